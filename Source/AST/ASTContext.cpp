@@ -0,0 +1,87 @@
+#include "ASTContext.h"
+
+#include <cstring>
+
+#include "Declaration.h"
+#include "TreeWalker.h"
+
+namespace Vex {
+    std::string_view ASTContext::Intern(const std::string_view Text) {
+        if (const auto IT = Strings.find(Text); IT != Strings.end()) {
+            return *IT;
+        }
+
+        auto* Memory = static_cast<char*>(Arena.Allocate(Text.size() + 1, 1));
+        std::memcpy(Memory, Text.data(), Text.size());
+        Memory[Text.size()] = '\0';
+
+        const std::string_view Stored(Memory, Text.size());
+        Strings.insert(Stored);
+        return Stored;
+    }
+
+    std::vector<const TypeRef*> ASTContext::Adopt(ASTContext& Other) {
+        std::vector<const TypeRef*> Remapped;
+        if (this == &Other) {
+            return Remapped;
+        }
+
+        // Types are copied (and canonicalized) before the slabs change hands
+        Remapped.reserve(Other.Types.Size());
+        for (uint32_t Id = 0; Id < Other.Types.Size(); ++Id) {
+            Remapped.push_back(Types.Get(*Other.Types.GetById(Id)));
+        }
+
+        Arena.Adopt(std::move(Other.Arena));
+        Other.Strings.clear();
+        Other.Types.Clear();
+
+        return Remapped;
+    }
+
+    void RemapTypes(ASTNode* Root, const std::vector<const TypeRef*>& Types) {
+        const auto Remap = [&Types](const TypeRef*& Type) {
+            if (Type != nullptr) {
+                Type = Types[Type->Id];
+            }
+        };
+
+        WalkTree(Root, [&](ASTNode& Node) {
+            switch (Node.Kind) {
+                case ENodeKind::CastExpression:
+                    Remap(static_cast<CastExpression&>(Node).Type);
+                    break;
+                case ENodeKind::NewExpression:
+                    Remap(static_cast<NewExpression&>(Node).Type);
+                    break;
+                case ENodeKind::VariableDeclaration:
+                    Remap(static_cast<VariableDeclaration&>(Node).Type);
+                    break;
+                case ENodeKind::FieldDeclaration:
+                    Remap(static_cast<FieldDeclaration&>(Node).Type);
+                    break;
+                case ENodeKind::FunctionDeclaration: {
+                    auto& Function = static_cast<FunctionDeclaration&>(Node);
+                    Remap(Function.ReturnType);
+                    for (auto& Param : Function.Parameters) {
+                        Remap(Param.Type);
+                    }
+                    break;
+                }
+                case ENodeKind::DefineDeclaration:
+                    for (auto& Base : static_cast<DefineDeclaration&>(Node).BaseTypes) {
+                        Remap(Base);
+                    }
+                    break;
+                case ENodeKind::InterfaceDeclaration:
+                    for (auto& Base : static_cast<InterfaceDeclaration&>(Node).BaseInterfaces) {
+                        Remap(Base);
+                    }
+                    break;
+                default:
+                    break;
+            }
+            return true;
+        });
+    }
+}
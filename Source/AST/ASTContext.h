@@ -0,0 +1,113 @@
+#pragma once
+
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Arena.h"
+#include "ASTNode.h"
+#include "TypeTable.h"
+
+namespace Vex {
+
+    /**
+     * Owns every node of one syntax tree
+     *
+     * Nodes, child lists, type references and strings are bump-allocated
+     * from a single arena and released together when the context dies.
+     * Strings and types are interned, so each distinct one is stored once.
+     * Pointers handed out by the context stay valid for its whole lifetime.
+     *
+     * Example:
+     *   ASTContext Context;
+     *   auto* Left  = Context.Create<Identifier>(Context.Intern("Health"));
+     *   auto* Right = Context.Create<IntegerLiteral>(10);
+     *   auto* Sum   = Context.Create<BinaryExpression>(Left, EBinaryOp::Add, Right);
+     */
+    class ASTContext {
+    public:
+        ASTContext() = default;
+
+        ASTContext(const ASTContext&) = delete;
+        ASTContext& operator=(const ASTContext&) = delete;
+
+        /**
+         * Constructs a node or AST helper inside the arena. The destructor
+         * is never called, so T must be trivially destructible.
+         */
+        template<typename T, typename... ArgTypes>
+        T* Create(ArgTypes&&... Arguments) {
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "AST storage must not own memory outside the arena");
+
+            void* Memory = Arena.Allocate(sizeof(T), alignof(T));
+            return new (Memory) T(std::forward<ArgTypes>(Arguments)...);
+        }
+
+        /** Copies Elements into the arena */
+        template<typename T>
+        ArenaArray<T> CreateArray(const std::vector<T>& Elements) {
+            return CreateArray(Elements.data(), Elements.size());
+        }
+
+        template<typename T>
+        ArenaArray<T> CreateArray(const T* Elements, size_t Count) {
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "Arena arrays never run element destructors");
+
+            if (Count == 0) {
+                return {};
+            }
+
+            auto* Memory = static_cast<T*>(Arena.Allocate(sizeof(T) * Count, alignof(T)));
+            for (size_t Index = 0; Index < Count; ++Index) {
+                new (Memory + Index) T(Elements[Index]);
+            }
+
+            return ArenaArray<T>(Memory, Count);
+        }
+
+        /**
+         * Returns an arena-owned copy of Text. Equal strings share storage,
+         * so the returned view can outlive the caller's buffer.
+         */
+        std::string_view Intern(std::string_view Text);
+
+        /** Canonical type table of this context */
+        TypeTable& GetTypes() { return Types; }
+
+        /** Shorthand for GetTypes().Get(Name) */
+        const TypeRef* GetType(const std::string_view Name) { return Types.Get(Name); }
+
+        void* Allocate(size_t Size, size_t Alignment) {
+            return Arena.Allocate(Size, Alignment);
+        }
+
+        /**
+         * Moves all of Other's storage into this context, so trees built in
+         * Other (e.g. on a worker thread) live as long as this context.
+         * Returns, indexed by Other's TypeRef::Id, the canonical type of this
+         * context for each type of Other; pass it to RemapTypes() to retarget
+         * the adopted trees. Other is left empty and can be reused.
+         */
+        std::vector<const TypeRef*> Adopt(ASTContext& Other);
+
+        [[nodiscard]] size_t GetBytesAllocated() const { return Arena.GetBytesAllocated(); }
+        [[nodiscard]] size_t GetBytesReserved() const { return Arena.GetBytesReserved(); }
+
+    private:
+        ArenaAllocator Arena;
+        std::unordered_set<std::string_view> Strings;
+        TypeTable Types{ *this };
+    };
+
+    /**
+     * Replaces every type reference in the subtree by Types[Type->Id]
+     * (the table returned by ASTContext::Adopt). Only touches the given
+     * tree, so disjoint trees can be remapped on different threads.
+     */
+    void RemapTypes(ASTNode* Root, const std::vector<const TypeRef*>& Types);
+}
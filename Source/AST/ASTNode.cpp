@@ -0,0 +1,210 @@
+#include <sstream>
+
+#include "ASTNode.h"
+#include "Declaration.h"
+#include "Expression.h"
+#include "Statement.h"
+
+namespace Vex {
+    std::string NodeKindToString(const ENodeKind Kind) {
+        switch (Kind) {
+            case ENodeKind::IntegerLiteral:         return "IntegerLiteral";
+            case ENodeKind::FloatLiteral:           return "FloatLiteral";
+            case ENodeKind::StringLiteral:          return "StringLiteral";
+            case ENodeKind::CharLiteral:            return "CharLiteral";
+            case ENodeKind::BoolLiteral:            return "BoolLiteral";
+            case ENodeKind::NullLiteral:            return "NullLiteral";
+            case ENodeKind::Identifier:             return "Identifier";
+            case ENodeKind::BinaryExpression:       return "BinaryExpression";
+            case ENodeKind::UnaryExpression:        return "UnaryExpression";
+            case ENodeKind::FunctionCall:           return "FunctionCall";
+            case ENodeKind::MemberAccess:           return "MemberAccess";
+            case ENodeKind::IndexAccess:            return "IndexAccess";
+            case ENodeKind::TernaryExpression:      return "TernaryExpression";
+            case ENodeKind::CastExpression:         return "CastExpression";
+            case ENodeKind::NewExpression:          return "NewExpression";
+            case ENodeKind::ThisExpression:         return "ThisExpression";
+            case ENodeKind::SuperExpression:        return "SuperExpression";
+            case ENodeKind::GroupingExpression:     return "GroupingExpression";
+
+            case ENodeKind::VariableDeclaration:    return "VariableDeclaration";
+            case ENodeKind::ExpressionStatement:    return "ExpressionStatement";
+            case ENodeKind::BlockStatement:         return "BlockStatement";
+            case ENodeKind::IfStatement:            return "IfStatement";
+            case ENodeKind::WhileStatement:         return "WhileStatement";
+            case ENodeKind::DoWhileStatement:       return "DoWhileStatement";
+            case ENodeKind::ForStatement:           return "ForStatement";
+            case ENodeKind::ReturnStatement:        return "ReturnStatement";
+            case ENodeKind::BreakStatement:         return "BreakStatement";
+            case ENodeKind::ContinueStatement:      return "ContinueStatement";
+            case ENodeKind::MatchStatement:         return "MatchStatement";
+
+            case ENodeKind::FieldDeclaration:       return "FieldDeclaration";
+            case ENodeKind::FunctionDeclaration:    return "FunctionDeclaration";
+            case ENodeKind::DefineDeclaration:      return "DefineDeclaration";
+            case ENodeKind::FetchDeclaration:       return "FetchDeclaration";
+            case ENodeKind::SetDeclaration:         return "SetDeclaration";
+            case ENodeKind::InterfaceDeclaration:   return "InterfaceDeclaration";
+            case ENodeKind::NamespaceDeclaration:   return "NamespaceDeclaration";
+            case ENodeKind::UsingDeclaration:       return "UsingDeclaration";
+            case ENodeKind::GlobalDeclaration:      return "GlobalDeclaration";
+
+            case ENodeKind::TranslationUnit:        return "TranslationUnit";
+        }
+
+        return "Unknown";
+    }
+
+    void ASTNode::Accept(ASTVisitor& Visitor) {
+        switch (Kind) {
+            case ENodeKind::IntegerLiteral:         static_cast<IntegerLiteral&>(*this).Accept(Visitor); return;
+            case ENodeKind::FloatLiteral:           static_cast<FloatLiteral&>(*this).Accept(Visitor); return;
+            case ENodeKind::StringLiteral:          static_cast<StringLiteral&>(*this).Accept(Visitor); return;
+            case ENodeKind::CharLiteral:            static_cast<CharLiteral&>(*this).Accept(Visitor); return;
+            case ENodeKind::BoolLiteral:            static_cast<BoolLiteral&>(*this).Accept(Visitor); return;
+            case ENodeKind::NullLiteral:            static_cast<NullLiteral&>(*this).Accept(Visitor); return;
+            case ENodeKind::Identifier:             static_cast<Identifier&>(*this).Accept(Visitor); return;
+            case ENodeKind::BinaryExpression:       static_cast<BinaryExpression&>(*this).Accept(Visitor); return;
+            case ENodeKind::UnaryExpression:        static_cast<UnaryExpression&>(*this).Accept(Visitor); return;
+            case ENodeKind::FunctionCall:           static_cast<FunctionCall&>(*this).Accept(Visitor); return;
+            case ENodeKind::MemberAccess:           static_cast<MemberAccess&>(*this).Accept(Visitor); return;
+            case ENodeKind::IndexAccess:            static_cast<IndexAccess&>(*this).Accept(Visitor); return;
+            case ENodeKind::TernaryExpression:      static_cast<TernaryExpression&>(*this).Accept(Visitor); return;
+            case ENodeKind::CastExpression:         static_cast<CastExpression&>(*this).Accept(Visitor); return;
+            case ENodeKind::NewExpression:          static_cast<NewExpression&>(*this).Accept(Visitor); return;
+            case ENodeKind::ThisExpression:         static_cast<ThisExpression&>(*this).Accept(Visitor); return;
+            case ENodeKind::SuperExpression:        static_cast<SuperExpression&>(*this).Accept(Visitor); return;
+            case ENodeKind::GroupingExpression:     static_cast<GroupingExpression&>(*this).Accept(Visitor); return;
+
+            case ENodeKind::VariableDeclaration:    static_cast<VariableDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::ExpressionStatement:    static_cast<ExpressionStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::BlockStatement:         static_cast<BlockStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::IfStatement:            static_cast<IfStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::WhileStatement:         static_cast<WhileStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::DoWhileStatement:       static_cast<DoWhileStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::ForStatement:           static_cast<ForStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::ReturnStatement:        static_cast<ReturnStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::BreakStatement:         static_cast<BreakStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::ContinueStatement:      static_cast<ContinueStatement&>(*this).Accept(Visitor); return;
+            case ENodeKind::MatchStatement:         static_cast<MatchStatement&>(*this).Accept(Visitor); return;
+
+            case ENodeKind::FieldDeclaration:       static_cast<FieldDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::FunctionDeclaration:    static_cast<FunctionDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::DefineDeclaration:      static_cast<DefineDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::FetchDeclaration:       static_cast<FetchDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::SetDeclaration:         static_cast<SetDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::InterfaceDeclaration:   static_cast<InterfaceDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::NamespaceDeclaration:   static_cast<NamespaceDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::UsingDeclaration:       static_cast<UsingDeclaration&>(*this).Accept(Visitor); return;
+            case ENodeKind::GlobalDeclaration:      static_cast<GlobalDeclaration&>(*this).Accept(Visitor); return;
+
+            case ENodeKind::TranslationUnit:        static_cast<TranslationUnit&>(*this).Accept(Visitor); return;
+        }
+    }
+
+    std::string ASTNode::ToString() const {
+        switch (Kind) {
+            case ENodeKind::IntegerLiteral:         return static_cast<const IntegerLiteral&>(*this).ToString();
+            case ENodeKind::FloatLiteral:           return static_cast<const FloatLiteral&>(*this).ToString();
+            case ENodeKind::StringLiteral:          return static_cast<const StringLiteral&>(*this).ToString();
+            case ENodeKind::CharLiteral:            return static_cast<const CharLiteral&>(*this).ToString();
+            case ENodeKind::BoolLiteral:            return static_cast<const BoolLiteral&>(*this).ToString();
+            case ENodeKind::NullLiteral:            return static_cast<const NullLiteral&>(*this).ToString();
+            case ENodeKind::Identifier:             return static_cast<const Identifier&>(*this).ToString();
+            case ENodeKind::BinaryExpression:       return static_cast<const BinaryExpression&>(*this).ToString();
+            case ENodeKind::UnaryExpression:        return static_cast<const UnaryExpression&>(*this).ToString();
+            case ENodeKind::FunctionCall:           return static_cast<const FunctionCall&>(*this).ToString();
+            case ENodeKind::MemberAccess:           return static_cast<const MemberAccess&>(*this).ToString();
+            case ENodeKind::IndexAccess:            return static_cast<const IndexAccess&>(*this).ToString();
+            case ENodeKind::TernaryExpression:      return static_cast<const TernaryExpression&>(*this).ToString();
+            case ENodeKind::CastExpression:         return static_cast<const CastExpression&>(*this).ToString();
+            case ENodeKind::NewExpression:          return static_cast<const NewExpression&>(*this).ToString();
+            case ENodeKind::ThisExpression:         return static_cast<const ThisExpression&>(*this).ToString();
+            case ENodeKind::SuperExpression:        return static_cast<const SuperExpression&>(*this).ToString();
+            case ENodeKind::GroupingExpression:     return static_cast<const GroupingExpression&>(*this).ToString();
+
+            case ENodeKind::VariableDeclaration:    return static_cast<const VariableDeclaration&>(*this).ToString();
+            case ENodeKind::ExpressionStatement:    return static_cast<const ExpressionStatement&>(*this).ToString();
+            case ENodeKind::BlockStatement:         return static_cast<const BlockStatement&>(*this).ToString();
+            case ENodeKind::IfStatement:            return static_cast<const IfStatement&>(*this).ToString();
+            case ENodeKind::WhileStatement:         return static_cast<const WhileStatement&>(*this).ToString();
+            case ENodeKind::DoWhileStatement:       return static_cast<const DoWhileStatement&>(*this).ToString();
+            case ENodeKind::ForStatement:           return static_cast<const ForStatement&>(*this).ToString();
+            case ENodeKind::ReturnStatement:        return static_cast<const ReturnStatement&>(*this).ToString();
+            case ENodeKind::BreakStatement:         return static_cast<const BreakStatement&>(*this).ToString();
+            case ENodeKind::ContinueStatement:      return static_cast<const ContinueStatement&>(*this).ToString();
+            case ENodeKind::MatchStatement:         return static_cast<const MatchStatement&>(*this).ToString();
+
+            case ENodeKind::FieldDeclaration:       return static_cast<const FieldDeclaration&>(*this).ToString();
+            case ENodeKind::FunctionDeclaration:    return static_cast<const FunctionDeclaration&>(*this).ToString();
+            case ENodeKind::DefineDeclaration:      return static_cast<const DefineDeclaration&>(*this).ToString();
+            case ENodeKind::FetchDeclaration:       return static_cast<const FetchDeclaration&>(*this).ToString();
+            case ENodeKind::SetDeclaration:         return static_cast<const SetDeclaration&>(*this).ToString();
+            case ENodeKind::InterfaceDeclaration:   return static_cast<const InterfaceDeclaration&>(*this).ToString();
+            case ENodeKind::NamespaceDeclaration:   return static_cast<const NamespaceDeclaration&>(*this).ToString();
+            case ENodeKind::UsingDeclaration:       return static_cast<const UsingDeclaration&>(*this).ToString();
+            case ENodeKind::GlobalDeclaration:      return static_cast<const GlobalDeclaration&>(*this).ToString();
+
+            case ENodeKind::TranslationUnit:        return static_cast<const TranslationUnit&>(*this).ToString();
+        }
+
+        return "";
+    }
+
+    std::string AccessModifierToString(const EAccessModifier Modifier) {
+        switch (Modifier) {
+            case EAccessModifier::NONE:         return "";
+            case EAccessModifier::PUBLIC:       return "Public";
+            case EAccessModifier::PRIVATE:      return "Private";
+            case EAccessModifier::PROTECTED:    return "Protected";
+            case EAccessModifier::VIEW:         return "View";
+        }
+
+        return "";
+    }
+
+    std::string TypeRef::ToString() const {
+        std::stringstream Stream;
+
+        if (IsUnique) { Stream << "Unique "; }
+        if (IsShared) { Stream << "Shared "; }
+        if (IsBorrow) { Stream << "Borrow "; }
+
+        Stream << Name;
+
+        for (const auto& Member : MemberPath) {
+            Stream << "." << Member;
+        }
+
+        if (!AllowedFields.empty()) {
+            Stream << "{";
+            for (size_t Index = 0; Index < AllowedFields.size(); ++Index) {
+                if (Index > 0) {
+                    Stream << ", ";
+                }
+                Stream << AllowedFields[Index];
+            }
+            Stream << "}";
+        }
+
+        if (IsPointer) { Stream << "*"; }
+        if (IsArray) { Stream << "[]"; }
+
+        return Stream.str();
+    }
+
+    std::string Parameter::ToString() const {
+        std::stringstream Stream;
+        Stream << Name;
+
+        if (Type != nullptr) {
+            Stream << ": " << Type->ToString();
+        }
+
+        if (DefaultValue != nullptr) {
+            Stream << " = " << DefaultValue->ToString();
+        }
+
+        return Stream.str();
+    }
+}
@@ -1,28 +1,158 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <vector>
-#include <memory>
+#include <string_view>
+
+#include "Arena.h"
 
 namespace Vex {
     class ASTVisitor;
 
+    /**
+     * Every concrete node type, in declaration order
+     * Used as the tag of flattened and serialized nodes.
+     */
+    enum class ENodeKind : uint8_t {
+        // Expressions
+        IntegerLiteral,
+        FloatLiteral,
+        StringLiteral,
+        CharLiteral,
+        BoolLiteral,
+        NullLiteral,
+        Identifier,
+        BinaryExpression,
+        UnaryExpression,
+        FunctionCall,
+        MemberAccess,
+        IndexAccess,
+        TernaryExpression,
+        CastExpression,
+        NewExpression,
+        ThisExpression,
+        SuperExpression,
+        GroupingExpression,
+
+        // Statements
+        VariableDeclaration,
+        ExpressionStatement,
+        BlockStatement,
+        IfStatement,
+        WhileStatement,
+        DoWhileStatement,
+        ForStatement,
+        ReturnStatement,
+        BreakStatement,
+        ContinueStatement,
+        MatchStatement,
+
+        // Declarations
+        FieldDeclaration,
+        FunctionDeclaration,
+        DefineDeclaration,
+        FetchDeclaration,
+        SetDeclaration,
+        InterfaceDeclaration,
+        NamespaceDeclaration,
+        UsingDeclaration,
+        GlobalDeclaration,
+
+        // Root of a source file
+        TranslationUnit,
+    };
+
+    constexpr size_t NodeKindCount = static_cast<size_t>(ENodeKind::TranslationUnit) + 1;
+
+    std::string NodeKindToString(ENodeKind Kind);
+
+    /**
+     * Position of the first token of a node (1-indexed, 0 when unknown)
+     */
+    struct SourceLocation {
+        int Line   = 0;
+        int Column = 0;
+    };
+
     /**
      * Base class for all AST nodes
      * Every node can accept a visitor for traversal
+     *
+     * Nodes are allocated in, and owned by, an ASTContext. They reference
+     * each other through raw pointers and are never deleted individually.
+     *
+     * Nodes have no vtable: Kind identifies the concrete class, and
+     * Accept() / ToString() switch on it to reach the concrete node's
+     * method. Passes can do the same through StaticVisitor and skip the
+     * ASTVisitor round trip entirely.
+     *
+     * CachedHash is filled in by StructuralHash() (see StructuralHash.h);
+     * a pass that rewrites a node must clear HasCachedHash on it and on
+     * its ancestors.
      */
     class ASTNode {
     public:
-        virtual ~ASTNode() = default;
-        virtual void Accept(ASTVisitor& Visitor) = 0;
-        virtual std::string ToString() const = 0;
+        const ENodeKind Kind;
+        mutable bool HasCachedHash = false;
+        SourceLocation Location;
+        mutable uint64_t CachedHash = 0;
+
+        explicit ASTNode(const ENodeKind Kind) : Kind(Kind) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+
+        /** True if this node is a T (T must be a concrete node class) */
+        template<typename T>
+        [[nodiscard]] bool Is() const { return Kind == T::NodeKind; }
+
+        /** Checked downcast; returns nullptr if this node is not a T */
+        template<typename T>
+        T* As() { return Is<T>() ? static_cast<T*>(this) : nullptr; }
+
+        template<typename T>
+        const T* As() const { return Is<T>() ? static_cast<const T*>(this) : nullptr; }
+
+        [[nodiscard]] bool IsExpression() const { return Kind <= ENodeKind::GroupingExpression; }
+        [[nodiscard]] bool IsStatement() const {
+            return Kind >= ENodeKind::VariableDeclaration && Kind <= ENodeKind::MatchStatement;
+        }
+        [[nodiscard]] bool IsDeclaration() const {
+            return Kind >= ENodeKind::FieldDeclaration && Kind <= ENodeKind::GlobalDeclaration;
+        }
+    };
+
+    /**
+     * What a name in the tree refers to, as bound by a backend's name
+     * resolution pass (the VM's Resolver); Unresolved until one has run
+     *
+     * Indices belong to whoever resolved them. Bindings are annotations:
+     * they are not part of structural hashing, flattening or modules, and
+     * a pass that rewrites the tree must resolve it again.
+     */
+    enum class ESymbolKind : uint8_t {
+        Unresolved,
+        Local,                                      // Index: slot among its function's locals, parameters first
+        Global,                                     // Index: global slot
+        Function,                                   // Index: function
+        Native,                                     // Index: native function
+        Field,                                      // Index: field of the type numbered Owner
+        Type,                                       // Index: type
+        Interface,                                  // Index: interface; where a method is called through one, Owner: its slot
+        Namespace,                                  // Index: scope of the namespace (see SymbolTable)
+    };
+
+    struct SymbolRef {
+        ESymbolKind Kind = ESymbolKind::Unresolved;
+        uint32_t Index = 0;
+        uint32_t Owner = 0;
     };
 
     enum class EAccessModifier {
         NONE,
         PUBLIC,
         PRIVATE,
-        PROTECTED, 
+        PROTECTED,
         VIEW
     };
 
@@ -31,25 +161,34 @@ namespace Vex {
     /**
      * Represents a type reference in the AST
      * Can be simple (Int_32) or complex (Player.Health)
-     * 
+     *
      * Examples:
      *   Int_32              -> Name: "Int_32", IsPointer: false
      *   Vector3             -> Name: "Vector3"
      *   Entity.Health       -> Name: "Entity", MemberPath: ["Health"]
      *   Float{Entity.Health}-> Name: "Float", AllowedFields: ["Entity.Health"]
+     *   Entity[]            -> Name: "Entity", IsArray: true
+     *
+     * Nodes only point at canonical instances handed out by the context's
+     * TypeTable, so equal types share one object and compare by pointer.
+     * A TypeRef built on the stack is just a lookup key.
      */
     struct TypeRef {
-        std::string Name;                           // Base type name
-        bool IsPointer = false;                     // Is this a pointer?
-        bool IsUnique = false;                      // Unique ownership?
-        bool IsShared = false;                      // Shared ownership?
-        bool IsBorrow = false;                      // Borrowed reference?
-        std::vector<std::string> MemberPath;        // For Entity.Health
-        std::vector<std::string> AllowedFields;     // For Float{Entity.Health}
-        
+        std::string_view Name;                          // Base type name
+        bool IsPointer = false;                         // Is this a pointer?
+        bool IsUnique = false;                          // Unique ownership?
+        bool IsShared = false;                          // Shared ownership?
+        bool IsBorrow = false;                          // Borrowed reference?
+        bool IsArray = false;                           // Array of the type (after any pointer)?
+        ArenaArray<std::string_view> MemberPath;        // For Entity.Health
+        ArenaArray<std::string_view> AllowedFields;     // For Float{Entity.Health}
+        uint32_t Id = InvalidId;                        // Dense id assigned by TypeTable
+
+        static constexpr uint32_t InvalidId = 0xFFFFFFFFu;
+
         TypeRef() = default;
-        explicit TypeRef(const std::string& Name) : Name(Name) {}
-        
+        explicit TypeRef(std::string_view Name) : Name(Name) {}
+
         std::string ToString() const;
     };
 
@@ -58,13 +197,13 @@ namespace Vex {
      * Example: Amount: Int_32
      */
     struct Parameter {
-        std::string Name;                           // Parameter name
-        std::unique_ptr<TypeRef> Type;              // Parameter type
-        std::unique_ptr<class Expression> DefaultValue; // Optional default
-        
-        Parameter(const std::string& Name, std::unique_ptr<TypeRef> Type)
-            : Name(Name), Type(std::move(Type)) {}
-        
+        std::string_view Name;                      // Parameter name
+        const TypeRef* Type = nullptr;              // Parameter type
+        class Expression* DefaultValue = nullptr;   // Optional default
+
+        Parameter(std::string_view Name, const TypeRef* Type)
+            : Name(Name), Type(Type) {}
+
         std::string ToString() const;
     };
 
@@ -74,17 +213,25 @@ namespace Vex {
      */
     class Expression : public ASTNode {
     public:
-        void Accept(ASTVisitor& Visitor) override = 0;
-        std::string ToString() const override = 0;
+        explicit Expression(const ENodeKind Kind) : ASTNode(Kind) {}
+    };
+
+    /**
+     * Base class for all statements.
+     * Statements are executed for their effect.
+     */
+    class Statement : public ASTNode {
+    public:
+        explicit Statement(const ENodeKind Kind) : ASTNode(Kind) {}
     };
 
     /**
      * Base class for all top-level declarations.
-     * (Define, Fetch, Set, Interface, Namespace, Function)
+     * (Define, Fetch, Set, Interface, Namespace, Using, global, and the
+     * fields and methods inside them)
      */
     class Declaration : public ASTNode {
     public:
-        void Accept(ASTVisitor& Visitor) override = 0;
-        std::string ToString() const override = 0;
+        explicit Declaration(const ENodeKind Kind) : ASTNode(Kind) {}
     };
-}
\ No newline at end of file
+}
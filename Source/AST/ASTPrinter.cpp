@@ -0,0 +1,376 @@
+#include "ASTPrinter.h"
+
+#include <utility>
+#include <vector>
+
+#include "Declaration.h"
+#include "Expression.h"
+#include "Statement.h"
+
+namespace Vex {
+    namespace {
+        /**
+         * Pending output: either a node still to be expanded or literal text
+         */
+        struct PrintItem {
+            const ASTNode* Node;
+            std::string    Text;
+        };
+
+        class TreePrinter {
+        public:
+            std::string Print(const ASTNode& Root) {
+                PushNode(&Root);
+
+                while (!Stack.empty()) {
+                    PrintItem Item = std::move(Stack.back());
+                    Stack.pop_back();
+
+                    if (Item.Node == nullptr) {
+                        Output += Item.Text;
+                    } else {
+                        Expand(*Item.Node);
+                    }
+                }
+
+                return std::move(Output);
+            }
+
+        private:
+            std::vector<PrintItem> Stack;
+            std::string            Output;
+
+            void PushNode(const ASTNode* Node) { Stack.push_back({ Node, {} }); }
+            void PushText(std::string Text) { Stack.push_back({ nullptr, std::move(Text) }); }
+
+            template<typename T>
+            void PushList(const ArenaArray<T*>& Items) {
+                for (size_t Index = Items.size(); Index-- > 0;) {
+                    PushNode(Items[Index]);
+                    if (Index > 0) {
+                        PushText(", ");
+                    }
+                }
+            }
+
+            /** Block members: " A B C" in front of the closing brace */
+            template<typename T>
+            void PushMembers(const ArenaArray<T*>& Members) {
+                for (size_t Index = Members.size(); Index-- > 0;) {
+                    PushNode(Members[Index]);
+                    PushText(" ");
+                }
+            }
+
+            static std::string AccessPrefix(const EAccessModifier Access) {
+                return Access == EAccessModifier::NONE ? "" : AccessModifierToString(Access) + ": ";
+            }
+
+            static std::string JoinTypes(const char* Prefix, const ArenaArray<const TypeRef*>& Types) {
+                std::string Text;
+                for (size_t Index = 0; Index < Types.size(); ++Index) {
+                    Text += Index == 0 ? Prefix : ", ";
+                    Text += Types[Index]->ToString();
+                }
+                return Text;
+            }
+
+            /**
+             * Text that comes before the first child goes straight to the
+             * output; everything after it is pushed in reverse order
+             */
+            void Expand(const ASTNode& Node) {
+                switch (Node.Kind) {
+                    case ENodeKind::BinaryExpression: {
+                        const auto& Binary = static_cast<const BinaryExpression&>(Node);
+                        Output += "(";
+                        PushText(")");
+                        PushNode(Binary.Right);
+                        PushText(" " + BinaryOpToString(Binary.Op) + " ");
+                        PushNode(Binary.Left);
+                        break;
+                    }
+                    case ENodeKind::UnaryExpression: {
+                        const auto& Unary = static_cast<const UnaryExpression&>(Node);
+                        Output += "(" + UnaryOpToString(Unary.Op);
+                        PushText(")");
+                        PushNode(Unary.Operand);
+                        break;
+                    }
+                    case ENodeKind::FunctionCall: {
+                        const auto& Call = static_cast<const FunctionCall&>(Node);
+                        PushText(")");
+                        PushList(Call.Arguments);
+                        PushText("(");
+                        PushNode(Call.Callee);
+                        break;
+                    }
+                    case ENodeKind::MemberAccess: {
+                        const auto& Access = static_cast<const MemberAccess&>(Node);
+                        PushText((Access.IsOptional ? "?." : ".") + std::string(Access.Member));
+                        PushNode(Access.Object);
+                        break;
+                    }
+                    case ENodeKind::IndexAccess: {
+                        const auto& Access = static_cast<const IndexAccess&>(Node);
+                        PushText("]");
+                        PushNode(Access.Index);
+                        PushText("[");
+                        PushNode(Access.Object);
+                        break;
+                    }
+                    case ENodeKind::TernaryExpression: {
+                        const auto& Ternary = static_cast<const TernaryExpression&>(Node);
+                        Output += "(";
+                        PushText(")");
+                        PushNode(Ternary.FalseExpr);
+                        PushText(" : ");
+                        PushNode(Ternary.TrueExpr);
+                        PushText(" ? ");
+                        PushNode(Ternary.Condition);
+                        break;
+                    }
+                    case ENodeKind::CastExpression: {
+                        const auto& Cast = static_cast<const CastExpression&>(Node);
+                        Output += "(";
+                        PushText(" as " + Cast.Type->ToString() + ")");
+                        PushNode(Cast.Expr);
+                        break;
+                    }
+                    case ENodeKind::NewExpression: {
+                        const auto& New = static_cast<const NewExpression&>(Node);
+                        Output += "new " + New.Type->ToString() + "(";
+                        PushText(")");
+                        PushList(New.Arguments);
+                        break;
+                    }
+                    case ENodeKind::GroupingExpression:
+                        Output += "(";
+                        PushText(")");
+                        PushNode(static_cast<const GroupingExpression&>(Node).Expr);
+                        break;
+
+                    case ENodeKind::VariableDeclaration: {
+                        const auto& Var = static_cast<const VariableDeclaration&>(Node);
+                        Output += Var.IsConst ? "Const " : Var.IsLet ? "Let " : "Var ";
+                        Output += Var.Name;
+
+                        if (Var.Type != nullptr) {
+                            Output += ": " + Var.Type->ToString();
+                        }
+
+                        if (Var.Initializer != nullptr) {
+                            Output += " = ";
+                            PushText(";");
+                            PushNode(Var.Initializer);
+                        } else {
+                            Output += ";";
+                        }
+                        break;
+                    }
+                    case ENodeKind::ExpressionStatement:
+                        PushText(";");
+                        PushNode(static_cast<const ExpressionStatement&>(Node).Expr);
+                        break;
+                    case ENodeKind::BlockStatement: {
+                        const auto& Block = static_cast<const BlockStatement&>(Node);
+                        Output += "{";
+                        PushText(" }");
+                        for (size_t Index = Block.Statements.size(); Index-- > 0;) {
+                            PushNode(Block.Statements[Index]);
+                            PushText(" ");
+                        }
+                        break;
+                    }
+                    case ENodeKind::IfStatement: {
+                        const auto& If = static_cast<const IfStatement&>(Node);
+                        Output += "if ";
+                        if (If.ElseBranch != nullptr) {
+                            PushNode(If.ElseBranch);
+                            PushText(" else ");
+                        }
+                        PushNode(If.ThenBranch);
+                        PushText(" ");
+                        PushNode(If.Condition);
+                        break;
+                    }
+                    case ENodeKind::WhileStatement: {
+                        const auto& While = static_cast<const WhileStatement&>(Node);
+                        Output += "while ";
+                        PushNode(While.Body);
+                        PushText(" ");
+                        PushNode(While.Condition);
+                        break;
+                    }
+                    case ENodeKind::DoWhileStatement: {
+                        const auto& DoWhile = static_cast<const DoWhileStatement&>(Node);
+                        Output += "do ";
+                        PushText(";");
+                        PushNode(DoWhile.Condition);
+                        PushText(" while ");
+                        PushNode(DoWhile.Body);
+                        break;
+                    }
+                    case ENodeKind::ForStatement: {
+                        const auto& For = static_cast<const ForStatement&>(Node);
+                        Output += "for " + std::string(For.Iterator) + " in ";
+                        PushNode(For.Body);
+                        PushText(" ");
+                        if (For.Step != nullptr) {
+                            PushNode(For.Step);
+                            PushText(" step ");
+                        }
+                        PushNode(For.RangeEnd);
+                        PushText(For.IsInclusive ? "..=" : "..");
+                        PushNode(For.RangeStart);
+                        break;
+                    }
+                    case ENodeKind::ReturnStatement: {
+                        const auto& Return = static_cast<const ReturnStatement&>(Node);
+                        if (Return.Value == nullptr) {
+                            Output += "return;";
+                        } else {
+                            Output += "return ";
+                            PushText(";");
+                            PushNode(Return.Value);
+                        }
+                        break;
+                    }
+                    case ENodeKind::MatchStatement: {
+                        const auto& Match = static_cast<const MatchStatement&>(Node);
+                        Output += "match ";
+                        PushText(" }");
+                        for (size_t Index = Match.Cases.size(); Index-- > 0;) {
+                            PushNode(Match.Cases[Index].Body);
+                            PushText(" -> ");
+                            PushNode(Match.Cases[Index].Pattern);
+                            PushText(" ");
+                        }
+                        PushText(" {");
+                        PushNode(Match.Value);
+                        break;
+                    }
+
+                    case ENodeKind::FieldDeclaration: {
+                        const auto& Field = static_cast<const FieldDeclaration&>(Node);
+                        Output += AccessPrefix(Field.Access);
+                        if (Field.IsStatic) { Output += "Static "; }
+                        if (Field.IsConst) { Output += "Const "; }
+                        Output += std::string(Field.Name) + " -> " + Field.Type->ToString();
+
+                        if (Field.Initializer != nullptr) {
+                            Output += " = ";
+                            PushText(";");
+                            PushNode(Field.Initializer);
+                        } else {
+                            Output += ";";
+                        }
+                        break;
+                    }
+                    case ENodeKind::FunctionDeclaration: {
+                        const auto& Function = static_cast<const FunctionDeclaration&>(Node);
+                        Output += AccessPrefix(Function.Access);
+                        if (Function.IsStatic) { Output += "Static "; }
+                        if (Function.IsVirtual) { Output += "Virtual "; }
+                        if (Function.IsOverride) { Output += "Override "; }
+                        if (Function.IsImplement) { Output += "Implement "; }
+                        if (Function.IsOperator) { Output += "Operator "; }
+                        Output += std::string(Function.Name) + "(";
+
+                        std::string Tail = ")";
+                        if (Function.ReturnType != nullptr) {
+                            Tail += " -> " + Function.ReturnType->ToString();
+                        }
+
+                        if (Function.Body != nullptr) {
+                            PushNode(Function.Body);
+                            PushText(Tail + " ");
+                        } else if (Function.Deferred != nullptr) {
+                            PushText(Tail + " { ... }");
+                        } else {
+                            PushText(Tail + ";");
+                        }
+
+                        for (size_t Index = Function.Parameters.size(); Index-- > 0;) {
+                            const Parameter& Param = Function.Parameters[Index];
+                            if (Param.DefaultValue != nullptr) {
+                                PushNode(Param.DefaultValue);
+                            }
+                            PushText(std::string(Index > 0 ? ", " : "") + std::string(Param.Name) +
+                                     (Param.Type != nullptr ? ": " + Param.Type->ToString() : "") +
+                                     (Param.DefaultValue != nullptr ? " = " : ""));
+                        }
+                        break;
+                    }
+                    case ENodeKind::DefineDeclaration: {
+                        const auto& Define = static_cast<const DefineDeclaration&>(Node);
+                        for (const auto& Attribute : Define.Attributes) {
+                            Output += "@" + std::string(Attribute) + " ";
+                        }
+                        Output += "Define " + std::string(Define.Name) + JoinTypes(" : ", Define.BaseTypes) + " {";
+                        PushText(" }");
+                        PushMembers(Define.Methods);
+                        PushMembers(Define.Fields);
+                        break;
+                    }
+                    case ENodeKind::FetchDeclaration: {
+                        const auto& Fetch = static_cast<const FetchDeclaration&>(Node);
+                        Output += "Fetch " + std::string(Fetch.Target) + " {";
+                        PushText(" }");
+                        PushMembers(Fetch.Methods);
+                        break;
+                    }
+                    case ENodeKind::SetDeclaration: {
+                        const auto& Set = static_cast<const SetDeclaration&>(Node);
+                        Output += "Set " + std::string(Set.Target) + " {";
+                        PushText(" }");
+                        PushMembers(Set.Methods);
+                        break;
+                    }
+                    case ENodeKind::InterfaceDeclaration: {
+                        const auto& Interface = static_cast<const InterfaceDeclaration&>(Node);
+                        Output += "Interface " + std::string(Interface.Name) +
+                                  JoinTypes(" : ", Interface.BaseInterfaces) + " {";
+                        PushText(" }");
+                        PushMembers(Interface.Methods);
+                        break;
+                    }
+                    case ENodeKind::NamespaceDeclaration: {
+                        const auto& Namespace = static_cast<const NamespaceDeclaration&>(Node);
+                        Output += "Namespace " + std::string(Namespace.Name) + " {";
+                        PushText(" }");
+                        PushMembers(Namespace.Declarations);
+                        break;
+                    }
+                    case ENodeKind::UsingDeclaration:
+                        Output += "Using " + std::string(static_cast<const UsingDeclaration&>(Node).Path) + ";";
+                        break;
+                    case ENodeKind::GlobalDeclaration:
+                        Output += "global ";
+                        PushNode(static_cast<const GlobalDeclaration&>(Node).Variable);
+                        break;
+                    case ENodeKind::TranslationUnit: {
+                        const auto& Unit = static_cast<const TranslationUnit&>(Node);
+                        for (size_t Index = Unit.Declarations.size(); Index-- > 0;) {
+                            PushNode(Unit.Declarations[Index]);
+                            if (Index > 0) {
+                                PushText("\n");
+                            }
+                        }
+                        break;
+                    }
+
+                    // Leaves print themselves without recursing
+                    default:
+                        Output += Node.ToString();
+                        break;
+                }
+            }
+        };
+    }
+
+    std::string PrintTree(const ASTNode& Root) {
+        TreePrinter Printer;
+        return Printer.Print(Root);
+    }
+}
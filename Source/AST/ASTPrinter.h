@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+#include "ASTNode.h"
+
+namespace Vex {
+
+    /**
+     * Source-like text of the subtree of Root
+     *
+     * This is what ASTNode::ToString() returns for every node with
+     * children. The text is produced with an explicit work stack, so a
+     * 100k-term expression or a million-deep else-if chain prints in
+     * linear time without recursing.
+     */
+    std::string PrintTree(const ASTNode& Root);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+namespace Vex {
+    // Expressions
+    class IntegerLiteral;
+    class FloatLiteral;
+    class StringLiteral;
+    class CharLiteral;
+    class BoolLiteral;
+    class NullLiteral;
+    class Identifier;
+    class BinaryExpression;
+    class UnaryExpression;
+    class FunctionCall;
+    class MemberAccess;
+    class IndexAccess;
+    class TernaryExpression;
+    class CastExpression;
+    class NewExpression;
+    class ThisExpression;
+    class SuperExpression;
+    class GroupingExpression;
+
+    // Statements
+    class VariableDeclaration;
+    class ExpressionStatement;
+    class BlockStatement;
+    class IfStatement;
+    class WhileStatement;
+    class DoWhileStatement;
+    class ForStatement;
+    class ReturnStatement;
+    class BreakStatement;
+    class ContinueStatement;
+    class MatchStatement;
+
+    class FieldDeclaration;
+    class FunctionDeclaration;
+    class DefineDeclaration;
+    class FetchDeclaration;
+    class SetDeclaration;
+    class InterfaceDeclaration;
+    class NamespaceDeclaration;
+    class UsingDeclaration;
+    class GlobalDeclaration;
+    class TranslationUnit;
+
+    /**
+     * Visitor interface for AST traversal
+     * Every concrete node calls the matching Visit() overload from Accept().
+     * Visitors are responsible for walking into children themselves.
+     */
+    class ASTVisitor {
+    public:
+        virtual ~ASTVisitor() = default;
+
+        // Expressions
+        virtual void Visit(IntegerLiteral& Node) = 0;
+        virtual void Visit(FloatLiteral& Node) = 0;
+        virtual void Visit(StringLiteral& Node) = 0;
+        virtual void Visit(CharLiteral& Node) = 0;
+        virtual void Visit(BoolLiteral& Node) = 0;
+        virtual void Visit(NullLiteral& Node) = 0;
+        virtual void Visit(Identifier& Node) = 0;
+        virtual void Visit(BinaryExpression& Node) = 0;
+        virtual void Visit(UnaryExpression& Node) = 0;
+        virtual void Visit(FunctionCall& Node) = 0;
+        virtual void Visit(MemberAccess& Node) = 0;
+        virtual void Visit(IndexAccess& Node) = 0;
+        virtual void Visit(TernaryExpression& Node) = 0;
+        virtual void Visit(CastExpression& Node) = 0;
+        virtual void Visit(NewExpression& Node) = 0;
+        virtual void Visit(ThisExpression& Node) = 0;
+        virtual void Visit(SuperExpression& Node) = 0;
+        virtual void Visit(GroupingExpression& Node) = 0;
+
+        // Statements
+        virtual void Visit(VariableDeclaration& Node) = 0;
+        virtual void Visit(ExpressionStatement& Node) = 0;
+        virtual void Visit(BlockStatement& Node) = 0;
+        virtual void Visit(IfStatement& Node) = 0;
+        virtual void Visit(WhileStatement& Node) = 0;
+        virtual void Visit(DoWhileStatement& Node) = 0;
+        virtual void Visit(ForStatement& Node) = 0;
+        virtual void Visit(ReturnStatement& Node) = 0;
+        virtual void Visit(BreakStatement& Node) = 0;
+        virtual void Visit(ContinueStatement& Node) = 0;
+        virtual void Visit(MatchStatement& Node) = 0;
+
+        // Declarations
+        virtual void Visit(FieldDeclaration& Node) = 0;
+        virtual void Visit(FunctionDeclaration& Node) = 0;
+        virtual void Visit(DefineDeclaration& Node) = 0;
+        virtual void Visit(FetchDeclaration& Node) = 0;
+        virtual void Visit(SetDeclaration& Node) = 0;
+        virtual void Visit(InterfaceDeclaration& Node) = 0;
+        virtual void Visit(NamespaceDeclaration& Node) = 0;
+        virtual void Visit(UsingDeclaration& Node) = 0;
+        virtual void Visit(GlobalDeclaration& Node) = 0;
+        virtual void Visit(TranslationUnit& Node) = 0;
+    };
+}
@@ -0,0 +1,129 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace Vex {
+    ArenaAllocator::ArenaAllocator(const size_t InitialSlabSize)
+        : NextSlabSize(InitialSlabSize)
+        , InitialSlabSize(InitialSlabSize) {}
+
+    ArenaAllocator::~ArenaAllocator() {
+        ReleaseSlabs(0);
+    }
+
+    ArenaAllocator::ArenaAllocator(ArenaAllocator&& Other) noexcept
+        : Slabs(std::move(Other.Slabs))
+        , Cursor(Other.Cursor)
+        , End(Other.End)
+        , NextSlabSize(Other.NextSlabSize)
+        , InitialSlabSize(Other.InitialSlabSize)
+        , BytesAllocated(Other.BytesAllocated)
+        , BytesReserved(Other.BytesReserved) {
+        Other.Slabs.clear();
+        Other.Cursor         = nullptr;
+        Other.End            = nullptr;
+        Other.NextSlabSize   = Other.InitialSlabSize;
+        Other.BytesAllocated = 0;
+        Other.BytesReserved  = 0;
+    }
+
+    ArenaAllocator& ArenaAllocator::operator=(ArenaAllocator&& Other) noexcept {
+        if (this != &Other) {
+            ReleaseSlabs(0);
+
+            Slabs           = std::move(Other.Slabs);
+            Cursor          = Other.Cursor;
+            End             = Other.End;
+            NextSlabSize    = Other.NextSlabSize;
+            InitialSlabSize = Other.InitialSlabSize;
+            BytesAllocated  = Other.BytesAllocated;
+            BytesReserved   = Other.BytesReserved;
+
+            Other.Slabs.clear();
+            Other.Cursor         = nullptr;
+            Other.End            = nullptr;
+            Other.NextSlabSize   = Other.InitialSlabSize;
+            Other.BytesAllocated = 0;
+            Other.BytesReserved  = 0;
+        }
+
+        return *this;
+    }
+
+    void* ArenaAllocator::AllocateSlow(const size_t Size, const size_t Alignment) {
+        // Oversized requests get a dedicated slab so they don't waste the current one
+        const size_t Required = Size + Alignment;
+        const size_t SlabSize = std::max(NextSlabSize, Required);
+
+        auto* Memory = static_cast<char*>(std::malloc(SlabSize));
+        if (Memory == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        Slabs.push_back({ Memory, SlabSize });
+        BytesReserved += SlabSize;
+
+        if (Required > NextSlabSize) {
+            // Keep bumping in the previous slab, if there was one
+            auto Address = reinterpret_cast<uintptr_t>(Memory);
+            uintptr_t Aligned = (Address + Alignment - 1) & ~(static_cast<uintptr_t>(Alignment) - 1);
+            BytesAllocated += Size;
+            return reinterpret_cast<void*>(Aligned);
+        }
+
+        NextSlabSize = std::min(NextSlabSize * 2, MaxSlabSize);
+
+        Cursor = Memory;
+        End    = Memory + SlabSize;
+
+        return Allocate(Size, Alignment);
+    }
+
+    void ArenaAllocator::Reset() {
+        if (Slabs.empty()) {
+            return;
+        }
+
+        // Keep the first regular slab around; most arenas are refilled right away
+        ReleaseSlabs(1);
+
+        Cursor         = Slabs[0].Memory;
+        End            = Slabs[0].Memory + Slabs[0].Size;
+        NextSlabSize   = std::min(InitialSlabSize * 2, MaxSlabSize);
+        BytesAllocated = 0;
+        BytesReserved  = Slabs[0].Size;
+    }
+
+    void ArenaAllocator::Adopt(ArenaAllocator&& Other) {
+        if (this == &Other) {
+            return;
+        }
+
+        Slabs.insert(Slabs.end(), Other.Slabs.begin(), Other.Slabs.end());
+        BytesAllocated += Other.BytesAllocated;
+        BytesReserved  += Other.BytesReserved;
+
+        Other.Slabs.clear();
+        Other.Cursor         = nullptr;
+        Other.End            = nullptr;
+        Other.NextSlabSize   = Other.InitialSlabSize;
+        Other.BytesAllocated = 0;
+        Other.BytesReserved  = 0;
+    }
+
+    void ArenaAllocator::ReleaseSlabs(const size_t Keep) {
+        while (Slabs.size() > Keep) {
+            std::free(Slabs.back().Memory);
+            Slabs.pop_back();
+        }
+
+        if (Keep == 0) {
+            Cursor        = nullptr;
+            End           = nullptr;
+            BytesReserved = 0;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Vex {
+
+    /**
+     * Bump-pointer allocator backing the AST
+     * Memory is carved out of large slabs and is only released all at once,
+     * either by Reset() or when the allocator is destroyed.
+     * Destructors of objects placed in the arena are never run.
+     */
+    class ArenaAllocator {
+    public:
+        static constexpr size_t DefaultSlabSize = 64 * 1024;
+        static constexpr size_t MaxSlabSize     = 16 * 1024 * 1024;
+
+        explicit ArenaAllocator(size_t InitialSlabSize = DefaultSlabSize);
+        ~ArenaAllocator();
+
+        ArenaAllocator(const ArenaAllocator&) = delete;
+        ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+        ArenaAllocator(ArenaAllocator&& Other) noexcept;
+        ArenaAllocator& operator=(ArenaAllocator&& Other) noexcept;
+
+        void* Allocate(size_t Size, size_t Alignment) {
+            auto Address = reinterpret_cast<uintptr_t>(Cursor);
+            uintptr_t Aligned = (Address + Alignment - 1) & ~(static_cast<uintptr_t>(Alignment) - 1);
+
+            if (Cursor == nullptr || Aligned + Size > reinterpret_cast<uintptr_t>(End)) {
+                return AllocateSlow(Size, Alignment);
+            }
+
+            Cursor = reinterpret_cast<char*>(Aligned + Size);
+            BytesAllocated += Size;
+            return reinterpret_cast<void*>(Aligned);
+        }
+
+        /** Releases every slab but the first one and rewinds the cursor */
+        void Reset();
+
+        /**
+         * Takes ownership of Other's slabs. Everything allocated from Other
+         * stays where it is and is released with this arena; Other is left
+         * empty. Allocation continues in this arena's current slab.
+         */
+        void Adopt(ArenaAllocator&& Other);
+
+        [[nodiscard]] size_t GetBytesAllocated() const { return BytesAllocated; }
+        [[nodiscard]] size_t GetBytesReserved() const { return BytesReserved; }
+        [[nodiscard]] size_t GetSlabCount() const { return Slabs.size(); }
+
+    private:
+        struct Slab {
+            char*  Memory;
+            size_t Size;
+        };
+
+        std::vector<Slab> Slabs;
+        char*  Cursor         = nullptr;
+        char*  End            = nullptr;
+        size_t NextSlabSize;
+        size_t InitialSlabSize;
+        size_t BytesAllocated = 0;
+        size_t BytesReserved  = 0;
+
+        void* AllocateSlow(size_t Size, size_t Alignment);
+        void  ReleaseSlabs(size_t Keep);
+    };
+
+    /**
+     * Fixed-size array living in an arena
+     * Used for child lists (arguments, statements, match cases, ...).
+     * Does not own its elements; the owning ASTContext does.
+     */
+    template<typename T>
+    class ArenaArray {
+    public:
+        using value_type     = T;
+        using iterator       = T*;
+        using const_iterator = const T*;
+
+        ArenaArray() = default;
+        ArenaArray(T* Elements, size_t Count)
+            : Elements(Elements), Count(static_cast<uint32_t>(Count)) {}
+
+        [[nodiscard]] T* begin() const { return Elements; }
+        [[nodiscard]] T* end() const { return Elements + Count; }
+
+        [[nodiscard]] size_t size() const { return Count; }
+        [[nodiscard]] bool empty() const { return Count == 0; }
+        [[nodiscard]] T* data() const { return Elements; }
+
+        T& operator[](size_t Index) const { return Elements[Index]; }
+
+        [[nodiscard]] T& front() const { return Elements[0]; }
+        [[nodiscard]] T& back() const { return Elements[Count - 1]; }
+
+    private:
+        T*       Elements = nullptr;
+        uint32_t Count    = 0;
+    };
+
+} // namespace Vex
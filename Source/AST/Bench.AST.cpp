@@ -0,0 +1,33 @@
+#include <iostream>
+
+// Forward declarations of all benchmark functions
+void Bench_AST_001_ArenaAllocation();
+void Bench_AST_002_FlatTraversal();
+void Bench_AST_003_StaticDispatch();
+void Bench_AST_004_TypeInterning();
+void Bench_AST_005_ModuleLoading();
+void Bench_AST_006_StructuralHashing();
+void Bench_AST_007_SymbolTable();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX AST BENCHMARKS" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Bench_AST_001_ArenaAllocation();
+        Bench_AST_002_FlatTraversal();
+        Bench_AST_003_StaticDispatch();
+        Bench_AST_004_TypeInterning();
+        Bench_AST_005_ModuleLoading();
+        Bench_AST_006_StructuralHashing();
+        Bench_AST_007_SymbolTable();
+
+        std::cout << "\n";
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Benchmark failed with exception: " << E.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,149 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../ASTContext.h"
+#include "../Statement.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    /**
+     * Mirror of the previous node layout: every child is a separate
+     * unique_ptr allocation and strings are owned per node.
+     */
+    struct LegacyExpression {
+        virtual ~LegacyExpression() = default;
+    };
+
+    struct LegacyIdentifier : LegacyExpression {
+        std::string Name;
+        explicit LegacyIdentifier(const std::string& Name) : Name(Name) {}
+    };
+
+    struct LegacyInteger : LegacyExpression {
+        long long Value;
+        explicit LegacyInteger(long long Value) : Value(Value) {}
+    };
+
+    struct LegacyBinary : LegacyExpression {
+        std::unique_ptr<LegacyExpression> Left;
+        EBinaryOp Op;
+        std::unique_ptr<LegacyExpression> Right;
+
+        LegacyBinary(std::unique_ptr<LegacyExpression> Left, EBinaryOp Op, std::unique_ptr<LegacyExpression> Right)
+            : Left(std::move(Left)), Op(Op), Right(std::move(Right)) {}
+    };
+
+    struct LegacyCall : LegacyExpression {
+        std::unique_ptr<LegacyExpression> Callee;
+        std::vector<std::unique_ptr<LegacyExpression>> Arguments;
+
+        explicit LegacyCall(std::unique_ptr<LegacyExpression> Callee) : Callee(std::move(Callee)) {}
+    };
+
+    struct LegacyStatement {
+        std::unique_ptr<LegacyExpression> Expr;
+        explicit LegacyStatement(std::unique_ptr<LegacyExpression> Expr) : Expr(std::move(Expr)) {}
+    };
+
+    // Each statement is: UpdateEntityHealth(CurrentHealth + 10, DamageMultiplier * 2);  -> 8 nodes
+    constexpr int StatementCount = 500000;
+    constexpr int NodesPerStatement = 8;
+
+    std::vector<std::unique_ptr<LegacyStatement>> BuildLegacy() {
+        std::vector<std::unique_ptr<LegacyStatement>> Statements;
+        Statements.reserve(StatementCount);
+
+        for (int Index = 0; Index < StatementCount; ++Index) {
+            auto Call = std::make_unique<LegacyCall>(std::make_unique<LegacyIdentifier>("UpdateEntityHealth"));
+            Call->Arguments.push_back(std::make_unique<LegacyBinary>(
+                std::make_unique<LegacyIdentifier>("CurrentHealth"), EBinaryOp::Add,
+                std::make_unique<LegacyInteger>(10)));
+            Call->Arguments.push_back(std::make_unique<LegacyBinary>(
+                std::make_unique<LegacyIdentifier>("DamageMultiplier"), EBinaryOp::Multiply,
+                std::make_unique<LegacyInteger>(Index)));
+            Statements.push_back(std::make_unique<LegacyStatement>(std::move(Call)));
+        }
+
+        return Statements;
+    }
+
+    BlockStatement* BuildArena(ASTContext& Context) {
+        std::vector<Statement*> Statements;
+        Statements.reserve(StatementCount);
+
+        const std::string_view Callee = Context.Intern("UpdateEntityHealth");
+        const std::string_view Health = Context.Intern("CurrentHealth");
+        const std::string_view Multiplier = Context.Intern("DamageMultiplier");
+
+        Expression* Arguments[2];
+
+        for (int Index = 0; Index < StatementCount; ++Index) {
+            auto* Call = Context.Create<FunctionCall>(Context.Create<Identifier>(Callee));
+            Arguments[0] = Context.Create<BinaryExpression>(
+                Context.Create<Identifier>(Health), EBinaryOp::Add, Context.Create<IntegerLiteral>(10));
+            Arguments[1] = Context.Create<BinaryExpression>(
+                Context.Create<Identifier>(Multiplier), EBinaryOp::Multiply, Context.Create<IntegerLiteral>(Index));
+            Call->Arguments = Context.CreateArray(Arguments, 2);
+            Statements.push_back(Context.Create<ExpressionStatement>(Call));
+        }
+
+        auto* Block = Context.Create<BlockStatement>();
+        Block->Statements = Context.CreateArray(Statements);
+        return Block;
+    }
+}
+
+void Bench_AST_001_ArenaAllocation() {
+    PrintHeader("AST Benchmark 001: Arena vs unique_ptr Allocation");
+
+    constexpr double NodeCount = static_cast<double>(StatementCount) * NodesPerStatement;
+
+    // Arena first: its slabs are returned to the OS on release and don't
+    // leave a warm malloc heap behind for the legacy run.
+    {
+        const size_t ResidentBefore = GetResidentBytes();
+        Stopwatch Timer;
+
+        auto Context = std::make_unique<ASTContext>();
+        BlockStatement* Block = BuildArena(*Context);
+        DoNotOptimize(Block);
+
+        const double BuildTime = Timer.ElapsedMilliseconds();
+        const size_t ResidentAfter = GetResidentBytes();
+
+        Timer.Restart();
+        Context.reset();
+        const double DestroyTime = Timer.ElapsedMilliseconds();
+
+        PrintRow("Arena build", BuildTime, "ms");
+        PrintRow("Arena throughput", NodeCount / BuildTime / 1000.0, "M nodes/s");
+        PrintRow("Arena destroy", DestroyTime, "ms");
+        PrintRow("Arena RSS growth", static_cast<double>(ResidentAfter - ResidentBefore) / (1024.0 * 1024.0), "MB");
+    }
+
+    {
+        const size_t ResidentBefore = GetResidentBytes();
+        Stopwatch Timer;
+
+        auto Statements = BuildLegacy();
+        DoNotOptimize(Statements);
+
+        const double BuildTime = Timer.ElapsedMilliseconds();
+        const size_t ResidentAfter = GetResidentBytes();
+
+        Timer.Restart();
+        Statements.clear();
+        const double DestroyTime = Timer.ElapsedMilliseconds();
+
+        PrintRow("unique_ptr build", BuildTime, "ms");
+        PrintRow("unique_ptr throughput", NodeCount / BuildTime / 1000.0, "M nodes/s");
+        PrintRow("unique_ptr destroy", DestroyTime, "ms");
+        PrintRow("unique_ptr RSS growth", static_cast<double>(ResidentAfter - ResidentBefore) / (1024.0 * 1024.0), "MB");
+    }
+
+    std::cout << "\n";
+}
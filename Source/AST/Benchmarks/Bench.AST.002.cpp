@@ -0,0 +1,215 @@
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../ASTContext.h"
+#include "../ASTVisitor.h"
+#include "../Declaration.h"
+#include "../FlatAST.h"
+#include "../Statement.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    /**
+     * Counts nodes per kind through Accept() and the virtual ASTVisitor
+     */
+    class CountingVisitor final : public ASTVisitor {
+    public:
+        std::array<size_t, NodeKindCount> Counts{};
+
+        void Visit(IntegerLiteral&) override { Count(ENodeKind::IntegerLiteral); }
+        void Visit(FloatLiteral&) override { Count(ENodeKind::FloatLiteral); }
+        void Visit(StringLiteral&) override { Count(ENodeKind::StringLiteral); }
+        void Visit(CharLiteral&) override { Count(ENodeKind::CharLiteral); }
+        void Visit(BoolLiteral&) override { Count(ENodeKind::BoolLiteral); }
+        void Visit(NullLiteral&) override { Count(ENodeKind::NullLiteral); }
+        void Visit(Identifier&) override { Count(ENodeKind::Identifier); }
+        void Visit(BinaryExpression& Node) override { Count(ENodeKind::BinaryExpression); Walk(Node.Left); Walk(Node.Right); }
+        void Visit(UnaryExpression& Node) override { Count(ENodeKind::UnaryExpression); Walk(Node.Operand); }
+        void Visit(FunctionCall& Node) override {
+            Count(ENodeKind::FunctionCall);
+            Walk(Node.Callee);
+            for (auto* Argument : Node.Arguments) { Walk(Argument); }
+        }
+        void Visit(MemberAccess& Node) override { Count(ENodeKind::MemberAccess); Walk(Node.Object); }
+        void Visit(IndexAccess& Node) override { Count(ENodeKind::IndexAccess); Walk(Node.Object); Walk(Node.Index); }
+        void Visit(TernaryExpression& Node) override {
+            Count(ENodeKind::TernaryExpression); Walk(Node.Condition); Walk(Node.TrueExpr); Walk(Node.FalseExpr);
+        }
+        void Visit(CastExpression& Node) override { Count(ENodeKind::CastExpression); Walk(Node.Expr); }
+        void Visit(NewExpression& Node) override {
+            Count(ENodeKind::NewExpression);
+            for (auto* Argument : Node.Arguments) { Walk(Argument); }
+        }
+        void Visit(ThisExpression&) override { Count(ENodeKind::ThisExpression); }
+        void Visit(SuperExpression&) override { Count(ENodeKind::SuperExpression); }
+        void Visit(GroupingExpression& Node) override { Count(ENodeKind::GroupingExpression); Walk(Node.Expr); }
+
+        void Visit(VariableDeclaration& Node) override { Count(ENodeKind::VariableDeclaration); Walk(Node.Initializer); }
+        void Visit(ExpressionStatement& Node) override { Count(ENodeKind::ExpressionStatement); Walk(Node.Expr); }
+        void Visit(BlockStatement& Node) override {
+            Count(ENodeKind::BlockStatement);
+            for (auto* Stmt : Node.Statements) { Walk(Stmt); }
+        }
+        void Visit(IfStatement& Node) override {
+            Count(ENodeKind::IfStatement); Walk(Node.Condition); Walk(Node.ThenBranch); Walk(Node.ElseBranch);
+        }
+        void Visit(WhileStatement& Node) override { Count(ENodeKind::WhileStatement); Walk(Node.Condition); Walk(Node.Body); }
+        void Visit(DoWhileStatement& Node) override { Count(ENodeKind::DoWhileStatement); Walk(Node.Body); Walk(Node.Condition); }
+        void Visit(ForStatement& Node) override {
+            Count(ENodeKind::ForStatement);
+            Walk(Node.RangeStart); Walk(Node.RangeEnd); Walk(Node.Step); Walk(Node.Body);
+        }
+        void Visit(ReturnStatement& Node) override { Count(ENodeKind::ReturnStatement); Walk(Node.Value); }
+        void Visit(BreakStatement&) override { Count(ENodeKind::BreakStatement); }
+        void Visit(ContinueStatement&) override { Count(ENodeKind::ContinueStatement); }
+        void Visit(MatchStatement& Node) override {
+            Count(ENodeKind::MatchStatement);
+            Walk(Node.Value);
+            for (const auto& Case : Node.Cases) { Walk(Case.Pattern); Walk(Case.Body); }
+        }
+
+        void Visit(FieldDeclaration& Node) override { Count(ENodeKind::FieldDeclaration); Walk(Node.Initializer); }
+        void Visit(FunctionDeclaration& Node) override {
+            Count(ENodeKind::FunctionDeclaration);
+            for (const auto& Param : Node.Parameters) { Walk(Param.DefaultValue); }
+            Walk(Node.Body);
+        }
+        void Visit(DefineDeclaration& Node) override {
+            Count(ENodeKind::DefineDeclaration);
+            for (auto* Field : Node.Fields) { Walk(Field); }
+            for (auto* Method : Node.Methods) { Walk(Method); }
+        }
+        void Visit(FetchDeclaration& Node) override {
+            Count(ENodeKind::FetchDeclaration);
+            for (auto* Method : Node.Methods) { Walk(Method); }
+        }
+        void Visit(SetDeclaration& Node) override {
+            Count(ENodeKind::SetDeclaration);
+            for (auto* Method : Node.Methods) { Walk(Method); }
+        }
+        void Visit(InterfaceDeclaration& Node) override {
+            Count(ENodeKind::InterfaceDeclaration);
+            for (auto* Method : Node.Methods) { Walk(Method); }
+        }
+        void Visit(NamespaceDeclaration& Node) override {
+            Count(ENodeKind::NamespaceDeclaration);
+            for (auto* Decl : Node.Declarations) { Walk(Decl); }
+        }
+        void Visit(UsingDeclaration&) override { Count(ENodeKind::UsingDeclaration); }
+        void Visit(GlobalDeclaration& Node) override { Count(ENodeKind::GlobalDeclaration); Walk(Node.Variable); }
+        void Visit(TranslationUnit& Node) override {
+            Count(ENodeKind::TranslationUnit);
+            for (auto* Decl : Node.Declarations) { Walk(Decl); }
+        }
+
+    private:
+        void Count(const ENodeKind Kind) { ++Counts[static_cast<size_t>(Kind)]; }
+
+        void Walk(ASTNode* Node) {
+            if (Node != nullptr) {
+                Node->Accept(*this);
+            }
+        }
+    };
+
+    constexpr int StatementCount = 200000;
+
+    BlockStatement* BuildTree(ASTContext& Context) {
+        std::vector<Statement*> Statements;
+        Statements.reserve(StatementCount);
+
+        const std::string_view Names[] = {
+            Context.Intern("Health"), Context.Intern("Armor"), Context.Intern("Speed"), Context.Intern("Target")
+        };
+
+        for (int Index = 0; Index < StatementCount; ++Index) {
+            auto* Name = Context.Create<Identifier>(Names[Index % 4]);
+
+            // if Health - Damage * 2 <= 0 { Die(Health); } else { Health = Health; }
+            auto* Condition = Context.Create<BinaryExpression>(
+                Context.Create<BinaryExpression>(
+                    Name, EBinaryOp::Subtract,
+                    Context.Create<BinaryExpression>(Context.Create<Identifier>(Names[(Index + 1) % 4]),
+                                                     EBinaryOp::Multiply, Context.Create<IntegerLiteral>(Index))),
+                EBinaryOp::LessEqual, Context.Create<IntegerLiteral>(0));
+
+            auto* Call = Context.Create<FunctionCall>(
+                Context.Create<MemberAccess>(Context.Create<ThisExpression>(), Names[(Index + 2) % 4]));
+            Expression* Arguments[] = { Context.Create<Identifier>(Names[(Index + 3) % 4]) };
+            Call->Arguments = Context.CreateArray(Arguments, 1);
+
+            auto* Then = Context.Create<BlockStatement>();
+            Statement* ThenStatements[] = { Context.Create<ExpressionStatement>(Call) };
+            Then->Statements = Context.CreateArray(ThenStatements, 1);
+
+            auto* Else = Context.Create<ReturnStatement>(Context.Create<FloatLiteral>(Index * 0.5));
+
+            Statements.push_back(Context.Create<IfStatement>(Condition, Then, Else));
+        }
+
+        auto* Block = Context.Create<BlockStatement>();
+        Block->Statements = Context.CreateArray(Statements);
+        return Block;
+    }
+}
+
+void Bench_AST_002_FlatTraversal() {
+    PrintHeader("AST Benchmark 002: Pointer Tree vs Flat AST Passes");
+
+    ASTContext Context;
+    BlockStatement* Tree = BuildTree(Context);
+
+    Stopwatch Timer;
+    FlatAST Flat;
+    const NodeIndex Root = Flat.Append(Tree);
+    PrintRow("Flatten", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Nodes", static_cast<double>(Flat.Size()), "");
+
+    constexpr int Iterations = 20;
+
+    Timer.Restart();
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+        CountingVisitor Visitor;
+        Tree->Accept(Visitor);
+        DoNotOptimize(Visitor.Counts);
+    }
+    PrintRow("Count (pointer, ASTVisitor)", Timer.ElapsedMilliseconds() / Iterations, "ms");
+
+    Timer.Restart();
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+        const auto Counts = Flat.CountKinds(Root);
+        DoNotOptimize(Counts);
+    }
+    PrintRow("Count (flat, linear scan)", Timer.ElapsedMilliseconds() / Iterations, "ms");
+
+    Timer.Restart();
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+        const auto Hashes = Flat.ComputeHashes(Root);
+        DoNotOptimize(Hashes);
+    }
+    PrintRow("Hash (flat, linear scan)", Timer.ElapsedMilliseconds() / Iterations, "ms");
+
+    Timer.Restart();
+    const std::string TreeText = Tree->ToString();
+    DoNotOptimize(TreeText);
+    PrintRow("Print (pointer, ToString)", Timer.ElapsedMilliseconds(), "ms");
+
+    Timer.Restart();
+    const std::string FlatText = Flat.ToString(Root);
+    DoNotOptimize(FlatText);
+    PrintRow("Print (flat, linear scan)", Timer.ElapsedMilliseconds(), "ms");
+
+    Timer.Restart();
+    ASTContext Rebuilt;
+    DoNotOptimize(Flat.ToTree(Root, Rebuilt));
+    PrintRow("Rebuild pointer tree", Timer.ElapsedMilliseconds(), "ms");
+
+    PrintRow("Arena bytes per node", static_cast<double>(Context.GetBytesAllocated()) / Flat.Size(), "B");
+    PrintRow("Flat bytes per node", static_cast<double>(sizeof(FlatNode) + sizeof(SourceLocation) + sizeof(NodeIndex)), "B");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../ASTContext.h"
+#include "../ASTVisitor.h"
+#include "../Declaration.h"
+#include "../StaticVisitor.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    /**
+     * Baseline: sums integer literals through Accept() and the virtual ASTVisitor
+     */
+    class VirtualSum final : public ASTVisitor {
+    public:
+        long long Sum = 0;
+        size_t Nodes = 0;
+
+        void Visit(IntegerLiteral& Node) override { ++Nodes; Sum += Node.Value; }
+        void Visit(FloatLiteral&) override { ++Nodes; }
+        void Visit(StringLiteral&) override { ++Nodes; }
+        void Visit(CharLiteral&) override { ++Nodes; }
+        void Visit(BoolLiteral&) override { ++Nodes; }
+        void Visit(NullLiteral&) override { ++Nodes; }
+        void Visit(Identifier&) override { ++Nodes; }
+        void Visit(BinaryExpression& Node) override { ++Nodes; Walk(Node.Left); Walk(Node.Right); }
+        void Visit(UnaryExpression& Node) override { ++Nodes; Walk(Node.Operand); }
+        void Visit(FunctionCall& Node) override {
+            ++Nodes;
+            Walk(Node.Callee);
+            for (auto* Argument : Node.Arguments) { Walk(Argument); }
+        }
+        void Visit(MemberAccess& Node) override { ++Nodes; Walk(Node.Object); }
+        void Visit(IndexAccess& Node) override { ++Nodes; Walk(Node.Object); Walk(Node.Index); }
+        void Visit(TernaryExpression& Node) override { ++Nodes; Walk(Node.Condition); Walk(Node.TrueExpr); Walk(Node.FalseExpr); }
+        void Visit(CastExpression& Node) override { ++Nodes; Walk(Node.Expr); }
+        void Visit(NewExpression& Node) override {
+            ++Nodes;
+            for (auto* Argument : Node.Arguments) { Walk(Argument); }
+        }
+        void Visit(ThisExpression&) override { ++Nodes; }
+        void Visit(SuperExpression&) override { ++Nodes; }
+        void Visit(GroupingExpression& Node) override { ++Nodes; Walk(Node.Expr); }
+
+        void Visit(VariableDeclaration& Node) override { ++Nodes; Walk(Node.Initializer); }
+        void Visit(ExpressionStatement& Node) override { ++Nodes; Walk(Node.Expr); }
+        void Visit(BlockStatement& Node) override {
+            ++Nodes;
+            for (auto* Stmt : Node.Statements) { Walk(Stmt); }
+        }
+        void Visit(IfStatement& Node) override { ++Nodes; Walk(Node.Condition); Walk(Node.ThenBranch); Walk(Node.ElseBranch); }
+        void Visit(WhileStatement& Node) override { ++Nodes; Walk(Node.Condition); Walk(Node.Body); }
+        void Visit(DoWhileStatement& Node) override { ++Nodes; Walk(Node.Body); Walk(Node.Condition); }
+        void Visit(ForStatement& Node) override {
+            ++Nodes; Walk(Node.RangeStart); Walk(Node.RangeEnd); Walk(Node.Step); Walk(Node.Body);
+        }
+        void Visit(ReturnStatement& Node) override { ++Nodes; Walk(Node.Value); }
+        void Visit(BreakStatement&) override { ++Nodes; }
+        void Visit(ContinueStatement&) override { ++Nodes; }
+        void Visit(MatchStatement& Node) override {
+            ++Nodes;
+            Walk(Node.Value);
+            for (const auto& Case : Node.Cases) { Walk(Case.Pattern); Walk(Case.Body); }
+        }
+
+        void Visit(FieldDeclaration& Node) override { ++Nodes; Walk(Node.Initializer); }
+        void Visit(FunctionDeclaration& Node) override {
+            ++Nodes;
+            for (const auto& Param : Node.Parameters) { Walk(Param.DefaultValue); }
+            Walk(Node.Body);
+        }
+        void Visit(DefineDeclaration& Node) override {
+            ++Nodes;
+            for (auto* Field : Node.Fields) { Walk(Field); }
+            for (auto* Method : Node.Methods) { Walk(Method); }
+        }
+        void Visit(FetchDeclaration& Node) override { ++Nodes; for (auto* Method : Node.Methods) { Walk(Method); } }
+        void Visit(SetDeclaration& Node) override { ++Nodes; for (auto* Method : Node.Methods) { Walk(Method); } }
+        void Visit(InterfaceDeclaration& Node) override { ++Nodes; for (auto* Method : Node.Methods) { Walk(Method); } }
+        void Visit(NamespaceDeclaration& Node) override { ++Nodes; for (auto* Decl : Node.Declarations) { Walk(Decl); } }
+        void Visit(UsingDeclaration&) override { ++Nodes; }
+        void Visit(GlobalDeclaration& Node) override { ++Nodes; Walk(Node.Variable); }
+        void Visit(TranslationUnit& Node) override { ++Nodes; for (auto* Decl : Node.Declarations) { Walk(Decl); } }
+
+    private:
+        void Walk(ASTNode* Node) {
+            if (Node != nullptr) {
+                Node->Accept(*this);
+            }
+        }
+    };
+
+    /**
+     * Same pass on the tag-dispatched visitor
+     */
+    class StaticSum final : public StaticVisitor<StaticSum> {
+    public:
+        long long Sum = 0;
+        size_t Nodes = 0;
+
+        void VisitIntegerLiteral(IntegerLiteral& Node) { ++Nodes; Sum += Node.Value; }
+
+        void VisitNode(ASTNode&) { ++Nodes; }
+    };
+
+    long long Apply(const EBinaryOp Op, const long long Left, const long long Right) {
+        switch (Op) {
+            case EBinaryOp::Add:        return Left + Right;
+            case EBinaryOp::Subtract:   return Left - Right;
+            case EBinaryOp::Multiply:   return Left * Right;
+            case EBinaryOp::Divide:     return Right != 0 ? Left / Right : 0;
+            default:                    return 0;
+        }
+    }
+
+    /**
+     * Baseline evaluator: Accept() returns void, so results travel through a member
+     */
+    class VirtualEval final : public ASTVisitor {
+    public:
+        long long Result = 0;
+
+        long long Evaluate(ASTNode* Node) {
+            Node->Accept(*this);
+            return Result;
+        }
+
+        void Visit(IntegerLiteral& Node) override { Result = Node.Value; }
+        void Visit(FloatLiteral&) override { Result = 0; }
+        void Visit(StringLiteral&) override { Result = 0; }
+        void Visit(CharLiteral&) override { Result = 0; }
+        void Visit(BoolLiteral&) override { Result = 0; }
+        void Visit(NullLiteral&) override { Result = 0; }
+        void Visit(Identifier&) override { Result = 1; }
+        void Visit(BinaryExpression& Node) override {
+            const long long Left = Evaluate(Node.Left);
+            Result = Apply(Node.Op, Left, Evaluate(Node.Right));
+        }
+        void Visit(UnaryExpression& Node) override { Result = -Evaluate(Node.Operand); }
+        void Visit(FunctionCall&) override { Result = 0; }
+        void Visit(MemberAccess&) override { Result = 0; }
+        void Visit(IndexAccess&) override { Result = 0; }
+        void Visit(TernaryExpression&) override { Result = 0; }
+        void Visit(CastExpression&) override { Result = 0; }
+        void Visit(NewExpression&) override { Result = 0; }
+        void Visit(ThisExpression&) override { Result = 0; }
+        void Visit(SuperExpression&) override { Result = 0; }
+        void Visit(GroupingExpression& Node) override { Result = Evaluate(Node.Expr); }
+
+        void Visit(VariableDeclaration& Node) override { Result = Evaluate(Node.Initializer); }
+        void Visit(ExpressionStatement&) override { Result = 0; }
+        void Visit(BlockStatement& Node) override {
+            long long Total = 0;
+            for (auto* Stmt : Node.Statements) { Total += Evaluate(Stmt); }
+            Result = Total;
+        }
+        void Visit(IfStatement&) override { Result = 0; }
+        void Visit(WhileStatement&) override { Result = 0; }
+        void Visit(DoWhileStatement&) override { Result = 0; }
+        void Visit(ForStatement&) override { Result = 0; }
+        void Visit(ReturnStatement&) override { Result = 0; }
+        void Visit(BreakStatement&) override { Result = 0; }
+        void Visit(ContinueStatement&) override { Result = 0; }
+        void Visit(MatchStatement&) override { Result = 0; }
+
+        void Visit(FieldDeclaration&) override { Result = 0; }
+        void Visit(FunctionDeclaration&) override { Result = 0; }
+        void Visit(DefineDeclaration&) override { Result = 0; }
+        void Visit(FetchDeclaration&) override { Result = 0; }
+        void Visit(SetDeclaration&) override { Result = 0; }
+        void Visit(InterfaceDeclaration&) override { Result = 0; }
+        void Visit(NamespaceDeclaration&) override { Result = 0; }
+        void Visit(UsingDeclaration&) override { Result = 0; }
+        void Visit(GlobalDeclaration&) override { Result = 0; }
+        void Visit(TranslationUnit&) override { Result = 0; }
+    };
+
+    /**
+     * Same evaluator returning values directly
+     */
+    class StaticEval final : public StaticVisitor<StaticEval, long long> {
+    public:
+        long long VisitIntegerLiteral(IntegerLiteral& Node) { return Node.Value; }
+        long long VisitIdentifier(Identifier&) { return 1; }
+        long long VisitBinaryExpression(BinaryExpression& Node) {
+            const long long Left = Visit(Node.Left);
+            return Apply(Node.Op, Left, Visit(Node.Right));
+        }
+        long long VisitUnaryExpression(UnaryExpression& Node) { return -Visit(Node.Operand); }
+        long long VisitGroupingExpression(GroupingExpression& Node) { return Visit(Node.Expr); }
+        long long VisitVariableDeclaration(VariableDeclaration& Node) { return Visit(Node.Initializer); }
+        long long VisitBlockStatement(BlockStatement& Node) {
+            long long Total = 0;
+            for (auto* Stmt : Node.Statements) { Total += Visit(Stmt); }
+            return Total;
+        }
+    };
+
+    constexpr int StatementCount = 100000;
+
+    BlockStatement* BuildTree(ASTContext& Context) {
+        std::vector<Statement*> Statements;
+        Statements.reserve(StatementCount);
+
+        const std::string_view Health = Context.Intern("Health");
+        const std::string_view Armor = Context.Intern("Armor");
+
+        for (int Index = 0; Index < StatementCount; ++Index) {
+            // Let X = (Health - Armor * I) + -(I / 3);  (10 nodes)
+            auto* Value = Context.Create<BinaryExpression>(
+                Context.Create<BinaryExpression>(
+                    Context.Create<Identifier>(Health), EBinaryOp::Subtract,
+                    Context.Create<BinaryExpression>(Context.Create<Identifier>(Armor), EBinaryOp::Multiply,
+                                                     Context.Create<IntegerLiteral>(Index))),
+                EBinaryOp::Add,
+                Context.Create<UnaryExpression>(EUnaryOp::Minus, Context.Create<BinaryExpression>(
+                    Context.Create<IntegerLiteral>(Index), EBinaryOp::Divide, Context.Create<IntegerLiteral>(3))));
+
+            Statements.push_back(Context.Create<VariableDeclaration>(false, true, Health, nullptr, Value));
+        }
+
+        auto* Block = Context.Create<BlockStatement>();
+        Block->Statements = Context.CreateArray(Statements);
+        return Block;
+    }
+}
+
+void Bench_AST_003_StaticDispatch() {
+    PrintHeader("AST Benchmark 003: ASTVisitor vs StaticVisitor Dispatch");
+
+    ASTContext Context;
+    BlockStatement* Tree = BuildTree(Context);
+
+    constexpr int Rounds = 5;
+    constexpr int Iterations = 10;
+
+    // Alternate the two passes and keep the best round of each
+    VirtualSum Virtual;
+    StaticSum Static;
+    double VirtualTime = 1e30;
+    double StaticTime = 1e30;
+    double VirtualEvalTime = 1e30;
+    double StaticEvalTime = 1e30;
+    long long VirtualResult = 0;
+    long long StaticResult = 0;
+
+    for (int Round = 0; Round < Rounds; ++Round) {
+        Stopwatch Timer;
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+            Virtual = VirtualSum();
+            Tree->Accept(Virtual);
+            DoNotOptimize(Virtual.Sum);
+        }
+        VirtualTime = std::min(VirtualTime, Timer.ElapsedMilliseconds() / Iterations);
+
+        Timer.Restart();
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+            Static = StaticSum();
+            Static.Visit(Tree);
+            DoNotOptimize(Static.Sum);
+        }
+        StaticTime = std::min(StaticTime, Timer.ElapsedMilliseconds() / Iterations);
+
+        Timer.Restart();
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+            VirtualEval Eval;
+            VirtualResult = Eval.Evaluate(Tree);
+            DoNotOptimize(VirtualResult);
+        }
+        VirtualEvalTime = std::min(VirtualEvalTime, Timer.ElapsedMilliseconds() / Iterations);
+
+        Timer.Restart();
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+            StaticEval Eval;
+            StaticResult = Eval.Visit(Tree);
+            DoNotOptimize(StaticResult);
+        }
+        StaticEvalTime = std::min(StaticEvalTime, Timer.ElapsedMilliseconds() / Iterations);
+    }
+
+    PrintRow("Nodes", static_cast<double>(Static.Nodes), "");
+    PrintRow("Walk (ASTVisitor)", VirtualTime, "ms");
+    PrintRow("Walk (StaticVisitor)", StaticTime, "ms");
+    PrintRow("Walk speedup", VirtualTime / StaticTime, "x");
+    PrintRow("Evaluate (ASTVisitor, via member)", VirtualEvalTime, "ms");
+    PrintRow("Evaluate (StaticVisitor, returned)", StaticEvalTime, "ms");
+    PrintRow("Evaluate speedup", VirtualEvalTime / StaticEvalTime, "x");
+    PrintRow("sizeof(BinaryExpression)", static_cast<double>(sizeof(BinaryExpression)), "B");
+    PrintRow("Results agree", Virtual.Sum == Static.Sum && Virtual.Nodes == Static.Nodes &&
+                              VirtualResult == StaticResult ? 1.0 : 0.0, "");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../ASTContext.h"
+#include "../Statement.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int AnnotationCount = 1000000;
+
+    // Type annotations as a parser sees them: text that lives in the source buffer
+    struct Annotation {
+        std::string Name;
+        bool IsShared;
+        bool IsPointer;
+        std::vector<std::string> MemberPath;
+
+        Annotation(std::string Name, const bool IsShared = false, const bool IsPointer = false,
+                   std::vector<std::string> MemberPath = {})
+            : Name(std::move(Name)), IsShared(IsShared), IsPointer(IsPointer), MemberPath(std::move(MemberPath)) {}
+    };
+
+    std::vector<Annotation> MakeAnnotations() {
+        return {
+            { "Int_32" }, { "Float" }, { "Bool" }, { "Int_32", true },
+            { "Entity", false, true }, { "Entity", false, false, { "Health" } },
+            { "Vector3" }, { "String" },
+        };
+    }
+
+    TypeRef* CopyType(ASTContext& Context, const Annotation& Source) {
+        auto* Type = Context.Create<TypeRef>(Context.Intern(Source.Name));
+        Type->IsShared = Source.IsShared;
+        Type->IsPointer = Source.IsPointer;
+
+        std::vector<std::string_view> Path;
+        for (const auto& Member : Source.MemberPath) {
+            Path.push_back(Context.Intern(Member));
+        }
+        Type->MemberPath = Context.CreateArray(Path);
+        return Type;
+    }
+
+    const TypeRef* InternType(ASTContext& Context, const Annotation& Source) {
+        std::string_view Path[4];
+        for (size_t Index = 0; Index < Source.MemberPath.size(); ++Index) {
+            Path[Index] = Source.MemberPath[Index];
+        }
+
+        TypeRef Key(Source.Name);
+        Key.IsShared = Source.IsShared;
+        Key.IsPointer = Source.IsPointer;
+        Key.MemberPath = ArenaArray<std::string_view>(Path, Source.MemberPath.size());
+        return Context.GetTypes().Get(Key);
+    }
+
+    bool StructurallyEqual(const TypeRef* Left, const TypeRef* Right) {
+        return Left->Name == Right->Name && Left->IsPointer == Right->IsPointer &&
+               Left->IsUnique == Right->IsUnique && Left->IsShared == Right->IsShared &&
+               Left->IsBorrow == Right->IsBorrow &&
+               std::equal(Left->MemberPath.begin(), Left->MemberPath.end(),
+                          Right->MemberPath.begin(), Right->MemberPath.end()) &&
+               std::equal(Left->AllowedFields.begin(), Left->AllowedFields.end(),
+                          Right->AllowedFields.begin(), Right->AllowedFields.end());
+    }
+}
+
+void Bench_AST_004_TypeInterning() {
+    PrintHeader("AST Benchmark 004: Per-Use vs Interned Type References");
+
+    const std::vector<Annotation> Annotations = MakeAnnotations();
+
+    std::vector<const TypeRef*> CopiedTypes(AnnotationCount);
+    std::vector<const TypeRef*> InternedTypes(AnnotationCount);
+
+    ASTContext Copied;
+    Stopwatch Timer;
+    for (int Index = 0; Index < AnnotationCount; ++Index) {
+        CopiedTypes[Index] = CopyType(Copied, Annotations[Index % Annotations.size()]);
+    }
+    PrintRow("Build (one TypeRef per use)", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Type memory (one per use)", static_cast<double>(Copied.GetBytesAllocated()) / (1024.0 * 1024.0), "MB");
+
+    ASTContext Interned;
+    Timer.Restart();
+    for (int Index = 0; Index < AnnotationCount; ++Index) {
+        InternedTypes[Index] = InternType(Interned, Annotations[Index % Annotations.size()]);
+    }
+    PrintRow("Build (TypeTable)", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Type memory (TypeTable)", static_cast<double>(Interned.GetBytesAllocated()) / 1024.0, "KB");
+    PrintRow("Distinct types", static_cast<double>(Interned.GetTypes().Size()), "");
+
+    // Compare every annotation with a fixed one, as a type checker would
+    size_t StructuralMatches = 0;
+    Timer.Restart();
+    for (int Index = 0; Index < AnnotationCount; ++Index) {
+        StructuralMatches += StructurallyEqual(CopiedTypes[Index], CopiedTypes[3]) ? 1 : 0;
+    }
+    DoNotOptimize(StructuralMatches);
+    PrintRow("Equality (structural)", Timer.ElapsedMilliseconds(), "ms");
+
+    size_t PointerMatches = 0;
+    Timer.Restart();
+    for (int Index = 0; Index < AnnotationCount; ++Index) {
+        PointerMatches += InternedTypes[Index] == InternedTypes[3] ? 1 : 0;
+    }
+    DoNotOptimize(PointerMatches);
+    PrintRow("Equality (pointer)", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Results agree", StructuralMatches == PointerMatches ? 1.0 : 0.0, "");
+
+    std::cout << "\n";
+}
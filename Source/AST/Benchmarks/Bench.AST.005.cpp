@@ -0,0 +1,109 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../ASTContext.h"
+#include "../Declaration.h"
+#include "../FlatAST.h"
+#include "../Module.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int DefineCount = 20000;
+
+    /**
+     * Namespace Engine { Define Type_I { X -> Float; Y -> Float; Length() -> Float { return (X * X) + (Y * Y); } } ... }
+     */
+    TranslationUnit* BuildLibrary(ASTContext& Context) {
+        const TypeRef* Float = Context.GetType("Float");
+        const std::string_view X = Context.Intern("X");
+        const std::string_view Y = Context.Intern("Y");
+
+        std::vector<Declaration*> Defines;
+        Defines.reserve(DefineCount);
+
+        for (int Index = 0; Index < DefineCount; ++Index) {
+            std::vector<FieldDeclaration*> Fields = {
+                Context.Create<FieldDeclaration>(EAccessModifier::PUBLIC, X, Float),
+                Context.Create<FieldDeclaration>(EAccessModifier::PUBLIC, Y, Float),
+            };
+
+            auto* Body = Context.Create<BlockStatement>();
+            std::vector<Statement*> Statements = { Context.Create<ReturnStatement>(Context.Create<BinaryExpression>(
+                Context.Create<BinaryExpression>(Context.Create<Identifier>(X), EBinaryOp::Multiply, Context.Create<Identifier>(X)),
+                EBinaryOp::Add,
+                Context.Create<BinaryExpression>(Context.Create<Identifier>(Y), EBinaryOp::Multiply, Context.Create<Identifier>(Y)))) };
+            Body->Statements = Context.CreateArray(Statements);
+
+            std::vector<FunctionDeclaration*> Methods = {
+                Context.Create<FunctionDeclaration>(EAccessModifier::PUBLIC, Context.Intern("Length"), Float, Body),
+            };
+
+            auto* Define = Context.Create<DefineDeclaration>(Context.Intern("Type_" + std::to_string(Index)));
+            Define->Fields = Context.CreateArray(Fields);
+            Define->Methods = Context.CreateArray(Methods);
+            Defines.push_back(Define);
+        }
+
+        auto* Engine = Context.Create<NamespaceDeclaration>(Context.Intern("Engine"));
+        Engine->Declarations = Context.CreateArray(Defines);
+
+        auto* Unit = Context.Create<TranslationUnit>(Context.Intern("Engine.vex"));
+        std::vector<Declaration*> Declarations = { Engine };
+        Unit->Declarations = Context.CreateArray(Declarations);
+        return Unit;
+    }
+}
+
+void Bench_AST_005_ModuleLoading() {
+    PrintHeader("AST Benchmark 005: Precompiled Modules");
+
+    ASTContext Context;
+    TranslationUnit* Unit = BuildLibrary(Context);
+    const std::string Path = (std::filesystem::temp_directory_path() / "Bench.AST.005.vexm").string();
+
+    Stopwatch Timer;
+    FlatAST Flat;
+    const NodeIndex Root = Flat.Append(Unit);
+    ModuleWriter::WriteFile(Flat, Path);
+    PrintRow("Nodes", static_cast<double>(Flat.Size()), "");
+    PrintRow("Flatten + write", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Module size", static_cast<double>(std::filesystem::file_size(Path)) / (1024.0 * 1024.0), "MB");
+
+    // Importing without a module means rebuilding the whole tree
+    Timer.Restart();
+    ASTContext Rebuilt;
+    DoNotOptimize(Flat.ToTree(Root, Rebuilt));
+    PrintRow("Rebuild whole tree", Timer.ElapsedMilliseconds(), "ms");
+
+    Timer.Restart();
+    ModuleFile Module;
+    const bool Opened = Module.Open(Path);
+    PrintRow("Open (map + validate)", Timer.ElapsedMilliseconds(), "ms");
+
+    constexpr int Lookups = 1000;
+    Timer.Restart();
+    ASTContext Imported;
+    size_t Found = 0;
+    for (int Index = 0; Index < Lookups; ++Index) {
+        const NodeIndex Symbol = Module.FindSymbol("Engine::Type_" + std::to_string(Index * 17 % DefineCount));
+        Found += Symbol != InvalidNode && Module.ToTree(Symbol, Imported) != nullptr ? 1 : 0;
+    }
+    PrintRow("Find + import 1000 Defines", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Imported arena bytes", static_cast<double>(Imported.GetBytesAllocated()) / 1024.0, "KB");
+    PrintRow("Rebuilt arena bytes", static_cast<double>(Rebuilt.GetBytesAllocated()) / 1024.0, "KB");
+
+    Timer.Restart();
+    const uint64_t MappedHash = Module.Hash(Module.GetRoots()[0]);
+    PrintRow("Hash in place", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Results agree", Opened && Found == Lookups && MappedHash == Flat.Hash(Root) ? 1.0 : 0.0, "");
+
+    Module.Close();
+    std::remove(Path.c_str());
+
+    std::cout << "\n";
+}
@@ -0,0 +1,136 @@
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../ASTContext.h"
+#include "../Declaration.h"
+#include "../StructuralHash.h"
+#include "../TreeWalker.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int FunctionCount = 50000;
+    constexpr int VariantCount = 500;
+
+    /**
+     * Generated accessors that often repeat:
+     * Get_I(Self: Entity) -> Float { if Self.Alive { return Self.Field_V * Scale_V + 1; } return 0; }
+     */
+    std::vector<FunctionDeclaration*> BuildFunctions(ASTContext& Context) {
+        const TypeRef* Float = Context.GetType("Float");
+        const TypeRef* Entity = Context.GetType("Entity");
+        const std::string_view Self = Context.Intern("Self");
+
+        std::vector<FunctionDeclaration*> Functions;
+        Functions.reserve(FunctionCount);
+
+        for (int Index = 0; Index < FunctionCount; ++Index) {
+            const std::string Variant = std::to_string(Index % VariantCount);
+            const auto Member = [&](const std::string_view Name) {
+                return Context.Create<MemberAccess>(Context.Create<Identifier>(Self), Name);
+            };
+
+            auto* Value = Context.Create<BinaryExpression>(
+                Context.Create<BinaryExpression>(Member(Context.Intern("Field_" + Variant)), EBinaryOp::Multiply,
+                                                 Context.Create<Identifier>(Context.Intern("Scale_" + Variant))),
+                EBinaryOp::Add, Context.Create<IntegerLiteral>(1));
+
+            auto* Then = Context.Create<BlockStatement>();
+            std::vector<Statement*> ThenStatements = { Context.Create<ReturnStatement>(Value) };
+            Then->Statements = Context.CreateArray(ThenStatements);
+
+            auto* Body = Context.Create<BlockStatement>();
+            std::vector<Statement*> Statements = {
+                Context.Create<IfStatement>(Member(Context.Intern("Alive")), Then),
+                Context.Create<ReturnStatement>(Context.Create<IntegerLiteral>(0)),
+            };
+            Body->Statements = Context.CreateArray(Statements);
+
+            auto* Function = Context.Create<FunctionDeclaration>(EAccessModifier::PUBLIC, Context.Intern("Get"), Float, Body);
+            std::vector<Parameter> Parameters = { Parameter(Self, Entity) };
+            Function->Parameters = Context.CreateArray(Parameters);
+            Functions.push_back(Function);
+        }
+
+        return Functions;
+    }
+}
+
+void Bench_AST_006_StructuralHashing() {
+    PrintHeader("AST Benchmark 006: Structural Hashing");
+
+    ASTContext Context;
+    const std::vector<FunctionDeclaration*> Functions = BuildFunctions(Context);
+
+    size_t Nodes = 0;
+    for (auto* Function : Functions) {
+        WalkTree(Function, [&Nodes](ASTNode&) { ++Nodes; return true; });
+    }
+
+    Stopwatch Timer;
+    uint64_t Sum = 0;
+    for (const auto* Function : Functions) {
+        Sum += StructuralHash(Function);
+    }
+    DoNotOptimize(Sum);
+    PrintRow("Nodes", static_cast<double>(Nodes), "");
+    PrintRow("Hash (cold)", Timer.ElapsedMilliseconds(), "ms");
+
+    Timer.Restart();
+    for (const auto* Function : Functions) {
+        Sum += StructuralHash(Function);
+    }
+    DoNotOptimize(Sum);
+    PrintRow("Hash (cached)", Timer.ElapsedMilliseconds(), "ms");
+
+    // Baseline: deduplicate by printed text
+    Timer.Restart();
+    std::unordered_set<std::string> Texts;
+    for (const auto* Function : Functions) {
+        Texts.insert(Function->ToString());
+    }
+    PrintRow("Dedupe by ToString()", Timer.ElapsedMilliseconds(), "ms");
+
+    // Hash buckets, confirmed by Equal (hashes already cached)
+    Timer.Restart();
+    std::unordered_map<uint64_t, std::vector<const FunctionDeclaration*>> Buckets;
+    size_t Unique = 0;
+    for (const auto* Function : Functions) {
+        auto& Bucket = Buckets[StructuralHash(Function)];
+        bool Duplicate = false;
+        for (const auto* Other : Bucket) {
+            if (StructurallyEqual(Function, Other)) {
+                Duplicate = true;
+                break;
+            }
+        }
+        if (!Duplicate) {
+            Bucket.push_back(Function);
+            ++Unique;
+        }
+    }
+    PrintRow("Dedupe by hash + StructurallyEqual", Timer.ElapsedMilliseconds(), "ms");
+
+    // Early exit: unequal pairs are rejected on the root hash
+    Timer.Restart();
+    size_t Matches = 0;
+    for (size_t Index = 1; Index < Functions.size(); ++Index) {
+        Matches += StructurallyEqual(Functions[Index - 1], Functions[Index]) ? 1 : 0;
+    }
+    PrintRow("Equal, all pairs differ", Timer.ElapsedMilliseconds(), "ms");
+
+    Timer.Restart();
+    for (size_t Index = VariantCount; Index < Functions.size(); ++Index) {
+        Matches += StructurallyEqual(Functions[Index - VariantCount], Functions[Index]) ? 1 : 0;
+    }
+    PrintRow("Equal, all pairs equal", Timer.ElapsedMilliseconds(), "ms");
+
+    PrintRow("Results agree", Unique == VariantCount && Texts.size() == VariantCount &&
+                              Matches == Functions.size() - VariantCount ? 1.0 : 0.0, "");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,213 @@
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../SymbolTable.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int NamespaceCount = 1000;
+    constexpr int MemberCount = 100;
+    constexpr int FunctionCount = 100000;
+    constexpr int LocalCount = 8;
+
+    /** Name interning and one hash map per scope, blocks pushed as maps of their own */
+    struct MapScopes {
+        struct Scope {
+            std::unordered_map<std::string, SymbolRef> Members;
+            std::unordered_map<std::string, size_t> Children;
+            size_t Parent = 0;
+            std::vector<size_t> Usings;
+        };
+
+        std::vector<Scope> Scopes = std::vector<Scope>(1);
+        std::vector<std::unordered_map<std::string, SymbolRef>> Blocks;
+
+        const SymbolRef* Lookup(size_t Namespace, const std::string& Name) const {
+            for (auto Block = Blocks.rbegin(); Block != Blocks.rend(); ++Block) {
+                const auto Found = Block->find(Name);
+                if (Found != Block->end()) {
+                    return &Found->second;
+                }
+            }
+            for (;; Namespace = Scopes[Namespace].Parent) {
+                const auto Found = Scopes[Namespace].Members.find(Name);
+                if (Found != Scopes[Namespace].Members.end()) {
+                    return &Found->second;
+                }
+                for (const size_t Imported : Scopes[Namespace].Usings) {
+                    const auto Used = Scopes[Imported].Members.find(Name);
+                    if (Used != Scopes[Imported].Members.end()) {
+                        return &Used->second;
+                    }
+                }
+                if (Namespace == 0) {
+                    return nullptr;
+                }
+            }
+        }
+
+        const SymbolRef* LookupPath(const std::string& Space, const std::string& Name) const {
+            const auto Child = Scopes[0].Children.find(Space);
+            if (Child == Scopes[0].Children.end()) {
+                return nullptr;
+            }
+            const auto Found = Scopes[Child->second].Members.find(Name);
+            return Found != Scopes[Child->second].Members.end() ? &Found->second : nullptr;
+        }
+    };
+
+    std::string Space(const int Index) { return "Module" + std::to_string(Index); }
+    std::string Member(const int Index) { return "Symbol" + std::to_string(Index); }
+    std::string LocalName(const int Index) { return "Local" + std::to_string(Index); }
+
+    /** Pseudo-random but reproducible choice of namespace and member for the Step-th reference */
+    int Pick(const int Step, const int Range) { return static_cast<int>((static_cast<uint64_t>(Step) * 2654435761u) % Range); }
+}
+
+void Bench_AST_007_SymbolTable() {
+    PrintHeader("AST Benchmark 007: Scoped Symbol Table (100k symbols)");
+
+    // Names are interned by the parser before resolution, so both sides get their strings up front
+    std::vector<std::string> Spaces, Members, Locals, Paths;
+    for (int Index = 0; Index < NamespaceCount; ++Index) {
+        Spaces.push_back(Space(Index));
+    }
+    for (int Index = 0; Index < MemberCount; ++Index) {
+        Members.push_back(Member(Index));
+    }
+    for (int Index = 0; Index < LocalCount; ++Index) {
+        Locals.push_back(LocalName(Index));
+    }
+    for (int Step = 0; Step < FunctionCount; ++Step) {
+        Paths.push_back(Spaces[Pick(Step, NamespaceCount)] + "::" + Members[Pick(Step + 7, MemberCount)]);
+    }
+
+    // Declaring every symbol
+    Stopwatch Timer;
+    MapScopes Maps;
+    for (int Space = 0; Space < NamespaceCount; ++Space) {
+        Maps.Scopes[0].Children.emplace(Spaces[Space], Maps.Scopes.size());
+        Maps.Scopes.emplace_back();
+        for (int Index = 0; Index < MemberCount; ++Index) {
+            Maps.Scopes.back().Members.emplace(Members[Index], SymbolRef{ ESymbolKind::Function, static_cast<uint32_t>(Index), 0 });
+        }
+    }
+    const double MapDeclare = Timer.ElapsedMilliseconds();
+
+    Timer.Restart();
+    SymbolTable Symbols;
+    std::vector<ScopeId> Scopes;
+    std::vector<SymbolId> MemberIds, LocalIds;
+    for (const std::string& Name : Members) {
+        MemberIds.push_back(Symbols.Intern(Name));
+    }
+    for (const std::string& Name : Locals) {
+        LocalIds.push_back(Symbols.Intern(Name));
+    }
+    for (int Space = 0; Space < NamespaceCount; ++Space) {
+        Scopes.push_back(Symbols.OpenNamespace(SymbolTable::GlobalScope, Spaces[Space]));
+        for (int Index = 0; Index < MemberCount; ++Index) {
+            Symbols.Declare(Scopes.back(), MemberIds[Index], { ESymbolKind::Function, static_cast<uint32_t>(Index), 0 });
+        }
+    }
+    const double TableDeclare = Timer.ElapsedMilliseconds();
+
+    std::cout << "\n  Declare " << NamespaceCount * MemberCount << " symbols in " << NamespaceCount << " namespaces\n";
+    PrintRow("  map per scope", MapDeclare, "ms");
+    PrintRow("  flat table", TableDeclare, "ms");
+
+    // Qualified references, Module::Symbol
+    uint64_t MapSum = 0, TableSum = 0;
+    Timer.Restart();
+    for (int Step = 0; Step < FunctionCount; ++Step) {
+        MapSum += Maps.LookupPath(Spaces[Pick(Step, NamespaceCount)], Members[Pick(Step + 7, MemberCount)])->Index;
+    }
+    const double MapPath = Timer.ElapsedMilliseconds();
+
+    Timer.Restart();
+    for (const std::string& Path : Paths) {
+        TableSum += Symbols.LookupPath(SymbolTable::GlobalScope, Path)->Index;
+    }
+    const double TablePath = Timer.ElapsedMilliseconds();
+
+    std::cout << "\n  " << FunctionCount << " qualified references (map given the split path)\n";
+    PrintRow("  map per scope", MapPath, "ms");
+    PrintRow("  flat table", TablePath, "ms");
+
+    // Resolving function bodies: each module imports the next one; a body declares locals in
+    // two nested blocks and refers to locals, its own module's members and the next module's export
+    for (int Space = 0; Space < NamespaceCount; ++Space) {
+        Maps.Scopes[Space + 1].Usings.push_back((Space + 1) % NamespaceCount + 1);
+        Symbols.AddUsing(Scopes[Space], Scopes[(Space + 1) % NamespaceCount]);
+    }
+    std::vector<std::string> Exports;
+    std::vector<SymbolId> ExportIds;
+    for (int Space = 0; Space < NamespaceCount; ++Space) {
+        Exports.push_back("Export" + std::to_string(Space));
+        ExportIds.push_back(Symbols.Intern(Exports.back()));
+        Maps.Scopes[Space + 1].Members.emplace(Exports.back(), SymbolRef{ ESymbolKind::Function, static_cast<uint32_t>(Space), 0 });
+        Symbols.Declare(Scopes[Space], ExportIds.back(), { ESymbolKind::Function, static_cast<uint32_t>(Space), 0 });
+    }
+
+    Timer.Restart();
+    for (int Step = 0; Step < FunctionCount; ++Step) {
+        const size_t Home = static_cast<size_t>(Pick(Step, NamespaceCount)) + 1;
+        Maps.Blocks.emplace_back();
+        for (int Index = 0; Index < LocalCount / 2; ++Index) {
+            Maps.Blocks.back().emplace(Locals[Index], SymbolRef{ ESymbolKind::Local, static_cast<uint32_t>(Index), 0 });
+        }
+        Maps.Blocks.emplace_back();
+        for (int Index = LocalCount / 2; Index < LocalCount; ++Index) {
+            Maps.Blocks.back().emplace(Locals[Index], SymbolRef{ ESymbolKind::Local, static_cast<uint32_t>(Index), 0 });
+        }
+        for (int Reference = 0; Reference < 16; ++Reference) {
+            const std::string& Name = Reference % 2 == 0 ? Locals[Reference / 2]
+                                    : Reference % 4 == 1 ? Members[Pick(Step + Reference, MemberCount)]
+                                    : Exports[Home % NamespaceCount];
+            const SymbolRef* Found = Maps.Lookup(Home, Name);
+            MapSum += Found != nullptr ? Found->Index : 0;
+        }
+        Maps.Blocks.pop_back();
+        Maps.Blocks.pop_back();
+    }
+    const double MapBodies = Timer.ElapsedMilliseconds();
+
+    Timer.Restart();
+    for (int Step = 0; Step < FunctionCount; ++Step) {
+        const int Module = Pick(Step, NamespaceCount);
+        const ScopeId Home = Scopes[static_cast<size_t>(Module)];
+        Symbols.PushScope();
+        for (int Index = 0; Index < LocalCount / 2; ++Index) {
+            Symbols.DeclareLocal(LocalIds[Index], { ESymbolKind::Local, static_cast<uint32_t>(Index), 0 });
+        }
+        Symbols.PushScope();
+        for (int Index = LocalCount / 2; Index < LocalCount; ++Index) {
+            Symbols.DeclareLocal(LocalIds[Index], { ESymbolKind::Local, static_cast<uint32_t>(Index), 0 });
+        }
+        for (int Reference = 0; Reference < 16; ++Reference) {
+            const SymbolId Name = Reference % 2 == 0 ? LocalIds[Reference / 2]
+                                : Reference % 4 == 1 ? MemberIds[Pick(Step + Reference, MemberCount)]
+                                : ExportIds[(Module + 1) % NamespaceCount];
+            const SymbolRef* Found = Symbols.Lookup(Home, Name);
+            TableSum += Found != nullptr ? Found->Index : 0;
+        }
+        Symbols.PopScope();
+        Symbols.PopScope();
+    }
+    const double TableBodies = Timer.ElapsedMilliseconds();
+
+    std::cout << "\n  " << FunctionCount << " function bodies: 2 blocks, " << LocalCount << " locals, 16 references\n";
+    PrintRow("  map per scope", MapBodies, "ms");
+    PrintRow("  flat table + undo log", TableBodies, "ms");
+    PrintRow("  speedup", MapBodies / TableBodies, "x");
+
+    DoNotOptimize(MapSum);
+    DoNotOptimize(TableSum);
+    PrintRow("Results agree", MapSum == TableSum ? 1.0 : 0.0, "");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,105 @@
+#include "Declaration.h"
+#include "ASTPrinter.h"
+#include "ASTVisitor.h"
+
+namespace Vex {
+    // ============================================================================
+    // FIELD DECLARATION
+    // ============================================================================
+
+    void FieldDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string FieldDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // FUNCTION DECLARATION
+    // ============================================================================
+
+    void FunctionDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string FunctionDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // DEFINE DECLARATION
+    // ============================================================================
+
+    void DefineDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string DefineDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // FETCH DECLARATION
+    // ============================================================================
+
+    void FetchDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string FetchDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // SET DECLARATION
+    // ============================================================================
+
+    void SetDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string SetDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // INTERFACE DECLARATION
+    // ============================================================================
+
+    void InterfaceDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string InterfaceDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // NAMESPACE DECLARATION
+    // ============================================================================
+
+    void NamespaceDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string NamespaceDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // USING DECLARATION
+    // ============================================================================
+
+    void UsingDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string UsingDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // GLOBAL DECLARATION
+    // ============================================================================
+
+    void GlobalDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string GlobalDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // TRANSLATION UNIT
+    // ============================================================================
+
+    void TranslationUnit::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string TranslationUnit::ToString() const {
+        return PrintTree(*this);
+    }
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <atomic>
+
+#include "ASTNode.h"
+#include "Statement.h"
+
+namespace Vex {
+
+    // ============================================================================
+    // FIELD DECLARATION
+    // ============================================================================
+
+    /**
+     * Field of a Define block
+     * Examples:
+     *   Health -> Int_32;
+     *   Public: Static Const MaxHealth -> Int_32 = 100;
+     */
+    class FieldDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::FieldDeclaration;
+
+        EAccessModifier Access;                     // Section the field was declared in
+        std::string_view Name;                      // Field name
+        const TypeRef* Type;                        // Field type
+        Expression* Initializer;                    // Optional default value
+        bool IsStatic = false;
+        bool IsConst = false;
+
+        FieldDeclaration(
+            const EAccessModifier Access,
+            std::string_view Name,
+            const TypeRef* Type,
+            Expression* Initializer = nullptr
+        ) : Declaration(NodeKind), Access(Access), Name(Name), Type(Type), Initializer(Initializer) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    // ============================================================================
+    // FUNCTION DECLARATION
+    // ============================================================================
+
+    /**
+     * Function body skipped by a lazy parse (see LazyParser)
+     * Records where the braces are in the source; Parsed is published once
+     * by whichever thread first asks for the body.
+     */
+    struct DeferredBody {
+        size_t         Begin = 0;                   // Offset of '{'
+        size_t         End   = 0;                   // Offset just past the matching '}'
+        SourceLocation Start;                       // Location of '{'
+        std::atomic<BlockStatement*> Parsed{ nullptr };
+    };
+
+    /**
+     * Method of a Define, Fetch, Set or Interface block
+     * Interface methods and forward declarations have no body.
+     * Examples:
+     *   Fetch_Health() -> Entity.Health { return Entity.Health; }
+     *   Public: Virtual TakeDamage(Amount: Int_32) -> Void;
+     *   Operator +(Other: Vector3) -> Vector3 { ... }
+     */
+    class FunctionDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::FunctionDeclaration;
+
+        EAccessModifier Access;                     // Section the method was declared in
+        std::string_view Name;                      // Method name (operator symbol for Operator)
+        ArenaArray<Parameter> Parameters;           // Parameter list
+        const TypeRef* ReturnType;                  // Optional return type
+        BlockStatement* Body;                       // nullptr for signatures and deferred bodies
+        DeferredBody* Deferred = nullptr;           // Set instead of Body by a lazy parse
+        bool IsStatic = false;
+        bool IsVirtual = false;
+        bool IsOverride = false;
+        bool IsImplement = false;
+        bool IsOperator = false;
+
+        FunctionDeclaration(
+            const EAccessModifier Access,
+            std::string_view Name,
+            const TypeRef* ReturnType,
+            BlockStatement* Body = nullptr
+        ) : Declaration(NodeKind), Access(Access), Name(Name), ReturnType(ReturnType), Body(Body) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    // ============================================================================
+    // DEFINE DECLARATION
+    // ============================================================================
+
+    /**
+     * Type definition
+     * Example:
+     *   @SoA Define Entity : Base {
+     *       Public:
+     *           Health -> Int_32;
+     *           Update(Delta: Float) -> Void { ... }
+     *   }
+     */
+    class DefineDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::DefineDeclaration;
+
+        std::string_view Name;                      // Type name
+        ArenaArray<const TypeRef*> BaseTypes;       // Inherited types and interfaces
+        ArenaArray<std::string_view> Attributes;    // @SoA, ... (without the @)
+        ArenaArray<FieldDeclaration*> Fields;       // Fields in declaration order
+        ArenaArray<FunctionDeclaration*> Methods;   // Methods in declaration order
+
+        explicit DefineDeclaration(std::string_view Name)
+            : Declaration(NodeKind), Name(Name) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    // ============================================================================
+    // FETCH / SET DECLARATIONS
+    // ============================================================================
+
+    /**
+     * Read accessors of a type
+     * Example:
+     *   Fetch Entity {
+     *       Fetch_Health() -> Entity.Health { return Entity.Health; }
+     *   }
+     */
+    class FetchDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::FetchDeclaration;
+
+        std::string_view Target;                    // Type the accessors belong to
+        ArenaArray<FunctionDeclaration*> Methods;
+
+        explicit FetchDeclaration(std::string_view Target)
+            : Declaration(NodeKind), Target(Target) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    /**
+     * Write accessors of a type
+     * Example:
+     *   Set Entity {
+     *       Set_Health(Value: Int_32) -> Void { Entity.Health = Value; }
+     *   }
+     */
+    class SetDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::SetDeclaration;
+
+        std::string_view Target;                    // Type the accessors belong to
+        ArenaArray<FunctionDeclaration*> Methods;
+
+        explicit SetDeclaration(std::string_view Target)
+            : Declaration(NodeKind), Target(Target) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    // ============================================================================
+    // INTERFACE DECLARATION
+    // ============================================================================
+
+    /**
+     * Interface: a named set of method signatures
+     * Example:
+     *   Interface IDamageable : IEntity {
+     *       TakeDamage(Amount: Int_32) -> Void;
+     *   }
+     */
+    class InterfaceDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::InterfaceDeclaration;
+
+        std::string_view Name;
+        ArenaArray<const TypeRef*> BaseInterfaces;
+        ArenaArray<FunctionDeclaration*> Methods;   // Signatures (Body may still be set for defaults)
+
+        explicit InterfaceDeclaration(std::string_view Name)
+            : Declaration(NodeKind), Name(Name) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    // ============================================================================
+    // NAMESPACE / USING / GLOBAL
+    // ============================================================================
+
+    /**
+     * Namespace block
+     * Example: Namespace Engine::Math { ... }
+     */
+    class NamespaceDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::NamespaceDeclaration;
+
+        std::string_view Name;                      // Possibly qualified (A::B)
+        ArenaArray<Declaration*> Declarations;
+
+        explicit NamespaceDeclaration(std::string_view Name)
+            : Declaration(NodeKind), Name(Name) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    /**
+     * Import of a namespace or module
+     * Example: Using Engine::Math;
+     */
+    class UsingDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::UsingDeclaration;
+
+        std::string_view Path;                      // Qualified name (A::B::C)
+
+        explicit UsingDeclaration(std::string_view Path)
+            : Declaration(NodeKind), Path(Path) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    /**
+     * Variable at namespace scope
+     * Example: global Const Gravity: Float = 9.81;
+     */
+    class GlobalDeclaration : public Declaration {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::GlobalDeclaration;
+
+        VariableDeclaration* Variable;
+
+        explicit GlobalDeclaration(VariableDeclaration* Variable)
+            : Declaration(NodeKind), Variable(Variable) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+    // ============================================================================
+    // TRANSLATION UNIT
+    // ============================================================================
+
+    /**
+     * Root of one source file: its top-level declarations in order
+     */
+    class TranslationUnit : public ASTNode {
+    public:
+        static constexpr ENodeKind NodeKind = ENodeKind::TranslationUnit;
+
+        std::string_view SourceName;                // File or module name
+        ArenaArray<Declaration*> Declarations;
+
+        explicit TranslationUnit(std::string_view SourceName = {})
+            : ASTNode(NodeKind), SourceName(SourceName) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
+    };
+
+} // namespace Vex
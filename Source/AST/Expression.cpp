@@ -0,0 +1,202 @@
+#include <sstream>
+
+#include "Expression.h"
+#include "ASTPrinter.h"
+#include "ASTVisitor.h"
+
+namespace Vex {
+    std::string BinaryOpToString(const EBinaryOp Op) {
+        switch (Op) {
+            case EBinaryOp::Add:            return "+";
+            case EBinaryOp::Subtract:       return "-";
+            case EBinaryOp::Multiply:       return "*";
+            case EBinaryOp::Divide:         return "/";
+            case EBinaryOp::Modulo:         return "%";
+            case EBinaryOp::Power:          return "**";
+
+            case EBinaryOp::Equal:          return "==";
+            case EBinaryOp::NotEqual:       return "!=";
+            case EBinaryOp::TypeValueEq:    return "===";
+            case EBinaryOp::TypeValueNeq:   return "!==";
+            case EBinaryOp::Less:           return "<";
+            case EBinaryOp::Greater:        return ">";
+            case EBinaryOp::LessEqual:      return "<=";
+            case EBinaryOp::GreaterEqual:   return ">=";
+
+            case EBinaryOp::LogicalAnd:     return "&&";
+            case EBinaryOp::LogicalOr:      return "||";
+
+            case EBinaryOp::BitwiseAnd:     return "&";
+            case EBinaryOp::BitwiseOr:      return "|";
+            case EBinaryOp::BitwiseXor:     return "^";
+            case EBinaryOp::LeftShift:      return "<<";
+            case EBinaryOp::RightShift:     return ">>";
+
+            case EBinaryOp::Range:          return "..";
+            case EBinaryOp::RangeInclusive: return "..=";
+
+            case EBinaryOp::NullCoalesce:   return "??";
+
+            case EBinaryOp::Assign:         return "=";
+            case EBinaryOp::AddAssign:      return "+=";
+            case EBinaryOp::SubtractAssign: return "-=";
+            case EBinaryOp::MultiplyAssign: return "*=";
+            case EBinaryOp::DivideAssign:   return "/=";
+            case EBinaryOp::ModuloAssign:   return "%=";
+        }
+
+        return "?";
+    }
+
+    std::string UnaryOpToString(const EUnaryOp Op) {
+        switch (Op) {
+            case EUnaryOp::Plus:            return "+";
+            case EUnaryOp::Minus:           return "-";
+            case EUnaryOp::LogicalNot:      return "!";
+            case EUnaryOp::BitwiseNot:      return "~";
+        }
+
+        return "?";
+    }
+
+    // ============================================================================
+    // LITERALS
+    // ============================================================================
+
+    void IntegerLiteral::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string IntegerLiteral::ToString() const {
+        return std::to_string(Value);
+    }
+
+    void FloatLiteral::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string FloatLiteral::ToString() const {
+        std::stringstream Stream;
+        Stream << Value;
+
+        // Keep floats distinguishable from integers: 100.0 instead of 100
+        std::string Text = Stream.str();
+        if (Text.find_first_of(".eEn") == std::string::npos) {
+            Text += ".0";
+        }
+
+        return Text;
+    }
+
+    void StringLiteral::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string StringLiteral::ToString() const {
+        return "\"" + std::string(Value) + "\"";
+    }
+
+    void CharLiteral::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string CharLiteral::ToString() const {
+        return std::string("'") + Value + "'";
+    }
+
+    void BoolLiteral::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string BoolLiteral::ToString() const {
+        return Value ? "true" : "false";
+    }
+
+    void NullLiteral::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string NullLiteral::ToString() const {
+        return "null";
+    }
+
+    // ============================================================================
+    // IDENTIFIER
+    // ============================================================================
+
+    void Identifier::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string Identifier::ToString() const {
+        return std::string(Name);
+    }
+
+    // ============================================================================
+    // OPERATORS
+    // ============================================================================
+
+    void BinaryExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string BinaryExpression::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void UnaryExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string UnaryExpression::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // CALLS AND ACCESS
+    // ============================================================================
+
+    void FunctionCall::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string FunctionCall::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void MemberAccess::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string MemberAccess::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void IndexAccess::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string IndexAccess::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // TERNARY, CAST, NEW
+    // ============================================================================
+
+    void TernaryExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string TernaryExpression::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void CastExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string CastExpression::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void NewExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string NewExpression::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // THIS, SUPER, GROUPING
+    // ============================================================================
+
+    void ThisExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string ThisExpression::ToString() const {
+        return "this";
+    }
+
+    void SuperExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string SuperExpression::ToString() const {
+        return "super";
+    }
+
+    void GroupingExpression::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string GroupingExpression::ToString() const {
+        return PrintTree(*this);
+    }
+}
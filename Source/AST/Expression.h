@@ -1,8 +1,6 @@
 ﻿#pragma once
 
 #include "ASTNode.h"
-#include <vector>
-#include <memory>
 
 namespace Vex {
 
@@ -46,10 +44,20 @@ namespace Vex {
 
         // Null coalescing
         NullCoalesce,   // ??
+
+        // Assignment (Left must be assignable)
+        Assign,         // =
+        AddAssign,      // +=
+        SubtractAssign, // -=
+        MultiplyAssign, // *=
+        DivideAssign,   // /=
+        ModuloAssign,   // %=
     };
 
     std::string BinaryOpToString(EBinaryOp Op);
 
+    constexpr bool IsAssignmentOp(const EBinaryOp Op) { return Op >= EBinaryOp::Assign; }
+
     // ============================================================================
     // UNARY OPERATORS
     // ============================================================================
@@ -72,12 +80,14 @@ namespace Vex {
      */
     class IntegerLiteral : public Expression {
     public:
+        static constexpr ENodeKind NodeKind = ENodeKind::IntegerLiteral;
+
         long long Value;
 
-        explicit IntegerLiteral(long long Value) : Value(Value) {}
+        explicit IntegerLiteral(long long Value) : Expression(NodeKind), Value(Value) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     /**
@@ -85,12 +95,14 @@ namespace Vex {
      */
     class FloatLiteral : public Expression {
     public:
+        static constexpr ENodeKind NodeKind = ENodeKind::FloatLiteral;
+
         double Value;
 
-        explicit FloatLiteral(double Value) : Value(Value) {}
+        explicit FloatLiteral(double Value) : Expression(NodeKind), Value(Value) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     /**
@@ -98,12 +110,14 @@ namespace Vex {
      */
     class StringLiteral : public Expression {
     public:
-        std::string Value;
+        static constexpr ENodeKind NodeKind = ENodeKind::StringLiteral;
+
+        std::string_view Value;
 
-        explicit StringLiteral(const std::string& Value) : Value(Value) {}
+        explicit StringLiteral(std::string_view Value) : Expression(NodeKind), Value(Value) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     /**
@@ -111,12 +125,14 @@ namespace Vex {
      */
     class CharLiteral : public Expression {
     public:
+        static constexpr ENodeKind NodeKind = ENodeKind::CharLiteral;
+
         char Value;
 
-        explicit CharLiteral(char Value) : Value(Value) {}
+        explicit CharLiteral(char Value) : Expression(NodeKind), Value(Value) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     /**
@@ -124,12 +140,14 @@ namespace Vex {
      */
     class BoolLiteral : public Expression {
     public:
+        static constexpr ENodeKind NodeKind = ENodeKind::BoolLiteral;
+
         bool Value;
 
-        explicit BoolLiteral(bool Value) : Value(Value) {}
+        explicit BoolLiteral(bool Value) : Expression(NodeKind), Value(Value) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     /**
@@ -137,10 +155,12 @@ namespace Vex {
      */
     class NullLiteral : public Expression {
     public:
-        NullLiteral() = default;
+        static constexpr ENodeKind NodeKind = ENodeKind::NullLiteral;
+
+        NullLiteral() : Expression(NodeKind) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -148,16 +168,19 @@ namespace Vex {
     // ============================================================================
 
     /**
-     * Identifier: Health, Player, X
+     * Identifier: Health, Player, X, Math::Dot
      */
     class Identifier : public Expression {
     public:
-        std::string Name;
+        static constexpr ENodeKind NodeKind = ENodeKind::Identifier;
+
+        std::string_view Name;                  // Qualified (A::B) when written with '::'
+        SymbolRef Symbol;                       // Set by name resolution
 
-        explicit Identifier(const std::string& Name) : Name(Name) {}
+        explicit Identifier(std::string_view Name) : Expression(NodeKind), Name(Name) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -170,18 +193,20 @@ namespace Vex {
      */
     class BinaryExpression : public Expression {
     public:
-        std::unique_ptr<Expression> Left;
+        static constexpr ENodeKind NodeKind = ENodeKind::BinaryExpression;
+
+        Expression* Left;
         EBinaryOp Op;
-        std::unique_ptr<Expression> Right;
+        Expression* Right;
 
         BinaryExpression(
-            std::unique_ptr<Expression> Left,
+            Expression* Left,
             EBinaryOp Op,
-            std::unique_ptr<Expression> Right
-        ) : Left(std::move(Left)), Op(Op), Right(std::move(Right)) {}
+            Expression* Right
+        ) : Expression(NodeKind), Left(Left), Op(Op), Right(Right) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -194,14 +219,16 @@ namespace Vex {
      */
     class UnaryExpression : public Expression {
     public:
+        static constexpr ENodeKind NodeKind = ENodeKind::UnaryExpression;
+
         EUnaryOp Op;
-        std::unique_ptr<Expression> Operand;
+        Expression* Operand;
 
-        UnaryExpression(EUnaryOp Op, std::unique_ptr<Expression> Operand)
-            : Op(Op), Operand(std::move(Operand)) {}
+        UnaryExpression(EUnaryOp Op, Expression* Operand)
+            : Expression(NodeKind), Op(Op), Operand(Operand) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -214,14 +241,16 @@ namespace Vex {
      */
     class FunctionCall : public Expression {
     public:
-        std::unique_ptr<Expression> Callee;                     // Function being called
-        std::vector<std::unique_ptr<Expression>> Arguments;     // Arguments
+        static constexpr ENodeKind NodeKind = ENodeKind::FunctionCall;
 
-        explicit FunctionCall(std::unique_ptr<Expression> Callee)
-            : Callee(std::move(Callee)) {}
+        Expression* Callee;                     // Function being called
+        ArenaArray<Expression*> Arguments;      // Arguments
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        explicit FunctionCall(Expression* Callee)
+            : Expression(NodeKind), Callee(Callee) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -229,19 +258,24 @@ namespace Vex {
     // ============================================================================
 
     /**
-     * Member access: Object.Member
-     * Examples: Player.Health, Entity.Position.X
+     * Member access: Object.Member, or Object?.Member which yields null
+     * when Object is null
+     * Examples: Player.Health, Entity.Position.X, Target?.Health
      */
     class MemberAccess : public Expression {
     public:
-        std::unique_ptr<Expression> Object;
-        std::string Member;
+        static constexpr ENodeKind NodeKind = ENodeKind::MemberAccess;
+
+        Expression* Object;
+        std::string_view Member;
+        bool IsOptional;                        // ?. instead of .
+        SymbolRef Symbol;                       // Field, when name resolution knows the Object's type
 
-        MemberAccess(std::unique_ptr<Expression> Object, const std::string& Member)
-            : Object(std::move(Object)), Member(Member) {}
+        MemberAccess(Expression* Object, std::string_view Member, const bool IsOptional = false)
+            : Expression(NodeKind), Object(Object), Member(Member), IsOptional(IsOptional) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -254,16 +288,19 @@ namespace Vex {
      */
     class IndexAccess : public Expression {
     public:
-        std::unique_ptr<Expression> Object;
-        std::unique_ptr<Expression> Index;
+        static constexpr ENodeKind NodeKind = ENodeKind::IndexAccess;
+
+        Expression* Object;
+        Expression* Index;
+        SymbolRef Symbol;                       // Interface, when name resolution finds the element used as one
 
         IndexAccess(
-            std::unique_ptr<Expression> Object,
-            std::unique_ptr<Expression> Index
-        ) : Object(std::move(Object)), Index(std::move(Index)) {}
+            Expression* Object,
+            Expression* Index
+        ) : Expression(NodeKind), Object(Object), Index(Index) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -276,20 +313,23 @@ namespace Vex {
      */
     class TernaryExpression : public Expression {
     public:
-        std::unique_ptr<Expression> Condition;
-        std::unique_ptr<Expression> TrueExpr;
-        std::unique_ptr<Expression> FalseExpr;
+        static constexpr ENodeKind NodeKind = ENodeKind::TernaryExpression;
+
+        Expression* Condition;
+        Expression* TrueExpr;
+        Expression* FalseExpr;
 
         TernaryExpression(
-            std::unique_ptr<Expression> Condition,
-            std::unique_ptr<Expression> TrueExpr,
-            std::unique_ptr<Expression> FalseExpr
-        ) : Condition(std::move(Condition)),
-            TrueExpr(std::move(TrueExpr)),
-            FalseExpr(std::move(FalseExpr)) {}
-
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+            Expression* Condition,
+            Expression* TrueExpr,
+            Expression* FalseExpr
+        ) : Expression(NodeKind),
+            Condition(Condition),
+            TrueExpr(TrueExpr),
+            FalseExpr(FalseExpr) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -302,16 +342,18 @@ namespace Vex {
      */
     class CastExpression : public Expression {
     public:
-        std::unique_ptr<Expression> Expr;
-        std::unique_ptr<TypeRef> Type;
+        static constexpr ENodeKind NodeKind = ENodeKind::CastExpression;
+
+        Expression* Expr;
+        const TypeRef* Type;
 
         CastExpression(
-            std::unique_ptr<Expression> Expr,
-            std::unique_ptr<TypeRef> Type
-        ) : Expr(std::move(Expr)), Type(std::move(Type)) {}
+            Expression* Expr,
+            const TypeRef* Type
+        ) : Expression(NodeKind), Expr(Expr), Type(Type) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -324,14 +366,16 @@ namespace Vex {
      */
     class NewExpression : public Expression {
     public:
-        std::unique_ptr<TypeRef> Type;
-        std::vector<std::unique_ptr<Expression>> Arguments;
+        static constexpr ENodeKind NodeKind = ENodeKind::NewExpression;
 
-        explicit NewExpression(std::unique_ptr<TypeRef> Type)
-            : Type(std::move(Type)) {}
+        const TypeRef* Type;
+        ArenaArray<Expression*> Arguments;
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        explicit NewExpression(const TypeRef* Type)
+            : Expression(NodeKind), Type(Type) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -343,10 +387,12 @@ namespace Vex {
      */
     class ThisExpression : public Expression {
     public:
-        ThisExpression() = default;
+        static constexpr ENodeKind NodeKind = ENodeKind::ThisExpression;
+
+        ThisExpression() : Expression(NodeKind) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -358,10 +404,12 @@ namespace Vex {
      */
     class SuperExpression : public Expression {
     public:
-        SuperExpression() = default;
+        static constexpr ENodeKind NodeKind = ENodeKind::SuperExpression;
+
+        SuperExpression() : Expression(NodeKind) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -374,13 +422,23 @@ namespace Vex {
      */
     class GroupingExpression : public Expression {
     public:
-        std::unique_ptr<Expression> Expr;
+        static constexpr ENodeKind NodeKind = ENodeKind::GroupingExpression;
 
-        explicit GroupingExpression(std::unique_ptr<Expression> Expr)
-            : Expr(std::move(Expr)) {}
+        Expression* Expr;
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        explicit GroupingExpression(Expression* Expr)
+            : Expression(NodeKind), Expr(Expr) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
+    /** Expr without the parentheses around it, if any */
+    inline Expression* Unwrap(Expression* Expr) {
+        while (auto* Group = Expr->As<GroupingExpression>()) {
+            Expr = Group->Expr;
+        }
+        return Expr;
+    }
+
 } // namespace Vex
\ No newline at end of file
@@ -0,0 +1,1315 @@
+#include "FlatAST.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "ASTContext.h"
+#include "Declaration.h"
+#include "Hashing.h"
+#include "Statement.h"
+#include "TreeWalker.h"
+
+namespace Vex {
+    namespace {
+        std::string Concat(const std::initializer_list<std::string_view> Pieces) {
+            size_t Length = 0;
+            for (const auto& Piece : Pieces) {
+                Length += Piece.size();
+            }
+
+            std::string Text;
+            Text.reserve(Length);
+            for (const auto& Piece : Pieces) {
+                Text += Piece;
+            }
+            return Text;
+        }
+
+        /** Copies Parts[First, Last) into an arena array of the concrete node type */
+        template<typename T>
+        ArenaArray<T*> CastParts(const std::vector<ASTNode*>& Parts, const size_t First, const size_t Last,
+                                 ASTContext& Context) {
+            std::vector<T*> Items;
+            Items.reserve(Last - First);
+            for (size_t Slot = First; Slot < Last; ++Slot) {
+                Items.push_back(static_cast<T*>(Parts[Slot]));
+            }
+            return Context.CreateArray(Items);
+        }
+
+        std::string AccessPrefix(const uint16_t Access) {
+            const auto Modifier = static_cast<EAccessModifier>(Access);
+            return Modifier == EAccessModifier::NONE ? "" : AccessModifierToString(Modifier) + ": ";
+        }
+    }
+
+    // ============================================================================
+    // BUILDER
+    // ============================================================================
+
+    /**
+     * Emits nodes in post-order: children first, then the parent
+     * Driven by WalkTree, so flattening never recurses, however deep the tree.
+     */
+    class FlatASTBuilder {
+    public:
+        explicit FlatASTBuilder(FlatAST& Flat) : Flat(Flat) {}
+
+        NodeIndex Build(ASTNode* Root) {
+            if (Root == nullptr) {
+                return InvalidNode;
+            }
+
+            WalkTree(Root, [](ASTNode&) { return true; }, [this](ASTNode& Node) { Leave(Node); });
+            return Finished.back();
+        }
+
+    private:
+        FlatAST& Flat;
+        std::vector<NodeIndex> Finished;        // Emitted subtrees whose parent is still pending
+        std::vector<ASTNode*>  Slots;           // Child layout of the current node, nullptr if absent
+
+        void Leave(ASTNode& Node) {
+            Slots.clear();
+
+            switch (Node.Kind) {
+                case ENodeKind::BinaryExpression: {
+                    auto& Binary = static_cast<BinaryExpression&>(Node);
+                    Slots.assign({ Binary.Left, Binary.Right });
+                    Emit(Node).Flags = static_cast<uint8_t>(Binary.Op);
+                    break;
+                }
+                case ENodeKind::UnaryExpression: {
+                    auto& Unary = static_cast<UnaryExpression&>(Node);
+                    Slots.push_back(Unary.Operand);
+                    Emit(Node).Flags = static_cast<uint8_t>(Unary.Op);
+                    break;
+                }
+                case ENodeKind::FunctionCall: {
+                    auto& Call = static_cast<FunctionCall&>(Node);
+                    Slots.push_back(Call.Callee);
+                    Slots.insert(Slots.end(), Call.Arguments.begin(), Call.Arguments.end());
+                    Emit(Node);
+                    break;
+                }
+                case ENodeKind::MemberAccess: {
+                    auto& Access = static_cast<MemberAccess&>(Node);
+                    Slots.push_back(Access.Object);
+                    const uint32_t Member = Flat.InternString(Access.Member);
+
+                    FlatNode& Emitted = Emit(Node);
+                    Emitted.Payload[0] = Member;
+                    Emitted.Flags = Access.IsOptional ? 1 : 0;
+                    break;
+                }
+                case ENodeKind::IndexAccess: {
+                    auto& Access = static_cast<IndexAccess&>(Node);
+                    Slots.assign({ Access.Object, Access.Index });
+                    Emit(Node);
+                    break;
+                }
+                case ENodeKind::TernaryExpression: {
+                    auto& Ternary = static_cast<TernaryExpression&>(Node);
+                    Slots.assign({ Ternary.Condition, Ternary.TrueExpr, Ternary.FalseExpr });
+                    Emit(Node);
+                    break;
+                }
+                case ENodeKind::CastExpression: {
+                    auto& Cast = static_cast<CastExpression&>(Node);
+                    Slots.push_back(Cast.Expr);
+                    const uint32_t Type = Flat.InternType(Cast.Type);
+                    Emit(Node).Payload[0] = Type;
+                    break;
+                }
+                case ENodeKind::NewExpression: {
+                    auto& New = static_cast<NewExpression&>(Node);
+                    Slots.insert(Slots.end(), New.Arguments.begin(), New.Arguments.end());
+                    const uint32_t Type = Flat.InternType(New.Type);
+                    Emit(Node).Payload[0] = Type;
+                    break;
+                }
+                case ENodeKind::GroupingExpression:
+                    Slots.push_back(static_cast<GroupingExpression&>(Node).Expr);
+                    Emit(Node);
+                    break;
+
+                case ENodeKind::VariableDeclaration: {
+                    auto& Var = static_cast<VariableDeclaration&>(Node);
+                    Slots.push_back(Var.Initializer);
+                    const uint32_t Name = Flat.InternString(Var.Name);
+                    const uint32_t Type = Var.Type != nullptr ? Flat.InternType(Var.Type) : InvalidNode;
+
+                    FlatNode& Emitted = Emit(Node);
+                    Emitted.Payload[0] = Name;
+                    Emitted.Payload[1] = Type;
+                    Emitted.Flags = (Var.IsConst ? 1 : 0) | (Var.IsLet ? 2 : 0);
+                    break;
+                }
+                case ENodeKind::ExpressionStatement:
+                    Slots.push_back(static_cast<ExpressionStatement&>(Node).Expr);
+                    Emit(Node);
+                    break;
+                case ENodeKind::BlockStatement: {
+                    auto& Block = static_cast<BlockStatement&>(Node);
+                    Slots.insert(Slots.end(), Block.Statements.begin(), Block.Statements.end());
+                    Emit(Node);
+                    break;
+                }
+                case ENodeKind::IfStatement: {
+                    auto& If = static_cast<IfStatement&>(Node);
+                    Slots.assign({ If.Condition, If.ThenBranch, If.ElseBranch });
+                    Emit(Node);
+                    break;
+                }
+                case ENodeKind::WhileStatement: {
+                    auto& While = static_cast<WhileStatement&>(Node);
+                    Slots.assign({ While.Condition, While.Body });
+                    Emit(Node);
+                    break;
+                }
+                case ENodeKind::DoWhileStatement: {
+                    auto& DoWhile = static_cast<DoWhileStatement&>(Node);
+                    Slots.assign({ DoWhile.Body, DoWhile.Condition });
+                    Emit(Node);
+                    break;
+                }
+                case ENodeKind::ForStatement: {
+                    auto& For = static_cast<ForStatement&>(Node);
+                    Slots.assign({ For.RangeStart, For.RangeEnd, For.Step, For.Body });
+                    const uint32_t Iterator = Flat.InternString(For.Iterator);
+
+                    FlatNode& Emitted = Emit(Node);
+                    Emitted.Payload[0] = Iterator;
+                    Emitted.Flags = For.IsInclusive ? 1 : 0;
+                    break;
+                }
+                case ENodeKind::ReturnStatement:
+                    Slots.push_back(static_cast<ReturnStatement&>(Node).Value);
+                    Emit(Node);
+                    break;
+                case ENodeKind::MatchStatement: {
+                    auto& Match = static_cast<MatchStatement&>(Node);
+                    Slots.push_back(Match.Value);
+                    for (const auto& Case : Match.Cases) {
+                        Slots.push_back(Case.Pattern);
+                        Slots.push_back(Case.Body);
+                    }
+                    Emit(Node);
+                    break;
+                }
+
+                case ENodeKind::FieldDeclaration: {
+                    auto& Field = static_cast<FieldDeclaration&>(Node);
+                    Slots.push_back(Field.Initializer);
+                    const uint32_t Name = Flat.InternString(Field.Name);
+                    const uint32_t Type = Flat.InternType(Field.Type);
+
+                    FlatNode& Emitted = Emit(Node);
+                    Emitted.Payload[0] = Name;
+                    Emitted.Payload[1] = Type;
+                    Emitted.Flags = (Field.IsStatic ? 1 : 0) | (Field.IsConst ? 2 : 0);
+                    Emitted.Reserved = static_cast<uint16_t>(Field.Access);
+                    break;
+                }
+                case ENodeKind::FunctionDeclaration: {
+                    auto& Function = static_cast<FunctionDeclaration&>(Node);
+                    for (const auto& Param : Function.Parameters) {
+                        Slots.push_back(Param.DefaultValue);
+                    }
+                    Slots.push_back(Function.Body);
+
+                    const uint32_t Name = Flat.InternString(Function.Name);
+                    const auto Record = static_cast<uint32_t>(Flat.ExtraData.size());
+                    Flat.ExtraData.push_back(InternOptionalType(Function.ReturnType));
+                    Flat.ExtraData.push_back(static_cast<uint32_t>(Function.Parameters.size()));
+                    for (const auto& Param : Function.Parameters) {
+                        Flat.ExtraData.push_back(Flat.InternString(Param.Name));
+                        Flat.ExtraData.push_back(InternOptionalType(Param.Type));
+                    }
+
+                    FlatNode& Emitted = Emit(Node);
+                    Emitted.Payload[0] = Name;
+                    Emitted.Payload[1] = Record;
+                    Emitted.Flags = (Function.IsStatic ? FunctionStatic : 0) |
+                                    (Function.IsVirtual ? FunctionVirtual : 0) |
+                                    (Function.IsOverride ? FunctionOverride : 0) |
+                                    (Function.IsImplement ? FunctionImplement : 0) |
+                                    (Function.IsOperator ? FunctionOperator : 0);
+                    Emitted.Reserved = static_cast<uint16_t>(Function.Access);
+                    break;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    auto& Define = static_cast<DefineDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Define.Fields.begin(), Define.Fields.end());
+                    Slots.insert(Slots.end(), Define.Methods.begin(), Define.Methods.end());
+
+                    const uint32_t Name = Flat.InternString(Define.Name);
+                    const auto Record = static_cast<uint32_t>(Flat.ExtraData.size());
+                    Flat.ExtraData.push_back(static_cast<uint32_t>(Define.Fields.size()));
+                    PushTypes(Define.BaseTypes);
+                    Flat.ExtraData.push_back(static_cast<uint32_t>(Define.Attributes.size()));
+                    for (const auto& Attribute : Define.Attributes) {
+                        Flat.ExtraData.push_back(Flat.InternString(Attribute));
+                    }
+
+                    FlatNode& Emitted = Emit(Node);
+                    Emitted.Payload[0] = Name;
+                    Emitted.Payload[1] = Record;
+                    break;
+                }
+                case ENodeKind::FetchDeclaration: {
+                    auto& Fetch = static_cast<FetchDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Fetch.Methods.begin(), Fetch.Methods.end());
+                    const uint32_t Target = Flat.InternString(Fetch.Target);
+                    Emit(Node).Payload[0] = Target;
+                    break;
+                }
+                case ENodeKind::SetDeclaration: {
+                    auto& Set = static_cast<SetDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Set.Methods.begin(), Set.Methods.end());
+                    const uint32_t Target = Flat.InternString(Set.Target);
+                    Emit(Node).Payload[0] = Target;
+                    break;
+                }
+                case ENodeKind::InterfaceDeclaration: {
+                    auto& Interface = static_cast<InterfaceDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Interface.Methods.begin(), Interface.Methods.end());
+
+                    const uint32_t Name = Flat.InternString(Interface.Name);
+                    const auto Record = static_cast<uint32_t>(Flat.ExtraData.size());
+                    PushTypes(Interface.BaseInterfaces);
+
+                    FlatNode& Emitted = Emit(Node);
+                    Emitted.Payload[0] = Name;
+                    Emitted.Payload[1] = Record;
+                    break;
+                }
+                case ENodeKind::NamespaceDeclaration: {
+                    auto& Namespace = static_cast<NamespaceDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Namespace.Declarations.begin(), Namespace.Declarations.end());
+                    const uint32_t Name = Flat.InternString(Namespace.Name);
+                    Emit(Node).Payload[0] = Name;
+                    break;
+                }
+                case ENodeKind::UsingDeclaration: {
+                    const uint32_t Path = Flat.InternString(static_cast<UsingDeclaration&>(Node).Path);
+                    Emit(Node).Payload[0] = Path;
+                    break;
+                }
+                case ENodeKind::GlobalDeclaration:
+                    Slots.push_back(static_cast<GlobalDeclaration&>(Node).Variable);
+                    Emit(Node);
+                    break;
+                case ENodeKind::TranslationUnit: {
+                    auto& Unit = static_cast<TranslationUnit&>(Node);
+                    Slots.insert(Slots.end(), Unit.Declarations.begin(), Unit.Declarations.end());
+                    const uint32_t SourceName = Flat.InternString(Unit.SourceName);
+                    Emit(Node).Payload[0] = SourceName;
+                    break;
+                }
+
+                // Leaves
+                case ENodeKind::IntegerLiteral:
+                    std::memcpy(Emit(Node).Payload, &static_cast<IntegerLiteral&>(Node).Value, sizeof(long long));
+                    break;
+                case ENodeKind::FloatLiteral:
+                    std::memcpy(Emit(Node).Payload, &static_cast<FloatLiteral&>(Node).Value, sizeof(double));
+                    break;
+                case ENodeKind::StringLiteral: {
+                    const uint32_t Value = Flat.InternString(static_cast<StringLiteral&>(Node).Value);
+                    Emit(Node).Payload[0] = Value;
+                    break;
+                }
+                case ENodeKind::CharLiteral:
+                    Emit(Node).Payload[0] = static_cast<uint8_t>(static_cast<CharLiteral&>(Node).Value);
+                    break;
+                case ENodeKind::BoolLiteral:
+                    Emit(Node).Flags = static_cast<BoolLiteral&>(Node).Value ? 1 : 0;
+                    break;
+                case ENodeKind::Identifier: {
+                    const uint32_t Name = Flat.InternString(static_cast<Identifier&>(Node).Name);
+                    Emit(Node).Payload[0] = Name;
+                    break;
+                }
+                case ENodeKind::NullLiteral:
+                case ENodeKind::ThisExpression:
+                case ENodeKind::SuperExpression:
+                case ENodeKind::BreakStatement:
+                case ENodeKind::ContinueStatement:
+                    Emit(Node);
+                    break;
+            }
+        }
+
+        uint32_t InternOptionalType(const TypeRef* Type) {
+            return Type != nullptr ? Flat.InternType(Type) : InvalidNode;
+        }
+
+        /** Appends { count, type ids... } to the Extra array */
+        void PushTypes(const ArenaArray<const TypeRef*>& TypeList) {
+            Flat.ExtraData.push_back(static_cast<uint32_t>(TypeList.size()));
+            for (const auto* Type : TypeList) {
+                Flat.ExtraData.push_back(Flat.InternType(Type));
+            }
+        }
+
+        /**
+         * Emits Source with the layout in Slots. The present children are
+         * the most recently finished subtrees, in source order.
+         */
+        FlatNode& Emit(const ASTNode& Source) {
+            size_t Present = 0;
+            for (const auto* Slot : Slots) {
+                Present += Slot != nullptr ? 1 : 0;
+            }
+
+            FlatNode Node;
+            Node.Kind       = Source.Kind;
+            Node.FirstChild = static_cast<uint32_t>(Flat.ChildData.size());
+            Node.ChildCount = static_cast<uint32_t>(Slots.size());
+
+            const NodeIndex* Next = Finished.data() + Finished.size() - Present;
+            for (const auto* Slot : Slots) {
+                Flat.ChildData.push_back(Slot != nullptr ? *Next++ : InvalidNode);
+            }
+            Finished.resize(Finished.size() - Present);
+
+            Finished.push_back(static_cast<NodeIndex>(Flat.NodeData.size()));
+            Flat.NodeData.push_back(Node);
+            Flat.LocationData.push_back(Source.Location);
+
+            return Flat.NodeData.back();
+        }
+    };
+
+    FlatAST::FlatAST() {
+        UpdateView();
+    }
+
+    FlatAST::FlatAST(FlatAST&& Other) noexcept {
+        *this = std::move(Other);
+    }
+
+    FlatAST& FlatAST::operator=(FlatAST&& Other) noexcept {
+        NodeData         = std::move(Other.NodeData);
+        LocationData     = std::move(Other.LocationData);
+        ChildData        = std::move(Other.ChildData);
+        RootData         = std::move(Other.RootData);
+        StringOffsetData = std::move(Other.StringOffsetData);
+        StringBlob       = std::move(Other.StringBlob);
+        StringIds        = std::move(Other.StringIds);
+        TypeData         = std::move(Other.TypeData);
+        TypeStringData   = std::move(Other.TypeStringData);
+        ExtraData        = std::move(Other.ExtraData);
+        TypeIds          = std::move(Other.TypeIds);
+
+        // The short-string buffer of StringBlob does not survive the move
+        UpdateView();
+
+        Other.NodeData.clear();
+        Other.LocationData.clear();
+        Other.ChildData.clear();
+        Other.RootData.clear();
+        Other.StringOffsetData.assign(1, 0);
+        Other.StringBlob.clear();
+        Other.StringIds.clear();
+        Other.TypeData.clear();
+        Other.TypeStringData.clear();
+        Other.ExtraData.clear();
+        Other.TypeIds.clear();
+        Other.UpdateView();
+
+        return *this;
+    }
+
+    NodeIndex FlatAST::Append(ASTNode* Root) {
+        FlatASTBuilder Builder(*this);
+        const NodeIndex Index = Builder.Build(Root);
+
+        if (Index != InvalidNode) {
+            RootData.push_back(Index);
+        }
+
+        UpdateView();
+        return Index;
+    }
+
+    void FlatAST::UpdateView() {
+        Nodes         = NodeData.data();
+        Locations     = LocationData.data();
+        Children      = ChildData.data();
+        Roots         = RootData.data();
+        StringOffsets = StringOffsetData.data();
+        StringData    = StringBlob.data();
+        Types         = TypeData.data();
+        TypeStrings   = TypeStringData.data();
+        Extra         = ExtraData.data();
+
+        NodeCount       = static_cast<uint32_t>(NodeData.size());
+        ChildCount      = static_cast<uint32_t>(ChildData.size());
+        RootCount       = static_cast<uint32_t>(RootData.size());
+        StringCount     = static_cast<uint32_t>(StringOffsetData.size() - 1);
+        StringDataSize  = static_cast<uint32_t>(StringBlob.size());
+        TypeCount       = static_cast<uint32_t>(TypeData.size());
+        TypeStringCount = static_cast<uint32_t>(TypeStringData.size());
+        ExtraCount      = static_cast<uint32_t>(ExtraData.size());
+    }
+
+    uint32_t FlatAST::InternString(const std::string_view Text) {
+        const uint64_t Key = HashBytes(Text);
+
+        const auto [First, Last] = StringIds.equal_range(Key);
+        for (auto IT = First; IT != Last; ++IT) {
+            const uint32_t Id = IT->second;
+            const std::string_view Stored(StringBlob.data() + StringOffsetData[Id],
+                                          StringOffsetData[Id + 1] - StringOffsetData[Id]);
+            if (Stored == Text) {
+                return Id;
+            }
+        }
+
+        const auto Id = static_cast<uint32_t>(StringOffsetData.size() - 1);
+        StringBlob.append(Text);
+        StringOffsetData.push_back(static_cast<uint32_t>(StringBlob.size()));
+        StringIds.emplace(Key, Id);
+        return Id;
+    }
+
+    uint32_t FlatAST::InternType(const TypeRef* Type) {
+        if (const auto IT = TypeIds.find(Type); IT != TypeIds.end()) {
+            return IT->second;
+        }
+
+        FlatType Flat;
+        Flat.Name  = InternString(Type->Name);
+        Flat.Flags = (Type->IsPointer ? 1 : 0) | (Type->IsUnique ? 2 : 0) |
+                     (Type->IsShared ? 4 : 0) | (Type->IsBorrow ? 8 : 0) | (Type->IsArray ? 16 : 0);
+
+        Flat.FirstPath = static_cast<uint32_t>(TypeStringData.size());
+        Flat.PathCount = static_cast<uint32_t>(Type->MemberPath.size());
+        for (const auto& Member : Type->MemberPath) {
+            TypeStringData.push_back(InternString(Member));
+        }
+
+        Flat.FirstAllowed = static_cast<uint32_t>(TypeStringData.size());
+        Flat.AllowedCount = static_cast<uint32_t>(Type->AllowedFields.size());
+        for (const auto& Field : Type->AllowedFields) {
+            TypeStringData.push_back(InternString(Field));
+        }
+
+        const auto Id = static_cast<uint32_t>(TypeData.size());
+        TypeData.push_back(Flat);
+        TypeIds.emplace(Type, Id);
+        return Id;
+    }
+
+    // ============================================================================
+    // ACCESSORS
+    // ============================================================================
+
+    NodeIndex FlatASTView::GetSubtreeBegin(NodeIndex Root) const {
+        // In post-order the subtree starts at its leftmost, deepest descendant
+        while (true) {
+            NodeIndex First = InvalidNode;
+            for (const NodeIndex* Child = ChildrenBegin(Root); Child != ChildrenEnd(Root); ++Child) {
+                if (*Child != InvalidNode) {
+                    First = *Child;
+                    break;
+                }
+            }
+
+            if (First == InvalidNode) {
+                return Root;
+            }
+
+            Root = First;
+        }
+    }
+
+    long long FlatASTView::GetInteger(const NodeIndex Index) const {
+        long long Value;
+        std::memcpy(&Value, Nodes[Index].Payload, sizeof(Value));
+        return Value;
+    }
+
+    double FlatASTView::GetFloat(const NodeIndex Index) const {
+        double Value;
+        std::memcpy(&Value, Nodes[Index].Payload, sizeof(Value));
+        return Value;
+    }
+
+    std::string FlatASTView::TypeToString(const uint32_t TypeId) const {
+        const FlatType& Type = Types[TypeId];
+        std::stringstream Stream;
+
+        if (Type.Flags & 2) { Stream << "Unique "; }
+        if (Type.Flags & 4) { Stream << "Shared "; }
+        if (Type.Flags & 8) { Stream << "Borrow "; }
+
+        Stream << GetString(Type.Name);
+
+        for (uint32_t Index = 0; Index < Type.PathCount; ++Index) {
+            Stream << "." << GetString(TypeStrings[Type.FirstPath + Index]);
+        }
+
+        if (Type.AllowedCount > 0) {
+            Stream << "{";
+            for (uint32_t Index = 0; Index < Type.AllowedCount; ++Index) {
+                if (Index > 0) {
+                    Stream << ", ";
+                }
+                Stream << GetString(TypeStrings[Type.FirstAllowed + Index]);
+            }
+            Stream << "}";
+        }
+
+        if (Type.Flags & 1) { Stream << "*"; }
+
+        return Stream.str();
+    }
+
+    // ============================================================================
+    // WHOLE-TREE PASSES
+    // ============================================================================
+
+    std::array<size_t, NodeKindCount> FlatASTView::CountKinds(const NodeIndex Root) const {
+        std::array<size_t, NodeKindCount> Counts{};
+
+        for (NodeIndex Index = GetSubtreeBegin(Root); Index <= Root; ++Index) {
+            ++Counts[static_cast<size_t>(Nodes[Index].Kind)];
+        }
+
+        return Counts;
+    }
+
+    std::vector<uint64_t> FlatASTView::ComputeHashes(const NodeIndex Root) const {
+        std::vector<uint64_t> Hashes(NodeCount, 0);
+        std::vector<uint64_t> StringHashes(StringCount, 0);
+
+        for (uint32_t Index = 0; Index < StringCount; ++Index) {
+            StringHashes[Index] = HashBytes(GetString(Index));
+        }
+
+        const auto HashType = [&](const uint32_t TypeId) {
+            if (TypeId == InvalidNode) {
+                return uint64_t{ 0 };
+            }
+
+            const FlatType& Type = Types[TypeId];
+            uint64_t Hash = HashCombine(StringHashes[Type.Name], Type.Flags);
+            for (uint32_t Index = 0; Index < Type.PathCount; ++Index) {
+                Hash = HashCombine(Hash, StringHashes[TypeStrings[Type.FirstPath + Index]]);
+            }
+            Hash = HashCombine(Hash, Type.AllowedCount);
+            for (uint32_t Index = 0; Index < Type.AllowedCount; ++Index) {
+                Hash = HashCombine(Hash, StringHashes[TypeStrings[Type.FirstAllowed + Index]]);
+            }
+            return Hash;
+        };
+
+        // Hashes a { count, type ids... } record and returns the word after it
+        const auto HashTypes = [&](const uint32_t* Record, uint64_t& Hash) {
+            Hash = HashCombine(Hash, Record[0]);
+            for (uint32_t Type = 0; Type < Record[0]; ++Type) {
+                Hash = HashCombine(Hash, HashType(Record[1 + Type]));
+            }
+            return Record + 1 + Record[0];
+        };
+
+        for (NodeIndex Index = GetSubtreeBegin(Root); Index <= Root; ++Index) {
+            const FlatNode& Node = Nodes[Index];
+            uint64_t Hash = HashCombine(static_cast<uint64_t>(Node.Kind), Node.Flags);
+
+            switch (Node.Kind) {
+                case ENodeKind::IntegerLiteral:
+                case ENodeKind::FloatLiteral:
+                    Hash = HashCombine(Hash, Node.Payload[0] | static_cast<uint64_t>(Node.Payload[1]) << 32);
+                    break;
+                case ENodeKind::CharLiteral:
+                    Hash = HashCombine(Hash, Node.Payload[0]);
+                    break;
+                case ENodeKind::StringLiteral:
+                case ENodeKind::Identifier:
+                case ENodeKind::MemberAccess:
+                case ENodeKind::ForStatement:
+                    Hash = HashCombine(Hash, StringHashes[Node.Payload[0]]);
+                    break;
+                case ENodeKind::CastExpression:
+                case ENodeKind::NewExpression:
+                    Hash = HashCombine(Hash, HashType(Node.Payload[0]));
+                    break;
+                case ENodeKind::VariableDeclaration:
+                    Hash = HashCombine(Hash, StringHashes[Node.Payload[0]]);
+                    Hash = HashCombine(Hash, HashType(Node.Payload[1]));
+                    break;
+                case ENodeKind::FieldDeclaration:
+                    Hash = HashCombine(Hash, Node.Reserved);
+                    Hash = HashCombine(Hash, StringHashes[Node.Payload[0]]);
+                    Hash = HashCombine(Hash, HashType(Node.Payload[1]));
+                    break;
+                case ENodeKind::FunctionDeclaration: {
+                    const uint32_t* Record = GetExtra(Index);
+                    Hash = HashCombine(Hash, Node.Reserved);
+                    Hash = HashCombine(Hash, StringHashes[Node.Payload[0]]);
+                    Hash = HashCombine(Hash, HashType(Record[0]));
+                    Hash = HashCombine(Hash, Record[1]);
+                    for (uint32_t Param = 0; Param < Record[1]; ++Param) {
+                        Hash = HashCombine(Hash, StringHashes[Record[2 + Param * 2]]);
+                        Hash = HashCombine(Hash, HashType(Record[3 + Param * 2]));
+                    }
+                    break;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    const uint32_t* Record = GetExtra(Index);
+                    Hash = HashCombine(Hash, StringHashes[Node.Payload[0]]);
+                    Hash = HashCombine(Hash, Record[0]);
+                    const uint32_t* Attributes = HashTypes(Record + 1, Hash);
+                    Hash = HashCombine(Hash, Attributes[0]);
+                    for (uint32_t Attribute = 0; Attribute < Attributes[0]; ++Attribute) {
+                        Hash = HashCombine(Hash, StringHashes[Attributes[1 + Attribute]]);
+                    }
+                    break;
+                }
+                case ENodeKind::InterfaceDeclaration:
+                    Hash = HashCombine(Hash, StringHashes[Node.Payload[0]]);
+                    HashTypes(GetExtra(Index), Hash);
+                    break;
+                case ENodeKind::FetchDeclaration:
+                case ENodeKind::SetDeclaration:
+                case ENodeKind::NamespaceDeclaration:
+                case ENodeKind::UsingDeclaration:
+                case ENodeKind::TranslationUnit:
+                    Hash = HashCombine(Hash, StringHashes[Node.Payload[0]]);
+                    break;
+                default:
+                    break;
+            }
+
+            Hash = HashCombine(Hash, Node.ChildCount);
+            for (const NodeIndex* Child = ChildrenBegin(Index); Child != ChildrenEnd(Index); ++Child) {
+                Hash = HashCombine(Hash, *Child == InvalidNode ? 0 : Hashes[*Child]);
+            }
+
+            Hashes[Index] = Hash;
+        }
+
+        return Hashes;
+    }
+
+    uint64_t FlatASTView::Hash(const NodeIndex Root) const {
+        return ComputeHashes(Root)[Root];
+    }
+
+    std::string FlatASTView::ToString(const NodeIndex Root) const {
+        // Same scheme as PrintTree(): text before a node's first child goes
+        // straight to the output, the rest is pushed in reverse as pending
+        // work. Linear in the output size however deep the tree is.
+        struct PrintItem {
+            NodeIndex   Node;       // InvalidNode for plain text
+            std::string Text;
+        };
+
+        std::vector<PrintItem> Stack;
+        std::string Output;
+
+        const auto PushNode = [&Stack](const NodeIndex Node) { Stack.push_back({ Node, {} }); };
+        const auto PushText = [&Stack](std::string Text) { Stack.push_back({ InvalidNode, std::move(Text) }); };
+        const auto PushList = [&](const NodeIndex Index, const uint32_t First) {
+            for (uint32_t Slot = Nodes[Index].ChildCount; Slot-- > First;) {
+                PushNode(GetChild(Index, Slot));
+                if (Slot > First) {
+                    PushText(", ");
+                }
+            }
+        };
+
+        const auto PushMembers = [&](const NodeIndex Index) {
+            PushText(" }");
+            for (uint32_t Slot = Nodes[Index].ChildCount; Slot-- > 0;) {
+                PushNode(GetChild(Index, Slot));
+                PushText(" ");
+            }
+        };
+        const auto JoinTypes = [this](const char* Prefix, const uint32_t* Record) {
+            std::string Text;
+            for (uint32_t Type = 0; Type < Record[0]; ++Type) {
+                Text += Type == 0 ? Prefix : ", ";
+                Text += TypeToString(Record[1 + Type]);
+            }
+            return Text;
+        };
+
+        PushNode(Root);
+
+        while (!Stack.empty()) {
+            PrintItem Item = std::move(Stack.back());
+            Stack.pop_back();
+
+            if (Item.Node == InvalidNode) {
+                Output += Item.Text;
+                continue;
+            }
+
+            const NodeIndex Index = Item.Node;
+            const FlatNode& Node = Nodes[Index];
+
+            switch (Node.Kind) {
+                case ENodeKind::IntegerLiteral:
+                    Output += IntegerLiteral(GetInteger(Index)).ToString();
+                    break;
+                case ENodeKind::FloatLiteral:
+                    Output += FloatLiteral(GetFloat(Index)).ToString();
+                    break;
+                case ENodeKind::StringLiteral:
+                    Output += Concat({ "\"", GetString(Node.Payload[0]), "\"" });
+                    break;
+                case ENodeKind::CharLiteral:
+                    Output += std::string("'") + static_cast<char>(Node.Payload[0]) + "'";
+                    break;
+                case ENodeKind::BoolLiteral:
+                    Output += Node.Flags ? "true" : "false";
+                    break;
+                case ENodeKind::NullLiteral:
+                    Output += "null";
+                    break;
+                case ENodeKind::Identifier:
+                    Output += GetString(Node.Payload[0]);
+                    break;
+                case ENodeKind::BinaryExpression:
+                    Output += "(";
+                    PushText(")");
+                    PushNode(GetChild(Index, 1));
+                    PushText(Concat({ " ", BinaryOpToString(static_cast<EBinaryOp>(Node.Flags)), " " }));
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::UnaryExpression:
+                    Output += "(" + UnaryOpToString(static_cast<EUnaryOp>(Node.Flags));
+                    PushText(")");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::FunctionCall:
+                    PushText(")");
+                    PushList(Index, 1);
+                    PushText("(");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::MemberAccess:
+                    PushText(Concat({ Node.Flags != 0 ? "?." : ".", GetString(Node.Payload[0]) }));
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::IndexAccess:
+                    PushText("]");
+                    PushNode(GetChild(Index, 1));
+                    PushText("[");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::TernaryExpression:
+                    Output += "(";
+                    PushText(")");
+                    PushNode(GetChild(Index, 2));
+                    PushText(" : ");
+                    PushNode(GetChild(Index, 1));
+                    PushText(" ? ");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::CastExpression:
+                    Output += "(";
+                    PushText(Concat({ " as ", TypeToString(Node.Payload[0]), ")" }));
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::NewExpression:
+                    Output += Concat({ "new ", TypeToString(Node.Payload[0]), "(" });
+                    PushText(")");
+                    PushList(Index, 0);
+                    break;
+                case ENodeKind::ThisExpression:
+                    Output += "this";
+                    break;
+                case ENodeKind::SuperExpression:
+                    Output += "super";
+                    break;
+                case ENodeKind::GroupingExpression:
+                    Output += "(";
+                    PushText(")");
+                    PushNode(GetChild(Index, 0));
+                    break;
+
+                case ENodeKind::VariableDeclaration:
+                    Output += (Node.Flags & 1) ? "Const " : (Node.Flags & 2) ? "Let " : "Var ";
+                    Output += GetString(Node.Payload[0]);
+                    if (Node.Payload[1] != InvalidNode) {
+                        Output += ": " + TypeToString(Node.Payload[1]);
+                    }
+                    if (GetChild(Index, 0) != InvalidNode) {
+                        Output += " = ";
+                        PushText(";");
+                        PushNode(GetChild(Index, 0));
+                    } else {
+                        Output += ";";
+                    }
+                    break;
+                case ENodeKind::ExpressionStatement:
+                    PushText(";");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::BlockStatement:
+                    Output += "{";
+                    PushText(" }");
+                    for (uint32_t Slot = Node.ChildCount; Slot-- > 0;) {
+                        PushNode(GetChild(Index, Slot));
+                        PushText(" ");
+                    }
+                    break;
+                case ENodeKind::IfStatement:
+                    Output += "if ";
+                    if (GetChild(Index, 2) != InvalidNode) {
+                        PushNode(GetChild(Index, 2));
+                        PushText(" else ");
+                    }
+                    PushNode(GetChild(Index, 1));
+                    PushText(" ");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::WhileStatement:
+                    Output += "while ";
+                    PushNode(GetChild(Index, 1));
+                    PushText(" ");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::DoWhileStatement:
+                    Output += "do ";
+                    PushText(";");
+                    PushNode(GetChild(Index, 1));
+                    PushText(" while ");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::ForStatement:
+                    Output += Concat({ "for ", GetString(Node.Payload[0]), " in " });
+                    PushNode(GetChild(Index, 3));
+                    PushText(" ");
+                    if (GetChild(Index, 2) != InvalidNode) {
+                        PushNode(GetChild(Index, 2));
+                        PushText(" step ");
+                    }
+                    PushNode(GetChild(Index, 1));
+                    PushText(Node.Flags ? "..=" : "..");
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::ReturnStatement:
+                    if (GetChild(Index, 0) != InvalidNode) {
+                        Output += "return ";
+                        PushText(";");
+                        PushNode(GetChild(Index, 0));
+                    } else {
+                        Output += "return;";
+                    }
+                    break;
+                case ENodeKind::BreakStatement:
+                    Output += "break;";
+                    break;
+                case ENodeKind::ContinueStatement:
+                    Output += "continue;";
+                    break;
+                case ENodeKind::MatchStatement:
+                    Output += "match ";
+                    PushText(" }");
+                    for (uint32_t Slot = Node.ChildCount - 1; Slot >= 1; Slot -= 2) {
+                        PushNode(GetChild(Index, Slot));
+                        PushText(" -> ");
+                        PushNode(GetChild(Index, Slot - 1));
+                        PushText(" ");
+                    }
+                    PushText(" {");
+                    PushNode(GetChild(Index, 0));
+                    break;
+
+                case ENodeKind::FieldDeclaration:
+                    Output += AccessPrefix(Node.Reserved);
+                    if (Node.Flags & 1) { Output += "Static "; }
+                    if (Node.Flags & 2) { Output += "Const "; }
+                    Output += Concat({ GetString(Node.Payload[0]), " -> ", TypeToString(Node.Payload[1]) });
+                    if (GetChild(Index, 0) != InvalidNode) {
+                        Output += " = ";
+                        PushText(";");
+                        PushNode(GetChild(Index, 0));
+                    } else {
+                        Output += ";";
+                    }
+                    break;
+                case ENodeKind::FunctionDeclaration: {
+                    const uint32_t* Record = GetExtra(Index);
+                    const uint32_t ParamCount = Record[1];
+
+                    Output += AccessPrefix(Node.Reserved);
+                    if (Node.Flags & FunctionStatic) { Output += "Static "; }
+                    if (Node.Flags & FunctionVirtual) { Output += "Virtual "; }
+                    if (Node.Flags & FunctionOverride) { Output += "Override "; }
+                    if (Node.Flags & FunctionImplement) { Output += "Implement "; }
+                    if (Node.Flags & FunctionOperator) { Output += "Operator "; }
+                    Output += Concat({ GetString(Node.Payload[0]), "(" });
+
+                    std::string Tail = ")";
+                    if (Record[0] != InvalidNode) {
+                        Tail += " -> " + TypeToString(Record[0]);
+                    }
+
+                    if (GetChild(Index, ParamCount) != InvalidNode) {
+                        PushNode(GetChild(Index, ParamCount));
+                        PushText(Tail + " ");
+                    } else {
+                        PushText(Tail + ";");
+                    }
+
+                    for (uint32_t Param = ParamCount; Param-- > 0;) {
+                        const NodeIndex Default = GetChild(Index, Param);
+                        const uint32_t Type = Record[3 + Param * 2];
+                        if (Default != InvalidNode) {
+                            PushNode(Default);
+                        }
+                        PushText(Concat({ Param > 0 ? ", " : "", GetString(Record[2 + Param * 2]),
+                                          Type != InvalidNode ? ": " + TypeToString(Type) : "",
+                                          Default != InvalidNode ? " = " : "" }));
+                    }
+                    break;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    const uint32_t* Record = GetExtra(Index);
+                    const uint32_t* Attributes = Record + 2 + Record[1];
+                    for (uint32_t Attribute = 0; Attribute < Attributes[0]; ++Attribute) {
+                        Output += Concat({ "@", GetString(Attributes[1 + Attribute]), " " });
+                    }
+                    Output += Concat({ "Define ", GetString(Node.Payload[0]), JoinTypes(" : ", Record + 1), " {" });
+                    PushMembers(Index);
+                    break;
+                }
+                case ENodeKind::FetchDeclaration:
+                    Output += Concat({ "Fetch ", GetString(Node.Payload[0]), " {" });
+                    PushMembers(Index);
+                    break;
+                case ENodeKind::SetDeclaration:
+                    Output += Concat({ "Set ", GetString(Node.Payload[0]), " {" });
+                    PushMembers(Index);
+                    break;
+                case ENodeKind::InterfaceDeclaration:
+                    Output += Concat({ "Interface ", GetString(Node.Payload[0]), JoinTypes(" : ", GetExtra(Index)), " {" });
+                    PushMembers(Index);
+                    break;
+                case ENodeKind::NamespaceDeclaration:
+                    Output += Concat({ "Namespace ", GetString(Node.Payload[0]), " {" });
+                    PushMembers(Index);
+                    break;
+                case ENodeKind::UsingDeclaration:
+                    Output += Concat({ "Using ", GetString(Node.Payload[0]), ";" });
+                    break;
+                case ENodeKind::GlobalDeclaration:
+                    Output += "global ";
+                    PushNode(GetChild(Index, 0));
+                    break;
+                case ENodeKind::TranslationUnit:
+                    for (uint32_t Slot = Node.ChildCount; Slot-- > 0;) {
+                        PushNode(GetChild(Index, Slot));
+                        if (Slot > 0) {
+                            PushText("\n");
+                        }
+                    }
+                    break;
+            }
+        }
+
+        return Output;
+    }
+
+    // ============================================================================
+    // REBUILDING
+    // ============================================================================
+
+    const TypeRef* FlatASTView::RebuildType(const uint32_t TypeId, ASTContext& Context) const {
+        const FlatType& Flat = Types[TypeId];
+
+        TypeRef Key(GetString(Flat.Name));
+        Key.IsPointer = (Flat.Flags & 1) != 0;
+        Key.IsUnique  = (Flat.Flags & 2) != 0;
+        Key.IsShared  = (Flat.Flags & 4) != 0;
+        Key.IsBorrow  = (Flat.Flags & 8) != 0;
+        Key.IsArray   = (Flat.Flags & 16) != 0;
+
+        std::vector<std::string_view> Path;
+        for (uint32_t Index = 0; Index < Flat.PathCount; ++Index) {
+            Path.push_back(GetString(TypeStrings[Flat.FirstPath + Index]));
+        }
+        Key.MemberPath = ArenaArray<std::string_view>(Path.data(), Path.size());
+
+        std::vector<std::string_view> Allowed;
+        for (uint32_t Index = 0; Index < Flat.AllowedCount; ++Index) {
+            Allowed.push_back(GetString(TypeStrings[Flat.FirstAllowed + Index]));
+        }
+        Key.AllowedFields = ArenaArray<std::string_view>(Allowed.data(), Allowed.size());
+
+        return Context.GetTypes().Get(Key);
+    }
+
+    const TypeRef* FlatASTView::RebuildOptionalType(const uint32_t TypeId, ASTContext& Context) const {
+        return TypeId != InvalidNode ? RebuildType(TypeId, Context) : nullptr;
+    }
+
+    ArenaArray<const TypeRef*> FlatASTView::RebuildTypes(const uint32_t* Record, ASTContext& Context) const {
+        std::vector<const TypeRef*> Rebuilt;
+        for (uint32_t Type = 0; Type < Record[0]; ++Type) {
+            Rebuilt.push_back(RebuildType(Record[1 + Type], Context));
+        }
+        return Context.CreateArray(Rebuilt);
+    }
+
+    ASTNode* FlatASTView::ToTree(const NodeIndex Root, ASTContext& Context) const {
+        std::vector<ASTNode*> Stack;
+        std::vector<ASTNode*> Parts;
+
+        const auto AsExpression = [](ASTNode* Node) { return static_cast<Expression*>(Node); };
+        const auto AsStatement  = [](ASTNode* Node) { return static_cast<Statement*>(Node); };
+
+        for (NodeIndex Index = GetSubtreeBegin(Root); Index <= Root; ++Index) {
+            const FlatNode& Node = Nodes[Index];
+
+            size_t Present = 0;
+            for (const NodeIndex* Child = ChildrenBegin(Index); Child != ChildrenEnd(Index); ++Child) {
+                Present += *Child != InvalidNode ? 1 : 0;
+            }
+
+            Parts.assign(Node.ChildCount, nullptr);
+            size_t Source = Stack.size() - Present;
+            for (uint32_t Slot = 0; Slot < Node.ChildCount; ++Slot) {
+                if (GetChild(Index, Slot) != InvalidNode) {
+                    Parts[Slot] = Stack[Source++];
+                }
+            }
+            Stack.resize(Stack.size() - Present);
+
+            ASTNode* Built = nullptr;
+
+            switch (Node.Kind) {
+                case ENodeKind::IntegerLiteral:
+                    Built = Context.Create<IntegerLiteral>(GetInteger(Index));
+                    break;
+                case ENodeKind::FloatLiteral:
+                    Built = Context.Create<FloatLiteral>(GetFloat(Index));
+                    break;
+                case ENodeKind::StringLiteral:
+                    Built = Context.Create<StringLiteral>(Context.Intern(GetString(Node.Payload[0])));
+                    break;
+                case ENodeKind::CharLiteral:
+                    Built = Context.Create<CharLiteral>(static_cast<char>(Node.Payload[0]));
+                    break;
+                case ENodeKind::BoolLiteral:
+                    Built = Context.Create<BoolLiteral>(Node.Flags != 0);
+                    break;
+                case ENodeKind::NullLiteral:
+                    Built = Context.Create<NullLiteral>();
+                    break;
+                case ENodeKind::Identifier:
+                    Built = Context.Create<Identifier>(Context.Intern(GetString(Node.Payload[0])));
+                    break;
+                case ENodeKind::BinaryExpression:
+                    Built = Context.Create<BinaryExpression>(
+                        AsExpression(Parts[0]), static_cast<EBinaryOp>(Node.Flags), AsExpression(Parts[1]));
+                    break;
+                case ENodeKind::UnaryExpression:
+                    Built = Context.Create<UnaryExpression>(static_cast<EUnaryOp>(Node.Flags), AsExpression(Parts[0]));
+                    break;
+                case ENodeKind::FunctionCall: {
+                    auto* Call = Context.Create<FunctionCall>(AsExpression(Parts[0]));
+                    std::vector<Expression*> Arguments;
+                    for (size_t Slot = 1; Slot < Parts.size(); ++Slot) {
+                        Arguments.push_back(AsExpression(Parts[Slot]));
+                    }
+                    Call->Arguments = Context.CreateArray(Arguments);
+                    Built = Call;
+                    break;
+                }
+                case ENodeKind::MemberAccess:
+                    Built = Context.Create<MemberAccess>(AsExpression(Parts[0]), Context.Intern(GetString(Node.Payload[0])),
+                                                         Node.Flags != 0);
+                    break;
+                case ENodeKind::IndexAccess:
+                    Built = Context.Create<IndexAccess>(AsExpression(Parts[0]), AsExpression(Parts[1]));
+                    break;
+                case ENodeKind::TernaryExpression:
+                    Built = Context.Create<TernaryExpression>(
+                        AsExpression(Parts[0]), AsExpression(Parts[1]), AsExpression(Parts[2]));
+                    break;
+                case ENodeKind::CastExpression:
+                    Built = Context.Create<CastExpression>(AsExpression(Parts[0]), RebuildType(Node.Payload[0], Context));
+                    break;
+                case ENodeKind::NewExpression: {
+                    auto* New = Context.Create<NewExpression>(RebuildType(Node.Payload[0], Context));
+                    std::vector<Expression*> Arguments;
+                    for (auto* Part : Parts) {
+                        Arguments.push_back(AsExpression(Part));
+                    }
+                    New->Arguments = Context.CreateArray(Arguments);
+                    Built = New;
+                    break;
+                }
+                case ENodeKind::ThisExpression:
+                    Built = Context.Create<ThisExpression>();
+                    break;
+                case ENodeKind::SuperExpression:
+                    Built = Context.Create<SuperExpression>();
+                    break;
+                case ENodeKind::GroupingExpression:
+                    Built = Context.Create<GroupingExpression>(AsExpression(Parts[0]));
+                    break;
+
+                case ENodeKind::VariableDeclaration:
+                    Built = Context.Create<VariableDeclaration>(
+                        (Node.Flags & 1) != 0, (Node.Flags & 2) != 0,
+                        Context.Intern(GetString(Node.Payload[0])),
+                        Node.Payload[1] != InvalidNode ? RebuildType(Node.Payload[1], Context) : nullptr,
+                        AsExpression(Parts[0]));
+                    break;
+                case ENodeKind::ExpressionStatement:
+                    Built = Context.Create<ExpressionStatement>(AsExpression(Parts[0]));
+                    break;
+                case ENodeKind::BlockStatement: {
+                    auto* Block = Context.Create<BlockStatement>();
+                    std::vector<Statement*> Statements;
+                    for (auto* Part : Parts) {
+                        Statements.push_back(AsStatement(Part));
+                    }
+                    Block->Statements = Context.CreateArray(Statements);
+                    Built = Block;
+                    break;
+                }
+                case ENodeKind::IfStatement:
+                    Built = Context.Create<IfStatement>(
+                        AsExpression(Parts[0]), AsStatement(Parts[1]), AsStatement(Parts[2]));
+                    break;
+                case ENodeKind::WhileStatement:
+                    Built = Context.Create<WhileStatement>(AsExpression(Parts[0]), AsStatement(Parts[1]));
+                    break;
+                case ENodeKind::DoWhileStatement:
+                    Built = Context.Create<DoWhileStatement>(AsStatement(Parts[0]), AsExpression(Parts[1]));
+                    break;
+                case ENodeKind::ForStatement:
+                    Built = Context.Create<ForStatement>(
+                        Context.Intern(GetString(Node.Payload[0])),
+                        AsExpression(Parts[0]), AsExpression(Parts[1]), Node.Flags != 0,
+                        AsStatement(Parts[3]), AsExpression(Parts[2]));
+                    break;
+                case ENodeKind::ReturnStatement:
+                    Built = Context.Create<ReturnStatement>(AsExpression(Parts[0]));
+                    break;
+                case ENodeKind::BreakStatement:
+                    Built = Context.Create<BreakStatement>();
+                    break;
+                case ENodeKind::ContinueStatement:
+                    Built = Context.Create<ContinueStatement>();
+                    break;
+                case ENodeKind::MatchStatement: {
+                    auto* Match = Context.Create<MatchStatement>(AsExpression(Parts[0]));
+                    std::vector<MatchCase> Cases;
+                    for (size_t Slot = 1; Slot + 1 < Parts.size(); Slot += 2) {
+                        Cases.emplace_back(AsExpression(Parts[Slot]), AsStatement(Parts[Slot + 1]));
+                    }
+                    Match->Cases = Context.CreateArray(Cases);
+                    Built = Match;
+                    break;
+                }
+
+                case ENodeKind::FieldDeclaration: {
+                    auto* Field = Context.Create<FieldDeclaration>(
+                        static_cast<EAccessModifier>(Node.Reserved), Context.Intern(GetString(Node.Payload[0])),
+                        RebuildType(Node.Payload[1], Context), AsExpression(Parts[0]));
+                    Field->IsStatic = (Node.Flags & 1) != 0;
+                    Field->IsConst  = (Node.Flags & 2) != 0;
+                    Built = Field;
+                    break;
+                }
+                case ENodeKind::FunctionDeclaration: {
+                    const uint32_t* Record = GetExtra(Index);
+                    const uint32_t ParamCount = Record[1];
+
+                    auto* Function = Context.Create<FunctionDeclaration>(
+                        static_cast<EAccessModifier>(Node.Reserved), Context.Intern(GetString(Node.Payload[0])),
+                        RebuildOptionalType(Record[0], Context), static_cast<BlockStatement*>(Parts[ParamCount]));
+
+                    std::vector<Parameter> Parameters;
+                    for (uint32_t Param = 0; Param < ParamCount; ++Param) {
+                        Parameters.emplace_back(Context.Intern(GetString(Record[2 + Param * 2])),
+                                                RebuildOptionalType(Record[3 + Param * 2], Context));
+                        Parameters.back().DefaultValue = AsExpression(Parts[Param]);
+                    }
+                    Function->Parameters = Context.CreateArray(Parameters);
+
+                    Function->IsStatic    = (Node.Flags & FunctionStatic) != 0;
+                    Function->IsVirtual   = (Node.Flags & FunctionVirtual) != 0;
+                    Function->IsOverride  = (Node.Flags & FunctionOverride) != 0;
+                    Function->IsImplement = (Node.Flags & FunctionImplement) != 0;
+                    Function->IsOperator  = (Node.Flags & FunctionOperator) != 0;
+                    Built = Function;
+                    break;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    const uint32_t* Record = GetExtra(Index);
+                    const uint32_t FieldCount = Record[0];
+                    const uint32_t* Attributes = Record + 2 + Record[1];
+
+                    auto* Define = Context.Create<DefineDeclaration>(Context.Intern(GetString(Node.Payload[0])));
+                    Define->BaseTypes = RebuildTypes(Record + 1, Context);
+
+                    std::vector<std::string_view> Names;
+                    for (uint32_t Attribute = 0; Attribute < Attributes[0]; ++Attribute) {
+                        Names.push_back(Context.Intern(GetString(Attributes[1 + Attribute])));
+                    }
+                    Define->Attributes = Context.CreateArray(Names);
+
+                    Define->Fields  = CastParts<FieldDeclaration>(Parts, 0, FieldCount, Context);
+                    Define->Methods = CastParts<FunctionDeclaration>(Parts, FieldCount, Parts.size(), Context);
+                    Built = Define;
+                    break;
+                }
+                case ENodeKind::FetchDeclaration: {
+                    auto* Fetch = Context.Create<FetchDeclaration>(Context.Intern(GetString(Node.Payload[0])));
+                    Fetch->Methods = CastParts<FunctionDeclaration>(Parts, 0, Parts.size(), Context);
+                    Built = Fetch;
+                    break;
+                }
+                case ENodeKind::SetDeclaration: {
+                    auto* Set = Context.Create<SetDeclaration>(Context.Intern(GetString(Node.Payload[0])));
+                    Set->Methods = CastParts<FunctionDeclaration>(Parts, 0, Parts.size(), Context);
+                    Built = Set;
+                    break;
+                }
+                case ENodeKind::InterfaceDeclaration: {
+                    auto* Interface = Context.Create<InterfaceDeclaration>(Context.Intern(GetString(Node.Payload[0])));
+                    Interface->BaseInterfaces = RebuildTypes(GetExtra(Index), Context);
+                    Interface->Methods = CastParts<FunctionDeclaration>(Parts, 0, Parts.size(), Context);
+                    Built = Interface;
+                    break;
+                }
+                case ENodeKind::NamespaceDeclaration: {
+                    auto* Namespace = Context.Create<NamespaceDeclaration>(Context.Intern(GetString(Node.Payload[0])));
+                    Namespace->Declarations = CastParts<Declaration>(Parts, 0, Parts.size(), Context);
+                    Built = Namespace;
+                    break;
+                }
+                case ENodeKind::UsingDeclaration:
+                    Built = Context.Create<UsingDeclaration>(Context.Intern(GetString(Node.Payload[0])));
+                    break;
+                case ENodeKind::GlobalDeclaration:
+                    Built = Context.Create<GlobalDeclaration>(static_cast<VariableDeclaration*>(Parts[0]));
+                    break;
+                case ENodeKind::TranslationUnit: {
+                    auto* Unit = Context.Create<TranslationUnit>(Context.Intern(GetString(Node.Payload[0])));
+                    Unit->Declarations = CastParts<Declaration>(Parts, 0, Parts.size(), Context);
+                    Built = Unit;
+                    break;
+                }
+            }
+
+            Built->Location = Locations[Index];
+            Stack.push_back(Built);
+        }
+
+        return Stack.empty() ? nullptr : Stack.back();
+    }
+}
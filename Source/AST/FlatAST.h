@@ -0,0 +1,251 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "ASTNode.h"
+
+namespace Vex {
+    class ASTContext;
+
+    using NodeIndex = uint32_t;
+
+    constexpr NodeIndex InvalidNode = 0xFFFFFFFFu;
+
+    /**
+     * One node of a FlatAST (20 bytes, no pointers)
+     *
+     * Children are a range [FirstChild, FirstChild + ChildCount) of the
+     * shared child array. Optional children that are absent are stored as
+     * InvalidNode so every kind keeps a fixed child layout:
+     *
+     *   BinaryExpression     [Left, Right]                 Flags = EBinaryOp
+     *   UnaryExpression      [Operand]                     Flags = EUnaryOp
+     *   FunctionCall         [Callee, Arguments...]
+     *   MemberAccess         [Object]                      Payload[0] = member string, Flags = IsOptional
+     *   IndexAccess          [Object, Index]
+     *   TernaryExpression    [Condition, True, False]
+     *   CastExpression       [Expr]                        Payload[0] = type
+     *   NewExpression        [Arguments...]                Payload[0] = type
+     *   GroupingExpression   [Expr]
+     *   VariableDeclaration  [Initializer?]                Payload = { name, type? }, Flags = Const | Let << 1
+     *   ExpressionStatement  [Expr]
+     *   BlockStatement       [Statements...]
+     *   IfStatement          [Condition, Then, Else?]
+     *   WhileStatement       [Condition, Body]
+     *   DoWhileStatement     [Body, Condition]
+     *   ForStatement         [Start, End, Step?, Body]     Payload[0] = iterator, Flags = IsInclusive
+     *   ReturnStatement      [Value?]
+     *   MatchStatement       [Value, Pattern0, Body0, ...]
+     *   FieldDeclaration     [Initializer?]                Payload = { name, type }, Flags = Static | Const << 1
+     *   FunctionDeclaration  [Default0?, ..., Body?]       Payload[0] = name, Flags = EFunctionFlags
+     *   DefineDeclaration    [Fields..., Methods...]       Payload[0] = name
+     *   FetchDeclaration     [Methods...]                  Payload[0] = target
+     *   SetDeclaration       [Methods...]                  Payload[0] = target
+     *   InterfaceDeclaration [Methods...]                  Payload[0] = name
+     *   NamespaceDeclaration [Declarations...]             Payload[0] = name
+     *   UsingDeclaration     []                            Payload[0] = path
+     *   GlobalDeclaration    [Variable]
+     *   TranslationUnit      [Declarations...]             Payload[0] = source name
+     *
+     * Field and function access modifiers live in Reserved. Declarations
+     * with variable-length metadata keep it in the Extra array, starting
+     * at Payload[1]:
+     *
+     *   FunctionDeclaration  { return type?, count, (name, type?) per parameter }
+     *   DefineDeclaration    { field count, base count, bases..., attribute count, attributes... }
+     *   InterfaceDeclaration { base count, bases... }
+     *
+     * (types are type ids, names string ids, absent entries InvalidNode)
+     *
+     * Literals keep their value in the payload (Integer/Float bits, string
+     * id, char, or Flags for Bool); Identifier keeps its name string id.
+     */
+    struct FlatNode {
+        ENodeKind Kind;
+        uint8_t   Flags      = 0;
+        uint16_t  Reserved   = 0;
+        uint32_t  FirstChild = 0;
+        uint32_t  ChildCount = 0;
+        uint32_t  Payload[2] = { 0, 0 };
+    };
+
+    /** FlatNode::Flags of a FunctionDeclaration */
+    enum EFunctionFlags : uint8_t {
+        FunctionStatic    = 1 << 0,
+        FunctionVirtual   = 1 << 1,
+        FunctionOverride  = 1 << 2,
+        FunctionImplement = 1 << 3,
+        FunctionOperator  = 1 << 4,
+    };
+
+    /**
+     * Flattened type reference; strings are ids into the FlatAST string table
+     */
+    struct FlatType {
+        uint32_t Name          = 0;
+        uint32_t Flags         = 0;     // Pointer | Unique << 1 | Shared << 2 | Borrow << 3 | Array << 4
+        uint32_t FirstPath     = 0;     // Range in TypeStrings
+        uint32_t PathCount     = 0;
+        uint32_t FirstAllowed  = 0;     // Range in TypeStrings
+        uint32_t AllowedCount  = 0;
+    };
+
+    // Sections are written to module files byte for byte
+    static_assert(sizeof(FlatNode) == 20 && std::is_trivially_copyable_v<FlatNode>);
+    static_assert(sizeof(FlatType) == 24 && std::is_trivially_copyable_v<FlatType>);
+    static_assert(sizeof(SourceLocation) == 8 && std::is_trivially_copyable_v<SourceLocation>);
+
+    /**
+     * Read-only access to flattened trees
+     *
+     * Every pass works on raw arrays, so the same code runs over a FlatAST
+     * in memory and over a module file mapped straight from disk (see
+     * Module.h) without copying or fixing up anything.
+     */
+    class FlatASTView {
+    public:
+        /** Rebuilds the subtree rooted at Root inside Context */
+        ASTNode* ToTree(NodeIndex Root, ASTContext& Context) const;
+
+        // ---- Node access ----
+
+        [[nodiscard]] size_t Size() const { return NodeCount; }
+        [[nodiscard]] ArenaArray<const NodeIndex> GetRoots() const { return { Roots, RootCount }; }
+
+        [[nodiscard]] const FlatNode& GetNode(const NodeIndex Index) const { return Nodes[Index]; }
+        [[nodiscard]] ENodeKind GetKind(const NodeIndex Index) const { return Nodes[Index].Kind; }
+        [[nodiscard]] const SourceLocation& GetLocation(const NodeIndex Index) const { return Locations[Index]; }
+
+        [[nodiscard]] const NodeIndex* ChildrenBegin(const NodeIndex Index) const {
+            return Children + Nodes[Index].FirstChild;
+        }
+        [[nodiscard]] const NodeIndex* ChildrenEnd(const NodeIndex Index) const {
+            return ChildrenBegin(Index) + Nodes[Index].ChildCount;
+        }
+        [[nodiscard]] NodeIndex GetChild(const NodeIndex Index, const uint32_t Slot) const {
+            return Children[Nodes[Index].FirstChild + Slot];
+        }
+
+        /** First node of the post-order range that makes up the subtree of Root */
+        [[nodiscard]] NodeIndex GetSubtreeBegin(NodeIndex Root) const;
+
+        [[nodiscard]] long long GetInteger(NodeIndex Index) const;
+        [[nodiscard]] double GetFloat(NodeIndex Index) const;
+
+        [[nodiscard]] size_t GetStringCount() const { return StringCount; }
+        [[nodiscard]] std::string_view GetString(const uint32_t StringId) const {
+            return { StringData + StringOffsets[StringId], StringOffsets[StringId + 1] - StringOffsets[StringId] };
+        }
+
+        [[nodiscard]] size_t GetTypeCount() const { return TypeCount; }
+        [[nodiscard]] const FlatType& GetType(uint32_t TypeId) const { return Types[TypeId]; }
+        [[nodiscard]] std::string TypeToString(uint32_t TypeId) const;
+
+        /** Side-table record of a declaration node (Payload[1]), see FlatNode */
+        [[nodiscard]] const uint32_t* GetExtra(const NodeIndex Index) const { return Extra + Nodes[Index].Payload[1]; }
+
+        // ---- Whole-tree passes ----
+
+        /** Number of nodes of each kind in the subtree of Root */
+        [[nodiscard]] std::array<size_t, NodeKindCount> CountKinds(NodeIndex Root) const;
+
+        /**
+         * Structural hash of every node in the subtree of Root (indexed by
+         * NodeIndex; entries outside the subtree are left at zero).
+         * Ignores source locations.
+         */
+        [[nodiscard]] std::vector<uint64_t> ComputeHashes(NodeIndex Root) const;
+        [[nodiscard]] uint64_t Hash(NodeIndex Root) const;
+
+        /** Same text as ASTNode::ToString() of the original subtree */
+        [[nodiscard]] std::string ToString(NodeIndex Root) const;
+
+    protected:
+        FlatASTView() = default;
+
+        void ClearView() { *this = FlatASTView(); }
+
+        const FlatNode*       Nodes         = nullptr;
+        const SourceLocation* Locations     = nullptr;     // Parallel to Nodes
+        const NodeIndex*      Children      = nullptr;
+        const NodeIndex*      Roots         = nullptr;
+        const uint32_t*       StringOffsets = nullptr;     // StringCount + 1 entries into StringData
+        const char*           StringData    = nullptr;
+        const FlatType*       Types         = nullptr;
+        const uint32_t*       TypeStrings   = nullptr;
+        const uint32_t*       Extra         = nullptr;
+
+        uint32_t NodeCount       = 0;
+        uint32_t ChildCount      = 0;
+        uint32_t RootCount       = 0;
+        uint32_t StringCount     = 0;
+        uint32_t StringDataSize  = 0;
+        uint32_t TypeCount       = 0;
+        uint32_t TypeStringCount = 0;
+        uint32_t ExtraCount      = 0;
+
+        friend class ModuleWriter;
+
+    private:
+        const TypeRef* RebuildType(uint32_t TypeId, ASTContext& Context) const;
+        const TypeRef* RebuildOptionalType(uint32_t TypeId, ASTContext& Context) const;
+        ArenaArray<const TypeRef*> RebuildTypes(const uint32_t* Record, ASTContext& Context) const;
+    };
+
+    /**
+     * Index-based, pointer-free representation of syntax trees
+     *
+     * Nodes are stored in post-order: every child precedes its parent and a
+     * subtree is one contiguous range ending at its root. Whole-tree passes
+     * (counting, hashing, printing, rebuilding) are single forward scans
+     * over that range instead of pointer chasing through virtual calls.
+     *
+     * Example:
+     *   FlatAST Flat;
+     *   const NodeIndex Root = Flat.Append(Block);
+     *   std::cout << Flat.ToString(Root);
+     *   Statement* Copy = static_cast<Statement*>(Flat.ToTree(Root, OtherContext));
+     */
+    class FlatAST : public FlatASTView {
+    public:
+        FlatAST();
+
+        FlatAST(const FlatAST&) = delete;
+        FlatAST& operator=(const FlatAST&) = delete;
+
+        FlatAST(FlatAST&& Other) noexcept;
+        FlatAST& operator=(FlatAST&& Other) noexcept;
+
+        /** Flattens a pointer tree and records it as a root. Returns the root index. */
+        NodeIndex Append(ASTNode* Root);
+
+    private:
+        std::vector<FlatNode>       NodeData;
+        std::vector<SourceLocation> LocationData;
+        std::vector<NodeIndex>      ChildData;
+        std::vector<NodeIndex>      RootData;
+
+        std::vector<uint32_t>                         StringOffsetData{ 0 };
+        std::string                                   StringBlob;
+        std::unordered_multimap<uint64_t, uint32_t>   StringIds;      // Content hash -> string id
+
+        std::vector<FlatType>                        TypeData;
+        std::vector<uint32_t>                        TypeStringData;
+        std::vector<uint32_t>                        ExtraData;
+        std::unordered_map<const TypeRef*, uint32_t> TypeIds;
+
+        friend class FlatASTBuilder;
+
+        /** Points the view at the current storage; called after every change */
+        void UpdateView();
+
+        uint32_t InternString(std::string_view Text);
+        uint32_t InternType(const TypeRef* Type);
+    };
+}
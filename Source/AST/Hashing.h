@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Vex {
+
+    /** FNV-1a over the bytes of Text; stable across runs and platforms */
+    inline uint64_t HashBytes(const std::string_view Text) {
+        uint64_t Hash = 0xCBF29CE484222325ull;
+        for (const char C : Text) {
+            Hash ^= static_cast<uint8_t>(C);
+            Hash *= 0x100000001B3ull;
+        }
+        return Hash;
+    }
+
+    /** Mixes Value into Seed (order-sensitive) */
+    inline uint64_t HashCombine(uint64_t Seed, const uint64_t Value) {
+        Seed ^= Value + 0x9E3779B97F4A7C15ull + (Seed << 6) + (Seed >> 2);
+        Seed ^= Seed >> 31;
+        Seed *= 0xBF58476D1CE4E5B9ull;
+        Seed ^= Seed >> 27;
+        return Seed;
+    }
+}
@@ -0,0 +1,364 @@
+#include "Module.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+#ifdef _WIN32
+    #include <iterator>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Vex {
+    namespace {
+        constexpr uint64_t SectionAlignment = 8;
+
+        uint64_t AlignUp(const uint64_t Value) {
+            return (Value + SectionAlignment - 1) & ~(SectionAlignment - 1);
+        }
+
+        const ModuleSection& GetSection(const ModuleHeader& Header, const EModuleSection Section) {
+            return Header.Sections[static_cast<size_t>(Section)];
+        }
+    }
+
+    // ============================================================================
+    // WRITER
+    // ============================================================================
+
+    std::vector<std::pair<std::string, NodeIndex>> ModuleWriter::CollectSymbols(const FlatASTView& Flat) {
+        std::vector<std::pair<std::string, NodeIndex>> Symbols;
+
+        // (declaration, enclosing namespace) pairs still to look at
+        std::vector<std::pair<NodeIndex, std::string>> Pending;
+
+        for (const NodeIndex Root : Flat.GetRoots()) {
+            if (Flat.GetKind(Root) != ENodeKind::TranslationUnit) {
+                continue;
+            }
+
+            for (const NodeIndex* Child = Flat.ChildrenBegin(Root); Child != Flat.ChildrenEnd(Root); ++Child) {
+                Pending.emplace_back(*Child, std::string());
+            }
+
+            while (!Pending.empty()) {
+                auto [Index, Scope] = std::move(Pending.back());
+                Pending.pop_back();
+
+                const FlatNode& Node = Flat.GetNode(Index);
+                const auto Qualify = [&Scope](const std::string_view Name) {
+                    return Scope.empty() ? std::string(Name) : Scope + "::" + std::string(Name);
+                };
+
+                switch (Node.Kind) {
+                    case ENodeKind::NamespaceDeclaration: {
+                        const std::string Inner = Qualify(Flat.GetString(Node.Payload[0]));
+                        for (const NodeIndex* Child = Flat.ChildrenBegin(Index); Child != Flat.ChildrenEnd(Index); ++Child) {
+                            Pending.emplace_back(*Child, Inner);
+                        }
+                        break;
+                    }
+                    case ENodeKind::DefineDeclaration:
+                    case ENodeKind::InterfaceDeclaration:
+                    case ENodeKind::FunctionDeclaration:
+                        Symbols.emplace_back(Qualify(Flat.GetString(Node.Payload[0])), Index);
+                        break;
+                    case ENodeKind::GlobalDeclaration: {
+                        const NodeIndex Variable = Flat.GetChild(Index, 0);
+                        Symbols.emplace_back(Qualify(Flat.GetString(Flat.GetNode(Variable).Payload[0])), Index);
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+
+        // Stable, so overloads keep their source order
+        std::stable_sort(Symbols.begin(), Symbols.end(),
+                         [](const auto& Left, const auto& Right) { return Left.first < Right.first; });
+        return Symbols;
+    }
+
+    bool ModuleWriter::Write(const FlatASTView& Flat, std::ostream& Stream) {
+        const auto Symbols = CollectSymbols(Flat);
+
+        std::vector<ModuleSymbol> SymbolTable;
+        std::string SymbolNames;
+        SymbolTable.reserve(Symbols.size());
+        for (const auto& [Name, Node] : Symbols) {
+            ModuleSymbol Symbol;
+            Symbol.NameOffset = static_cast<uint32_t>(SymbolNames.size());
+            Symbol.NameLength = static_cast<uint32_t>(Name.size());
+            Symbol.Node       = Node;
+            Symbol.Kind       = static_cast<uint32_t>(Flat.GetKind(Node));
+            SymbolTable.push_back(Symbol);
+            SymbolNames += Name;
+        }
+
+        // Every section's size is known now: lay them out, then stream
+        struct Source {
+            const void* Data;
+            size_t      ElementSize;
+            uint32_t    Count;
+        };
+
+        const Source Sources[ModuleSectionCount] = {
+            { Flat.Nodes,         sizeof(FlatNode),       Flat.NodeCount },
+            { Flat.Locations,     sizeof(SourceLocation), Flat.NodeCount },
+            { Flat.Children,      sizeof(NodeIndex),      Flat.ChildCount },
+            { Flat.Roots,         sizeof(NodeIndex),      Flat.RootCount },
+            { Flat.StringOffsets, sizeof(uint32_t),       Flat.StringCount + 1 },
+            { Flat.StringData,    sizeof(char),           Flat.StringDataSize },
+            { Flat.Types,         sizeof(FlatType),       Flat.TypeCount },
+            { Flat.TypeStrings,   sizeof(uint32_t),       Flat.TypeStringCount },
+            { Flat.Extra,         sizeof(uint32_t),       Flat.ExtraCount },
+            { SymbolTable.data(), sizeof(ModuleSymbol),   static_cast<uint32_t>(SymbolTable.size()) },
+            { SymbolNames.data(), sizeof(char),           static_cast<uint32_t>(SymbolNames.size()) },
+        };
+
+        ModuleHeader Header;
+        uint64_t Offset = AlignUp(sizeof(ModuleHeader));
+        for (size_t Section = 0; Section < ModuleSectionCount; ++Section) {
+            Header.Sections[Section].Offset = Offset;
+            Header.Sections[Section].Size   = Sources[Section].ElementSize * Sources[Section].Count;
+            Header.Sections[Section].Count  = Sources[Section].Count;
+            Offset = AlignUp(Offset + Header.Sections[Section].Size);
+        }
+        Header.FileSize = Offset;
+
+        static constexpr char Padding[SectionAlignment] = {};
+        uint64_t Written = 0;
+        const auto Emit = [&](const void* Data, const uint64_t Bytes) {
+            if (Bytes > 0) {
+                Stream.write(static_cast<const char*>(Data), static_cast<std::streamsize>(Bytes));
+                Written += Bytes;
+            }
+        };
+
+        Emit(&Header, sizeof(Header));
+        for (size_t Section = 0; Section < ModuleSectionCount; ++Section) {
+            Emit(Padding, Header.Sections[Section].Offset - Written);
+            Emit(Sources[Section].Data, Header.Sections[Section].Size);
+        }
+        Emit(Padding, Header.FileSize - Written);
+
+        return static_cast<bool>(Stream);
+    }
+
+    bool ModuleWriter::WriteFile(const FlatASTView& Flat, const std::string& Path) {
+        std::ofstream Stream(Path, std::ios::binary | std::ios::trunc);
+        return Stream && Write(Flat, Stream) && Stream.flush();
+    }
+
+    // ============================================================================
+    // READER
+    // ============================================================================
+
+    ModuleFile::~ModuleFile() {
+        Close();
+    }
+
+    bool ModuleFile::Open(const std::string& Path) {
+        Close();
+
+#ifdef _WIN32
+        std::ifstream Stream(Path, std::ios::binary);
+        if (!Stream) {
+            return Fail("Cannot open module file " + Path);
+        }
+
+        Buffer.assign(std::istreambuf_iterator<char>(Stream), std::istreambuf_iterator<char>());
+        MappedData = Buffer.data();
+        MappedSize = Buffer.size();
+#else
+        const int File = ::open(Path.c_str(), O_RDONLY);
+        if (File < 0) {
+            return Fail("Cannot open module file " + Path);
+        }
+
+        struct stat Status {};
+        if (::fstat(File, &Status) != 0 || Status.st_size <= 0) {
+            ::close(File);
+            return Fail("Cannot read module file " + Path);
+        }
+
+        void* Mapping = ::mmap(nullptr, static_cast<size_t>(Status.st_size), PROT_READ, MAP_PRIVATE, File, 0);
+        ::close(File);
+
+        if (Mapping == MAP_FAILED) {
+            return Fail("Cannot map module file " + Path);
+        }
+
+        MappedData = static_cast<const unsigned char*>(Mapping);
+        MappedSize = static_cast<size_t>(Status.st_size);
+        Mapped = true;
+#endif
+
+        return Validate();
+    }
+
+    bool ModuleFile::Load(const void* Data, const size_t Size) {
+        Close();
+
+        MappedData = static_cast<const unsigned char*>(Data);
+        MappedSize = Size;
+        return Validate();
+    }
+
+    void ModuleFile::Close() {
+#ifndef _WIN32
+        if (Mapped) {
+            ::munmap(const_cast<unsigned char*>(MappedData), MappedSize);
+        }
+#endif
+
+        MappedData = nullptr;
+        MappedSize = 0;
+        Mapped = false;
+        Buffer.clear();
+
+        ClearView();
+        Symbols = nullptr;
+        SymbolNames = nullptr;
+        SymbolCount = 0;
+    }
+
+    bool ModuleFile::Fail(std::string Message) {
+        Close();
+        Error = std::move(Message);
+        return false;
+    }
+
+    bool ModuleFile::Validate() {
+        if (MappedData == nullptr || MappedSize < sizeof(ModuleHeader)) {
+            return Fail("Module file is truncated");
+        }
+
+        if (reinterpret_cast<uintptr_t>(MappedData) % SectionAlignment != 0) {
+            return Fail("Module image is not 8-byte aligned");
+        }
+
+        const ModuleHeader& Header = *reinterpret_cast<const ModuleHeader*>(MappedData);
+
+        if (std::memcmp(Header.Magic, "VEXM", 4) != 0) {
+            return Fail("Not a Vex module");
+        }
+        if (Header.EndianMarker != ModuleEndianMarker) {
+            return Fail("Module was written with a different byte order");
+        }
+        if (Header.Version != ModuleVersion) {
+            return Fail("Unsupported module version " + std::to_string(Header.Version));
+        }
+        if (Header.SectionCount != ModuleSectionCount || Header.FileSize != MappedSize) {
+            return Fail("Module header does not match the file");
+        }
+
+        const size_t ElementSizes[ModuleSectionCount] = {
+            sizeof(FlatNode), sizeof(SourceLocation), sizeof(NodeIndex), sizeof(NodeIndex),
+            sizeof(uint32_t), sizeof(char), sizeof(FlatType), sizeof(uint32_t), sizeof(uint32_t),
+            sizeof(ModuleSymbol), sizeof(char),
+        };
+
+        for (size_t Section = 0; Section < ModuleSectionCount; ++Section) {
+            const ModuleSection& Range = Header.Sections[Section];
+            if (Range.Offset % SectionAlignment != 0 || Range.Offset > MappedSize ||
+                Range.Size > MappedSize - Range.Offset ||
+                Range.Size != static_cast<uint64_t>(Range.Count) * ElementSizes[Section]) {
+                return Fail("Module section " + std::to_string(Section) + " is out of bounds");
+            }
+        }
+
+        const auto At = [this, &Header](const EModuleSection Section) {
+            return MappedData + GetSection(Header, Section).Offset;
+        };
+        const auto CountOf = [&Header](const EModuleSection Section) {
+            return GetSection(Header, Section).Count;
+        };
+
+        if (CountOf(EModuleSection::Locations) != CountOf(EModuleSection::Nodes) ||
+            CountOf(EModuleSection::StringOffsets) == 0) {
+            return Fail("Module sections are inconsistent");
+        }
+
+        Nodes           = reinterpret_cast<const FlatNode*>(At(EModuleSection::Nodes));
+        Locations       = reinterpret_cast<const SourceLocation*>(At(EModuleSection::Locations));
+        Children        = reinterpret_cast<const NodeIndex*>(At(EModuleSection::Children));
+        Roots           = reinterpret_cast<const NodeIndex*>(At(EModuleSection::Roots));
+        StringOffsets   = reinterpret_cast<const uint32_t*>(At(EModuleSection::StringOffsets));
+        StringData      = reinterpret_cast<const char*>(At(EModuleSection::StringData));
+        Types           = reinterpret_cast<const FlatType*>(At(EModuleSection::Types));
+        TypeStrings     = reinterpret_cast<const uint32_t*>(At(EModuleSection::TypeStrings));
+        Extra           = reinterpret_cast<const uint32_t*>(At(EModuleSection::Extra));
+        Symbols         = reinterpret_cast<const ModuleSymbol*>(At(EModuleSection::Symbols));
+        SymbolNames     = reinterpret_cast<const char*>(At(EModuleSection::SymbolNames));
+
+        NodeCount       = CountOf(EModuleSection::Nodes);
+        ChildCount      = CountOf(EModuleSection::Children);
+        RootCount       = CountOf(EModuleSection::Roots);
+        StringCount     = CountOf(EModuleSection::StringOffsets) - 1;
+        StringDataSize  = CountOf(EModuleSection::StringData);
+        TypeCount       = CountOf(EModuleSection::Types);
+        TypeStringCount = CountOf(EModuleSection::TypeStrings);
+        ExtraCount      = CountOf(EModuleSection::Extra);
+        SymbolCount     = CountOf(EModuleSection::Symbols);
+
+        // Structural indices that every pass follows blindly are checked
+        // once here; payload ids are trusted, modules are compiler output
+        for (uint32_t Index = 0; Index <= StringCount; ++Index) {
+            if (StringOffsets[Index] > StringDataSize || (Index > 0 && StringOffsets[Index] < StringOffsets[Index - 1])) {
+                return Fail("Module string table is corrupt");
+            }
+        }
+
+        for (NodeIndex Index = 0; Index < NodeCount; ++Index) {
+            const FlatNode& Node = Nodes[Index];
+            if (static_cast<size_t>(Node.Kind) >= NodeKindCount || Node.FirstChild > ChildCount ||
+                Node.ChildCount > ChildCount - Node.FirstChild) {
+                return Fail("Module node " + std::to_string(Index) + " is corrupt");
+            }
+
+            // Post-order: children always precede their parent
+            for (const NodeIndex* Child = ChildrenBegin(Index); Child != ChildrenEnd(Index); ++Child) {
+                if (*Child != InvalidNode && *Child >= Index) {
+                    return Fail("Module node " + std::to_string(Index) + " is corrupt");
+                }
+            }
+        }
+
+        for (uint32_t Root = 0; Root < RootCount; ++Root) {
+            if (Roots[Root] >= NodeCount) {
+                return Fail("Module roots are corrupt");
+            }
+        }
+
+        for (uint32_t Index = 0; Index < SymbolCount; ++Index) {
+            const ModuleSymbol& Symbol = Symbols[Index];
+            if (Symbol.Node >= NodeCount || Symbol.NameOffset > CountOf(EModuleSection::SymbolNames) ||
+                Symbol.NameLength > CountOf(EModuleSection::SymbolNames) - Symbol.NameOffset) {
+                return Fail("Module symbol table is corrupt");
+            }
+        }
+
+        Error.clear();
+        return true;
+    }
+
+    NodeIndex ModuleFile::FindSymbol(const std::string_view QualifiedName) const {
+        const ModuleSymbol* End = Symbols + SymbolCount;
+        const ModuleSymbol* Found = std::lower_bound(
+            Symbols, End, QualifiedName,
+            [this](const ModuleSymbol& Symbol, const std::string_view Name) { return GetSymbolName(Symbol) < Name; });
+
+        if (Found == End || GetSymbolName(*Found) != QualifiedName) {
+            return InvalidNode;
+        }
+
+        return Found->Node;
+    }
+}
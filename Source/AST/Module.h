@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "FlatAST.h"
+
+namespace Vex {
+
+    /**
+     * Binary module format (.vexm), version 1
+     *
+     * A module is a FlatAST written to disk as-is: a fixed header followed
+     * by one 8-byte aligned section per array. Nothing in the file is a
+     * pointer, so a reader maps it and points a FlatASTView at the
+     * sections; the only "fix-up" happens when ToTree() turns indices
+     * back into arena pointers, and only for the declarations that are
+     * actually needed.
+     *
+     *   Header          ModuleHeader
+     *   Nodes           FlatNode[]
+     *   Locations       SourceLocation[]
+     *   Children        NodeIndex[]
+     *   Roots           NodeIndex[]
+     *   StringOffsets   uint32_t[StringCount + 1]
+     *   StringData      char[]
+     *   Types           FlatType[]
+     *   TypeStrings     uint32_t[]
+     *   Extra           uint32_t[]
+     *   Symbols         ModuleSymbol[]   (sorted by qualified name)
+     *   SymbolNames     char[]
+     *
+     * Files are written in the byte order of the producer; the endian
+     * marker rejects files from a machine of the other order.
+     */
+    constexpr uint32_t ModuleVersion = 1;
+    constexpr uint32_t ModuleEndianMarker = 0x01020304u;
+
+    enum class EModuleSection : uint32_t {
+        Nodes,
+        Locations,
+        Children,
+        Roots,
+        StringOffsets,
+        StringData,
+        Types,
+        TypeStrings,
+        Extra,
+        Symbols,
+        SymbolNames,
+    };
+
+    constexpr size_t ModuleSectionCount = static_cast<size_t>(EModuleSection::SymbolNames) + 1;
+
+    struct ModuleSection {
+        uint64_t Offset = 0;            // From the start of the file, 8-byte aligned
+        uint64_t Size   = 0;            // In bytes
+        uint32_t Count  = 0;            // Elements
+        uint32_t Reserved = 0;
+    };
+
+    struct ModuleHeader {
+        char          Magic[4]     = { 'V', 'E', 'X', 'M' };
+        uint32_t      Version      = ModuleVersion;
+        uint32_t      EndianMarker = ModuleEndianMarker;
+        uint32_t      SectionCount = ModuleSectionCount;
+        uint64_t      FileSize     = 0;
+        ModuleSection Sections[ModuleSectionCount];
+    };
+
+    /**
+     * Exported declaration: qualified name (A::B::Name) and its node
+     * Defines, Interfaces, functions and globals are exported; Fetch/Set
+     * blocks are found through the type they belong to.
+     */
+    struct ModuleSymbol {
+        uint32_t  NameOffset = 0;       // Range in SymbolNames
+        uint32_t  NameLength = 0;
+        NodeIndex Node       = InvalidNode;
+        uint32_t  Kind       = 0;       // ENodeKind of Node
+    };
+
+    static_assert(sizeof(ModuleSection) == 24 && std::is_trivially_copyable_v<ModuleSection>);
+    static_assert(sizeof(ModuleSymbol) == 16 && std::is_trivially_copyable_v<ModuleSymbol>);
+
+    /**
+     * Streams a FlatAST to a module in one sequential pass
+     * All section sizes are known up front, so the header is written
+     * first and every section follows without seeking back.
+     *
+     * Example:
+     *   FlatAST Flat;
+     *   Flat.Append(Unit);
+     *   ModuleWriter::WriteFile(Flat, "Engine.vexm");
+     */
+    class ModuleWriter {
+    public:
+        /** Returns false if the stream failed */
+        static bool Write(const FlatASTView& Flat, std::ostream& Stream);
+        static bool WriteFile(const FlatASTView& Flat, const std::string& Path);
+
+        /** Exported declarations of every TranslationUnit root, sorted by name */
+        static std::vector<std::pair<std::string, NodeIndex>> CollectSymbols(const FlatASTView& Flat);
+    };
+
+    /**
+     * A module file opened for reading
+     *
+     * Open() maps the file read-only (POSIX) or reads it into memory
+     * (Windows) and validates the header and section bounds. The module
+     * is then a FlatASTView whose arrays live inside the mapping: printing,
+     * hashing and symbol lookup read the file in place, and ToTree()
+     * rebuilds the declarations a compilation actually uses.
+     *
+     * Example:
+     *   ModuleFile Module;
+     *   if (!Module.Open("Engine.vexm")) { std::cerr << Module.GetError(); }
+     *   const NodeIndex Vector = Module.FindSymbol("Engine::Math::Vector3");
+     *   auto* Define = static_cast<DefineDeclaration*>(Module.ToTree(Vector, Context));
+     */
+    class ModuleFile : public FlatASTView {
+    public:
+        ModuleFile() = default;
+        ~ModuleFile();
+
+        ModuleFile(const ModuleFile&) = delete;
+        ModuleFile& operator=(const ModuleFile&) = delete;
+
+        /** Maps and validates Path; on failure GetError() says why */
+        bool Open(const std::string& Path);
+
+        /** Validates a module image already in memory; Data must outlive the module */
+        bool Load(const void* Data, size_t Size);
+
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return MappedData != nullptr; }
+        [[nodiscard]] const std::string& GetError() const { return Error; }
+
+        // ---- Symbols ----
+
+        [[nodiscard]] size_t GetSymbolCount() const { return SymbolCount; }
+        [[nodiscard]] const ModuleSymbol& GetSymbol(const size_t Index) const { return Symbols[Index]; }
+        [[nodiscard]] std::string_view GetSymbolName(const ModuleSymbol& Symbol) const {
+            return { SymbolNames + Symbol.NameOffset, Symbol.NameLength };
+        }
+
+        /** Node of an exported declaration, or InvalidNode (binary search) */
+        [[nodiscard]] NodeIndex FindSymbol(std::string_view QualifiedName) const;
+
+    private:
+        const unsigned char*       MappedData = nullptr;
+        size_t                     MappedSize = 0;
+        bool                       Mapped     = false;
+        std::vector<unsigned char> Buffer;          // Backing storage when the file is read, not mapped
+
+        const ModuleSymbol* Symbols     = nullptr;
+        const char*         SymbolNames = nullptr;
+        uint32_t            SymbolCount = 0;
+
+        std::string Error;
+
+        bool Fail(std::string Message);
+        bool Validate();
+    };
+}
@@ -0,0 +1,91 @@
+#include "Statement.h"
+#include "ASTPrinter.h"
+#include "ASTVisitor.h"
+
+namespace Vex {
+    // ============================================================================
+    // VARIABLE DECLARATION
+    // ============================================================================
+
+    void VariableDeclaration::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string VariableDeclaration::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // EXPRESSION STATEMENT
+    // ============================================================================
+
+    void ExpressionStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string ExpressionStatement::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // BLOCK STATEMENT
+    // ============================================================================
+
+    void BlockStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string BlockStatement::ToString() const {
+        return PrintTree(*this);
+    }
+
+    // ============================================================================
+    // CONTROL FLOW
+    // ============================================================================
+
+    void IfStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string IfStatement::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void WhileStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string WhileStatement::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void DoWhileStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string DoWhileStatement::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void ForStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string ForStatement::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void ReturnStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string ReturnStatement::ToString() const {
+        return PrintTree(*this);
+    }
+
+    void BreakStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string BreakStatement::ToString() const {
+        return "break;";
+    }
+
+    void ContinueStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string ContinueStatement::ToString() const {
+        return "continue;";
+    }
+
+    // ============================================================================
+    // MATCH STATEMENT
+    // ============================================================================
+
+    void MatchStatement::Accept(ASTVisitor& Visitor) { Visitor.Visit(*this); }
+
+    std::string MatchStatement::ToString() const {
+        return PrintTree(*this);
+    }
+}
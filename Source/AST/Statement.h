@@ -2,8 +2,6 @@
 
 #include "ASTNode.h"
 #include "Expression.h"
-#include <vector>
-#include <memory>
 
 namespace Vex {
 
@@ -20,26 +18,30 @@ namespace Vex {
      */
     class VariableDeclaration : public Statement {
     public:
+        static constexpr ENodeKind NodeKind = ENodeKind::VariableDeclaration;
+
         bool IsConst;                               // Const vs Var/Let
         bool IsLet;                                 // Let vs Var
-        std::string Name;                           // Variable name
-        std::unique_ptr<TypeRef> Type;              // Optional type annotation
-        std::unique_ptr<Expression> Initializer;    // Optional initializer
+        std::string_view Name;                      // Variable name
+        const TypeRef* Type;                        // Optional type annotation
+        Expression* Initializer;                    // Optional initializer
+        SymbolRef Symbol;                           // Local it declares, set by name resolution
 
         VariableDeclaration(
             bool IsConst,
             bool IsLet,
-            const std::string& Name,
-            std::unique_ptr<TypeRef> Type = nullptr,
-            std::unique_ptr<Expression> Initializer = nullptr
-        ) : IsConst(IsConst),
+            std::string_view Name,
+            const TypeRef* Type = nullptr,
+            Expression* Initializer = nullptr
+        ) : Statement(NodeKind),
+            IsConst(IsConst),
             IsLet(IsLet),
             Name(Name),
-            Type(std::move(Type)),
-            Initializer(std::move(Initializer)) {}
+            Type(Type),
+            Initializer(Initializer) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -55,13 +57,15 @@ namespace Vex {
      */
     class ExpressionStatement : public Statement {
     public:
-        std::unique_ptr<Expression> Expr;
+        static constexpr ENodeKind NodeKind = ENodeKind::ExpressionStatement;
+
+        Expression* Expr;
 
-        explicit ExpressionStatement(std::unique_ptr<Expression> Expr)
-            : Expr(std::move(Expr)) {}
+        explicit ExpressionStatement(Expression* Expr)
+            : Statement(NodeKind), Expr(Expr) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -73,12 +77,14 @@ namespace Vex {
      */
     class BlockStatement : public Statement {
     public:
-        std::vector<std::unique_ptr<Statement>> Statements;
+        static constexpr ENodeKind NodeKind = ENodeKind::BlockStatement;
+
+        ArenaArray<Statement*> Statements;
 
-        BlockStatement() = default;
+        BlockStatement() : Statement(NodeKind) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -94,20 +100,23 @@ namespace Vex {
      */
     class IfStatement : public Statement {
     public:
-        std::unique_ptr<Expression> Condition;
-        std::unique_ptr<Statement> ThenBranch;
-        std::unique_ptr<Statement> ElseBranch;      // Optional
+        static constexpr ENodeKind NodeKind = ENodeKind::IfStatement;
+
+        Expression* Condition;
+        Statement* ThenBranch;
+        Statement* ElseBranch;                      // Optional
 
         IfStatement(
-            std::unique_ptr<Expression> Condition,
-            std::unique_ptr<Statement> ThenBranch,
-            std::unique_ptr<Statement> ElseBranch = nullptr
-        ) : Condition(std::move(Condition)),
-            ThenBranch(std::move(ThenBranch)),
-            ElseBranch(std::move(ElseBranch)) {}
-
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+            Expression* Condition,
+            Statement* ThenBranch,
+            Statement* ElseBranch = nullptr
+        ) : Statement(NodeKind),
+            Condition(Condition),
+            ThenBranch(ThenBranch),
+            ElseBranch(ElseBranch) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -120,16 +129,18 @@ namespace Vex {
      */
     class WhileStatement : public Statement {
     public:
-        std::unique_ptr<Expression> Condition;
-        std::unique_ptr<Statement> Body;
+        static constexpr ENodeKind NodeKind = ENodeKind::WhileStatement;
+
+        Expression* Condition;
+        Statement* Body;
 
         WhileStatement(
-            std::unique_ptr<Expression> Condition,
-            std::unique_ptr<Statement> Body
-        ) : Condition(std::move(Condition)), Body(std::move(Body)) {}
+            Expression* Condition,
+            Statement* Body
+        ) : Statement(NodeKind), Condition(Condition), Body(Body) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -142,16 +153,18 @@ namespace Vex {
      */
     class DoWhileStatement : public Statement {
     public:
-        std::unique_ptr<Statement> Body;
-        std::unique_ptr<Expression> Condition;
+        static constexpr ENodeKind NodeKind = ENodeKind::DoWhileStatement;
+
+        Statement* Body;
+        Expression* Condition;
 
         DoWhileStatement(
-            std::unique_ptr<Statement> Body,
-            std::unique_ptr<Expression> Condition
-        ) : Body(std::move(Body)), Condition(std::move(Condition)) {}
+            Statement* Body,
+            Expression* Condition
+        ) : Statement(NodeKind), Body(Body), Condition(Condition) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -166,29 +179,33 @@ namespace Vex {
      */
     class ForStatement : public Statement {
     public:
-        std::string Iterator;                       // Loop variable
-        std::unique_ptr<Expression> RangeStart;     // Start of range
-        std::unique_ptr<Expression> RangeEnd;       // End of range
+        static constexpr ENodeKind NodeKind = ENodeKind::ForStatement;
+
+        std::string_view Iterator;                  // Loop variable
+        Expression* RangeStart;                     // Start of range
+        Expression* RangeEnd;                       // End of range
         bool IsInclusive;                           // .. vs ..=
-        std::unique_ptr<Expression> Step;           // Optional step
-        std::unique_ptr<Statement> Body;
+        Expression* Step;                           // Optional step
+        Statement* Body;
+        SymbolRef Symbol;                           // Local of the iterator, set by name resolution
 
         ForStatement(
-            const std::string& Iterator,
-            std::unique_ptr<Expression> RangeStart,
-            std::unique_ptr<Expression> RangeEnd,
+            std::string_view Iterator,
+            Expression* RangeStart,
+            Expression* RangeEnd,
             bool IsInclusive,
-            std::unique_ptr<Statement> Body,
-            std::unique_ptr<Expression> Step = nullptr
-        ) : Iterator(Iterator),
-            RangeStart(std::move(RangeStart)),
-            RangeEnd(std::move(RangeEnd)),
+            Statement* Body,
+            Expression* Step = nullptr
+        ) : Statement(NodeKind),
+            Iterator(Iterator),
+            RangeStart(RangeStart),
+            RangeEnd(RangeEnd),
             IsInclusive(IsInclusive),
-            Step(std::move(Step)),
-            Body(std::move(Body)) {}
+            Step(Step),
+            Body(Body) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -204,13 +221,15 @@ namespace Vex {
      */
     class ReturnStatement : public Statement {
     public:
-        std::unique_ptr<Expression> Value;          // Optional return value
+        static constexpr ENodeKind NodeKind = ENodeKind::ReturnStatement;
+
+        Expression* Value;                          // Optional return value
 
-        explicit ReturnStatement(std::unique_ptr<Expression> Value = nullptr)
-            : Value(std::move(Value)) {}
+        explicit ReturnStatement(Expression* Value = nullptr)
+            : Statement(NodeKind), Value(Value) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -222,10 +241,12 @@ namespace Vex {
      */
     class BreakStatement : public Statement {
     public:
-        BreakStatement() = default;
+        static constexpr ENodeKind NodeKind = ENodeKind::BreakStatement;
+
+        BreakStatement() : Statement(NodeKind) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -237,10 +258,12 @@ namespace Vex {
      */
     class ContinueStatement : public Statement {
     public:
-        ContinueStatement() = default;
+        static constexpr ENodeKind NodeKind = ENodeKind::ContinueStatement;
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        ContinueStatement() : Statement(NodeKind) {}
+
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
     // ============================================================================
@@ -252,13 +275,13 @@ namespace Vex {
      * Example: WeaponType.Sword -> Damage = 50.0
      */
     struct MatchCase {
-        std::unique_ptr<Expression> Pattern;        // Pattern to match
-        std::unique_ptr<Statement> Body;            // Code to execute
+        Expression* Pattern;                        // Pattern to match
+        Statement* Body;                            // Code to execute
 
         MatchCase(
-            std::unique_ptr<Expression> Pattern,
-            std::unique_ptr<Statement> Body
-        ) : Pattern(std::move(Pattern)), Body(std::move(Body)) {}
+            Expression* Pattern,
+            Statement* Body
+        ) : Pattern(Pattern), Body(Body) {}
     };
 
     /**
@@ -272,14 +295,16 @@ namespace Vex {
      */
     class MatchStatement : public Statement {
     public:
-        std::unique_ptr<Expression> Value;          // Value to match against
-        std::vector<MatchCase> Cases;               // Match cases
+        static constexpr ENodeKind NodeKind = ENodeKind::MatchStatement;
+
+        Expression* Value;                          // Value to match against
+        ArenaArray<MatchCase> Cases;                // Match cases
 
-        explicit MatchStatement(std::unique_ptr<Expression> Value)
-            : Value(std::move(Value)) {}
+        explicit MatchStatement(Expression* Value)
+            : Statement(NodeKind), Value(Value) {}
 
-        void Accept(ASTVisitor& Visitor) override;
-        std::string ToString() const override;
+        void Accept(ASTVisitor& Visitor);
+        std::string ToString() const;
     };
 
 } // namespace Vex
\ No newline at end of file
@@ -0,0 +1,458 @@
+#pragma once
+
+#include <type_traits>
+
+#include "Declaration.h"
+#include "Expression.h"
+#include "Statement.h"
+
+namespace Vex {
+
+    /**
+     * Calls Callback(ASTNode*) for every present child of Node, in source order
+     * Absent optional children (else branch, step, initializer, ...) are skipped.
+     */
+    template<typename CallbackType>
+    void ForEachChild(ASTNode& Node, CallbackType&& Callback) {
+        const auto Visit = [&Callback](ASTNode* Child) {
+            if (Child != nullptr) {
+                Callback(Child);
+            }
+        };
+
+        switch (Node.Kind) {
+            case ENodeKind::IntegerLiteral:
+            case ENodeKind::FloatLiteral:
+            case ENodeKind::StringLiteral:
+            case ENodeKind::CharLiteral:
+            case ENodeKind::BoolLiteral:
+            case ENodeKind::NullLiteral:
+            case ENodeKind::Identifier:
+            case ENodeKind::ThisExpression:
+            case ENodeKind::SuperExpression:
+            case ENodeKind::BreakStatement:
+            case ENodeKind::ContinueStatement:
+                break;
+
+            case ENodeKind::BinaryExpression: {
+                auto& Binary = static_cast<BinaryExpression&>(Node);
+                Visit(Binary.Left);
+                Visit(Binary.Right);
+                break;
+            }
+            case ENodeKind::UnaryExpression:
+                Visit(static_cast<UnaryExpression&>(Node).Operand);
+                break;
+            case ENodeKind::FunctionCall: {
+                auto& Call = static_cast<FunctionCall&>(Node);
+                Visit(Call.Callee);
+                for (auto* Argument : Call.Arguments) {
+                    Visit(Argument);
+                }
+                break;
+            }
+            case ENodeKind::MemberAccess:
+                Visit(static_cast<MemberAccess&>(Node).Object);
+                break;
+            case ENodeKind::IndexAccess: {
+                auto& Access = static_cast<IndexAccess&>(Node);
+                Visit(Access.Object);
+                Visit(Access.Index);
+                break;
+            }
+            case ENodeKind::TernaryExpression: {
+                auto& Ternary = static_cast<TernaryExpression&>(Node);
+                Visit(Ternary.Condition);
+                Visit(Ternary.TrueExpr);
+                Visit(Ternary.FalseExpr);
+                break;
+            }
+            case ENodeKind::CastExpression:
+                Visit(static_cast<CastExpression&>(Node).Expr);
+                break;
+            case ENodeKind::NewExpression:
+                for (auto* Argument : static_cast<NewExpression&>(Node).Arguments) {
+                    Visit(Argument);
+                }
+                break;
+            case ENodeKind::GroupingExpression:
+                Visit(static_cast<GroupingExpression&>(Node).Expr);
+                break;
+
+            case ENodeKind::VariableDeclaration:
+                Visit(static_cast<VariableDeclaration&>(Node).Initializer);
+                break;
+            case ENodeKind::ExpressionStatement:
+                Visit(static_cast<ExpressionStatement&>(Node).Expr);
+                break;
+            case ENodeKind::BlockStatement:
+                for (auto* Stmt : static_cast<BlockStatement&>(Node).Statements) {
+                    Visit(Stmt);
+                }
+                break;
+            case ENodeKind::IfStatement: {
+                auto& If = static_cast<IfStatement&>(Node);
+                Visit(If.Condition);
+                Visit(If.ThenBranch);
+                Visit(If.ElseBranch);
+                break;
+            }
+            case ENodeKind::WhileStatement: {
+                auto& While = static_cast<WhileStatement&>(Node);
+                Visit(While.Condition);
+                Visit(While.Body);
+                break;
+            }
+            case ENodeKind::DoWhileStatement: {
+                auto& DoWhile = static_cast<DoWhileStatement&>(Node);
+                Visit(DoWhile.Body);
+                Visit(DoWhile.Condition);
+                break;
+            }
+            case ENodeKind::ForStatement: {
+                auto& For = static_cast<ForStatement&>(Node);
+                Visit(For.RangeStart);
+                Visit(For.RangeEnd);
+                Visit(For.Step);
+                Visit(For.Body);
+                break;
+            }
+            case ENodeKind::ReturnStatement:
+                Visit(static_cast<ReturnStatement&>(Node).Value);
+                break;
+            case ENodeKind::MatchStatement: {
+                auto& Match = static_cast<MatchStatement&>(Node);
+                Visit(Match.Value);
+                for (const auto& Case : Match.Cases) {
+                    Visit(Case.Pattern);
+                    Visit(Case.Body);
+                }
+                break;
+            }
+
+            case ENodeKind::FieldDeclaration:
+                Visit(static_cast<FieldDeclaration&>(Node).Initializer);
+                break;
+            case ENodeKind::FunctionDeclaration: {
+                auto& Function = static_cast<FunctionDeclaration&>(Node);
+                for (const auto& Param : Function.Parameters) {
+                    Visit(Param.DefaultValue);
+                }
+                Visit(Function.Body);
+                break;
+            }
+            case ENodeKind::DefineDeclaration: {
+                auto& Define = static_cast<DefineDeclaration&>(Node);
+                for (auto* Field : Define.Fields) {
+                    Visit(Field);
+                }
+                for (auto* Method : Define.Methods) {
+                    Visit(Method);
+                }
+                break;
+            }
+            case ENodeKind::FetchDeclaration:
+                for (auto* Method : static_cast<FetchDeclaration&>(Node).Methods) {
+                    Visit(Method);
+                }
+                break;
+            case ENodeKind::SetDeclaration:
+                for (auto* Method : static_cast<SetDeclaration&>(Node).Methods) {
+                    Visit(Method);
+                }
+                break;
+            case ENodeKind::InterfaceDeclaration:
+                for (auto* Method : static_cast<InterfaceDeclaration&>(Node).Methods) {
+                    Visit(Method);
+                }
+                break;
+            case ENodeKind::NamespaceDeclaration:
+                for (auto* Decl : static_cast<NamespaceDeclaration&>(Node).Declarations) {
+                    Visit(Decl);
+                }
+                break;
+            case ENodeKind::UsingDeclaration:
+                break;
+            case ENodeKind::GlobalDeclaration:
+                Visit(static_cast<GlobalDeclaration&>(Node).Variable);
+                break;
+            case ENodeKind::TranslationUnit:
+                for (auto* Decl : static_cast<TranslationUnit&>(Node).Declarations) {
+                    Visit(Decl);
+                }
+                break;
+        }
+    }
+
+    /**
+     * Tag-dispatched visitor base (CRTP)
+     *
+     * Visit() switches on ASTNode::Kind and calls Derived::Visit<NodeType>()
+     * directly, so the compiler can inline the handlers. Derived classes
+     * hide only the handlers they need.
+     *
+     * An unhandled node first goes to VisitExpression / VisitStatement /
+     * VisitDeclaration (and from there to VisitNode); a void visitor then
+     * continues into the node's children, so a pass that handles a few
+     * node types still reaches the whole tree. A handler that is hidden replaces the walk:
+     * call VisitChildren(Node) to keep descending. Visitors returning a
+     * value do not walk and get ReturnType{} for unhandled nodes.
+     *
+     * Visiting recurses once per tree level; use WalkTree (TreeWalker.h)
+     * for passes that must survive arbitrarily deep trees.
+     *
+     * Example:
+     *   class IdentifierCounter : public StaticVisitor<IdentifierCounter> {
+     *   public:
+     *       size_t Count = 0;
+     *       void VisitIdentifier(Identifier& Node) { ++Count; }
+     *   };
+     *
+     *   IdentifierCounter Counter;
+     *   Counter.Visit(Root);
+     */
+    template<typename Derived, typename ReturnType = void>
+    class StaticVisitor {
+    public:
+        ReturnType Visit(ASTNode* Node) {
+            switch (Node->Kind) {
+                case ENodeKind::IntegerLiteral:         return Self().VisitIntegerLiteral(static_cast<IntegerLiteral&>(*Node));
+                case ENodeKind::FloatLiteral:           return Self().VisitFloatLiteral(static_cast<FloatLiteral&>(*Node));
+                case ENodeKind::StringLiteral:          return Self().VisitStringLiteral(static_cast<StringLiteral&>(*Node));
+                case ENodeKind::CharLiteral:            return Self().VisitCharLiteral(static_cast<CharLiteral&>(*Node));
+                case ENodeKind::BoolLiteral:            return Self().VisitBoolLiteral(static_cast<BoolLiteral&>(*Node));
+                case ENodeKind::NullLiteral:            return Self().VisitNullLiteral(static_cast<NullLiteral&>(*Node));
+                case ENodeKind::Identifier:             return Self().VisitIdentifier(static_cast<Identifier&>(*Node));
+                case ENodeKind::BinaryExpression:       return Self().VisitBinaryExpression(static_cast<BinaryExpression&>(*Node));
+                case ENodeKind::UnaryExpression:        return Self().VisitUnaryExpression(static_cast<UnaryExpression&>(*Node));
+                case ENodeKind::FunctionCall:           return Self().VisitFunctionCall(static_cast<FunctionCall&>(*Node));
+                case ENodeKind::MemberAccess:           return Self().VisitMemberAccess(static_cast<MemberAccess&>(*Node));
+                case ENodeKind::IndexAccess:            return Self().VisitIndexAccess(static_cast<IndexAccess&>(*Node));
+                case ENodeKind::TernaryExpression:      return Self().VisitTernaryExpression(static_cast<TernaryExpression&>(*Node));
+                case ENodeKind::CastExpression:         return Self().VisitCastExpression(static_cast<CastExpression&>(*Node));
+                case ENodeKind::NewExpression:          return Self().VisitNewExpression(static_cast<NewExpression&>(*Node));
+                case ENodeKind::ThisExpression:         return Self().VisitThisExpression(static_cast<ThisExpression&>(*Node));
+                case ENodeKind::SuperExpression:        return Self().VisitSuperExpression(static_cast<SuperExpression&>(*Node));
+                case ENodeKind::GroupingExpression:     return Self().VisitGroupingExpression(static_cast<GroupingExpression&>(*Node));
+
+                case ENodeKind::VariableDeclaration:    return Self().VisitVariableDeclaration(static_cast<VariableDeclaration&>(*Node));
+                case ENodeKind::ExpressionStatement:    return Self().VisitExpressionStatement(static_cast<ExpressionStatement&>(*Node));
+                case ENodeKind::BlockStatement:         return Self().VisitBlockStatement(static_cast<BlockStatement&>(*Node));
+                case ENodeKind::IfStatement:            return Self().VisitIfStatement(static_cast<IfStatement&>(*Node));
+                case ENodeKind::WhileStatement:         return Self().VisitWhileStatement(static_cast<WhileStatement&>(*Node));
+                case ENodeKind::DoWhileStatement:       return Self().VisitDoWhileStatement(static_cast<DoWhileStatement&>(*Node));
+                case ENodeKind::ForStatement:           return Self().VisitForStatement(static_cast<ForStatement&>(*Node));
+                case ENodeKind::ReturnStatement:        return Self().VisitReturnStatement(static_cast<ReturnStatement&>(*Node));
+                case ENodeKind::BreakStatement:         return Self().VisitBreakStatement(static_cast<BreakStatement&>(*Node));
+                case ENodeKind::ContinueStatement:      return Self().VisitContinueStatement(static_cast<ContinueStatement&>(*Node));
+                case ENodeKind::MatchStatement:         return Self().VisitMatchStatement(static_cast<MatchStatement&>(*Node));
+
+                case ENodeKind::FieldDeclaration:       return Self().VisitFieldDeclaration(static_cast<FieldDeclaration&>(*Node));
+                case ENodeKind::FunctionDeclaration:    return Self().VisitFunctionDeclaration(static_cast<FunctionDeclaration&>(*Node));
+                case ENodeKind::DefineDeclaration:      return Self().VisitDefineDeclaration(static_cast<DefineDeclaration&>(*Node));
+                case ENodeKind::FetchDeclaration:       return Self().VisitFetchDeclaration(static_cast<FetchDeclaration&>(*Node));
+                case ENodeKind::SetDeclaration:         return Self().VisitSetDeclaration(static_cast<SetDeclaration&>(*Node));
+                case ENodeKind::InterfaceDeclaration:   return Self().VisitInterfaceDeclaration(static_cast<InterfaceDeclaration&>(*Node));
+                case ENodeKind::NamespaceDeclaration:   return Self().VisitNamespaceDeclaration(static_cast<NamespaceDeclaration&>(*Node));
+                case ENodeKind::UsingDeclaration:       return Self().VisitUsingDeclaration(static_cast<UsingDeclaration&>(*Node));
+                case ENodeKind::GlobalDeclaration:      return Self().VisitGlobalDeclaration(static_cast<GlobalDeclaration&>(*Node));
+
+                case ENodeKind::TranslationUnit:        return Self().VisitTranslationUnit(static_cast<TranslationUnit&>(*Node));
+            }
+
+            return ReturnType();
+        }
+
+        /** Visits every present child of Node, in source order */
+        void VisitChildren(ASTNode& Node) {
+            ForEachChild(Node, [this](ASTNode* Child) { Visit(Child); });
+        }
+
+        // Typed overloads used by the default handlers; no second switch on Kind
+        void VisitChildren(IntegerLiteral&) {}
+        void VisitChildren(FloatLiteral&) {}
+        void VisitChildren(StringLiteral&) {}
+        void VisitChildren(CharLiteral&) {}
+        void VisitChildren(BoolLiteral&) {}
+        void VisitChildren(NullLiteral&) {}
+        void VisitChildren(Identifier&) {}
+        void VisitChildren(BinaryExpression& Node) {
+            Visit(Node.Left);
+            Visit(Node.Right);
+        }
+        void VisitChildren(UnaryExpression& Node) { Visit(Node.Operand); }
+        void VisitChildren(FunctionCall& Node) {
+            Visit(Node.Callee);
+            for (auto* Argument : Node.Arguments) { Visit(Argument); }
+        }
+        void VisitChildren(MemberAccess& Node) { Visit(Node.Object); }
+        void VisitChildren(IndexAccess& Node) {
+            Visit(Node.Object);
+            Visit(Node.Index);
+        }
+        void VisitChildren(TernaryExpression& Node) {
+            Visit(Node.Condition);
+            Visit(Node.TrueExpr);
+            Visit(Node.FalseExpr);
+        }
+        void VisitChildren(CastExpression& Node) { Visit(Node.Expr); }
+        void VisitChildren(NewExpression& Node) { for (auto* Argument : Node.Arguments) { Visit(Argument); } }
+        void VisitChildren(ThisExpression&) {}
+        void VisitChildren(SuperExpression&) {}
+        void VisitChildren(GroupingExpression& Node) { Visit(Node.Expr); }
+        void VisitChildren(VariableDeclaration& Node) { VisitOptional(Node.Initializer); }
+        void VisitChildren(ExpressionStatement& Node) { Visit(Node.Expr); }
+        void VisitChildren(BlockStatement& Node) { for (auto* Stmt : Node.Statements) { Visit(Stmt); } }
+        void VisitChildren(IfStatement& Node) {
+            Visit(Node.Condition);
+            Visit(Node.ThenBranch);
+            VisitOptional(Node.ElseBranch);
+        }
+        void VisitChildren(WhileStatement& Node) {
+            Visit(Node.Condition);
+            Visit(Node.Body);
+        }
+        void VisitChildren(DoWhileStatement& Node) {
+            Visit(Node.Body);
+            Visit(Node.Condition);
+        }
+        void VisitChildren(ForStatement& Node) {
+            Visit(Node.RangeStart);
+            Visit(Node.RangeEnd);
+            VisitOptional(Node.Step);
+            Visit(Node.Body);
+        }
+        void VisitChildren(ReturnStatement& Node) { VisitOptional(Node.Value); }
+        void VisitChildren(BreakStatement&) {}
+        void VisitChildren(ContinueStatement&) {}
+        void VisitChildren(MatchStatement& Node) {
+            Visit(Node.Value);
+            for (const auto& Case : Node.Cases) { Visit(Case.Pattern); Visit(Case.Body); }
+        }
+        void VisitChildren(FieldDeclaration& Node) { VisitOptional(Node.Initializer); }
+        void VisitChildren(FunctionDeclaration& Node) {
+            for (const auto& Param : Node.Parameters) { VisitOptional(Param.DefaultValue); }
+            VisitOptional(Node.Body);
+        }
+        void VisitChildren(DefineDeclaration& Node) {
+            for (auto* Field : Node.Fields) { Visit(Field); }
+            for (auto* Method : Node.Methods) { Visit(Method); }
+        }
+        void VisitChildren(FetchDeclaration& Node) { for (auto* Method : Node.Methods) { Visit(Method); } }
+        void VisitChildren(SetDeclaration& Node) { for (auto* Method : Node.Methods) { Visit(Method); } }
+        void VisitChildren(InterfaceDeclaration& Node) { for (auto* Method : Node.Methods) { Visit(Method); } }
+        void VisitChildren(NamespaceDeclaration& Node) { for (auto* Decl : Node.Declarations) { Visit(Decl); } }
+        void VisitChildren(UsingDeclaration&) {}
+        void VisitChildren(GlobalDeclaration& Node) { Visit(Node.Variable); }
+        void VisitChildren(TranslationUnit& Node) { for (auto* Decl : Node.Declarations) { Visit(Decl); } }
+
+        // Category fallbacks, called before the children are visited
+        ReturnType VisitNode(ASTNode&) { return ReturnType(); }
+        ReturnType VisitExpression(Expression& Node) { return Self().VisitNode(Node); }
+        ReturnType VisitStatement(Statement& Node) { return Self().VisitNode(Node); }
+        ReturnType VisitDeclaration(Declaration& Node) { return Self().VisitNode(Node); }
+
+        // Per-kind handlers; Derived hides the ones it handles
+        // Expressions
+        ReturnType VisitIntegerLiteral(IntegerLiteral& Node) { return FallbackExpression(Node); }
+        ReturnType VisitFloatLiteral(FloatLiteral& Node) { return FallbackExpression(Node); }
+        ReturnType VisitStringLiteral(StringLiteral& Node) { return FallbackExpression(Node); }
+        ReturnType VisitCharLiteral(CharLiteral& Node) { return FallbackExpression(Node); }
+        ReturnType VisitBoolLiteral(BoolLiteral& Node) { return FallbackExpression(Node); }
+        ReturnType VisitNullLiteral(NullLiteral& Node) { return FallbackExpression(Node); }
+        ReturnType VisitIdentifier(Identifier& Node) { return FallbackExpression(Node); }
+        ReturnType VisitBinaryExpression(BinaryExpression& Node) { return FallbackExpression(Node); }
+        ReturnType VisitUnaryExpression(UnaryExpression& Node) { return FallbackExpression(Node); }
+        ReturnType VisitFunctionCall(FunctionCall& Node) { return FallbackExpression(Node); }
+        ReturnType VisitMemberAccess(MemberAccess& Node) { return FallbackExpression(Node); }
+        ReturnType VisitIndexAccess(IndexAccess& Node) { return FallbackExpression(Node); }
+        ReturnType VisitTernaryExpression(TernaryExpression& Node) { return FallbackExpression(Node); }
+        ReturnType VisitCastExpression(CastExpression& Node) { return FallbackExpression(Node); }
+        ReturnType VisitNewExpression(NewExpression& Node) { return FallbackExpression(Node); }
+        ReturnType VisitThisExpression(ThisExpression& Node) { return FallbackExpression(Node); }
+        ReturnType VisitSuperExpression(SuperExpression& Node) { return FallbackExpression(Node); }
+        ReturnType VisitGroupingExpression(GroupingExpression& Node) { return FallbackExpression(Node); }
+
+        // Statements
+        ReturnType VisitVariableDeclaration(VariableDeclaration& Node) { return FallbackStatement(Node); }
+        ReturnType VisitExpressionStatement(ExpressionStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitBlockStatement(BlockStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitIfStatement(IfStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitWhileStatement(WhileStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitDoWhileStatement(DoWhileStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitForStatement(ForStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitReturnStatement(ReturnStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitBreakStatement(BreakStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitContinueStatement(ContinueStatement& Node) { return FallbackStatement(Node); }
+        ReturnType VisitMatchStatement(MatchStatement& Node) { return FallbackStatement(Node); }
+
+        // Declarations
+        ReturnType VisitFieldDeclaration(FieldDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitFunctionDeclaration(FunctionDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitDefineDeclaration(DefineDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitFetchDeclaration(FetchDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitSetDeclaration(SetDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitInterfaceDeclaration(InterfaceDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitNamespaceDeclaration(NamespaceDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitUsingDeclaration(UsingDeclaration& Node) { return FallbackDeclaration(Node); }
+        ReturnType VisitGlobalDeclaration(GlobalDeclaration& Node) { return FallbackDeclaration(Node); }
+
+        ReturnType VisitTranslationUnit(TranslationUnit& Node) { return FallbackNode(Node); }
+
+    protected:
+        StaticVisitor() = default;
+
+    private:
+        Derived& Self() { return static_cast<Derived&>(*this); }
+
+        void VisitOptional(ASTNode* Node) {
+            if (Node != nullptr) {
+                Visit(Node);
+            }
+        }
+
+        /**
+         * Default handlers: run the category fallback, then (for void
+         * visitors) continue into the children of the concrete node
+         */
+        template<typename NodeType>
+        ReturnType FallbackExpression(NodeType& Node) {
+            if constexpr (std::is_void_v<ReturnType>) {
+                Self().VisitExpression(Node);
+                Self().VisitChildren(Node);
+            } else {
+                return Self().VisitExpression(Node);
+            }
+        }
+
+        template<typename NodeType>
+        ReturnType FallbackStatement(NodeType& Node) {
+            if constexpr (std::is_void_v<ReturnType>) {
+                Self().VisitStatement(Node);
+                Self().VisitChildren(Node);
+            } else {
+                return Self().VisitStatement(Node);
+            }
+        }
+
+        template<typename NodeType>
+        ReturnType FallbackDeclaration(NodeType& Node) {
+            if constexpr (std::is_void_v<ReturnType>) {
+                Self().VisitDeclaration(Node);
+                Self().VisitChildren(Node);
+            } else {
+                return Self().VisitDeclaration(Node);
+            }
+        }
+
+        template<typename NodeType>
+        ReturnType FallbackNode(NodeType& Node) {
+            if constexpr (std::is_void_v<ReturnType>) {
+                Self().VisitNode(Node);
+                Self().VisitChildren(Node);
+            } else {
+                return Self().VisitNode(Node);
+            }
+        }
+    };
+}
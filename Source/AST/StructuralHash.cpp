@@ -0,0 +1,509 @@
+#include "StructuralHash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "Declaration.h"
+#include "FlatAST.h"
+#include "Hashing.h"
+#include "Statement.h"
+#include "TreeWalker.h"
+
+namespace Vex {
+    namespace {
+        /**
+         * Child layout of Node, nullptr for absent optional children
+         * Same slots as FlatAST (see FlatNode), so both hash alike.
+         */
+        void CollectSlots(const ASTNode& Node, std::vector<const ASTNode*>& Slots) {
+            Slots.clear();
+
+            switch (Node.Kind) {
+                case ENodeKind::BinaryExpression: {
+                    const auto& Binary = static_cast<const BinaryExpression&>(Node);
+                    Slots.assign({ Binary.Left, Binary.Right });
+                    break;
+                }
+                case ENodeKind::UnaryExpression:
+                    Slots.push_back(static_cast<const UnaryExpression&>(Node).Operand);
+                    break;
+                case ENodeKind::FunctionCall: {
+                    const auto& Call = static_cast<const FunctionCall&>(Node);
+                    Slots.push_back(Call.Callee);
+                    Slots.insert(Slots.end(), Call.Arguments.begin(), Call.Arguments.end());
+                    break;
+                }
+                case ENodeKind::MemberAccess:
+                    Slots.push_back(static_cast<const MemberAccess&>(Node).Object);
+                    break;
+                case ENodeKind::IndexAccess: {
+                    const auto& Access = static_cast<const IndexAccess&>(Node);
+                    Slots.assign({ Access.Object, Access.Index });
+                    break;
+                }
+                case ENodeKind::TernaryExpression: {
+                    const auto& Ternary = static_cast<const TernaryExpression&>(Node);
+                    Slots.assign({ Ternary.Condition, Ternary.TrueExpr, Ternary.FalseExpr });
+                    break;
+                }
+                case ENodeKind::CastExpression:
+                    Slots.push_back(static_cast<const CastExpression&>(Node).Expr);
+                    break;
+                case ENodeKind::NewExpression: {
+                    const auto& New = static_cast<const NewExpression&>(Node);
+                    Slots.insert(Slots.end(), New.Arguments.begin(), New.Arguments.end());
+                    break;
+                }
+                case ENodeKind::GroupingExpression:
+                    Slots.push_back(static_cast<const GroupingExpression&>(Node).Expr);
+                    break;
+
+                case ENodeKind::VariableDeclaration:
+                    Slots.push_back(static_cast<const VariableDeclaration&>(Node).Initializer);
+                    break;
+                case ENodeKind::ExpressionStatement:
+                    Slots.push_back(static_cast<const ExpressionStatement&>(Node).Expr);
+                    break;
+                case ENodeKind::BlockStatement: {
+                    const auto& Block = static_cast<const BlockStatement&>(Node);
+                    Slots.insert(Slots.end(), Block.Statements.begin(), Block.Statements.end());
+                    break;
+                }
+                case ENodeKind::IfStatement: {
+                    const auto& If = static_cast<const IfStatement&>(Node);
+                    Slots.assign({ If.Condition, If.ThenBranch, If.ElseBranch });
+                    break;
+                }
+                case ENodeKind::WhileStatement: {
+                    const auto& While = static_cast<const WhileStatement&>(Node);
+                    Slots.assign({ While.Condition, While.Body });
+                    break;
+                }
+                case ENodeKind::DoWhileStatement: {
+                    const auto& DoWhile = static_cast<const DoWhileStatement&>(Node);
+                    Slots.assign({ DoWhile.Body, DoWhile.Condition });
+                    break;
+                }
+                case ENodeKind::ForStatement: {
+                    const auto& For = static_cast<const ForStatement&>(Node);
+                    Slots.assign({ For.RangeStart, For.RangeEnd, For.Step, For.Body });
+                    break;
+                }
+                case ENodeKind::ReturnStatement:
+                    Slots.push_back(static_cast<const ReturnStatement&>(Node).Value);
+                    break;
+                case ENodeKind::MatchStatement: {
+                    const auto& Match = static_cast<const MatchStatement&>(Node);
+                    Slots.push_back(Match.Value);
+                    for (const auto& Case : Match.Cases) {
+                        Slots.push_back(Case.Pattern);
+                        Slots.push_back(Case.Body);
+                    }
+                    break;
+                }
+
+                case ENodeKind::FieldDeclaration:
+                    Slots.push_back(static_cast<const FieldDeclaration&>(Node).Initializer);
+                    break;
+                case ENodeKind::FunctionDeclaration: {
+                    const auto& Function = static_cast<const FunctionDeclaration&>(Node);
+                    for (const auto& Param : Function.Parameters) {
+                        Slots.push_back(Param.DefaultValue);
+                    }
+                    Slots.push_back(Function.Body);
+                    break;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    const auto& Define = static_cast<const DefineDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Define.Fields.begin(), Define.Fields.end());
+                    Slots.insert(Slots.end(), Define.Methods.begin(), Define.Methods.end());
+                    break;
+                }
+                case ENodeKind::FetchDeclaration: {
+                    const auto& Fetch = static_cast<const FetchDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Fetch.Methods.begin(), Fetch.Methods.end());
+                    break;
+                }
+                case ENodeKind::SetDeclaration: {
+                    const auto& Set = static_cast<const SetDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Set.Methods.begin(), Set.Methods.end());
+                    break;
+                }
+                case ENodeKind::InterfaceDeclaration: {
+                    const auto& Interface = static_cast<const InterfaceDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Interface.Methods.begin(), Interface.Methods.end());
+                    break;
+                }
+                case ENodeKind::NamespaceDeclaration: {
+                    const auto& Namespace = static_cast<const NamespaceDeclaration&>(Node);
+                    Slots.insert(Slots.end(), Namespace.Declarations.begin(), Namespace.Declarations.end());
+                    break;
+                }
+                case ENodeKind::GlobalDeclaration:
+                    Slots.push_back(static_cast<const GlobalDeclaration&>(Node).Variable);
+                    break;
+                case ENodeKind::TranslationUnit: {
+                    const auto& Unit = static_cast<const TranslationUnit&>(Node);
+                    Slots.insert(Slots.end(), Unit.Declarations.begin(), Unit.Declarations.end());
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        /** FlatNode::Flags of Node */
+        uint8_t GetFlags(const ASTNode& Node) {
+            switch (Node.Kind) {
+                case ENodeKind::BinaryExpression:
+                    return static_cast<uint8_t>(static_cast<const BinaryExpression&>(Node).Op);
+                case ENodeKind::UnaryExpression:
+                    return static_cast<uint8_t>(static_cast<const UnaryExpression&>(Node).Op);
+                case ENodeKind::BoolLiteral:
+                    return static_cast<const BoolLiteral&>(Node).Value ? 1 : 0;
+                case ENodeKind::MemberAccess:
+                    return static_cast<const MemberAccess&>(Node).IsOptional ? 1 : 0;
+                case ENodeKind::VariableDeclaration: {
+                    const auto& Var = static_cast<const VariableDeclaration&>(Node);
+                    return (Var.IsConst ? 1 : 0) | (Var.IsLet ? 2 : 0);
+                }
+                case ENodeKind::ForStatement:
+                    return static_cast<const ForStatement&>(Node).IsInclusive ? 1 : 0;
+                case ENodeKind::FieldDeclaration: {
+                    const auto& Field = static_cast<const FieldDeclaration&>(Node);
+                    return (Field.IsStatic ? 1 : 0) | (Field.IsConst ? 2 : 0);
+                }
+                case ENodeKind::FunctionDeclaration: {
+                    const auto& Function = static_cast<const FunctionDeclaration&>(Node);
+                    return (Function.IsStatic ? FunctionStatic : 0) |
+                           (Function.IsVirtual ? FunctionVirtual : 0) |
+                           (Function.IsOverride ? FunctionOverride : 0) |
+                           (Function.IsImplement ? FunctionImplement : 0) |
+                           (Function.IsOperator ? FunctionOperator : 0);
+                }
+                default:
+                    return 0;
+            }
+        }
+
+        template<typename T>
+        uint64_t GetBits(const T Value) {
+            static_assert(sizeof(T) == sizeof(uint64_t));
+            uint64_t Bits;
+            std::memcpy(&Bits, &Value, sizeof(Bits));
+            return Bits;
+        }
+
+        uint32_t GetTypeFlags(const TypeRef& Type) {
+            return (Type.IsPointer ? 1 : 0) | (Type.IsUnique ? 2 : 0) | (Type.IsShared ? 4 : 0) | (Type.IsBorrow ? 8 : 0) |
+                   (Type.IsArray ? 16 : 0);
+        }
+
+        /** Content hash of a type; 0 for an absent one */
+        uint64_t HashType(const TypeRef* Type) {
+            if (Type == nullptr) {
+                return 0;
+            }
+
+            uint64_t Hash = HashCombine(HashBytes(Type->Name), GetTypeFlags(*Type));
+            for (const auto& Member : Type->MemberPath) {
+                Hash = HashCombine(Hash, HashBytes(Member));
+            }
+            Hash = HashCombine(Hash, Type->AllowedFields.size());
+            for (const auto& Field : Type->AllowedFields) {
+                Hash = HashCombine(Hash, HashBytes(Field));
+            }
+            return Hash;
+        }
+
+        uint64_t HashTypes(uint64_t Hash, const ArenaArray<const TypeRef*>& TypeList) {
+            Hash = HashCombine(Hash, TypeList.size());
+            for (const auto* Type : TypeList) {
+                Hash = HashCombine(Hash, HashType(Type));
+            }
+            return Hash;
+        }
+
+        /** Hash of everything but the children (mirrors FlatASTView::ComputeHashes) */
+        uint64_t HashLocal(const ASTNode& Node) {
+            uint64_t Hash = HashCombine(static_cast<uint64_t>(Node.Kind), GetFlags(Node));
+
+            switch (Node.Kind) {
+                case ENodeKind::IntegerLiteral:
+                    return HashCombine(Hash, GetBits(static_cast<const IntegerLiteral&>(Node).Value));
+                case ENodeKind::FloatLiteral:
+                    return HashCombine(Hash, GetBits(static_cast<const FloatLiteral&>(Node).Value));
+                case ENodeKind::CharLiteral:
+                    return HashCombine(Hash, static_cast<uint8_t>(static_cast<const CharLiteral&>(Node).Value));
+                case ENodeKind::StringLiteral:
+                    return HashCombine(Hash, HashBytes(static_cast<const StringLiteral&>(Node).Value));
+                case ENodeKind::Identifier:
+                    return HashCombine(Hash, HashBytes(static_cast<const Identifier&>(Node).Name));
+                case ENodeKind::MemberAccess:
+                    return HashCombine(Hash, HashBytes(static_cast<const MemberAccess&>(Node).Member));
+                case ENodeKind::ForStatement:
+                    return HashCombine(Hash, HashBytes(static_cast<const ForStatement&>(Node).Iterator));
+                case ENodeKind::CastExpression:
+                    return HashCombine(Hash, HashType(static_cast<const CastExpression&>(Node).Type));
+                case ENodeKind::NewExpression:
+                    return HashCombine(Hash, HashType(static_cast<const NewExpression&>(Node).Type));
+                case ENodeKind::VariableDeclaration: {
+                    const auto& Var = static_cast<const VariableDeclaration&>(Node);
+                    Hash = HashCombine(Hash, HashBytes(Var.Name));
+                    return HashCombine(Hash, HashType(Var.Type));
+                }
+                case ENodeKind::FieldDeclaration: {
+                    const auto& Field = static_cast<const FieldDeclaration&>(Node);
+                    Hash = HashCombine(Hash, static_cast<uint64_t>(Field.Access));
+                    Hash = HashCombine(Hash, HashBytes(Field.Name));
+                    return HashCombine(Hash, HashType(Field.Type));
+                }
+                case ENodeKind::FunctionDeclaration: {
+                    const auto& Function = static_cast<const FunctionDeclaration&>(Node);
+                    Hash = HashCombine(Hash, static_cast<uint64_t>(Function.Access));
+                    Hash = HashCombine(Hash, HashBytes(Function.Name));
+                    Hash = HashCombine(Hash, HashType(Function.ReturnType));
+                    Hash = HashCombine(Hash, Function.Parameters.size());
+                    for (const auto& Param : Function.Parameters) {
+                        Hash = HashCombine(Hash, HashBytes(Param.Name));
+                        Hash = HashCombine(Hash, HashType(Param.Type));
+                    }
+                    return Hash;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    const auto& Define = static_cast<const DefineDeclaration&>(Node);
+                    Hash = HashCombine(Hash, HashBytes(Define.Name));
+                    Hash = HashCombine(Hash, Define.Fields.size());
+                    Hash = HashTypes(Hash, Define.BaseTypes);
+                    Hash = HashCombine(Hash, Define.Attributes.size());
+                    for (const auto& Attribute : Define.Attributes) {
+                        Hash = HashCombine(Hash, HashBytes(Attribute));
+                    }
+                    return Hash;
+                }
+                case ENodeKind::InterfaceDeclaration: {
+                    const auto& Interface = static_cast<const InterfaceDeclaration&>(Node);
+                    Hash = HashCombine(Hash, HashBytes(Interface.Name));
+                    return HashTypes(Hash, Interface.BaseInterfaces);
+                }
+                case ENodeKind::FetchDeclaration:
+                    return HashCombine(Hash, HashBytes(static_cast<const FetchDeclaration&>(Node).Target));
+                case ENodeKind::SetDeclaration:
+                    return HashCombine(Hash, HashBytes(static_cast<const SetDeclaration&>(Node).Target));
+                case ENodeKind::NamespaceDeclaration:
+                    return HashCombine(Hash, HashBytes(static_cast<const NamespaceDeclaration&>(Node).Name));
+                case ENodeKind::UsingDeclaration:
+                    return HashCombine(Hash, HashBytes(static_cast<const UsingDeclaration&>(Node).Path));
+                case ENodeKind::TranslationUnit:
+                    return HashCombine(Hash, HashBytes(static_cast<const TranslationUnit&>(Node).SourceName));
+                default:
+                    return Hash;
+            }
+        }
+
+        /** Types are canonical per context; across contexts compare their contents */
+        bool SameType(const TypeRef* Left, const TypeRef* Right) {
+            if (Left == Right) {
+                return true;
+            }
+            if (Left == nullptr || Right == nullptr) {
+                return false;
+            }
+
+            return Left->Name == Right->Name && GetTypeFlags(*Left) == GetTypeFlags(*Right) &&
+                   Left->MemberPath.size() == Right->MemberPath.size() &&
+                   std::equal(Left->MemberPath.begin(), Left->MemberPath.end(), Right->MemberPath.begin()) &&
+                   Left->AllowedFields.size() == Right->AllowedFields.size() &&
+                   std::equal(Left->AllowedFields.begin(), Left->AllowedFields.end(), Right->AllowedFields.begin());
+        }
+
+        bool SameTypes(const ArenaArray<const TypeRef*>& Left, const ArenaArray<const TypeRef*>& Right) {
+            return Left.size() == Right.size() && std::equal(Left.begin(), Left.end(), Right.begin(), SameType);
+        }
+
+        /** Everything HashLocal() covers, compared exactly (nodes are of the same kind) */
+        bool EqualLocal(const ASTNode& Left, const ASTNode& Right) {
+            if (GetFlags(Left) != GetFlags(Right)) {
+                return false;
+            }
+
+            switch (Left.Kind) {
+                case ENodeKind::IntegerLiteral:
+                    return static_cast<const IntegerLiteral&>(Left).Value == static_cast<const IntegerLiteral&>(Right).Value;
+                case ENodeKind::FloatLiteral:
+                    // Bitwise, like the hash: NaN equals itself and 0.0 differs from -0.0
+                    return GetBits(static_cast<const FloatLiteral&>(Left).Value) ==
+                           GetBits(static_cast<const FloatLiteral&>(Right).Value);
+                case ENodeKind::CharLiteral:
+                    return static_cast<const CharLiteral&>(Left).Value == static_cast<const CharLiteral&>(Right).Value;
+                case ENodeKind::StringLiteral:
+                    return static_cast<const StringLiteral&>(Left).Value == static_cast<const StringLiteral&>(Right).Value;
+                case ENodeKind::Identifier:
+                    return static_cast<const Identifier&>(Left).Name == static_cast<const Identifier&>(Right).Name;
+                case ENodeKind::MemberAccess:
+                    return static_cast<const MemberAccess&>(Left).Member == static_cast<const MemberAccess&>(Right).Member;
+                case ENodeKind::ForStatement:
+                    return static_cast<const ForStatement&>(Left).Iterator == static_cast<const ForStatement&>(Right).Iterator;
+                case ENodeKind::CastExpression:
+                    return SameType(static_cast<const CastExpression&>(Left).Type, static_cast<const CastExpression&>(Right).Type);
+                case ENodeKind::NewExpression:
+                    return SameType(static_cast<const NewExpression&>(Left).Type, static_cast<const NewExpression&>(Right).Type);
+                case ENodeKind::VariableDeclaration: {
+                    const auto& A = static_cast<const VariableDeclaration&>(Left);
+                    const auto& B = static_cast<const VariableDeclaration&>(Right);
+                    return A.Name == B.Name && SameType(A.Type, B.Type);
+                }
+                case ENodeKind::FieldDeclaration: {
+                    const auto& A = static_cast<const FieldDeclaration&>(Left);
+                    const auto& B = static_cast<const FieldDeclaration&>(Right);
+                    return A.Access == B.Access && A.Name == B.Name && SameType(A.Type, B.Type);
+                }
+                case ENodeKind::FunctionDeclaration: {
+                    const auto& A = static_cast<const FunctionDeclaration&>(Left);
+                    const auto& B = static_cast<const FunctionDeclaration&>(Right);
+                    if (A.Access != B.Access || A.Name != B.Name || !SameType(A.ReturnType, B.ReturnType) ||
+                        A.Parameters.size() != B.Parameters.size()) {
+                        return false;
+                    }
+                    for (size_t Index = 0; Index < A.Parameters.size(); ++Index) {
+                        if (A.Parameters[Index].Name != B.Parameters[Index].Name ||
+                            !SameType(A.Parameters[Index].Type, B.Parameters[Index].Type)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    const auto& A = static_cast<const DefineDeclaration&>(Left);
+                    const auto& B = static_cast<const DefineDeclaration&>(Right);
+                    return A.Name == B.Name && A.Fields.size() == B.Fields.size() && SameTypes(A.BaseTypes, B.BaseTypes) &&
+                           A.Attributes.size() == B.Attributes.size() &&
+                           std::equal(A.Attributes.begin(), A.Attributes.end(), B.Attributes.begin());
+                }
+                case ENodeKind::InterfaceDeclaration: {
+                    const auto& A = static_cast<const InterfaceDeclaration&>(Left);
+                    const auto& B = static_cast<const InterfaceDeclaration&>(Right);
+                    return A.Name == B.Name && SameTypes(A.BaseInterfaces, B.BaseInterfaces);
+                }
+                case ENodeKind::FetchDeclaration:
+                    return static_cast<const FetchDeclaration&>(Left).Target == static_cast<const FetchDeclaration&>(Right).Target;
+                case ENodeKind::SetDeclaration:
+                    return static_cast<const SetDeclaration&>(Left).Target == static_cast<const SetDeclaration&>(Right).Target;
+                case ENodeKind::NamespaceDeclaration:
+                    return static_cast<const NamespaceDeclaration&>(Left).Name ==
+                           static_cast<const NamespaceDeclaration&>(Right).Name;
+                case ENodeKind::UsingDeclaration:
+                    return static_cast<const UsingDeclaration&>(Left).Path == static_cast<const UsingDeclaration&>(Right).Path;
+                case ENodeKind::TranslationUnit:
+                    return static_cast<const TranslationUnit&>(Left).SourceName ==
+                           static_cast<const TranslationUnit&>(Right).SourceName;
+                default:
+                    return true;
+            }
+        }
+    }
+
+    uint64_t StructuralHash(const ASTNode* Root) {
+        if (Root == nullptr) {
+            return 0;
+        }
+        if (Root->HasCachedHash) {
+            return Root->CachedHash;
+        }
+
+        struct Frame {
+            const ASTNode* Node;
+            uint32_t       SlotCount;
+            bool           Entered;
+        };
+
+        // Bottom-up with an explicit stack: a node is hashed after its child
+        // slots, whose hashes are the last entries of Values. Cached
+        // subtrees are not entered.
+        std::vector<Frame>          Stack = { { Root, 0, false } };
+        std::vector<uint64_t>       Values;
+        std::vector<const ASTNode*> Slots;
+
+        while (!Stack.empty()) {
+            Frame& Top = Stack.back();
+
+            if (!Top.Entered) {
+                if (Top.Node == nullptr || Top.Node->HasCachedHash) {
+                    Values.push_back(Top.Node != nullptr ? Top.Node->CachedHash : 0);
+                    Stack.pop_back();
+                    continue;
+                }
+
+                CollectSlots(*Top.Node, Slots);
+                Top.Entered = true;
+                Top.SlotCount = static_cast<uint32_t>(Slots.size());
+
+                // Reversed so the first slot is finished first
+                for (size_t Slot = Slots.size(); Slot-- > 0;) {
+                    Stack.push_back({ Slots[Slot], 0, false });
+                }
+                continue;
+            }
+
+            const ASTNode* Node = Top.Node;
+            const size_t First = Values.size() - Top.SlotCount;
+            Stack.pop_back();
+
+            uint64_t Hash = HashCombine(HashLocal(*Node), Values.size() - First);
+            for (size_t Slot = First; Slot < Values.size(); ++Slot) {
+                Hash = HashCombine(Hash, Values[Slot]);
+            }
+
+            Values.resize(First);
+            Values.push_back(Hash);
+            Node->CachedHash = Hash;
+            Node->HasCachedHash = true;
+        }
+
+        return Root->CachedHash;
+    }
+
+    bool StructurallyEqual(const ASTNode* Left, const ASTNode* Right) {
+        if (StructuralHash(Left) != StructuralHash(Right)) {
+            return false;
+        }
+
+        // Hashes match; confirm pair by pair, stopping at the first difference
+        std::vector<std::pair<const ASTNode*, const ASTNode*>> Pending = { { Left, Right } };
+        std::vector<const ASTNode*> LeftSlots;
+        std::vector<const ASTNode*> RightSlots;
+
+        while (!Pending.empty()) {
+            const auto [A, B] = Pending.back();
+            Pending.pop_back();
+
+            if (A == B) {
+                continue;
+            }
+            if (A == nullptr || B == nullptr || A->Kind != B->Kind || !EqualLocal(*A, *B)) {
+                return false;
+            }
+
+            CollectSlots(*A, LeftSlots);
+            CollectSlots(*B, RightSlots);
+            if (LeftSlots.size() != RightSlots.size()) {
+                return false;
+            }
+            for (size_t Slot = LeftSlots.size(); Slot-- > 0;) {
+                Pending.emplace_back(LeftSlots[Slot], RightSlots[Slot]);
+            }
+        }
+
+        return true;
+    }
+
+    void ClearStructuralHashes(const ASTNode* Root) {
+        WalkTree(const_cast<ASTNode*>(Root), [](ASTNode& Node) {
+            Node.HasCachedHash = false;
+            return true;
+        });
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ASTNode.h"
+
+namespace Vex {
+
+    /**
+     * Structural hash of the subtree rooted at Root; 0 for nullptr
+     *
+     * Computed bottom-up once and cached in every node it visits
+     * (ASTNode::CachedHash), so later queries on the subtree or any part of
+     * it are a field read, and hashing a new parent only hashes the parent.
+     * Hashes depend only on node kinds, operators, names, literal values and
+     * types (by content, not by TypeRef pointer); source locations are
+     * ignored. They are built from FNV-1a and fixed mixing constants (see
+     * Hashing.h), so they are stable across runs and usable as persistent
+     * cache keys, and they equal FlatASTView::Hash() of the same subtree,
+     * including one read from a module file.
+     *
+     * Writes the cache of shared subtrees, so concurrent passes must hash
+     * a tree before sharing it between threads.
+     *
+     * Example:
+     *   auto& Bucket = Functions[StructuralHash(Function)];
+     *   for (auto* Other : Bucket) { if (StructurallyEqual(Function, Other)) { ... } }
+     */
+    uint64_t StructuralHash(const ASTNode* Root);
+
+    /**
+     * True if both subtrees have the same structure and contents (both may
+     * be nullptr). Compares the root hashes first, so unequal subtrees are
+     * almost always rejected without a walk; matching hashes are confirmed
+     * node by node, stopping at the first difference.
+     */
+    bool StructurallyEqual(const ASTNode* Left, const ASTNode* Right);
+
+    /** Drops the cached hashes of the whole subtree, e.g. after rewriting it in place */
+    void ClearStructuralHashes(const ASTNode* Root);
+}
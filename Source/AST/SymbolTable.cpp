@@ -0,0 +1,245 @@
+#include "SymbolTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Hashing.h"
+
+namespace Vex {
+    namespace {
+        constexpr size_t InitialCapacity = 64;
+
+        /** Table position of a (scope, symbol) key; Mask is the capacity minus one */
+        size_t Home(const ScopeId Scope, const SymbolId Name, const size_t Mask) {
+            const uint64_t Key = static_cast<uint64_t>(Scope) << 32 | Name;
+            return static_cast<size_t>((Key * 0x9E3779B97F4A7C15ull) >> 32) & Mask;
+        }
+    }
+
+    SymbolTable::SymbolTable()
+        : NameSlots(InitialCapacity, 0)
+        , Entries(InitialCapacity) {
+        Scopes.push_back({ NoScope, NoSymbol, {} });
+    }
+
+    // ---- Names ----
+
+    SymbolId SymbolTable::Intern(const std::string_view Name) {
+        const uint64_t Hash = HashBytes(Name);
+        const size_t Mask = NameSlots.size() - 1;
+        size_t At = static_cast<size_t>(Hash) & Mask;
+        for (; NameSlots[At] != 0; At = (At + 1) & Mask) {
+            const SymbolId Existing = NameSlots[At] - 1;
+            if (NameHashes[Existing] == Hash && Names[Existing] == Name) {
+                return Existing;
+            }
+        }
+
+        auto* Memory = static_cast<char*>(Storage.Allocate(Name.size() + 1, 1));
+        std::memcpy(Memory, Name.data(), Name.size());
+        Memory[Name.size()] = '\0';
+
+        const auto Added = static_cast<SymbolId>(Names.size());
+        Names.emplace_back(Memory, Name.size());
+        NameHashes.push_back(Hash);
+        Innermost.push_back(NoScope);
+        NameSlots[At] = Added + 1;
+
+        // Rehash at three quarters full
+        if (Names.size() * 4 > NameSlots.size() * 3) {
+            std::vector<uint32_t> Grown(NameSlots.size() * 2, 0);
+            const size_t GrownMask = Grown.size() - 1;
+            for (SymbolId Symbol = 0; Symbol < Names.size(); ++Symbol) {
+                size_t Free = static_cast<size_t>(NameHashes[Symbol]) & GrownMask;
+                while (Grown[Free] != 0) {
+                    Free = (Free + 1) & GrownMask;
+                }
+                Grown[Free] = Symbol + 1;
+            }
+            NameSlots.swap(Grown);
+        }
+        return Added;
+    }
+
+    SymbolId SymbolTable::Find(const std::string_view Name) const {
+        const uint64_t Hash = HashBytes(Name);
+        const size_t Mask = NameSlots.size() - 1;
+        for (size_t At = static_cast<size_t>(Hash) & Mask; NameSlots[At] != 0; At = (At + 1) & Mask) {
+            const SymbolId Existing = NameSlots[At] - 1;
+            if (NameHashes[Existing] == Hash && Names[Existing] == Name) {
+                return Existing;
+            }
+        }
+        return NoSymbol;
+    }
+
+    // ---- Namespaces ----
+
+    ScopeId SymbolTable::OpenNamespace(ScopeId Parent, const std::string_view Path) {
+        size_t Start = 0;
+        while (Start <= Path.size()) {
+            const size_t End = std::min(Path.find("::", Start), Path.size());
+            const SymbolId Name = Intern(Path.substr(Start, End - Start));
+            Start = End + 2;
+
+            if (const SymbolRef* Found = FindIn(Parent, Name)) {
+                if (Found->Kind != ESymbolKind::Namespace) {
+                    return NoScope;
+                }
+                Parent = Found->Index;
+                continue;
+            }
+
+            const auto Added = static_cast<ScopeId>(Scopes.size());
+            Scopes.push_back({ Parent, Name, {} });
+            Insert(Parent, Name, { ESymbolKind::Namespace, Added, 0 });
+            Parent = Added;
+        }
+        return Parent;
+    }
+
+    void SymbolTable::AddUsing(const ScopeId Scope, const ScopeId Imported) {
+        std::vector<ScopeId>& Usings = Scopes[Scope].Usings;
+        if (Imported != Scope && std::find(Usings.begin(), Usings.end(), Imported) == Usings.end()) {
+            Usings.push_back(Imported);
+        }
+    }
+
+    std::string SymbolTable::QualifiedName(ScopeId Scope) const {
+        std::string Name;
+        for (; Scope != GlobalScope && Scope != NoScope; Scope = Scopes[Scope].Parent) {
+            Name.insert(0, Name.empty() ? std::string(Names[Scopes[Scope].Name])
+                                        : std::string(Names[Scopes[Scope].Name]) + "::");
+        }
+        return Name;
+    }
+
+    // ---- Declarations ----
+
+    bool SymbolTable::Declare(const ScopeId Scope, const SymbolId Name, const SymbolRef& Value) {
+        if (FindIn(Scope, Name) != nullptr) {
+            return false;
+        }
+        Insert(Scope, Name, Value);
+        return true;
+    }
+
+    const SymbolRef* SymbolTable::FindIn(const ScopeId Scope, const SymbolId Name) const {
+        const Entry& Found = Entries[Slot(Scope, Name)];
+        return Found.Scope != NoScope ? &Found.Value : nullptr;
+    }
+
+    size_t SymbolTable::Slot(const ScopeId Scope, const SymbolId Name) const {
+        const size_t Mask = Entries.size() - 1;
+        size_t At = Home(Scope, Name, Mask);
+        while (Entries[At].Scope != NoScope && (Entries[At].Scope != Scope || Entries[At].Name != Name)) {
+            At = (At + 1) & Mask;
+        }
+        return At;
+    }
+
+    size_t SymbolTable::Insert(const ScopeId Scope, const SymbolId Name, const SymbolRef& Value) {
+        if ((Count + 1) * 4 > Entries.size() * 3) {
+            Grow();
+        }
+        const size_t At = Slot(Scope, Name);
+        Entries[At] = { Scope, Name, Value };
+        ++Count;
+        return At;
+    }
+
+    void SymbolTable::Erase(const size_t At) {
+        // Backward shift: pull later entries of the probe run into the hole, so no tombstones are left
+        const size_t Mask = Entries.size() - 1;
+        size_t Hole = At;
+        for (size_t Next = (At + 1) & Mask; Entries[Next].Scope != NoScope; Next = (Next + 1) & Mask) {
+            const size_t Wanted = Home(Entries[Next].Scope, Entries[Next].Name, Mask);
+            if (((Next - Wanted) & Mask) >= ((Next - Hole) & Mask)) {
+                Entries[Hole] = Entries[Next];
+                Hole = Next;
+            }
+        }
+        Entries[Hole] = Entry();
+        --Count;
+    }
+
+    void SymbolTable::Grow() {
+        std::vector<Entry> Old(Entries.size() * 2);
+        Old.swap(Entries);
+        for (const Entry& Moved : Old) {
+            if (Moved.Scope != NoScope) {
+                Entries[Slot(Moved.Scope, Moved.Name)] = Moved;
+            }
+        }
+    }
+
+    // ---- Blocks ----
+
+    ScopeId SymbolTable::PushScope() {
+        Blocks.push_back(Log.size());
+        return FirstBlock + static_cast<ScopeId>(Blocks.size() - 1);
+    }
+
+    void SymbolTable::PopScope() {
+        const ScopeId Block = FirstBlock + static_cast<ScopeId>(Blocks.size() - 1);
+        for (; Log.size() > Blocks.back(); Log.pop_back()) {
+            const Undo& Last = Log.back();
+            Erase(Slot(Block, Last.Name));
+            Innermost[Last.Name] = Last.Shadowed;
+        }
+        Blocks.pop_back();
+    }
+
+    bool SymbolTable::DeclareLocal(const SymbolId Name, const SymbolRef& Value) {
+        if (Blocks.empty()) {
+            return false;
+        }
+        const ScopeId Block = FirstBlock + static_cast<ScopeId>(Blocks.size() - 1);
+        if (Innermost[Name] == Block) {
+            return false;
+        }
+        Insert(Block, Name, Value);
+        Log.push_back({ Name, Innermost[Name] });
+        Innermost[Name] = Block;
+        return true;
+    }
+
+    // ---- Lookup ----
+
+    const SymbolRef* SymbolTable::Lookup(const ScopeId Namespace, const SymbolId Name, const bool InBlocks) const {
+        if (Name == NoSymbol) {
+            return nullptr;
+        }
+        if (InBlocks && Innermost[Name] != NoScope) {
+            return FindIn(Innermost[Name], Name);
+        }
+
+        for (ScopeId Scope = Namespace; Scope != NoScope; Scope = Scopes[Scope].Parent) {
+            if (const SymbolRef* Found = FindIn(Scope, Name)) {
+                return Found;
+            }
+            for (const ScopeId Imported : Scopes[Scope].Usings) {
+                if (const SymbolRef* Found = FindIn(Imported, Name)) {
+                    return Found;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    const SymbolRef* SymbolTable::LookupPath(const ScopeId Namespace, const std::string_view Path, const bool InBlocks) const {
+        size_t End = std::min(Path.find("::"), Path.size());
+        const SymbolRef* Found = Lookup(Namespace, Find(Path.substr(0, End)), InBlocks);
+
+        while (Found != nullptr && End < Path.size()) {
+            if (Found->Kind != ESymbolKind::Namespace) {
+                return nullptr;
+            }
+            const size_t Start = End + 2;
+            End = std::min(Path.find("::", Start), Path.size());
+            const SymbolId Segment = Find(Path.substr(Start, End - Start));
+            Found = Segment != NoSymbol ? FindIn(Found->Index, Segment) : nullptr;
+        }
+        return Found;
+    }
+}
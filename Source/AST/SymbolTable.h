@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Arena.h"
+#include "ASTNode.h"
+
+namespace Vex {
+
+    /** Dense id of a name interned by a SymbolTable */
+    using SymbolId = uint32_t;
+
+    /** Namespace or open block of a SymbolTable; the global scope is 0 */
+    using ScopeId = uint32_t;
+
+    /**
+     * Scoped names for name resolution
+     *
+     * Names are interned once into dense SymbolIds. Every declaration, in
+     * any scope, lives in one flat open-addressing table keyed by
+     * (scope, symbol), so finding a name in a given scope is a single
+     * probe and resolving `A::B::C` costs one probe per segment.
+     *
+     * Namespaces are persistent scopes: they are reopened by name and
+     * can be searched at any time. Block scopes are pushed and popped
+     * around function bodies and blocks; each declaration in one is
+     * recorded in an undo log, and popping replays the log back to the
+     * scope's mark, erasing its entries and restoring whatever they
+     * shadowed. Nothing is ever copied on entering or leaving a scope,
+     * and the innermost block declaring each name is kept in an array
+     * indexed by SymbolId, so an unqualified lookup checks all the open
+     * blocks with one load and one probe.
+     *
+     * Unqualified lookup then tries the namespace it starts in, the
+     * namespaces that one imports with Using (the first import that has
+     * the name wins), and each enclosing namespace the same way, out to
+     * the global scope.
+     *
+     * Example:
+     *   SymbolTable Symbols;
+     *   const ScopeId Math = Symbols.OpenNamespace(SymbolTable::GlobalScope, "Engine::Math");
+     *   Symbols.Declare(Math, Symbols.Intern("Dot"), { ESymbolKind::Function, 0, 0 });
+     *   Symbols.LookupPath(SymbolTable::GlobalScope, "Engine::Math::Dot");     // The function
+     *
+     *   Symbols.PushScope();
+     *   Symbols.DeclareLocal(Symbols.Intern("Dot"), { ESymbolKind::Local, 0, 0 });
+     *   Symbols.Lookup(Math, Symbols.Intern("Dot"));                          // The local
+     *   Symbols.PopScope();
+     */
+    class SymbolTable {
+    public:
+        static constexpr ScopeId GlobalScope = 0;
+        static constexpr ScopeId NoScope = 0xFFFFFFFFu;
+        static constexpr SymbolId NoSymbol = 0xFFFFFFFFu;
+
+        SymbolTable();
+
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        // ---- Names ----
+
+        /** Id of Name, interning a copy of it if it is new */
+        SymbolId Intern(std::string_view Name);
+
+        /** Id of Name, or NoSymbol if it was never interned (so nothing can be declared by it) */
+        [[nodiscard]] SymbolId Find(std::string_view Name) const;
+
+        [[nodiscard]] std::string_view NameOf(const SymbolId Symbol) const { return Names[Symbol]; }
+        [[nodiscard]] size_t SymbolCount() const { return Names.size(); }
+
+        // ---- Namespaces ----
+
+        /**
+         * Scope of the namespace Path (A or A::B) inside Parent, created
+         * along with any missing outer segment; an existing namespace is
+         * reopened. NoScope if a segment is already declared as something
+         * else.
+         */
+        ScopeId OpenNamespace(ScopeId Parent, std::string_view Path);
+
+        /** Makes the members of Imported visible to unqualified lookups in Scope */
+        void AddUsing(ScopeId Scope, ScopeId Imported);
+
+        [[nodiscard]] ScopeId ParentOf(const ScopeId Scope) const { return Scopes[Scope].Parent; }
+
+        /** Qualified name of a namespace ("" for the global scope) */
+        [[nodiscard]] std::string QualifiedName(ScopeId Scope) const;
+
+        // ---- Declarations ----
+
+        /** Declares Name in a namespace; false if that namespace already has it */
+        bool Declare(ScopeId Scope, SymbolId Name, const SymbolRef& Value);
+
+        /** What Name is declared as in Scope itself, or null: one probe */
+        [[nodiscard]] const SymbolRef* FindIn(ScopeId Scope, SymbolId Name) const;
+
+        // ---- Blocks ----
+
+        /** Opens a block scope inside the current one */
+        ScopeId PushScope();
+
+        /** Closes the innermost block scope, forgetting what it declared */
+        void PopScope();
+
+        /** Declares Name in the innermost block scope, shadowing outer ones; false if that block already has it */
+        bool DeclareLocal(SymbolId Name, const SymbolRef& Value);
+
+        [[nodiscard]] size_t OpenScopes() const { return Blocks.size(); }
+
+        // ---- Lookup ----
+
+        /**
+         * What Name means in the open blocks, then in Namespace and around
+         * it; null if nothing. InBlocks false skips the blocks, for names
+         * that locals cannot shadow, such as types.
+         */
+        [[nodiscard]] const SymbolRef* Lookup(ScopeId Namespace, SymbolId Name, bool InBlocks = true) const;
+
+        /** Lookup() of A, then FindIn() of each further segment of A::B::C; null if any is missing */
+        [[nodiscard]] const SymbolRef* LookupPath(ScopeId Namespace, std::string_view Path, bool InBlocks = true) const;
+
+        /** Entries in the table, live ones only */
+        [[nodiscard]] size_t Size() const { return Count; }
+
+    private:
+        struct Entry {
+            ScopeId Scope = NoScope;                // NoScope marks an empty slot
+            SymbolId Name = NoSymbol;
+            SymbolRef Value;
+        };
+
+        struct NamespaceInfo {
+            ScopeId Parent;
+            SymbolId Name;                          // Last segment of its path
+            std::vector<ScopeId> Usings;
+        };
+
+        /** A declaration in a block, undone when the block closes */
+        struct Undo {
+            SymbolId Name;
+            ScopeId Shadowed;                       // Previous Innermost[Name]
+        };
+
+        /** Blocks are numbered by depth above every namespace; only open ones have entries */
+        static constexpr ScopeId FirstBlock = 0x80000000u;
+
+        // Interned names: open addressing over Names, storing id + 1
+        ArenaAllocator Storage;
+        std::vector<std::string_view> Names;
+        std::vector<uint64_t> NameHashes;
+        std::vector<uint32_t> NameSlots;
+
+        // Declarations: open addressing with linear probing and backward-shift deletion
+        std::vector<Entry> Entries;
+        size_t Count = 0;
+
+        std::vector<NamespaceInfo> Scopes;          // By ScopeId, below FirstBlock
+        std::vector<size_t> Blocks;                 // Log size when each open block opened, innermost last
+        std::vector<Undo> Log;
+        std::vector<ScopeId> Innermost;             // By SymbolId: innermost open block declaring it, or NoScope
+
+        /** Slot holding (Scope, Name), or the empty slot where it would go */
+        [[nodiscard]] size_t Slot(ScopeId Scope, SymbolId Name) const;
+        size_t Insert(ScopeId Scope, SymbolId Name, const SymbolRef& Value);
+        void Erase(size_t At);
+        void Grow();
+    };
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+
+// Forward declarations of all test functions
+void Test_AST_001_ContextAllocation();
+void Test_AST_002_FlatAST();
+void Test_AST_003_StaticVisitor();
+void Test_AST_004_TypeTable();
+void Test_AST_005_DeepTrees();
+void Test_AST_006_Modules();
+void Test_AST_007_StructuralHashing();
+void Test_AST_008_SymbolTable();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX AST TEST SUITE" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Test_AST_001_ContextAllocation();
+        Test_AST_002_FlatAST();
+        Test_AST_003_StaticVisitor();
+        Test_AST_004_TypeTable();
+        Test_AST_005_DeepTrees();
+        Test_AST_006_Modules();
+        Test_AST_007_StructuralHashing();
+        Test_AST_008_SymbolTable();
+
+        std::cout << "\n";
+
+        std::cout << "========================================" << "\n";
+        std::cout << " ALL TESTS PASSED!" << "\n";
+        std::cout << "========================================" << "\n";
+
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Test failed with exception: " << E.what() << "\n";
+        return 1;
+    } catch (...) {
+        std::cerr << "Test failed with unknown exception" << "\n";
+        return 1;
+    }
+}
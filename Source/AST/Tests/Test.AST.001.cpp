@@ -0,0 +1,79 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+#include "../ASTContext.h"
+#include "../Statement.h"
+
+using namespace Vex;
+
+void Test_AST_001_ContextAllocation() {
+    std::cout << "--- AST Test 001: Context Allocation ---" << "\n";
+
+    ASTContext Context;
+
+    // Interned strings share storage and outlive the source buffer
+    std::string Buffer = "Health";
+    const std::string_view Health = Context.Intern(Buffer);
+    Buffer = "Changed";
+    assert(Health == "Health");
+    assert(Context.Intern("Health").data() == Health.data());
+
+    // Health <= 0
+    auto* Condition = Context.Create<BinaryExpression>(
+        Context.Create<Identifier>(Health),
+        EBinaryOp::LessEqual,
+        Context.Create<IntegerLiteral>(0)
+    );
+
+    // Die(Reason)
+    auto* Call = Context.Create<FunctionCall>(Context.Create<Identifier>(Context.Intern("Die")));
+    std::vector<Expression*> Arguments = { Context.Create<StringLiteral>(Context.Intern("Fell")) };
+    Call->Arguments = Context.CreateArray(Arguments);
+
+    auto* Then = Context.Create<BlockStatement>();
+    std::vector<Statement*> Statements = { Context.Create<ExpressionStatement>(Call) };
+    Then->Statements = Context.CreateArray(Statements);
+
+    auto* If = Context.Create<IfStatement>(Condition, Then);
+
+    std::cout << If->ToString() << "\n";
+    assert(If->ToString() == "if (Health <= 0) { Die(\"Fell\"); }");
+
+    // Types and parameters live in the context too
+    TypeRef SharedInt(Context.Intern("Int_32"));
+    SharedInt.IsShared = true;
+    const TypeRef* Type = Context.GetTypes().Get(SharedInt);
+    const Parameter Amount(Context.Intern("Amount"), Type);
+    assert(Amount.ToString() == "Amount: Shared Int_32");
+
+    auto* Var = Context.Create<VariableDeclaration>(false, true, Context.Intern("X"), Type,
+                                                    Context.Create<FloatLiteral>(100.0));
+    assert(Var->ToString() == "Let X: Shared Int_32 = 100.0;");
+
+    // Empty arrays do not touch the arena
+    const size_t Before = Context.GetBytesAllocated();
+    const auto Empty = Context.CreateArray(std::vector<Expression*>());
+    assert(Empty.empty());
+    assert(Context.GetBytesAllocated() == Before);
+
+    // Large allocations fall back to dedicated slabs
+    void* Large = Context.Allocate(1024 * 1024, 16);
+    assert(Large != nullptr);
+    assert(reinterpret_cast<uintptr_t>(Large) % 16 == 0);
+    assert(Context.GetBytesReserved() >= Context.GetBytesAllocated());
+
+    // Reset keeps the arena usable
+    ArenaAllocator Arena(256);
+    for (int Index = 0; Index < 1000; ++Index) {
+        auto* Value = static_cast<long long*>(Arena.Allocate(sizeof(long long), alignof(long long)));
+        *Value = Index;
+    }
+    assert(Arena.GetSlabCount() > 1);
+    Arena.Reset();
+    assert(Arena.GetSlabCount() == 1);
+    assert(Arena.GetBytesAllocated() == 0);
+    assert(Arena.Allocate(8, 8) != nullptr);
+
+    std::cout << "AST Test 001: Passed\n\n";
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+#include "../ASTContext.h"
+#include "../FlatAST.h"
+#include "../Statement.h"
+
+using namespace Vex;
+
+namespace {
+    Statement* BuildSample(ASTContext& Context) {
+        // Let Damage: Shared Int_32 = Base * 2 ** Level;
+        TypeRef SharedInt("Int_32");
+        SharedInt.IsShared = true;
+        const TypeRef* Type = Context.GetTypes().Get(SharedInt);
+
+        auto* Damage = Context.Create<VariableDeclaration>(
+            false, true, Context.Intern("Damage"), Type,
+            Context.Create<BinaryExpression>(
+                Context.Create<Identifier>(Context.Intern("Base")),
+                EBinaryOp::Multiply,
+                Context.Create<BinaryExpression>(
+                    Context.Create<IntegerLiteral>(2), EBinaryOp::Power,
+                    Context.Create<Identifier>(Context.Intern("Level")))));
+        Damage->Location = { 3, 5 };
+
+        // for I in 0..=10 step 2 { Spawn(I as Float, "Orc"); }
+        auto* Call = Context.Create<FunctionCall>(Context.Create<Identifier>(Context.Intern("Spawn")));
+        std::vector<Expression*> Arguments = {
+            Context.Create<CastExpression>(Context.Create<Identifier>(Context.Intern("I")),
+                                           Context.GetType("Float")),
+            Context.Create<StringLiteral>(Context.Intern("Orc")),
+        };
+        Call->Arguments = Context.CreateArray(Arguments);
+
+        auto* LoopBody = Context.Create<BlockStatement>();
+        std::vector<Statement*> LoopStatements = { Context.Create<ExpressionStatement>(Call) };
+        LoopBody->Statements = Context.CreateArray(LoopStatements);
+
+        auto* Loop = Context.Create<ForStatement>(
+            Context.Intern("I"), Context.Create<IntegerLiteral>(0), Context.Create<IntegerLiteral>(10),
+            true, LoopBody, Context.Create<IntegerLiteral>(2));
+
+        // match Weapon { Sword -> return 1.5; _ -> return; }
+        auto* Match = Context.Create<MatchStatement>(Context.Create<Identifier>(Context.Intern("Weapon")));
+        std::vector<MatchCase> Cases = {
+            MatchCase(Context.Create<Identifier>(Context.Intern("Sword")),
+                      Context.Create<ReturnStatement>(Context.Create<FloatLiteral>(1.5))),
+            MatchCase(Context.Create<Identifier>(Context.Intern("_")), Context.Create<ReturnStatement>()),
+        };
+        Match->Cases = Context.CreateArray(Cases);
+
+        // if !Alive { break; } else if X?? { continue; }
+        auto* Else = Context.Create<IfStatement>(
+            Context.Create<BinaryExpression>(Context.Create<Identifier>(Context.Intern("X")), EBinaryOp::NullCoalesce,
+                                             Context.Create<NullLiteral>()),
+            Context.Create<ContinueStatement>());
+        auto* If = Context.Create<IfStatement>(
+            Context.Create<UnaryExpression>(EUnaryOp::LogicalNot, Context.Create<Identifier>(Context.Intern("Alive"))),
+            Context.Create<BreakStatement>(), Else);
+
+        auto* Block = Context.Create<BlockStatement>();
+        std::vector<Statement*> Statements = { Damage, Loop, Match, If };
+        Block->Statements = Context.CreateArray(Statements);
+        return Block;
+    }
+}
+
+void Test_AST_002_FlatAST() {
+    std::cout << "--- AST Test 002: Flat AST ---" << "\n";
+
+    ASTContext Context;
+    Statement* Tree = BuildSample(Context);
+
+    FlatAST Flat;
+    const NodeIndex Root = Flat.Append(Tree);
+
+    std::cout << Flat.ToString(Root) << "\n";
+
+    // Post-order: the root comes last and the subtree starts at 0
+    assert(Root == Flat.Size() - 1);
+    assert(Flat.GetSubtreeBegin(Root) == 0);
+    assert(Flat.GetKind(Root) == ENodeKind::BlockStatement);
+    assert(Flat.GetNode(Root).ChildCount == 4);
+
+    // Printing matches the pointer tree
+    assert(Flat.ToString(Root) == Tree->ToString());
+
+    // Counting
+    const auto Counts = Flat.CountKinds(Root);
+    assert(Counts[static_cast<size_t>(ENodeKind::IntegerLiteral)] == 4);
+    assert(Counts[static_cast<size_t>(ENodeKind::IfStatement)] == 2);
+    assert(Counts[static_cast<size_t>(ENodeKind::BlockStatement)] == 2);
+
+    // Locations are kept in a parallel array
+    const NodeIndex DamageIndex = Flat.GetChild(Root, 0);
+    assert(Flat.GetLocation(DamageIndex).Line == 3);
+    assert(Flat.GetLocation(DamageIndex).Column == 5);
+
+    // Round trip through a different context
+    ASTContext Other;
+    ASTNode* Rebuilt = Flat.ToTree(Root, Other);
+    assert(Rebuilt->ToString() == Tree->ToString());
+    assert(static_cast<BlockStatement*>(Rebuilt)->Statements[0]->Location.Line == 3);
+
+    // Structurally identical trees hash identically, regardless of locations
+    FlatAST Copy;
+    Rebuilt->Location = { 42, 42 };
+    const NodeIndex CopyRoot = Copy.Append(Rebuilt);
+    assert(Copy.Hash(CopyRoot) == Flat.Hash(Root));
+
+    // A single changed literal changes the hash
+    static_cast<IntegerLiteral*>(static_cast<ForStatement*>(
+        static_cast<BlockStatement*>(Rebuilt)->Statements[1])->RangeEnd)->Value = 11;
+    FlatAST Changed;
+    const NodeIndex ChangedRoot = Changed.Append(Rebuilt);
+    assert(Changed.Hash(ChangedRoot) != Flat.Hash(Root));
+
+    // Subtrees can be printed on their own
+    const NodeIndex LoopIndex = Flat.GetChild(Root, 1);
+    assert(Flat.ToString(LoopIndex) == "for I in 0..=10 step 2 { Spawn((I as Float), \"Orc\"); }");
+
+    std::cout << "AST Test 002: Passed\n\n";
+}
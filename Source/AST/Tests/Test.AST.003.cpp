@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../ASTContext.h"
+#include "../StaticVisitor.h"
+
+using namespace Vex;
+
+namespace {
+    /**
+     * Only handles identifiers and counts statements; the defaults do the walk
+     */
+    class IdentifierCollector : public StaticVisitor<IdentifierCollector> {
+    public:
+        std::vector<std::string_view> Names;
+        size_t Statements = 0;
+
+        void VisitIdentifier(Identifier& Node) { Names.push_back(Node.Name); }
+
+        void VisitStatement(Statement&) { ++Statements; }
+    };
+
+    /**
+     * Value-returning visitor over integer arithmetic
+     */
+    class Evaluator : public StaticVisitor<Evaluator, long long> {
+    public:
+        long long VisitIntegerLiteral(IntegerLiteral& Node) { return Node.Value; }
+        long long VisitGroupingExpression(GroupingExpression& Node) { return Visit(Node.Expr); }
+
+        long long VisitUnaryExpression(UnaryExpression& Node) {
+            const long long Operand = Visit(Node.Operand);
+            return Node.Op == EUnaryOp::Minus ? -Operand : Operand;
+        }
+
+        long long VisitBinaryExpression(BinaryExpression& Node) {
+            const long long Left = Visit(Node.Left);
+            const long long Right = Visit(Node.Right);
+
+            switch (Node.Op) {
+                case EBinaryOp::Add:        return Left + Right;
+                case EBinaryOp::Subtract:   return Left - Right;
+                case EBinaryOp::Multiply:   return Left * Right;
+                case EBinaryOp::Divide:     return Left / Right;
+                default:                    return 0;
+            }
+        }
+    };
+}
+
+void Test_AST_003_StaticVisitor() {
+    std::cout << "--- AST Test 003: Static Visitor ---" << "\n";
+
+    // Nodes carry a kind tag instead of a vtable
+    static_assert(!std::is_polymorphic_v<ASTNode>);
+    static_assert(std::is_trivially_destructible_v<BinaryExpression>);
+
+    ASTContext Context;
+
+    // Kind tags and checked casts
+    auto* Literal = Context.Create<IntegerLiteral>(7);
+    ASTNode* Node = Literal;
+    assert(Node->Kind == ENodeKind::IntegerLiteral);
+    assert(Node->Is<IntegerLiteral>());
+    assert(!Node->Is<FloatLiteral>());
+    assert(Node->As<IntegerLiteral>() == Literal);
+    assert(Node->As<Identifier>() == nullptr);
+    assert(Node->IsExpression() && !Node->IsStatement());
+    assert(Context.Create<BreakStatement>()->IsStatement());
+
+    // (1 + 2) * -(10 / 5) = -6
+    auto* Expr = Context.Create<BinaryExpression>(
+        Context.Create<GroupingExpression>(Context.Create<BinaryExpression>(
+            Context.Create<IntegerLiteral>(1), EBinaryOp::Add, Context.Create<IntegerLiteral>(2))),
+        EBinaryOp::Multiply,
+        Context.Create<UnaryExpression>(EUnaryOp::Minus, Context.Create<BinaryExpression>(
+            Context.Create<IntegerLiteral>(10), EBinaryOp::Divide, Context.Create<IntegerLiteral>(5))));
+
+    Evaluator Eval;
+    assert(Eval.Visit(Expr) == -6);
+
+    // Unhandled kinds return a default value
+    assert(Eval.Visit(Context.Create<Identifier>(Context.Intern("X"))) == 0);
+
+    // while Alive { if Health <= 0 { Die(Self); } }
+    auto* Call = Context.Create<FunctionCall>(Context.Create<Identifier>(Context.Intern("Die")));
+    Expression* Arguments[] = { Context.Create<Identifier>(Context.Intern("Self")) };
+    Call->Arguments = Context.CreateArray(Arguments, 1);
+
+    auto* If = Context.Create<IfStatement>(
+        Context.Create<BinaryExpression>(Context.Create<Identifier>(Context.Intern("Health")),
+                                         EBinaryOp::LessEqual, Context.Create<IntegerLiteral>(0)),
+        Context.Create<ExpressionStatement>(Call));
+
+    auto* Body = Context.Create<BlockStatement>();
+    Statement* BodyStatements[] = { If };
+    Body->Statements = Context.CreateArray(BodyStatements, 1);
+
+    auto* Loop = Context.Create<WhileStatement>(Context.Create<Identifier>(Context.Intern("Alive")), Body);
+
+    IdentifierCollector Collector;
+    Collector.Visit(Loop);
+
+    // Source order, absent else branch skipped
+    assert(Collector.Names.size() == 4);
+    assert(Collector.Names[0] == "Alive");
+    assert(Collector.Names[1] == "Health");
+    assert(Collector.Names[2] == "Die");
+    assert(Collector.Names[3] == "Self");
+    assert(Collector.Statements == 4);
+
+    // ForEachChild visits direct children only
+    size_t ChildCount = 0;
+    ForEachChild(*If, [&ChildCount](ASTNode*) { ++ChildCount; });
+    assert(ChildCount == 2);
+
+    std::cout << "AST Test 003: Passed\n\n";
+}
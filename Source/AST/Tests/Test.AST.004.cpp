@@ -0,0 +1,93 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "../ASTContext.h"
+#include "../FlatAST.h"
+#include "../Statement.h"
+
+using namespace Vex;
+
+void Test_AST_004_TypeTable() {
+    std::cout << "--- AST Test 004: Type Table ---" << "\n";
+
+    ASTContext Context;
+    TypeTable& Types = Context.GetTypes();
+
+    // Equal names give the same object, whatever buffer they came from
+    const std::string Buffer = "Int_32";
+    const TypeRef* Int = Types.Get("Int_32");
+    assert(Int == Types.Get(Buffer));
+    assert(Int == Context.GetType(Context.Intern("Int_32")));
+    assert(Int->Name.data() != Buffer.data());
+    assert(Int->Id == 0);
+    assert(Types.GetById(Int->Id) == Int);
+
+    // Every qualifier is part of the identity
+    TypeRef Key("Int_32");
+    Key.IsShared = true;
+    const TypeRef* SharedInt = Types.Get(Key);
+    assert(SharedInt != Int);
+    assert(SharedInt->ToString() == "Shared Int_32");
+
+    Key.IsShared = false;
+    Key.IsUnique = true;
+    assert(Types.Get(Key) != SharedInt);
+    Key.IsUnique = false;
+    Key.IsBorrow = true;
+    assert(Types.Get(Key) != SharedInt);
+    Key.IsBorrow = false;
+    Key.IsPointer = true;
+    assert(Types.Get(Key)->ToString() == "Int_32*");
+    assert(Types.Size() == 5);
+
+    // Member paths and allowed fields are compared element-wise
+    std::vector<std::string_view> Path = { "Health" };
+    TypeRef Member("Entity");
+    Member.MemberPath = ArenaArray<std::string_view>(Path.data(), Path.size());
+    const TypeRef* EntityHealth = Types.Get(Member);
+    assert(EntityHealth->ToString() == "Entity.Health");
+
+    const std::string Copy = "Health";
+    std::vector<std::string_view> OtherPath = { Copy };
+    Member.MemberPath = ArenaArray<std::string_view>(OtherPath.data(), OtherPath.size());
+    assert(Types.Get(Member) == EntityHealth);
+
+    std::vector<std::string_view> Fields = { "Entity.Health", "Entity.Armor" };
+    TypeRef Restricted("Float");
+    Restricted.AllowedFields = ArenaArray<std::string_view>(Fields.data(), Fields.size());
+    const TypeRef* FloatFields = Types.Get(Restricted);
+    assert(FloatFields->ToString() == "Float{Entity.Health, Entity.Armor}");
+    assert(FloatFields != Types.Get("Float"));
+
+    std::swap(Fields[0], Fields[1]);
+    assert(Types.Get(Restricted) != FloatFields);
+
+    // Canonical copies do not point into the caller's storage
+    assert(EntityHealth->MemberPath[0].data() != Copy.data());
+
+    // Memory is O(distinct types): a million annotations add nothing
+    const size_t Before = Context.GetBytesAllocated();
+    const size_t Count = Types.Size();
+    for (int Index = 0; Index < 1000000; ++Index) {
+        assert(Types.Get(Index % 2 == 0 ? "Int_32" : "Float") != nullptr);
+    }
+    assert(Types.Size() == Count);
+    assert(Context.GetBytesAllocated() == Before);
+
+    // Rebuilding a flattened tree reuses the target context's canonical types
+    auto* Cast = Context.Create<CastExpression>(Context.Create<Identifier>(Context.Intern("X")), SharedInt);
+    auto* Stmt = Context.Create<VariableDeclaration>(false, true, Context.Intern("Y"), SharedInt, Cast);
+
+    FlatAST Flat;
+    const NodeIndex Root = Flat.Append(Stmt);
+
+    ASTContext Other;
+    auto* Rebuilt = static_cast<VariableDeclaration*>(Flat.ToTree(Root, Other));
+    assert(Rebuilt->ToString() == "Let Y: Shared Int_32 = (X as Shared Int_32);");
+    assert(Rebuilt->Type == static_cast<CastExpression*>(Rebuilt->Initializer)->Type);
+    assert(Other.GetTypes().Size() == 1);
+
+    std::cout << "AST Test 004: Passed\n\n";
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+
+#include "../ASTContext.h"
+#include "../FlatAST.h"
+#include "../Statement.h"
+#include "../TreeWalker.h"
+
+using namespace Vex;
+
+namespace {
+    // Deep enough that any per-level recursion would blow a default 8 MB stack
+    constexpr size_t Depth = 1000000;
+
+    /** A + B + A + B + ... with Depth operators (left-deep) */
+    Expression* BuildSum(ASTContext& Context) {
+        const std::string_view Names[] = { Context.Intern("A"), Context.Intern("B") };
+
+        Expression* Sum = Context.Create<Identifier>(Names[0]);
+        for (size_t Index = 0; Index < Depth; ++Index) {
+            Sum = Context.Create<BinaryExpression>(Sum, EBinaryOp::Add, Context.Create<Identifier>(Names[(Index + 1) % 2]));
+        }
+        return Sum;
+    }
+
+    /** if X { break; } else if X { break; } else ... with Depth ifs (right-deep) */
+    Statement* BuildElseChain(ASTContext& Context) {
+        const std::string_view Name = Context.Intern("X");
+
+        Statement* Chain = Context.Create<ContinueStatement>();
+        for (size_t Index = 0; Index < Depth; ++Index) {
+            Chain = Context.Create<IfStatement>(Context.Create<Identifier>(Name), Context.Create<BreakStatement>(), Chain);
+        }
+        return Chain;
+    }
+}
+
+void Test_AST_005_DeepTrees() {
+    std::cout << "--- AST Test 005: Million-Deep Trees ---" << "\n";
+
+    {
+        ASTContext Context;
+        Expression* Sum = BuildSum(Context);
+
+        // Walk: every node entered and left once, parents after children
+        size_t Entered = 0;
+        size_t Left = 0;
+        size_t Leaves = 0;
+        WalkTree(Sum,
+                 [&](ASTNode&) { ++Entered; return true; },
+                 [&](ASTNode& Node) { ++Left; Leaves += Node.Is<Identifier>() ? 1 : 0; });
+        assert(Entered == 2 * Depth + 1);
+        assert(Left == Entered);
+        assert(Leaves == Depth + 1);
+
+        // Skipping children stops the descent
+        size_t Visited = 0;
+        WalkTree(Sum, [&](ASTNode&) { ++Visited; return false; });
+        assert(Visited == 1);
+
+        // Printing
+        const std::string Text = Sum->ToString();
+        assert(Text.size() == Depth * 6 + 1);
+        assert(Text.compare(0, 4, "((((") == 0);
+        assert(Text.compare(Text.size() - 10, 10, " + B) + A)") == 0);
+
+        // Flattening, printing and rebuilding the flat form
+        FlatAST Flat;
+        const NodeIndex Root = Flat.Append(Sum);
+        assert(Flat.Size() == 2 * Depth + 1);
+        assert(Flat.GetSubtreeBegin(Root) == 0);
+        assert(Flat.ToString(Root) == Text);
+
+        ASTContext Copy;
+        ASTNode* Rebuilt = Flat.ToTree(Root, Copy);
+        assert(Rebuilt->ToString() == Text);
+
+        FlatAST Again;
+        assert(Again.Hash(Again.Append(Rebuilt)) == Flat.Hash(Root));
+
+        // Both contexts release their trees without visiting any node
+    }
+
+    {
+        ASTContext Context;
+        Statement* Chain = BuildElseChain(Context);
+
+        size_t Ifs = 0;
+        WalkTree(Chain, [&](ASTNode& Node) { Ifs += Node.Is<IfStatement>() ? 1 : 0; return true; });
+        assert(Ifs == Depth);
+
+        const std::string Text = Chain->ToString();
+        assert(Text.compare(0, 36, "if X break; else if X break; else if") == 0);
+        assert(Text.compare(Text.size() - 21, 21, "break; else continue;") == 0);
+
+        FlatAST Flat;
+        const NodeIndex Root = Flat.Append(Chain);
+        assert(Flat.ToString(Root) == Text);
+    }
+
+    std::cout << "AST Test 005: Passed\n\n";
+}
@@ -0,0 +1,251 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../ASTContext.h"
+#include "../Declaration.h"
+#include "../FlatAST.h"
+#include "../Module.h"
+#include "../TreeWalker.h"
+
+using namespace Vex;
+
+namespace {
+    FunctionCall* Call(ASTContext& Context, const char* Name, Expression* Argument) {
+        auto* Result = Context.Create<FunctionCall>(Context.Create<Identifier>(Context.Intern(Name)));
+        Result->Arguments = Context.CreateArray(&Argument, 1);
+        return Result;
+    }
+
+    FunctionDeclaration* BuildMethod(ASTContext& Context, const char* Name, const TypeRef* ReturnType,
+                                     std::vector<Statement*> Statements, std::vector<Parameter> Parameters = {}) {
+        auto* Body = Context.Create<BlockStatement>();
+        Body->Statements = Context.CreateArray(Statements);
+
+        auto* Method = Context.Create<FunctionDeclaration>(EAccessModifier::NONE, Context.Intern(Name), ReturnType, Body);
+        Method->Parameters = Context.CreateArray(Parameters);
+        return Method;
+    }
+
+    TranslationUnit* BuildUnit(ASTContext& Context) {
+        const TypeRef* Int = Context.GetType("Int_32");
+        const TypeRef* Float = Context.GetType("Float");
+        const TypeRef* Void = Context.GetType("Void");
+
+        std::vector<std::string_view> Path = { "Health" };
+        TypeRef Key("Entity");
+        Key.MemberPath = ArenaArray<std::string_view>(Path.data(), Path.size());
+        const TypeRef* EntityHealth = Context.GetTypes().Get(Key);
+
+        // Interface IDamageable : IEntity { Public: TakeDamage(Amount: Int_32) -> Void; }
+        auto* TakeDamage = Context.Create<FunctionDeclaration>(EAccessModifier::PUBLIC, Context.Intern("TakeDamage"), Void);
+        std::vector<Parameter> DamageParams = { Parameter(Context.Intern("Amount"), Int) };
+        TakeDamage->Parameters = Context.CreateArray(DamageParams);
+
+        auto* Damageable = Context.Create<InterfaceDeclaration>(Context.Intern("IDamageable"));
+        std::vector<const TypeRef*> InterfaceBases = { Context.GetType("IEntity") };
+        std::vector<FunctionDeclaration*> Signatures = { TakeDamage };
+        Damageable->BaseInterfaces = Context.CreateArray(InterfaceBases);
+        Damageable->Methods = Context.CreateArray(Signatures);
+
+        // @SoA Define Entity : Base, IDamageable { ... }
+        auto* Health = Context.Create<FieldDeclaration>(EAccessModifier::PUBLIC, Context.Intern("Health"), Int,
+                                                        Context.Create<IntegerLiteral>(100));
+        auto* MaxHealth = Context.Create<FieldDeclaration>(EAccessModifier::PRIVATE, Context.Intern("MaxHealth"), Int);
+        MaxHealth->IsStatic = true;
+        MaxHealth->IsConst = true;
+
+        Parameter Scale(Context.Intern("Scale"), Float);
+        Scale.DefaultValue = Context.Create<FloatLiteral>(1.5);
+        auto* Update = BuildMethod(
+            Context, "Update", Void,
+            { Context.Create<ExpressionStatement>(Call(Context, "Damage", Context.Create<BinaryExpression>(
+                Context.Create<Identifier>(Context.Intern("Delta")), EBinaryOp::Multiply,
+                Context.Create<Identifier>(Context.Intern("Scale"))))) },
+            { Parameter(Context.Intern("Delta"), Float), Scale });
+        Update->Access = EAccessModifier::PUBLIC;
+        Update->IsVirtual = true;
+        Update->IsOverride = true;
+
+        auto* Entity = Context.Create<DefineDeclaration>(Context.Intern("Entity"));
+        std::vector<const TypeRef*> Bases = { Context.GetType("Base"), Context.GetType("IDamageable") };
+        std::vector<std::string_view> Attributes = { Context.Intern("SoA") };
+        std::vector<FieldDeclaration*> Fields = { Health, MaxHealth };
+        std::vector<FunctionDeclaration*> Methods = { Update };
+        Entity->BaseTypes = Context.CreateArray(Bases);
+        Entity->Attributes = Context.CreateArray(Attributes);
+        Entity->Fields = Context.CreateArray(Fields);
+        Entity->Methods = Context.CreateArray(Methods);
+
+        // Fetch Entity { Fetch_Health() -> Entity.Health { return Entity.Health; } }
+        auto* Fetch = Context.Create<FetchDeclaration>(Context.Intern("Entity"));
+        std::vector<FunctionDeclaration*> Getters = { BuildMethod(
+            Context, "Fetch_Health", EntityHealth,
+            { Context.Create<ReturnStatement>(Context.Create<MemberAccess>(
+                Context.Create<Identifier>(Context.Intern("Entity")), Context.Intern("Health"))) }) };
+        Fetch->Methods = Context.CreateArray(Getters);
+
+        // Set Entity { Set_Health(Value: Int_32) { Store(Value); } }
+        auto* Set = Context.Create<SetDeclaration>(Context.Intern("Entity"));
+        std::vector<FunctionDeclaration*> Setters = { BuildMethod(
+            Context, "Set_Health", nullptr,
+            { Context.Create<ExpressionStatement>(Call(Context, "Store", Context.Create<Identifier>(Context.Intern("Value")))) },
+            { Parameter(Context.Intern("Value"), Int) }) };
+        Set->Methods = Context.CreateArray(Setters);
+
+        // Static Operator +(Other: Entity) -> Entity { return Other; }
+        auto* Plus = BuildMethod(Context, "+", Context.GetType("Entity"),
+                                 { Context.Create<ReturnStatement>(Context.Create<Identifier>(Context.Intern("Other"))) },
+                                 { Parameter(Context.Intern("Other"), Context.GetType("Entity")) });
+        Plus->IsStatic = true;
+        Plus->IsOperator = true;
+
+        auto* Game = Context.Create<NamespaceDeclaration>(Context.Intern("Game"));
+        std::vector<Declaration*> GameDeclarations = { Damageable, Entity, Fetch, Set, Plus };
+        Game->Declarations = Context.CreateArray(GameDeclarations);
+
+        auto* Gravity = Context.Create<GlobalDeclaration>(Context.Create<VariableDeclaration>(
+            true, false, Context.Intern("Gravity"), Float, Context.Create<FloatLiteral>(9.5)));
+
+        auto* Unit = Context.Create<TranslationUnit>(Context.Intern("Game.vex"));
+        std::vector<Declaration*> Declarations = {
+            Context.Create<UsingDeclaration>(Context.Intern("Engine::Math")), Gravity, Game,
+        };
+        Unit->Declarations = Context.CreateArray(Declarations);
+        return Unit;
+    }
+
+    /** Module image in 8-byte aligned memory, as Load() requires */
+    std::vector<uint64_t> ToImage(const std::string& Bytes) {
+        std::vector<uint64_t> Image((Bytes.size() + 7) / 8);
+        std::memcpy(Image.data(), Bytes.data(), Bytes.size());
+        return Image;
+    }
+}
+
+void Test_AST_006_Modules() {
+    std::cout << "--- AST Test 006: Declarations and Modules ---" << "\n";
+
+    ASTContext Context;
+    TranslationUnit* Unit = BuildUnit(Context);
+
+    const std::string Text = Unit->ToString();
+    std::cout << Text << "\n";
+
+    assert(Text.find("Using Engine::Math;\nglobal ") == 0);
+    assert(Text.find("global Const Gravity: Float = 9.5;") != std::string::npos);
+    assert(Text.find("Interface IDamageable : IEntity { Public: TakeDamage(Amount: Int_32) -> Void; }") != std::string::npos);
+    assert(Text.find("@SoA Define Entity : Base, IDamageable { Public: Health -> Int_32 = 100; "
+                     "Private: Static Const MaxHealth -> Int_32; "
+                     "Public: Virtual Override Update(Delta: Float, Scale: Float = 1.5) -> Void {") != std::string::npos);
+    assert(Text.find("Fetch Entity { Fetch_Health() -> Entity.Health { return Entity.Health; } }") != std::string::npos);
+    assert(Text.find("Set Entity { Set_Health(Value: Int_32) { Store(Value); } }") != std::string::npos);
+    assert(Text.find("Static Operator +(Other: Entity) -> Entity { return Other; }") != std::string::npos);
+
+    // Declarations are ordinary nodes for every traversal
+    assert(Unit->Declarations[2]->IsDeclaration() && !Unit->IsDeclaration());
+    size_t Walked = 0;
+    WalkTree(Unit, [&](ASTNode&) { ++Walked; return true; });
+
+    FlatAST Flat;
+    const NodeIndex Root = Flat.Append(Unit);
+    assert(Walked == Flat.Size());
+    assert(Flat.ToString(Root) == Text);
+
+    const auto Counts = Flat.CountKinds(Root);
+    assert(Counts[static_cast<size_t>(ENodeKind::FunctionDeclaration)] == 5);
+    assert(Counts[static_cast<size_t>(ENodeKind::FieldDeclaration)] == 2);
+
+    // Rebuilt trees print and hash the same, with canonical types of the new context
+    {
+        ASTContext Copy;
+        auto* Rebuilt = static_cast<TranslationUnit*>(Flat.ToTree(Root, Copy));
+        assert(Rebuilt->ToString() == Text);
+
+        auto* Entity = static_cast<NamespaceDeclaration*>(Rebuilt->Declarations[2])->Declarations[1]->As<DefineDeclaration>();
+        assert(Entity != nullptr && Entity->Fields[0]->Type == Copy.GetType("Int_32"));
+
+        FlatAST Again;
+        assert(Again.Hash(Again.Append(Rebuilt)) == Flat.Hash(Root));
+    }
+
+    // Round trip through a file, read in place
+    const std::string Path = (std::filesystem::temp_directory_path() / "Test.AST.006.vexm").string();
+    assert(ModuleWriter::WriteFile(Flat, Path));
+
+    {
+        ModuleFile Module;
+        assert(Module.Open(Path));
+        assert(Module.Size() == Flat.Size());
+        assert(Module.GetRoots().size() == 1);
+
+        const NodeIndex ModuleRoot = Module.GetRoots()[0];
+        assert(Module.ToString(ModuleRoot) == Text);
+        assert(Module.Hash(ModuleRoot) == Flat.Hash(Root));
+        assert(Module.CountKinds(ModuleRoot) == Counts);
+        assert(Module.GetLocation(ModuleRoot).Line == Flat.GetLocation(Root).Line);
+
+        // Exported symbols, qualified and sorted
+        assert(Module.GetSymbolCount() == 4);
+        assert(Module.GetSymbolName(Module.GetSymbol(0)) == "Game::+");
+        assert(Module.GetKind(Module.FindSymbol("Gravity")) == ENodeKind::GlobalDeclaration);
+        assert(Module.GetKind(Module.FindSymbol("Game::IDamageable")) == ENodeKind::InterfaceDeclaration);
+        assert(Module.FindSymbol("Game::Fetch_Health") == InvalidNode);
+        assert(Module.FindSymbol("Entity") == InvalidNode);
+
+        // Only the imported declaration is turned back into pointers
+        const NodeIndex EntityIndex = Module.FindSymbol("Game::Entity");
+        assert(EntityIndex != InvalidNode);
+
+        ASTContext Importer;
+        auto* Entity = static_cast<DefineDeclaration*>(Module.ToTree(EntityIndex, Importer));
+        assert(Entity->Is<DefineDeclaration>() && Entity->Methods[0]->IsVirtual);
+        assert(Entity->Methods[0]->Parameters[1].DefaultValue->ToString() == "1.5");
+        assert(Text.find(Entity->ToString()) != std::string::npos);
+    }
+
+    std::remove(Path.c_str());
+
+    // Same bytes through a stream and an in-memory image
+    std::stringstream Stream;
+    assert(ModuleWriter::Write(Flat, Stream));
+    const std::string Bytes = Stream.str();
+    assert(Bytes.size() % 8 == 0);
+
+    {
+        std::vector<uint64_t> Image = ToImage(Bytes);
+        ModuleFile Module;
+        assert(Module.Load(Image.data(), Bytes.size()));
+        assert(Module.ToString(Module.GetRoots()[0]) == Text);
+    }
+
+    // Damaged or foreign files are rejected
+    {
+        ModuleFile Module;
+        assert(!Module.Open("Missing.vexm"));
+
+        std::vector<uint64_t> Image = ToImage(Bytes);
+        reinterpret_cast<ModuleHeader*>(Image.data())->Version = ModuleVersion + 1;
+        assert(!Module.Load(Image.data(), Bytes.size()));
+        assert(Module.GetError().find("version") != std::string::npos);
+        assert(!Module.IsOpen());
+
+        Image = ToImage(Bytes);
+        assert(!Module.Load(Image.data(), Bytes.size() - 8));
+
+        reinterpret_cast<char*>(Image.data())[0] = 'X';
+        assert(!Module.Load(Image.data(), Bytes.size()));
+    }
+
+    // Moving a FlatAST keeps its view valid
+    FlatAST Moved = std::move(Flat);
+    assert(Moved.ToString(Root) == Text);
+    assert(Flat.Size() == 0);
+
+    std::cout << "AST Test 006: Passed\n\n";
+}
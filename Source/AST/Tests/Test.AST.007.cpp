@@ -0,0 +1,186 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../ASTContext.h"
+#include "../Declaration.h"
+#include "../FlatAST.h"
+#include "../StructuralHash.h"
+#include "../TreeWalker.h"
+
+using namespace Vex;
+
+namespace {
+    /**
+     * Scale(Value: Float) -> Float {
+     *     Let Result: Float = Value * Factor;
+     *     if Result > Limit { return Limit; }
+     *     return Result;
+     * }
+     */
+    FunctionDeclaration* BuildScale(ASTContext& Context, const char* Factor, const int Line = 1) {
+        const TypeRef* Float = Context.GetType("Float");
+        const auto Name = [&Context](const char* Text) { return Context.Create<Identifier>(Context.Intern(Text)); };
+
+        auto* Result = Context.Create<VariableDeclaration>(false, true, Context.Intern("Result"), Float,
+                                                          Context.Create<BinaryExpression>(Name("Value"), EBinaryOp::Multiply, Name(Factor)));
+        auto* Clamp = Context.Create<IfStatement>(
+            Context.Create<BinaryExpression>(Name("Result"), EBinaryOp::Greater, Name("Limit")),
+            Context.Create<ReturnStatement>(Name("Limit")));
+
+        auto* Body = Context.Create<BlockStatement>();
+        std::vector<Statement*> Statements = { Result, Clamp, Context.Create<ReturnStatement>(Name("Result")) };
+        Body->Statements = Context.CreateArray(Statements);
+
+        auto* Function = Context.Create<FunctionDeclaration>(EAccessModifier::PUBLIC, Context.Intern("Scale"), Float, Body);
+        std::vector<Parameter> Parameters = { Parameter(Context.Intern("Value"), Float) };
+        Function->Parameters = Context.CreateArray(Parameters);
+
+        // Positions must not matter
+        int Column = 1;
+        WalkTree(Function, [&](ASTNode& Node) { Node.Location = { Line, Column++ }; return true; });
+        return Function;
+    }
+
+    size_t CountNodes(ASTNode* Root) {
+        size_t Count = 0;
+        WalkTree(Root, [&](ASTNode&) { ++Count; return true; });
+        return Count;
+    }
+
+    size_t CountCached(ASTNode* Root) {
+        size_t Count = 0;
+        WalkTree(Root, [&](ASTNode& Node) { Count += Node.HasCachedHash ? 1 : 0; return true; });
+        return Count;
+    }
+}
+
+void Test_AST_007_StructuralHashing() {
+    std::cout << "--- AST Test 007: Structural Hashing ---" << "\n";
+
+    ASTContext Context;
+    ASTContext OtherContext;
+    FunctionDeclaration* Scale = BuildScale(Context, "Factor");
+
+    // Same structure built elsewhere: other arena, other TypeRefs, other positions
+    {
+        FunctionDeclaration* Copy = BuildScale(OtherContext, "Factor", 40);
+
+        assert(StructuralHash(Scale) == StructuralHash(Copy));
+        assert(StructurallyEqual(Scale, Copy));
+        assert(StructurallyEqual(Scale, Scale));
+        assert(StructurallyEqual(Scale->Body->Statements[0], Copy->Body->Statements[0]));
+
+        // Stable across runs and platforms: usable as a persistent cache key
+        assert(StructuralHash(Scale) == 0xAA76CBB9133E5C3Dull);
+
+        // The pointer tree and its flattened form agree
+        FlatAST Flat;
+        const NodeIndex Root = Flat.Append(Scale);
+        assert(Flat.Hash(Root) == StructuralHash(Scale));
+        assert(Flat.Hash(Flat.GetChild(Root, 1)) == StructuralHash(Scale->Body));
+
+        std::cout << "  ✓ Equal trees hash alike, independent of context and location" << "\n";
+    }
+
+    // Any difference in kind, operator, name, literal or type changes the hash
+    {
+        FunctionDeclaration* Renamed = BuildScale(OtherContext, "Gain");
+
+        FunctionDeclaration* Operator = BuildScale(OtherContext, "Factor");
+        static_cast<BinaryExpression*>(static_cast<VariableDeclaration*>(Operator->Body->Statements[0])->Initializer)->Op =
+            EBinaryOp::Divide;
+
+        FunctionDeclaration* Typed = BuildScale(OtherContext, "Factor");
+        Typed->ReturnType = OtherContext.GetType("Double");
+
+        FunctionDeclaration* Signature = BuildScale(OtherContext, "Factor");
+        Signature->Body = nullptr;
+
+        for (auto* Different : { Renamed, Operator, Typed, Signature }) {
+            assert(StructuralHash(Different) != StructuralHash(Scale));
+            assert(!StructurallyEqual(Scale, Different));
+        }
+
+        assert(StructuralHash(nullptr) == 0);
+        assert(StructurallyEqual(nullptr, nullptr));
+        assert(!StructurallyEqual(Scale, nullptr));
+
+        // Literals compare by value and bits
+        assert(StructurallyEqual(Context.Create<IntegerLiteral>(7), OtherContext.Create<IntegerLiteral>(7)));
+        assert(!StructurallyEqual(Context.Create<IntegerLiteral>(7), Context.Create<IntegerLiteral>(8)));
+        assert(!StructurallyEqual(Context.Create<FloatLiteral>(0.0), Context.Create<FloatLiteral>(-0.0)));
+        assert(!StructurallyEqual(Context.Create<StringLiteral>("A"), Context.Create<Identifier>("A")));
+
+        std::cout << "  ✓ Differences are detected" << "\n";
+    }
+
+    // Hashes are computed once per node and reused
+    {
+        ClearStructuralHashes(Scale);
+        const uint64_t Hash = StructuralHash(Scale);
+        assert(CountNodes(Scale) == CountCached(Scale));
+
+        // Subtrees are already cached; hashing a parent only adds the parent
+        auto* Wrapper = Context.Create<NamespaceDeclaration>(Context.Intern("Math"));
+        std::vector<Declaration*> Declarations = { Scale };
+        Wrapper->Declarations = Context.CreateArray(Declarations);
+        Scale->Body->CachedHash ^= 1;
+        StructuralHash(Wrapper);
+        assert(Wrapper->HasCachedHash);
+        assert(StructuralHash(Scale) == Hash);
+        Scale->Body->CachedHash ^= 1;
+
+        // An in-place rewrite clears the node and its ancestors
+        auto* Return = static_cast<ReturnStatement*>(Scale->Body->Statements[2]);
+        Return->Value = Context.Create<Identifier>(Context.Intern("Limit"));
+        assert(StructuralHash(Scale) == Hash);
+        for (const ASTNode* Node : { static_cast<ASTNode*>(Return), static_cast<ASTNode*>(Scale->Body),
+                                     static_cast<ASTNode*>(Scale) }) {
+            Node->HasCachedHash = false;
+        }
+
+        const uint64_t Rewritten = StructuralHash(Scale);
+        assert(Rewritten != Hash);
+        ClearStructuralHashes(Scale);
+        assert(CountCached(Scale) == 0);
+        assert(StructuralHash(Scale) == Rewritten);
+
+        Return->Value = Context.Create<Identifier>(Context.Intern("Result"));
+        ClearStructuralHashes(Scale);
+        assert(StructuralHash(Scale) == Hash);
+
+        std::cout << "  ✓ Hashes are cached per node and cleared explicitly" << "\n";
+    }
+
+    // Deduplicating generated functions: bucket by hash, confirm with Equal
+    {
+        const char* Factors[] = { "Factor", "Gain", "Factor", "Weight", "Gain", "Factor" };
+        std::vector<FunctionDeclaration*> Generated;
+        for (const char* Factor : Factors) {
+            Generated.push_back(BuildScale(OtherContext, Factor, static_cast<int>(Generated.size()) + 1));
+        }
+
+        std::unordered_map<uint64_t, std::vector<FunctionDeclaration*>> Buckets;
+        std::vector<FunctionDeclaration*> Unique;
+        for (auto* Function : Generated) {
+            auto& Bucket = Buckets[StructuralHash(Function)];
+            bool Duplicate = false;
+            for (const auto* Other : Bucket) {
+                Duplicate = Duplicate || StructurallyEqual(Function, Other);
+            }
+            if (!Duplicate) {
+                Bucket.push_back(Function);
+                Unique.push_back(Function);
+            }
+        }
+        assert(Unique.size() == 3);
+        assert(Buckets.size() == 3);
+
+        std::cout << "  ✓ Identical generated functions deduplicated" << "\n";
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <cassert>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../SymbolTable.h"
+
+using namespace Vex;
+
+namespace {
+    SymbolRef Function(const uint32_t Index) { return { ESymbolKind::Function, Index, 0 }; }
+    SymbolRef Local(const uint32_t Index) { return { ESymbolKind::Local, Index, 0 }; }
+
+    /** Index of what Name means from Namespace, or -1 */
+    int64_t Find(const SymbolTable& Symbols, const ScopeId Namespace, const char* Name) {
+        const SymbolRef* Found = Symbols.LookupPath(Namespace, Name);
+        return Found != nullptr ? static_cast<int64_t>(Found->Index) : -1;
+    }
+}
+
+void Test_AST_008_SymbolTable() {
+    std::cout << "--- AST Test 008: Symbol Table ---" << "\n";
+
+    // Names are interned once into dense ids
+    {
+        SymbolTable Symbols;
+        const SymbolId Health = Symbols.Intern("Health");
+        std::string Copy = "Health";
+        assert(Symbols.Intern(Copy) == Health);
+        Copy[0] = 'W';
+        assert(Symbols.NameOf(Health) == "Health");
+        assert(Symbols.Find("Wealth") == SymbolTable::NoSymbol);
+        assert(Symbols.Intern("Armor") == Health + 1);
+
+        for (int Index = 0; Index < 10000; ++Index) {
+            Symbols.Intern("Name" + std::to_string(Index));
+        }
+        assert(Symbols.SymbolCount() == 10002);
+        assert(Symbols.Find("Name9999") == 10001 && Symbols.Find("Health") == Health);
+
+        std::cout << "  ✓ Interning" << "\n";
+    }
+
+    // Namespaces nest, reopen, and are searched outwards
+    {
+        SymbolTable Symbols;
+        const ScopeId Math = Symbols.OpenNamespace(SymbolTable::GlobalScope, "Engine::Math");
+        const ScopeId Engine = Symbols.ParentOf(Math);
+        assert(Symbols.QualifiedName(Math) == "Engine::Math" && Symbols.QualifiedName(Engine) == "Engine");
+        assert(Symbols.OpenNamespace(Engine, "Math") == Math);
+
+        assert(Symbols.Declare(Math, Symbols.Intern("Dot"), Function(1)));
+        assert(!Symbols.Declare(Math, Symbols.Intern("Dot"), Function(2)));
+        assert(Symbols.Declare(Engine, Symbols.Intern("Tick"), Function(3)));
+        assert(Symbols.Declare(SymbolTable::GlobalScope, Symbols.Intern("Main"), Function(4)));
+        assert(Symbols.Declare(SymbolTable::GlobalScope, Symbols.Intern("Dot"), Function(5)));
+
+        assert(Find(Symbols, SymbolTable::GlobalScope, "Engine::Math::Dot") == 1);
+        assert(Find(Symbols, SymbolTable::GlobalScope, "Dot") == 5);
+        assert(Find(Symbols, Math, "Dot") == 1);
+        assert(Find(Symbols, Math, "Tick") == 3 && Find(Symbols, Math, "Main") == 4);
+        assert(Find(Symbols, Engine, "Math::Dot") == 1);
+        assert(Find(Symbols, Math, "Math::Dot") == 1);
+
+        // Missing segments, and segments that are not namespaces
+        assert(Find(Symbols, SymbolTable::GlobalScope, "Math::Dot") == -1);
+        assert(Find(Symbols, SymbolTable::GlobalScope, "Engine::Physics::Dot") == -1);
+        assert(Find(Symbols, SymbolTable::GlobalScope, "Main::Dot") == -1);
+        assert(Find(Symbols, SymbolTable::GlobalScope, "Engine::Math::Cross") == -1);
+        assert(Symbols.OpenNamespace(SymbolTable::GlobalScope, "Main::Inner") == SymbolTable::NoScope);
+
+        std::cout << "  ✓ Namespaces" << "\n";
+    }
+
+    // Using imports a namespace's members; the importing scope and its own declarations win
+    {
+        SymbolTable Symbols;
+        const ScopeId Math = Symbols.OpenNamespace(SymbolTable::GlobalScope, "Math");
+        const ScopeId Physics = Symbols.OpenNamespace(SymbolTable::GlobalScope, "Physics");
+        const ScopeId Game = Symbols.OpenNamespace(SymbolTable::GlobalScope, "Game");
+        Symbols.Declare(Math, Symbols.Intern("Dot"), Function(1));
+        Symbols.Declare(Math, Symbols.Intern("Cross"), Function(2));
+        Symbols.Declare(Physics, Symbols.Intern("Dot"), Function(3));
+        Symbols.Declare(Game, Symbols.Intern("Cross"), Function(4));
+
+        assert(Find(Symbols, Game, "Dot") == -1);
+        Symbols.AddUsing(Game, Math);
+        Symbols.AddUsing(Game, Physics);
+        Symbols.AddUsing(Game, Math);
+        assert(Find(Symbols, Game, "Dot") == 1);
+        assert(Find(Symbols, Game, "Cross") == 4);
+        assert(Find(Symbols, SymbolTable::GlobalScope, "Dot") == -1);
+
+        // Nested namespaces see their parent's imports
+        const ScopeId Levels = Symbols.OpenNamespace(Game, "Levels");
+        assert(Find(Symbols, Levels, "Dot") == 1);
+
+        std::cout << "  ✓ Using" << "\n";
+    }
+
+    // Blocks shadow outer names and are undone when they close
+    {
+        SymbolTable Symbols;
+        const ScopeId Math = Symbols.OpenNamespace(SymbolTable::GlobalScope, "Math");
+        const SymbolId X = Symbols.Intern("X");
+        const SymbolId Y = Symbols.Intern("Y");
+        Symbols.Declare(Math, X, Function(9));
+        const size_t Declared = Symbols.Size();
+
+        Symbols.PushScope();
+        assert(Symbols.DeclareLocal(X, Local(0)));
+        assert(!Symbols.DeclareLocal(X, Local(1)));
+        assert(Symbols.Lookup(Math, X)->Index == 0);
+        assert(Symbols.Lookup(Math, X, false)->Kind == ESymbolKind::Function);
+
+        Symbols.PushScope();
+        assert(Symbols.Lookup(Math, X)->Index == 0);
+        assert(Symbols.DeclareLocal(X, Local(2)) && Symbols.DeclareLocal(Y, Local(3)));
+        assert(Symbols.Lookup(Math, X)->Index == 2 && Symbols.Lookup(Math, Y)->Index == 3);
+        assert(Symbols.OpenScopes() == 2);
+        Symbols.PopScope();
+
+        assert(Symbols.Lookup(Math, X)->Index == 0);
+        assert(Symbols.Lookup(Math, Y) == nullptr);
+        Symbols.PopScope();
+
+        assert(Symbols.Lookup(Math, X)->Kind == ESymbolKind::Function);
+        assert(Symbols.Lookup(SymbolTable::GlobalScope, X) == nullptr);
+        assert(Symbols.Size() == Declared && Symbols.OpenScopes() == 0);
+        assert(!Symbols.DeclareLocal(X, Local(0)));
+
+        std::cout << "  ✓ Block scopes" << "\n";
+    }
+
+    // The flat table stays consistent through growth and many push/pop cycles
+    {
+        SymbolTable Symbols;
+        std::map<std::pair<ScopeId, std::string>, uint32_t> Expected;
+        std::vector<ScopeId> Namespaces;
+        for (int Space = 0; Space < 50; ++Space) {
+            Namespaces.push_back(Symbols.OpenNamespace(SymbolTable::GlobalScope, "N" + std::to_string(Space)));
+        }
+        for (uint32_t Index = 0; Index < 20000; ++Index) {
+            const ScopeId Scope = Namespaces[Index % Namespaces.size()];
+            const std::string Name = "S" + std::to_string(Index / 7);
+            if (Symbols.Declare(Scope, Symbols.Intern(Name), Function(Index))) {
+                Expected.emplace(std::make_pair(Scope, Name), Index);
+            }
+        }
+
+        for (int Round = 0; Round < 200; ++Round) {
+            Symbols.PushScope();
+            for (int Index = 0; Index < 40; ++Index) {
+                Symbols.DeclareLocal(Symbols.Intern("S" + std::to_string(Round * 13 + Index)), Local(Index));
+                if (Index % 10 == 0) {
+                    Symbols.PushScope();
+                    Symbols.DeclareLocal(Symbols.Intern("S" + std::to_string(Index)), Local(Index));
+                }
+            }
+            while (Symbols.OpenScopes() > 0) {
+                Symbols.PopScope();
+            }
+        }
+
+        assert(Symbols.Size() == Expected.size() + Namespaces.size());
+        for (const auto& [Key, Index] : Expected) {
+            const SymbolRef* Found = Symbols.FindIn(Key.first, Symbols.Find(Key.second));
+            assert(Found != nullptr && Found->Index == Index);
+        }
+
+        std::cout << "  ✓ Growth and undo" << "\n";
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "StaticVisitor.h"
+
+namespace Vex {
+
+    /**
+     * Depth-first walk over the subtree of Root using an explicit stack
+     *
+     * Enter(ASTNode&) runs before a node's children and returns false to
+     * skip them; Leave(ASTNode&) runs after them (and after a skipped
+     * node). Children are visited in source order. The native stack does
+     * not grow with tree depth, so this is safe for arbitrarily deep trees
+     * where a recursive StaticVisitor or ASTVisitor could overflow.
+     *
+     * Example:
+     *   size_t Count = 0;
+     *   WalkTree(Root, [&](ASTNode&) { ++Count; return true; }, [](ASTNode&) {});
+     */
+    template<typename EnterType, typename LeaveType>
+    void WalkTree(ASTNode* Root, EnterType&& Enter, LeaveType&& Leave) {
+        if (Root == nullptr) {
+            return;
+        }
+
+        struct Frame {
+            ASTNode* Node;
+            bool     Entered;
+        };
+
+        std::vector<Frame> Stack;
+        Stack.push_back({ Root, false });
+
+        while (!Stack.empty()) {
+            ASTNode* Node = Stack.back().Node;
+
+            if (Stack.back().Entered) {
+                Stack.pop_back();
+                Leave(*Node);
+                continue;
+            }
+
+            Stack.back().Entered = true;
+            if (!Enter(*Node)) {
+                continue;
+            }
+
+            // Reverse the pushed children so the first one is on top
+            const size_t First = Stack.size();
+            ForEachChild(*Node, [&Stack](ASTNode* Child) { Stack.push_back({ Child, false }); });
+            std::reverse(Stack.begin() + static_cast<std::ptrdiff_t>(First), Stack.end());
+        }
+    }
+
+    /** Pre-order walk; Enter(ASTNode&) returns false to skip a node's children */
+    template<typename EnterType>
+    void WalkTree(ASTNode* Root, EnterType&& Enter) {
+        WalkTree(Root, std::forward<EnterType>(Enter), [](ASTNode&) {});
+    }
+}
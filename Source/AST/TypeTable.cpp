@@ -0,0 +1,79 @@
+#include "TypeTable.h"
+
+#include <algorithm>
+
+#include "ASTContext.h"
+#include "Hashing.h"
+
+namespace Vex {
+    size_t TypeTable::ContentHash::operator()(const TypeRef* Type) const {
+        uint64_t Hash = HashBytes(Type->Name);
+        Hash = HashCombine(Hash, (Type->IsPointer ? 1 : 0) | (Type->IsUnique ? 2 : 0) |
+                                 (Type->IsShared ? 4 : 0) | (Type->IsBorrow ? 8 : 0) | (Type->IsArray ? 16 : 0));
+
+        Hash = HashCombine(Hash, Type->MemberPath.size());
+        for (const auto& Member : Type->MemberPath) {
+            Hash = HashCombine(Hash, HashBytes(Member));
+        }
+
+        Hash = HashCombine(Hash, Type->AllowedFields.size());
+        for (const auto& Field : Type->AllowedFields) {
+            Hash = HashCombine(Hash, HashBytes(Field));
+        }
+
+        return static_cast<size_t>(Hash);
+    }
+
+    bool TypeTable::ContentEqual::operator()(const TypeRef* Left, const TypeRef* Right) const {
+        return Left->Name == Right->Name &&
+               Left->IsPointer == Right->IsPointer &&
+               Left->IsUnique == Right->IsUnique &&
+               Left->IsShared == Right->IsShared &&
+               Left->IsBorrow == Right->IsBorrow &&
+               Left->IsArray == Right->IsArray &&
+               std::equal(Left->MemberPath.begin(), Left->MemberPath.end(),
+                          Right->MemberPath.begin(), Right->MemberPath.end()) &&
+               std::equal(Left->AllowedFields.begin(), Left->AllowedFields.end(),
+                          Right->AllowedFields.begin(), Right->AllowedFields.end());
+    }
+
+    const TypeRef* TypeTable::Get(const std::string_view Name) {
+        return Get(TypeRef(Name));
+    }
+
+    const TypeRef* TypeTable::Get(const TypeRef& Type) {
+        if (const auto IT = Lookup.find(&Type); IT != Lookup.end()) {
+            return *IT;
+        }
+
+        // First occurrence: copy everything into the context
+        auto* Canonical = Context.Create<TypeRef>(Context.Intern(Type.Name));
+        Canonical->IsPointer = Type.IsPointer;
+        Canonical->IsUnique  = Type.IsUnique;
+        Canonical->IsShared  = Type.IsShared;
+        Canonical->IsBorrow  = Type.IsBorrow;
+        Canonical->IsArray   = Type.IsArray;
+        Canonical->Id        = static_cast<uint32_t>(Types.size());
+
+        std::vector<std::string_view> Names;
+        for (const auto& Member : Type.MemberPath) {
+            Names.push_back(Context.Intern(Member));
+        }
+        Canonical->MemberPath = Context.CreateArray(Names);
+
+        Names.clear();
+        for (const auto& Field : Type.AllowedFields) {
+            Names.push_back(Context.Intern(Field));
+        }
+        Canonical->AllowedFields = Context.CreateArray(Names);
+
+        Types.push_back(Canonical);
+        Lookup.insert(Canonical);
+        return Canonical;
+    }
+
+    void TypeTable::Clear() {
+        Types.clear();
+        Lookup.clear();
+    }
+}
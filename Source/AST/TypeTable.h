@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "ASTNode.h"
+
+namespace Vex {
+    class ASTContext;
+
+    /**
+     * Hash-consed store of canonical type references
+     *
+     * Every distinct type (name, qualifiers, member path and allowed
+     * fields) is stored once in the owning context. Asking for an equal
+     * type again returns the same object, so two canonical types are equal
+     * exactly when their pointers (or Ids) are equal, and type memory grows
+     * with the number of distinct types rather than with the number of
+     * annotations.
+     *
+     * Example:
+     *   const TypeRef* A = Context.GetTypes().Get("Int_32");
+     *
+     *   TypeRef Key(Context.Intern("Int_32"));
+     *   Key.IsShared = true;
+     *   const TypeRef* B = Context.GetTypes().Get(Key);     // "Shared Int_32"
+     *
+     *   assert(A == Context.GetTypes().Get("Int_32"));
+     *   assert(A != B);
+     */
+    class TypeTable {
+    public:
+        explicit TypeTable(ASTContext& Context) : Context(Context) {}
+
+        TypeTable(const TypeTable&) = delete;
+        TypeTable& operator=(const TypeTable&) = delete;
+
+        /** Canonical unqualified type called Name */
+        const TypeRef* Get(std::string_view Name);
+
+        /**
+         * Canonical type equal to Type. Type may be a temporary whose
+         * strings and arrays live anywhere; they are copied on first use.
+         */
+        const TypeRef* Get(const TypeRef& Type);
+
+        [[nodiscard]] const TypeRef* GetById(const uint32_t Id) const { return Types[Id]; }
+        [[nodiscard]] size_t Size() const { return Types.size(); }
+
+        /** Forgets every type; the TypeRefs themselves stay in the arena */
+        void Clear();
+
+    private:
+        struct ContentHash {
+            size_t operator()(const TypeRef* Type) const;
+        };
+
+        struct ContentEqual {
+            bool operator()(const TypeRef* Left, const TypeRef* Right) const;
+        };
+
+        ASTContext& Context;
+        std::vector<const TypeRef*> Types;                                      // Indexed by Id
+        std::unordered_set<const TypeRef*, ContentHash, ContentEqual> Lookup;
+    };
+}
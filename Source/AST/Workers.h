@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace Vex {
+
+    /** Threads == 0 means one per hardware thread */
+    inline unsigned WorkerCount(const unsigned Threads) {
+        return Threads != 0 ? Threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * Runs Work(Worker) on Count threads, one of them the caller's, and
+     * returns when all are done. Workers usually claim items from a shared
+     * atomic cursor, so a worker that finishes early takes over what the
+     * others have not started.
+     *
+     * Targets calling this link Threads::Threads.
+     */
+    template<typename WorkType>
+    void RunOnWorkers(const unsigned Count, WorkType&& Work) {
+        std::vector<std::thread> Threads;
+        Threads.reserve(Count > 0 ? Count - 1 : 0);
+        for (unsigned Worker = 1; Worker < Count; ++Worker) {
+            Threads.emplace_back([&Work, Worker] { Work(Worker); });
+        }
+
+        Work(0);
+        for (auto& Thread : Threads) {
+            Thread.join();
+        }
+    }
+}
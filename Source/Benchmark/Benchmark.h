@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace Vex::Benchmark {
+
+    /**
+     * Wall-clock stopwatch for the benchmark executables
+     */
+    class Stopwatch {
+    public:
+        Stopwatch() : Start(Clock::now()) {}
+
+        void Restart() { Start = Clock::now(); }
+
+        [[nodiscard]] double ElapsedMilliseconds() const {
+            return std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point Start;
+    };
+
+    /**
+     * Current resident set size in bytes, or 0 where it cannot be queried
+     */
+    inline size_t GetResidentBytes() {
+#if defined(__linux__)
+        size_t Pages = 0;
+        size_t Resident = 0;
+
+        if (FILE* File = std::fopen("/proc/self/statm", "r")) {
+            if (std::fscanf(File, "%zu %zu", &Pages, &Resident) != 2) {
+                Resident = 0;
+            }
+            std::fclose(File);
+        }
+
+        return Resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * Keeps the optimizer from discarding a computed value
+     */
+    template<typename T>
+    inline void DoNotOptimize(const T& Value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&Value) : "memory");
+#else
+        static volatile const void* Sink;
+        Sink = &Value;
+#endif
+    }
+
+    inline void PrintHeader(const std::string& Title) {
+        std::cout << "--- " << Title << " ---" << "\n";
+    }
+
+    inline void PrintRow(const std::string& Label, const double Value, const std::string& Unit) {
+        std::cout << "  " << std::left << std::setw(36) << Label
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(2) << Value
+                  << " " << Unit << "\n";
+    }
+}
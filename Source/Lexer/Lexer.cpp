@@ -1,10 +1,18 @@
 #include "Lexer.h"
 
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
 #include <utility>
 
 namespace Vex {
     Lexer::Lexer(std::string  Source) : Source(std::move(Source)) {}
 
+    Lexer::Lexer(std::string Source, const int Line, const int Column)
+        : Source(std::move(Source))
+        , Line(Line)
+        , Column(Column) {}
+
     std::vector<Token> Lexer::Tokenize() {
         std::vector<Token> Tokens;
 
@@ -32,6 +40,37 @@ namespace Vex {
         return ScanToken();
     }
 
+    bool Lexer::SkipBlock() {
+        int Depth = 1;
+
+        while (true) {
+            SkipWhitespace();
+            if (IsAtEnd()) {
+                return false;
+            }
+
+            Start = Current;
+            switch (Advance()) {
+                case '{':
+                    ++Depth;
+                    break;
+                case '}':
+                    if (--Depth == 0) {
+                        return true;
+                    }
+                    break;
+                case '"':
+                    static_cast<void>(String());
+                    break;
+                case '\'':
+                    static_cast<void>(Character());
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
     bool Lexer::IsAtEnd() const {
         return Current >= Source.length();
     }
@@ -270,12 +309,20 @@ namespace Vex {
             }
 
             Token T = MakeToken(ETokenType::FLOAT_LITERAL);
-            T.FloatValue = std::stod(T.Lexeme);
+            errno = 0;
+            T.FloatValue = std::strtod(T.Lexeme.c_str(), nullptr);
+            if (errno == ERANGE && T.FloatValue == HUGE_VAL) {
+                return ErrorToken("Float literal out of range");
+            }
             return T;
         }
 
         Token T = MakeToken(ETokenType::INTEGER_LITERAL);
-        T.IntValue = std::stoll(T.Lexeme);
+        errno = 0;
+        T.IntValue = std::strtoll(T.Lexeme.c_str(), nullptr, 10);
+        if (errno == ERANGE) {
+            return ErrorToken("Integer literal out of range");
+        }
         return T;
     }
 
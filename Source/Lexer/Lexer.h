@@ -11,10 +11,31 @@ namespace Vex {
     public:
         explicit Lexer(std::string  Source);
 
+        /** Lexes a slice of a larger file that begins at the given line and column */
+        Lexer(std::string Source, int Line, int Column);
+
         std::vector<Token> Tokenize();
         Token NextToken();
         [[nodiscard]] bool IsAtEnd() const;
 
+        /** Byte offset just past the last scanned token */
+        [[nodiscard]] size_t GetOffset() const { return Current; }
+
+        /** Byte offset where the last scanned token began (stale after END_OF_FILE) */
+        [[nodiscard]] size_t GetTokenOffset() const { return Start; }
+
+        /** Position just past the last scanned token, as the next token's location would count it */
+        [[nodiscard]] int GetLine() const { return Line; }
+        [[nodiscard]] int GetColumn() const { return Column; }
+
+        /**
+         * Skips past the '}' that matches a '{' just returned by NextToken(),
+         * without building tokens. Strings, characters and comments are
+         * scanned as usual, so braces inside them do not count and line and
+         * column stay exact. Returns false if the input ends first.
+         */
+        bool SkipBlock();
+
     private:
         std::string Source;
         size_t      Start   = 0;
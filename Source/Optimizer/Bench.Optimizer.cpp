@@ -0,0 +1,21 @@
+#include <iostream>
+
+// Forward declarations of all benchmark functions
+void Bench_Optimizer_001_ConstantFolding();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX OPTIMIZER BENCHMARKS" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Bench_Optimizer_001_ConstantFolding();
+
+        std::cout << "\n";
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Benchmark failed with exception: " << E.what() << "\n";
+        return 1;
+    }
+}
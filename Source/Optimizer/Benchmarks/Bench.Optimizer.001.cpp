@@ -0,0 +1,76 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../ConstantFolder.h"
+#include "Parser.h"
+#include "TreeWalker.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int TableCount = 4000;
+
+    /** Generated gameplay tables: tuning constants and the code that reads them */
+    std::string Generate() {
+        std::string Source = "global Const TicksPerSecond: Int = 60;\n"
+                             "global Const TicksPerHour: Int = TicksPerSecond * 60 ** 2;\n";
+
+        for (int Index = 0; Index < TableCount; ++Index) {
+            const std::string Name = "Wave" + std::to_string(Index);
+            const std::string Level = std::to_string(Index % 50 + 1);
+            Source += "Define " + Name + " {\n"
+                      "    Public:\n"
+                      "        Spawn(Elapsed: Int) -> Int {\n"
+                      "            Const Level = " + Level + ";\n"
+                      "            Const Budget = 100 * Level ** 2 + (Level << 4) - 7 % 3;\n"
+                      "            Const Rate: Float = Budget / (TicksPerSecond * 1.5);\n"
+                      "            if Elapsed > TicksPerHour / 4 && Level >= 10 { return Budget * 2; }\n"
+                      "            for Tick in 0..=TicksPerSecond * 2 step 4 { Emit(Tick * Rate, Level > 25 ? 3 : 1); }\n"
+                      "            return Elapsed % (TicksPerSecond * 10) == 0 ? Budget : -(Level * 3);\n"
+                      "        }\n"
+                      "}\n";
+        }
+
+        return Source;
+    }
+
+    size_t CountNodes(ASTNode* Root) {
+        size_t Count = 0;
+        WalkTree(Root, [&Count](ASTNode&) { ++Count; return true; });
+        return Count;
+    }
+}
+
+void Bench_Optimizer_001_ConstantFolding() {
+    PrintHeader("Optimizer Benchmark 001: Constant Folding");
+
+    const std::string Source = Generate();
+    ASTContext Context;
+    Parser Parser(Source, Context);
+    TranslationUnit* Unit = Parser.ParseTranslationUnit();
+
+    Stopwatch Timer;
+    const size_t Before = CountNodes(Unit);
+    const double WalkBefore = Timer.ElapsedMilliseconds();
+    PrintRow("Nodes before", static_cast<double>(Before), "");
+
+    Timer.Restart();
+    const FoldStatistics Stats = FoldConstants(Unit, Context);
+    const double Fold = Timer.ElapsedMilliseconds();
+    PrintRow("Fold time", Fold, "ms");
+    PrintRow("  expressions folded", static_cast<double>(Stats.Folded), "");
+    PrintRow("  Const uses propagated", static_cast<double>(Stats.Propagated), "");
+
+    Timer.Restart();
+    const size_t After = CountNodes(Unit);
+    const double WalkAfter = Timer.ElapsedMilliseconds();
+    PrintRow("Nodes after", static_cast<double>(After), "");
+    PrintRow("  reduction", 100.0 * static_cast<double>(Before - After) / static_cast<double>(Before), "%");
+
+    // What every later pass pays per walk
+    PrintRow("Full walk before", WalkBefore, "ms");
+    PrintRow("Full walk after", WalkAfter, "ms");
+
+    std::cout << "\n";
+}
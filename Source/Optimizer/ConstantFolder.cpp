@@ -0,0 +1,754 @@
+#include "ConstantFolder.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "StructuralHash.h"
+#include "TreeWalker.h"
+
+namespace Vex {
+    namespace {
+        /** Value of a literal operand */
+        struct Constant {
+            enum class EKind : uint8_t { Int, Float, Bool, Char, String, Null };
+
+            EKind Kind = EKind::Null;
+            long long Int = 0;
+            double Float = 0.0;
+            bool Bool = false;
+            char Char = 0;
+            std::string_view String;
+
+            [[nodiscard]] bool IsNumber() const { return Kind == EKind::Int || Kind == EKind::Float; }
+            [[nodiscard]] double AsFloat() const { return Kind == EKind::Int ? static_cast<double>(Int) : Float; }
+
+            static Constant OfInt(const long long Value) {
+                Constant Result;
+                Result.Kind = EKind::Int;
+                Result.Int = Value;
+                return Result;
+            }
+
+            static Constant OfFloat(const double Value) {
+                Constant Result;
+                Result.Kind = EKind::Float;
+                Result.Float = Value;
+                return Result;
+            }
+
+            static Constant OfBool(const bool Value) {
+                Constant Result;
+                Result.Kind = EKind::Bool;
+                Result.Bool = Value;
+                return Result;
+            }
+        };
+
+        using EKind = Constant::EKind;
+
+        bool IsLiteral(const Expression* Expr) {
+            return Expr != nullptr && Expr->Kind >= ENodeKind::IntegerLiteral && Expr->Kind <= ENodeKind::NullLiteral;
+        }
+
+        bool ToConstant(const Expression* Expr, Constant& Out) {
+            switch (Expr->Kind) {
+                case ENodeKind::IntegerLiteral:
+                    Out = Constant::OfInt(static_cast<const IntegerLiteral*>(Expr)->Value);
+                    return true;
+                case ENodeKind::FloatLiteral:
+                    Out = Constant::OfFloat(static_cast<const FloatLiteral*>(Expr)->Value);
+                    return true;
+                case ENodeKind::BoolLiteral:
+                    Out = Constant::OfBool(static_cast<const BoolLiteral*>(Expr)->Value);
+                    return true;
+                case ENodeKind::CharLiteral:
+                    Out.Kind = EKind::Char;
+                    Out.Char = static_cast<const CharLiteral*>(Expr)->Value;
+                    return true;
+                case ENodeKind::StringLiteral:
+                    Out.Kind = EKind::String;
+                    Out.String = static_cast<const StringLiteral*>(Expr)->Value;
+                    return true;
+                case ENodeKind::NullLiteral:
+                    Out.Kind = EKind::Null;
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        Expression* ToLiteral(const Constant& Value, ASTContext& Context, const SourceLocation Location) {
+            Expression* Result = nullptr;
+            switch (Value.Kind) {
+                case EKind::Int:    Result = Context.Create<IntegerLiteral>(Value.Int); break;
+                case EKind::Float:  Result = Context.Create<FloatLiteral>(Value.Float); break;
+                case EKind::Bool:   Result = Context.Create<BoolLiteral>(Value.Bool); break;
+                case EKind::Char:   Result = Context.Create<CharLiteral>(Value.Char); break;
+                case EKind::String: Result = Context.Create<StringLiteral>(Value.String); break;
+                case EKind::Null:   Result = Context.Create<NullLiteral>(); break;
+            }
+            Result->Location = Location;
+            return Result;
+        }
+
+        // ---- Int arithmetic ----
+        // Done on uint64_t, where overflow is defined to wrap, then read back
+        // as two's complement.
+
+        long long Wrap(const uint64_t Value) { return static_cast<long long>(Value); }
+
+        bool IntPower(const long long Base, const long long Exponent, long long& Out) {
+            if (Exponent < 0) {
+                if (Base == 0) {
+                    return false;                   // 1 / 0
+                }
+                Out = Base == 1 ? 1 : Base == -1 ? (Exponent % 2 == 0 ? 1 : -1) : 0;
+                return true;
+            }
+
+            uint64_t Result = 1;
+            uint64_t Factor = static_cast<uint64_t>(Base);
+            for (auto Remaining = static_cast<uint64_t>(Exponent); Remaining != 0; Remaining >>= 1) {
+                if ((Remaining & 1) != 0) {
+                    Result *= Factor;
+                }
+                Factor *= Factor;
+            }
+            Out = Wrap(Result);
+            return true;
+        }
+
+        bool EvaluateInt(const EBinaryOp Op, const long long Left, const long long Right, long long& Out) {
+            const auto A = static_cast<uint64_t>(Left);
+            const auto B = static_cast<uint64_t>(Right);
+            constexpr long long Min = std::numeric_limits<long long>::min();
+
+            switch (Op) {
+                case EBinaryOp::Add:        Out = Wrap(A + B); return true;
+                case EBinaryOp::Subtract:   Out = Wrap(A - B); return true;
+                case EBinaryOp::Multiply:   Out = Wrap(A * B); return true;
+                case EBinaryOp::Divide:
+                    if (Right == 0) {
+                        return false;
+                    }
+                    Out = Left == Min && Right == -1 ? Min : Left / Right;
+                    return true;
+                case EBinaryOp::Modulo:
+                    if (Right == 0) {
+                        return false;
+                    }
+                    Out = Right == -1 ? 0 : Left % Right;
+                    return true;
+                case EBinaryOp::Power:      return IntPower(Left, Right, Out);
+                case EBinaryOp::BitwiseAnd: Out = Left & Right; return true;
+                case EBinaryOp::BitwiseOr:  Out = Left | Right; return true;
+                case EBinaryOp::BitwiseXor: Out = Left ^ Right; return true;
+                case EBinaryOp::LeftShift:  Out = Wrap(A << (B & 63)); return true;
+                case EBinaryOp::RightShift: Out = Left >> (B & 63); return true;
+                default:                    return false;
+            }
+        }
+
+        bool EvaluateFloat(const EBinaryOp Op, const double Left, const double Right, double& Out) {
+            switch (Op) {
+                case EBinaryOp::Add:        Out = Left + Right; break;
+                case EBinaryOp::Subtract:   Out = Left - Right; break;
+                case EBinaryOp::Multiply:   Out = Left * Right; break;
+                case EBinaryOp::Divide:     Out = Left / Right; break;
+                case EBinaryOp::Modulo:     Out = std::fmod(Left, Right); break;
+                case EBinaryOp::Power:      Out = std::pow(Left, Right); break;
+                default:                    return false;
+            }
+            return std::isfinite(Out);
+        }
+
+        /** Equality as == (or === when Strict); false when the checker has to decide */
+        bool Equals(const Constant& Left, const Constant& Right, const bool Strict, bool& Out) {
+            // The VM holds a Char as the Int of its code, so 'a' === 97
+            const auto Code = [](const Constant& Operand) {
+                return Operand.Kind == EKind::Char ? static_cast<long long>(static_cast<unsigned char>(Operand.Char)) : Operand.Int;
+            };
+            if ((Left.Kind == EKind::Char && Right.Kind == EKind::Int) || (Left.Kind == EKind::Int && Right.Kind == EKind::Char)) {
+                Out = Code(Left) == Code(Right);
+                return true;
+            }
+
+            if (Left.Kind != Right.Kind) {
+                if (Strict) {
+                    Out = false;
+                    return true;
+                }
+                if (!Left.IsNumber() || !Right.IsNumber()) {
+                    return false;
+                }
+                Out = Left.AsFloat() == Right.AsFloat();
+                return true;
+            }
+
+            switch (Left.Kind) {
+                case EKind::Int:    Out = Left.Int == Right.Int; break;
+                case EKind::Float:  Out = Left.Float == Right.Float; break;
+                case EKind::Bool:   Out = Left.Bool == Right.Bool; break;
+                case EKind::Char:   Out = Left.Char == Right.Char; break;
+                case EKind::String: Out = Left.String == Right.String; break;
+                case EKind::Null:   Out = true; break;
+            }
+            return true;
+        }
+
+        /** Sign of Left - Right for ordered operands */
+        bool Compare(const Constant& Left, const Constant& Right, int& Out) {
+            const auto Sign = [](const auto A, const auto B) { return A < B ? -1 : B < A ? 1 : 0; };
+
+            if (Left.Kind == EKind::Int && Right.Kind == EKind::Int) {
+                Out = Sign(Left.Int, Right.Int);
+            } else if (Left.IsNumber() && Right.IsNumber()) {
+                Out = Sign(Left.AsFloat(), Right.AsFloat());
+            } else if (Left.Kind == EKind::Char && Right.Kind == EKind::Char) {
+                Out = Sign(static_cast<unsigned char>(Left.Char), static_cast<unsigned char>(Right.Char));
+            } else if (Left.Kind == EKind::String && Right.Kind == EKind::String) {
+                const int Order = Left.String.compare(Right.String);
+                Out = Order < 0 ? -1 : Order > 0 ? 1 : 0;
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        bool EvaluateBinary(const EBinaryOp Op, const Constant& Left, const Constant& Right, ASTContext& Context,
+                            Constant& Out) {
+            const bool Ints = Left.Kind == EKind::Int && Right.Kind == EKind::Int;
+            const bool Bools = Left.Kind == EKind::Bool && Right.Kind == EKind::Bool;
+
+            switch (Op) {
+                case EBinaryOp::Add:
+                    if (Left.Kind == EKind::String && Right.Kind == EKind::String) {
+                        std::string Joined;
+                        Joined.reserve(Left.String.size() + Right.String.size());
+                        Joined.append(Left.String).append(Right.String);
+                        Out.Kind = EKind::String;
+                        Out.String = Context.Intern(Joined);
+                        return true;
+                    }
+                    [[fallthrough]];
+                case EBinaryOp::Subtract:
+                case EBinaryOp::Multiply:
+                case EBinaryOp::Divide:
+                case EBinaryOp::Modulo:
+                case EBinaryOp::Power:
+                    if (Ints) {
+                        Out.Kind = EKind::Int;
+                        return EvaluateInt(Op, Left.Int, Right.Int, Out.Int);
+                    }
+                    if (Left.IsNumber() && Right.IsNumber()) {
+                        Out.Kind = EKind::Float;
+                        return EvaluateFloat(Op, Left.AsFloat(), Right.AsFloat(), Out.Float);
+                    }
+                    return false;
+
+                case EBinaryOp::Equal:
+                case EBinaryOp::NotEqual:
+                case EBinaryOp::TypeValueEq:
+                case EBinaryOp::TypeValueNeq: {
+                    const bool Strict = Op == EBinaryOp::TypeValueEq || Op == EBinaryOp::TypeValueNeq;
+                    bool Same = false;
+                    if (!Equals(Left, Right, Strict, Same)) {
+                        return false;
+                    }
+                    Out = Constant::OfBool(Op == EBinaryOp::Equal || Op == EBinaryOp::TypeValueEq ? Same : !Same);
+                    return true;
+                }
+
+                case EBinaryOp::Less:
+                case EBinaryOp::Greater:
+                case EBinaryOp::LessEqual:
+                case EBinaryOp::GreaterEqual: {
+                    int Order = 0;
+                    if (!Compare(Left, Right, Order)) {
+                        return false;
+                    }
+                    switch (Op) {
+                        case EBinaryOp::Less:       Out = Constant::OfBool(Order < 0); break;
+                        case EBinaryOp::Greater:    Out = Constant::OfBool(Order > 0); break;
+                        case EBinaryOp::LessEqual:  Out = Constant::OfBool(Order <= 0); break;
+                        default:                    Out = Constant::OfBool(Order >= 0); break;
+                    }
+                    return true;
+                }
+
+                case EBinaryOp::LogicalAnd:
+                case EBinaryOp::LogicalOr:
+                    if (!Bools) {
+                        return false;
+                    }
+                    Out = Constant::OfBool(Op == EBinaryOp::LogicalAnd ? Left.Bool && Right.Bool
+                                                                       : Left.Bool || Right.Bool);
+                    return true;
+
+                case EBinaryOp::BitwiseAnd:
+                case EBinaryOp::BitwiseOr:
+                case EBinaryOp::BitwiseXor:
+                    if (Bools) {
+                        Out = Constant::OfBool(Op == EBinaryOp::BitwiseAnd ? Left.Bool && Right.Bool
+                                               : Op == EBinaryOp::BitwiseOr ? Left.Bool || Right.Bool
+                                                                            : Left.Bool != Right.Bool);
+                        return true;
+                    }
+                    [[fallthrough]];
+                case EBinaryOp::LeftShift:
+                case EBinaryOp::RightShift:
+                    if (!Ints) {
+                        return false;
+                    }
+                    Out.Kind = EKind::Int;
+                    return EvaluateInt(Op, Left.Int, Right.Int, Out.Int);
+
+                default:
+                    return false;                   // Ranges, ?? and assignments are not values here
+            }
+        }
+
+        bool EvaluateUnary(const EUnaryOp Op, const Constant& Operand, Constant& Out) {
+            switch (Op) {
+                case EUnaryOp::Plus:
+                    if (!Operand.IsNumber()) {
+                        return false;
+                    }
+                    Out = Operand;
+                    return true;
+                case EUnaryOp::Minus:
+                    if (Operand.Kind == EKind::Int) {
+                        Out = Constant::OfInt(Wrap(0 - static_cast<uint64_t>(Operand.Int)));
+                        return true;
+                    }
+                    if (Operand.Kind == EKind::Float) {
+                        Out = Constant::OfFloat(-Operand.Float);
+                        return true;
+                    }
+                    return false;
+                case EUnaryOp::LogicalNot:
+                    if (Operand.Kind != EKind::Bool) {
+                        return false;
+                    }
+                    Out = Constant::OfBool(!Operand.Bool);
+                    return true;
+                case EUnaryOp::BitwiseNot:
+                    if (Operand.Kind != EKind::Int) {
+                        return false;
+                    }
+                    Out = Constant::OfInt(~Operand.Int);
+                    return true;
+            }
+            return false;
+        }
+
+        /** True if Start..=End over Ints with the given step can be written Start..End + 1 */
+        bool CanMakeExclusive(const Expression* Start, const Expression* End, const Expression* Step) {
+            const auto* First = Start != nullptr ? Start->As<IntegerLiteral>() : nullptr;
+            const auto* Last = End != nullptr ? End->As<IntegerLiteral>() : nullptr;
+            if (First == nullptr || Last == nullptr) {
+                return false;                       // A Float iterator would see the difference
+            }
+            if (Step != nullptr) {
+                const auto* Stride = Step->As<IntegerLiteral>();
+                if (Stride == nullptr || Stride->Value <= 0) {
+                    return false;
+                }
+            }
+            return First->Value <= Last->Value && Last->Value != std::numeric_limits<long long>::max();
+        }
+
+        /**
+         * One folding run over a tree
+         *
+         * Children are folded before their parent: when the walk leaves a
+         * node, every expression below it is already final, so the node
+         * rewrites its own child slots. Names are resolved at that moment,
+         * which is also when the walk has seen exactly the declarations
+         * that precede the use.
+         */
+        class Folder {
+        public:
+            Folder(ASTContext& Context, FoldStatistics& Stats) : Context(Context), Stats(Stats) {}
+
+            /**
+             * Folds global Const initializers and makes the unique ones
+             * visible. Globals may use each other in any order, so this runs
+             * until a round resolves nothing new.
+             */
+            void CollectGlobals(ASTNode* Root) {
+                std::vector<VariableDeclaration*> Pending;
+                std::unordered_map<std::string_view, size_t> Declared;
+
+                WalkTree(Root, [&](ASTNode& Node) {
+                    if (auto* Global = Node.As<GlobalDeclaration>(); Global != nullptr && Global->Variable != nullptr) {
+                        ++Declared[Global->Variable->Name];
+                        if (Global->Variable->IsConst && Global->Variable->Initializer != nullptr) {
+                            Pending.push_back(Global->Variable);
+                        }
+                    }
+                    return Node.Is<TranslationUnit>() || Node.Is<NamespaceDeclaration>();
+                });
+
+                for (size_t Resolved = 1; Resolved != 0;) {
+                    Resolved = 0;
+                    size_t Kept = 0;
+                    for (VariableDeclaration* Variable : Pending) {
+                        Variable->Initializer = FoldTree(Variable->Initializer);
+                        if (!IsLiteral(Variable->Initializer)) {
+                            Pending[Kept++] = Variable;
+                        } else if (Declared[Variable->Name] == 1) {
+                            Globals.emplace(Variable->Name, Variable->Initializer);
+                            ++Resolved;
+                        }
+                    }
+                    Pending.resize(Kept);
+                }
+            }
+
+            void Walk(ASTNode* Root) {
+                WalkTree(Root,
+                         [this](ASTNode& Node) { Enter(Node); return true; },
+                         [this](ASTNode& Node) { Leave(Node); });
+            }
+
+            Expression* FoldTree(Expression* Root) {
+                Walk(Root);
+                return Fold(Root, true);
+            }
+
+            [[nodiscard]] bool HasChanged() const { return Stats.Folded + Stats.Propagated != Initial; }
+
+        private:
+            ASTContext& Context;
+            FoldStatistics& Stats;
+            size_t Initial = Stats.Folded + Stats.Propagated;
+
+            // Visible names, innermost last; a null value shadows an outer Const
+            std::vector<std::pair<std::string_view, const Expression*>> Bindings;
+            std::vector<size_t> Scopes;
+            std::unordered_map<std::string_view, const Expression*> Globals;
+
+            // Loop bodies that open a scope holding the iterator
+            std::vector<std::pair<const ASTNode*, std::string_view>> Iterators;
+
+            void OpenScope() { Scopes.push_back(Bindings.size()); }
+
+            void CloseScope() {
+                Bindings.resize(Scopes.back());
+                Scopes.pop_back();
+            }
+
+            const Expression* Lookup(const std::string_view Name) const {
+                for (auto Binding = Bindings.rbegin(); Binding != Bindings.rend(); ++Binding) {
+                    if (Binding->first == Name) {
+                        return Binding->second;
+                    }
+                }
+                const auto Global = Globals.find(Name);
+                return Global != Globals.end() ? Global->second : nullptr;
+            }
+
+            void Enter(ASTNode& Node) {
+                if (!Iterators.empty() && Iterators.back().first == &Node) {
+                    OpenScope();
+                    Bindings.emplace_back(Iterators.back().second, nullptr);
+                }
+
+                switch (Node.Kind) {
+                    case ENodeKind::BlockStatement:
+                        OpenScope();
+                        break;
+                    case ENodeKind::FunctionDeclaration:
+                        OpenScope();
+                        for (const auto& Param : static_cast<FunctionDeclaration&>(Node).Parameters) {
+                            Bindings.emplace_back(Param.Name, nullptr);
+                        }
+                        break;
+                    case ENodeKind::ForStatement: {
+                        const auto& For = static_cast<ForStatement&>(Node);
+                        if (For.Body != nullptr) {
+                            Iterators.emplace_back(For.Body, For.Iterator);
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+
+            void Leave(ASTNode& Node) {
+                FoldSlots(Node);
+
+                switch (Node.Kind) {
+                    case ENodeKind::VariableDeclaration: {
+                        const auto& Variable = static_cast<VariableDeclaration&>(Node);
+                        if (!Scopes.empty()) {
+                            const bool Known = Variable.IsConst && IsLiteral(Variable.Initializer);
+                            Bindings.emplace_back(Variable.Name, Known ? Variable.Initializer : nullptr);
+                        }
+                        break;
+                    }
+                    case ENodeKind::ForStatement: {
+                        auto& For = static_cast<ForStatement&>(Node);
+                        if (For.IsInclusive && CanMakeExclusive(For.RangeStart, For.RangeEnd, For.Step)) {
+                            For.RangeEnd = Successor(*For.RangeEnd->As<IntegerLiteral>());
+                            For.IsInclusive = false;
+                        }
+                        break;
+                    }
+                    case ENodeKind::BlockStatement:
+                    case ENodeKind::FunctionDeclaration:
+                        CloseScope();
+                        break;
+                    default:
+                        break;
+                }
+
+                if (!Iterators.empty() && Iterators.back().first == &Node) {
+                    CloseScope();
+                    Iterators.pop_back();
+                }
+            }
+
+            /** Folds every expression slot of Node; the expressions below them are already folded */
+            void FoldSlots(ASTNode& Node) {
+                const auto Visit = [this](Expression*& Slot, const bool Substitute = true) {
+                    if (Slot != nullptr) {
+                        Slot = Fold(Slot, Substitute);
+                    }
+                };
+
+                switch (Node.Kind) {
+                    case ENodeKind::BinaryExpression: {
+                        auto& Binary = static_cast<BinaryExpression&>(Node);
+                        Visit(Binary.Left, !IsAssignmentOp(Binary.Op));
+                        Visit(Binary.Right);
+                        break;
+                    }
+                    case ENodeKind::UnaryExpression:
+                        Visit(static_cast<UnaryExpression&>(Node).Operand);
+                        break;
+                    case ENodeKind::FunctionCall: {
+                        auto& Call = static_cast<FunctionCall&>(Node);
+                        Visit(Call.Callee, false);
+                        for (auto& Argument : Call.Arguments) {
+                            Visit(Argument);
+                        }
+                        break;
+                    }
+                    case ENodeKind::MemberAccess:
+                        Visit(static_cast<MemberAccess&>(Node).Object);
+                        break;
+                    case ENodeKind::IndexAccess: {
+                        auto& Access = static_cast<IndexAccess&>(Node);
+                        Visit(Access.Object);
+                        Visit(Access.Index);
+                        break;
+                    }
+                    case ENodeKind::TernaryExpression: {
+                        auto& Ternary = static_cast<TernaryExpression&>(Node);
+                        Visit(Ternary.Condition);
+                        Visit(Ternary.TrueExpr);
+                        Visit(Ternary.FalseExpr);
+                        break;
+                    }
+                    case ENodeKind::CastExpression:
+                        Visit(static_cast<CastExpression&>(Node).Expr);
+                        break;
+                    case ENodeKind::NewExpression:
+                        for (auto& Argument : static_cast<NewExpression&>(Node).Arguments) {
+                            Visit(Argument);
+                        }
+                        break;
+                    case ENodeKind::GroupingExpression:
+                        Visit(static_cast<GroupingExpression&>(Node).Expr);
+                        break;
+
+                    case ENodeKind::VariableDeclaration:
+                        Visit(static_cast<VariableDeclaration&>(Node).Initializer);
+                        break;
+                    case ENodeKind::ExpressionStatement:
+                        Visit(static_cast<ExpressionStatement&>(Node).Expr);
+                        break;
+                    case ENodeKind::IfStatement:
+                        Visit(static_cast<IfStatement&>(Node).Condition);
+                        break;
+                    case ENodeKind::WhileStatement:
+                        Visit(static_cast<WhileStatement&>(Node).Condition);
+                        break;
+                    case ENodeKind::DoWhileStatement:
+                        Visit(static_cast<DoWhileStatement&>(Node).Condition);
+                        break;
+                    case ENodeKind::ForStatement: {
+                        auto& For = static_cast<ForStatement&>(Node);
+                        Visit(For.RangeStart);
+                        Visit(For.RangeEnd);
+                        Visit(For.Step);
+                        break;
+                    }
+                    case ENodeKind::ReturnStatement:
+                        Visit(static_cast<ReturnStatement&>(Node).Value);
+                        break;
+                    case ENodeKind::MatchStatement: {
+                        auto& Match = static_cast<MatchStatement&>(Node);
+                        Visit(Match.Value);
+                        for (auto& Case : Match.Cases) {
+                            Visit(Case.Pattern);
+                        }
+                        break;
+                    }
+
+                    case ENodeKind::FieldDeclaration:
+                        Visit(static_cast<FieldDeclaration&>(Node).Initializer);
+                        break;
+                    case ENodeKind::FunctionDeclaration:
+                        for (auto& Param : static_cast<FunctionDeclaration&>(Node).Parameters) {
+                            Visit(Param.DefaultValue);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            /** Expr, or what replaces it; its children are already folded */
+            Expression* Fold(Expression* Expr, const bool Substitute) {
+                switch (Expr->Kind) {
+                    case ENodeKind::Identifier: {
+                        const Expression* Value = Substitute ? Lookup(static_cast<Identifier*>(Expr)->Name) : nullptr;
+                        if (Value == nullptr) {
+                            return Expr;
+                        }
+                        Constant Known;
+                        ToConstant(Value, Known);
+                        ++Stats.Propagated;
+                        return ToLiteral(Known, Context, Expr->Location);
+                    }
+
+                    case ENodeKind::GroupingExpression: {
+                        Expression* Inner = static_cast<GroupingExpression*>(Expr)->Expr;
+                        if (!IsLiteral(Inner)) {
+                            return Expr;
+                        }
+                        Inner->Location = Expr->Location;
+                        ++Stats.Folded;
+                        return Inner;
+                    }
+
+                    case ENodeKind::UnaryExpression: {
+                        const auto* Unary = static_cast<UnaryExpression*>(Expr);
+                        Constant Operand;
+                        Constant Result;
+                        if (!ToConstant(Unary->Operand, Operand) || !EvaluateUnary(Unary->Op, Operand, Result)) {
+                            return Expr;
+                        }
+                        ++Stats.Folded;
+                        return ToLiteral(Result, Context, Expr->Location);
+                    }
+
+                    case ENodeKind::TernaryExpression: {
+                        const auto* Ternary = static_cast<TernaryExpression*>(Expr);
+                        const auto* Condition = Ternary->Condition->As<BoolLiteral>();
+                        if (Condition == nullptr) {
+                            return Expr;
+                        }
+                        ++Stats.Folded;
+                        return Condition->Value ? Ternary->TrueExpr : Ternary->FalseExpr;
+                    }
+
+                    case ENodeKind::BinaryExpression:
+                        return FoldBinary(static_cast<BinaryExpression*>(Expr));
+
+                    default:
+                        return Expr;
+                }
+            }
+
+            Expression* FoldBinary(BinaryExpression* Binary) {
+                Constant Left;
+                Constant Right;
+                const bool LeftKnown = ToConstant(Binary->Left, Left);
+                const bool RightKnown = ToConstant(Binary->Right, Right);
+
+                switch (Binary->Op) {
+                    case EBinaryOp::LogicalAnd:
+                    case EBinaryOp::LogicalOr:
+                        // The right side never runs when the left decides
+                        if (LeftKnown && Left.Kind == EKind::Bool && Left.Bool == (Binary->Op == EBinaryOp::LogicalOr)) {
+                            ++Stats.Folded;
+                            return ToLiteral(Left, Context, Binary->Location);
+                        }
+                        break;
+
+                    case EBinaryOp::NullCoalesce:
+                        if (!LeftKnown) {
+                            return Binary;
+                        }
+                        ++Stats.Folded;
+                        return Left.Kind == EKind::Null ? Binary->Right : Binary->Left;
+
+                    case EBinaryOp::RangeInclusive:
+                        if (CanMakeExclusive(Binary->Left, Binary->Right, nullptr)) {
+                            Binary->Right = Successor(*Binary->Right->As<IntegerLiteral>());
+                            Binary->Op = EBinaryOp::Range;
+                            ++Stats.Folded;
+                        }
+                        return Binary;
+
+                    default:
+                        break;
+                }
+
+                Constant Result;
+                if (!LeftKnown || !RightKnown || !EvaluateBinary(Binary->Op, Left, Right, Context, Result)) {
+                    return Binary;
+                }
+                ++Stats.Folded;
+                return ToLiteral(Result, Context, Binary->Location);
+            }
+
+            Expression* Successor(const IntegerLiteral& Last) {
+                return ToLiteral(Constant::OfInt(Last.Value + 1), Context, Last.Location);
+            }
+        };
+    }
+
+    FoldStatistics FoldConstants(ASTNode* Root, ASTContext& Context) {
+        FoldStatistics Stats;
+        if (Root == nullptr) {
+            return Stats;
+        }
+
+        Folder Pass(Context, Stats);
+        Pass.CollectGlobals(Root);
+        Pass.Walk(Root);
+
+        if (Pass.HasChanged()) {
+            ClearStructuralHashes(Root);
+        }
+        return Stats;
+    }
+
+    Expression* FoldExpression(Expression* Root, ASTContext& Context, FoldStatistics* Stats) {
+        FoldStatistics Local;
+        FoldStatistics& Counts = Stats != nullptr ? *Stats : Local;
+        if (Root == nullptr) {
+            return nullptr;
+        }
+
+        Folder Pass(Context, Counts);
+        Expression* Result = Pass.FoldTree(Root);
+
+        if (Pass.HasChanged()) {
+            ClearStructuralHashes(Result);
+        }
+        return Result;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ASTContext.h"
+#include "Declaration.h"
+
+namespace Vex {
+
+    /**
+     * What FoldConstants() changed
+     */
+    struct FoldStatistics {
+        size_t Folded = 0;                          // Operators replaced by their value
+        size_t Propagated = 0;                      // Const uses replaced by the constant's value
+    };
+
+    /**
+     * Folds constant expressions in the subtree of Root, in place
+     *
+     * Binary, unary, ternary and grouping expressions whose operands are
+     * literals are replaced by a literal of their value, bottom-up, so
+     * `100 * 60 ** 2` becomes `360000`. Const locals and globals whose
+     * initializer folds to a literal are propagated into their uses, which
+     * then fold further. Folding follows the run-time rules exactly and
+     * leaves anything the run time would report alone:
+     *
+     *   Int         64-bit two's complement; + - * ** and unary - wrap on
+     *               overflow. / and % truncate toward zero; by zero is not
+     *               folded. A negative ** exponent gives 0 unless the base
+     *               is 1 or -1 (0 is not folded).
+     *   Shifts      The count is taken modulo 64; >> is arithmetic.
+     *   Float       IEEE double; Int mixed with Float is converted first.
+     *               % is fmod. Results that are not finite are not folded.
+     *   ==, !=      Int and Float compare by value; === and !== also
+     *               require the same type. Strings compare bytewise.
+     *   && ||       Short-circuit: `false && F()` is false, but `true && F()`
+     *               stays, since only the checker knows F() is a Bool.
+     *   ??          `null ?? X` is X; any other literal ?? X is the literal.
+     *   ..=         A constant Int end is made exclusive (`0..=9` is
+     *               `0..10`), in expressions and in for loops.
+     *   ? :         A literal Bool condition selects its branch.
+     *   + on String Concatenates; the result is interned in Context.
+     *
+     * Const names are scoped like the language: a local is visible from
+     * its declaration to the end of its block, and Var, Let, parameters and
+     * loop iterators of the same name shadow it. Globals are visible
+     * everywhere when their name is declared once in the tree. Assignment
+     * targets and callees are never replaced. Bodies left unparsed by a
+     * LazyParser are not visited.
+     *
+     * New literals are allocated in Context and take the location of the
+     * expression they replace. Root itself is kept even if it is a foldable
+     * expression (see FoldExpression). Cached structural hashes in the
+     * subtree are cleared if anything changed.
+     *
+     * Example:
+     *   FoldStatistics Stats = FoldConstants(Unit, Context);
+     */
+    FoldStatistics FoldConstants(ASTNode* Root, ASTContext& Context);
+
+    /** Folds a single expression tree (no Const names in scope); returns its new root */
+    Expression* FoldExpression(Expression* Root, ASTContext& Context, FoldStatistics* Stats = nullptr);
+}
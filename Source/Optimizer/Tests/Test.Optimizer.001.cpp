@@ -0,0 +1,188 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+
+#include "../ConstantFolder.h"
+#include "Parser.h"
+#include "StructuralHash.h"
+
+using namespace Vex;
+
+namespace {
+    std::string FoldText(const std::string& Source, FoldStatistics* Stats = nullptr) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        Expression* Expr = Parser.ParseExpression();
+        assert(!Parser.HasErrors());
+        return FoldExpression(Expr, Context, Stats)->ToString();
+    }
+
+    std::string FoldStatement(const std::string& Source, FoldStatistics* Stats = nullptr) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        Statement* Stmt = Parser.ParseStatement();
+        assert(!Parser.HasErrors());
+        const FoldStatistics Result = FoldConstants(Stmt, Context);
+        if (Stats != nullptr) {
+            *Stats = Result;
+        }
+        return Stmt->ToString();
+    }
+}
+
+void Test_Optimizer_001_ConstantFolding() {
+    std::cout << "--- Optimizer Test 001: Constant Folding ---" << "\n";
+
+    // Int arithmetic wraps; what the run time reports is left alone
+    {
+        FoldStatistics Stats;
+        assert(FoldText("100 * 60 ** 2", &Stats) == "360000");
+        assert(Stats.Folded == 2 && Stats.Propagated == 0);
+
+        assert(FoldText("(1 + 2) * 3") == "9");
+        assert(FoldText("9223372036854775807 + 1") == "-9223372036854775808");
+        assert(FoldText("-7 / 2") == "-3");
+        assert(FoldText("-7 % 2") == "-1");
+        assert(FoldText("7 / 0") == "(7 / 0)");
+        assert(FoldText("7 % (3 - 3)") == "(7 % 0)");
+        assert(FoldText("2 ** 62 * 4") == "0");
+        assert(FoldText("2 ** -1") == "0");
+        assert(FoldText("(-1) ** -3") == "-1");
+        assert(FoldText("0 ** -1") == "(0 ** -1)");
+        assert(FoldText("-2 ** 2") == "-4");
+        assert(FoldText("1 << 65") == "2");
+        assert(FoldText("-16 >> 2") == "-4");
+        assert(FoldText("~0 & 6 | 1 ^ 2") == "7");
+        assert(FoldText("A + 1 * 2") == "(A + 2)");
+
+        std::cout << "  ✓ Int arithmetic" << "\n";
+    }
+
+    // Floats, comparisons, strings and logic
+    {
+        assert(FoldText("1 + 0.5") == "1.5");
+        assert(FoldText("2.0 ** 3") == "8.0");
+        assert(FoldText("7.5 % 2") == "1.5");
+        assert(FoldText("1.0 / 0.0") == "(1.0 / 0.0)");
+
+        assert(FoldText("1 == 1.0") == "true");
+        assert(FoldText("1 === 1.0") == "false");
+        assert(FoldText("1 !== 1") == "false");
+        assert(FoldText("3 >= 2 && 'a' < 'b'") == "true");
+        assert(FoldText("\"Fire\" + \"ball\"") == "\"Fireball\"");
+        assert(FoldText("\"Fire\" < \"Ice\"") == "true");
+        assert(FoldText("1 == \"1\"") == "(1 == \"1\")");
+
+        assert(FoldText("false && Check()") == "false");
+        assert(FoldText("true || Check()") == "true");
+        assert(FoldText("true && Check()") == "(true && Check())");
+        assert(FoldText("!true || false") == "false");
+
+        assert(FoldText("null ?? Fallback") == "Fallback");
+        assert(FoldText("5 ?? Fallback") == "5");
+        assert(FoldText("Value ?? 5") == "(Value ?? 5)");
+
+        assert(FoldText("1 > 0 ? Alive : Dead") == "Alive");
+        assert(FoldText("(Armor)") == "(Armor)");
+
+        std::cout << "  ✓ Floats, comparisons, strings, && || ?? and ?:" << "\n";
+    }
+
+    // Ranges: a constant Int end is made exclusive
+    {
+        assert(FoldText("0..=9") == FoldText("0..10"));
+        assert(FoldText("0..=2 * 5") == FoldText("0..11"));
+        assert(FoldText("0.5..=3") == FoldText("0.5..=3"));
+        assert(FoldText("0.5..=3") != FoldText("0.5..4"));
+        assert(FoldText("9..=0") != FoldText("9..1"));
+
+        assert(FoldStatement("for I in 0..=60 * 60 step 2 { Tick(I); }") ==
+               FoldStatement("for I in 0..3601 step 2 { Tick(I); }"));
+        assert(FoldStatement("for I in 0..=9 step -1 { Tick(I); }") !=
+               FoldStatement("for I in 0..10 step -1 { Tick(I); }"));
+
+        std::cout << "  ✓ Ranges" << "\n";
+    }
+
+    // Const propagation follows scopes
+    {
+        FoldStatistics Stats;
+        assert(FoldStatement("{ Const Rate = 60; Const Total = 100 * Rate ** 2; return Total + 1; }", &Stats) ==
+               "{ Const Rate = 60; Const Total = 360000; return 360001; }");
+        assert(Stats.Propagated == 2);
+
+        assert(FoldStatement("{ Const X = 1; { Var X = 5; Y = X; } Z = X; }") ==
+               "{ Const X = 1; { Var X = 5; (Y = X); } (Z = 1); }");
+        assert(FoldStatement("{ Const I = 3; for I in 0..I { Sum += I; } Sum += I; }") ==
+               FoldStatement("{ Const I = 3; for I in 0..3 { Sum += I; } Sum += 3; }"));
+        assert(FoldStatement("{ Y = X; Const X = 1; }") == "{ (Y = X); Const X = 1; }");
+        assert(FoldStatement("{ Const X = 1; Const X = X + 1; Y = X; }") ==
+               "{ Const X = 1; Const X = 2; (Y = 2); }");
+        assert(FoldStatement("{ Const X = 1; X = 2; X(); }") == "{ Const X = 1; (X = 2); X(); }");
+        assert(FoldStatement("{ Const Name = \"Orc\"; Log(Name + \"s\"); }") ==
+               "{ Const Name = \"Orc\"; Log(\"Orcs\"); }");
+        assert(FoldStatement("{ Let Scale = 2; Y = Scale * 2; }") == "{ Let Scale = 2; (Y = (Scale * 2)); }");
+
+        std::cout << "  ✓ Const propagation and shadowing" << "\n";
+    }
+
+    // Globals are visible everywhere, also before their declaration
+    {
+        const std::string Source =
+            "Define Clock {\n"
+            "    Public:\n"
+            "        Day() -> Int { return Hour * 24; }\n"
+            "        Wait(Hour: Int) -> Int { return Hour * 2; }\n"
+            "}\n"
+            "global Const Hour: Int = Minute * 60;\n"
+            "global Const Minute: Int = 60;\n"
+            "global Const Twice: Int = 1;\n"
+            "global Const Twice: Int = 2;\n"
+            "global Const Hours: Int = Twice * Hour;\n";
+
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        assert(!Parser.HasErrors());
+
+        const FoldStatistics Stats = FoldConstants(Unit, Context);
+        const auto* Clock = Unit->Declarations[0]->As<DefineDeclaration>();
+        assert(Clock->Methods[0]->Body->ToString() == "{ return 86400; }");
+        assert(Clock->Methods[1]->Body->ToString() == "{ return (Hour * 2); }");
+        assert(Stats.Propagated == 3);
+
+        // A name declared twice is not a constant
+        const auto* Hours = Unit->Declarations[5]->As<GlobalDeclaration>()->Variable;
+        assert(Hours->Initializer->ToString() == "(Twice * 3600)");
+
+        std::cout << "  ✓ Global constants" << "\n";
+    }
+
+    // Hashes and locations follow the rewrite; deep chains fold without recursion
+    {
+        ASTContext Context;
+        Parser Parser("Damage(Base, (2 + 3) * 4)", Context);
+        Expression* Call = Parser.ParseExpression();
+        const SourceLocation Location = Call->As<FunctionCall>()->Arguments[1]->Location;
+        const uint64_t Before = StructuralHash(Call);
+
+        Call = FoldExpression(Call, Context);
+        const Expression* Argument = Call->As<FunctionCall>()->Arguments[1];
+        assert(Argument->Is<IntegerLiteral>() && Argument->As<IntegerLiteral>()->Value == 20);
+        assert(Argument->Location.Line == Location.Line && Argument->Location.Column == Location.Column);
+
+        Vex::Parser Expected("Damage(Base, 20)", Context);
+        assert(StructuralHash(Call) != Before);
+        assert(StructurallyEqual(Call, Expected.ParseExpression()));
+
+        std::string Chain = "0";
+        for (int Index = 0; Index < 100000; ++Index) {
+            Chain += " + 1";
+        }
+        assert(FoldText(Chain) == "100000");
+
+        std::cout << "  ✓ Hashes, locations and deep trees" << "\n";
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,27 @@
+#include <iostream>
+
+// Forward declarations of all benchmark functions
+void Bench_Parser_001_Throughput();
+void Bench_Parser_002_ParallelScaling();
+void Bench_Parser_003_LazyBodies();
+void Bench_Parser_004_IncrementalEdits();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX PARSER BENCHMARKS" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Bench_Parser_001_Throughput();
+        Bench_Parser_002_ParallelScaling();
+        Bench_Parser_003_LazyBodies();
+        Bench_Parser_004_IncrementalEdits();
+
+        std::cout << "\n";
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Benchmark failed with exception: " << E.what() << "\n";
+        return 1;
+    }
+}
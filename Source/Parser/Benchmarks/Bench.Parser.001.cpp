@@ -0,0 +1,101 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int DefineCount = 4000;
+
+    /** Game-style source: one Define of fields and methods per entity kind (~28 lines each) */
+    std::string Generate(size_t& Lines) {
+        std::string Source;
+        Lines = 0;
+
+        for (int Index = 0; Index < DefineCount; ++Index) {
+            const std::string Name = "Entity" + std::to_string(Index);
+            Source += "@SoA\n"
+                      "Define " + Name + " : Base {\n"
+                      "    Public:\n"
+                      "        Health -> Int_32 = 100;\n"
+                      "        Position -> Vector3;\n"
+                      "        Velocity -> Vector3;\n"
+                      "        Update(Delta: Float) -> Void {\n"
+                      "            Let Speed: Float = Velocity.Length() * Delta;\n"
+                      "            if Speed > MaxSpeed * 2 ** Level && Health > 0 {\n"
+                      "                Position += Velocity * (MaxSpeed / Speed) * Delta;\n"
+                      "            } else {\n"
+                      "                Position += Velocity * Delta;\n"
+                      "            }\n"
+                      "            for I in 0..Targets.Count step 1 {\n"
+                      "                Var Target = Targets[I]?.Owner ?? Self;\n"
+                      "                Target.Health -= Damage[I] as Int_32 % 7 + (Armor << 1 | 3);\n"
+                      "            }\n"
+                      "        }\n"
+                      "    Private:\n"
+                      "        Classify() -> Int_32 {\n"
+                      "            match Health / 25 {\n"
+                      "                0 -> return -1;\n"
+                      "                1 -> { Log(\"Low\", Health); }\n"
+                      "                _ -> return Health >= 50 ? 1 : 0;\n"
+                      "            }\n"
+                      "            return 0;\n"
+                      "        }\n"
+                      "}\n\n";
+            Lines += 29;
+        }
+
+        return Source;
+    }
+}
+
+void Bench_Parser_001_Throughput() {
+    PrintHeader("Parser Benchmark 001: Throughput");
+
+    size_t Lines = 0;
+    const std::string Source = Generate(Lines);
+    PrintRow("Lines", static_cast<double>(Lines), "");
+    PrintRow("Source size", static_cast<double>(Source.size()) / (1024.0 * 1024.0), "MB");
+
+    // Lexing alone, token by token as the parser consumes them
+    Stopwatch Timer;
+    size_t Tokens = 0;
+    {
+        Lexer Lexer(Source);
+        while (Lexer.NextToken().Type != ETokenType::END_OF_FILE) {
+            ++Tokens;
+        }
+    }
+    const double LexMilliseconds = Timer.ElapsedMilliseconds();
+    DoNotOptimize(Tokens);
+    PrintRow("Lex only (NextToken)", LexMilliseconds, "ms");
+
+    // Lexing into a token vector, for comparison
+    Timer.Restart();
+    {
+        Lexer Lexer(Source);
+        DoNotOptimize(Lexer.Tokenize().size());
+    }
+    PrintRow("Lex only (Tokenize)", Timer.ElapsedMilliseconds(), "ms");
+
+    // Lex + parse, pulling tokens lazily
+    const size_t ResidentBefore = GetResidentBytes();
+    Timer.Restart();
+    ASTContext Context;
+    Parser Parser(Source, Context);
+    const TranslationUnit* Unit = Parser.ParseTranslationUnit();
+    const double ParseMilliseconds = Timer.ElapsedMilliseconds();
+    DoNotOptimize(Unit);
+
+    PrintRow("Lex + parse", ParseMilliseconds, "ms");
+    PrintRow("Parse share", 100.0 * (ParseMilliseconds - LexMilliseconds) / ParseMilliseconds, "%");
+    PrintRow("Lines per second", static_cast<double>(Lines) / (ParseMilliseconds / 1000.0), "lines/s");
+    PrintRow("Tokens per second", static_cast<double>(Tokens) / (ParseMilliseconds / 1000.0), "tokens/s");
+    PrintRow("Memory growth", static_cast<double>(GetResidentBytes() - ResidentBefore) / (1024.0 * 1024.0), "MB");
+    PrintRow("Declarations", static_cast<double>(Unit->Declarations.size()), "");
+    PrintRow("Errors", static_cast<double>(Parser.GetErrors().size()), "");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,80 @@
+#include <string>
+#include <thread>
+
+#include "Benchmark.h"
+#include "../ParallelParser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int BlockCount = 6000;
+
+    /** A script bundle: independent Define / Fetch / Set blocks */
+    std::string Generate(size_t& Lines) {
+        std::string Source;
+        Lines = 0;
+
+        for (int Index = 0; Index < BlockCount; ++Index) {
+            const std::string Name = "Entity" + std::to_string(Index);
+            Source += "Define " + Name + " {\n"
+                      "    Public:\n"
+                      "        Health -> Int_32 = 100;\n"
+                      "        Armor -> Float;\n"
+                      "        Update(Delta: Float) -> Void {\n"
+                      "            if Health > 0 && Armor < 50.0 { Armor += Delta * 2 ** Level; }\n"
+                      "            for I in 0..Count { Total += Values[I] as Int_32 % 7; }\n"
+                      "        }\n"
+                      "}\n"
+                      "Fetch " + Name + " {\n"
+                      "    Fetch_Health() -> Int_32 { return Health > 0 ? Health : 0; }\n"
+                      "}\n"
+                      "Set " + Name + " {\n"
+                      "    Set_Health(Value: Int_32) -> Void { Health = Value < 0 ? 0 : Value; }\n"
+                      "}\n";
+            Lines += 15;
+        }
+
+        return Source;
+    }
+}
+
+void Bench_Parser_002_ParallelScaling() {
+    PrintHeader("Parser Benchmark 002: Parallel Scaling");
+
+    size_t Lines = 0;
+    const std::string Source = Generate(Lines);
+    PrintRow("Lines", static_cast<double>(Lines), "");
+    PrintRow("Hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "");
+
+    Stopwatch Timer;
+    std::vector<SourceSpan> Spans;
+    ParallelParser::Split(Source, Spans);
+    PrintRow("Pre-scan", Timer.ElapsedMilliseconds(), "ms");
+    PrintRow("Top-level spans", static_cast<double>(Spans.size()), "");
+
+    double Serial = 0.0;
+    {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        Timer.Restart();
+        DoNotOptimize(Parser.ParseTranslationUnit());
+        Serial = Timer.ElapsedMilliseconds();
+        PrintRow("Serial parse", Serial, "ms");
+    }
+
+    for (const unsigned Threads : { 1u, 2u, 4u, 8u }) {
+        ASTContext Context;
+        ParallelParser Parser(Source, Context, "", Threads);
+        Timer.Restart();
+        DoNotOptimize(Parser.ParseTranslationUnit());
+        const double Elapsed = Timer.ElapsedMilliseconds();
+
+        const std::string Label = "Parallel, " + std::to_string(Threads) + " thread(s)";
+        PrintRow(Label, Elapsed, "ms");
+        PrintRow("  speedup", Serial / Elapsed, "x");
+        PrintRow("  lines per second", static_cast<double>(Lines) / (Elapsed / 1000.0), "lines/s");
+    }
+
+    std::cout << "\n";
+}
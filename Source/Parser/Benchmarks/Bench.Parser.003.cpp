@@ -0,0 +1,92 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../LazyParser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int BlockCount = 6000;
+
+    /** Declarations with typical method bodies, most of which a tool never opens */
+    std::string Generate(size_t& Lines) {
+        std::string Source;
+        Lines = 0;
+
+        for (int Index = 0; Index < BlockCount; ++Index) {
+            const std::string Name = "Entity" + std::to_string(Index);
+            Source += "Define " + Name + " {\n"
+                      "    Public:\n"
+                      "        Health -> Int_32 = 100;\n"
+                      "        Armor -> Float;\n"
+                      "        Update(Delta: Float) -> Void {\n"
+                      "            if Health > 0 && Armor < 50.0 { Armor += Delta * 2 ** Level; }\n"
+                      "            for I in 0..Count { Total += Values[I] as Int_32 % 7; }\n"
+                      "            while Total > 100 { Total -= Step(Total, \"{ clamp }\"); }\n"
+                      "            return;\n"
+                      "        }\n"
+                      "}\n"
+                      "Fetch " + Name + " {\n"
+                      "    Fetch_Health() -> Int_32 { return Health > 0 ? Health : 0; }\n"
+                      "}\n";
+            Lines += 14;
+        }
+
+        return Source;
+    }
+}
+
+void Bench_Parser_003_LazyBodies() {
+    PrintHeader("Parser Benchmark 003: Lazy Function Bodies");
+
+    size_t Lines = 0;
+    const std::string Source = Generate(Lines);
+    PrintRow("Lines", static_cast<double>(Lines), "");
+
+    Stopwatch Timer;
+    double Eager = 0.0;
+    {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        Timer.Restart();
+        DoNotOptimize(Parser.ParseTranslationUnit());
+        Eager = Timer.ElapsedMilliseconds();
+        PrintRow("Eager parse", Eager, "ms");
+    }
+
+    {
+        ASTContext Context;
+        LazyParser Parser(Source, Context);
+        Timer.Restart();
+        DoNotOptimize(Parser.ParseTranslationUnit());
+        const double Signatures = Timer.ElapsedMilliseconds();
+        PrintRow("Lazy parse, signatures only", Signatures, "ms");
+        PrintRow("  speedup", Eager / Signatures, "x");
+
+        // A tool that opens one body in ten
+        const auto& Functions = Parser.GetDeferredFunctions();
+        Timer.Restart();
+        for (size_t Index = 0; Index < Functions.size(); Index += 10) {
+            DoNotOptimize(Parser.GetBody(Functions[Index]));
+        }
+        PrintRow("  + 10% of bodies", Signatures + Timer.ElapsedMilliseconds(), "ms");
+
+        Timer.Restart();
+        Parser.ParseAllBodies();
+        PrintRow("  + remaining bodies", Timer.ElapsedMilliseconds(), "ms");
+    }
+
+    {
+        ASTContext Context;
+        LazyParser Parser(Source, Context);
+        Timer.Restart();
+        DoNotOptimize(Parser.ParseTranslationUnit());
+        Parser.ParseAllBodies();
+        const double Total = Timer.ElapsedMilliseconds();
+        PrintRow("Lazy parse, all bodies", Total, "ms");
+        PrintRow("  overhead vs eager", Total / Eager, "x");
+    }
+
+    std::cout << "\n";
+}
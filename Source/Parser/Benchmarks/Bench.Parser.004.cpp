@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <string>
+
+#include "Benchmark.h"
+#include "../SyntaxTree.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int BlockCount = 5000;
+
+    /** About 50k lines of declarations with method bodies */
+    std::string Generate(size_t& Lines) {
+        std::string Source;
+        Lines = 0;
+
+        for (int Index = 0; Index < BlockCount; ++Index) {
+            const std::string Name = "Entity" + std::to_string(Index);
+            Source += "Define " + Name + " {\n"
+                      "    Public:\n"
+                      "        Health -> Int_32 = 100;\n"
+                      "        Update(Delta: Float) -> Void {\n"
+                      "            if Health > 0 && Armor < 50.0 { Armor += Delta * 2 ** Level; }\n"
+                      "            for I in 0..Count { Total += Values[I] as Int_32 % 7; }\n"
+                      "            // Keep the totals in range\n"
+                      "            while Total > 100 { Total -= Step(Total, \"{ clamp }\"); }\n"
+                      "        }\n"
+                      "}\n";
+            Lines += 10;
+        }
+
+        return Source;
+    }
+
+    struct Latency {
+        double Average = 0.0;
+        double Worst = 0.0;
+    };
+
+    /** Types Text one character at a time at Offset, timing each edit */
+    Latency Type(SyntaxTree& Tree, size_t Offset, const std::string& Text) {
+        Latency Result;
+        Stopwatch Timer;
+        for (const char Character : Text) {
+            Timer.Restart();
+            SyntaxTree Next = Tree.Edit(Offset++, 0, std::string_view(&Character, 1));
+            const double Elapsed = Timer.ElapsedMilliseconds() * 1000.0;
+
+            Result.Average += Elapsed;
+            Result.Worst = std::max(Result.Worst, Elapsed);
+            Tree = std::move(Next);
+        }
+        Result.Average /= static_cast<double>(Text.size());
+        return Result;
+    }
+}
+
+void Bench_Parser_004_IncrementalEdits() {
+    PrintHeader("Parser Benchmark 004: Incremental Edits");
+
+    size_t Lines = 0;
+    const std::string Source = Generate(Lines);
+    PrintRow("Lines", static_cast<double>(Lines), "");
+
+    Stopwatch Timer;
+    SyntaxTree Tree(Source);
+    const double Build = Timer.ElapsedMilliseconds();
+    PrintRow("Full build", Build, "ms");
+
+    // A new statement typed into a body in the middle of the file
+    const size_t Body = Source.find("for I in 0..Count", Source.size() / 2);
+    const std::string Statement = "Total = Total * 3 + Clamp(Delta, 0.0, 1.0);\n            ";
+    const Latency Statements = Type(Tree, Body, Statement);
+    PrintRow("Keystroke in a body, average", Statements.Average, "us");
+    PrintRow("Keystroke in a body, worst", Statements.Worst, "us");
+
+    // A whole block typed in, so braces are unbalanced between keystrokes
+    const Latency Blocks = Type(Tree, Body, "if Ready { Fire(); }\n            ");
+    PrintRow("Keystroke with open braces, average", Blocks.Average, "us");
+    PrintRow("Keystroke with open braces, worst", Blocks.Worst, "us");
+
+    // A new declaration typed at the top level
+    const Latency Declarations = Type(Tree, Source.size() / 2 - Source.size() / 2 % 64, "\nUsing Engine::Audio;\n");
+    PrintRow("Keystroke at the top level, average", Declarations.Average, "us");
+
+    // What an editor does next: find the enclosing block and parse it
+    const size_t Cursor = Body + 5;
+    Timer.Restart();
+    const SyntaxNode* Node = Tree.GetRoot().FindToken(Cursor);
+    while (Node != nullptr && Node->GetKind() != ESyntaxKind::Block) {
+        Node = Node->GetParent();
+    }
+    ASTContext Context;
+    DoNotOptimize(Node->ToStatement(Context));
+    PrintRow("Find and parse the enclosing block", Timer.ElapsedMilliseconds() * 1000.0, "us");
+
+    std::cout << "\n";
+}
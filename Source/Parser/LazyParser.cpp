@@ -0,0 +1,73 @@
+#include "LazyParser.h"
+
+#include <utility>
+
+#include "StructuralHash.h"
+
+namespace Vex {
+    LazyParser::LazyParser(std::string Source, ASTContext& Context, const std::string_view SourceName)
+        : Source(std::move(Source))
+        , Context(Context)
+        , SourceName(Context.Intern(SourceName)) {}
+
+    TranslationUnit* LazyParser::ParseTranslationUnit() {
+        std::lock_guard<std::mutex> Guard(Lock);
+
+        Deferred.clear();
+        Parser Parser(Source, Context, SourceName);
+        Parser.DeferBodies(&Deferred);
+
+        Unit = Parser.ParseTranslationUnit();
+        Errors = Parser.GetErrors();
+        return Unit;
+    }
+
+    BlockStatement* LazyParser::GetBody(FunctionDeclaration* Function) {
+        DeferredBody* Pending = Function->Deferred;
+        if (Pending == nullptr) {
+            return Function->Body;
+        }
+
+        if (BlockStatement* Parsed = Pending->Parsed.load(std::memory_order_acquire)) {
+            return Parsed;
+        }
+
+        std::lock_guard<std::mutex> Guard(Lock);
+
+        // Another thread may have parsed it while this one waited
+        if (BlockStatement* Parsed = Pending->Parsed.load(std::memory_order_relaxed)) {
+            return Parsed;
+        }
+
+        Parser Parser(Source.substr(Pending->Begin, Pending->End - Pending->Begin), Context, SourceName,
+                      Pending->Start);
+        auto* Body = static_cast<BlockStatement*>(Parser.ParseStatement());
+        Errors.insert(Errors.end(), Parser.GetErrors().begin(), Parser.GetErrors().end());
+
+        Pending->Parsed.store(Body, std::memory_order_release);
+        return Body;
+    }
+
+    void LazyParser::ParseAllBodies() {
+        for (FunctionDeclaration* Function : Deferred) {
+            if (Function->Deferred != nullptr) {
+                Function->Body = GetBody(Function);
+                Function->Deferred = nullptr;
+            }
+        }
+
+        if (Unit != nullptr) {
+            ClearStructuralHashes(Unit);
+        }
+    }
+
+    std::vector<ParseError> LazyParser::GetErrors() const {
+        std::lock_guard<std::mutex> Guard(Lock);
+        return Errors;
+    }
+
+    bool LazyParser::HasErrors() const {
+        std::lock_guard<std::mutex> Guard(Lock);
+        return !Errors.empty();
+    }
+}
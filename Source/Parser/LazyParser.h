@@ -0,0 +1,73 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Parser.h"
+
+namespace Vex {
+
+    /**
+     * Parses declarations now and function bodies on first access
+     *
+     * ParseTranslationUnit() builds every declaration and signature but
+     * only brace-skips function bodies (Parser::DeferBodies), so its cost
+     * is close to that of the signatures alone. GetBody() parses a body the
+     * first time it is asked for and returns the same BlockStatement from
+     * then on.
+     *
+     * GetBody() may be called from any number of threads. The first access
+     * to a given body is serialized, because bodies are parsed into the
+     * shared ASTContext; later accesses are a single atomic load. While
+     * bodies may still be parsed, nothing else may allocate from the
+     * context.
+     *
+     * Passes that walk whole trees (printing, hashing, flattening) see only
+     * the signatures of deferred functions. ParseAllBodies() attaches every
+     * body to FunctionDeclaration::Body, after which the tree is identical
+     * to an eager parse.
+     *
+     * Example:
+     *   ASTContext Context;
+     *   LazyParser Parser(Source, Context, "Player.vex");
+     *   TranslationUnit* Unit = Parser.ParseTranslationUnit();     // signatures
+     *   BlockStatement* Body = Parser.GetBody(Function);           // on demand
+     */
+    class LazyParser {
+    public:
+        LazyParser(std::string Source, ASTContext& Context, std::string_view SourceName = "");
+
+        /** Parses all declarations, deferring function bodies */
+        TranslationUnit* ParseTranslationUnit();
+
+        /** Body of Function, parsed on first access; nullptr for signatures. Thread-safe. */
+        BlockStatement* GetBody(FunctionDeclaration* Function);
+
+        /**
+         * Parses every body that is still deferred and stores it in
+         * FunctionDeclaration::Body. Drops the structural hashes cached in
+         * the unit, which no longer describe it. Must not run concurrently
+         * with GetBody().
+         */
+        void ParseAllBodies();
+
+        /** Functions whose body was deferred, in source order */
+        [[nodiscard]] const std::vector<FunctionDeclaration*>& GetDeferredFunctions() const { return Deferred; }
+
+        /** Errors so far: declarations, plus those of bodies parsed up to now */
+        [[nodiscard]] std::vector<ParseError> GetErrors() const;
+        [[nodiscard]] bool HasErrors() const;
+
+    private:
+        std::string      Source;
+        ASTContext&      Context;
+        std::string_view SourceName;
+        TranslationUnit* Unit = nullptr;
+
+        std::vector<FunctionDeclaration*> Deferred;
+        std::vector<ParseError> Errors;
+        mutable std::mutex Lock;                    // Guards Context and Errors while bodies are parsed
+    };
+}
@@ -0,0 +1,254 @@
+#include "ParallelParser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "Workers.h"
+
+namespace Vex {
+    namespace {
+        bool IsNameCharacter(const char C) {
+            return (C >= 'a' && C <= 'z') || (C >= 'A' && C <= 'Z') || (C >= '0' && C <= '9') || C == '_';
+        }
+
+        /** Consecutive spans parsed by one worker in one go */
+        struct Batch {
+            SourceSpan                Span;
+            unsigned                  Worker = 0;
+            SourceLocation            UnitLocation;
+            std::vector<Declaration*> Declarations;
+        };
+    }
+
+    ParallelParser::ParallelParser(std::string Source, ASTContext& Context, const std::string_view SourceName,
+                                   const unsigned Threads)
+        : Source(std::move(Source))
+        , Context(Context)
+        , SourceName(Context.Intern(SourceName))
+        , Threads(WorkerCount(Threads)) {}
+
+    bool ParallelParser::Split(const std::string_view Source, std::vector<SourceSpan>& Spans) {
+        Spans.clear();
+
+        // Positions follow the lexer: Column is 1 + bytes since the last
+        // newline the lexer counts (escaped newlines in literals do not count)
+        int    Line      = 1;
+        size_t LineStart = 0;
+        int    Depth     = 0;
+        bool   FieldList = false;               // The open top-level brace is a type's {Field, ...} list
+
+        SourceSpan Current;
+        Current.Start = { 1, 1 };
+
+        const auto Cut = [&](const size_t End) {
+            Current.End = End;
+            Spans.push_back(Current);
+            Current.Begin = End;
+            Current.Start = { Line, static_cast<int>(End - LineStart) + 1 };
+        };
+
+        const size_t Size = Source.size();
+        size_t Index = 0;
+
+        while (Index < Size) {
+            switch (Source[Index]) {
+                case '\n':
+                    ++Line;
+                    LineStart = ++Index;
+                    break;
+
+                case '/':
+                    if (Index + 1 < Size && Source[Index + 1] == '/') {
+                        while (Index < Size && Source[Index] != '\n') {
+                            ++Index;
+                        }
+                    } else if (Index + 1 < Size && Source[Index + 1] == '*') {
+                        Index += 2;
+                        while (Index + 1 < Size && !(Source[Index] == '*' && Source[Index + 1] == '/')) {
+                            if (Source[Index] == '\n') {
+                                ++Line;
+                                LineStart = Index + 1;
+                            }
+                            ++Index;
+                        }
+                        if (Index + 1 >= Size) {
+                            return false;
+                        }
+                        Index += 2;
+                    } else {
+                        ++Index;
+                    }
+                    break;
+
+                case '"':
+                    ++Index;
+                    while (Index < Size && Source[Index] != '"') {
+                        if (Source[Index] == '\\') {
+                            Index += 2;
+                            continue;
+                        }
+                        if (Source[Index] == '\n') {
+                            ++Line;
+                            LineStart = Index + 1;
+                        }
+                        ++Index;
+                    }
+                    if (Index >= Size) {
+                        return false;
+                    }
+                    ++Index;
+                    break;
+
+                case '\'':
+                    // Exactly one (possibly escaped) character; anything else is a lexer error
+                    ++Index;
+                    if (Index < Size && Source[Index] == '\\') {
+                        Index += 2;
+                    } else if (Index < Size && Source[Index] != '\n') {
+                        ++Index;
+                    } else {
+                        return false;
+                    }
+                    if (Index >= Size || Source[Index] != '\'') {
+                        return false;
+                    }
+                    ++Index;
+                    break;
+
+                case '{':
+                    if (Depth == 0) {
+                        FieldList = Index > 0 && IsNameCharacter(Source[Index - 1]);
+                    }
+                    ++Depth;
+                    ++Index;
+                    break;
+
+                case '}':
+                    ++Index;
+                    if (--Depth < 0) {
+                        return false;
+                    }
+                    if (Depth == 0 && !FieldList) {
+                        Cut(Index);
+                    }
+                    break;
+
+                case ';':
+                    ++Index;
+                    if (Depth == 0) {
+                        Cut(Index);
+                    }
+                    break;
+
+                default:
+                    ++Index;
+                    break;
+            }
+        }
+
+        if (Depth != 0) {
+            return false;
+        }
+        if (Current.Begin < Size) {
+            Cut(Size);
+        }
+
+        return true;
+    }
+
+    TranslationUnit* ParallelParser::ParseSerial() {
+        Parser Serial(Source, Context, SourceName);
+        TranslationUnit* Unit = Serial.ParseTranslationUnit();
+        Errors = Serial.GetErrors();
+        return Unit;
+    }
+
+    TranslationUnit* ParallelParser::ParseTranslationUnit() {
+        Errors.clear();
+        Parallel = false;
+
+        std::vector<SourceSpan> Spans;
+        if (Threads < 2 || Source.size() < MinParallelBytes || !Split(Source, Spans) || Spans.size() < 2) {
+            return ParseSerial();
+        }
+
+        // About eight batches per worker, so uneven declarations still balance
+        const size_t Target = std::max<size_t>(Source.size() / (static_cast<size_t>(Threads) * 8), 1);
+        std::vector<Batch> Batches;
+        for (const auto& Span : Spans) {
+            if (Batches.empty() || Batches.back().Span.End - Batches.back().Span.Begin >= Target) {
+                Batches.emplace_back();
+                Batches.back().Span = Span;
+            } else {
+                Batches.back().Span.End = Span.End;
+            }
+        }
+
+        const auto Workers = static_cast<unsigned>(std::min<size_t>(Threads, Batches.size()));
+        std::vector<std::unique_ptr<ASTContext>> Contexts;
+        for (unsigned Worker = 0; Worker < Workers; ++Worker) {
+            Contexts.push_back(std::make_unique<ASTContext>());
+        }
+
+        // Parse: each worker owns one context and claims batches until none are left
+        std::atomic<size_t> Next{ 0 };
+        std::atomic<bool> Failed{ false };
+
+        RunOnWorkers(Workers, [&](const unsigned Worker) {
+            while (!Failed.load(std::memory_order_relaxed)) {
+                const size_t Index = Next.fetch_add(1, std::memory_order_relaxed);
+                if (Index >= Batches.size()) {
+                    return;
+                }
+
+                Batch& Current = Batches[Index];
+                Parser Parser(Source.substr(Current.Span.Begin, Current.Span.End - Current.Span.Begin),
+                              *Contexts[Worker], SourceName, Current.Span.Start);
+                const TranslationUnit* Unit = Parser.ParseTranslationUnit();
+
+                // Errors may recover differently across a cut; let the serial parser report them
+                if (Parser.HasErrors()) {
+                    Failed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+
+                Current.Worker = Worker;
+                Current.UnitLocation = Unit->Location;
+                Current.Declarations.assign(Unit->Declarations.begin(), Unit->Declarations.end());
+            }
+        });
+
+        if (Failed.load()) {
+            return ParseSerial();
+        }
+
+        // Stitch: take over the workers' arenas, then point their trees at this context's types
+        std::vector<std::vector<const TypeRef*>> Remaps;
+        for (const auto& Worker : Contexts) {
+            Remaps.push_back(Context.Adopt(*Worker));
+        }
+
+        Next.store(0);
+        RunOnWorkers(Workers, [&](unsigned) {
+            for (size_t Index = Next.fetch_add(1); Index < Batches.size(); Index = Next.fetch_add(1)) {
+                for (Declaration* Parsed : Batches[Index].Declarations) {
+                    RemapTypes(Parsed, Remaps[Batches[Index].Worker]);
+                }
+            }
+        });
+
+        std::vector<Declaration*> Declarations;
+        for (const auto& Current : Batches) {
+            Declarations.insert(Declarations.end(), Current.Declarations.begin(), Current.Declarations.end());
+        }
+
+        auto* Unit = Context.Create<TranslationUnit>(SourceName);
+        Unit->Location = Batches.front().UnitLocation;
+        Unit->Declarations = Context.CreateArray(Declarations);
+
+        Parallel = true;
+        return Unit;
+    }
+}
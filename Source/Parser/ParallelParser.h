@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Parser.h"
+
+namespace Vex {
+
+    /**
+     * A run of top-level declarations, as found by ParallelParser::Split()
+     */
+    struct SourceSpan {
+        size_t         Begin = 0;           // Byte offsets into the source
+        size_t         End   = 0;
+        SourceLocation Start;               // Line and column of Begin
+    };
+
+    /**
+     * Parses the top-level declarations of one file on several threads
+     *
+     * A character-level pre-scan (strings, characters and comments are
+     * skipped, braces are counted) cuts the file after every top-level '}'
+     * or ';'. The pieces are grouped into batches that worker threads
+     * claim one at a time; each worker parses into its own ASTContext, so
+     * there is no shared state while parsing. Afterwards the workers'
+     * arenas are adopted by the caller's context, their types are remapped
+     * to its canonical TypeRefs (again in parallel), and the declarations
+     * are stitched into one TranslationUnit in source order.
+     *
+     * The result is identical to Parser::ParseTranslationUnit(), locations
+     * included. Whenever that cannot be guaranteed cheaply (unbalanced
+     * braces, unterminated literals or comments, or any parse error in a
+     * batch) the whole file is parsed serially instead, so errors and
+     * recovery are exactly those of the serial parser.
+     *
+     * Example:
+     *   ASTContext Context;
+     *   ParallelParser Parser(Source, Context, "Bundle.vex");
+     *   TranslationUnit* Unit = Parser.ParseTranslationUnit();
+     */
+    class ParallelParser {
+    public:
+        /** Threads == 0 uses std::thread::hardware_concurrency() */
+        ParallelParser(std::string Source, ASTContext& Context, std::string_view SourceName = "", unsigned Threads = 0);
+
+        TranslationUnit* ParseTranslationUnit();
+
+        [[nodiscard]] bool HasErrors() const { return !Errors.empty(); }
+        [[nodiscard]] const std::vector<ParseError>& GetErrors() const { return Errors; }
+
+        /** True if the last parse ran in parallel rather than falling back to the serial parser */
+        [[nodiscard]] bool WasParallel() const { return Parallel; }
+
+        /**
+         * Splits Source into spans that each hold whole top-level
+         * declarations. Returns false if the pre-scan cannot vouch for the
+         * split (unbalanced braces, unterminated literal or comment).
+         */
+        static bool Split(std::string_view Source, std::vector<SourceSpan>& Spans);
+
+        /** Files smaller than this are not worth splitting */
+        static constexpr size_t MinParallelBytes = 16 * 1024;
+
+    private:
+        std::string      Source;
+        ASTContext&      Context;
+        std::string_view SourceName;
+        unsigned         Threads;
+
+        std::vector<ParseError> Errors;
+        bool Parallel = false;
+
+        TranslationUnit* ParseSerial();
+    };
+}
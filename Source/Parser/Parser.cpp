@@ -0,0 +1,1264 @@
+#include "Parser.h"
+
+#include <utility>
+
+namespace Vex {
+    namespace {
+        /** Built-in type keywords (Int_8 ... Transform, Void) */
+        bool IsTypeKeyword(const ETokenType Type) {
+            return Type >= ETokenType::INT8 && Type <= ETokenType::TRANSFORM;
+        }
+
+        bool IsTypeName(const ETokenType Type) {
+            return Type == ETokenType::IDENTIFIER || IsTypeKeyword(Type);
+        }
+
+        bool IsAccessKeyword(const ETokenType Type) {
+            return Type == ETokenType::PUBLIC || Type == ETokenType::PRIVATE ||
+                   Type == ETokenType::PROTECTED || Type == ETokenType::VIEW;
+        }
+
+        EAccessModifier ToAccessModifier(const ETokenType Type) {
+            switch (Type) {
+                case ETokenType::PUBLIC:    return EAccessModifier::PUBLIC;
+                case ETokenType::PRIVATE:   return EAccessModifier::PRIVATE;
+                case ETokenType::PROTECTED: return EAccessModifier::PROTECTED;
+                case ETokenType::VIEW:      return EAccessModifier::VIEW;
+                default:                    return EAccessModifier::NONE;
+            }
+        }
+
+        /** Tokens that can only begin a statement; resynchronization stops in front of them */
+        bool StartsStatement(const ETokenType Type) {
+            switch (Type) {
+                case ETokenType::VAR:
+                case ETokenType::LET:
+                case ETokenType::CONST:
+                case ETokenType::IF:
+                case ETokenType::WHILE:
+                case ETokenType::DO:
+                case ETokenType::FOR:
+                case ETokenType::RETURN:
+                case ETokenType::MATCH:
+                case ETokenType::BREAK:
+                case ETokenType::CONTINUE:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        /** Tokens that can only begin a declaration or member section */
+        bool StartsDeclaration(const ETokenType Type) {
+            switch (Type) {
+                case ETokenType::DEFINE:
+                case ETokenType::FETCH:
+                case ETokenType::SET:
+                case ETokenType::INTERFACE:
+                case ETokenType::NAMESPACE:
+                case ETokenType::USING:
+                case ETokenType::GLOBAL:
+                case ETokenType::AT:
+                    return true;
+                default:
+                    return IsAccessKeyword(Type);
+            }
+        }
+
+        /** Symbols allowed after Operator in a method declaration */
+        bool IsOverloadableOperator(const ETokenType Type) {
+            const BindingPower Power = GetInfixBindingPower(Type);
+            return (Power.IsBinary && !IsAssignmentOp(Power.Op)) ||
+                   Type == ETokenType::NOT || Type == ETokenType::BITWISE_NOT;
+        }
+
+        bool StartsExpression(const ETokenType Type) {
+            switch (Type) {
+                case ETokenType::INTEGER_LITERAL:
+                case ETokenType::FLOAT_LITERAL:
+                case ETokenType::STRING_LITERAL:
+                case ETokenType::CHAR_LITERAL:
+                case ETokenType::TRUE:
+                case ETokenType::FALSE:
+                case ETokenType::NULL_KEY:
+                case ETokenType::THIS:
+                case ETokenType::SUPER:
+                case ETokenType::LEFT_PAREN:
+                case ETokenType::MINUS:
+                case ETokenType::PLUS:
+                case ETokenType::NOT:
+                case ETokenType::BITWISE_NOT:
+                case ETokenType::NEW:
+                    return true;
+                default:
+                    return IsTypeName(Type);
+            }
+        }
+
+        bool IsAssignable(const Expression* Target) {
+            return Target->Is<Identifier>() || Target->Is<MemberAccess>() || Target->Is<IndexAccess>();
+        }
+    }
+
+    std::string ParseError::ToString() const {
+        return "Line " + std::to_string(Location.Line) + ", Column " + std::to_string(Location.Column) + ": " + Message;
+    }
+
+    Parser::Parser(std::string Source, ASTContext& Context, const std::string_view SourceName,
+                   const SourceLocation Start)
+        : Context(Context)
+        , Source(std::move(Source), Start.Line, Start.Column)
+        , SourceName(Context.Intern(SourceName))
+        , Current(ETokenType::END_OF_FILE, "", 0, 0)
+    {
+        Current = Pull();
+    }
+
+    // ============================================================================
+    // TOKENS
+    // ============================================================================
+
+    Token Parser::Pull() {
+        Token Pulled = Source.NextToken();
+
+        // Lexical errors are reported here and never reach the grammar
+        while (Pulled.Type == ETokenType::UNKNOWN) {
+            Errors.push_back({ Pulled.Lexeme, { Pulled.Line, Pulled.Column } });
+            Pulled = Source.NextToken();
+        }
+
+        return Pulled;
+    }
+
+    Token Parser::Advance() {
+        if (IsAtEnd()) {
+            return Current;
+        }
+
+        PreviousEnd = { Current.Line, Current.Column + static_cast<int>(Current.Lexeme.size()) };
+        ++Consumed;
+
+        Token Taken = std::move(Current);
+        Current = Pull();
+        return Taken;
+    }
+
+    bool Parser::Match(const ETokenType Type) {
+        if (!Check(Type)) {
+            return false;
+        }
+
+        Advance();
+        return true;
+    }
+
+    bool Parser::Expect(const ETokenType Type, const char* Message) {
+        if (Match(Type)) {
+            return true;
+        }
+
+        Error(Current, Message);
+        return false;
+    }
+
+    bool Parser::IsAdjacent() const {
+        return Current.Line == PreviousEnd.Line && Current.Column == PreviousEnd.Column;
+    }
+
+    void Parser::Error(const Token& At, const std::string& Message) {
+        if (Panicking) {
+            return;
+        }
+
+        Panicking = true;
+        Errors.push_back({ Message, { At.Line, At.Column } });
+    }
+
+    void Parser::SynchronizeStatement() {
+        Panicking = false;
+        int Nesting = 0;
+
+        while (!IsAtEnd()) {
+            switch (Current.Type) {
+                case ETokenType::SEMICOLON:
+                    Advance();
+                    if (Nesting == 0) {
+                        return;
+                    }
+                    break;
+                case ETokenType::LEFT_BRACE:
+                    ++Nesting;
+                    Advance();
+                    break;
+                case ETokenType::RIGHT_BRACE:
+                    if (Nesting == 0) {
+                        return;
+                    }
+                    Advance();
+                    if (--Nesting == 0) {
+                        return;
+                    }
+                    break;
+                default:
+                    if (Nesting == 0 && StartsStatement(Current.Type)) {
+                        return;
+                    }
+                    Advance();
+                    break;
+            }
+        }
+    }
+
+    void Parser::SynchronizeDeclaration() {
+        Panicking = false;
+        int Nesting = 0;
+
+        while (!IsAtEnd()) {
+            switch (Current.Type) {
+                case ETokenType::SEMICOLON:
+                    Advance();
+                    if (Nesting == 0) {
+                        return;
+                    }
+                    break;
+                case ETokenType::LEFT_BRACE:
+                    ++Nesting;
+                    Advance();
+                    break;
+                case ETokenType::RIGHT_BRACE:
+                    if (Nesting == 0) {
+                        return;
+                    }
+                    Advance();
+                    if (--Nesting == 0) {
+                        return;
+                    }
+                    break;
+                default:
+                    if (Nesting == 0 && StartsDeclaration(Current.Type)) {
+                        return;
+                    }
+                    Advance();
+                    break;
+            }
+        }
+    }
+
+    std::string_view Parser::ParseQualifiedName(const char* Message) {
+        if (!Check(ETokenType::IDENTIFIER)) {
+            Error(Current, Message);
+            return {};
+        }
+
+        std::string Name = Advance().Lexeme;
+        while (Match(ETokenType::DOUBLE_COLON)) {
+            if (!Check(ETokenType::IDENTIFIER)) {
+                Error(Current, "Expected name after '::'");
+                return {};
+            }
+            Name += "::" + Advance().Lexeme;
+        }
+
+        return Context.Intern(Name);
+    }
+
+    // ============================================================================
+    // EXPRESSIONS
+    // ============================================================================
+
+    Expression* Parser::ParseExpression() {
+        Expression* Result = ParseExpression(0);
+        if (Result != nullptr && !IsAtEnd()) {
+            Error(Current, "Unexpected '" + Current.Lexeme + "' after expression");
+        }
+        return Result;
+    }
+
+    Expression* Parser::ParseExpression(const uint8_t MinPower) {
+        if (Depth >= MaxDepth) {
+            Error(Current, "Expression nested too deeply");
+            return nullptr;
+        }
+
+        ++Depth;
+        Expression* Left = ParsePrefix();
+
+        // Operators of any one tier loop here; only tighter operands recurse
+        while (Left != nullptr) {
+            const BindingPower Power = GetInfixBindingPower(Current.Type);
+            if (Power.Left == 0 || Power.Left < MinPower) {
+                break;
+            }
+
+            const Token Operator = Advance();
+            Left = ParseInfix(Left, Operator, Power);
+        }
+
+        --Depth;
+        return Left;
+    }
+
+    Expression* Parser::ParsePrefix() {
+        // The offending token is left in place for the caller to resynchronize on
+        if (!StartsExpression(Current.Type)) {
+            Error(Current, IsAtEnd() ? "Expected expression" : "Expected expression, found '" + Current.Lexeme + "'");
+            return nullptr;
+        }
+
+        const Token Start = Advance();
+
+        switch (Start.Type) {
+            case ETokenType::INTEGER_LITERAL:
+                return Make<IntegerLiteral>(Start, Start.IntValue);
+            case ETokenType::FLOAT_LITERAL:
+                return Make<FloatLiteral>(Start, Start.FloatValue);
+            case ETokenType::STRING_LITERAL:
+                return Make<StringLiteral>(Start, Intern(Start));
+            case ETokenType::CHAR_LITERAL:
+                return Make<CharLiteral>(Start, Start.Lexeme.empty() ? '\0' : Start.Lexeme[0]);
+            case ETokenType::TRUE:
+                return Make<BoolLiteral>(Start, true);
+            case ETokenType::FALSE:
+                return Make<BoolLiteral>(Start, false);
+            case ETokenType::NULL_KEY:
+                return Make<NullLiteral>(Start);
+            case ETokenType::THIS:
+                return Make<ThisExpression>(Start);
+            case ETokenType::SUPER:
+                return Make<SuperExpression>(Start);
+
+            case ETokenType::LEFT_PAREN: {
+                Expression* Inner = ParseExpression(0);
+                if (Inner == nullptr || !Expect(ETokenType::RIGHT_PAREN, "Expected ')' after expression")) {
+                    return nullptr;
+                }
+                return Make<GroupingExpression>(Start, Inner);
+            }
+
+            case ETokenType::MINUS:
+            case ETokenType::PLUS:
+            case ETokenType::NOT:
+            case ETokenType::BITWISE_NOT: {
+                const EUnaryOp Op = Start.Type == ETokenType::MINUS ? EUnaryOp::Minus
+                                  : Start.Type == ETokenType::PLUS  ? EUnaryOp::Plus
+                                  : Start.Type == ETokenType::NOT   ? EUnaryOp::LogicalNot
+                                                                    : EUnaryOp::BitwiseNot;
+                Expression* Operand = ParseExpression(PrefixBindingPower);
+                return Operand != nullptr ? Make<UnaryExpression>(Start, Op, Operand) : nullptr;
+            }
+
+            case ETokenType::NEW: {
+                const TypeRef* Type = ParseType();
+                if (Type == nullptr || !Expect(ETokenType::LEFT_PAREN, "Expected '(' after type in 'new'")) {
+                    return nullptr;
+                }
+                std::vector<Expression*> Arguments;
+                if (!ParseArguments(Arguments)) {
+                    return nullptr;
+                }
+                auto* New = Make<NewExpression>(Start, Type);
+                New->Arguments = Context.CreateArray(Arguments);
+                return New;
+            }
+
+            default: {
+                // Names, including built-in types so that Vector3(1, 2, 3) is a call
+                if (Start.Type != ETokenType::IDENTIFIER || !Check(ETokenType::DOUBLE_COLON)) {
+                    return Make<Identifier>(Start, Intern(Start));
+                }
+                std::string Name = Start.Lexeme;
+                while (Match(ETokenType::DOUBLE_COLON)) {
+                    if (!Check(ETokenType::IDENTIFIER)) {
+                        Error(Current, "Expected name after '::'");
+                        return nullptr;
+                    }
+                    Name += "::" + Advance().Lexeme;
+                }
+                return Make<Identifier>(Start, Context.Intern(Name));
+            }
+        }
+    }
+
+    Expression* Parser::ParseInfix(Expression* Left, const Token& Operator, const BindingPower Power) {
+        if (Power.IsBinary) {
+            if (IsAssignmentOp(Power.Op) && !IsAssignable(Left)) {
+                Error(Operator, "Invalid assignment target");
+                return nullptr;
+            }
+
+            Expression* Right = ParseExpression(Power.Right);
+            return Right != nullptr ? Make<BinaryExpression>(Operator, Left, Power.Op, Right) : nullptr;
+        }
+
+        switch (Operator.Type) {
+            case ETokenType::QUESTION: {
+                Expression* Then = ParseExpression(0);
+                if (Then == nullptr || !Expect(ETokenType::COLON, "Expected ':' in conditional expression")) {
+                    return nullptr;
+                }
+                Expression* Else = ParseExpression(Power.Right);
+                return Else != nullptr ? Make<TernaryExpression>(Operator, Left, Then, Else) : nullptr;
+            }
+
+            case ETokenType::AS: {
+                const TypeRef* Type = ParseType();
+                return Type != nullptr ? Make<CastExpression>(Operator, Left, Type) : nullptr;
+            }
+
+            case ETokenType::LEFT_PAREN: {
+                std::vector<Expression*> Arguments;
+                if (!ParseArguments(Arguments)) {
+                    return nullptr;
+                }
+                auto* Call = Make<FunctionCall>(Operator, Left);
+                Call->Arguments = Context.CreateArray(Arguments);
+                return Call;
+            }
+
+            case ETokenType::LEFT_BRACKET: {
+                Expression* Index = ParseExpression(0);
+                if (Index == nullptr || !Expect(ETokenType::RIGHT_BRACKET, "Expected ']' after index")) {
+                    return nullptr;
+                }
+                return Make<IndexAccess>(Operator, Left, Index);
+            }
+
+            case ETokenType::DOT:
+            case ETokenType::QUESTION_DOT: {
+                if (!IsTypeName(Current.Type)) {
+                    Error(Current, "Expected member name after '" + Operator.Lexeme + "'");
+                    return nullptr;
+                }
+                const Token Member = Advance();
+                return Make<MemberAccess>(Operator, Left, Intern(Member), Operator.Type == ETokenType::QUESTION_DOT);
+            }
+
+            default:
+                Error(Operator, "Unexpected '" + Operator.Lexeme + "'");
+                return nullptr;
+        }
+    }
+
+    bool Parser::ParseArguments(std::vector<Expression*>& Arguments) {
+        if (Match(ETokenType::RIGHT_PAREN)) {
+            return true;
+        }
+
+        do {
+            Expression* Argument = ParseExpression(0);
+            if (Argument == nullptr) {
+                return false;
+            }
+            Arguments.push_back(Argument);
+        } while (Match(ETokenType::COMMA));
+
+        return Expect(ETokenType::RIGHT_PAREN, "Expected ')' after arguments");
+    }
+
+    // ============================================================================
+    // TYPES
+    // ============================================================================
+
+    const TypeRef* Parser::ParseType() {
+        TypeRef Key;
+
+        for (bool Qualifier = true; Qualifier;) {
+            if (Match(ETokenType::UNIQUE)) {
+                Key.IsUnique = true;
+            } else if (Match(ETokenType::SHARED)) {
+                Key.IsShared = true;
+            } else if (Match(ETokenType::BORROW)) {
+                Key.IsBorrow = true;
+            } else {
+                Qualifier = false;
+            }
+        }
+
+        if (!IsTypeName(Current.Type)) {
+            Error(Current, "Expected type name");
+            return nullptr;
+        }
+
+        std::string Name = Advance().Lexeme;
+        while (Match(ETokenType::DOUBLE_COLON)) {
+            if (!IsTypeName(Current.Type)) {
+                Error(Current, "Expected type name after '::'");
+                return nullptr;
+            }
+            Name += "::" + Advance().Lexeme;
+        }
+        Key.Name = Context.Intern(Name);
+
+        // Entity.Health
+        std::vector<std::string_view> MemberPath;
+        while (Match(ETokenType::DOT)) {
+            if (!IsTypeName(Current.Type)) {
+                Error(Current, "Expected member name in type");
+                return nullptr;
+            }
+            MemberPath.push_back(Intern(Advance()));
+        }
+        Key.MemberPath = ArenaArray<std::string_view>(MemberPath.data(), MemberPath.size());
+
+        // Float{Entity.Health, Entity.Armor}: the brace must touch the name,
+        // otherwise it opens a function body
+        std::vector<std::string_view> AllowedFields;
+        if (Check(ETokenType::LEFT_BRACE) && IsAdjacent()) {
+            Advance();
+            do {
+                if (!Check(ETokenType::IDENTIFIER)) {
+                    Error(Current, "Expected field name in allowed-field list");
+                    return nullptr;
+                }
+                std::string Field = Advance().Lexeme;
+                while (Match(ETokenType::DOT)) {
+                    if (!IsTypeName(Current.Type)) {
+                        Error(Current, "Expected field name after '.'");
+                        return nullptr;
+                    }
+                    Field += "." + Advance().Lexeme;
+                }
+                AllowedFields.push_back(Context.Intern(Field));
+            } while (Match(ETokenType::COMMA));
+
+            if (!Expect(ETokenType::RIGHT_BRACE, "Expected '}' after allowed fields")) {
+                return nullptr;
+            }
+        }
+        Key.AllowedFields = ArenaArray<std::string_view>(AllowedFields.data(), AllowedFields.size());
+
+        // Int_32*: likewise only when touching, so "X as Int * 2" stays a product
+        if (Check(ETokenType::STAR) && IsAdjacent()) {
+            Advance();
+            Key.IsPointer = true;
+        }
+
+        // Entity[]: an array of the type, for `new Entity[](Count)` and declarations
+        if (Check(ETokenType::LEFT_BRACKET) && IsAdjacent()) {
+            Advance();
+            if (!Expect(ETokenType::RIGHT_BRACKET, "Expected ']' after '[' in array type")) {
+                return nullptr;
+            }
+            Key.IsArray = true;
+        }
+
+        return Context.GetTypes().Get(Key);
+    }
+
+    // ============================================================================
+    // STATEMENTS
+    // ============================================================================
+
+    Statement* Parser::ParseStatement() {
+        if (Depth >= MaxDepth) {
+            Error(Current, "Statement nested too deeply");
+            return nullptr;
+        }
+
+        ++Depth;
+        Statement* Result;
+
+        switch (Current.Type) {
+            case ETokenType::LEFT_BRACE: Result = ParseBlock(); break;
+            case ETokenType::VAR:
+            case ETokenType::LET:
+            case ETokenType::CONST:      Result = ParseVariable(); break;
+            case ETokenType::IF:         Result = ParseIf(); break;
+            case ETokenType::WHILE:      Result = ParseWhile(); break;
+            case ETokenType::DO:         Result = ParseDoWhile(); break;
+            case ETokenType::FOR:        Result = ParseFor(); break;
+            case ETokenType::RETURN:     Result = ParseReturn(); break;
+            case ETokenType::MATCH:      Result = ParseMatch(); break;
+            case ETokenType::BREAK:
+            case ETokenType::CONTINUE:   Result = ParseJump(); break;
+            default:                     Result = ParseExpressionStatement(); break;
+        }
+
+        --Depth;
+        return Result;
+    }
+
+    BlockStatement* Parser::ParseBlock() {
+        const Token Start = Current;
+        if (!Expect(ETokenType::LEFT_BRACE, "Expected '{'")) {
+            return nullptr;
+        }
+
+        std::vector<Statement*> Statements;
+        while (!Check(ETokenType::RIGHT_BRACE) && !IsAtEnd()) {
+            const size_t Before = Consumed;
+
+            Statement* Parsed = ParseStatement();
+            if (Parsed != nullptr) {
+                Statements.push_back(Parsed);
+            }
+            if (Panicking) {
+                SynchronizeStatement();
+                if (Consumed == Before) {
+                    Advance();
+                }
+            }
+        }
+
+        auto* Block = Make<BlockStatement>(Start);
+        Block->Statements = Context.CreateArray(Statements);
+
+        Expect(ETokenType::RIGHT_BRACE, "Expected '}' to close block");
+        return Block;
+    }
+
+    DeferredBody* Parser::SkipBlock() {
+        // Current is the '{' the lexer has just returned
+        auto* Deferred = Context.Create<DeferredBody>();
+        Deferred->Start = { Current.Line, Current.Column };
+        Deferred->Begin = Source.GetOffset() - 1;
+
+        if (!Source.SkipBlock()) {
+            Error(Current, "Expected '}' to close block");
+            Current = Pull();
+            return nullptr;
+        }
+
+        Deferred->End = Source.GetOffset();
+        ++Consumed;
+        Current = Pull();
+        return Deferred;
+    }
+
+    Statement* Parser::ParseVariable() {
+        const Token Keyword = Advance();
+
+        if (!Check(ETokenType::IDENTIFIER)) {
+            Error(Current, "Expected variable name");
+            return nullptr;
+        }
+        const std::string_view Name = Intern(Advance());
+
+        const TypeRef* Type = nullptr;
+        if (Match(ETokenType::COLON)) {
+            Type = ParseType();
+            if (Type == nullptr) {
+                return nullptr;
+            }
+        }
+
+        Expression* Initializer = nullptr;
+        if (Match(ETokenType::ASSIGN)) {
+            Initializer = ParseExpression(0);
+            if (Initializer == nullptr) {
+                return nullptr;
+            }
+        }
+
+        auto* Variable = Make<VariableDeclaration>(Keyword, Keyword.Type == ETokenType::CONST,
+                                                   Keyword.Type == ETokenType::LET, Name, Type, Initializer);
+        Expect(ETokenType::SEMICOLON, "Expected ';' after variable declaration");
+        return Variable;
+    }
+
+    Statement* Parser::ParseIf() {
+        IfStatement* Root = nullptr;
+        IfStatement* Tail = nullptr;
+
+        // else-if chains are linked in a loop rather than by recursion
+        while (true) {
+            const Token Keyword = Advance();
+
+            Expression* Condition = ParseExpression(0);
+            if (Condition == nullptr) {
+                return nullptr;
+            }
+            Statement* Then = ParseStatement();
+            if (Then == nullptr) {
+                return nullptr;
+            }
+
+            auto* If = Make<IfStatement>(Keyword, Condition, Then);
+            if (Tail != nullptr) {
+                Tail->ElseBranch = If;
+            } else {
+                Root = If;
+            }
+            Tail = If;
+
+            if (!Match(ETokenType::ELSE)) {
+                break;
+            }
+            if (!Check(ETokenType::IF)) {
+                Tail->ElseBranch = ParseStatement();
+                if (Tail->ElseBranch == nullptr) {
+                    return nullptr;
+                }
+                break;
+            }
+        }
+
+        return Root;
+    }
+
+    Statement* Parser::ParseWhile() {
+        const Token Keyword = Advance();
+
+        Expression* Condition = ParseExpression(0);
+        if (Condition == nullptr) {
+            return nullptr;
+        }
+        Statement* Body = ParseStatement();
+        return Body != nullptr ? Make<WhileStatement>(Keyword, Condition, Body) : nullptr;
+    }
+
+    Statement* Parser::ParseDoWhile() {
+        const Token Keyword = Advance();
+
+        Statement* Body = ParseStatement();
+        if (Body == nullptr || !Expect(ETokenType::WHILE, "Expected 'while' after do body")) {
+            return nullptr;
+        }
+        Expression* Condition = ParseExpression(0);
+        if (Condition == nullptr) {
+            return nullptr;
+        }
+
+        auto* Loop = Make<DoWhileStatement>(Keyword, Body, Condition);
+        Expect(ETokenType::SEMICOLON, "Expected ';' after do-while condition");
+        return Loop;
+    }
+
+    Statement* Parser::ParseFor() {
+        const Token Keyword = Advance();
+
+        if (!Check(ETokenType::IDENTIFIER)) {
+            Error(Current, "Expected loop variable after 'for'");
+            return nullptr;
+        }
+        const std::string_view Iterator = Intern(Advance());
+
+        if (!Expect(ETokenType::IN, "Expected 'in' after loop variable")) {
+            return nullptr;
+        }
+
+        // The bounds parse as one range expression and are taken apart here
+        const Token RangeStart = Current;
+        Expression* Range = ParseExpression(0);
+        if (Range == nullptr) {
+            return nullptr;
+        }
+        auto* Bounds = Range->As<BinaryExpression>();
+        if (Bounds == nullptr || (Bounds->Op != EBinaryOp::Range && Bounds->Op != EBinaryOp::RangeInclusive)) {
+            Error(RangeStart, "Expected a range (A..B or A..=B) after 'in'");
+            return nullptr;
+        }
+
+        Expression* Step = nullptr;
+        if (Match(ETokenType::STEP)) {
+            Step = ParseExpression(0);
+            if (Step == nullptr) {
+                return nullptr;
+            }
+        }
+
+        Statement* Body = ParseStatement();
+        if (Body == nullptr) {
+            return nullptr;
+        }
+
+        return Make<ForStatement>(Keyword, Iterator, Bounds->Left, Bounds->Right,
+                                  Bounds->Op == EBinaryOp::RangeInclusive, Body, Step);
+    }
+
+    Statement* Parser::ParseReturn() {
+        const Token Keyword = Advance();
+
+        Expression* Value = nullptr;
+        if (!Check(ETokenType::SEMICOLON)) {
+            Value = ParseExpression(0);
+            if (Value == nullptr) {
+                return nullptr;
+            }
+        }
+
+        auto* Return = Make<ReturnStatement>(Keyword, Value);
+        Expect(ETokenType::SEMICOLON, "Expected ';' after return");
+        return Return;
+    }
+
+    Statement* Parser::ParseJump() {
+        const Token Keyword = Advance();
+
+        Statement* Jump = Keyword.Type == ETokenType::BREAK ? static_cast<Statement*>(Make<BreakStatement>(Keyword))
+                                                            : Make<ContinueStatement>(Keyword);
+        Expect(ETokenType::SEMICOLON, "Expected ';' after jump");
+        return Jump;
+    }
+
+    Statement* Parser::ParseMatch() {
+        const Token Keyword = Advance();
+
+        Expression* Value = ParseExpression(0);
+        if (Value == nullptr || !Expect(ETokenType::LEFT_BRACE, "Expected '{' after match value")) {
+            return nullptr;
+        }
+
+        // Pattern -> { ... } | Pattern -> statement | Pattern -> expression[; or ,]
+        std::vector<MatchCase> Cases;
+        while (!Check(ETokenType::RIGHT_BRACE) && !IsAtEnd()) {
+            Expression* Pattern = ParseExpression(0);
+            if (Pattern == nullptr || !Expect(ETokenType::ARROW, "Expected '->' after match pattern")) {
+                return nullptr;
+            }
+
+            Statement* Body;
+            if (Check(ETokenType::LEFT_BRACE) || StartsStatement(Current.Type)) {
+                Body = ParseStatement();
+            } else {
+                const Token Start = Current;
+                Expression* Result = ParseExpression(0);
+                Body = Result != nullptr ? Make<ExpressionStatement>(Start, Result) : nullptr;
+                if (!Match(ETokenType::SEMICOLON)) {
+                    Match(ETokenType::COMMA);
+                }
+            }
+            if (Body == nullptr) {
+                return nullptr;
+            }
+
+            Cases.emplace_back(Pattern, Body);
+        }
+
+        auto* Result = Make<MatchStatement>(Keyword, Value);
+        Result->Cases = Context.CreateArray(Cases);
+
+        Expect(ETokenType::RIGHT_BRACE, "Expected '}' after match cases");
+        return Result;
+    }
+
+    Statement* Parser::ParseExpressionStatement() {
+        const Token Start = Current;
+
+        Expression* Value = ParseExpression(0);
+        if (Value == nullptr) {
+            return nullptr;
+        }
+
+        auto* Result = Make<ExpressionStatement>(Start, Value);
+        Expect(ETokenType::SEMICOLON, "Expected ';' after expression");
+        return Result;
+    }
+
+    // ============================================================================
+    // DECLARATIONS
+    // ============================================================================
+
+    TranslationUnit* Parser::ParseTranslationUnit() {
+        auto* Unit = Make<TranslationUnit>(Current, SourceName);
+
+        std::vector<Declaration*> Declarations;
+        ParseDeclarations(Declarations, true);
+        Unit->Declarations = Context.CreateArray(Declarations);
+
+        return Unit;
+    }
+
+    void Parser::ParseDeclarations(std::vector<Declaration*>& Declarations, const bool IsTopLevel) {
+        while (!IsAtEnd()) {
+            if (Check(ETokenType::RIGHT_BRACE)) {
+                if (!IsTopLevel) {
+                    return;
+                }
+                Error(Current, "Unexpected '}'");
+                Advance();
+                Panicking = false;
+                continue;
+            }
+
+            const size_t Before = Consumed;
+
+            Declaration* Parsed = ParseDeclaration();
+            if (Parsed != nullptr) {
+                Declarations.push_back(Parsed);
+            }
+            if (Panicking) {
+                SynchronizeDeclaration();
+                if (Consumed == Before) {
+                    Advance();
+                }
+            }
+        }
+    }
+
+    Declaration* Parser::ParseDeclaration() {
+        if (Depth >= MaxDepth) {
+            Error(Current, "Declaration nested too deeply");
+            return nullptr;
+        }
+
+        ++Depth;
+        Declaration* Result;
+
+        switch (Current.Type) {
+            case ETokenType::AT: {
+                std::vector<std::string_view> Attributes;
+                while (Match(ETokenType::AT)) {
+                    if (!Check(ETokenType::IDENTIFIER)) {
+                        Error(Current, "Expected attribute name after '@'");
+                        --Depth;
+                        return nullptr;
+                    }
+                    Attributes.push_back(Intern(Advance()));
+                }
+                if (!Check(ETokenType::DEFINE)) {
+                    Error(Current, "Attributes must be followed by a Define");
+                    Result = nullptr;
+                } else {
+                    Result = ParseDefine(std::move(Attributes));
+                }
+                break;
+            }
+            case ETokenType::DEFINE:    Result = ParseDefine({}); break;
+            case ETokenType::FETCH:
+            case ETokenType::SET:       Result = ParseAccessorBlock(Current.Type); break;
+            case ETokenType::INTERFACE: Result = ParseInterface(); break;
+            case ETokenType::NAMESPACE: Result = ParseNamespace(); break;
+            case ETokenType::USING:     Result = ParseUsing(); break;
+            case ETokenType::GLOBAL:    Result = ParseGlobal(); break;
+            default: {
+                // Free function
+                const Token Start = Current;
+                Result = ParseMember(EAccessModifier::NONE);
+                if (Result != nullptr && Result->Is<FieldDeclaration>()) {
+                    Error(Start, "Fields must be declared inside a Define");
+                    Result = nullptr;
+                }
+                break;
+            }
+        }
+
+        --Depth;
+        return Result;
+    }
+
+    Declaration* Parser::ParseDefine(std::vector<std::string_view> Attributes) {
+        const Token Keyword = Advance();
+
+        if (!Check(ETokenType::IDENTIFIER)) {
+            Error(Current, "Expected type name after 'Define'");
+            return nullptr;
+        }
+        auto* Define = Make<DefineDeclaration>(Keyword, Intern(Advance()));
+        Define->Attributes = Context.CreateArray(Attributes);
+
+        std::vector<const TypeRef*> BaseTypes;
+        if (Match(ETokenType::COLON) && !ParseTypeList(BaseTypes)) {
+            return nullptr;
+        }
+        Define->BaseTypes = Context.CreateArray(BaseTypes);
+
+        if (!Expect(ETokenType::LEFT_BRACE, "Expected '{' after Define header")) {
+            return nullptr;
+        }
+
+        std::vector<FieldDeclaration*> Fields;
+        std::vector<FunctionDeclaration*> Methods;
+        ParseMembers(&Fields, Methods);
+        Define->Fields = Context.CreateArray(Fields);
+        Define->Methods = Context.CreateArray(Methods);
+
+        Expect(ETokenType::RIGHT_BRACE, "Expected '}' after Define body");
+        return Define;
+    }
+
+    Declaration* Parser::ParseAccessorBlock(const ETokenType Keyword) {
+        const Token Start = Advance();
+
+        if (!Check(ETokenType::IDENTIFIER)) {
+            Error(Current, std::string("Expected type name after '") + Start.Lexeme + "'");
+            return nullptr;
+        }
+        const std::string_view Target = Intern(Advance());
+
+        if (!Expect(ETokenType::LEFT_BRACE, "Expected '{' after accessor target")) {
+            return nullptr;
+        }
+
+        std::vector<FunctionDeclaration*> Methods;
+        ParseMembers(nullptr, Methods);
+        Expect(ETokenType::RIGHT_BRACE, "Expected '}' after accessors");
+
+        if (Keyword == ETokenType::FETCH) {
+            auto* Fetch = Make<FetchDeclaration>(Start, Target);
+            Fetch->Methods = Context.CreateArray(Methods);
+            return Fetch;
+        }
+
+        auto* Set = Make<SetDeclaration>(Start, Target);
+        Set->Methods = Context.CreateArray(Methods);
+        return Set;
+    }
+
+    Declaration* Parser::ParseInterface() {
+        const Token Keyword = Advance();
+
+        if (!Check(ETokenType::IDENTIFIER)) {
+            Error(Current, "Expected interface name");
+            return nullptr;
+        }
+        auto* Interface = Make<InterfaceDeclaration>(Keyword, Intern(Advance()));
+
+        std::vector<const TypeRef*> BaseInterfaces;
+        if (Match(ETokenType::COLON) && !ParseTypeList(BaseInterfaces)) {
+            return nullptr;
+        }
+        Interface->BaseInterfaces = Context.CreateArray(BaseInterfaces);
+
+        if (!Expect(ETokenType::LEFT_BRACE, "Expected '{' after Interface header")) {
+            return nullptr;
+        }
+
+        std::vector<FunctionDeclaration*> Methods;
+        ParseMembers(nullptr, Methods);
+        Interface->Methods = Context.CreateArray(Methods);
+
+        Expect(ETokenType::RIGHT_BRACE, "Expected '}' after Interface body");
+        return Interface;
+    }
+
+    Declaration* Parser::ParseNamespace() {
+        const Token Keyword = Advance();
+
+        const std::string_view Name = ParseQualifiedName("Expected namespace name");
+        if (Name.empty() || !Expect(ETokenType::LEFT_BRACE, "Expected '{' after namespace name")) {
+            return nullptr;
+        }
+
+        std::vector<Declaration*> Declarations;
+        ParseDeclarations(Declarations, false);
+
+        auto* Namespace = Make<NamespaceDeclaration>(Keyword, Name);
+        Namespace->Declarations = Context.CreateArray(Declarations);
+
+        Expect(ETokenType::RIGHT_BRACE, "Expected '}' after namespace body");
+        return Namespace;
+    }
+
+    Declaration* Parser::ParseUsing() {
+        const Token Keyword = Advance();
+
+        const std::string_view Path = ParseQualifiedName("Expected name after 'Using'");
+        if (Path.empty()) {
+            return nullptr;
+        }
+
+        auto* Using = Make<UsingDeclaration>(Keyword, Path);
+        Expect(ETokenType::SEMICOLON, "Expected ';' after Using");
+        return Using;
+    }
+
+    Declaration* Parser::ParseGlobal() {
+        const Token Keyword = Advance();
+
+        if (!Check(ETokenType::VAR) && !Check(ETokenType::LET) && !Check(ETokenType::CONST)) {
+            Error(Current, "Expected 'Var', 'Let' or 'Const' after 'global'");
+            return nullptr;
+        }
+
+        auto* Variable = static_cast<VariableDeclaration*>(ParseVariable());
+        return Variable != nullptr ? Make<GlobalDeclaration>(Keyword, Variable) : nullptr;
+    }
+
+    bool Parser::ParseTypeList(std::vector<const TypeRef*>& Types) {
+        do {
+            const TypeRef* Type = ParseType();
+            if (Type == nullptr) {
+                return false;
+            }
+            Types.push_back(Type);
+        } while (Match(ETokenType::COMMA));
+
+        return true;
+    }
+
+    void Parser::ParseMembers(std::vector<FieldDeclaration*>* Fields, std::vector<FunctionDeclaration*>& Methods) {
+        EAccessModifier Access = EAccessModifier::NONE;
+
+        while (!Check(ETokenType::RIGHT_BRACE) && !IsAtEnd()) {
+            const size_t Before = Consumed;
+
+            // "Public:" applies to every member up to the next label
+            if (IsAccessKeyword(Current.Type)) {
+                Access = ToAccessModifier(Advance().Type);
+                Expect(ETokenType::COLON, "Expected ':' after access modifier");
+            } else {
+                const Token Start = Current;
+                Declaration* Member = ParseMember(Access);
+
+                if (auto* Field = Member != nullptr ? Member->As<FieldDeclaration>() : nullptr) {
+                    if (Fields != nullptr) {
+                        Fields->push_back(Field);
+                    } else {
+                        Error(Start, "Fields are only allowed in a Define");
+                    }
+                } else if (Member != nullptr) {
+                    Methods.push_back(static_cast<FunctionDeclaration*>(Member));
+                }
+            }
+
+            if (Panicking) {
+                SynchronizeDeclaration();
+                if (Consumed == Before) {
+                    Advance();
+                }
+            }
+        }
+    }
+
+    Declaration* Parser::ParseMember(const EAccessModifier Access) {
+        const Token Start = Current;
+
+        // Modifiers in any order
+        Modifiers Flags;
+        for (bool IsModifier = true; IsModifier;) {
+            switch (Current.Type) {
+                case ETokenType::STATIC:    Flags.IsStatic = true; break;
+                case ETokenType::CONST:     Flags.IsConst = true; break;
+                case ETokenType::VIRTUAL:   Flags.IsVirtual = true; break;
+                case ETokenType::OVERRIDE:  Flags.IsOverride = true; break;
+                case ETokenType::IMPLEMENT: Flags.IsImplement = true; break;
+                default:                    IsModifier = false; continue;
+            }
+            Advance();
+        }
+
+        std::string_view Name;
+        if (Match(ETokenType::OPERATOR)) {
+            Flags.IsOperator = true;
+            if (Match(ETokenType::LEFT_BRACKET)) {
+                if (!Expect(ETokenType::RIGHT_BRACKET, "Expected ']' after 'Operator ['")) {
+                    return nullptr;
+                }
+                Name = Context.Intern("[]");
+            } else if (IsOverloadableOperator(Current.Type)) {
+                Name = Intern(Advance());
+            } else {
+                Error(Current, "Expected an operator symbol after 'Operator'");
+                return nullptr;
+            }
+        } else if (Check(ETokenType::IDENTIFIER)) {
+            Name = Intern(Advance());
+        } else {
+            Error(Current, "Expected member name");
+            return nullptr;
+        }
+
+        if (Check(ETokenType::LEFT_PAREN)) {
+            if (Flags.IsConst) {
+                Error(Start, "Methods cannot be Const");
+                return nullptr;
+            }
+            return ParseFunction(Start, Name, Access, Flags);
+        }
+
+        if (!Match(ETokenType::ARROW)) {
+            Error(Current, "Expected '(' or '->' after member name");
+            return nullptr;
+        }
+        if (Flags.IsVirtual || Flags.IsOverride || Flags.IsImplement || Flags.IsOperator) {
+            Error(Start, "Only Static and Const apply to fields");
+            return nullptr;
+        }
+
+        // Field: Name -> Type [= Initializer];
+        const TypeRef* Type = ParseType();
+        if (Type == nullptr) {
+            return nullptr;
+        }
+
+        Expression* Initializer = nullptr;
+        if (Match(ETokenType::ASSIGN)) {
+            Initializer = ParseExpression(0);
+            if (Initializer == nullptr) {
+                return nullptr;
+            }
+        }
+
+        auto* Field = Make<FieldDeclaration>(Start, Access, Name, Type, Initializer);
+        Field->IsStatic = Flags.IsStatic;
+        Field->IsConst = Flags.IsConst;
+
+        Expect(ETokenType::SEMICOLON, "Expected ';' after field");
+        return Field;
+    }
+
+    FunctionDeclaration* Parser::ParseFunction(const Token& Start, const std::string_view Name,
+                                               const EAccessModifier Access, const Modifiers& Flags) {
+        Advance(); // (
+
+        std::vector<Parameter> Parameters;
+        if (!Check(ETokenType::RIGHT_PAREN)) {
+            do {
+                if (!Check(ETokenType::IDENTIFIER)) {
+                    Error(Current, "Expected parameter name");
+                    return nullptr;
+                }
+                const std::string_view ParameterName = Intern(Advance());
+
+                if (!Expect(ETokenType::COLON, "Expected ':' after parameter name")) {
+                    return nullptr;
+                }
+                const TypeRef* Type = ParseType();
+                if (Type == nullptr) {
+                    return nullptr;
+                }
+
+                Parameter& Added = Parameters.emplace_back(ParameterName, Type);
+                if (Match(ETokenType::ASSIGN)) {
+                    Added.DefaultValue = ParseExpression(0);
+                    if (Added.DefaultValue == nullptr) {
+                        return nullptr;
+                    }
+                }
+            } while (Match(ETokenType::COMMA));
+        }
+
+        if (!Expect(ETokenType::RIGHT_PAREN, "Expected ')' after parameters")) {
+            return nullptr;
+        }
+
+        const TypeRef* ReturnType = nullptr;
+        if (Match(ETokenType::ARROW)) {
+            ReturnType = ParseType();
+            if (ReturnType == nullptr) {
+                return nullptr;
+            }
+        }
+
+        BlockStatement* Body = nullptr;
+        DeferredBody* Deferred = nullptr;
+        if (Check(ETokenType::LEFT_BRACE) && DeferredFunctions != nullptr) {
+            Deferred = SkipBlock();
+            if (Deferred == nullptr) {
+                return nullptr;
+            }
+        } else if (Check(ETokenType::LEFT_BRACE)) {
+            Body = ParseBlock();
+            if (Body == nullptr) {
+                return nullptr;
+            }
+        } else if (!Expect(ETokenType::SEMICOLON, "Expected '{' or ';' after function signature")) {
+            return nullptr;
+        }
+
+        auto* Function = Make<FunctionDeclaration>(Start, Access, Name, ReturnType, Body);
+        Function->Parameters = Context.CreateArray(Parameters);
+        Function->IsStatic = Flags.IsStatic;
+        Function->IsVirtual = Flags.IsVirtual;
+        Function->IsOverride = Flags.IsOverride;
+        Function->IsImplement = Flags.IsImplement;
+        Function->IsOperator = Flags.IsOperator;
+
+        if (Deferred != nullptr) {
+            Function->Deferred = Deferred;
+            DeferredFunctions->push_back(Function);
+        }
+        return Function;
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ASTContext.h"
+#include "Declaration.h"
+#include "Lexer.h"
+#include "Precedence.h"
+
+namespace Vex {
+
+    /**
+     * A syntax error and where it was found
+     */
+    struct ParseError {
+        std::string    Message;
+        SourceLocation Location;
+
+        [[nodiscard]] std::string ToString() const;
+    };
+
+    /**
+     * Recursive-descent parser with a Pratt expression core
+     *
+     * Tokens are pulled from Lexer::NextToken() one at a time and at most
+     * one token of lookahead is buffered; no token vector is ever built.
+     * Expressions are parsed by precedence climbing over the constexpr
+     * binding-power table in Precedence.h, so a left-associative chain of
+     * any length is a loop rather than a recursion.
+     *
+     * Nodes, names and types go into the given ASTContext. Errors do not
+     * stop the parse: each one is recorded, the parser skips to the next
+     * statement or declaration boundary, and the returned tree holds
+     * everything that did parse.
+     *
+     * Example:
+     *   ASTContext Context;
+     *   Parser Parser(Source, Context, "Player.vex");
+     *   TranslationUnit* Unit = Parser.ParseTranslationUnit();
+     *   for (const auto& Error : Parser.GetErrors()) { std::cerr << Error.ToString() << "\n"; }
+     */
+    class Parser {
+    public:
+        /**
+         * Start is where Source begins in its file; a slice cut out of a
+         * larger file passes its own position so locations stay absolute.
+         */
+        Parser(std::string Source, ASTContext& Context, std::string_view SourceName = "",
+               SourceLocation Start = { 1, 1 });
+
+        /** Parses declarations up to the end of the input */
+        TranslationUnit* ParseTranslationUnit();
+
+        /** Parses a single expression (the input should hold nothing else) */
+        Expression* ParseExpression();
+
+        /** Parses a single statement */
+        Statement* ParseStatement();
+
+        [[nodiscard]] bool HasErrors() const { return !Errors.empty(); }
+        [[nodiscard]] const std::vector<ParseError>& GetErrors() const { return Errors; }
+
+        /**
+         * Skips function bodies instead of parsing them: each function gets
+         * a DeferredBody (Body stays nullptr) and is appended to Functions.
+         * Pass nullptr to parse bodies again. See LazyParser.
+         */
+        void DeferBodies(std::vector<FunctionDeclaration*>* Functions) { DeferredFunctions = Functions; }
+
+        /** Deepest nesting of expressions and blocks before the parser gives up */
+        static constexpr int MaxDepth = 1000;
+
+    private:
+        ASTContext&      Context;
+        Lexer            Source;
+        std::string_view SourceName;
+
+        Token Current;                      // Next token to consume (the one-token lookahead)
+        SourceLocation PreviousEnd;         // Just past the last consumed token
+        size_t Consumed = 0;                // Tokens consumed so far, to detect stalls
+
+        std::vector<ParseError> Errors;
+        bool Panicking = false;             // Suppresses cascading errors until resynchronized
+        int  Depth = 0;
+
+        std::vector<FunctionDeclaration*>* DeferredFunctions = nullptr;
+
+        // ---- Tokens ----
+
+        Token Advance();
+        Token Pull();
+        [[nodiscard]] bool Check(ETokenType Type) const { return Current.Type == Type; }
+        bool Match(ETokenType Type);
+        bool Expect(ETokenType Type, const char* Message);
+        [[nodiscard]] bool IsAtEnd() const { return Current.Type == ETokenType::END_OF_FILE; }
+        [[nodiscard]] bool IsAdjacent() const;
+
+        void Error(const Token& At, const std::string& Message);
+        void SynchronizeStatement();
+        void SynchronizeDeclaration();
+
+        template<typename T, typename... ArgTypes>
+        T* Make(const Token& At, ArgTypes&&... Arguments) {
+            T* Node = Context.Create<T>(std::forward<ArgTypes>(Arguments)...);
+            Node->Location = { At.Line, At.Column };
+            return Node;
+        }
+
+        std::string_view Intern(const Token& Name) { return Context.Intern(Name.Lexeme); }
+        std::string_view ParseQualifiedName(const char* Message);
+
+        // ---- Expressions ----
+
+        Expression* ParseExpression(uint8_t MinPower);
+        Expression* ParsePrefix();
+        Expression* ParseInfix(Expression* Left, const Token& Operator, BindingPower Power);
+        bool ParseArguments(std::vector<Expression*>& Arguments);
+
+        // ---- Types ----
+
+        const TypeRef* ParseType();
+
+        // ---- Statements ----
+
+        BlockStatement* ParseBlock();
+        DeferredBody* SkipBlock();
+        Statement* ParseVariable();
+        Statement* ParseIf();
+        Statement* ParseWhile();
+        Statement* ParseDoWhile();
+        Statement* ParseFor();
+        Statement* ParseReturn();
+        Statement* ParseMatch();
+        Statement* ParseJump();
+        Statement* ParseExpressionStatement();
+
+        // ---- Declarations ----
+
+        Declaration* ParseDeclaration();
+        Declaration* ParseDefine(std::vector<std::string_view> Attributes);
+        Declaration* ParseAccessorBlock(ETokenType Keyword);
+        Declaration* ParseInterface();
+        Declaration* ParseNamespace();
+        Declaration* ParseUsing();
+        Declaration* ParseGlobal();
+
+        struct Modifiers {
+            bool IsStatic    = false;
+            bool IsConst     = false;
+            bool IsVirtual   = false;
+            bool IsOverride  = false;
+            bool IsImplement = false;
+            bool IsOperator  = false;
+        };
+
+        Declaration* ParseMember(EAccessModifier Access);
+        FunctionDeclaration* ParseFunction(const Token& Start, std::string_view Name, EAccessModifier Access,
+                                           const Modifiers& Flags);
+        void ParseMembers(std::vector<FieldDeclaration*>* Fields, std::vector<FunctionDeclaration*>& Methods);
+        void ParseDeclarations(std::vector<Declaration*>& Declarations, bool IsTopLevel);
+        bool ParseTypeList(std::vector<const TypeRef*>& Types);
+    };
+}
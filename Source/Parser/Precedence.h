@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Expression.h"
+#include "TokenEnums.h"
+
+namespace Vex {
+
+    /**
+     * Operator tiers, loosest first
+     *
+     *   Assignment      = += -= *= /= %=        right
+     *   Ternary         ? :                     right
+     *   NullCoalesce    ??                      right
+     *   LogicalOr       ||
+     *   LogicalAnd      &&
+     *   BitwiseOr       |
+     *   BitwiseXor      ^
+     *   BitwiseAnd      &
+     *   Equality        == != === !==
+     *   Comparison      < > <= >=
+     *   Range           .. ..=
+     *   Shift           << >>
+     *   Additive        + -
+     *   Multiplicative  * / %
+     *   Cast            as
+     *   Prefix          - + ! ~                 (operand only)
+     *   Power           **                      right, so -2 ** 2 is -(2 ** 2)
+     *   Postfix         () [] . ?.
+     */
+    enum class EPrecedence : uint8_t {
+        None,
+        Assignment,
+        Ternary,
+        NullCoalesce,
+        LogicalOr,
+        LogicalAnd,
+        BitwiseOr,
+        BitwiseXor,
+        BitwiseAnd,
+        Equality,
+        Comparison,
+        Range,
+        Shift,
+        Additive,
+        Multiplicative,
+        Cast,
+        Prefix,
+        Power,
+        Postfix,
+    };
+
+    /**
+     * How an infix or postfix token binds (Pratt parsing)
+     *
+     * An operator is taken while its Left power is at least the minimum
+     * the caller asked for; its right operand is then parsed with Right
+     * as the new minimum. Left-associative tiers use (2p, 2p + 1) and
+     * right-associative ones (2p + 1, 2p), so equal operators group the
+     * right way without any special cases. Left == 0 means the token does
+     * not continue an expression.
+     */
+    struct BindingPower {
+        uint8_t   Left    = 0;
+        uint8_t   Right   = 0;
+        EBinaryOp Op      = EBinaryOp::Add;    // Meaningful only when IsBinary
+        bool      IsBinary = false;            // false: ternary, cast or postfix
+    };
+
+    constexpr size_t TokenTypeCount = static_cast<size_t>(ETokenType::UNKNOWN) + 1;
+
+    namespace Detail {
+        constexpr BindingPower LeftAssociative(const EPrecedence Tier, const EBinaryOp Op) {
+            const auto Power = static_cast<uint8_t>(static_cast<uint8_t>(Tier) * 2);
+            return { Power, static_cast<uint8_t>(Power + 1), Op, true };
+        }
+
+        constexpr BindingPower RightAssociative(const EPrecedence Tier, const EBinaryOp Op) {
+            const auto Power = static_cast<uint8_t>(static_cast<uint8_t>(Tier) * 2);
+            return { static_cast<uint8_t>(Power + 1), Power, Op, true };
+        }
+
+        constexpr BindingPower Special(const EPrecedence Tier) {
+            const auto Power = static_cast<uint8_t>(static_cast<uint8_t>(Tier) * 2);
+            return { static_cast<uint8_t>(Power + 1), Power, EBinaryOp::Add, false };
+        }
+
+        constexpr std::array<BindingPower, TokenTypeCount> BuildInfixTable() {
+            std::array<BindingPower, TokenTypeCount> Table{};
+            const auto Set = [&Table](const ETokenType Type, const BindingPower Power) {
+                Table[static_cast<size_t>(Type)] = Power;
+            };
+
+            Set(ETokenType::ASSIGN,          RightAssociative(EPrecedence::Assignment, EBinaryOp::Assign));
+            Set(ETokenType::PLUS_ASSIGN,     RightAssociative(EPrecedence::Assignment, EBinaryOp::AddAssign));
+            Set(ETokenType::MINUS_ASSIGN,    RightAssociative(EPrecedence::Assignment, EBinaryOp::SubtractAssign));
+            Set(ETokenType::STAR_ASSIGN,     RightAssociative(EPrecedence::Assignment, EBinaryOp::MultiplyAssign));
+            Set(ETokenType::SLASH_ASSIGN,    RightAssociative(EPrecedence::Assignment, EBinaryOp::DivideAssign));
+            Set(ETokenType::PERCENT_ASSIGN,  RightAssociative(EPrecedence::Assignment, EBinaryOp::ModuloAssign));
+
+            Set(ETokenType::QUESTION,        Special(EPrecedence::Ternary));
+            Set(ETokenType::DOUBLE_QUESTION, RightAssociative(EPrecedence::NullCoalesce, EBinaryOp::NullCoalesce));
+
+            Set(ETokenType::OR,              LeftAssociative(EPrecedence::LogicalOr, EBinaryOp::LogicalOr));
+            Set(ETokenType::AND,             LeftAssociative(EPrecedence::LogicalAnd, EBinaryOp::LogicalAnd));
+            Set(ETokenType::BITWISE_OR,      LeftAssociative(EPrecedence::BitwiseOr, EBinaryOp::BitwiseOr));
+            Set(ETokenType::BITWISE_XOR,     LeftAssociative(EPrecedence::BitwiseXor, EBinaryOp::BitwiseXor));
+            Set(ETokenType::BITWISE_AND,     LeftAssociative(EPrecedence::BitwiseAnd, EBinaryOp::BitwiseAnd));
+
+            Set(ETokenType::EQUAL,           LeftAssociative(EPrecedence::Equality, EBinaryOp::Equal));
+            Set(ETokenType::NOT_EQUAL,       LeftAssociative(EPrecedence::Equality, EBinaryOp::NotEqual));
+            Set(ETokenType::TYPE_VAL_EQ,     LeftAssociative(EPrecedence::Equality, EBinaryOp::TypeValueEq));
+            Set(ETokenType::TYPE_VAL_NEQ,    LeftAssociative(EPrecedence::Equality, EBinaryOp::TypeValueNeq));
+
+            Set(ETokenType::LESS,            LeftAssociative(EPrecedence::Comparison, EBinaryOp::Less));
+            Set(ETokenType::GREATER,         LeftAssociative(EPrecedence::Comparison, EBinaryOp::Greater));
+            Set(ETokenType::LESS_EQUAL,      LeftAssociative(EPrecedence::Comparison, EBinaryOp::LessEqual));
+            Set(ETokenType::GREATER_EQUAL,   LeftAssociative(EPrecedence::Comparison, EBinaryOp::GreaterEqual));
+
+            Set(ETokenType::DOUBLE_DOT,      LeftAssociative(EPrecedence::Range, EBinaryOp::Range));
+            Set(ETokenType::DOT_DOT_EQUAL,   LeftAssociative(EPrecedence::Range, EBinaryOp::RangeInclusive));
+
+            Set(ETokenType::LEFT_SHIFT,      LeftAssociative(EPrecedence::Shift, EBinaryOp::LeftShift));
+            Set(ETokenType::RIGHT_SHIFT,     LeftAssociative(EPrecedence::Shift, EBinaryOp::RightShift));
+
+            Set(ETokenType::PLUS,            LeftAssociative(EPrecedence::Additive, EBinaryOp::Add));
+            Set(ETokenType::MINUS,           LeftAssociative(EPrecedence::Additive, EBinaryOp::Subtract));
+
+            Set(ETokenType::STAR,            LeftAssociative(EPrecedence::Multiplicative, EBinaryOp::Multiply));
+            Set(ETokenType::SLASH,           LeftAssociative(EPrecedence::Multiplicative, EBinaryOp::Divide));
+            Set(ETokenType::PERCENT,         LeftAssociative(EPrecedence::Multiplicative, EBinaryOp::Modulo));
+
+            Set(ETokenType::AS,              Special(EPrecedence::Cast));
+            Set(ETokenType::POWER,           RightAssociative(EPrecedence::Power, EBinaryOp::Power));
+
+            Set(ETokenType::LEFT_PAREN,      Special(EPrecedence::Postfix));
+            Set(ETokenType::LEFT_BRACKET,    Special(EPrecedence::Postfix));
+            Set(ETokenType::DOT,             Special(EPrecedence::Postfix));
+            Set(ETokenType::QUESTION_DOT,    Special(EPrecedence::Postfix));
+
+            return Table;
+        }
+    }
+
+    /** Infix/postfix binding powers, indexed by ETokenType */
+    inline constexpr std::array<BindingPower, TokenTypeCount> InfixBindingPowers = Detail::BuildInfixTable();
+
+    constexpr BindingPower GetInfixBindingPower(const ETokenType Type) {
+        return InfixBindingPowers[static_cast<size_t>(Type)];
+    }
+
+    /** Minimum power for the operand of a prefix operator */
+    constexpr uint8_t PrefixBindingPower = static_cast<uint8_t>(EPrecedence::Prefix) * 2;
+
+    static_assert(GetInfixBindingPower(ETokenType::STAR).Left > GetInfixBindingPower(ETokenType::PLUS).Left);
+    static_assert(GetInfixBindingPower(ETokenType::POWER).Left > PrefixBindingPower);
+    static_assert(GetInfixBindingPower(ETokenType::AS).Left < PrefixBindingPower);
+    static_assert(GetInfixBindingPower(ETokenType::SEMICOLON).Left == 0);
+}
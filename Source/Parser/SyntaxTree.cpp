@@ -0,0 +1,834 @@
+#include "SyntaxTree.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Vex {
+
+    // ---- GreenRef ----
+
+    GreenRef::GreenRef(const GreenNode* Node) : Node(Node) {
+        if (Node != nullptr) {
+            Node->References.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    GreenRef::GreenRef(const GreenRef& Other) : GreenRef(Other.Node) {}
+
+    GreenRef::GreenRef(GreenRef&& Other) noexcept : Node(std::exchange(Other.Node, nullptr)) {}
+
+    GreenRef& GreenRef::operator=(GreenRef Other) noexcept {
+        std::swap(Node, Other.Node);
+        return *this;
+    }
+
+    GreenRef::~GreenRef() {
+        Release(Node);
+    }
+
+    void GreenRef::Release(const GreenNode* Node) {
+        if (Node == nullptr || Node->References.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        // Detach the children of each dead node before deleting it, so no destructor recurses
+        std::vector<const GreenNode*> Dead{ Node };
+        while (!Dead.empty()) {
+            const GreenNode* Current = Dead.back();
+            Dead.pop_back();
+
+            for (GreenRef& Child : const_cast<GreenNode*>(Current)->Children) {
+                const GreenNode* Orphan = std::exchange(Child.Node, nullptr);
+                if (Orphan->References.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    Dead.push_back(Orphan);
+                }
+            }
+            delete Current;
+        }
+    }
+
+    namespace {
+        /** Nodes borrowed from trees that outlive the edit */
+        using Units = std::vector<const GreenNode*>;
+
+        constexpr size_t MaxListSize = SyntaxTree::MaxListSize;
+
+        // ---- Building nodes ----
+
+        /** Adds Child after everything Node already covers */
+        void Append(GreenNode& Node, const GreenNode* Child) {
+            Node.Tail = Child->Lines > 0 ? Child->Tail : Node.Tail + Child->Width;
+            Node.Width += Child->Width;
+            Node.Lines += Child->Lines;
+            Node.Leaves += Child->Leaves;
+            Node.Children.emplace_back(Child);
+        }
+
+        GreenRef MakeToken(const ETokenType Type, std::string Text, const size_t Trivia, const int Lines,
+                           const int Tail) {
+            auto* Node = new GreenNode();
+            Node->Type = Type;
+            Node->Balanced = Type != ETokenType::LEFT_BRACE && Type != ETokenType::RIGHT_BRACE;
+            Node->Width = static_cast<uint32_t>(Text.size());
+            Node->Lines = static_cast<uint32_t>(Lines);
+            Node->Tail = Lines > 0 ? static_cast<uint32_t>(Tail) : Node->Width;
+            Node->Leaves = 1;
+            Node->Trivia = static_cast<uint32_t>(Trivia);
+            Node->Text = std::move(Text);
+            return GreenRef(Node);
+        }
+
+        GreenRef MakeBlock(const GreenNode* Open, const GreenNode* Content, const GreenNode* Close) {
+            auto* Node = new GreenNode();
+            Node->Kind = ESyntaxKind::Block;
+            Node->Children.reserve(3);
+            Append(*Node, Open);
+            Append(*Node, Content);
+            if (Close != nullptr) {
+                Append(*Node, Close);
+            }
+            Node->Balanced = Close != nullptr && Content->Balanced;
+            return GreenRef(Node);
+        }
+
+        GreenRef MakeList(const GreenNode* const* Children, const size_t Count, const uint8_t Height) {
+            auto* Node = new GreenNode();
+            Node->Kind = ESyntaxKind::List;
+            Node->Height = Height;
+            Node->Units = 0;
+            Node->Children.reserve(Count);
+            for (size_t Index = 0; Index < Count; ++Index) {
+                Append(*Node, Children[Index]);
+                Node->Units += Children[Index]->Units;
+                Node->Balanced = Node->Balanced && Children[Index]->Balanced;
+            }
+            return GreenRef(Node);
+        }
+
+        /** Splits Children evenly into lists of at most MaxListSize */
+        void Chunk(const Units& Children, const uint8_t Height, std::vector<GreenRef>& Out) {
+            const size_t Count = (Children.size() + MaxListSize - 1) / MaxListSize;
+            size_t Position = 0;
+            for (size_t Index = 0; Index < Count; ++Index) {
+                const size_t Size = Children.size() / Count + (Index < Children.size() % Count ? 1 : 0);
+                Out.push_back(MakeList(Children.data() + Position, Size, Height));
+                Position += Size;
+            }
+        }
+
+        /** Stacks lists of one height until a single list remains */
+        GreenRef Collapse(std::vector<GreenRef> Level, uint8_t Height) {
+            while (Level.size() > 1) {
+                Units Children;
+                Children.reserve(Level.size());
+                for (const auto& Piece : Level) {
+                    Children.push_back(Piece.Get());
+                }
+
+                std::vector<GreenRef> Next;
+                Chunk(Children, ++Height, Next);
+                Level = std::move(Next);
+            }
+
+            if (Level.empty()) {
+                return MakeList(nullptr, 0, 1);
+            }
+
+            // Deletions can leave a chain of single-child lists at the top
+            GreenRef Result = std::move(Level.front());
+            while (Result->Height > 1 && Result->Children.size() == 1) {
+                Result = GreenRef(Result->Children.front());
+            }
+            return Result;
+        }
+
+        GreenRef BuildList(const Units& Items) {
+            std::vector<GreenRef> Level;
+            Chunk(Items, 1, Level);
+            return Collapse(std::move(Level), 1);
+        }
+
+        /**
+         * Units [From, To) of List replaced by New, as lists of List's
+         * height. Only the lists on the paths to From and To are rebuilt.
+         */
+        void Replace(const GreenNode& List, const uint32_t From, const uint32_t To, const Units& New,
+                     std::vector<GreenRef>& Out) {
+            Units Children;
+            std::vector<GreenRef> Pieces;
+
+            if (List.Height == 1) {
+                Children.reserve(List.Children.size() - (To - From) + New.size());
+                for (uint32_t Index = 0; Index < From; ++Index) {
+                    Children.push_back(List.Children[Index].Get());
+                }
+                Children.insert(Children.end(), New.begin(), New.end());
+                for (size_t Index = To; Index < List.Children.size(); ++Index) {
+                    Children.push_back(List.Children[Index].Get());
+                }
+            } else {
+                static const Units None;
+
+                uint32_t Start = 0;
+                for (const GreenRef& Child : List.Children) {
+                    const uint32_t End = Start + Child->Units;
+                    if (End <= From || Start >= To) {
+                        Children.push_back(Child.Get());
+                    } else {
+                        const size_t First = Pieces.size();
+                        Replace(*Child, std::max(From, Start) - Start, std::min(To, End) - Start,
+                                Start <= From ? New : None, Pieces);
+                        for (size_t Index = First; Index < Pieces.size(); ++Index) {
+                            Children.push_back(Pieces[Index].Get());
+                        }
+                    }
+                    Start = End;
+                }
+            }
+
+            Chunk(Children, List.Height, Out);
+        }
+
+        GreenRef ReplaceUnits(const GreenNode& List, const uint32_t From, const uint32_t To, const Units& New) {
+            std::vector<GreenRef> Level;
+            Replace(List, From, To, New, Level);
+            return Collapse(std::move(Level), List.Height);
+        }
+
+        /** Right appended to Left as lists of Left's or Right's height, whichever is taller */
+        void Join(const GreenNode& Left, const GreenNode& Right, std::vector<GreenRef>& Out) {
+            Units Children;
+            std::vector<GreenRef> Pieces;
+
+            if (Left.Height > Right.Height) {
+                Join(*Left.Children.back(), Right, Pieces);
+                for (size_t Index = 0; Index + 1 < Left.Children.size(); ++Index) {
+                    Children.push_back(Left.Children[Index].Get());
+                }
+                for (const auto& Piece : Pieces) {
+                    Children.push_back(Piece.Get());
+                }
+            } else if (Left.Height < Right.Height) {
+                Join(Left, *Right.Children.front(), Pieces);
+                for (const auto& Piece : Pieces) {
+                    Children.push_back(Piece.Get());
+                }
+                for (size_t Index = 1; Index < Right.Children.size(); ++Index) {
+                    Children.push_back(Right.Children[Index].Get());
+                }
+            } else {
+                for (const auto& Child : Left.Children) {
+                    Children.push_back(Child.Get());
+                }
+                for (const auto& Child : Right.Children) {
+                    Children.push_back(Child.Get());
+                }
+            }
+
+            Chunk(Children, std::max(Left.Height, Right.Height), Out);
+        }
+
+        /** One list of Left's units followed by Right's; only their facing edges are rebuilt */
+        GreenRef Join(const GreenRef& Left, const GreenNode& Right) {
+            if (Right.Units == 0) {
+                return Left;
+            }
+            if (Left->Units == 0) {
+                return GreenRef(&Right);
+            }
+
+            std::vector<GreenRef> Level;
+            Join(*Left, Right, Level);
+            return Collapse(std::move(Level), std::max(Left->Height, Right.Height));
+        }
+
+        /** A list of Items, which are units or whole lists; lists are joined in, not taken apart */
+        GreenRef BuildContent(const Units& Items) {
+            GreenRef Result = MakeList(nullptr, 0, 1);
+            Units Run;
+
+            for (const GreenNode* Item : Items) {
+                if (Item->Kind != ESyntaxKind::List) {
+                    Run.push_back(Item);
+                    continue;
+                }
+                if (!Run.empty()) {
+                    Result = Join(Result, *BuildList(Run));
+                    Run.clear();
+                }
+                Result = Join(Result, *Item);
+            }
+
+            if (!Run.empty()) {
+                Result = Join(Result, *BuildList(Run));
+            }
+            return Result;
+        }
+
+        /** Units [From, To) of List replaced by Items, which may hold whole lists */
+        GreenRef Splice(const GreenNode& List, const uint32_t From, const uint32_t To, const Units& Items) {
+            const bool Flat = std::none_of(Items.begin(), Items.end(),
+                                           [](const GreenNode* Item) { return Item->Kind == ESyntaxKind::List; });
+            if (Flat) {
+                return ReplaceUnits(List, From, To, Items);
+            }
+
+            const GreenRef Left = ReplaceUnits(List, From, List.Units, {});
+            const GreenRef Right = ReplaceUnits(List, 0, To, {});
+            return Join(Join(Left, *BuildContent(Items)), *Right);
+        }
+
+        // ---- Taking nodes apart ----
+
+        /**
+         * Appends what covers the first Leaves tokens of Node: whole
+         * subtrees where possible, opening only the blocks and lists cut
+         * through.
+         */
+        void CollectBefore(const GreenNode* Node, uint32_t Leaves, Units& Out) {
+            while (Leaves > 0) {
+                if (Leaves >= Node->Leaves) {
+                    Out.push_back(Node);
+                    return;
+                }
+                for (const GreenRef& Child : Node->Children) {
+                    if (Leaves < Child->Leaves) {
+                        Node = Child.Get();
+                        break;
+                    }
+                    Out.push_back(Child.Get());
+                    Leaves -= Child->Leaves;
+                }
+            }
+        }
+
+        /** Appends what covers Node's tokens from index Skip on, as CollectBefore() does */
+        void CollectAfter(const GreenNode* Node, uint32_t Skip, Units& Out) {
+            std::vector<std::pair<const GreenNode*, size_t>> Levels;   // Parent and first sibling to keep
+            const GreenNode* Whole = nullptr;
+
+            while (Skip < Node->Leaves) {
+                if (Skip == 0) {
+                    Whole = Node;
+                    break;
+                }
+                size_t Index = 0;
+                while (Skip >= Node->Children[Index]->Leaves) {
+                    Skip -= Node->Children[Index]->Leaves;
+                    ++Index;
+                }
+                Levels.emplace_back(Node, Index + 1);
+                Node = Node->Children[Index].Get();
+            }
+
+            if (Whole != nullptr) {
+                Out.push_back(Whole);
+            }
+            for (auto Level = Levels.rbegin(); Level != Levels.rend(); ++Level) {
+                for (size_t Index = Level->second; Index < Level->first->Children.size(); ++Index) {
+                    Out.push_back(Level->first->Children[Index].Get());
+                }
+            }
+        }
+
+        /** Unit of List holding token Leaf, with its index and first token */
+        const GreenNode* FindUnit(const GreenNode& List, const uint32_t Leaf, uint32_t& Unit, uint32_t& Start) {
+            const GreenNode* Node = &List;
+            Unit = 0;
+            Start = 0;
+
+            while (Node->Kind == ESyntaxKind::List) {
+                for (const GreenRef& Child : Node->Children) {
+                    if (Leaf < Start + Child->Leaves) {
+                        Node = Child.Get();
+                        break;
+                    }
+                    Start += Child->Leaves;
+                    Unit += Child->Units;
+                }
+            }
+            return Node;
+        }
+
+        /**
+         * Matches braces in Items and wraps each pair, with what lies
+         * between, into a block. Items are tokens, blocks and whole lists;
+         * balanced ones are kept as they are. Strict grouping fails on a
+         * stray '}', an unclosed '{' or an unbalanced item; tolerant
+         * grouping (the top level) keeps a stray '}' as a token, closes open
+         * blocks at the end and takes unbalanced items apart until their
+         * braces can be matched again.
+         */
+        bool Group(const Units& Items, const bool Tolerant, Units& Result, std::vector<GreenRef>& Created) {
+            struct Frame {
+                const GreenNode* Open = nullptr;
+                Units Items;
+            };
+
+            std::vector<Frame> Stack(1);
+            const auto Close = [&Stack, &Created](const GreenNode* CloseBrace) {
+                Frame Top = std::move(Stack.back());
+                Stack.pop_back();
+                const GreenRef Content = BuildContent(Top.Items);
+                Created.push_back(MakeBlock(Top.Open, Content.Get(), CloseBrace));
+                Stack.back().Items.push_back(Created.back().Get());
+            };
+
+            Units Work;
+            for (const GreenNode* Item : Items) {
+                Work.push_back(Item);
+                while (!Work.empty()) {
+                    const GreenNode* Node = Work.back();
+                    Work.pop_back();
+
+                    if (Node->Kind == ESyntaxKind::Token && Node->Type == ETokenType::LEFT_BRACE) {
+                        Stack.push_back({ Node, {} });
+                    } else if (Node->Kind == ESyntaxKind::Token && Node->Type == ETokenType::RIGHT_BRACE) {
+                        if (Stack.size() > 1) {
+                            Close(Node);
+                        } else if (Tolerant) {
+                            Stack.back().Items.push_back(Node);
+                        } else {
+                            return false;
+                        }
+                    } else if (Node->Balanced) {
+                        Stack.back().Items.push_back(Node);
+                    } else if (!Tolerant) {
+                        return false;
+                    } else {
+                        // An unclosed block or a list holding one or a stray '}': match its pieces again
+                        for (auto Child = Node->Children.rbegin(); Child != Node->Children.rend(); ++Child) {
+                            Work.push_back(Child->Get());
+                        }
+                    }
+                }
+            }
+
+            if (Stack.size() > 1 && !Tolerant) {
+                return false;
+            }
+            while (Stack.size() > 1) {
+                Close(nullptr);
+            }
+
+            Result = std::move(Stack.front().Items);
+            return true;
+        }
+
+        // ---- Lexing ----
+
+        /** Scans the next token of Source with its leading trivia; Previous is where the trivia begins */
+        GreenRef NextLeaf(Lexer& Lexer, const std::string& Source, size_t& Previous, bool& IsEnd) {
+            const int Line = Lexer.GetLine();
+            const Token Next = Lexer.NextToken();
+
+            IsEnd = Next.Type == ETokenType::END_OF_FILE;
+            const size_t End = Lexer.GetOffset();
+            const size_t Trivia = (IsEnd ? End : Lexer.GetTokenOffset()) - Previous;
+
+            GreenRef Leaf = MakeToken(Next.Type, Source.substr(Previous, End - Previous), Trivia,
+                                      Lexer.GetLine() - Line, Lexer.GetColumn() - 1);
+            Previous = End;
+            return Leaf;
+        }
+
+        /** Walks the tokens of a tree in order, starting at a given one */
+        class LeafCursor {
+        public:
+            LeafCursor(const GreenNode& Root, uint32_t Leaf) {
+                const GreenNode* Node = &Root;
+                while (Node->Kind != ESyntaxKind::Token) {
+                    size_t Index = 0;
+                    while (Leaf >= Node->Children[Index]->Leaves) {
+                        Leaf -= Node->Children[Index]->Leaves;
+                        ++Index;
+                    }
+                    Path.emplace_back(Node, Index);
+                    Node = Node->Children[Index].Get();
+                }
+                Current = Node;
+            }
+
+            [[nodiscard]] const GreenNode* Get() const { return Current; }
+
+            /** Moves to the next token; false after the last one */
+            bool Next() {
+                while (!Path.empty()) {
+                    auto& [Parent, Index] = Path.back();
+                    if (++Index == Parent->Children.size()) {
+                        Path.pop_back();
+                        continue;
+                    }
+
+                    const GreenNode* Node = Parent->Children[Index].Get();
+                    if (Node->Leaves == 0) {
+                        continue;
+                    }
+                    while (Node->Kind != ESyntaxKind::Token) {
+                        size_t First = 0;
+                        while (Node->Children[First]->Leaves == 0) {
+                            ++First;
+                        }
+                        Path.emplace_back(Node, First);
+                        Node = Node->Children[First].Get();
+                    }
+                    Current = Node;
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            std::vector<std::pair<const GreenNode*, size_t>> Path;
+            const GreenNode* Current = nullptr;
+        };
+
+        /** Token holding byte Offset, with its index and start */
+        uint32_t LocateLeaf(const GreenNode& Root, const size_t Offset, size_t& Start) {
+            const GreenNode* Node = &Root;
+            uint32_t Leaf = 0;
+            Start = 0;
+
+            while (Node->Kind != ESyntaxKind::Token) {
+                for (const GreenRef& Child : Node->Children) {
+                    if (Offset < Start + Child->Width) {
+                        Node = Child.Get();
+                        break;
+                    }
+                    Start += Child->Width;
+                    Leaf += Child->Leaves;
+                }
+            }
+            return Leaf;
+        }
+
+        SourceLocation After(const SourceLocation Location, const GreenNode& Node) {
+            if (Node.Lines > 0) {
+                return { Location.Line + static_cast<int>(Node.Lines), static_cast<int>(Node.Tail) + 1 };
+            }
+            return { Location.Line, Location.Column + static_cast<int>(Node.Width) };
+        }
+    }
+
+    // ---- SyntaxNode ----
+
+    SyntaxNode::SyntaxNode(const GreenNode& Green, const SyntaxNode* Parent, const size_t Offset,
+                           const SourceLocation Location)
+        : Green(Green)
+        , Parent(Parent)
+        , Offset(Offset)
+        , Location(Location) {}
+
+    const SyntaxNode* SyntaxNode::GetChild(const size_t Index) const {
+        if (Index >= Green.Children.size()) {
+            return nullptr;
+        }
+        if (Children.empty()) {
+            Children.resize(Green.Children.size());
+        }
+
+        if (Children[Index] == nullptr) {
+            size_t ChildOffset = Offset;
+            SourceLocation ChildLocation = Location;
+            for (size_t Before = 0; Before < Index; ++Before) {
+                ChildOffset += Green.Children[Before]->Width;
+                ChildLocation = After(ChildLocation, *Green.Children[Before]);
+            }
+            Children[Index] = std::make_unique<SyntaxNode>(*Green.Children[Index], this, ChildOffset, ChildLocation);
+        }
+        return Children[Index].get();
+    }
+
+    SourceLocation SyntaxNode::GetTokenLocation() const {
+        const SyntaxNode* Node = this;
+        while (Node->GetKind() != ESyntaxKind::Token) {
+            size_t Index = 0;
+            while (Index < Node->GetChildCount() && Node->Green.Children[Index]->Leaves == 0) {
+                ++Index;
+            }
+            if (Index == Node->GetChildCount()) {
+                return Location;
+            }
+            Node = Node->GetChild(Index);
+        }
+
+        // Every newline in trivia counts; literals cannot occur there
+        SourceLocation Result = Node->Location;
+        for (size_t Index = 0; Index < Node->Green.Trivia; ++Index) {
+            if (Node->Green.Text[Index] == '\n') {
+                ++Result.Line;
+                Result.Column = 1;
+            } else {
+                ++Result.Column;
+            }
+        }
+        return Result;
+    }
+
+    const SyntaxNode* SyntaxNode::FindToken(const size_t Target) const {
+        const SyntaxNode* Node = this;
+        while (Node->GetKind() != ESyntaxKind::Token) {
+            // Past the end only the zero-width tail can match: take the last token
+            size_t Index = 0;
+            size_t End = Node->Offset;
+            size_t Last = Node->GetChildCount();
+            for (; Index < Node->GetChildCount(); ++Index) {
+                const GreenNode& Child = *Node->Green.Children[Index];
+                if (Child.Leaves > 0) {
+                    Last = Index;
+                }
+                End += Child.Width;
+                if (Target < End && Child.Leaves > 0) {
+                    break;
+                }
+            }
+            if (Index == Node->GetChildCount()) {
+                if (Last == Node->GetChildCount()) {
+                    return nullptr;
+                }
+                Index = Last;
+            }
+            Node = Node->GetChild(Index);
+        }
+        return Node;
+    }
+
+    std::string SyntaxNode::GetText() const {
+        std::string Text;
+        Text.reserve(Green.Width);
+
+        std::vector<const GreenNode*> Stack{ &Green };
+        while (!Stack.empty()) {
+            const GreenNode* Node = Stack.back();
+            Stack.pop_back();
+
+            if (Node->Kind == ESyntaxKind::Token) {
+                Text += Node->Text;
+                continue;
+            }
+            for (auto Child = Node->Children.rbegin(); Child != Node->Children.rend(); ++Child) {
+                Stack.push_back(Child->Get());
+            }
+        }
+        return Text;
+    }
+
+    Statement* SyntaxNode::ToStatement(ASTContext& Context, const std::string_view SourceName,
+                                       std::vector<ParseError>* Errors) const {
+        Parser Parser(GetText(), Context, SourceName, Location);
+        Statement* Result = Parser.ParseStatement();
+        if (Errors != nullptr) {
+            *Errors = Parser.GetErrors();
+        }
+        return Result;
+    }
+
+    Expression* SyntaxNode::ToExpression(ASTContext& Context, const std::string_view SourceName,
+                                         std::vector<ParseError>* Errors) const {
+        Parser Parser(GetText(), Context, SourceName, Location);
+        Expression* Result = Parser.ParseExpression();
+        if (Errors != nullptr) {
+            *Errors = Parser.GetErrors();
+        }
+        return Result;
+    }
+
+    // ---- SyntaxTree ----
+
+    SyntaxTree::SyntaxTree(const std::string_view Source) {
+        const std::string Text(Source);
+        Lexer Lexer(Text);
+
+        std::vector<GreenRef> Leaves;
+        size_t Previous = 0;
+        for (bool IsEnd = false; !IsEnd;) {
+            Leaves.push_back(NextLeaf(Lexer, Text, Previous, IsEnd));
+        }
+
+        Units Items;
+        Items.reserve(Leaves.size());
+        for (const auto& Leaf : Leaves) {
+            Items.push_back(Leaf.Get());
+        }
+
+        Units Grouped;
+        std::vector<GreenRef> Created;
+        Group(Items, true, Grouped, Created);
+
+        Green = BuildContent(Grouped);
+        Root = std::make_unique<SyntaxNode>(*Green, nullptr, 0, SourceLocation{ 1, 1 });
+    }
+
+    SyntaxTree::SyntaxTree(GreenRef Green)
+        : Green(std::move(Green))
+        , Root(std::make_unique<SyntaxNode>(*this->Green, nullptr, 0, SourceLocation{ 1, 1 })) {}
+
+    SyntaxTree SyntaxTree::Edit(size_t Offset, size_t Length, const std::string_view Replacement) const {
+        const size_t Size = Green->Width;
+        Offset = std::min(Offset, Size);
+        Length = std::min(Length, Size - Offset);
+        if (Length == 0 && Replacement.empty()) {
+            return SyntaxTree(Green);
+        }
+
+        // ---- Relex ----
+        // A token before the edit can only change through the lexer's two
+        // characters of lookahead, so relexing starts at the token holding
+        // the byte two before it. It stops at the first new token that ends
+        // where an old one did, past the edit: from there on the lexer sees
+        // the same text in the same state, so the old tokens stand.
+
+        const size_t EditEnd = Offset + Length;
+        const size_t NewEditEnd = Offset + Replacement.size();
+
+        size_t FirstOffset = 0;
+        const uint32_t First = Size == 0 ? 0 : LocateLeaf(*Green, Offset >= 2 ? Offset - 2 : 0, FirstOffset);
+
+        LeafCursor Cursor(*Green, First);
+        std::string OldText;                        // Old tokens from First on, as far as gathered
+        std::vector<size_t> OldEnds;                // Their end offsets
+        size_t OldReach = FirstOffset;
+        bool AtEnd = false;                         // The end of file token was gathered
+
+        std::vector<GreenRef> NewLeaves;
+        size_t Replaced = 0;                        // Old tokens the new ones stand for
+
+        for (size_t Margin = 256; ; Margin *= 4) {
+            while (!AtEnd && OldReach < EditEnd + Margin) {
+                const GreenNode* Leaf = Cursor.Get();
+                OldText += Leaf->Text;
+                OldReach += Leaf->Width;
+                OldEnds.push_back(OldReach);
+                AtEnd = !Cursor.Next();
+            }
+
+            std::string Window = OldText.substr(0, Offset - FirstOffset);
+            Window += Replacement;
+            Window.append(OldText, EditEnd - FirstOffset, std::string::npos);
+
+            Lexer Lexer(Window);
+            NewLeaves.clear();
+            size_t Previous = 0;
+            size_t Old = 0;
+
+            while (Replaced == 0) {
+                bool IsEnd = false;
+                GreenRef Leaf = NextLeaf(Lexer, Window, Previous, IsEnd);
+                if (IsEnd && !AtEnd) {
+                    break;                          // Out of text: widen the window
+                }
+                NewLeaves.push_back(std::move(Leaf));
+                if (IsEnd) {
+                    Replaced = OldEnds.size();
+                    break;
+                }
+
+                // The token's end depends on the two characters after it
+                const size_t End = FirstOffset + Previous;
+                if (End < NewEditEnd || (!AtEnd && Previous + 2 > Window.size())) {
+                    continue;
+                }
+
+                const size_t OldEnd = End - Replacement.size() + Length;
+                while (Old < OldEnds.size() && OldEnds[Old] < OldEnd) {
+                    ++Old;
+                }
+                const bool IsOldEnd = AtEnd && Old + 1 == OldEnds.size();
+                if (Old < OldEnds.size() && OldEnds[Old] == OldEnd && !IsOldEnd) {
+                    Replaced = Old + 1;
+                }
+            }
+
+            if (Replaced != 0) {
+                break;
+            }
+        }
+
+        Units New;
+        New.reserve(NewLeaves.size());
+        for (const auto& Leaf : NewLeaves) {
+            New.push_back(Leaf.Get());
+        }
+
+        // ---- Regroup ----
+        // Descend to the innermost block whose contents hold every replaced
+        // token, then try to regroup there; if its braces no longer match,
+        // try the enclosing block instead.
+
+        struct Level {
+            const GreenNode* Content;               // List being edited
+            uint32_t From, To;                      // Replaced tokens within it
+            const GreenNode* A;                     // Units holding the first and the last of them
+            const GreenNode* B;
+            uint32_t UnitA, UnitB;
+            uint32_t StartA, StartB;                // Their first tokens
+        };
+
+        std::vector<Level> Levels;
+        const GreenNode* Content = Green.Get();
+        uint32_t From = First;
+        uint32_t To = First + static_cast<uint32_t>(Replaced);
+
+        while (true) {
+            Level Current{ Content, From, To, nullptr, nullptr, 0, 0, 0, 0 };
+            Current.A = FindUnit(*Content, From, Current.UnitA, Current.StartA);
+            Current.B = FindUnit(*Content, To - 1, Current.UnitB, Current.StartB);
+            Levels.push_back(Current);
+
+            if (Current.A != Current.B || Current.A->Kind != ESyntaxKind::Block) {
+                break;
+            }
+            const GreenNode* Inner = Current.A->Children[1].Get();
+            if (From - Current.StartA < 1 || To - Current.StartA > 1 + Inner->Leaves) {
+                break;                              // The edit touches the block's own braces
+            }
+            Content = Inner;
+            From -= Current.StartA + 1;
+            To -= Current.StartA + 1;
+        }
+
+        std::vector<GreenRef> Created;
+        for (size_t Depth = Levels.size(); Depth-- > 0;) {
+            const Level& Current = Levels[Depth];
+
+            Units Items;
+            CollectBefore(Current.A, Current.From - Current.StartA, Items);
+            Items.insert(Items.end(), New.begin(), New.end());
+            CollectAfter(Current.B, Current.To - Current.StartB, Items);
+
+            Units Grouped;
+            if (!Group(Items, false, Grouped, Created)) {
+                continue;
+            }
+
+            GreenRef Result = Splice(*Current.Content, Current.UnitA, Current.UnitB + 1, Grouped);
+            while (Depth-- > 0) {
+                const Level& Outer = Levels[Depth];
+                const auto& Parts = Outer.A->Children;
+                const GreenRef Block = MakeBlock(Parts[0].Get(), Result.Get(), Parts.size() > 2 ? Parts[2].Get() : nullptr);
+                Result = ReplaceUnits(*Outer.Content, Outer.UnitA, Outer.UnitA + 1, { Block.Get() });
+            }
+            return SyntaxTree(std::move(Result));
+        }
+
+        // Braces no longer match even at the top level: regroup all of it
+        Units Items;
+        CollectBefore(Green.Get(), First, Items);
+        Items.insert(Items.end(), New.begin(), New.end());
+        CollectAfter(Green.Get(), First + static_cast<uint32_t>(Replaced), Items);
+
+        Units Grouped;
+        Group(Items, true, Grouped, Created);
+        return SyntaxTree(BuildContent(Grouped));
+    }
+
+    TranslationUnit* SyntaxTree::ToTranslationUnit(ASTContext& Context, const std::string_view SourceName,
+                                                   std::vector<ParseError>* Errors) const {
+        Parser Parser(GetText(), Context, SourceName);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        if (Errors != nullptr) {
+            *Errors = Parser.GetErrors();
+        }
+        return Unit;
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Parser.h"
+
+namespace Vex {
+
+    enum class ESyntaxKind : uint8_t {
+        Token,      // One token with its leading trivia (whitespace and comments)
+        Block,      // '{', a List, then '}' unless the file ended first
+        List,       // A run of tokens and blocks, split into nested lists when long
+    };
+
+    class GreenNode;
+
+    /**
+     * Counted reference to an immutable GreenNode
+     *
+     * The count is atomic, so green subtrees may be shared between threads
+     * and tree versions freely. Dropping the last reference frees the
+     * subtree iteratively, however deep it is.
+     */
+    class GreenRef {
+    public:
+        GreenRef() = default;
+        explicit GreenRef(const GreenNode* Node);           // Adds a reference
+        GreenRef(const GreenRef& Other);
+        GreenRef(GreenRef&& Other) noexcept;
+        GreenRef& operator=(GreenRef Other) noexcept;
+        ~GreenRef();
+
+        [[nodiscard]] const GreenNode* Get() const { return Node; }
+        const GreenNode* operator->() const { return Node; }
+        const GreenNode& operator*() const { return *Node; }
+        explicit operator bool() const { return Node != nullptr; }
+
+    private:
+        const GreenNode* Node = nullptr;
+
+        static void Release(const GreenNode* Node);
+    };
+
+    /**
+     * Immutable, position-free syntax node
+     *
+     * A node knows only its own extent: its width in bytes and how its text
+     * moves the lexer's line and column. Absolute positions live in the
+     * SyntaxNode wrappers, so one green subtree can appear at different
+     * offsets in successive versions of a file and is shared, not copied.
+     *
+     * Nodes are built only by SyntaxTree and never change afterwards.
+     */
+    class GreenNode {
+    public:
+        ESyntaxKind Kind = ESyntaxKind::Token;
+        ETokenType  Type = ETokenType::UNKNOWN;      // Tokens only
+        bool        Balanced = true;                // No stray '}' and no unclosed block inside
+        uint8_t     Height = 0;                     // Lists: 1 + height of the children lists; 0 otherwise
+        uint32_t    Width = 0;                      // Bytes, leading trivia included
+        uint32_t    Lines = 0;                      // Newlines the lexer counts (not escaped ones in literals)
+        uint32_t    Tail = 0;                       // Bytes after the last counted newline; Width if none
+        uint32_t    Leaves = 0;                     // Tokens in the subtree
+        uint32_t    Units = 1;                      // Lists: tokens and blocks at this level; 1 otherwise
+        uint32_t    Trivia = 0;                     // Tokens: bytes of leading trivia
+        std::string Text;                           // Tokens: trivia followed by the token
+        std::vector<GreenRef> Children;             // Blocks and lists
+
+    private:
+        mutable std::atomic<uint32_t> References{ 0 };
+        friend class GreenRef;
+    };
+
+    class SyntaxTree;
+
+    /**
+     * Position-aware view of a GreenNode in one version of a file
+     *
+     * Created on first access by the parent and owned by it, so a walk only
+     * pays for the part of the tree it visits. Not thread-safe: use one
+     * SyntaxTree per thread (they may share green nodes).
+     */
+    class SyntaxNode {
+    public:
+        SyntaxNode(const GreenNode& Green, const SyntaxNode* Parent, size_t Offset, SourceLocation Location);
+
+        [[nodiscard]] const GreenNode& GetGreen() const { return Green; }
+        [[nodiscard]] ESyntaxKind GetKind() const { return Green.Kind; }
+        [[nodiscard]] ETokenType GetTokenType() const { return Green.Type; }
+        [[nodiscard]] const SyntaxNode* GetParent() const { return Parent; }
+
+        /** Start of the node, leading trivia included */
+        [[nodiscard]] size_t GetOffset() const { return Offset; }
+        [[nodiscard]] size_t GetWidth() const { return Green.Width; }
+        [[nodiscard]] size_t GetEnd() const { return Offset + Green.Width; }
+
+        /** Lexer position at GetOffset(); what a Parser for GetText() must start at */
+        [[nodiscard]] SourceLocation GetLocation() const { return Location; }
+
+        /** Position of the first token itself, after its leading trivia */
+        [[nodiscard]] SourceLocation GetTokenLocation() const;
+
+        [[nodiscard]] size_t GetChildCount() const { return Green.Children.size(); }
+        [[nodiscard]] const SyntaxNode* GetChild(size_t Index) const;
+
+        /** Innermost token whose span (leading trivia included) holds Offset */
+        [[nodiscard]] const SyntaxNode* FindToken(size_t Offset) const;
+
+        [[nodiscard]] std::string GetText() const;
+
+        /**
+         * Parses the node's text with the regular Parser, at the node's own
+         * position, so the result equals that part of a full parse. A Block
+         * gives a BlockStatement.
+         */
+        Statement* ToStatement(ASTContext& Context, std::string_view SourceName = "",
+                               std::vector<ParseError>* Errors = nullptr) const;
+        Expression* ToExpression(ASTContext& Context, std::string_view SourceName = "",
+                                 std::vector<ParseError>* Errors = nullptr) const;
+
+    private:
+        const GreenNode& Green;
+        const SyntaxNode* Parent;
+        size_t Offset;
+        SourceLocation Location;
+
+        mutable std::vector<std::unique_ptr<SyntaxNode>> Children;     // Created on first access
+    };
+
+    /**
+     * One version of a source file as a red-green syntax tree
+     *
+     * The green tree is lossless: tokens keep their trivia, so GetText()
+     * returns the source byte for byte. Tokens are grouped by braces only;
+     * everything finer is left to the Parser, which runs on demand on any
+     * node (SyntaxNode::ToStatement) or on the whole file.
+     *
+     * Edit() returns a new version and leaves this one intact. It relexes
+     * from just before the change until the token stream falls back in
+     * step with the old one, then regroups only within the innermost block
+     * that still balances. Every subtree outside that block, and every
+     * block inside it that the edit did not touch, is shared with this
+     * version. Long runs are kept in balanced lists, so a keystroke costs
+     * time logarithmic in the file size. An edit that unbalances braces
+     * takes apart only the blocks it cuts through; the lists around them
+     * are joined back whole.
+     *
+     * Example:
+     *   SyntaxTree Tree(Source);
+     *   SyntaxTree Next = Tree.Edit(Offset, 0, "x");
+     *   const SyntaxNode* Node = Next.GetRoot().FindToken(Offset);
+     *   while (Node != nullptr && Node->GetKind() != ESyntaxKind::Block) { Node = Node->GetParent(); }
+     *   Statement* Block = Node != nullptr ? Node->ToStatement(Context) : nullptr;
+     */
+    class SyntaxTree {
+    public:
+        explicit SyntaxTree(std::string_view Source);
+
+        SyntaxTree(SyntaxTree&&) noexcept = default;
+        SyntaxTree& operator=(SyntaxTree&&) noexcept = default;
+
+        /** This version with Length bytes at Offset replaced; both are clamped to the text */
+        [[nodiscard]] SyntaxTree Edit(size_t Offset, size_t Length, std::string_view Replacement) const;
+
+        [[nodiscard]] const SyntaxNode& GetRoot() const { return *Root; }
+        [[nodiscard]] size_t GetLength() const { return Green->Width; }
+        [[nodiscard]] std::string GetText() const { return Root->GetText(); }
+
+        /** Parses the whole file */
+        TranslationUnit* ToTranslationUnit(ASTContext& Context, std::string_view SourceName = "",
+                                           std::vector<ParseError>* Errors = nullptr) const;
+
+        /** Most children per list before it is split */
+        static constexpr size_t MaxListSize = 32;
+
+    private:
+        explicit SyntaxTree(GreenRef Green);
+
+        GreenRef Green;
+        std::unique_ptr<SyntaxNode> Root;
+    };
+}
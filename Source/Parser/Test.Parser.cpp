@@ -0,0 +1,39 @@
+#include <iostream>
+
+// Forward declarations of all test functions
+void Test_Parser_001_Expressions();
+void Test_Parser_002_Statements();
+void Test_Parser_003_Declarations();
+void Test_Parser_004_ParallelParsing();
+void Test_Parser_005_LazyBodies();
+void Test_Parser_006_SyntaxTree();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX PARSER TEST SUITE" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Test_Parser_001_Expressions();
+        Test_Parser_002_Statements();
+        Test_Parser_003_Declarations();
+        Test_Parser_004_ParallelParsing();
+        Test_Parser_005_LazyBodies();
+        Test_Parser_006_SyntaxTree();
+
+        std::cout << "\n";
+
+        std::cout << "========================================" << "\n";
+        std::cout << " ALL TESTS PASSED!" << "\n";
+        std::cout << "========================================" << "\n";
+
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Test failed with exception: " << E.what() << "\n";
+        return 1;
+    } catch (...) {
+        std::cerr << "Test failed with unknown exception" << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+
+#include "../Parser.h"
+
+using namespace Vex;
+
+namespace {
+    /** Parses Source as one expression and prints it fully parenthesized */
+    std::string Parse(const std::string& Source) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        const Expression* Result = Parser.ParseExpression();
+        assert(!Parser.HasErrors());
+        assert(Result != nullptr);
+        return Result->ToString();
+    }
+
+    bool Fails(const std::string& Source) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        Parser.ParseExpression();
+        return Parser.HasErrors();
+    }
+}
+
+void Test_Parser_001_Expressions() {
+    std::cout << "--- Parser Test 001: Expressions ---" << "\n";
+
+    // Literals and primaries
+    {
+        assert(Parse("42") == "42");
+        assert(Parse("2.5") == "2.5");
+        assert(Parse("\"Hi\"") == "\"Hi\"");
+        assert(Parse("'c'") == "'c'");
+        assert(Parse("true") == "true");
+        assert(Parse("null") == "null");
+        assert(Parse("this.Health") == "this.Health");
+        assert(Parse("(A)") == "(A)");
+        assert(Parse("Vector3(1, 2, 3)") == "Vector3(1, 2, 3)");
+        assert(Parse("new Player(1)") == "new Player(1)");
+
+        std::cout << "  ✓ Literals and primaries" << "\n";
+    }
+
+    // Tiers, loosest to tightest
+    {
+        assert(Parse("1 + 2 * 3") == "(1 + (2 * 3))");
+        assert(Parse("1 * 2 + 3") == "((1 * 2) + 3)");
+        assert(Parse("A - B - C") == "((A - B) - C)");
+        assert(Parse("A || B && C") == "(A || (B && C))");
+        assert(Parse("A | B ^ C & D") == "(A | (B ^ (C & D)))");
+        assert(Parse("A & B == C") == "(A & (B == C))");
+        assert(Parse("A == B < C") == "(A == (B < C))");
+        assert(Parse("A !== B === C") == "((A !== B) === C)");
+        assert(Parse("A < B..C") == "(A < (B .. C))");
+        assert(Parse("0..N << 1") == "(0 .. (N << 1))");
+        assert(Parse("0..=N - 1") == "(0 ..= (N - 1))");
+        assert(Parse("1 << 2 + 3") == "(1 << (2 + 3))");
+        assert(Parse("A ?? B || C") == "(A ?? (B || C))");
+        assert(Parse("A ?? B ?? C") == "(A ?? (B ?? C))");
+
+        std::cout << "  ✓ Binary tiers and associativity" << "\n";
+    }
+
+    // Prefix, power and cast
+    {
+        assert(Parse("-X") == "(-X)");
+        assert(Parse("!~X") == "(!(~X))");
+        assert(Parse("-2 ** 2") == "(-(2 ** 2))");
+        assert(Parse("2 ** 3 ** 2") == "(2 ** (3 ** 2))");
+        assert(Parse("A * B ** C") == "(A * (B ** C))");
+        assert(Parse("-X as Float") == "((-X) as Float)");
+        assert(Parse("X as Float * 2") == "((X as Float) * 2)");
+        assert(Parse("X + Y as Int_32") == "(X + (Y as Int_32))");
+        assert(Parse("P as Entity*") == "(P as Entity*)");
+
+        std::cout << "  ✓ Prefix, power and cast" << "\n";
+    }
+
+    // Postfix chains and optional access
+    {
+        assert(Parse("A.B.C") == "A.B.C");
+        assert(Parse("A?.B.C") == "A?.B.C");
+        assert(Parse("F(A, B)[0].Size") == "F(A, B)[0].Size");
+        assert(Parse("-A.B(1)") == "(-A.B(1))");
+        assert(Parse("Items[I + 1] ** 2") == "(Items[(I + 1)] ** 2)");
+        assert(Parse("Engine::Math::Dot(A, B).X") == "Engine::Math::Dot(A, B).X");
+
+        ASTContext Context;
+        Parser Parser("Target?.Position", Context);
+        const auto* Access = Parser.ParseExpression()->As<MemberAccess>();
+        assert(Access != nullptr && Access->IsOptional);
+        assert(Access->Object->Is<Identifier>());
+
+        std::cout << "  ✓ Calls, indexing and member access" << "\n";
+    }
+
+    // Ternary and assignment
+    {
+        assert(Parse("A ? B : C ? D : E") == "(A ? B : (C ? D : E))");
+        assert(Parse("A || B ? 1 : 2") == "((A || B) ? 1 : 2)");
+        assert(Parse("X = Y = 3") == "(X = (Y = 3))");
+        assert(Parse("X += A ? 1 : 2") == "(X += (A ? 1 : 2))");
+        assert(Parse("Self.Health -= Amount * 2") == "(Self.Health -= (Amount * 2))");
+        assert(Parse("Items[0] %= 3") == "(Items[0] %= 3)");
+
+        std::cout << "  ✓ Ternary and assignment" << "\n";
+    }
+
+    // Locations point at the operator or first token
+    {
+        ASTContext Context;
+        Parser Parser("A +\n  B * C", Context);
+        const auto* Sum = Parser.ParseExpression()->As<BinaryExpression>();
+        assert(Sum->Location.Line == 1 && Sum->Location.Column == 3);
+        assert(Sum->Right->Location.Line == 2 && Sum->Right->Location.Column == 5);
+
+        std::cout << "  ✓ Source locations" << "\n";
+    }
+
+    // Long chains loop instead of recursing
+    {
+        std::string Source = "X";
+        for (int Index = 0; Index < 100000; ++Index) {
+            Source += " + X";
+        }
+
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        const Expression* Sum = Parser.ParseExpression();
+        assert(!Parser.HasErrors());
+
+        int Length = 0;
+        while (const auto* Binary = Sum->As<BinaryExpression>()) {
+            Sum = Binary->Left;
+            ++Length;
+        }
+        assert(Length == 100000);
+
+        std::cout << "  ✓ 100000-term chain" << "\n";
+    }
+
+    // Errors
+    {
+        assert(Fails("1 +"));
+        assert(Fails("(A"));
+        assert(Fails("F(A,"));
+        assert(Fails("A ? B"));
+        assert(Fails("1 = 2"));
+        assert(Fails("A + B = C"));
+        assert(Fails("A B"));
+        assert(Fails("A.;"));
+        assert(Fails("A::;"));
+        assert(Fails("99999999999999999999"));
+
+        // Nesting is bounded rather than overflowing the stack
+        const std::string Deep = std::string(Parser::MaxDepth + 10, '(') + "A" + std::string(Parser::MaxDepth + 10, ')');
+        assert(Fails(Deep));
+        assert(Fails(std::string(100000, '-') + "A"));
+
+        std::cout << "  ✓ Malformed expressions are rejected" << "\n";
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+
+#include "../Parser.h"
+
+using namespace Vex;
+
+namespace {
+    std::string Parse(const std::string& Source) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        const Statement* Result = Parser.ParseStatement();
+        assert(!Parser.HasErrors());
+        assert(Result != nullptr);
+        return Result->ToString();
+    }
+}
+
+void Test_Parser_002_Statements() {
+    std::cout << "--- Parser Test 002: Statements ---" << "\n";
+
+    // Variables, expressions, jumps
+    {
+        assert(Parse("Var X;") == "Var X;");
+        assert(Parse("Let Speed: Float = 2.5 * Scale;") == "Let Speed: Float = (2.5 * Scale);");
+        assert(Parse("Const Limit: Shared Int_32* = 10;") == "Const Limit: Shared Int_32* = 10;");
+        assert(Parse("Self.Health = 100;") == "(Self.Health = 100);");
+        assert(Parse("{ break; continue; return; return X; }") == "{ break; continue; return; return X; }");
+
+        std::cout << "  ✓ Variables, expression statements and jumps" << "\n";
+    }
+
+    // Control flow
+    {
+        assert(Parse("if A > B { return A; } else { return B; }") ==
+               "if (A > B) { return A; } else { return B; }");
+        assert(Parse("while I < 10 { I += 1; }") == "while (I < 10) { (I += 1); }");
+        assert(Parse("do { I -= 1; } while I > 0;") == "do { (I -= 1); } while (I > 0);");
+
+        ASTContext Context;
+        Parser Parser("if A { X = 1; } else if B { X = 2; } else if C { X = 3; } else { X = 4; }", Context);
+        const auto* If = Parser.ParseStatement()->As<IfStatement>();
+        assert(!Parser.HasErrors());
+
+        int Branches = 1;
+        while (If->ElseBranch != nullptr && If->ElseBranch->Is<IfStatement>()) {
+            If = If->ElseBranch->As<IfStatement>();
+            ++Branches;
+        }
+        assert(Branches == 3);
+        assert(If->ElseBranch->Is<BlockStatement>());
+
+        std::cout << "  ✓ if / else if / while / do-while" << "\n";
+    }
+
+    // for: the range expression is split into bounds
+    {
+        ASTContext Context;
+        Parser Parser("for I in 0..=Count - 1 step 2 { Sum += I; }", Context);
+        const auto* For = Parser.ParseStatement()->As<ForStatement>();
+        assert(!Parser.HasErrors());
+        assert(For->Iterator == "I");
+        assert(For->IsInclusive);
+        assert(For->RangeStart->ToString() == "0");
+        assert(For->RangeEnd->ToString() == "(Count - 1)");
+        assert(For->Step->ToString() == "2");
+
+        assert(Parse("for I in 0..10 { }") == "for I in 0..10 { }");
+
+        Vex::Parser NotARange("for I in Items { }", Context);
+        NotARange.ParseStatement();
+        assert(NotARange.HasErrors());
+
+        std::cout << "  ✓ for loops" << "\n";
+    }
+
+    // match arms: blocks, statements and bare expressions
+    {
+        ASTContext Context;
+        Parser Parser(R"(
+            match State {
+                0 -> { Idle(); }
+                1 -> return Run();
+                2 -> Jump(),
+                _ -> Log("Unknown")
+            }
+        )", Context);
+        const auto* Match = Parser.ParseStatement()->As<MatchStatement>();
+        assert(!Parser.HasErrors());
+        assert(Match->Cases.size() == 4);
+        assert(Match->Cases[0].Body->Is<BlockStatement>());
+        assert(Match->Cases[1].Body->Is<ReturnStatement>());
+        assert(Match->Cases[2].Body->Is<ExpressionStatement>());
+        assert(Match->Cases[3].Pattern->ToString() == "_");
+
+        std::cout << "  ✓ match" << "\n";
+    }
+
+    // Recovery inside a block keeps the good statements
+    {
+        ASTContext Context;
+        Parser Parser(R"({
+            Var A = 1;
+            Var B = ;
+            A = A + ;
+            Let C = A * 2;
+            if { }
+            return C;
+        })", Context);
+        const auto* Block = Parser.ParseStatement()->As<BlockStatement>();
+        assert(Parser.GetErrors().size() == 3);
+        assert(Block->Statements.size() == 3);
+        assert(Block->Statements[2]->Is<ReturnStatement>());
+        assert(Parser.GetErrors()[0].Location.Line == 3);
+
+        // A missing ';' is reported but the statement is kept
+        Vex::Parser Missing("{ X = 1 Y = 2; }", Context);
+        const auto* Kept = Missing.ParseStatement()->As<BlockStatement>();
+        assert(Missing.GetErrors().size() == 1);
+        assert(Kept->Statements.size() == 1);
+
+        std::cout << "  ✓ Error recovery" << "\n";
+    }
+
+    // Deeply nested blocks are bounded
+    {
+        ASTContext Context;
+        const std::string Source = std::string(Parser::MaxDepth + 5, '{') + std::string(Parser::MaxDepth + 5, '}');
+        Parser Parser(Source, Context);
+        Parser.ParseStatement();
+        assert(Parser.HasErrors());
+
+        std::cout << "  ✓ Nesting limit" << "\n";
+    }
+
+    std::cout << "\n";
+}
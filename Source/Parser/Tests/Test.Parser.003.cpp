@@ -0,0 +1,168 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+
+#include "../Parser.h"
+#include "StructuralHash.h"
+
+using namespace Vex;
+
+namespace {
+    const char* Game = R"(
+        Using Engine::Math;
+
+        global Const Gravity: Float = 9.81;
+
+        Interface IDamageable : IEntity {
+            TakeDamage(Amount: Int_32) -> Void;
+        }
+
+        @SoA @Packed
+        Define Entity : Base, IDamageable {
+            Public:
+                Health -> Int_32 = 100;
+                Static Const MaxHealth -> Int_32 = 100;
+                Position -> Vector3;
+                Override TakeDamage(Amount: Int_32) -> Void {
+                    Health -= Amount;
+                    if Health < 0 { Health = 0; }
+                }
+            Private:
+                Armor -> Float{Entity.Health, Entity.Armor};
+                Operator +(Other: Entity) -> Entity { return Other; }
+                Virtual Scale(Factor: Float = 1.0) -> Float;
+        }
+
+        Fetch Entity {
+            Fetch_Health() -> Entity.Health { return Entity.Health; }
+        }
+
+        Set Entity {
+            Set_Health(Value: Int_32) -> Void { Entity.Health = Value; }
+        }
+
+        Namespace Engine::Physics {
+            Namespace Detail {
+                Step(Delta: Float) -> Void { }
+            }
+        }
+
+        Clamp(Value: Float, Low: Float, High: Float) -> Float {
+            return Value < Low ? Low : Value > High ? High : Value;
+        }
+    )";
+}
+
+void Test_Parser_003_Declarations() {
+    std::cout << "--- Parser Test 003: Declarations ---" << "\n";
+
+    // A complete file
+    {
+        ASTContext Context;
+        Parser Parser(Game, Context, "Game.vex");
+        const TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        for (const auto& Error : Parser.GetErrors()) {
+            std::cerr << Error.ToString() << "\n";
+        }
+        assert(!Parser.HasErrors());
+        assert(Unit->SourceName == "Game.vex");
+        assert(Unit->Declarations.size() == 8);
+
+        assert(Unit->Declarations[0]->As<UsingDeclaration>()->Path == "Engine::Math");
+        assert(Unit->Declarations[1]->As<GlobalDeclaration>()->Variable->IsConst);
+
+        const auto* Interface = Unit->Declarations[2]->As<InterfaceDeclaration>();
+        assert(Interface->BaseInterfaces.size() == 1 && Interface->Methods.size() == 1);
+        assert(Interface->Methods[0]->Body == nullptr);
+
+        const auto* Define = Unit->Declarations[3]->As<DefineDeclaration>();
+        assert(Define->Name == "Entity");
+        assert(Define->Attributes.size() == 2 && Define->Attributes[0] == "SoA");
+        assert(Define->BaseTypes.size() == 2);
+        assert(Define->Fields.size() == 4);
+        assert(Define->Methods.size() == 3);
+        assert(Define->Fields[0]->Access == EAccessModifier::PUBLIC);
+        assert(Define->Fields[1]->IsStatic && Define->Fields[1]->IsConst);
+        assert(Define->Fields[3]->Access == EAccessModifier::PRIVATE);
+        assert(Define->Fields[3]->Type->ToString() == "Float{Entity.Health, Entity.Armor}");
+        assert(Define->Methods[0]->IsOverride && Define->Methods[0]->Body->Statements.size() == 2);
+        assert(Define->Methods[1]->IsOperator && Define->Methods[1]->Name == "+");
+        assert(Define->Methods[2]->IsVirtual && Define->Methods[2]->Parameters[0].DefaultValue != nullptr);
+
+        const auto* Fetch = Unit->Declarations[4]->As<FetchDeclaration>();
+        assert(Fetch->Methods[0]->ReturnType->ToString() == "Entity.Health");
+        assert(Unit->Declarations[5]->Is<SetDeclaration>());
+
+        const auto* Namespace = Unit->Declarations[6]->As<NamespaceDeclaration>();
+        assert(Namespace->Name == "Engine::Physics");
+        assert(Namespace->Declarations[0]->As<NamespaceDeclaration>()->Declarations.size() == 1);
+
+        const auto* Clamp = Unit->Declarations[7]->As<FunctionDeclaration>();
+        assert(Clamp->Parameters.size() == 3);
+        assert(Clamp->Access == EAccessModifier::NONE);
+
+        // Types are canonical
+        assert(Define->Fields[0]->Type == Context.GetType("Int_32"));
+
+        std::cout << "  ✓ Using, global, Interface, Define, Fetch, Set, Namespace, functions" << "\n";
+    }
+
+    // Parsing is deterministic: two parses give structurally equal trees
+    {
+        ASTContext First;
+        ASTContext Second;
+        Parser A(Game, First);
+        Parser B(Game, Second);
+        assert(StructurallyEqual(A.ParseTranslationUnit(), B.ParseTranslationUnit()));
+
+        std::cout << "  ✓ Repeatable" << "\n";
+    }
+
+    // Errors are collected and parsing continues with the next declaration
+    {
+        ASTContext Context;
+        Parser Parser(R"(
+            Define Broken {
+                Health -> ;
+                Armor -> Int_32;
+                Fly( -> Void;
+                Update(Delta: Float) -> Void { Var X = ; }
+            }
+            Define 42 { }
+            Using ;
+            Lonely -> Int_32;
+            Define Fine { Size -> Int_32; }
+            }
+            Last() -> Void { Log("$"); }
+        )", Context);
+        const TranslationUnit* Unit = Parser.ParseTranslationUnit();
+
+        const auto& Errors = Parser.GetErrors();
+        assert(Errors.size() == 7);
+        assert(Errors[0].Location.Line == 3);
+        assert(Errors[0].ToString().find("Line 3") == 0);
+
+        const auto* Broken = Unit->Declarations[0]->As<DefineDeclaration>();
+        assert(Broken->Fields.size() == 1 && Broken->Fields[0]->Name == "Armor");
+        assert(Broken->Methods.size() == 1 && Broken->Methods[0]->Name == "Update");
+
+        assert(Unit->Declarations.size() == 3);
+        assert(Unit->Declarations[1]->As<DefineDeclaration>()->Name == "Fine");
+        assert(Unit->Declarations[2]->As<FunctionDeclaration>()->Name == "Last");
+
+        std::cout << "  ✓ Errors are collected and parsing recovers" << "\n";
+    }
+
+    // Lexical errors surface as parse errors
+    {
+        ASTContext Context;
+        Parser Parser("Main() -> Void { Var S = \"open; }", Context);
+        Parser.ParseTranslationUnit();
+        assert(Parser.HasErrors());
+        assert(Parser.GetErrors()[0].Message == "Unterminated String");
+
+        std::cout << "  ✓ Lexer errors reported" << "\n";
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "../ParallelParser.h"
+#include "StructuralHash.h"
+#include "TreeWalker.h"
+
+using namespace Vex;
+
+namespace {
+    /** Many small declarations, with braces, semicolons and newlines hidden in literals and comments */
+    std::string Generate(const int Count) {
+        std::string Source = "Using Engine::Math;\n";
+        for (int Index = 0; Index < Count; ++Index) {
+            const std::string Name = "Entity" + std::to_string(Index);
+            Source += "// Define Fake { ; }\n"
+                      "@SoA\n"
+                      "Define " + Name + " : Base {\n"
+                      "    Public:\n"
+                      "        Health -> Int_32 = 100;\n"
+                      "        Armor -> Float{" + Name + ".Health};\n"
+                      "        Describe() -> String { return \"{ not a block; }\\\n still the string\"; }\n"
+                      "        Brace() -> Char { return '}'; }\n"
+                      "}\n"
+                      "/* multi-line comment with } and ;\n"
+                      "   on two lines */\n"
+                      "Fetch " + Name + " { Fetch_Armor() -> Float{" + Name + ".Armor} { return Armor; } }\n"
+                      "global Var Count" + std::to_string(Index) + ": Int_32 = " + std::to_string(Index) + ";\n"
+                      "Namespace Game::Zone" + std::to_string(Index) + " { Tick() -> Void { } }\n";
+        }
+        return Source;
+    }
+
+    std::vector<SourceLocation> Locations(ASTNode* Root) {
+        std::vector<SourceLocation> Result;
+        WalkTree(Root, [&Result](ASTNode& Node) { Result.push_back(Node.Location); return true; });
+        return Result;
+    }
+
+    bool SameLocations(ASTNode* Left, ASTNode* Right) {
+        const auto A = Locations(Left);
+        const auto B = Locations(Right);
+        if (A.size() != B.size()) {
+            return false;
+        }
+        for (size_t Index = 0; Index < A.size(); ++Index) {
+            if (A[Index].Line != B[Index].Line || A[Index].Column != B[Index].Column) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void Test_Parser_004_ParallelParsing() {
+    std::cout << "--- Parser Test 004: Parallel Parsing ---" << "\n";
+
+    // Pre-scan cuts after top-level '}' and ';' only
+    {
+        std::vector<SourceSpan> Spans;
+        const std::string Source = "Using A;\nDefine B { X -> Int; }\n"
+                                   "F() -> Float{B.X} { return \"}\"; } // }\n"
+                                   "/* ; */ Set B { }";
+        assert(ParallelParser::Split(Source, Spans));
+        assert(Spans.size() == 4);
+        assert(Source.substr(Spans[0].Begin, Spans[0].End - Spans[0].Begin) == "Using A;");
+        assert(Source.substr(Spans[1].Begin, Spans[1].End - Spans[1].Begin) == "\nDefine B { X -> Int; }");
+        assert(Spans[1].Start.Line == 1 && Spans[1].Start.Column == 9);
+        assert(Spans[2].Start.Line == 2 && Spans[2].Start.Column == 23);
+        assert(Spans[3].End == Source.size());
+
+        assert(!ParallelParser::Split("Define A { ", Spans));
+        assert(!ParallelParser::Split("Define A { } }", Spans));
+        assert(!ParallelParser::Split("F() -> Void { Log(\"open); }", Spans));
+        assert(!ParallelParser::Split("/* open", Spans));
+
+        std::cout << "  ✓ Top-level boundaries" << "\n";
+    }
+
+    // Identical to the serial parse, locations and all
+    {
+        const std::string Source = Generate(300);
+
+        ASTContext SerialContext;
+        Parser Serial(Source, SerialContext, "Bundle.vex");
+        TranslationUnit* Expected = Serial.ParseTranslationUnit();
+        assert(!Serial.HasErrors());
+
+        for (const unsigned Threads : { 2u, 3u, 8u }) {
+            ASTContext Context;
+            ParallelParser Parallel(Source, Context, "Bundle.vex", Threads);
+            TranslationUnit* Unit = Parallel.ParseTranslationUnit();
+
+            assert(Parallel.WasParallel());
+            assert(!Parallel.HasErrors());
+            assert(Unit->SourceName == "Bundle.vex");
+            assert(Unit->Declarations.size() == Expected->Declarations.size());
+            assert(StructurallyEqual(Unit, Expected));
+            assert(Unit->ToString() == Expected->ToString());
+            assert(SameLocations(Unit, Expected));
+
+            // Types were remapped to the caller's canonical table
+            const TypeRef* Int = Context.GetType("Int_32");
+            for (const Declaration* Parsed : Unit->Declarations) {
+                if (const auto* Define = Parsed->As<DefineDeclaration>()) {
+                    assert(Define->Fields[0]->Type == Int);
+                    assert(Context.GetTypes().Get(*Define->Fields[1]->Type) == Define->Fields[1]->Type);
+                    assert(Define->BaseTypes[0] == Context.GetType("Base"));
+                }
+            }
+        }
+
+        std::cout << "  ✓ Same tree as the serial parser" << "\n";
+    }
+
+    // Errors anywhere fall back to the serial parser, so they are reported identically
+    {
+        std::string Source = Generate(100);
+        Source.insert(Source.size() / 2, "Define Broken { Health -> ; }\n");
+
+        ASTContext SerialContext;
+        Parser Serial(Source, SerialContext);
+        Serial.ParseTranslationUnit();
+
+        ASTContext Context;
+        ParallelParser Parallel(Source, Context, "", 4);
+        Parallel.ParseTranslationUnit();
+
+        assert(!Parallel.WasParallel());
+        assert(Parallel.GetErrors().size() == Serial.GetErrors().size());
+        assert(Parallel.GetErrors()[0].ToString() == Serial.GetErrors()[0].ToString());
+
+        // Small inputs are not worth the threads
+        ParallelParser Small("Using A;", Context, "", 4);
+        assert(Small.ParseTranslationUnit()->Declarations.size() == 1);
+        assert(!Small.WasParallel());
+
+        std::cout << "  ✓ Serial fallback" << "\n";
+    }
+
+    std::cout << "\n";
+}
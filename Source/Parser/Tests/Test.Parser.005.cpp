@@ -0,0 +1,192 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../LazyParser.h"
+#include "StructuralHash.h"
+#include "TreeWalker.h"
+
+using namespace Vex;
+
+namespace {
+    /** Methods and free functions whose bodies hide braces in literals and comments */
+    std::string Generate(const int Count) {
+        std::string Source;
+        for (int Index = 0; Index < Count; ++Index) {
+            const std::string Name = "Entity" + std::to_string(Index);
+            Source += "Define " + Name + " {\n"
+                      "    Public:\n"
+                      "        Health -> Int_32 = 100;\n"
+                      "        Update(Delta: Float) -> Void {\n"
+                      "            // } not a brace\n"
+                      "            if Health > 0 { Health -= 1; } /* { */\n"
+                      "            Log(\"}}{\\\" still the string\");\n"
+                      "            Close = '}';\n"
+                      "        }\n"
+                      "        Abstract() -> Int_32;\n"
+                      "}\n"
+                      "Namespace Game { Tick" + std::to_string(Index) + "() -> Void { for I in 0..3 { Step(I); } } }\n";
+        }
+        return Source;
+    }
+
+    std::vector<FunctionDeclaration*> Functions(ASTNode* Root) {
+        std::vector<FunctionDeclaration*> Result;
+        WalkTree(Root, [&Result](ASTNode& Node) {
+            if (auto* Function = Node.As<FunctionDeclaration>()) {
+                Result.push_back(Function);
+            }
+            return true;
+        });
+        return Result;
+    }
+
+    std::vector<SourceLocation> Locations(ASTNode* Root) {
+        std::vector<SourceLocation> Result;
+        WalkTree(Root, [&Result](ASTNode& Node) { Result.push_back(Node.Location); return true; });
+        return Result;
+    }
+
+    bool SameLocations(ASTNode* Left, ASTNode* Right) {
+        const auto A = Locations(Left);
+        const auto B = Locations(Right);
+        if (A.size() != B.size()) {
+            return false;
+        }
+        for (size_t Index = 0; Index < A.size(); ++Index) {
+            if (A[Index].Line != B[Index].Line || A[Index].Column != B[Index].Column) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void Test_Parser_005_LazyBodies() {
+    std::cout << "--- Parser Test 005: Lazy Function Bodies ---" << "\n";
+
+    const std::string Source = Generate(50);
+
+    ASTContext EagerContext;
+    Parser Eager(Source, EagerContext, "Lazy.vex");
+    TranslationUnit* Expected = Eager.ParseTranslationUnit();
+    assert(!Eager.HasErrors());
+    const auto ExpectedFunctions = Functions(Expected);
+
+    // Declarations are complete, bodies are only ranges
+    {
+        ASTContext Context;
+        LazyParser Lazy(Source, Context, "Lazy.vex");
+        TranslationUnit* Unit = Lazy.ParseTranslationUnit();
+        assert(!Lazy.HasErrors());
+
+        const auto Parsed = Functions(Unit);
+        assert(Parsed.size() == ExpectedFunctions.size());
+        assert(Lazy.GetDeferredFunctions().size() == 100);
+
+        for (size_t Index = 0; Index < Parsed.size(); ++Index) {
+            FunctionDeclaration* Function = Parsed[Index];
+            assert(Function->Body == nullptr);
+            assert(Function->Name == ExpectedFunctions[Index]->Name);
+            assert((Function->Deferred != nullptr) == (ExpectedFunctions[Index]->Body != nullptr));
+            if (Function->Deferred != nullptr) {
+                assert(Source[Function->Deferred->Begin] == '{');
+                assert(Source[Function->Deferred->End - 1] == '}');
+            }
+        }
+        assert(Unit->ToString().find("{ ... }") != std::string::npos);
+
+        // Each body matches the eager one, locations and all
+        for (size_t Index = 0; Index < Parsed.size(); ++Index) {
+            BlockStatement* Body = Lazy.GetBody(Parsed[Index]);
+            assert(StructurallyEqual(Body, ExpectedFunctions[Index]->Body));
+            if (Body != nullptr) {
+                assert(SameLocations(Body, ExpectedFunctions[Index]->Body));
+                assert(Lazy.GetBody(Parsed[Index]) == Body);
+            }
+        }
+        assert(!Lazy.HasErrors());
+
+        std::cout << "  ✓ Bodies parsed on access" << "\n";
+    }
+
+    // Concurrent first accesses agree on one body per function
+    {
+        ASTContext Context;
+        LazyParser Lazy(Source, Context, "Lazy.vex");
+        Lazy.ParseTranslationUnit();
+        const auto& Deferred = Lazy.GetDeferredFunctions();
+
+        constexpr int ThreadCount = 8;
+        std::vector<std::vector<BlockStatement*>> Seen(ThreadCount);
+        std::vector<std::thread> Threads;
+        for (int Thread = 0; Thread < ThreadCount; ++Thread) {
+            Threads.emplace_back([&, Thread] {
+                // Walk in different orders so threads race on different bodies
+                for (size_t Step = 0; Step < Deferred.size(); ++Step) {
+                    const size_t Index = (Step * (Thread + 1) + Thread) % Deferred.size();
+                    Seen[Thread].push_back(Lazy.GetBody(Deferred[Index]));
+                    assert(Seen[Thread].back() != nullptr);
+                }
+            });
+        }
+        for (auto& Thread : Threads) {
+            Thread.join();
+        }
+
+        for (size_t Index = 0; Index < Deferred.size(); ++Index) {
+            BlockStatement* Body = Deferred[Index]->Deferred->Parsed.load();
+            assert(Body != nullptr);
+            for (int Thread = 0; Thread < ThreadCount; ++Thread) {
+                for (size_t Step = 0; Step < Deferred.size(); ++Step) {
+                    if ((Step * (Thread + 1) + Thread) % Deferred.size() == Index) {
+                        assert(Seen[Thread][Step] == Body);
+                    }
+                }
+            }
+        }
+
+        std::cout << "  ✓ Thread-safe first access" << "\n";
+    }
+
+    // Resolving every body gives the eager tree
+    {
+        ASTContext Context;
+        LazyParser Lazy(Source, Context, "Lazy.vex");
+        TranslationUnit* Unit = Lazy.ParseTranslationUnit();
+        assert(!StructurallyEqual(Unit, Expected));
+
+        Lazy.ParseAllBodies();
+        assert(StructurallyEqual(Unit, Expected));
+        assert(Unit->ToString() == Expected->ToString());
+        assert(SameLocations(Unit, Expected));
+
+        std::cout << "  ✓ Same tree as the eager parser" << "\n";
+    }
+
+    // Body errors surface when the body is parsed; unbalanced braces at once
+    {
+        ASTContext Context;
+        LazyParser Lazy("F() -> Void { Health = ; }\nG() -> Int_32 { return 1; }", Context);
+        Lazy.ParseTranslationUnit();
+        assert(!Lazy.HasErrors());
+        assert(Lazy.GetDeferredFunctions().size() == 2);
+
+        Lazy.GetBody(Lazy.GetDeferredFunctions()[1]);
+        assert(!Lazy.HasErrors());
+        Lazy.GetBody(Lazy.GetDeferredFunctions()[0]);
+        assert(Lazy.HasErrors());
+        assert(Lazy.GetErrors()[0].Location.Line == 1);
+        assert(Lazy.GetErrors()[0].Location.Column == 24);
+
+        LazyParser Open("F() -> Void { if A { }", Context);
+        Open.ParseTranslationUnit();
+        assert(Open.HasErrors());
+
+        std::cout << "  ✓ Errors" << "\n";
+    }
+
+    std::cout << "\n";
+}
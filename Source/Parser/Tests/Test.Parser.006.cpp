@@ -0,0 +1,261 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../SyntaxTree.h"
+#include "StructuralHash.h"
+#include "TreeWalker.h"
+
+using namespace Vex;
+
+namespace {
+    std::string Generate(const int Count) {
+        std::string Source = "Using Engine::Math;\n";
+        for (int Index = 0; Index < Count; ++Index) {
+            const std::string Name = "Entity" + std::to_string(Index);
+            Source += "Define " + Name + " {\n"
+                      "    Public:\n"
+                      "        Health -> Int_32 = 100;\n"
+                      "        Update(Delta: Float) -> Void {\n"
+                      "            if Health > 0 { Health -= 1; } /* { */\n"
+                      "            Log(\"}\\\n{\"); // }\n"
+                      "            Close = '}';\n"
+                      "        }\n"
+                      "}\n";
+        }
+        return Source;
+    }
+
+    /** Brace structure and tokens, ignoring how long runs are split into lists */
+    void Describe(const GreenNode& Node, std::string& Out) {
+        switch (Node.Kind) {
+            case ESyntaxKind::Token:
+                Out += std::to_string(static_cast<int>(Node.Type)) + ":" + Node.Text + "|";
+                break;
+            case ESyntaxKind::Block:
+                Out += Node.Children.size() == 3 ? "(" : "(unclosed ";
+                for (const auto& Child : Node.Children) {
+                    Describe(*Child, Out);
+                }
+                Out += ")";
+                break;
+            case ESyntaxKind::List:
+                for (const auto& Child : Node.Children) {
+                    Describe(*Child, Out);
+                }
+                break;
+        }
+    }
+
+    std::string Describe(const SyntaxTree& Tree) {
+        std::string Out;
+        Describe(Tree.GetRoot().GetGreen(), Out);
+        return Out;
+    }
+
+    /** No node has more than MaxListSize children, and lists nest to a uniform height */
+    void CheckShape(const GreenNode& Node) {
+        assert(Node.Children.size() <= SyntaxTree::MaxListSize);
+        for (const auto& Child : Node.Children) {
+            if (Node.Kind == ESyntaxKind::List) {
+                assert(Child->Kind == ESyntaxKind::List ? Child->Height + 1 == Node.Height : Node.Height == 1);
+            }
+            CheckShape(*Child);
+        }
+    }
+
+    /** The tree an edit produced must be the tree a fresh build of its text produces */
+    void CheckAgainstRebuild(const SyntaxTree& Tree) {
+        const SyntaxTree Fresh(Tree.GetText());
+        assert(Describe(Tree) == Describe(Fresh));
+        assert(Tree.GetLength() == Fresh.GetLength());
+        CheckShape(Tree.GetRoot().GetGreen());
+    }
+
+    void CollectBlocks(const GreenNode& Node, std::vector<const GreenNode*>& Out) {
+        for (const auto& Child : Node.Children) {
+            if (Child->Kind == ESyntaxKind::Block) {
+                Out.push_back(Child.Get());
+            } else if (Child->Kind == ESyntaxKind::List) {
+                CollectBlocks(*Child, Out);
+            }
+        }
+    }
+
+    std::vector<SourceLocation> Locations(ASTNode* Root) {
+        std::vector<SourceLocation> Result;
+        WalkTree(Root, [&Result](ASTNode& Node) { Result.push_back(Node.Location); return true; });
+        return Result;
+    }
+
+    bool SameLocations(ASTNode* Left, ASTNode* Right) {
+        const auto A = Locations(Left);
+        const auto B = Locations(Right);
+        if (A.size() != B.size()) {
+            return false;
+        }
+        for (size_t Index = 0; Index < A.size(); ++Index) {
+            if (A[Index].Line != B[Index].Line || A[Index].Column != B[Index].Column) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void Test_Parser_006_SyntaxTree() {
+    std::cout << "--- Parser Test 006: Red-Green Syntax Tree ---" << "\n";
+
+    const std::string Source = Generate(200);
+
+    // Lossless, with the lexer's tokens and positions
+    {
+        const SyntaxTree Tree(Source);
+        assert(Tree.GetText() == Source);
+        assert(Tree.GetLength() == Source.size());
+
+        Lexer Lexer(Source);
+        for (Token Expected = Lexer.NextToken(); Expected.Type != ETokenType::END_OF_FILE; Expected = Lexer.NextToken()) {
+            const SyntaxNode* Found = Tree.GetRoot().FindToken(Lexer.GetTokenOffset());
+            assert(Found != nullptr && Found->GetTokenType() == Expected.Type);
+            assert(Found->GetEnd() == Lexer.GetOffset());
+            assert(Found->GetOffset() + Found->GetGreen().Trivia == Lexer.GetTokenOffset());
+
+            // Literal columns count the decoded value, so only lines compare there
+            assert(Found->GetTokenLocation().Line == Expected.Line);
+            if (Expected.Type != ETokenType::STRING_LITERAL && Expected.Type != ETokenType::CHAR_LITERAL) {
+                assert(Found->GetTokenLocation().Column == Expected.Column);
+            }
+        }
+
+        // Long runs are split into balanced lists
+        CheckShape(Tree.GetRoot().GetGreen());
+
+        std::cout << "  ✓ Lossless tokens and positions" << "\n";
+    }
+
+    // An edit inside a body shares everything but the path to it
+    {
+        const SyntaxTree Tree(Source);
+        const size_t Offset = Source.find("Health -= 1", Source.size() / 2);
+        const SyntaxTree Next = Tree.Edit(Offset, 6, "Armor");
+
+        assert(Next.GetText() == Source.substr(0, Offset) + "Armor" + Source.substr(Offset + 6));
+        CheckAgainstRebuild(Next);
+
+        std::vector<const GreenNode*> Before;
+        std::vector<const GreenNode*> After;
+        CollectBlocks(Tree.GetRoot().GetGreen(), Before);
+        CollectBlocks(Next.GetRoot().GetGreen(), After);
+        assert(Before.size() == 200 && After.size() == 200);
+
+        size_t Shared = 0;
+        for (size_t Index = 0; Index < Before.size(); ++Index) {
+            Shared += Before[Index] == After[Index] ? 1 : 0;
+        }
+        assert(Shared == 199);
+
+        // The old version is untouched
+        assert(Tree.GetText() == Source);
+
+        // Positions after the edit moved; the green nodes did not
+        const size_t Later = Source.find("Close", Offset);
+        const SyntaxNode* Old = Tree.GetRoot().FindToken(Later);
+        const SyntaxNode* New = Next.GetRoot().FindToken(Later - 1);
+        assert(&Old->GetGreen() == &New->GetGreen());
+        assert(New->GetOffset() + 1 == Old->GetOffset());
+
+        std::cout << "  ✓ Unchanged subtrees are shared" << "\n";
+    }
+
+    // Random edits, including ones that cut through tokens, comments, strings and braces
+    {
+        const std::vector<std::string> Snippets = {
+            "", "x", "{", "}", "\"", "'", "/*", "*/", "//", "\n", " ", "1.", "5", "->", ";",
+            "if A { B(); }", "} else {", "\\", "Define Q { }", "..=",
+        };
+
+        SyntaxTree Tree(Source.substr(0, 4000));
+        uint64_t State = 0x9E3779B97F4A7C15ull;
+        const auto Next = [&State](const uint64_t Bound) {
+            State ^= State << 13;
+            State ^= State >> 7;
+            State ^= State << 17;
+            return Bound == 0 ? 0 : State % Bound;
+        };
+
+        for (int Step = 0; Step < 600; ++Step) {
+            const std::string Text = Tree.GetText();
+            const size_t Offset = Next(Text.size() + 1);
+            const size_t Length = Next(4) == 0 ? Next(40) : Next(3);
+            const std::string& Snippet = Snippets[Next(Snippets.size())];
+
+            SyntaxTree Edited = Tree.Edit(Offset, Length, Snippet);
+            const size_t Clamped = std::min(Length, Text.size() - Offset);
+            assert(Edited.GetText() == Text.substr(0, Offset) + Snippet + Text.substr(Offset + Clamped));
+            CheckAgainstRebuild(Edited);
+            Tree = std::move(Edited);
+        }
+
+        // Down to nothing and back
+        SyntaxTree Empty = Tree.Edit(0, Tree.GetLength(), "");
+        assert(Empty.GetLength() == 0 && Empty.GetText().empty());
+        SyntaxTree Again = Empty.Edit(0, 0, "F() -> Void { }");
+        CheckAgainstRebuild(Again);
+
+        std::cout << "  ✓ Edits match a fresh build" << "\n";
+    }
+
+    // Nodes convert to the regular AST, at their own positions
+    {
+        const SyntaxTree Tree(Source);
+        const SyntaxTree Next = Tree.Edit(Source.find("Health -= 1"), 0, "Armor += 2; ");
+        const std::string Text = Next.GetText();
+
+        ASTContext EagerContext;
+        Parser Eager(Text, EagerContext, "Edited.vex");
+        TranslationUnit* Expected = Eager.ParseTranslationUnit();
+        assert(!Eager.HasErrors());
+
+        ASTContext Context;
+        std::vector<ParseError> Errors;
+        TranslationUnit* Unit = Next.ToTranslationUnit(Context, "Edited.vex", &Errors);
+        assert(Errors.empty());
+        assert(StructurallyEqual(Unit, Expected));
+
+        // The body of Entity0's Update, taken from the block around an offset in it
+        const SyntaxNode* Node = Next.GetRoot().FindToken(Text.find("Armor += 2"));
+        assert(Node->GetTokenType() == ETokenType::IDENTIFIER);
+        while (Node->GetKind() != ESyntaxKind::Block) {
+            Node = Node->GetParent();
+        }
+        Node = Node->GetParent();
+        while (Node->GetKind() != ESyntaxKind::Block) {
+            Node = Node->GetParent();
+        }
+
+        Statement* Body = Node->ToStatement(Context, "Edited.vex", &Errors);
+        assert(Errors.empty());
+        const auto* Define = Expected->Declarations[1]->As<DefineDeclaration>();
+        BlockStatement* ExpectedBody = Define->Methods[0]->Body;
+        assert(StructurallyEqual(Body, ExpectedBody));
+        assert(SameLocations(Body, ExpectedBody));
+
+        std::cout << "  ✓ Conversion to the AST" << "\n";
+    }
+
+    // Unbalanced braces: a stray '}' stays a token, an open '{' runs to the end
+    {
+        const SyntaxTree Tree("A } B { C { D");
+        assert(Describe(Tree).find("(unclosed ") != std::string::npos);
+        CheckAgainstRebuild(Tree.Edit(0, 0, "{"));
+        CheckAgainstRebuild(Tree.Edit(13, 0, " } }"));
+        CheckAgainstRebuild(Tree.Edit(2, 1, ""));
+
+        std::cout << "  ✓ Unbalanced braces" << "\n";
+    }
+
+    std::cout << "\n";
+}
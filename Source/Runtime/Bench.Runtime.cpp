@@ -0,0 +1,21 @@
+#include <iostream>
+
+// Forward declarations of all benchmark functions
+void Bench_Runtime_001_SimdMath();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX RUNTIME BENCHMARKS" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Bench_Runtime_001_SimdMath();
+
+        std::cout << "\n";
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Benchmark failed with exception: " << E.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,220 @@
+#include <cmath>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Math.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr size_t Count = 1 << 18;
+    constexpr int Rounds = 20;
+
+    /** What a straightforward engine would write: packed floats and per-component code */
+    namespace Naive {
+        struct Vector3 { float X, Y, Z; };
+        struct Quat { float X, Y, Z, W; };
+        struct Transform { Vector3 Translation; Quat Rotation; Vector3 Scale; };
+
+        Vector3 Add(const Vector3& A, const Vector3& B) { return { A.X + B.X, A.Y + B.Y, A.Z + B.Z }; }
+        Vector3 Scale(const Vector3& A, const float S) { return { A.X * S, A.Y * S, A.Z * S }; }
+        Vector3 Multiply(const Vector3& A, const Vector3& B) { return { A.X * B.X, A.Y * B.Y, A.Z * B.Z }; }
+        float Dot(const Vector3& A, const Vector3& B) { return A.X * B.X + A.Y * B.Y + A.Z * B.Z; }
+        Vector3 Cross(const Vector3& A, const Vector3& B) {
+            return { A.Y * B.Z - A.Z * B.Y, A.Z * B.X - A.X * B.Z, A.X * B.Y - A.Y * B.X };
+        }
+        Vector3 Normalize(const Vector3& A) {
+            const float Squared = Dot(A, A);
+            return Squared > 0.0f ? Scale(A, 1.0f / std::sqrt(Squared)) : Vector3{ 0.0f, 0.0f, 0.0f };
+        }
+
+        Quat Multiply(const Quat& A, const Quat& B) {
+            return { A.W * B.X + A.X * B.W + A.Y * B.Z - A.Z * B.Y,
+                     A.W * B.Y - A.X * B.Z + A.Y * B.W + A.Z * B.X,
+                     A.W * B.Z + A.X * B.Y - A.Y * B.X + A.Z * B.W,
+                     A.W * B.W - A.X * B.X - A.Y * B.Y - A.Z * B.Z };
+        }
+        Vector3 Rotate(const Quat& Q, const Vector3& V) {
+            const Vector3 Axis{ Q.X, Q.Y, Q.Z };
+            const Vector3 Twice = Scale(Cross(Axis, V), 2.0f);
+            return Add(Add(V, Scale(Twice, Q.W)), Cross(Axis, Twice));
+        }
+        Quat Slerp(const Quat& A, Quat B, const float T) {
+            float Cosine = A.X * B.X + A.Y * B.Y + A.Z * B.Z + A.W * B.W;
+            if (Cosine < 0.0f) {
+                B = { -B.X, -B.Y, -B.Z, -B.W };
+                Cosine = -Cosine;
+            }
+            if (Cosine > 0.9995f) {
+                Quat Mixed{ A.X + (B.X - A.X) * T, A.Y + (B.Y - A.Y) * T, A.Z + (B.Z - A.Z) * T, A.W + (B.W - A.W) * T };
+                const float Inverse = 1.0f / std::sqrt(Mixed.X * Mixed.X + Mixed.Y * Mixed.Y + Mixed.Z * Mixed.Z + Mixed.W * Mixed.W);
+                return { Mixed.X * Inverse, Mixed.Y * Inverse, Mixed.Z * Inverse, Mixed.W * Inverse };
+            }
+            const float Angle = std::acos(Cosine);
+            const float Inverse = 1.0f / std::sin(Angle);
+            const float From = std::sin((1.0f - T) * Angle) * Inverse;
+            const float To = std::sin(T * Angle) * Inverse;
+            return { A.X * From + B.X * To, A.Y * From + B.Y * To, A.Z * From + B.Z * To, A.W * From + B.W * To };
+        }
+        Transform Compose(const Transform& Parent, const Transform& Child) {
+            return { Add(Rotate(Parent.Rotation, Multiply(Parent.Scale, Child.Translation)), Parent.Translation),
+                     Multiply(Parent.Rotation, Child.Rotation), Multiply(Parent.Scale, Child.Scale) };
+        }
+    }
+
+    float Random(uint32_t& State) {
+        State = State * 1664525u + 1013904223u;
+        return static_cast<float>(State >> 8) / static_cast<float>(1 << 24) * 2.0f - 1.0f;
+    }
+
+    /** Best of Rounds, in nanoseconds per element */
+    template<typename Body>
+    double Measure(Body&& Run) {
+        double Best = 1e30;
+        for (int Round = 0; Round < Rounds; ++Round) {
+            Stopwatch Timer;
+            Run();
+            Best = std::min(Best, Timer.ElapsedMilliseconds());
+        }
+        return Best * 1e6 / static_cast<double>(Count);
+    }
+
+    void Report(const char* Label, const double Scalar, const double Simd) {
+        std::cout << "\n  " << Label << "\n";
+        PrintRow("  naive scalar", Scalar, "ns/op");
+        PrintRow("  SIMD runtime", Simd, "ns/op");
+        PrintRow("  speedup", Scalar / Simd, "x");
+    }
+}
+
+void Bench_Runtime_001_SimdMath() {
+    PrintHeader("Runtime Benchmark 001: SIMD Math vs Naive Scalar Structs");
+
+    uint32_t Seed = 12345;
+    std::vector<Naive::Vector3> NaivePositions(Count);
+    std::vector<Naive::Vector3> NaiveVelocities(Count);
+    std::vector<Naive::Quat> NaiveRotations(Count);
+    std::vector<Naive::Transform> NaiveLocals(Count);
+    std::vector<Vector3> Positions(Count);
+    std::vector<Vector3> Velocities(Count);
+    std::vector<Quat> Rotations(Count);
+    std::vector<Transform> Locals(Count);
+
+    for (size_t Index = 0; Index < Count; ++Index) {
+        const Vector3 Position(Random(Seed), Random(Seed), Random(Seed));
+        const Vector3 Velocity(Random(Seed), Random(Seed), Random(Seed));
+        const Quat Rotation = Normalize(Quat(Random(Seed), Random(Seed), Random(Seed), Random(Seed)));
+        Positions[Index] = Position;
+        Velocities[Index] = Velocity;
+        Rotations[Index] = Rotation;
+        // Scales alternate with their inverse so the hierarchy neither overflows nor goes denormal
+        const Vector3 Grow = Vector3(1.0f, 1.0f, 1.0f) + Velocity * 0.1f;
+        Locals[Index] = { Position, Rotation, Index % 2 == 0 ? Grow : Vector3(1.0f / Grow.X, 1.0f / Grow.Y, 1.0f / Grow.Z) };
+
+        NaivePositions[Index] = { Position.X, Position.Y, Position.Z };
+        NaiveVelocities[Index] = { Velocity.X, Velocity.Y, Velocity.Z };
+        NaiveRotations[Index] = { Rotation.X, Rotation.Y, Rotation.Z, Rotation.W };
+        const Vector3 Scale = Locals[Index].Scale;
+        NaiveLocals[Index] = { NaivePositions[Index], NaiveRotations[Index], { Scale.X, Scale.Y, Scale.Z } };
+    }
+
+    std::vector<Naive::Vector3> NaiveOut(Count);
+    std::vector<Naive::Quat> NaiveQuatOut(Count);
+    std::vector<Naive::Transform> NaiveTransformOut(Count);
+    std::vector<Vector3> Out(Count);
+    std::vector<Quat> QuatOut(Count);
+    std::vector<Transform> TransformOut(Count);
+
+    // Integration step: P + V * Dt
+    Report("integrate (add, scale)",
+           Measure([&] {
+               for (size_t I = 0; I < Count; ++I) {
+                   NaiveOut[I] = Naive::Add(NaivePositions[I], Naive::Scale(NaiveVelocities[I], 0.016f));
+               }
+               DoNotOptimize(NaiveOut[Count - 1]);
+           }),
+           Measure([&] {
+               for (size_t I = 0; I < Count; ++I) {
+                   Out[I] = Positions[I] + Velocities[I] * 0.016f;
+               }
+               DoNotOptimize(Out[Count - 1]);
+           }));
+
+    // Steering: normalize(cross(P, V)) scaled by dot(P, V)
+    Report("normalize, cross, dot",
+           Measure([&] {
+               for (size_t I = 0; I < Count; ++I) {
+                   const Naive::Vector3 Axis = Naive::Normalize(Naive::Cross(NaivePositions[I], NaiveVelocities[I]));
+                   NaiveOut[I] = Naive::Scale(Axis, Naive::Dot(NaivePositions[I], NaiveVelocities[I]));
+               }
+               DoNotOptimize(NaiveOut[Count - 1]);
+           }),
+           Measure([&] {
+               for (size_t I = 0; I < Count; ++I) {
+                   Out[I] = Normalize(Cross(Positions[I], Velocities[I])) * Dot(Positions[I], Velocities[I]);
+               }
+               DoNotOptimize(Out[Count - 1]);
+           }));
+
+    Report("quaternion rotate",
+           Measure([&] {
+               for (size_t I = 0; I < Count; ++I) {
+                   NaiveOut[I] = Naive::Rotate(NaiveRotations[I], NaivePositions[I]);
+               }
+               DoNotOptimize(NaiveOut[Count - 1]);
+           }),
+           Measure([&] {
+               for (size_t I = 0; I < Count; ++I) {
+                   Out[I] = Rotate(Rotations[I], Positions[I]);
+               }
+               DoNotOptimize(Out[Count - 1]);
+           }));
+
+    Report("quaternion multiply",
+           Measure([&] {
+               for (size_t I = 0; I + 1 < Count; ++I) {
+                   NaiveQuatOut[I] = Naive::Multiply(NaiveRotations[I], NaiveRotations[I + 1]);
+               }
+               DoNotOptimize(NaiveQuatOut[Count - 2]);
+           }),
+           Measure([&] {
+               for (size_t I = 0; I + 1 < Count; ++I) {
+                   QuatOut[I] = Rotations[I] * Rotations[I + 1];
+               }
+               DoNotOptimize(QuatOut[Count - 2]);
+           }));
+
+    Report("slerp",
+           Measure([&] {
+               for (size_t I = 0; I + 1 < Count; ++I) {
+                   NaiveQuatOut[I] = Naive::Slerp(NaiveRotations[I], NaiveRotations[I + 1], 0.3f);
+               }
+               DoNotOptimize(NaiveQuatOut[Count - 2]);
+           }),
+           Measure([&] {
+               for (size_t I = 0; I + 1 < Count; ++I) {
+                   QuatOut[I] = Slerp(Rotations[I], Rotations[I + 1], 0.3f);
+               }
+               DoNotOptimize(QuatOut[Count - 2]);
+           }));
+
+    // A parent chain: each transform composed onto the previous world transform
+    Report("transform compose (hierarchy)",
+           Measure([&] {
+               NaiveTransformOut[0] = NaiveLocals[0];
+               for (size_t I = 1; I < Count; ++I) {
+                   NaiveTransformOut[I] = Naive::Compose(NaiveTransformOut[I - 1], NaiveLocals[I]);
+               }
+               DoNotOptimize(NaiveTransformOut[Count - 1]);
+           }),
+           Measure([&] {
+               TransformOut[0] = Locals[0];
+               for (size_t I = 1; I < Count; ++I) {
+                   TransformOut[I] = Compose(TransformOut[I - 1], Locals[I]);
+               }
+               DoNotOptimize(TransformOut[Count - 1]);
+           }));
+
+    std::cout << "\n";
+}
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <cmath>
+
+#include "SIMD.h"
+
+namespace Vex {
+
+    // ============================================================================
+    // VECTORS
+    // ============================================================================
+
+    /**
+     * Two floats; too small for SIMD to pay off, so plain scalar code
+     */
+    struct alignas(8) Vector2 {
+        float X = 0.0f;
+        float Y = 0.0f;
+
+        Vector2() = default;
+        Vector2(const float X, const float Y) : X(X), Y(Y) {}
+    };
+
+    inline Vector2 operator+(const Vector2 A, const Vector2 B) { return { A.X + B.X, A.Y + B.Y }; }
+    inline Vector2 operator-(const Vector2 A, const Vector2 B) { return { A.X - B.X, A.Y - B.Y }; }
+    inline Vector2 operator*(const Vector2 A, const Vector2 B) { return { A.X * B.X, A.Y * B.Y }; }
+    inline Vector2 operator/(const Vector2 A, const Vector2 B) { return { A.X / B.X, A.Y / B.Y }; }
+    inline Vector2 operator*(const Vector2 A, const float Scale) { return { A.X * Scale, A.Y * Scale }; }
+    inline Vector2 operator-(const Vector2 A) { return { -A.X, -A.Y }; }
+    inline bool operator==(const Vector2 A, const Vector2 B) { return A.X == B.X && A.Y == B.Y; }
+
+    inline float Dot(const Vector2 A, const Vector2 B) { return A.X * B.X + A.Y * B.Y; }
+    inline float Length(const Vector2 A) { return std::sqrt(Dot(A, A)); }
+    inline Vector2 Lerp(const Vector2 A, const Vector2 B, const float T) { return A + (B - A) * T; }
+
+    /** A scaled to length 1, or zero if A is zero */
+    inline Vector2 Normalize(const Vector2 A) {
+        const float Squared = Dot(A, A);
+        return Squared > 0.0f ? A * (1.0f / std::sqrt(Squared)) : Vector2();
+    }
+
+    /**
+     * Three floats padded to one 16-byte lane set
+     *
+     * W is padding and kept at zero by every operation, so a Vector3 loads
+     * and stores as a single aligned SSE register.
+     */
+    struct alignas(16) Vector3 {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float W = 0.0f;
+
+        Vector3() = default;
+        Vector3(const float X, const float Y, const float Z) : X(X), Y(Y), Z(Z) {}
+        explicit Vector3(const Float4 Lanes) { Float4::ClearW(Lanes).Store(&X); }
+
+        [[nodiscard]] Float4 Lanes() const { return Float4::Load(&X); }
+    };
+
+    inline Vector3 operator+(const Vector3& A, const Vector3& B) { return Vector3(A.Lanes() + B.Lanes()); }
+    inline Vector3 operator-(const Vector3& A, const Vector3& B) { return Vector3(A.Lanes() - B.Lanes()); }
+    inline Vector3 operator*(const Vector3& A, const Vector3& B) { return Vector3(A.Lanes() * B.Lanes()); }
+    inline Vector3 operator/(const Vector3& A, const Vector3& B) { return Vector3(A.Lanes() / B.Lanes()); }
+    inline Vector3 operator*(const Vector3& A, const float Scale) { return Vector3(A.Lanes() * Float4::Splat(Scale)); }
+    inline Vector3 operator-(const Vector3& A) { return Vector3(-A.Lanes()); }
+    inline bool operator==(const Vector3& A, const Vector3& B) { return Float4::Equal(A.Lanes(), B.Lanes()); }
+
+    inline float Dot(const Vector3& A, const Vector3& B) { return Float4::Dot3(A.Lanes(), B.Lanes()).GetX(); }
+    inline Vector3 Cross(const Vector3& A, const Vector3& B) { return Vector3(Float4::Cross3(A.Lanes(), B.Lanes())); }
+    inline float Length(const Vector3& A) { return std::sqrt(Dot(A, A)); }
+    inline float LengthSquared(const Vector3& A) { return Dot(A, A); }
+
+    inline Vector3 Lerp(const Vector3& A, const Vector3& B, const float T) {
+        return Vector3(Float4::MulAdd(B.Lanes() - A.Lanes(), Float4::Splat(T), A.Lanes()));
+    }
+
+    /** A scaled to length 1, or zero if A is zero; stays in registers throughout */
+    inline Vector3 Normalize(const Vector3& A) {
+        const Float4 Lanes = A.Lanes();
+        const Float4 Squared = Float4::Dot3(Lanes, Lanes);
+        const Float4 Scaled = Lanes / Float4::Sqrt(Squared);
+        return Vector3(Float4::Select(Float4::Less(Float4(), Squared), Scaled, Float4()));
+    }
+
+    struct alignas(16) Vector4 {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float W = 0.0f;
+
+        Vector4() = default;
+        Vector4(const float X, const float Y, const float Z, const float W) : X(X), Y(Y), Z(Z), W(W) {}
+        explicit Vector4(const Float4 Lanes) { Lanes.Store(&X); }
+
+        [[nodiscard]] Float4 Lanes() const { return Float4::Load(&X); }
+    };
+
+    inline Vector4 operator+(const Vector4& A, const Vector4& B) { return Vector4(A.Lanes() + B.Lanes()); }
+    inline Vector4 operator-(const Vector4& A, const Vector4& B) { return Vector4(A.Lanes() - B.Lanes()); }
+    inline Vector4 operator*(const Vector4& A, const Vector4& B) { return Vector4(A.Lanes() * B.Lanes()); }
+    inline Vector4 operator/(const Vector4& A, const Vector4& B) { return Vector4(A.Lanes() / B.Lanes()); }
+    inline Vector4 operator*(const Vector4& A, const float Scale) { return Vector4(A.Lanes() * Float4::Splat(Scale)); }
+    inline Vector4 operator-(const Vector4& A) { return Vector4(-A.Lanes()); }
+    inline bool operator==(const Vector4& A, const Vector4& B) { return Float4::Equal(A.Lanes(), B.Lanes()); }
+
+    inline float Dot(const Vector4& A, const Vector4& B) { return Float4::Dot4(A.Lanes(), B.Lanes()).GetX(); }
+    inline float Length(const Vector4& A) { return std::sqrt(Dot(A, A)); }
+
+    inline Vector4 Lerp(const Vector4& A, const Vector4& B, const float T) {
+        return Vector4(Float4::MulAdd(B.Lanes() - A.Lanes(), Float4::Splat(T), A.Lanes()));
+    }
+
+    inline Vector4 Normalize(const Vector4& A) {
+        const Float4 Lanes = A.Lanes();
+        const Float4 Squared = Float4::Dot4(Lanes, Lanes);
+        return Vector4(Float4::Select(Float4::Less(Float4(), Squared), Lanes / Float4::Sqrt(Squared), Float4()));
+    }
+
+    // ============================================================================
+    // ROTATIONS
+    // ============================================================================
+
+    /**
+     * Rotation quaternion, X Y Z the vector part and W the scalar part
+     *
+     * A * B applies B first, then A. Operations expect unit quaternions
+     * except Normalize.
+     */
+    struct alignas(16) Quat {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float W = 1.0f;
+
+        Quat() = default;
+        Quat(const float X, const float Y, const float Z, const float W) : X(X), Y(Y), Z(Z), W(W) {}
+        explicit Quat(const Float4 Lanes) { Lanes.Store(&X); }
+
+        [[nodiscard]] Float4 Lanes() const { return Float4::Load(&X); }
+
+        /** Rotation by Angle radians around a unit Axis */
+        static Quat FromAxisAngle(const Vector3& Axis, const float Angle) {
+            const float Half = Angle * 0.5f;
+            const float Sine = std::sin(Half);
+            return { Axis.X * Sine, Axis.Y * Sine, Axis.Z * Sine, std::cos(Half) };
+        }
+    };
+
+    inline bool operator==(const Quat& A, const Quat& B) { return Float4::Equal(A.Lanes(), B.Lanes()); }
+
+    /** Hamilton product as four shuffled multiplies and adds */
+    inline Quat operator*(const Quat& A, const Quat& B) {
+        const Float4 L = A.Lanes();
+        const Float4 R = B.Lanes();
+        const Float4 FlipW = Float4::Set(1.0f, 1.0f, 1.0f, -1.0f);
+
+        const Float4 Scalar = Float4::Shuffle<3, 3, 3, 3>(L) * R;
+        const Float4 First = Float4::Shuffle<0, 1, 2, 0>(L) * Float4::Shuffle<3, 3, 3, 0>(R);
+        const Float4 Second = Float4::Shuffle<1, 2, 0, 1>(L) * Float4::Shuffle<2, 0, 1, 1>(R);
+        const Float4 Third = Float4::Shuffle<2, 0, 1, 2>(L) * Float4::Shuffle<1, 2, 0, 2>(R);
+        return Quat(Float4::MulAdd(First + Second, FlipW, Scalar) - Third);
+    }
+
+    inline float Dot(const Quat& A, const Quat& B) { return Float4::Dot4(A.Lanes(), B.Lanes()).GetX(); }
+    inline Quat Conjugate(const Quat& A) { return Quat(A.Lanes() * Float4::Set(-1.0f, -1.0f, -1.0f, 1.0f)); }
+
+    /** A scaled to length 1, or the identity if A is zero */
+    inline Quat Normalize(const Quat& A) {
+        const Float4 Lanes = A.Lanes();
+        const Float4 Squared = Float4::Dot4(Lanes, Lanes);
+        return Quat(Float4::Select(Float4::Less(Float4(), Squared), Lanes / Float4::Sqrt(Squared), Quat().Lanes()));
+    }
+
+    /** V rotated by Q: V + 2W (Q x V) + Q x (2 (Q x V)) */
+    inline Vector3 Rotate(const Quat& Q, const Vector3& V) {
+        const Float4 Rotation = Q.Lanes();
+        const Float4 Twice = Float4::Cross3(Rotation, V.Lanes()) * Float4::Splat(2.0f);
+        const Float4 Turned = Float4::MulAdd(Float4::Shuffle<3, 3, 3, 3>(Rotation), Twice, V.Lanes());
+        return Vector3(Turned + Float4::Cross3(Rotation, Twice));
+    }
+
+    /**
+     * Spherical interpolation along the shorter arc; falls back to a
+     * normalized lerp when A and B are nearly equal, where the sine of the
+     * angle loses precision
+     */
+    inline Quat Slerp(const Quat& A, const Quat& B, const float T) {
+        Float4 To = B.Lanes();
+        float Cosine = Dot(A, B);
+        if (Cosine < 0.0f) {
+            To = -To;
+            Cosine = -Cosine;
+        }
+
+        if (Cosine > 0.9995f) {
+            return Normalize(Quat(Float4::MulAdd(To - A.Lanes(), Float4::Splat(T), A.Lanes())));
+        }
+
+        const float Angle = std::acos(Cosine);
+        const float Inverse = 1.0f / std::sin(Angle);
+        const Float4 From = Float4::Splat(std::sin((1.0f - T) * Angle) * Inverse);
+        return Quat(Float4::MulAdd(A.Lanes(), From, To * Float4::Splat(std::sin(T * Angle) * Inverse)));
+    }
+
+    // ============================================================================
+    // COLOR
+    // ============================================================================
+
+    /** Linear RGBA with float channels */
+    struct alignas(16) Color {
+        float R = 0.0f;
+        float G = 0.0f;
+        float B = 0.0f;
+        float A = 1.0f;
+
+        Color() = default;
+        Color(const float R, const float G, const float B, const float A = 1.0f) : R(R), G(G), B(B), A(A) {}
+        explicit Color(const Float4 Lanes) { Lanes.Store(&R); }
+
+        [[nodiscard]] Float4 Lanes() const { return Float4::Load(&R); }
+    };
+
+    inline Color operator+(const Color& A, const Color& B) { return Color(A.Lanes() + B.Lanes()); }
+    inline Color operator-(const Color& A, const Color& B) { return Color(A.Lanes() - B.Lanes()); }
+    inline Color operator*(const Color& A, const Color& B) { return Color(A.Lanes() * B.Lanes()); }     // Modulate
+    inline Color operator*(const Color& A, const float Scale) { return Color(A.Lanes() * Float4::Splat(Scale)); }
+    inline bool operator==(const Color& A, const Color& B) { return Float4::Equal(A.Lanes(), B.Lanes()); }
+
+    inline Color Lerp(const Color& A, const Color& B, const float T) {
+        return Color(Float4::MulAdd(B.Lanes() - A.Lanes(), Float4::Splat(T), A.Lanes()));
+    }
+
+    /** Every channel clamped to [0, 1] */
+    inline Color Saturate(const Color& A) {
+        return Color(Float4::Min(Float4::Max(A.Lanes(), Float4()), Float4::Splat(1.0f)));
+    }
+
+    // ============================================================================
+    // TRANSFORMS
+    // ============================================================================
+
+    /** Column-major 4x4 matrix; Columns[3] holds the translation */
+    struct alignas(16) Matrix4 {
+        Vector4 Columns[4] = {
+            { 1.0f, 0.0f, 0.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f, 0.0f },
+            { 0.0f, 0.0f, 1.0f, 0.0f },
+            { 0.0f, 0.0f, 0.0f, 1.0f },
+        };
+    };
+
+    /** A * B: each column of B is a combination of A's columns */
+    inline Matrix4 operator*(const Matrix4& A, const Matrix4& B) {
+        const Float4 C0 = A.Columns[0].Lanes();
+        const Float4 C1 = A.Columns[1].Lanes();
+        const Float4 C2 = A.Columns[2].Lanes();
+        const Float4 C3 = A.Columns[3].Lanes();
+
+        Matrix4 Result;
+        for (int Column = 0; Column < 4; ++Column) {
+            const Float4 Weights = B.Columns[Column].Lanes();
+            Float4 Sum = C0 * Float4::Shuffle<0, 0, 0, 0>(Weights);
+            Sum = Float4::MulAdd(C1, Float4::Shuffle<1, 1, 1, 1>(Weights), Sum);
+            Sum = Float4::MulAdd(C2, Float4::Shuffle<2, 2, 2, 2>(Weights), Sum);
+            Sum = Float4::MulAdd(C3, Float4::Shuffle<3, 3, 3, 3>(Weights), Sum);
+            Result.Columns[Column] = Vector4(Sum);
+        }
+        return Result;
+    }
+
+    inline Vector3 TransformPoint(const Matrix4& M, const Vector3& P) {
+        Float4 Sum = Float4::MulAdd(M.Columns[0].Lanes(), Float4::Splat(P.X), M.Columns[3].Lanes());
+        Sum = Float4::MulAdd(M.Columns[1].Lanes(), Float4::Splat(P.Y), Sum);
+        Sum = Float4::MulAdd(M.Columns[2].Lanes(), Float4::Splat(P.Z), Sum);
+        return Vector3(Sum);
+    }
+
+    /**
+     * Scale, then rotate, then translate
+     *
+     * Compose(Parent, Child) is Child expressed in Parent's space. With
+     * non-uniform scale on a rotated parent the result is the usual
+     * scale-rotate-translate approximation (no shear), as in most engines.
+     */
+    struct Transform {
+        Vector3 Translation;
+        Quat Rotation;
+        Vector3 Scale{ 1.0f, 1.0f, 1.0f };
+    };
+
+    inline Vector3 TransformPoint(const Transform& T, const Vector3& P) {
+        return Rotate(T.Rotation, T.Scale * P) + T.Translation;
+    }
+
+    inline Transform Compose(const Transform& Parent, const Transform& Child) {
+        Transform Result;
+        Result.Translation = TransformPoint(Parent, Child.Translation);
+        Result.Rotation = Parent.Rotation * Child.Rotation;
+        Result.Scale = Parent.Scale * Child.Scale;
+        return Result;
+    }
+
+    /** Exact for uniform scale */
+    inline Transform Inverse(const Transform& T) {
+        Transform Result;
+        Result.Rotation = Conjugate(T.Rotation);
+        Result.Scale = Vector3(Float4::Splat(1.0f) / T.Scale.Lanes());
+        Result.Translation = -(Result.Scale * Rotate(Result.Rotation, T.Translation));
+        return Result;
+    }
+
+    inline Matrix4 ToMatrix(const Transform& T) {
+        Matrix4 Result;
+        const Vector3 Axes[3] = { { T.Scale.X, 0.0f, 0.0f }, { 0.0f, T.Scale.Y, 0.0f }, { 0.0f, 0.0f, T.Scale.Z } };
+        for (int Column = 0; Column < 3; ++Column) {
+            Result.Columns[Column] = Vector4(Rotate(T.Rotation, Axes[Column]).Lanes());
+        }
+        Result.Columns[3] = Vector4(T.Translation.X, T.Translation.Y, T.Translation.Z, 1.0f);
+        return Result;
+    }
+}
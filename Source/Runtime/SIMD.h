@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cmath>
+
+// SSE2 is part of every x86-64 target; define VEX_MATH_SCALAR to force the portable path
+#if !defined(VEX_MATH_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define VEX_SIMD_SSE 1
+    #include <emmintrin.h>
+#else
+    #define VEX_SIMD_SSE 0
+#endif
+
+namespace Vex {
+
+    /**
+     * Four floats in one SSE register, or in a plain array without SSE
+     *
+     * The building block of the math types: each of their operations is a
+     * handful of Float4 operations, which compile to single instructions
+     * on the SSE path. Loads and stores are aligned unless named otherwise.
+     * Dot3 and Dot4 return the sum in every lane, so it can feed the next
+     * operation without leaving the register.
+     */
+    struct Float4 {
+    #if VEX_SIMD_SSE
+        __m128 V;
+
+        Float4() : V(_mm_setzero_ps()) {}
+        explicit Float4(const __m128 V) : V(V) {}
+
+        static Float4 Load(const float* Aligned) { return Float4(_mm_load_ps(Aligned)); }
+        static Float4 LoadUnaligned(const float* Data) { return Float4(_mm_loadu_ps(Data)); }
+        static Float4 Set(const float X, const float Y, const float Z, const float W) { return Float4(_mm_setr_ps(X, Y, Z, W)); }
+        static Float4 Splat(const float Value) { return Float4(_mm_set1_ps(Value)); }
+
+        void Store(float* Aligned) const { _mm_store_ps(Aligned, V); }
+        void StoreUnaligned(float* Data) const { _mm_storeu_ps(Data, V); }
+        [[nodiscard]] float GetX() const { return _mm_cvtss_f32(V); }
+
+        friend Float4 operator+(const Float4 A, const Float4 B) { return Float4(_mm_add_ps(A.V, B.V)); }
+        friend Float4 operator-(const Float4 A, const Float4 B) { return Float4(_mm_sub_ps(A.V, B.V)); }
+        friend Float4 operator*(const Float4 A, const Float4 B) { return Float4(_mm_mul_ps(A.V, B.V)); }
+        friend Float4 operator/(const Float4 A, const Float4 B) { return Float4(_mm_div_ps(A.V, B.V)); }
+        friend Float4 operator-(const Float4 A) { return Float4(_mm_xor_ps(A.V, _mm_set1_ps(-0.0f))); }
+
+        static Float4 Min(const Float4 A, const Float4 B) { return Float4(_mm_min_ps(A.V, B.V)); }
+        static Float4 Max(const Float4 A, const Float4 B) { return Float4(_mm_max_ps(A.V, B.V)); }
+        static Float4 Sqrt(const Float4 A) { return Float4(_mm_sqrt_ps(A.V)); }
+
+        /** Lanes picked from A: result lane i is A[Ii] */
+        template<int I0, int I1, int I2, int I3>
+        static Float4 Shuffle(const Float4 A) { return Float4(_mm_shuffle_ps(A.V, A.V, _MM_SHUFFLE(I3, I2, I1, I0))); }
+
+        static Float4 Dot4(const Float4 A, const Float4 B) {
+            const __m128 Product = _mm_mul_ps(A.V, B.V);
+            const __m128 Pairs = _mm_add_ps(Product, _mm_shuffle_ps(Product, Product, _MM_SHUFFLE(2, 3, 0, 1)));
+            return Float4(_mm_add_ps(Pairs, _mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        /** Sum over X, Y and Z only; W may hold anything */
+        static Float4 Dot3(const Float4 A, const Float4 B) {
+            const __m128 Product = _mm_and_ps(_mm_mul_ps(A.V, B.V), _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+            const __m128 Pairs = _mm_add_ps(Product, _mm_shuffle_ps(Product, Product, _MM_SHUFFLE(2, 3, 0, 1)));
+            return Float4(_mm_add_ps(Pairs, _mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        /** A with W set to 0 */
+        static Float4 ClearW(const Float4 A) { return Float4(_mm_and_ps(A.V, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)))); }
+
+        /** A if the lane of Mask is set, else B; Mask lanes are all ones or all zeros */
+        static Float4 Select(const Float4 Mask, const Float4 A, const Float4 B) {
+            return Float4(_mm_or_ps(_mm_and_ps(Mask.V, A.V), _mm_andnot_ps(Mask.V, B.V)));
+        }
+
+        static Float4 Less(const Float4 A, const Float4 B) { return Float4(_mm_cmplt_ps(A.V, B.V)); }
+        static bool Equal(const Float4 A, const Float4 B) { return _mm_movemask_ps(_mm_cmpeq_ps(A.V, B.V)) == 0xF; }
+    #else
+        float V[4];
+
+        Float4() : V{ 0.0f, 0.0f, 0.0f, 0.0f } {}
+
+        static Float4 Load(const float* Aligned) { return Set(Aligned[0], Aligned[1], Aligned[2], Aligned[3]); }
+        static Float4 LoadUnaligned(const float* Data) { return Load(Data); }
+        static Float4 Set(const float X, const float Y, const float Z, const float W) {
+            Float4 Result;
+            Result.V[0] = X;
+            Result.V[1] = Y;
+            Result.V[2] = Z;
+            Result.V[3] = W;
+            return Result;
+        }
+        static Float4 Splat(const float Value) { return Set(Value, Value, Value, Value); }
+
+        void Store(float* Aligned) const {
+            for (int Lane = 0; Lane < 4; ++Lane) {
+                Aligned[Lane] = V[Lane];
+            }
+        }
+        void StoreUnaligned(float* Data) const { Store(Data); }
+        [[nodiscard]] float GetX() const { return V[0]; }
+
+        template<typename Operation>
+        static Float4 Map(const Float4 A, const Float4 B, Operation Apply) {
+            return Set(Apply(A.V[0], B.V[0]), Apply(A.V[1], B.V[1]), Apply(A.V[2], B.V[2]), Apply(A.V[3], B.V[3]));
+        }
+
+        friend Float4 operator+(const Float4 A, const Float4 B) { return Map(A, B, [](float L, float R) { return L + R; }); }
+        friend Float4 operator-(const Float4 A, const Float4 B) { return Map(A, B, [](float L, float R) { return L - R; }); }
+        friend Float4 operator*(const Float4 A, const Float4 B) { return Map(A, B, [](float L, float R) { return L * R; }); }
+        friend Float4 operator/(const Float4 A, const Float4 B) { return Map(A, B, [](float L, float R) { return L / R; }); }
+        friend Float4 operator-(const Float4 A) { return Set(-A.V[0], -A.V[1], -A.V[2], -A.V[3]); }
+
+        static Float4 Min(const Float4 A, const Float4 B) { return Map(A, B, [](float L, float R) { return L < R ? L : R; }); }
+        static Float4 Max(const Float4 A, const Float4 B) { return Map(A, B, [](float L, float R) { return L > R ? L : R; }); }
+        static Float4 Sqrt(const Float4 A) { return Set(std::sqrt(A.V[0]), std::sqrt(A.V[1]), std::sqrt(A.V[2]), std::sqrt(A.V[3])); }
+
+        template<int I0, int I1, int I2, int I3>
+        static Float4 Shuffle(const Float4 A) { return Set(A.V[I0], A.V[I1], A.V[I2], A.V[I3]); }
+
+        static Float4 Dot4(const Float4 A, const Float4 B) {
+            return Splat(A.V[0] * B.V[0] + A.V[1] * B.V[1] + A.V[2] * B.V[2] + A.V[3] * B.V[3]);
+        }
+        static Float4 Dot3(const Float4 A, const Float4 B) {
+            return Splat(A.V[0] * B.V[0] + A.V[1] * B.V[1] + A.V[2] * B.V[2]);
+        }
+
+        static Float4 ClearW(const Float4 A) { return Set(A.V[0], A.V[1], A.V[2], 0.0f); }
+
+        static Float4 Select(const Float4 Mask, const Float4 A, const Float4 B) {
+            return Set(Mask.V[0] != 0.0f ? A.V[0] : B.V[0], Mask.V[1] != 0.0f ? A.V[1] : B.V[1],
+                       Mask.V[2] != 0.0f ? A.V[2] : B.V[2], Mask.V[3] != 0.0f ? A.V[3] : B.V[3]);
+        }
+
+        /** Lanes are 1.0 for true (any nonzero works for Select) */
+        static Float4 Less(const Float4 A, const Float4 B) {
+            return Map(A, B, [](float L, float R) { return L < R ? 1.0f : 0.0f; });
+        }
+        static bool Equal(const Float4 A, const Float4 B) {
+            return A.V[0] == B.V[0] && A.V[1] == B.V[1] && A.V[2] == B.V[2] && A.V[3] == B.V[3];
+        }
+    #endif
+
+        /** A * B + C */
+        static Float4 MulAdd(const Float4 A, const Float4 B, const Float4 C) { return A * B + C; }
+
+        /** X, Y, Z of A x B; W is 0 when A's W and B's W are finite */
+        static Float4 Cross3(const Float4 A, const Float4 B) {
+            const Float4 AYZX = Shuffle<1, 2, 0, 3>(A);
+            const Float4 BYZX = Shuffle<1, 2, 0, 3>(B);
+            return Shuffle<1, 2, 0, 3>(A * BYZX - AYZX * B);
+        }
+    };
+}
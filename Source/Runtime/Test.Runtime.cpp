@@ -0,0 +1,29 @@
+#include <iostream>
+
+// Forward declarations of all test functions
+void Test_Runtime_001_Math();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX RUNTIME TEST SUITE" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Test_Runtime_001_Math();
+
+        std::cout << "\n";
+
+        std::cout << "========================================" << "\n";
+        std::cout << " ALL TESTS PASSED!" << "\n";
+        std::cout << "========================================" << "\n";
+
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Test failed with exception: " << E.what() << "\n";
+        return 1;
+    } catch (...) {
+        std::cerr << "Test failed with unknown exception" << "\n";
+        return 1;
+    }
+}
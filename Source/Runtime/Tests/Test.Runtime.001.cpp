@@ -0,0 +1,144 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "../Math.h"
+
+using namespace Vex;
+
+namespace {
+    constexpr float Pi = 3.14159265358979f;
+
+    bool Near(const float A, const float B, const float Tolerance = 1e-5f) {
+        return std::fabs(A - B) <= Tolerance * (1.0f + std::fabs(A) + std::fabs(B));
+    }
+
+    bool Near(const Vector3& A, const Vector3& B, const float Tolerance = 1e-5f) {
+        return Near(A.X, B.X, Tolerance) && Near(A.Y, B.Y, Tolerance) && Near(A.Z, B.Z, Tolerance) && A.W == 0.0f;
+    }
+
+    bool Near(const Quat& A, const Quat& B, const float Tolerance = 1e-5f) {
+        return Near(A.X, B.X, Tolerance) && Near(A.Y, B.Y, Tolerance) && Near(A.Z, B.Z, Tolerance) && Near(A.W, B.W, Tolerance);
+    }
+
+    /** Textbook Hamilton product, component by component */
+    Quat Multiply(const Quat& A, const Quat& B) {
+        return { A.W * B.X + A.X * B.W + A.Y * B.Z - A.Z * B.Y,
+                 A.W * B.Y - A.X * B.Z + A.Y * B.W + A.Z * B.X,
+                 A.W * B.Z + A.X * B.Y - A.Y * B.X + A.Z * B.W,
+                 A.W * B.W - A.X * B.X - A.Y * B.Y - A.Z * B.Z };
+    }
+}
+
+void Test_Runtime_001_Math() {
+    std::cout << "--- Runtime Test 001: Math Types (" << (VEX_SIMD_SSE ? "SSE" : "scalar") << ") ---" << "\n";
+
+    // Layouts are one aligned register each
+    {
+        static_assert(sizeof(Vector3) == 16 && alignof(Vector3) == 16, "Vector3 is one register");
+        static_assert(sizeof(Vector4) == 16 && sizeof(Quat) == 16 && sizeof(Color) == 16, "Four lanes each");
+        static_assert(sizeof(Vector2) == 8, "Vector2 stays scalar");
+        static_assert(sizeof(Matrix4) == 64 && alignof(Matrix4) == 16, "Four columns");
+
+        Vector3 Array[3];
+        assert(reinterpret_cast<uintptr_t>(&Array[1]) % 16 == 0);
+
+        std::cout << "  ✓ Layout" << "\n";
+    }
+
+    // Vectors: lane-wise operators, dot, cross, length and normalize
+    {
+        const Vector3 A(1.0f, 2.0f, 3.0f);
+        const Vector3 B(-4.0f, 5.0f, 0.5f);
+        assert(A + B == Vector3(-3.0f, 7.0f, 3.5f));
+        assert(A - B == Vector3(5.0f, -3.0f, 2.5f));
+        assert(A * B == Vector3(-4.0f, 10.0f, 1.5f));
+        assert(A * 2.0f == Vector3(2.0f, 4.0f, 6.0f));
+        assert(-A == Vector3(-1.0f, -2.0f, -3.0f));
+        assert(Near(A / B, Vector3(-0.25f, 0.4f, 6.0f)));          // Padding stays zero through 0 / 0
+        assert(Dot(A, B) == 7.5f);
+        assert(Cross(A, B) == Vector3(2.0f * 0.5f - 3.0f * 5.0f, 3.0f * -4.0f - 1.0f * 0.5f, 1.0f * 5.0f - 2.0f * -4.0f));
+        assert(Cross(Vector3(1, 0, 0), Vector3(0, 1, 0)) == Vector3(0, 0, 1));
+        assert(Near(Length(Vector3(3.0f, 4.0f, 12.0f)), 13.0f));
+        assert(Near(Normalize(Vector3(0.0f, 3.0f, 4.0f)), Vector3(0.0f, 0.6f, 0.8f)));
+        assert(Normalize(Vector3()) == Vector3());
+        assert(Lerp(A, B, 0.5f) == Vector3(-1.5f, 3.5f, 1.75f));
+
+        const Vector4 C(1.0f, 2.0f, 3.0f, 4.0f);
+        assert(Dot(C, C) == 30.0f && C + C == C * 2.0f);
+        assert(Near(Length(Normalize(C)), 1.0f));
+
+        const Vector2 D(3.0f, 4.0f);
+        assert(Length(D) == 5.0f && Normalize(D) == Vector2(0.6f, 0.8f) && Dot(D, D) == 25.0f);
+
+        std::cout << "  ✓ Vectors" << "\n";
+    }
+
+    // Quaternions: product, rotation, slerp
+    {
+        const Quat A = Normalize(Quat(0.1f, -0.7f, 0.3f, 0.6f));
+        const Quat B = Normalize(Quat(-0.5f, 0.2f, 0.9f, -0.1f));
+        assert(Near(A * B, Multiply(A, B)));
+        assert(Near(Quat() * A, A));
+        assert(Near(A * Conjugate(A), Quat()));
+
+        // A quarter turn around Z takes X to Y
+        const Quat Turn = Quat::FromAxisAngle(Vector3(0.0f, 0.0f, 1.0f), Pi / 2.0f);
+        assert(Near(Rotate(Turn, Vector3(1.0f, 0.0f, 0.0f)), Vector3(0.0f, 1.0f, 0.0f)));
+        assert(Near(Rotate(Turn * Turn, Vector3(1.0f, 2.0f, 3.0f)), Vector3(-1.0f, -2.0f, 3.0f)));
+
+        // Rotating by a product is rotating twice, B first
+        const Vector3 Point(0.3f, -1.2f, 2.0f);
+        assert(Near(Rotate(A * B, Point), Rotate(A, Rotate(B, Point))));
+
+        // Slerp ends at both inputs, moves at constant angular speed and takes the short way
+        const Quat Eighth = Quat::FromAxisAngle(Vector3(0.0f, 0.0f, 1.0f), Pi / 4.0f);
+        assert(Near(Slerp(Quat(), Turn, 0.0f), Quat()) && Near(Slerp(Quat(), Turn, 1.0f), Turn));
+        assert(Near(Slerp(Quat(), Turn, 0.5f), Eighth));
+        assert(Near(Slerp(Quat(), Quat(-Turn.X, -Turn.Y, -Turn.Z, -Turn.W), 0.5f), Eighth));
+        assert(Near(Slerp(A, A, 0.3f), A));
+        assert(Normalize(Quat(0.0f, 0.0f, 0.0f, 0.0f)) == Quat());
+
+        std::cout << "  ✓ Quaternions" << "\n";
+    }
+
+    // Colors
+    {
+        const Color Orange(1.0f, 0.5f, 0.0f);
+        assert(Orange * Color(0.5f, 0.5f, 0.5f, 0.5f) == Color(0.5f, 0.25f, 0.0f, 0.5f));
+        assert(Lerp(Orange, Color(0.0f, 0.5f, 1.0f, 0.0f), 0.5f) == Color(0.5f, 0.5f, 0.5f, 0.5f));
+        assert(Saturate(Color(2.0f, -1.0f, 0.25f, 1.5f)) == Color(1.0f, 0.0f, 0.25f, 1.0f));
+        assert(Orange + Orange == Orange * 2.0f);
+
+        std::cout << "  ✓ Colors" << "\n";
+    }
+
+    // Transforms and matrices agree with each other
+    {
+        Transform Parent;
+        Parent.Translation = Vector3(10.0f, 0.0f, -2.0f);
+        Parent.Rotation = Quat::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 0.7f);
+        Parent.Scale = Vector3(2.0f, 2.0f, 2.0f);
+
+        Transform Child;
+        Child.Translation = Vector3(1.0f, 2.0f, 3.0f);
+        Child.Rotation = Quat::FromAxisAngle(Normalize(Vector3(1.0f, 1.0f, 0.0f)), -1.1f);
+        Child.Scale = Vector3(0.5f, 1.0f, 3.0f);
+
+        const Vector3 Point(0.25f, -4.0f, 1.5f);
+        const Transform World = Compose(Parent, Child);
+        assert(Near(TransformPoint(World, Point), TransformPoint(Parent, TransformPoint(Child, Point)), 1e-4f));
+
+        const Matrix4 Product = ToMatrix(Parent) * ToMatrix(Child);
+        assert(Near(TransformPoint(Product, Point), TransformPoint(World, Point), 1e-4f));
+        assert(Near(TransformPoint(ToMatrix(World), Point), TransformPoint(World, Point), 1e-4f));
+
+        assert(Near(TransformPoint(Inverse(Parent), TransformPoint(Parent, Point)), Point, 1e-4f));
+
+        const Matrix4 Identity;
+        assert(Near(TransformPoint(Identity * Product, Point), TransformPoint(Product, Point)));
+
+        std::cout << "  ✓ Transforms" << "\n";
+    }
+}
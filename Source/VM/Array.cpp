@@ -0,0 +1,32 @@
+#include "Array.h"
+
+#include <memory>
+#include <new>
+
+namespace Vex {
+    void ArrayObject::Reset(const TypeLayout& NewLayout, const uint32_t NewType, const size_t NewCount, Value* Storage,
+                            const size_t NewCapacity) {
+        Layout = &NewLayout;
+        Type = NewType;
+        Shares.store(0, std::memory_order_relaxed);
+        Counted = false;
+        Count = NewCount;
+        FieldStride = NewLayout.IsSoA ? NewCount : 1;
+        ElementStride = NewLayout.IsSoA ? 1 : NewLayout.Fields.size();
+        Cells = Storage;
+        Capacity = NewCapacity;
+        if (NewLayout.IsSoA) {
+            for (size_t Field = 0; Field < NewLayout.Fields.size(); ++Field) {
+                std::uninitialized_fill_n(Cells + Field * NewCount, NewCount, NewLayout.Fields[Field].Default);
+            }
+            return;
+        }
+
+        Value* Cell = Cells;
+        for (size_t Element = 0; Element < NewCount; ++Element) {
+            for (const FieldLayout& Field : NewLayout.Fields) {
+                new (Cell++) Value(Field.Default);
+            }
+        }
+    }
+}
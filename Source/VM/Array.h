@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Bytecode.h"
+
+namespace Vex {
+
+    /**
+     * Elements of a Define type, made by NEWARRAY or NEWLOCAL and owned
+     * by the VirtualMachine that ran it
+     *
+     * Every field of every element lives in the one block of Cells, which
+     * the VM takes from its allocators (see Heap.h) and frees itself. An
+     * @SoA type lays it out column by column (Health of each element, then
+     * Armor of each element, ...), any other type element by element; the
+     * two strides let one instruction address either layout.
+     *
+     * Shares counts the Shared references holding the array (see RETAIN).
+     * A Counted array is freed when it drops to zero: its cells go back
+     * and Count becomes 0, so a plain reference still holding it fails
+     * as out of range instead of reading freed memory.
+     */
+    struct ArrayObject {
+        const TypeLayout* Layout = nullptr;
+        uint32_t Type = 0;                          // Index of Layout in the Program's Types
+        size_t Count = 0;
+        size_t FieldStride = 1;                     // Cells from a field to the next of the same element: Count (SoA) or 1
+        size_t ElementStride = 1;                   // Cells from an element to the next: 1 (SoA) or the field count
+        Value* Cells = nullptr;                     // From the VM's allocators, which free it
+        size_t Capacity = 0;                        // Cells the block has room for
+        std::atomic<uint32_t> Shares{ 0 };          // Shared references holding it
+        bool Counted = false;                       // Made for a Shared reference; frame-local arrays never are
+
+        /** Cells an array of Count elements of Layout takes */
+        [[nodiscard]] static size_t CellsFor(const TypeLayout& Layout, const size_t Count) { return Count * Layout.Fields.size(); }
+
+        /** Makes this Count elements in Storage, each field holding its Default; Storage must hold CellsFor() cells */
+        void Reset(const TypeLayout& NewLayout, uint32_t NewType, size_t NewCount, Value* Storage, size_t NewCapacity);
+
+        [[nodiscard]] Value& At(const size_t Index, const uint32_t Field) {
+            return Cells[Field * FieldStride + Index * ElementStride];
+        }
+
+        [[nodiscard]] const Value& At(const size_t Index, const uint32_t Field) const {
+            return Cells[Field * FieldStride + Index * ElementStride];
+        }
+    };
+}
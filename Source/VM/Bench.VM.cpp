@@ -0,0 +1,43 @@
+#include <iostream>
+
+// Forward declarations of all benchmark functions
+void Bench_VM_001_Interpreters();
+void Bench_VM_002_MathIntrinsics();
+void Bench_VM_003_DefineArrays();
+void Bench_VM_004_FieldResolution();
+void Bench_VM_005_ParallelChecking();
+void Bench_VM_006_MatchDispatch();
+void Bench_VM_007_SharedCounts();
+void Bench_VM_008_FrameArrays();
+void Bench_VM_009_Allocators();
+void Bench_VM_010_Inlining();
+void Bench_VM_011_Devirtualization();
+void Bench_VM_012_Interfaces();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX VM BENCHMARKS" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Bench_VM_001_Interpreters();
+        Bench_VM_002_MathIntrinsics();
+        Bench_VM_003_DefineArrays();
+        Bench_VM_004_FieldResolution();
+        Bench_VM_005_ParallelChecking();
+        Bench_VM_006_MatchDispatch();
+        Bench_VM_007_SharedCounts();
+        Bench_VM_008_FrameArrays();
+        Bench_VM_009_Allocators();
+        Bench_VM_010_Inlining();
+        Bench_VM_011_Devirtualization();
+        Bench_VM_012_Interfaces();
+
+        std::cout << "\n";
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Benchmark failed with exception: " << E.what() << "\n";
+        return 1;
+    }
+}
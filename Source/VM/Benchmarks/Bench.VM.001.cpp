@@ -0,0 +1,291 @@
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../VM.h"
+#include "ConstantFolder.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    const char* Source = R"(
+        Fib(N: Int) -> Int {
+            if N < 2 { return N; }
+            return Fib(N - 1) + Fib(N - 2);
+        }
+
+        Loops(Rows: Int, Columns: Int) -> Int {
+            Var Sum = 0;
+            for I in 0..Rows {
+                for J in 0..Columns {
+                    if (I ^ J) % 3 == 0 { Sum += I; } else { Sum -= 1; }
+                }
+            }
+            Var K = 0;
+            while K < Rows * 100 { K += 1; Sum += K & 7; }
+            return Sum;
+        }
+
+        Orbit(Steps: Int) -> Float {
+            Const Dt = 0.001;
+            Var X = 1.0;
+            Var Y = 0.0;
+            Var Z = 0.25;
+            Var Vx = 0.0;
+            Var Vy = 1.0;
+            Var Vz = 0.0;
+            for Step in 0..Steps {
+                Var Distance2 = X * X + Y * Y + Z * Z;
+                Var Pull = Dt / (Distance2 * Sqrt(Distance2));
+                Vx -= X * Pull;
+                Vy -= Y * Pull;
+                Vz -= Z * Pull;
+                X += Vx * Dt;
+                Y += Vy * Dt;
+                Z += Vz * Dt;
+            }
+            return X + Y + Z;
+        }
+    )";
+
+    Value NativeSqrt(const Value* Arguments) { return Value::MakeFloat(std::sqrt(Arguments[0].ToFloat())); }
+
+    /**
+     * The baseline: walks the AST for every evaluation and keeps variables
+     * in per-scope hash maps looked up by name
+     */
+    class TreeInterpreter {
+    public:
+        explicit TreeInterpreter(TranslationUnit* Unit) {
+            for (Declaration* Decl : Unit->Declarations) {
+                if (auto* Function = Decl->As<FunctionDeclaration>()) {
+                    Functions[Function->Name] = Function;
+                }
+            }
+        }
+
+        Value Call(const std::string_view Name, const std::vector<Value>& Arguments) {
+            if (Name == "Sqrt") {
+                return NativeSqrt(Arguments.data());
+            }
+
+            const FunctionDeclaration* Function = Functions.at(Name);
+            std::vector<std::unordered_map<std::string_view, Value>> Frame(1);
+            for (size_t Index = 0; Index < Arguments.size(); ++Index) {
+                Frame[0][Function->Parameters[Index].Name] = Arguments[Index];
+            }
+
+            Frames.push_back(std::move(Frame));
+            Returned = Value();
+            Execute(*Function->Body);
+            Frames.pop_back();
+            return Returned;
+        }
+
+    private:
+        enum class EFlow { Normal, Break, Continue, Return };
+
+        std::unordered_map<std::string_view, const FunctionDeclaration*> Functions;
+        std::vector<std::vector<std::unordered_map<std::string_view, Value>>> Frames;
+        Value Returned;
+
+        Value& Lookup(const std::string_view Name) {
+            auto& Scopes = Frames.back();
+            for (auto Scope = Scopes.rbegin(); Scope != Scopes.rend(); ++Scope) {
+                if (const auto Found = Scope->find(Name); Found != Scope->end()) {
+                    return Found->second;
+                }
+            }
+            return Scopes.back()[Name];
+        }
+
+        static Value Arithmetic(const EBinaryOp Op, const Value& Left, const Value& Right) {
+            if (Left.Type == EValueType::Int && Right.Type == EValueType::Int) {
+                switch (Op) {
+                    case EBinaryOp::Add:        case EBinaryOp::AddAssign:      return Value::MakeInt(Left.Int + Right.Int);
+                    case EBinaryOp::Subtract:   case EBinaryOp::SubtractAssign: return Value::MakeInt(Left.Int - Right.Int);
+                    case EBinaryOp::Multiply:   case EBinaryOp::MultiplyAssign: return Value::MakeInt(Left.Int * Right.Int);
+                    case EBinaryOp::Divide:     case EBinaryOp::DivideAssign:   return Value::MakeInt(Left.Int / Right.Int);
+                    case EBinaryOp::Modulo:     case EBinaryOp::ModuloAssign:   return Value::MakeInt(Left.Int % Right.Int);
+                    case EBinaryOp::BitwiseAnd: return Value::MakeInt(Left.Int & Right.Int);
+                    case EBinaryOp::BitwiseXor: return Value::MakeInt(Left.Int ^ Right.Int);
+                    case EBinaryOp::Less:       return Value::MakeBool(Left.Int < Right.Int);
+                    case EBinaryOp::Greater:    return Value::MakeBool(Left.Int > Right.Int);
+                    case EBinaryOp::Equal:      return Value::MakeBool(Left.Int == Right.Int);
+                    default:                    return {};
+                }
+            }
+
+            const double A = Left.ToFloat();
+            const double B = Right.ToFloat();
+            switch (Op) {
+                case EBinaryOp::Add:        case EBinaryOp::AddAssign:      return Value::MakeFloat(A + B);
+                case EBinaryOp::Subtract:   case EBinaryOp::SubtractAssign: return Value::MakeFloat(A - B);
+                case EBinaryOp::Multiply:   case EBinaryOp::MultiplyAssign: return Value::MakeFloat(A * B);
+                case EBinaryOp::Divide:     case EBinaryOp::DivideAssign:   return Value::MakeFloat(A / B);
+                case EBinaryOp::Less:       return Value::MakeBool(A < B);
+                case EBinaryOp::Greater:    return Value::MakeBool(A > B);
+                default:                    return {};
+            }
+        }
+
+        Value Evaluate(Expression& Expr) {
+            switch (Expr.Kind) {
+                case ENodeKind::IntegerLiteral: return Value::MakeInt(Expr.As<IntegerLiteral>()->Value);
+                case ENodeKind::FloatLiteral:   return Value::MakeFloat(Expr.As<FloatLiteral>()->Value);
+                case ENodeKind::BoolLiteral:    return Value::MakeBool(Expr.As<BoolLiteral>()->Value);
+                case ENodeKind::Identifier:     return Lookup(Expr.As<Identifier>()->Name);
+                case ENodeKind::GroupingExpression: return Evaluate(*Expr.As<GroupingExpression>()->Expr);
+                case ENodeKind::BinaryExpression: {
+                    const auto* Binary = Expr.As<BinaryExpression>();
+                    if (Binary->Op == EBinaryOp::Assign) {
+                        return Lookup(Binary->Left->As<Identifier>()->Name) = Evaluate(*Binary->Right);
+                    }
+                    if (IsAssignmentOp(Binary->Op)) {
+                        Value& Target = Lookup(Binary->Left->As<Identifier>()->Name);
+                        return Target = Arithmetic(Binary->Op, Target, Evaluate(*Binary->Right));
+                    }
+                    const Value Left = Evaluate(*Binary->Left);
+                    return Arithmetic(Binary->Op, Left, Evaluate(*Binary->Right));
+                }
+                case ENodeKind::FunctionCall: {
+                    const auto* Call = Expr.As<FunctionCall>();
+                    std::vector<Value> Arguments;
+                    for (Expression* Argument : Call->Arguments) {
+                        Arguments.push_back(Evaluate(*Argument));
+                    }
+                    return this->Call(Call->Callee->As<Identifier>()->Name, Arguments);
+                }
+                default:
+                    return {};
+            }
+        }
+
+        EFlow Execute(Statement& Stmt) {
+            switch (Stmt.Kind) {
+                case ENodeKind::VariableDeclaration: {
+                    auto& Variable = static_cast<VariableDeclaration&>(Stmt);
+                    Frames.back().back()[Variable.Name] = Evaluate(*Variable.Initializer);
+                    return EFlow::Normal;
+                }
+                case ENodeKind::ExpressionStatement:
+                    Evaluate(*static_cast<ExpressionStatement&>(Stmt).Expr);
+                    return EFlow::Normal;
+                case ENodeKind::BlockStatement: {
+                    Frames.back().emplace_back();
+                    EFlow Flow = EFlow::Normal;
+                    for (Statement* Inner : static_cast<BlockStatement&>(Stmt).Statements) {
+                        if ((Flow = Execute(*Inner)) != EFlow::Normal) {
+                            break;
+                        }
+                    }
+                    Frames.back().pop_back();
+                    return Flow;
+                }
+                case ENodeKind::IfStatement: {
+                    auto& If = static_cast<IfStatement&>(Stmt);
+                    if (Evaluate(*If.Condition).Bool) {
+                        return Execute(*If.ThenBranch);
+                    }
+                    return If.ElseBranch != nullptr ? Execute(*If.ElseBranch) : EFlow::Normal;
+                }
+                case ENodeKind::WhileStatement: {
+                    auto& While = static_cast<WhileStatement&>(Stmt);
+                    while (Evaluate(*While.Condition).Bool) {
+                        const EFlow Flow = Execute(*While.Body);
+                        if (Flow == EFlow::Break) {
+                            break;
+                        }
+                        if (Flow == EFlow::Return) {
+                            return Flow;
+                        }
+                    }
+                    return EFlow::Normal;
+                }
+                case ENodeKind::ForStatement: {
+                    auto& For = static_cast<ForStatement&>(Stmt);
+                    const long long End = Evaluate(*For.RangeEnd).Int;
+                    Frames.back().emplace_back();
+                    for (long long Index = Evaluate(*For.RangeStart).Int; Index < End; ++Index) {
+                        Frames.back().back()[For.Iterator] = Value::MakeInt(Index);
+                        const EFlow Flow = Execute(*For.Body);
+                        if (Flow == EFlow::Break || Flow == EFlow::Return) {
+                            Frames.back().pop_back();
+                            return Flow == EFlow::Return ? Flow : EFlow::Normal;
+                        }
+                    }
+                    Frames.back().pop_back();
+                    return EFlow::Normal;
+                }
+                case ENodeKind::ReturnStatement:
+                    Returned = Evaluate(*static_cast<ReturnStatement&>(Stmt).Value);
+                    return EFlow::Return;
+                default:
+                    return EFlow::Normal;
+            }
+        }
+    };
+
+    struct Case {
+        const char* Label;
+        const char* Function;
+        std::vector<Value> Arguments;
+    };
+}
+
+void Bench_VM_001_Interpreters() {
+    PrintHeader("VM Benchmark 001: Bytecode VM vs AST Interpreter");
+
+    ASTContext Context;
+    Parser Parser(Source, Context);
+    TranslationUnit* Unit = Parser.ParseTranslationUnit();
+    FoldConstants(Unit, Context);
+
+    Program Code;
+    Code.AddNative("Sqrt", NativeSqrt, 1);
+    Compiler Compiler(Code);
+    Stopwatch Timer;
+    const bool Compiled = Compiler.Compile(Unit);
+    PrintRow("Compile time", Timer.ElapsedMilliseconds(), "ms");
+    if (!Compiled) {
+        std::cerr << Compiler.GetErrors()[0].Message << "\n";
+        return;
+    }
+
+    VirtualMachine VM(Code);
+    TreeInterpreter Tree(Unit);
+
+    const Case Cases[] = {
+        { "fib(27)", "Fib", { Value::MakeInt(27) } },
+        { "nested loops 2000x1000", "Loops", { Value::MakeInt(2000), Value::MakeInt(1000) } },
+        { "vector math 1M steps", "Orbit", { Value::MakeInt(1000000) } },
+    };
+
+    for (const Case& Run : Cases) {
+        std::cout << "\n  " << Run.Label << "\n";
+
+        Timer.Restart();
+        const Value Walked = Tree.Call(Run.Function, Run.Arguments);
+        const double TreeTime = Timer.ElapsedMilliseconds();
+
+        Value Result;
+        Timer.Restart();
+        VM.Call(static_cast<uint32_t>(Code.FindFunction(Run.Function)), Run.Arguments.data(), Run.Arguments.size(), Result);
+        const double VMTime = Timer.ElapsedMilliseconds();
+        DoNotOptimize(Result);
+
+        PrintRow("  AST interpreter", TreeTime, "ms");
+        PrintRow("  bytecode VM", VMTime, "ms");
+        PrintRow("  speedup", TreeTime / VMTime, "x");
+        if (Walked.ToString() != Result.ToString()) {
+            std::cout << "  results differ: " << Walked.ToString() << " vs " << Result.ToString() << "\n";
+        }
+    }
+
+    std::cout << "\n";
+}
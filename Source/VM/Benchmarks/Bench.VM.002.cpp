@@ -0,0 +1,164 @@
+#include <cmath>
+#include <string>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../Intrinsics.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    /**
+     * One orbit integrator three ways: per-component Float code, Vector3
+     * values the compiler cannot type (generic opcodes, dispatched at run
+     * time) and declared Vector3 locals (one MATH per operator)
+     */
+    const char* Source = R"(
+        Components(Steps: Int) -> Float {
+            Var X = 1.0;
+            Var Y = 0.0;
+            Var Z = 0.25;
+            Var Vx = 0.0;
+            Var Vy = 1.0;
+            Var Vz = 0.0;
+            for Step in 0..Steps {
+                Var Distance2 = X * X + Y * Y + Z * Z;
+                Var Pull = 0.001 / (Distance2 * Sqrt(Distance2));
+                Vx -= X * Pull;
+                Vy -= Y * Pull;
+                Vz -= Z * Pull;
+                X += Vx * 0.001;
+                Y += Vy * 0.001;
+                Z += Vz * 0.001;
+            }
+            return X + Y + Z;
+        }
+
+        Untyped(Steps: Int, Start: Thing, Speed: Thing) -> Float {
+            Var Position = Start;
+            Var Velocity = Speed;
+            for Step in 0..Steps {
+                Var Distance2 = Dot(Position, Position);
+                Var Pull = 0.001 / (Distance2 * Sqrt(Distance2));
+                Velocity -= Position * Pull;
+                Position += Velocity * 0.001;
+            }
+            return Position.X + Position.Y + Position.Z;
+        }
+
+        Typed(Steps: Int, Start: Vector3, Speed: Vector3) -> Float {
+            Var Position = Start;
+            Var Velocity = Speed;
+            for Step in 0..Steps {
+                Var Distance2 = Dot(Position, Position);
+                Var Pull = 0.001 / (Distance2 * Sqrt(Distance2));
+                Velocity -= Position * Pull;
+                Position += Velocity * 0.001;
+            }
+            return Position.X + Position.Y + Position.Z;
+        }
+
+        Spin(Steps: Int, Turn: Quat, Point: Vector3) -> Float {
+            Var Rotation = Turn;
+            Var Sum = Vector3(0, 0, 0);
+            for Step in 0..Steps {
+                Rotation = Rotation * Turn;
+                Sum += Rotation * Point;
+            }
+            return Sum.X + Sum.Y + Sum.Z;
+        }
+
+        SpinComponents(Steps: Int, Qx: Float, Qy: Float, Qz: Float, Qw: Float, Px: Float, Py: Float, Pz: Float) -> Float {
+            Var X = Qx;
+            Var Y = Qy;
+            Var Z = Qz;
+            Var W = Qw;
+            Var Sx = 0.0;
+            Var Sy = 0.0;
+            Var Sz = 0.0;
+            for Step in 0..Steps {
+                Var Nx = W * Qx + X * Qw + Y * Qz - Z * Qy;
+                Var Ny = W * Qy - X * Qz + Y * Qw + Z * Qx;
+                Var Nz = W * Qz + X * Qy - Y * Qx + Z * Qw;
+                W = W * Qw - X * Qx - Y * Qy - Z * Qz;
+                X = Nx;
+                Y = Ny;
+                Z = Nz;
+                Var Tx = 2.0 * (Y * Pz - Z * Py);
+                Var Ty = 2.0 * (Z * Px - X * Pz);
+                Var Tz = 2.0 * (X * Py - Y * Px);
+                Sx += Px + W * Tx + (Y * Tz - Z * Ty);
+                Sy += Py + W * Ty + (Z * Tx - X * Tz);
+                Sz += Pz + W * Tz + (X * Ty - Y * Tx);
+            }
+            return Sx + Sy + Sz;
+        }
+    )";
+
+    constexpr int Rounds = 5;
+    constexpr long long Steps = 1000000;
+
+    /** Best of Rounds, in milliseconds */
+    double Time(VirtualMachine& VM, const Program& Code, const char* Function, const std::vector<Value>& Arguments) {
+        double Best = 1e30;
+        for (int Round = 0; Round < Rounds; ++Round) {
+            Value Result;
+            Stopwatch Timer;
+            VM.Call(static_cast<uint32_t>(Code.FindFunction(Function)), Arguments.data(), Arguments.size(), Result);
+            Best = std::min(Best, Timer.ElapsedMilliseconds());
+            DoNotOptimize(Result);
+        }
+        return Best;
+    }
+}
+
+void Bench_VM_002_MathIntrinsics() {
+    PrintHeader("VM Benchmark 002: Math Intrinsics vs Per-Component Code");
+
+    ASTContext Context;
+    Parser Parser(Source, Context);
+    TranslationUnit* Unit = Parser.ParseTranslationUnit();
+
+    Program Code;
+    Code.AddNative("Sqrt", [](const Value* Arguments) { return Value::MakeFloat(std::sqrt(Arguments[0].ToFloat())); }, 1,
+                   EValueType::Float);
+    AddMathNatives(Code);
+    Compiler Compiler(Code);
+    if (!Compiler.Compile(Unit)) {
+        std::cerr << Compiler.GetErrors()[0].Message << "\n";
+        return;
+    }
+    VirtualMachine VM(Code);
+
+    const Value Count = Value::MakeInt(Steps);
+    const Value Start = Value::MakeMath(EValueType::Vector3, 1.0f, 0.0f, 0.25f);
+    const Value Speed = Value::MakeMath(EValueType::Vector3, 0.0f, 1.0f, 0.0f);
+    const float Sine = std::sin(0.0005f);
+    const float Cosine = std::cos(0.0005f);
+
+    std::cout << "\n  orbit, 1M steps\n";
+    const double Components = Time(VM, Code, "Components", { Count });
+    const double Untyped = Time(VM, Code, "Untyped", { Count, Start, Speed });
+    const double Typed = Time(VM, Code, "Typed", { Count, Start, Speed });
+    PrintRow("  per-component Float", Components, "ms");
+    PrintRow("  Vector3, generic opcodes", Untyped, "ms");
+    PrintRow("  Vector3, MATH intrinsics", Typed, "ms");
+    PrintRow("  speedup over components", Components / Typed, "x");
+    PrintRow("  speedup over generic", Untyped / Typed, "x");
+
+    std::cout << "\n  quaternion multiply + rotate, 1M steps\n";
+    const double SpinComponents = Time(VM, Code, "SpinComponents",
+                                       { Count, Value::MakeFloat(0), Value::MakeFloat(Sine), Value::MakeFloat(0),
+                                         Value::MakeFloat(Cosine), Value::MakeFloat(1), Value::MakeFloat(2), Value::MakeFloat(3) });
+    const double Spin = Time(VM, Code, "Spin",
+                             { Count, Value::MakeMath(EValueType::Quat, 0.0f, Sine, 0.0f, Cosine),
+                               Value::MakeMath(EValueType::Vector3, 1.0f, 2.0f, 3.0f) });
+    PrintRow("  per-component Float", SpinComponents, "ms");
+    PrintRow("  Quat, MATH intrinsics", Spin, "ms");
+    PrintRow("  speedup", SpinComponents / Spin, "x");
+
+    std::cout << "\n";
+}
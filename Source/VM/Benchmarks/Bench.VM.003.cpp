@@ -0,0 +1,131 @@
+#include <memory>
+#include <string>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../Intrinsics.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    /**
+     * 1M entities of eight fields, compiled once as an array of structs and
+     * once with @SoA; the loops touch one, two or all of the fields
+     */
+    const char* Source = R"(
+        Define Entity {
+            Health -> Int = 100;
+            Armor -> Int = 5;
+            Speed -> Float = 1.5;
+            Team -> Int;
+            Position -> Vector3;
+            Velocity -> Vector3;
+            Name -> String = "Grunt";
+            Alive -> Bool = true;
+        }
+
+        Spawn(Count: Int) -> Entity[] {
+            return new Entity[](Count);
+        }
+
+        Damage(All: Entity[]) -> Void {
+            for I in 0..All.Count {
+                All[I].Health -= 1;
+            }
+        }
+
+        Fastest(All: Entity[]) -> Float {
+            Var Best = 0.0;
+            for I in 0..All.Count {
+                if (All[I].Speed > Best) {
+                    Best = All[I].Speed;
+                }
+            }
+            return Best;
+        }
+
+        Move(All: Entity[], Dt: Float) -> Void {
+            for I in 0..All.Count {
+                All[I].Position += All[I].Velocity * Dt;
+            }
+        }
+
+        Everything(All: Entity[]) -> Int {
+            Var Sum = 0;
+            for I in 0..All.Count {
+                if (All[I].Alive && All[I].Name == "Grunt") {
+                    Sum += All[I].Health + All[I].Armor + All[I].Team + (All[I].Speed + All[I].Position.X + All[I].Velocity.Y) as Int;
+                }
+            }
+            return Sum;
+        }
+    )";
+
+    constexpr int Rounds = 5;
+    constexpr long long EntityCount = 1000000;
+
+    struct Layout {
+        ASTContext Context;
+        Program Code;
+        std::unique_ptr<VirtualMachine> VM;
+        Value Entities;
+
+        explicit Layout(const bool SoA) {
+            Parser Parser(std::string(SoA ? "@SoA " : "") + Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            AddMathNatives(Code);
+            Compiler Compiler(Code);
+            if (!Compiler.Compile(Unit)) {
+                std::cerr << Compiler.GetErrors()[0].Message << "\n";
+                return;
+            }
+            VM = std::make_unique<VirtualMachine>(Code);
+            const Value Count = Value::MakeInt(EntityCount);
+            VM->Call(static_cast<uint32_t>(Code.FindFunction("Spawn")), &Count, 1, Entities);
+        }
+
+        /** Best of Rounds, in milliseconds */
+        double Time(const char* Function, const Value Extra = Value()) {
+            const Value Arguments[2] = { Entities, Extra };
+            const size_t Count = Code.Functions[static_cast<size_t>(Code.FindFunction(Function))].ParameterCount;
+            double Best = 1e30;
+            for (int Round = 0; Round < Rounds; ++Round) {
+                Value Result;
+                Stopwatch Timer;
+                VM->Call(static_cast<uint32_t>(Code.FindFunction(Function)), Arguments, Count, Result);
+                Best = std::min(Best, Timer.ElapsedMilliseconds());
+                DoNotOptimize(Result);
+            }
+            return Best;
+        }
+    };
+
+    void Compare(Layout& AoS, Layout& SoA, const char* Title, const char* Function, const Value Extra = Value()) {
+        const double Rows = AoS.Time(Function, Extra);
+        const double Columns = SoA.Time(Function, Extra);
+        std::cout << "\n  " << Title << "\n";
+        PrintRow("  array of structs", Rows, "ms");
+        PrintRow("  @SoA", Columns, "ms");
+        PrintRow("  speedup", Rows / Columns, "x");
+    }
+}
+
+void Bench_VM_003_DefineArrays() {
+    PrintHeader("VM Benchmark 003: @SoA vs Array-of-Structs Define Arrays (1M entities)");
+
+    Layout AoS(false);
+    Layout SoA(true);
+    if (AoS.VM == nullptr || SoA.VM == nullptr) {
+        return;
+    }
+
+    Compare(AoS, SoA, "Health -= 1 (one field, read and write)", "Damage");
+    Compare(AoS, SoA, "max of Speed (one field, read)", "Fastest");
+    Compare(AoS, SoA, "Position += Velocity * Dt (two Vector3 fields)", "Move", Value::MakeFloat(0.016));
+    Compare(AoS, SoA, "all eight fields", "Everything");
+
+    std::cout << "\n";
+}
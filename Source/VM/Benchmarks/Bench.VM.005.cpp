@@ -0,0 +1,76 @@
+#include <string>
+#include <thread>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../Intrinsics.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int FunctionCount = 20000;
+    constexpr int Rounds = 3;
+
+    /** Functions in 16 namespaces with a few nested blocks, locals, field accesses and calls each */
+    std::string Generate() {
+        std::string Source = "Define Entity { Health -> Int = 10; Armor -> Int = 2; }\n";
+        for (int Index = 0; Index < FunctionCount; ++Index) {
+            Source += "Namespace Module" + std::to_string(Index % 16) + " {\n";
+            Source += "    Update" + std::to_string(Index) + "(All: Entity[], Scale: Int) -> Int {\n"
+                      "        Var Sum = 0;\n"
+                      "        for I in 0..All.Count {\n"
+                      "            Var Damage = All[I].Armor * Scale;\n"
+                      "            if (Damage > All[I].Health) { Var Over = Damage - All[I].Health; Sum += Over; }\n"
+                      "            else { All[I].Health -= Damage; Sum += All[I].Health; }\n"
+                      "        }\n";
+            if (Index > 0) {
+                Source += "        Sum += Module" + std::to_string((Index - 1) % 16) + "::Update" + std::to_string(Index - 1) +
+                          "(All, Scale - 1);\n";
+            }
+            Source += "        return Sum;\n    }\n}\n";
+        }
+        return Source;
+    }
+
+    /** Best of Rounds, in milliseconds */
+    double TimeCompile(TranslationUnit* Unit, const unsigned Threads) {
+        double Best = 1e30;
+        for (int Round = 0; Round < Rounds; ++Round) {
+            Program Code;
+            AddMathNatives(Code);
+            Compiler Compiler(Code, Threads);
+            Stopwatch Timer;
+            const bool Succeeded = Compiler.Compile(Unit);
+            Best = std::min(Best, Timer.ElapsedMilliseconds());
+            DoNotOptimize(Succeeded);
+        }
+        return Best;
+    }
+}
+
+void Bench_VM_005_ParallelChecking() {
+    PrintHeader("VM Benchmark 005: Parallel Checking (20k functions)");
+
+    ASTContext Context;
+    Parser Parser(Generate(), Context);
+    TranslationUnit* Unit = Parser.ParseTranslationUnit();
+    if (Parser.HasErrors()) {
+        std::cerr << Parser.GetErrors()[0].ToString() << "\n";
+        return;
+    }
+
+    const unsigned Hardware = std::max(1u, std::thread::hardware_concurrency());
+    PrintRow("Hardware threads", static_cast<double>(Hardware), "");
+
+    const double Serial = TimeCompile(Unit, 1);
+    PrintRow("Compile, 1 thread", Serial, "ms");
+    for (const unsigned Threads : { 2u, 4u, 8u }) {
+        const double Parallel = TimeCompile(Unit, Threads);
+        PrintRow("Compile, " + std::to_string(Threads) + " threads", Parallel, "ms");
+        PrintRow("  speedup", Serial / Parallel, "x");
+    }
+
+    std::cout << "\n";
+}
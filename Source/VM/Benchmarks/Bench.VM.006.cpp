@@ -0,0 +1,96 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int Iterations = 2000000;
+    constexpr int Rounds = 3;
+
+    enum class EKeys { Dense, Sparse, Strings };
+
+    std::string Pattern(const EKeys Keys, const int Index) {
+        switch (Keys) {
+            case EKeys::Dense:  return std::to_string(Index);
+            case EKeys::Sparse: return std::to_string(Index * 1009 + 3);
+            default:            return "\"Key" + std::to_string(Index) + "\"";
+        }
+    }
+
+    /**
+     * Count cases over subjects read from an array, so every variant pays
+     * the same for its subject. With Chain the first pattern is a local
+     * holding the same value, which keeps the compiler from building a table.
+     */
+    std::string Generate(const EKeys Keys, const int Count, const bool Chain) {
+        const std::string Field = Keys == EKeys::Strings ? "Text" : "Number";
+        std::string Source = "Define Case { Number -> Int = 0; Text -> String = \"\"; }\n"
+                             "Setup() -> Case[] {\n"
+                             "    Var All = new Case[](" + std::to_string(Count) + ");\n";
+        for (int Index = 0; Index < Count; ++Index) {
+            Source += "    All[" + std::to_string(Index) + "]." + Field + " = " + Pattern(Keys, Index) + ";\n";
+        }
+        Source += "    return All;\n}\n"
+                  "Dispatch(All: Case[], N: Int) -> Int {\n"
+                  "    Var First = " + Pattern(Keys, 0) + ";\n"
+                  "    Var Sum = 0;\n"
+                  "    for I in 0..N {\n"
+                  "        match All[I % " + std::to_string(Count) + "]." + Field + " {\n";
+        for (int Index = 0; Index < Count; ++Index) {
+            Source += "            " + (Chain && Index == 0 ? "First" : Pattern(Keys, Index)) + " -> Sum += " +
+                      std::to_string(Index) + ";\n";
+        }
+        return Source + "        }\n    }\n    return Sum;\n}\n";
+    }
+
+    /** Best of Rounds, in nanoseconds per match */
+    double TimeDispatch(const EKeys Keys, const int Count, const bool Chain) {
+        ASTContext Context;
+        Parser Parser(Generate(Keys, Count, Chain), Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        Program Code;
+        Compiler Compiler(Code);
+        if (Parser.HasErrors() || !Compiler.Compile(Unit) || Code.Switches.size() != (Chain ? 0u : 1u)) {
+            std::cerr << "Bench.VM.006: could not build the " << (Chain ? "chain" : "table") << " variant\n";
+            return 0.0;
+        }
+
+        VirtualMachine VM(Code);
+        Value All;
+        VM.Call("Setup", {}, All);
+        double Best = 1e30;
+        for (int Round = 0; Round < Rounds; ++Round) {
+            Value Sum;
+            Stopwatch Timer;
+            VM.Call("Dispatch", { All, Value::MakeInt(Iterations) }, Sum);
+            Best = std::min(Best, Timer.ElapsedMilliseconds());
+            DoNotOptimize(Sum);
+        }
+        return Best * 1e6 / Iterations;
+    }
+}
+
+void Bench_VM_006_MatchDispatch() {
+    PrintHeader("VM Benchmark 006: Match Dispatch (2M matches)");
+
+    const std::pair<EKeys, const char*> Kinds[] = {
+        { EKeys::Dense, "dense Int" }, { EKeys::Sparse, "sparse Int" }, { EKeys::Strings, "String" }
+    };
+    for (const auto& [Keys, Name] : Kinds) {
+        for (const int Count : { 4, 8, 16, 64, 256 }) {
+            const double Chain = TimeDispatch(Keys, Count, true);
+            const double Table = TimeDispatch(Keys, Count, false);
+            const std::string Label = std::string(Name) + ", " + std::to_string(Count) + " cases";
+            PrintRow(Label + ", chain", Chain, "ns/match");
+            PrintRow(Label + ", table", Table, "ns/match");
+            PrintRow("  speedup", Chain / Table, "x");
+        }
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,89 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int Particles = 256;
+    constexpr int Frames = 2000;
+
+    /**
+     * A particle system passing its Shared pool to small helpers for every
+     * particle, and taking a Shared burst from an emitter every frame
+     */
+    const char* const Source = R"(
+        Define Particle { X -> Float = 0.0; VX -> Float = 1.0; Life -> Int = 100; }
+
+        Emit(N: Int) -> Shared Particle[] { Var Burst: Shared Particle[] = new Particle[](N); Burst[0].Life = N; return Burst; }
+        Alive(Pool: Shared Particle[], I: Int) -> Int { return Pool[I].Life > 0 ? 1 : 0; }
+        Move(Pool: Shared Particle[], I: Int) -> Int {
+            Var Moving: Shared Particle[] = Pool;
+            Moving[I].X += Moving[I].VX * 0.016;
+            Moving[I].Life -= 1;
+            return Alive(Moving, I);
+        }
+        Simulate(Pool: Shared Particle[], N: Int) -> Int {
+            Var Total = 0;
+            for F in 0..N {
+                Var Burst: Shared Particle[] = Emit(8);
+                for I in 0..Pool.Count { Total += Move(Pool, I); }
+                Total += Burst[0].Life;
+            }
+            return Total;
+        }
+    )";
+
+    struct Measured {
+        double Milliseconds = 0.0;
+        size_t Operations = 0;
+        size_t Released = 0;
+    };
+
+    Measured Run(const bool CountElision) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        Program Code;
+        Compiler Compiler(Code);
+        Compiler.SetCountElision(CountElision);
+        if (Parser.HasErrors() || !Compiler.Compile(Unit)) {
+            std::cerr << "Bench.VM.007: the script does not compile\n";
+            return {};
+        }
+
+        VirtualMachine VM(Code);
+        Value Pool;
+        VM.Call("Emit", { Value::MakeInt(Particles) }, Pool);
+
+        Value Total;
+        const Stopwatch Timer;
+        VM.Call("Simulate", { Pool, Value::MakeInt(Frames) }, Total);
+        Measured Result{ Timer.ElapsedMilliseconds(), VM.GetCountOperations(), VM.GetReleasedArrays() };
+        DoNotOptimize(Total);
+        return Result;
+    }
+}
+
+void Bench_VM_007_SharedCounts() {
+    PrintHeader("VM Benchmark 007: Shared Reference Counts (2k frames, 256 particles)");
+
+    const Measured Naive = Run(false);
+    const Measured Elided = Run(true);
+    if (Naive.Released != Elided.Released) {
+        std::cerr << "Bench.VM.007: elision changed which arrays were freed\n";
+    }
+    PrintRow("Count operations, every reference atomic", static_cast<double>(Naive.Operations), "");
+    PrintRow("Count operations, elided", static_cast<double>(Elided.Operations), "");
+    PrintRow("  operations elided", static_cast<double>(Naive.Operations - Elided.Operations), "");
+    PrintRow("Arrays freed by their last reference", static_cast<double>(Elided.Released), "");
+    PrintRow("Simulation, every reference atomic", Naive.Milliseconds, "ms");
+    PrintRow("Simulation, elided", Elided.Milliseconds, "ms");
+    PrintRow("  speedup", Naive.Milliseconds / Elided.Milliseconds, "x");
+
+    std::cout << "\n";
+}
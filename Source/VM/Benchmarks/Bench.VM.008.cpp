@@ -0,0 +1,87 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int Bodies = 64;
+    constexpr int Frames = 20000;
+
+    /**
+     * A physics step per frame that gathers forces into a temporary array,
+     * blurs them through a second one handed to a helper, and applies them
+     */
+    const char* const Source = R"(
+        Define Body { X -> Float = 0.0; Y -> Float = 0.0; VX -> Float = 1.0; VY -> Float = 0.0; }
+        Define Force { X -> Float = 0.0; Y -> Float = 0.0; }
+
+        Setup(N: Int) -> Body[] { Var All = new Body[](N); for I in 0..N { All[I].X = I * 1.0; } return All; }
+        Smooth(From: Force[], Into: Force[]) -> Int {
+            for I in 1..From.Count { Into[I].X = (From[I - 1].X + From[I].X) * 0.5; Into[I].Y = (From[I - 1].Y + From[I].Y) * 0.5; }
+            return From.Count;
+        }
+        Step(All: Body[], Time: Float) -> Int {
+            Var Forces = new Force[](All.Count);
+            for I in 0..All.Count { Forces[I].X = -All[I].X * 0.01; Forces[I].Y = Time * 0.001 - All[I].Y * 0.01; }
+            Var Smoothed = new Force[](All.Count);
+            Var Count = Smooth(Forces, Smoothed);
+            for I in 0..All.Count {
+                All[I].VX += Smoothed[I].X; All[I].VY += Smoothed[I].Y;
+                All[I].X += All[I].VX * 0.016; All[I].Y += All[I].VY * 0.016;
+            }
+            return Count;
+        }
+        Simulate(All: Body[], N: Int) -> Int { Var Total = 0; for F in 0..N { Total += Step(All, F * 0.016); } return Total; }
+    )";
+
+    struct Measured {
+        double Milliseconds = 0.0;
+        size_t HeapArrays = 0;
+        size_t ScratchArrays = 0;
+    };
+
+    Measured Run(const bool FrameAllocation) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        Program Code;
+        Compiler Compiler(Code);
+        Compiler.SetFrameAllocation(FrameAllocation);
+        if (Parser.HasErrors() || !Compiler.Compile(Unit)) {
+            std::cerr << "Bench.VM.008: the script does not compile\n";
+            return {};
+        }
+
+        VirtualMachine VM(Code);
+        Value All;
+        VM.Call("Setup", { Value::MakeInt(Bodies) }, All);
+        const size_t Before = VM.GetHeapArrays();
+
+        Value Total;
+        Stopwatch Timer;
+        VM.Call("Simulate", { All, Value::MakeInt(Frames) }, Total);
+        Measured Result{ Timer.ElapsedMilliseconds(), VM.GetHeapArrays() - Before, VM.GetScratchArrays() };
+        DoNotOptimize(Total);
+        return Result;
+    }
+}
+
+void Bench_VM_008_FrameArrays() {
+    PrintHeader("VM Benchmark 008: Frame-Local Arrays (20k frames, 64 bodies)");
+
+    const Measured Heap = Run(false);
+    const Measured Frame = Run(true);
+    PrintRow("Heap arrays made, every new on the heap", static_cast<double>(Heap.HeapArrays), "");
+    PrintRow("Heap arrays made, frame-local", static_cast<double>(Frame.HeapArrays), "");
+    PrintRow("  scratch arrays kept for reuse", static_cast<double>(Frame.ScratchArrays), "");
+    PrintRow("Simulation, every new on the heap", Heap.Milliseconds, "ms");
+    PrintRow("Simulation, frame-local", Frame.Milliseconds, "ms");
+    PrintRow("  speedup", Heap.Milliseconds / Frame.Milliseconds, "x");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,161 @@
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../Heap.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int Frames = 20000;
+    constexpr int Temporaries = 64;                 // Per frame, dead at its end
+    constexpr int Survivors = 4;                    // Per frame, each living for Lifetime frames
+    constexpr int Lifetime = 64;
+    constexpr int Rounds = 3;
+
+    /** Bytes of the Index-th allocation: 48 to about 3 KiB, mostly small */
+    size_t SizeOf(const int Frame, const int Index) {
+        return 48 + static_cast<size_t>((Frame * 31 + Index * 17) % 64) * ((Index % 4) == 0 ? 48 : 8);
+    }
+
+    struct Pending {
+        void* Memory;
+        size_t Size;
+    };
+
+    /** The frame loop of a script host, on malloc or on the VM's allocators; best of Rounds in milliseconds */
+    template<bool Pooled>
+    double TimeFrames(AllocatorStats& ArenaUse, AllocatorStats& SlabUse) {
+        double Best = 1e30;
+        for (int Round = 0; Round < Rounds; ++Round) {
+            FrameArena Arena;
+            SlabAllocator Slabs;
+            std::vector<Pending> Temporary;
+            std::vector<Pending> Living(static_cast<size_t>(Survivors * Lifetime), Pending{ nullptr, 0 });
+
+            Stopwatch Timer;
+            for (int Frame = 0; Frame < Frames; ++Frame) {
+                for (int Index = 0; Index < Temporaries; ++Index) {
+                    const size_t Size = SizeOf(Frame, Index);
+                    void* Memory = Pooled ? Arena.Allocate(Size) : std::malloc(Size);
+                    std::memset(Memory, Index, 32);
+                    if (!Pooled) {
+                        Temporary.push_back({ Memory, Size });
+                    }
+                }
+                for (int Index = 0; Index < Survivors; ++Index) {
+                    Pending& Slot = Living[static_cast<size_t>((Frame % Lifetime) * Survivors + Index)];
+                    if (Pooled) {
+                        Slabs.Free(Slot.Memory, Slot.Size);
+                    } else {
+                        std::free(Slot.Memory);
+                    }
+                    Slot.Size = SizeOf(Frame, Index + Temporaries);
+                    Slot.Memory = Pooled ? Slabs.Allocate(Slot.Size) : std::malloc(Slot.Size);
+                    std::memset(Slot.Memory, Index, 32);
+                }
+
+                // End of frame
+                if (Pooled) {
+                    Arena.Reset();
+                } else {
+                    for (const Pending& Dead : Temporary) {
+                        std::free(Dead.Memory);
+                    }
+                    Temporary.clear();
+                }
+            }
+            Best = std::min(Best, Timer.ElapsedMilliseconds());
+
+            for (const Pending& Slot : Living) {
+                if (Pooled) {
+                    Slabs.Free(Slot.Memory, Slot.Size);
+                } else {
+                    std::free(Slot.Memory);
+                }
+            }
+            ArenaUse = Arena.GetStats();
+            SlabUse = Slabs.GetStats();
+        }
+        return Best;
+    }
+
+    /** Per frame: particles gathered into temporaries of a varying size, and a snapshot kept in a global */
+    const char* const Source = R"(
+        Define Particle { X -> Float = 0.0; Y -> Float = 0.0; Life -> Float = 1.0; }
+        global Var Snapshot: Particle[] = new Particle[](1);
+
+        Weigh(All: Particle[]) -> Float { Var Sum = 0.0; for I in 0..All.Count { Sum += All[I].Life; } return Sum; }
+        Frame(F: Int) -> Float {
+            Var N = 16 + F % 96;
+            Var Live = new Particle[](N);
+            Var Next = new Particle[](N);
+            for I in 0..N { Live[I].X = I * 0.5; Next[I].X = Live[I].X + 0.1; Next[I].Life = Live[I].Life - 0.01; }
+            if (F % 8 == 0) { Var Kept = new Particle[](4); Kept[0].X = Next[0].X; Snapshot = Kept; }
+            return Weigh(Live) + Weigh(Next);
+        }
+    )";
+
+    /** Host frame loop calling Frame() once per frame; best of Rounds in milliseconds */
+    double TimeScript(const EAllocator Allocator, AllocatorStats& Heap, AllocatorStats& Arena) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        Program Code;
+        Compiler Compiler(Code);
+        if (Parser.HasErrors() || !Compiler.Compile(Unit)) {
+            std::cerr << "Bench.VM.009: the script does not compile\n";
+            return 0.0;
+        }
+
+        double Best = 1e30;
+        for (int Round = 0; Round < Rounds; ++Round) {
+            VirtualMachine VM(Code, VirtualMachine::DefaultStackSize, Allocator);
+            Value Result;
+            Stopwatch Timer;
+            for (int Frame = 0; Frame < Frames; ++Frame) {
+                VM.Call("Frame", { Value::MakeInt(Frame) }, Result);
+                DoNotOptimize(Result);
+            }
+            Best = std::min(Best, Timer.ElapsedMilliseconds());
+            Heap = VM.GetHeapStats();
+            Arena = VM.GetFrameStats();
+        }
+        return Best;
+    }
+}
+
+void Bench_VM_009_Allocators() {
+    PrintHeader("VM Benchmark 009: Frame Arena and Slabs (20k frames)");
+
+    AllocatorStats Heap;
+    AllocatorStats Arena;
+    const double System = TimeFrames<false>(Arena, Heap);
+    const double Pooled = TimeFrames<true>(Arena, Heap);
+    PrintRow("Frame loop, malloc and free", System, "ms");
+    PrintRow("Frame loop, arena and slabs", Pooled, "ms");
+    PrintRow("  speedup", System / Pooled, "x");
+    PrintRow("  arena peak", static_cast<double>(Arena.Peak) / 1024.0, "KiB");
+    PrintRow("  arena chunks from the system", static_cast<double>(Arena.Fallbacks), "");
+    PrintRow("  slab peak", static_cast<double>(Heap.Peak) / 1024.0, "KiB");
+    PrintRow("  slab pages", static_cast<double>(Heap.Reserved / SlabAllocator::PageSize), "");
+
+    const double ScriptSystem = TimeScript(EAllocator::System, Heap, Arena);
+    PrintRow("Script frames, EAllocator::System", ScriptSystem, "ms");
+    PrintRow("  heap allocations", static_cast<double>(Heap.Allocations), "");
+    const double ScriptPooled = TimeScript(EAllocator::Pooled, Heap, Arena);
+    PrintRow("Script frames, EAllocator::Pooled", ScriptPooled, "ms");
+    PrintRow("  slab allocations", static_cast<double>(Heap.Allocations), "");
+    PrintRow("  slab fallbacks", static_cast<double>(Heap.Fallbacks), "");
+    PrintRow("  arena allocations", static_cast<double>(Arena.Allocations), "");
+    PrintRow("  arena peak", static_cast<double>(Arena.Peak) / 1024.0, "KiB");
+    PrintRow("  speedup", ScriptSystem / ScriptPooled, "x");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,94 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int Entities = 256;
+    constexpr int Frames = 2000;
+
+    /** Gameplay code that touches every field through Fetch and Set accessors and small helpers */
+    const char* const Source = R"(
+        Define Entity { Health -> Int = 100; Armor -> Int = 3; Speed -> Float = 1.0; X -> Float = 0.0; }
+        Fetch Entity {
+            Fetch_Health() -> Entity.Health { return Entity.Health; }
+            Fetch_Armor() -> Entity.Armor { return Entity.Armor; }
+            Fetch_Speed() -> Entity.Speed { return Entity.Speed; }
+            Fetch_X() -> Entity.X { return Entity.X; }
+        }
+        Set Entity {
+            Set_Health(Value: Int) -> Void { Entity.Health = Value; }
+            Set_X(Value: Float) -> Void { Entity.X = Value; }
+        }
+
+        Setup(N: Int) -> Entity[] { Var All = new Entity[](N); for I in 0..N { All[I].Set_X(I * 1.0); } return All; }
+        Mitigate(Damage: Int, Armor: Int) -> Int { return Damage > Armor ? Damage - Armor : 0; }
+        Heal(Health: Int) -> Int { return Health < 100 ? Health + 1 : 100; }
+        Frame(All: Entity[], F: Int) -> Int {
+            Var Alive = 0;
+            for I in 0..All.Count {
+                All[I].Set_X(All[I].Fetch_X() + All[I].Fetch_Speed() * 0.016);
+                Var Hit = Mitigate((I + F) % 7, All[I].Fetch_Armor());
+                All[I].Set_Health(Heal(All[I].Fetch_Health() - Hit));
+                if (All[I].Fetch_Health() > 0) { Alive += 1; }
+            }
+            return Alive;
+        }
+        Simulate(All: Entity[], N: Int) -> Int { Var Total = 0; for F in 0..N { Total += Frame(All, F); } return Total; }
+    )";
+
+    struct Measured {
+        double Milliseconds = 0.0;
+        size_t Calls = 0;
+        size_t Inlined = 0;
+        long long Total = 0;
+    };
+
+    Measured Run(const bool Inlining) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        Program Code;
+        Compiler Compiler(Code);
+        Compiler.SetInlining(Inlining);
+        if (Parser.HasErrors() || !Compiler.Compile(Unit)) {
+            std::cerr << "Bench.VM.010: the script does not compile\n";
+            return {};
+        }
+
+        VirtualMachine VM(Code);
+        Value All;
+        VM.Call("Setup", { Value::MakeInt(Entities) }, All);
+        const size_t Before = VM.GetCalls();
+
+        Value Total;
+        Stopwatch Timer;
+        VM.Call("Simulate", { All, Value::MakeInt(Frames) }, Total);
+        Measured Result{ Timer.ElapsedMilliseconds(), VM.GetCalls() - Before, Compiler.GetInlinedCalls(), Total.Int };
+        DoNotOptimize(Total);
+        return Result;
+    }
+}
+
+void Bench_VM_010_Inlining() {
+    PrintHeader("VM Benchmark 010: Accessor Inlining (2k frames, 256 entities)");
+
+    const Measured Calls = Run(false);
+    const Measured Inlined = Run(true);
+    if (Calls.Total != Inlined.Total) {
+        std::cerr << "Bench.VM.010: inlined code computed a different result\n";
+    }
+    PrintRow("Call sites inlined", static_cast<double>(Inlined.Inlined), "");
+    PrintRow("Calls made, accessors as calls", static_cast<double>(Calls.Calls), "");
+    PrintRow("Calls made, inlined", static_cast<double>(Inlined.Calls), "");
+    PrintRow("Simulation, accessors as calls", Calls.Milliseconds, "ms");
+    PrintRow("Simulation, inlined", Inlined.Milliseconds, "ms");
+    PrintRow("  speedup", Calls.Milliseconds / Inlined.Milliseconds, "x");
+
+    std::cout << "\n";
+}
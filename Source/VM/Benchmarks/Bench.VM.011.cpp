@@ -0,0 +1,100 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int Units = 256;
+    constexpr int Frames = 2000;
+
+    /** Gameplay code calling virtuals: two with a few overrides, and one with a single implementation */
+    const char* const Source = R"(
+        Define Unit {
+            Health -> Int = 100; Armor -> Int = 2; X -> Float = 0.0;
+            Virtual Mitigate(Damage: Int) -> Int { return Damage > this.Armor ? Damage - this.Armor : 0; }
+            Virtual Speed() -> Float { return 1.0; }
+            Virtual Regenerate() -> Int { return this.Health < 100 ? 1 : 0; }
+        }
+        Define Soldier : Unit { Override Speed() -> Float { return 1.5; } }
+        Define Tank : Unit {
+            Override Mitigate(Damage: Int) -> Int { return Damage / 4; }
+            Override Speed() -> Float { return 0.5; }
+        }
+
+        Frame(All: Unit[], F: Int) -> Int {
+            Var Alive = 0;
+            for I in 0..All.Count {
+                All[I].X = All[I].X + All[I].Speed() * 0.016;
+                All[I].Health = All[I].Health - All[I].Mitigate((I + F) % 9) + All[I].Regenerate();
+                if (All[I].Health > 0) { Alive += 1; }
+            }
+            return Alive;
+        }
+        Simulate(Soldiers: Unit[], Tanks: Unit[], N: Int) -> Int {
+            Var Total = 0;
+            for F in 0..N { Total += Frame(Soldiers, F) + Frame(Tanks, F); }
+            return Total;
+        }
+        Soldiers(N: Int) -> Unit[] { return new Soldier[](N); }
+        Tanks(N: Int) -> Unit[] { return new Tank[](N); }
+    )";
+
+    struct Measured {
+        double Milliseconds = 0.0;
+        size_t Calls = 0;
+        DispatchReport Dispatch;
+        long long Total = 0;
+    };
+
+    Measured Run(const bool Devirtualization) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        Program Code;
+        Compiler Compiler(Code);
+        Compiler.SetDevirtualization(Devirtualization);
+        if (Parser.HasErrors() || !Compiler.Compile(Unit)) {
+            std::cerr << "Bench.VM.011: the script does not compile\n";
+            return {};
+        }
+
+        VirtualMachine VM(Code);
+        Value Soldiers;
+        Value Tanks;
+        VM.Call("Soldiers", { Value::MakeInt(Units) }, Soldiers);
+        VM.Call("Tanks", { Value::MakeInt(Units) }, Tanks);
+        const size_t Before = VM.GetCalls();
+
+        Value Total;
+        Stopwatch Timer;
+        VM.Call("Simulate", { Soldiers, Tanks, Value::MakeInt(Frames) }, Total);
+        Measured Result{ Timer.ElapsedMilliseconds(), VM.GetCalls() - Before, Compiler.GetDispatch(), Total.Int };
+        DoNotOptimize(Total);
+        return Result;
+    }
+}
+
+void Bench_VM_011_Devirtualization() {
+    PrintHeader("VM Benchmark 011: Devirtualized Virtual Calls (2k frames, 2x256 units)");
+
+    const Measured Dynamic = Run(false);
+    const Measured Narrowed = Run(true);
+    if (Dynamic.Total != Narrowed.Total) {
+        std::cerr << "Bench.VM.011: devirtualized code computed a different result\n";
+    }
+    PrintRow("Virtual call sites", static_cast<double>(Narrowed.Dispatch.VirtualCalls), "");
+    PrintRow("  devirtualized", static_cast<double>(Narrowed.Dispatch.Devirtualized()), "");
+    PrintRow("  guarded by ISTYPE", static_cast<double>(Narrowed.Dispatch.Guarded), "");
+    PrintRow("Calls made, CALLVIRT", static_cast<double>(Dynamic.Calls), "");
+    PrintRow("Calls made, devirtualized", static_cast<double>(Narrowed.Calls), "");
+    PrintRow("Simulation, CALLVIRT", Dynamic.Milliseconds, "ms");
+    PrintRow("Simulation, devirtualized", Narrowed.Milliseconds, "ms");
+    PrintRow("  speedup", Dynamic.Milliseconds / Narrowed.Milliseconds, "x");
+
+    std::cout << "\n";
+}
@@ -0,0 +1,113 @@
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+using namespace Vex::Benchmark;
+
+namespace {
+    constexpr int Units = 256;
+    constexpr int Frames = 2000;
+    constexpr size_t Lookups = 10000000;
+
+    /** Gameplay code calling three methods of an Interface on elements of two Defines */
+    const char* const Source = R"(
+        Interface IUnit { Mitigate(Damage: Int) -> Int; Speed() -> Float; Regenerate() -> Int; }
+        Define Soldier : IUnit {
+            Health -> Int = 100; Armor -> Int = 2;
+            Implement Mitigate(Damage: Int) -> Int { return Damage > this.Armor ? Damage - this.Armor : 0; }
+            Implement Speed() -> Float { return 1.5; }
+            Implement Regenerate() -> Int { return this.Health < 100 ? 1 : 0; }
+        }
+        Define Tank : IUnit {
+            Health -> Int = 100;
+            Implement Mitigate(Damage: Int) -> Int { return Damage / 4; }
+            Implement Speed() -> Float { return 0.5; }
+            Implement Regenerate() -> Int { return 0; }
+        }
+
+        Step(U: IUnit, Damage: Int) -> Float { return U.Speed() * 0.016 + U.Regenerate() - U.Mitigate(Damage); }
+        Simulate(N: Int, Count: Int) -> Float {
+            Var Soldiers = new Soldier[](Count);
+            Var Tanks = new Tank[](Count);
+            Var Total = 0.0;
+            for F in 0..N {
+                for I in 0..Count { Total += Step(Soldiers[I], (I + F) % 9) + Step(Tanks[I], (I + F) % 7); }
+            }
+            return Total;
+        }
+    )";
+
+    /** One call the script makes: the Define of the element, and the slot of the method in IUnit */
+    struct CallSite {
+        uint32_t Type;
+        uint32_t Slot;
+        uint32_t Table;
+    };
+}
+
+void Bench_VM_012_Interfaces() {
+    PrintHeader("VM Benchmark 012: Interface Tables (2k frames, 2x256 units)");
+
+    ASTContext Context;
+    Parser Parser(Source, Context);
+    TranslationUnit* Unit = Parser.ParseTranslationUnit();
+    Program Code;
+    Compiler Compiler(Code);
+    if (Parser.HasErrors() || !Compiler.Compile(Unit)) {
+        std::cerr << "Bench.VM.012: the script does not compile\n";
+        return;
+    }
+
+    VirtualMachine VM(Code);
+    Value Total;
+    const Stopwatch Timer;
+    VM.Call("Simulate", { Value::MakeInt(Frames), Value::MakeInt(Units) }, Total);
+    const double Script = Timer.ElapsedMilliseconds();
+    DoNotOptimize(Total);
+    PrintRow("Interface calls made", static_cast<double>(VM.GetCalls()), "");
+    PrintRow("Simulation, CALLIFACE", Script, "ms");
+
+    // The same calls resolved to functions: by name in each Define's method dictionary, or by slot in its table
+    const auto Interface = static_cast<uint32_t>(Code.FindInterface("IUnit"));
+    const InterfaceLayout& Used = Code.Interfaces[Interface];
+    std::vector<CallSite> Calls;
+    for (const char* Name : { "Soldier", "Tank" }) {
+        const auto Type = static_cast<uint32_t>(Code.FindType(Name));
+        const auto Table = static_cast<uint32_t>(Code.Types[Type].FindITable(Interface));
+        for (uint32_t Slot = 0; Slot < Used.Methods.size(); ++Slot) {
+            Calls.push_back({ Type, Slot, Table });
+        }
+    }
+
+    uint64_t ByName = 0;
+    const Stopwatch NameTimer;
+    for (size_t I = 0; I < Lookups; ++I) {
+        const CallSite& Call = Calls[I % Calls.size()];
+        ByName += static_cast<uint64_t>(Code.Types[Call.Type].FindMethod(Used.Methods[Call.Slot]));
+    }
+    const double Dictionary = NameTimer.ElapsedMilliseconds();
+    DoNotOptimize(ByName);
+
+    uint64_t BySlot = 0;
+    const Stopwatch SlotTimer;
+    for (size_t I = 0; I < Lookups; ++I) {
+        const CallSite& Call = Calls[I % Calls.size()];
+        BySlot += Code.ITables[Call.Table + 1 + Call.Slot];
+    }
+    const double Tables = SlotTimer.ElapsedMilliseconds();
+    DoNotOptimize(BySlot);
+
+    if (ByName != BySlot) {
+        std::cerr << "Bench.VM.012: interface tables found different functions\n";
+    }
+    PrintRow("10M lookups, method dictionary", Dictionary, "ms");
+    PrintRow("10M lookups, interface table", Tables, "ms");
+    PrintRow("  speedup", Dictionary / Tables, "x");
+
+    std::cout << "\n";
+}
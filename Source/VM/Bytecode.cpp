@@ -0,0 +1,431 @@
+#include "Bytecode.h"
+#include "Array.h"
+#include "Intrinsics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace Vex {
+    std::string ValueTypeToString(const EValueType Type) {
+        switch (Type) {
+            case EValueType::Null:   return "Null";
+            case EValueType::Bool:   return "Bool";
+            case EValueType::Int:    return "Int";
+            case EValueType::Float:  return "Float";
+            case EValueType::String: return "String";
+            case EValueType::Array:  return "Array";
+            case EValueType::Interface: return "Interface";
+            case EValueType::Vector2: return "Vector2";
+            case EValueType::Vector3: return "Vector3";
+            case EValueType::Vector4: return "Vector4";
+            case EValueType::Quat:    return "Quat";
+            case EValueType::Color:   return "Color";
+        }
+
+        return "?";
+    }
+
+    std::string Value::ToString() const {
+        switch (Type) {
+            case EValueType::Null:   return "null";
+            case EValueType::Bool:   return Bool ? "true" : "false";
+            case EValueType::Int:    return std::to_string(Int);
+            case EValueType::Float: {
+                std::stringstream Stream;
+                Stream << Float;
+                return Stream.str();
+            }
+            case EValueType::String: return *String;
+            case EValueType::Array:  return Array->Layout->Name + "[" + std::to_string(Array->Count) + "]";
+            case EValueType::Interface:
+                return Interface.Array->Layout->Name + "[" + std::to_string(Interface.Array->Count) + "][" +
+                       std::to_string(Interface.Index) + "]";
+            default: {
+                std::stringstream Stream;
+                Stream << ValueTypeToString(Type) << "(";
+                for (int Lane = 0; Lane < MathLaneCount(Type); ++Lane) {
+                    Stream << (Lane > 0 ? ", " : "") << Lanes[Lane];
+                }
+                Stream << ")";
+                return Stream.str();
+            }
+        }
+
+        return "?";
+    }
+
+    std::string OpCodeToString(const EOpCode Op) {
+        switch (Op) {
+        #define VEX_OPCODE_NAME(Name, Format, Effect) case EOpCode::Name: return #Name;
+            VEX_OPCODES(VEX_OPCODE_NAME)
+        #undef VEX_OPCODE_NAME
+        }
+
+        return "?";
+    }
+
+    uint32_t Program::AddNative(const std::string_view Name, const NativeFunction Callback, const uint8_t Arity,
+                                const EValueType Result) {
+        Natives.push_back({ std::string(Name), Callback, Arity, Result });
+
+        const auto Index = static_cast<uint32_t>(Natives.size() - 1);
+        NativeIndex.emplace(*Intern(Name), static_cast<int32_t>(Index));   // The first one by a name wins
+        return Index;
+    }
+
+    uint32_t Program::AddFunction(const std::string_view Name) {
+        Function& Added = Functions.emplace_back();
+        Added.Name = std::string(Name);
+
+        const auto Index = static_cast<uint32_t>(Functions.size() - 1);
+        FunctionIndex.emplace(*Intern(Name), static_cast<int32_t>(Index));
+        return Index;
+    }
+
+    int32_t Program::FindFunction(const std::string_view Name) const {
+        const auto Found = FunctionIndex.find(Name);
+        return Found != FunctionIndex.end() ? Found->second : -1;
+    }
+
+    uint32_t Program::AddType(const std::string_view Name) {
+        TypeLayout& Added = Types.emplace_back();
+        Added.Name = std::string(Name);
+
+        const auto Index = static_cast<uint32_t>(Types.size() - 1);
+        Added.Lineage.push_back(Index);
+        TypeIndex.emplace(*Intern(Name), static_cast<int32_t>(Index));
+        return Index;
+    }
+
+    int32_t Program::FindType(const std::string_view Name) const {
+        const auto Found = TypeIndex.find(Name);
+        return Found != TypeIndex.end() ? Found->second : -1;
+    }
+
+    uint32_t Program::AddInterface(const std::string_view Name) {
+        InterfaceLayout& Added = Interfaces.emplace_back();
+        Added.Name = std::string(Name);
+
+        const auto Index = static_cast<uint32_t>(Interfaces.size() - 1);
+        InterfaceIndex.emplace(*Intern(Name), static_cast<int32_t>(Index));
+        return Index;
+    }
+
+    int32_t Program::FindInterface(const std::string_view Name) const {
+        const auto Found = InterfaceIndex.find(Name);
+        return Found != InterfaceIndex.end() ? Found->second : -1;
+    }
+
+    int32_t InterfaceLayout::FindMethod(const std::string_view Method) const {
+        for (size_t Slot = 0; Slot < Methods.size(); ++Slot) {
+            if (Methods[Slot] == Method) {
+                return static_cast<int32_t>(Slot);
+            }
+        }
+        return -1;
+    }
+
+    FieldLayout& TypeLayout::AddField(const std::string_view Field) {
+        FieldLayout& Added = Fields.emplace_back();
+        Added.Name = std::string(Field);
+        FieldIndex.emplace(Added.Name, static_cast<int32_t>(Fields.size() - 1));
+        return Added;
+    }
+
+    int32_t TypeLayout::FindField(const std::string_view Field) const {
+        const auto Found = FieldIndex.find(Field);
+        return Found != FieldIndex.end() ? Found->second : -1;
+    }
+
+    void TypeLayout::AddMethod(const std::string_view Method, const uint32_t Function, const int32_t Slot) {
+        Methods[std::string(Method)] = { static_cast<int32_t>(Function), Slot };
+    }
+
+    void TypeLayout::InheritMethods(const TypeLayout& From) {
+        for (const auto& [Name, Entry] : From.Methods) {
+            Methods.emplace(Name, Entry);
+        }
+    }
+
+    int32_t TypeLayout::FindMethod(const std::string_view Method) const {
+        const auto Found = Methods.find(std::string(Method));
+        return Found != Methods.end() ? Found->second.Function : -1;
+    }
+
+    int32_t TypeLayout::FindSlot(const std::string_view Method) const {
+        const auto Found = Methods.find(std::string(Method));
+        return Found != Methods.end() ? Found->second.Slot : -1;
+    }
+
+    int32_t SwitchTable::Target(const Value& Subject) const {
+        if (Subject.Type == EValueType::Int) {
+            if (Kind == ESwitchKind::Dense) {
+                const uint64_t Index = static_cast<uint64_t>(Subject.Int) - static_cast<uint64_t>(Low);
+                return Index < Dense.size() ? Dense[Index] : Default;
+            }
+            if (Kind == ESwitchKind::Sorted) {
+                const auto Found = std::lower_bound(Keys.begin(), Keys.end(), Subject.Int);
+                return Found != Keys.end() && *Found == Subject.Int ? KeyTargets[Found - Keys.begin()] : Default;
+            }
+            return Default;
+        }
+
+        if (Subject.Type == EValueType::String) {
+            if (Kind != ESwitchKind::Hashed) {
+                return Default;
+            }
+            const uint64_t Hash = HashBytes(*Subject.String);
+            const uint32_t Bucket = Displacement[BucketOf(Hash, Displacement.size() - 1)];
+            const int32_t Index = Slots[SlotOf(Hash, Bucket, Slots.size() - 1)];
+            if (Index < 0) {
+                return Default;
+            }
+            const std::string* Pattern = Patterns[Index].String;
+            return Pattern == Subject.String || *Pattern == *Subject.String ? Targets[Index] : Default;
+        }
+
+        // EQ compares Ints and Floats by value
+        if (Subject.Type == EValueType::Float && Kind != ESwitchKind::Hashed) {
+            for (size_t Index = 0; Index < Patterns.size(); ++Index) {
+                if (static_cast<double>(Patterns[Index].Int) == Subject.Float) {
+                    return Targets[Index];
+                }
+            }
+        }
+        return Default;
+    }
+
+    bool SwitchTable::BuildPerfectHash() {
+        constexpr uint32_t MaxDisplacement = 1 << 16;
+        const size_t Count = Patterns.size();
+
+        size_t BucketCount = 1;
+        while (BucketCount * 4 < Count) {
+            BucketCount *= 2;
+        }
+        size_t SlotCount = 1;
+        while (SlotCount < Count + Count / 4) {
+            SlotCount *= 2;
+        }
+
+        std::vector<uint64_t> Hashes(Count);
+        std::vector<std::vector<uint32_t>> Members(BucketCount);
+        for (size_t Index = 0; Index < Count; ++Index) {
+            Hashes[Index] = HashBytes(*Patterns[Index].String);
+            Members[BucketOf(Hashes[Index], BucketCount - 1)].push_back(static_cast<uint32_t>(Index));
+        }
+
+        // Crowded buckets first, while most slots are free
+        std::vector<uint32_t> Order(BucketCount);
+        for (size_t Bucket = 0; Bucket < BucketCount; ++Bucket) {
+            Order[Bucket] = static_cast<uint32_t>(Bucket);
+        }
+        std::stable_sort(Order.begin(), Order.end(),
+                         [&](const uint32_t Left, const uint32_t Right) { return Members[Left].size() > Members[Right].size(); });
+
+        Displacement.assign(BucketCount, 0);
+        Slots.assign(SlotCount, -1);
+        std::vector<size_t> Taken;
+        for (const uint32_t Bucket : Order) {
+            const std::vector<uint32_t>& Keys = Members[Bucket];
+            if (Keys.empty()) {
+                break;
+            }
+
+            uint32_t Tried = 0;
+            for (;; ++Tried) {
+                if (Tried == MaxDisplacement) {
+                    return false;
+                }
+                Taken.clear();
+                for (const uint32_t Key : Keys) {
+                    const size_t Slot = SlotOf(Hashes[Key], Tried, SlotCount - 1);
+                    if (Slots[Slot] >= 0 || std::find(Taken.begin(), Taken.end(), Slot) != Taken.end()) {
+                        break;
+                    }
+                    Taken.push_back(Slot);
+                }
+                if (Taken.size() == Keys.size()) {
+                    break;
+                }
+            }
+
+            Displacement[Bucket] = Tried;
+            for (size_t Index = 0; Index < Keys.size(); ++Index) {
+                Slots[Taken[Index]] = static_cast<int32_t>(Keys[Index]);
+            }
+        }
+        return true;
+    }
+
+    int32_t Program::FindNative(const std::string_view Name) const {
+        const auto Found = NativeIndex.find(Name);
+        return Found != NativeIndex.end() ? Found->second : -1;
+    }
+
+    const std::string* Program::Intern(const std::string_view Text) {
+        if (const auto Found = StringIndex.find(Text); Found != StringIndex.end()) {
+            return Found->second;
+        }
+
+        const std::string& Stored = Strings.emplace_back(Text);
+        StringIndex.emplace(Stored, &Stored);
+        return &Stored;
+    }
+
+    uint32_t Program::AddConstant(const Value& Constant) {
+        uint64_t Bits = 0;
+        size_t Table = 0;
+        switch (Constant.Type) {
+            case EValueType::Int:
+                Bits = static_cast<uint64_t>(Constant.Int);
+                break;
+            case EValueType::Float:
+                std::memcpy(&Bits, &Constant.Float, sizeof(Bits));
+                Table = 1;
+                break;
+            case EValueType::String:
+                Bits = reinterpret_cast<uintptr_t>(Constant.String);    // Interned, so equal strings match
+                Table = 2;
+                break;
+            default:
+                Constants.push_back(Constant);
+                return static_cast<uint32_t>(Constants.size() - 1);
+        }
+
+        const auto [Found, Added] = ConstantIndex[Table].emplace(Bits, static_cast<uint32_t>(Constants.size()));
+        if (Added) {
+            Constants.push_back(Constant);
+        }
+        return Found->second;
+    }
+
+    std::string Program::Disassemble(const Function& Function) const {
+        using namespace Encoding;
+
+        std::stringstream Out;
+        Out << Function.Name << " (" << static_cast<int>(Function.ParameterCount) << " parameters, "
+            << Function.RegisterCount << " registers)\n";
+
+        for (size_t Pc = 0; Pc < Function.Code.size(); Pc += Width(GetOp(Function.Code[Pc]))) {
+            const Instruction Word = Function.Code[Pc];
+            const EOpCode Op = GetOp(Word);
+            Out << "  " << Pc << "\t" << OpCodeToString(Op);
+
+            switch (Op) {
+                case EOpCode::LOADK:
+                    Out << " R" << GetA(Word) << " K" << GetBx(Word) << "\t; " << Constants[GetBx(Word)].ToString();
+                    break;
+                case EOpCode::GETGLOBAL:
+                case EOpCode::SETGLOBAL:
+                    Out << " R" << GetA(Word) << " G" << GetBx(Word) << "\t; " << Globals[GetBx(Word)];
+                    break;
+                case EOpCode::LOADI:
+                    Out << " R" << GetA(Word) << " " << GetsBx(Word);
+                    break;
+                case EOpCode::LOADNULL:
+                    Out << " R" << GetA(Word);
+                    break;
+                case EOpCode::LOADBOOL:
+                    Out << " R" << GetA(Word) << " " << GetB(Word);
+                    break;
+                case EOpCode::ADDI:
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " " << GetsC(Word);
+                    break;
+                case EOpCode::MOVE:
+                case EOpCode::COUNT:
+                case EOpCode::NEG:
+                case EOpCode::NOT:
+                case EOpCode::BNOT:
+                case EOpCode::TOINT:
+                case EOpCode::TOFLOAT:
+                    Out << " R" << GetA(Word) << " R" << GetB(Word);
+                    break;
+                case EOpCode::JMP:
+                    Out << " " << GetsJ(Word) << "\t; to " << static_cast<int64_t>(Pc) + 1 + GetsJ(Word);
+                    break;
+                case EOpCode::SWITCH: {
+                    static const char* const KindNames[] = { "dense", "sorted", "hashed" };
+                    const SwitchTable& Table = Switches[GetBx(Word)];
+                    Out << " R" << GetA(Word) << " T" << GetBx(Word) << "\t; " << KindNames[static_cast<int>(Table.Kind)] << ", "
+                        << Table.Patterns.size() << " cases, else to " << static_cast<int64_t>(Pc) + 1 + Table.Default;
+                    break;
+                }
+                case EOpCode::JMPIF:
+                case EOpCode::JMPIFNOT:
+                case EOpCode::JMPNN:
+                case EOpCode::FORPREP:
+                case EOpCode::FORLOOP:
+                case EOpCode::FORPREPI:
+                case EOpCode::FORLOOPI:
+                    Out << " R" << GetA(Word) << " " << GetsBx(Word)
+                        << "\t; to " << static_cast<int64_t>(Pc) + 1 + GetsBx(Word);
+                    break;
+                case EOpCode::ISTYPE:
+                    Out << " R" << GetA(Word) << " " << GetBx(Word) << "\t; " << Types[GetBx(Word)].Name << "[]";
+                    break;
+                case EOpCode::GETLANE:
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " " << GetC(Word);
+                    break;
+                case EOpCode::NEWARRAY:
+                case EOpCode::NEWLOCAL:
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << "\t; " << Types[Function.Code[Pc + 1]].Name << "[]"
+                        << (Op == EOpCode::NEWARRAY && GetC(Word) != 0 ? ", counted" : "");
+                    break;
+                case EOpCode::RETAIN:
+                case EOpCode::RELEASE:
+                    Out << " R" << GetA(Word) << " " << GetB(Word) << "\t; "
+                        << ((GetB(Word) & CountAtomic) != 0 ? "atomic" : "non-atomic")
+                        << ((GetB(Word) & CountDeferred) != 0 ? ", deferred" : "");
+                    break;
+                case EOpCode::IFACE:
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " R" << GetC(Word) << "\t; as "
+                        << Interfaces[Function.Code[Pc + 1]].Name;
+                    break;
+                case EOpCode::GETFIELD:
+                case EOpCode::SETFIELD: {
+                    const Instruction Ref = Function.Code[Pc + 1];
+                    const TypeLayout& Layout = Types[GetFieldType(Ref)];
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " R" << GetC(Word) << "\t; " << Layout.Name << "."
+                        << Layout.Fields[GetField(Ref)].Name << (Layout.IsSoA ? " (SoA)" : "");
+                    break;
+                }
+                case EOpCode::MATH:
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " R" << GetC(Word) << "\t; "
+                        << GetIntrinsic(Function.Code[Pc + 1]).Name;
+                    break;
+                case EOpCode::CALL:
+                case EOpCode::CALLNATIVE: {
+                    const Instruction Callee = Function.Code[Pc + 1];
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " " << GetC(Word) << "\t; "
+                        << (Op == EOpCode::CALL ? Functions[Callee].Name : Natives[Callee].Name);
+                    break;
+                }
+                case EOpCode::CALLVIRT: {
+                    const Instruction Ref = Function.Code[Pc + 1];
+                    const TypeLayout& Owner = Types[GetFieldType(Ref)];
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " " << GetC(Word) << "\t; " << Owner.Name
+                        << " slot " << GetField(Ref) << ", " << Functions[Owner.VTable[GetField(Ref)]].Name;
+                    break;
+                }
+                case EOpCode::CALLIFACE: {
+                    const Instruction Ref = Function.Code[Pc + 1];
+                    const InterfaceLayout& Used = Interfaces[GetFieldType(Ref)];
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " " << GetC(Word) << "\t; " << Used.Name << "."
+                        << Used.Methods[GetField(Ref)];
+                    break;
+                }
+                case EOpCode::RETURN:
+                    Out << " R" << GetA(Word) << " " << GetB(Word);
+                    break;
+                default:
+                    Out << " R" << GetA(Word) << " R" << GetB(Word) << " R" << GetC(Word);
+                    break;
+            }
+            Out << "\n";
+        }
+
+        return Out.str();
+    }
+}
@@ -0,0 +1,426 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ASTNode.h"
+#include "Hashing.h"
+#include "Value.h"
+
+namespace Vex {
+
+    /**
+     * Every opcode with its operand format, in encoding order
+     *
+     * R[X] is register X of the current frame, K[X] constant X of the
+     * Program and G[X] global slot X. Jump offsets are relative to the
+     * next instruction. `next` is the extra word after the opcodes that
+     * Width() counts as two. A call's arguments are the C registers
+     * starting at B, and the callee's frame begins at R[B], so arguments
+     * are never copied.
+     */
+    #define VEX_OPCODES(X)                                                              \
+        X(MOVE,       "A B",    "R[A] = R[B]")                                          \
+        X(LOADK,      "A Bx",   "R[A] = K[Bx]")                                         \
+        X(LOADI,      "A sBx",  "R[A] = sBx")                                           \
+        X(LOADNULL,   "A",      "R[A] = null")                                          \
+        X(LOADBOOL,   "A B",    "R[A] = B != 0")                                        \
+        X(GETGLOBAL,  "A Bx",   "R[A] = G[Bx]")                                         \
+        X(SETGLOBAL,  "A Bx",   "G[Bx] = R[A]")                                         \
+        X(ADD,        "A B C",  "R[A] = R[B] + R[C]")                                   \
+        X(SUB,        "A B C",  "R[A] = R[B] - R[C]")                                   \
+        X(MUL,        "A B C",  "R[A] = R[B] * R[C]")                                   \
+        X(DIV,        "A B C",  "R[A] = R[B] / R[C]")                                   \
+        X(MOD,        "A B C",  "R[A] = R[B] % R[C]")                                   \
+        X(POW,        "A B C",  "R[A] = R[B] ** R[C]")                                  \
+        X(ADDI,       "A B sC", "R[A] = R[B] + sC")                                     \
+        X(EQ,         "A B C",  "R[A] = R[B] == R[C]")                                  \
+        X(NE,         "A B C",  "R[A] = R[B] != R[C]")                                  \
+        X(TEQ,        "A B C",  "R[A] = R[B] === R[C]")                                 \
+        X(TNE,        "A B C",  "R[A] = R[B] !== R[C]")                                 \
+        X(LT,         "A B C",  "R[A] = R[B] < R[C]")                                   \
+        X(LE,         "A B C",  "R[A] = R[B] <= R[C]")                                  \
+        X(BAND,       "A B C",  "R[A] = R[B] & R[C]")                                   \
+        X(BOR,        "A B C",  "R[A] = R[B] | R[C]")                                   \
+        X(BXOR,       "A B C",  "R[A] = R[B] ^ R[C]")                                   \
+        X(SHL,        "A B C",  "R[A] = R[B] << R[C]")                                  \
+        X(SHR,        "A B C",  "R[A] = R[B] >> R[C]")                                  \
+        X(MATH,       "A B C",  "R[A] = Intrinsics[next](R[B], R[C]), else as its opcode") \
+        X(NEG,        "A B",    "R[A] = -R[B]")                                         \
+        X(NOT,        "A B",    "R[A] = !R[B]")                                         \
+        X(BNOT,       "A B",    "R[A] = ~R[B]")                                         \
+        X(TOINT,      "A B",    "R[A] = R[B] as Int")                                   \
+        X(TOFLOAT,    "A B",    "R[A] = R[B] as Float")                                 \
+        X(GETLANE,    "A B C",  "R[A] = R[B].Lanes[C] as Float")                        \
+        X(NEWARRAY,   "A B C",  "R[A] = new Types[next][](R[B]), counted from 1 if C (see RETAIN)") \
+        X(NEWLOCAL,   "A B",    "R[A] = new Types[next][](R[B]) in this frame")         \
+        X(GETFIELD,   "A B C",  "R[A] = R[B][R[C]].Fields[next.Field], R[B] a Types[next.Type][]") \
+        X(SETFIELD,   "A B C",  "R[B][R[C]].Fields[next.Field] = R[A], R[B] a Types[next.Type][]") \
+        X(COUNT,      "A B",    "R[A] = R[B].Count")                                    \
+        X(IFACE,      "A B C",  "R[A] = R[B][R[C]] as Interfaces[next]")                \
+        X(RETAIN,     "A B",    "++R[A].Shares if R[A] is an array, atomically if B & CountAtomic") \
+        X(RELEASE,    "A B",    "--R[A].Shares likewise, when Call() ends if B & CountDeferred") \
+        X(JMP,        "sJ",     "pc += sJ")                                             \
+        X(JMPIF,      "A sBx",  "if R[A] { pc += sBx }")                                \
+        X(JMPIFNOT,   "A sBx",  "if !R[A] { pc += sBx }")                               \
+        X(JMPNN,      "A sBx",  "if R[A] != null { pc += sBx }")                        \
+        X(ISTYPE,     "A Bx",   "if R[A] is not a Types[Bx][] { pc += 1 }")             \
+        X(SWITCH,     "A Bx",   "pc += Switches[Bx].Target(R[A])")                      \
+        X(FORPREP,    "A sBx",  "R[A+3] = R[A]; if !(R[A] < R[A+1]) { pc += sBx }")     \
+        X(FORLOOP,    "A sBx",  "R[A] += R[A+2]; if R[A] < R[A+1] { R[A+3] = R[A]; pc += sBx }") \
+        X(FORPREPI,   "A sBx",  "as FORPREP, with <=")                                  \
+        X(FORLOOPI,   "A sBx",  "as FORLOOP, with <=")                                  \
+        X(CALL,       "A B C",  "R[A] = Functions[next](R[B], ..., R[B+C-1])")          \
+        X(CALLVIRT,   "A B C",  "R[A] = R[B].Type.VTable[next.Field](R[B], ..., R[B+C-1]), compiled for Types[next.Type]") \
+        X(CALLIFACE,  "A B C",  "R[A] = ITables[R[B].Table + 1 + next.Field](R[B].Array, R[B].Index, ..., R[B+C-1])") \
+        X(CALLNATIVE, "A B C",  "R[A] = Natives[next](R[B], ..., R[B+C-1])")            \
+        X(RETURN,     "A B",    "return B != 0 ? R[A] : null")
+
+    enum class EOpCode : uint8_t {
+    #define VEX_OPCODE_ENUM(Name, Format, Effect) Name,
+        VEX_OPCODES(VEX_OPCODE_ENUM)
+    #undef VEX_OPCODE_ENUM
+    };
+
+    constexpr size_t OpCodeCount = static_cast<size_t>(EOpCode::RETURN) + 1;
+
+    std::string OpCodeToString(EOpCode Op);
+
+    /**
+     * One 32-bit instruction
+     *
+     *   31      24 23      16 15       8 7       0
+     *   [    C    ][    B    ][    A    ][   Op   ]
+     *   [         Bx         ]
+     *   [              sJ              ]
+     *
+     * Signed operands are stored with a bias: sBx = Bx - MaxBx / 2,
+     * sC = C - 128 and sJ = J - MaxJ / 2. The opcode sits in the low byte
+     * so dispatch needs no shift.
+     */
+    using Instruction = uint32_t;
+
+    namespace Encoding {
+        constexpr uint32_t MaxBx = 0xFFFF;
+        constexpr uint32_t MaxJ = 0xFFFFFF;
+        constexpr int32_t BiasBx = static_cast<int32_t>(MaxBx / 2);
+        constexpr int32_t BiasC = 128;
+        constexpr int32_t BiasJ = static_cast<int32_t>(MaxJ / 2);
+
+        constexpr Instruction ABC(const EOpCode Op, const uint32_t A, const uint32_t B, const uint32_t C) {
+            return static_cast<uint32_t>(Op) | A << 8 | B << 16 | C << 24;
+        }
+
+        constexpr Instruction ABx(const EOpCode Op, const uint32_t A, const uint32_t Bx) {
+            return static_cast<uint32_t>(Op) | A << 8 | Bx << 16;
+        }
+
+        constexpr Instruction AsBx(const EOpCode Op, const uint32_t A, const int32_t sBx) {
+            return ABx(Op, A, static_cast<uint32_t>(sBx + BiasBx));
+        }
+
+        constexpr Instruction sJ(const EOpCode Op, const int32_t Offset) {
+            return static_cast<uint32_t>(Op) | static_cast<uint32_t>(Offset + BiasJ) << 8;
+        }
+
+        constexpr EOpCode GetOp(const Instruction Word) { return static_cast<EOpCode>(Word & 0xFF); }
+        constexpr uint32_t GetA(const Instruction Word) { return Word >> 8 & 0xFF; }
+        constexpr uint32_t GetB(const Instruction Word) { return Word >> 16 & 0xFF; }
+        constexpr uint32_t GetC(const Instruction Word) { return Word >> 24; }
+        constexpr int32_t GetsC(const Instruction Word) { return static_cast<int32_t>(Word >> 24) - BiasC; }
+        constexpr uint32_t GetBx(const Instruction Word) { return Word >> 16; }
+        constexpr int32_t GetsBx(const Instruction Word) { return static_cast<int32_t>(Word >> 16) - BiasBx; }
+        constexpr int32_t GetsJ(const Instruction Word) { return static_cast<int32_t>(Word >> 8) - BiasJ; }
+
+        /**
+         * Extra word of GETFIELD and SETFIELD: field Field of Types[Type]; of CALLVIRT, virtual slot Field; of
+         * CALLIFACE, method Field of Interfaces[Type]
+         */
+        constexpr Instruction FieldRef(const uint32_t Type, const uint32_t Field) { return Type << 16 | Field; }
+        constexpr uint32_t GetFieldType(const Instruction Ref) { return Ref >> 16; }
+        constexpr uint32_t GetField(const Instruction Ref) { return Ref & 0xFFFF; }
+
+        constexpr uint32_t MaxTypes = 0xFFFF;
+        constexpr uint32_t MaxFields = 0xFFFF;
+        constexpr uint32_t MaxSwitches = 0xFFFF;
+
+        /** B operand of RETAIN and RELEASE */
+        constexpr uint32_t CountAtomic = 1;         // Another thread may count the array too
+        constexpr uint32_t CountDeferred = 2;       // RELEASE of a call's result the caller did not keep
+
+        /** Words taken by an instruction starting with Op (calls, MATH and the array opcodes but COUNT carry an index) */
+        constexpr size_t Width(const EOpCode Op) {
+            return Op == EOpCode::CALL || Op == EOpCode::CALLVIRT || Op == EOpCode::CALLIFACE || Op == EOpCode::CALLNATIVE ||
+                           Op == EOpCode::MATH || Op == EOpCode::NEWARRAY || Op == EOpCode::NEWLOCAL || Op == EOpCode::GETFIELD ||
+                           Op == EOpCode::SETFIELD || Op == EOpCode::IFACE
+                       ? 2
+                       : 1;
+        }
+    }
+
+    /**
+     * Compiled function
+     *
+     * Parameters arrive in R[0] .. R[ParameterCount - 1]; RegisterCount is
+     * the frame size. Locations has one entry per code word, for runtime
+     * errors.
+     */
+    struct Function {
+        std::string Name;
+        uint8_t ParameterCount = 0;
+        uint16_t RegisterCount = 0;
+        std::vector<Instruction> Code;
+        std::vector<SourceLocation> Locations;
+    };
+
+    enum class ESwitchKind : uint8_t {
+        Dense,      // Int cases close together: Dense[Value - Low]
+        Sorted,     // Sparse Int cases: binary search in Keys
+        Hashed      // String cases: perfect hash into Slots
+    };
+
+    /**
+     * Where SWITCH goes for each value of its subject
+     *
+     * The Compiler builds one for a match whose cases are all Int or all
+     * String literals, with enough of them that a chain of EQ would be
+     * slower. Targets are relative to the instruction after the SWITCH,
+     * like jump offsets; a value no case names goes to Default.
+     *
+     * Hashed tables are CHD perfect hashes: a string's hash picks a bucket,
+     * and the bucket's Displacement, chosen when compiling so that no two
+     * patterns share a slot, picks its slot. Finding a case therefore
+     * costs one hash and one string comparison, however many there are.
+     *
+     * Subjects of another type get EQ's answer: a Float is compared with
+     * the Int patterns in case order, anything else matches no case.
+     */
+    struct SwitchTable {
+        ESwitchKind Kind = ESwitchKind::Dense;
+        int32_t Default = 0;
+        std::vector<Value> Patterns;                // Case order, each value once
+        std::vector<int32_t> Targets;               // Parallel to Patterns
+
+        int64_t Low = 0;
+        std::vector<int32_t> Dense;                 // Target of Low + Index
+
+        std::vector<int64_t> Keys;                  // Ascending
+        std::vector<int32_t> KeyTargets;            // Parallel to Keys
+
+        std::vector<uint32_t> Displacement;         // Per bucket; a power of two of them
+        std::vector<int32_t> Slots;                 // Index into Patterns, or -1; a power of two of them
+
+        /** Offset of the case Subject selects, or Default */
+        [[nodiscard]] int32_t Target(const Value& Subject) const;
+
+        /** Bucket and slot of a string with hash Hash; the masks are the table sizes minus one */
+        static size_t BucketOf(const uint64_t Hash, const size_t Mask) {
+            return static_cast<size_t>(Hash * 0x9E3779B97F4A7C15ull >> 32) & Mask;
+        }
+        static size_t SlotOf(const uint64_t Hash, const uint32_t Displacement, const size_t Mask) {
+            return static_cast<size_t>(HashCombine(Hash, Displacement)) & Mask;
+        }
+
+        /**
+         * Fills Displacement and Slots so every String in Patterns has a slot
+         * of its own; false if no displacement separates two of them, which
+         * only happens if their 64-bit hashes collide
+         */
+        bool BuildPerfectHash();
+    };
+
+    /** Host function callable from scripts; Arguments holds exactly its arity */
+    using NativeFunction = Value (*)(const Value* Arguments);
+
+    struct NativeBinding {
+        std::string Name;
+        NativeFunction Callback = nullptr;
+        uint8_t Arity = 0;
+        EValueType Result = EValueType::Null;       // What it always returns, or Null if that varies
+    };
+
+    /** Field of a Define, as arrays of the type store it */
+    struct FieldLayout {
+        std::string Name;
+        EValueType Type = EValueType::Null;         // Declared type, or Null if it is not one the VM knows
+        Value Default;                              // Every new element starts with this
+    };
+
+    /**
+     * How arrays of a Define type store their elements
+     *
+     * An @SoA type keeps one contiguous column per field, so a loop over
+     * one field of every element reads only that field's cells; any other
+     * type keeps the fields of each element together. Methods holds the
+     * Fetch and Set accessors declared for the type and the methods of
+     * its Define. The Compiler resolves every field to its index from the
+     * array's declared or inferred Define (GETFIELD), and reports one it
+     * cannot.
+     *
+     * A Define whose first base type is another Define extends it: the
+     * base's fields come first, at the same indices, so code compiled for
+     * the base reads a derived array's cells unchanged. Lineage lists the
+     * types from the root down to this one, which makes Program::IsA one
+     * comparison. Each Virtual method takes a slot in VTable after the
+     * base's slots, and an Override replaces the entry of the slot it
+     * inherits. ITables has the Define's table for each Interface it
+     * implements, its own or its base's: a Define that overrides a method
+     * gets tables of its own.
+     */
+    struct TypeLayout {
+        std::string Name;
+        std::deque<FieldLayout> Fields;             // Instance fields in declaration order
+        bool IsSoA = false;
+        int32_t Base = -1;                          // Program::Types index of the Define this one extends, or -1
+        std::vector<uint32_t> Lineage;              // Program::Types indices, the root first and this type last
+        std::vector<uint32_t> VTable;               // Function of each virtual slot, the base's slots first
+        std::vector<std::pair<uint32_t, uint32_t>> ITables;  // Program::Interfaces index, and its table's Program::ITables offset
+
+        TypeLayout() = default;
+        TypeLayout(const TypeLayout&) = delete;     // FieldIndex points into Fields
+        TypeLayout& operator=(const TypeLayout&) = delete;
+
+        /** Appends a field; names must be unique */
+        FieldLayout& AddField(std::string_view Field);
+
+        /** Index of the field with that name, or -1 */
+        [[nodiscard]] int32_t FindField(std::string_view Field) const;
+
+        /** Records that Method is Program function Function, dispatched through VTable[Slot] unless Slot is -1 */
+        void AddMethod(std::string_view Method, uint32_t Function, int32_t Slot = -1);
+
+        /** Adds the methods of the base this type has none of by that name, before it adds or overrides its own */
+        void InheritMethods(const TypeLayout& From);
+
+        /** Program function index of the method with that name, or -1 */
+        [[nodiscard]] int32_t FindMethod(std::string_view Method) const;
+
+        /** Virtual slot of the method with that name, or -1 if it is not virtual */
+        [[nodiscard]] int32_t FindSlot(std::string_view Method) const;
+
+        /** Program::ITables offset of this type's table for Program::Interfaces[Interface], or -1 if it does not implement it */
+        [[nodiscard]] int32_t FindITable(const uint32_t Interface) const {
+            for (const auto& [Implemented, Table] : ITables) {
+                if (Implemented == Interface) {
+                    return static_cast<int32_t>(Table);
+                }
+            }
+            return -1;
+        }
+
+    private:
+        struct MethodEntry {
+            int32_t Function;
+            int32_t Slot;
+        };
+
+        std::unordered_map<std::string_view, int32_t> FieldIndex;
+        std::unordered_map<std::string, MethodEntry> Methods;
+    };
+
+    /**
+     * The methods a Define must have to be used through an Interface
+     *
+     * Methods are numbered from those of the interfaces it extends, in the
+     * order it lists them, to its own; a name two of them share is one
+     * method. Each Define implementing the Interface has a table in
+     * Program::ITables: the Interface's index, then the function running
+     * each method, so a call through it is one indexed load. A local or
+     * parameter declared with an Interface type holds the element and its
+     * table; the Compiler converts `All[I]` to one with IFACE where one is
+     * expected, and calls through it with CALLIFACE.
+     */
+    struct InterfaceLayout {
+        std::string Name;
+        std::vector<std::string> Methods;           // In slot order
+        std::vector<uint8_t> ParameterCounts;       // Parallel to Methods: of the function, with the array and index
+        std::vector<uint32_t> Extends;              // Program::Interfaces indices of every interface it extends, however indirectly
+
+        /** Slot of the method with that name, or -1 */
+        [[nodiscard]] int32_t FindMethod(std::string_view Method) const;
+    };
+
+    /**
+     * Everything a VirtualMachine runs: functions, the constant pool,
+     * native bindings, the layouts of Define types and the global slots'
+     * names
+     *
+     * Natives must be added before compiling code that calls them. Strings
+     * (constants and names) are stored once and never move, so Values may
+     * point at them for the Program's lifetime.
+     *
+     * Example:
+     *   Program Program;
+     *   Program.AddNative("Sqrt", [](const Value* Args) { return Value::MakeFloat(std::sqrt(Args[0].ToFloat())); }, 1);
+     *   Compiler Compiler(Program);
+     *   Compiler.Compile(Unit);
+     */
+    class Program {
+    public:
+        Program() = default;
+
+        Program(const Program&) = delete;
+        Program& operator=(const Program&) = delete;
+
+        std::vector<Function> Functions;
+        std::vector<Value> Constants;
+        std::vector<NativeBinding> Natives;
+        std::deque<TypeLayout> Types;               // Never move, so arrays may point at their layout
+        std::vector<std::string_view> Globals;      // Slot names
+        std::vector<uint32_t> Initializers;         // Functions assigning the globals' initial values, one per unit
+        std::vector<SwitchTable> Switches;          // Indexed by SWITCH's Bx
+        std::vector<InterfaceLayout> Interfaces;
+        std::vector<uint32_t> ITables;              // Interface tables back to back, each the Interface and then its functions
+
+        uint32_t AddNative(std::string_view Name, NativeFunction Callback, uint8_t Arity,
+                           EValueType Result = EValueType::Null);
+
+        /** Adds an empty function to be filled in by the Compiler; names must be unique */
+        uint32_t AddFunction(std::string_view Name);
+
+        /** Adds a Define type with no fields or base yet; names must be unique */
+        uint32_t AddType(std::string_view Name);
+
+        /** Adds an Interface with no methods yet; names must be unique */
+        uint32_t AddInterface(std::string_view Name);
+
+        /** Whether arrays of Types[Type] can stand for arrays of Types[Of]: the same Define, or one extending it */
+        [[nodiscard]] bool IsA(const uint32_t Type, const uint32_t Of) const {
+            if (Type == Of) {
+                return true;
+            }
+            const std::vector<uint32_t>& Line = Types[Type].Lineage;
+            const size_t Depth = Types[Of].Lineage.size();
+            return Depth != 0 && Depth < Line.size() && Line[Depth - 1] == Of;
+        }
+
+        /** Index of the function, native, type or interface with that name, or -1 */
+        [[nodiscard]] int32_t FindFunction(std::string_view Name) const;
+        [[nodiscard]] int32_t FindNative(std::string_view Name) const;
+        [[nodiscard]] int32_t FindType(std::string_view Name) const;
+        [[nodiscard]] int32_t FindInterface(std::string_view Name) const;
+
+        /** Stable copy of Text; equal strings share one copy */
+        const std::string* Intern(std::string_view Text);
+
+        /** Index of a constant equal to Constant (same type and bits), added if new */
+        uint32_t AddConstant(const Value& Constant);
+
+        /** Readable listing of one function, one instruction per line */
+        [[nodiscard]] std::string Disassemble(const Function& Function) const;
+
+    private:
+        std::deque<std::string> Strings;
+        std::unordered_map<std::string_view, const std::string*> StringIndex;
+        std::unordered_map<std::string_view, int32_t> FunctionIndex;
+        std::unordered_map<std::string_view, int32_t> NativeIndex;
+        std::unordered_map<std::string_view, int32_t> TypeIndex;
+        std::unordered_map<std::string_view, int32_t> InterfaceIndex;
+        std::unordered_map<uint64_t, uint32_t> ConstantIndex[3];   // Int, Float and String bits
+    };
+}
@@ -0,0 +1,2409 @@
+#include "Compiler.h"
+
+#include "Declaration.h"
+#include "Expression.h"
+#include "Intrinsics.h"
+#include "Ownership.h"
+#include "Resolver.h"
+#include "Statement.h"
+#include "StaticVisitor.h"
+#include "Workers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+
+namespace Vex {
+    namespace {
+        using namespace Encoding;
+
+        constexpr uint32_t MaxRegisters = 256;
+        constexpr size_t MinSwitchCases = 4;           // Fewer are as quick through a chain of EQ
+        constexpr uint64_t MaxDenseSpan = 65536;
+        constexpr uint32_t MaxInlineCost = 24;         // AST nodes of a body expanded at every call
+        constexpr size_t MaxInlineDepth = 4;           // Expansions inside expansions
+        constexpr size_t MaxGuardedTypes = 4;          // Receiver Defines a virtual call is tested for before CALLVIRT
+
+        bool IsWildcard(const Expression* Pattern) {
+            const auto* Name = Pattern->As<Identifier>();
+            return Name != nullptr && Name->Name == "_";
+        }
+
+        bool IsLiteral(const Expression* Expr) {
+            return Expr != nullptr && Expr->Kind >= ENodeKind::IntegerLiteral && Expr->Kind <= ENodeKind::NullLiteral;
+        }
+
+        bool IsVoid(const TypeRef* Type) {
+            return Type != nullptr && !Type->IsArray && !Type->IsPointer && Type->Name == "Void";
+        }
+
+        /** Opcode of a binary operator that maps to one instruction; Swap for > and >= */
+        bool BinaryOpCode(const EBinaryOp Op, EOpCode& Out, bool& Swap) {
+            Swap = false;
+            switch (Op) {
+                case EBinaryOp::Add:            case EBinaryOp::AddAssign:      Out = EOpCode::ADD; return true;
+                case EBinaryOp::Subtract:       case EBinaryOp::SubtractAssign: Out = EOpCode::SUB; return true;
+                case EBinaryOp::Multiply:       case EBinaryOp::MultiplyAssign: Out = EOpCode::MUL; return true;
+                case EBinaryOp::Divide:         case EBinaryOp::DivideAssign:   Out = EOpCode::DIV; return true;
+                case EBinaryOp::Modulo:         case EBinaryOp::ModuloAssign:   Out = EOpCode::MOD; return true;
+                case EBinaryOp::Power:          Out = EOpCode::POW;  return true;
+                case EBinaryOp::Equal:          Out = EOpCode::EQ;   return true;
+                case EBinaryOp::NotEqual:       Out = EOpCode::NE;   return true;
+                case EBinaryOp::TypeValueEq:    Out = EOpCode::TEQ;  return true;
+                case EBinaryOp::TypeValueNeq:   Out = EOpCode::TNE;  return true;
+                case EBinaryOp::Less:           Out = EOpCode::LT;   return true;
+                case EBinaryOp::LessEqual:      Out = EOpCode::LE;   return true;
+                case EBinaryOp::Greater:        Out = EOpCode::LT;   Swap = true; return true;
+                case EBinaryOp::GreaterEqual:   Out = EOpCode::LE;   Swap = true; return true;
+                case EBinaryOp::BitwiseAnd:     Out = EOpCode::BAND; return true;
+                case EBinaryOp::BitwiseOr:      Out = EOpCode::BOR;  return true;
+                case EBinaryOp::BitwiseXor:     Out = EOpCode::BXOR; return true;
+                case EBinaryOp::LeftShift:      Out = EOpCode::SHL;  return true;
+                case EBinaryOp::RightShift:     Out = EOpCode::SHR;  return true;
+                default:                        return false;
+            }
+        }
+
+        /** Value type a declared type name stands for, or Null if it is not one the VM knows */
+        EValueType TypeFromName(const std::string_view Name) {
+            if (Name == "Int" || Name.substr(0, 4) == "Int_" || Name == "Uint" || Name.substr(0, 5) == "Uint_") {
+                return EValueType::Int;
+            }
+            if (Name == "Float" || Name.substr(0, 6) == "Float_" || Name == "Double") {
+                return EValueType::Float;
+            }
+            if (Name == "Bool")    { return EValueType::Bool; }
+            if (Name == "String")  { return EValueType::String; }
+            if (Name == "Vector2") { return EValueType::Vector2; }
+            if (Name == "Vector3") { return EValueType::Vector3; }
+            if (Name == "Vector4") { return EValueType::Vector4; }
+            if (Name == "Quat")    { return EValueType::Quat; }
+            if (Name == "Color")   { return EValueType::Color; }
+            return EValueType::Null;
+        }
+
+        EValueType TypeFromRef(const TypeRef* Type) {
+            if (Type == nullptr || Type->IsPointer) {
+                return EValueType::Null;
+            }
+            return Type->IsArray ? EValueType::Array : TypeFromName(Type->Name);
+        }
+
+        /** Value a field of that type starts with when its declaration gives none */
+        Value ZeroOf(const EValueType Type) {
+            switch (Type) {
+                case EValueType::Bool:  return Value::MakeBool(false);
+                case EValueType::Int:   return Value::MakeInt(0);
+                case EValueType::Float: return Value::MakeFloat(0.0);
+                default:                return Type >= EValueType::Vector2 ? Value::MakeMath(Type, 0.0f, 0.0f) : Value();
+            }
+        }
+
+        /** Value of a literal, or of a negated number literal; false for anything else */
+        bool LiteralValue(Program& Target, Expression* Expr, Value& Out) {
+            Expr = Unwrap(Expr);
+            bool Negate = false;
+            if (const auto* Unary = Expr->As<UnaryExpression>(); Unary != nullptr && Unary->Op == EUnaryOp::Minus) {
+                Expr = Unwrap(Unary->Operand);
+                Negate = true;
+            }
+
+            switch (Expr->Kind) {
+                case ENodeKind::IntegerLiteral: {
+                    const auto Bits = static_cast<uint64_t>(Expr->As<IntegerLiteral>()->Value);
+                    Out = Value::MakeInt(static_cast<long long>(Negate ? 0 - Bits : Bits));
+                    return true;
+                }
+                case ENodeKind::CharLiteral:
+                    Out = Value::MakeInt(static_cast<unsigned char>(Expr->As<CharLiteral>()->Value));
+                    return !Negate;
+                case ENodeKind::FloatLiteral:
+                    Out = Value::MakeFloat(Negate ? -Expr->As<FloatLiteral>()->Value : Expr->As<FloatLiteral>()->Value);
+                    return true;
+                case ENodeKind::BoolLiteral:
+                    Out = Value::MakeBool(Expr->As<BoolLiteral>()->Value);
+                    return !Negate;
+                case ENodeKind::StringLiteral:
+                    Out = Value::MakeString(Target.Intern(Expr->As<StringLiteral>()->Value));
+                    return !Negate;
+                case ENodeKind::NullLiteral:
+                    Out = Value();
+                    return !Negate;
+                default:
+                    return false;
+            }
+        }
+
+        /**
+         * SWITCH table for a match whose patterns, up to the first wildcard,
+         * are all Int (or Char) literals or all String literals; false if one
+         * is not, or if there are too few cases for a table to pay off
+         *
+         * Ints close together get a Dense table and others a Sorted one;
+         * Strings get a perfect hash. A value named twice keeps its first
+         * case. Targets hold case positions, -1 for none, until the bodies
+         * are placed.
+         */
+        bool PlanSwitch(Program& Target, const MatchStatement& Match, SwitchTable& Table) {
+            EValueType Type = EValueType::Null;
+            std::unordered_set<uint64_t> Seen;
+            for (size_t Position = 0; Position < Match.Cases.size() && !IsWildcard(Match.Cases[Position].Pattern); ++Position) {
+                Value Pattern;
+                if (!LiteralValue(Target, Match.Cases[Position].Pattern, Pattern) ||
+                    (Pattern.Type != EValueType::Int && Pattern.Type != EValueType::String) ||
+                    (Type != EValueType::Null && Pattern.Type != Type)) {
+                    return false;
+                }
+                Type = Pattern.Type;
+
+                // Interned, so equal strings are the same pointer
+                const uint64_t Key = Type == EValueType::Int ? static_cast<uint64_t>(Pattern.Int)
+                                                             : reinterpret_cast<uintptr_t>(Pattern.String);
+                if (Seen.insert(Key).second) {
+                    Table.Patterns.push_back(Pattern);
+                    Table.Targets.push_back(static_cast<int32_t>(Position));
+                }
+            }
+            if (Table.Patterns.size() < MinSwitchCases) {
+                return false;
+            }
+
+            if (Type == EValueType::String) {
+                Table.Kind = ESwitchKind::Hashed;
+                return Table.BuildPerfectHash();
+            }
+
+            const auto [Lowest, Highest] = std::minmax_element(
+                Table.Patterns.begin(), Table.Patterns.end(), [](const Value& Left, const Value& Right) { return Left.Int < Right.Int; });
+            const uint64_t Span = static_cast<uint64_t>(Highest->Int) - static_cast<uint64_t>(Lowest->Int);
+            if (Span < MaxDenseSpan && Span < Table.Patterns.size() * 2) {
+                Table.Kind = ESwitchKind::Dense;
+                Table.Low = Lowest->Int;
+                Table.Dense.assign(Span + 1, -1);
+                for (size_t Index = 0; Index < Table.Patterns.size(); ++Index) {
+                    Table.Dense[static_cast<uint64_t>(Table.Patterns[Index].Int) - static_cast<uint64_t>(Table.Low)] = Table.Targets[Index];
+                }
+                return true;
+            }
+
+            std::vector<std::pair<int64_t, int32_t>> Sorted;
+            for (size_t Index = 0; Index < Table.Patterns.size(); ++Index) {
+                Sorted.emplace_back(Table.Patterns[Index].Int, Table.Targets[Index]);
+            }
+            std::sort(Sorted.begin(), Sorted.end());
+            Table.Kind = ESwitchKind::Sorted;
+            for (const auto& [Key, Position] : Sorted) {
+                Table.Keys.push_back(Key);
+                Table.KeyTargets.push_back(Position);
+            }
+            return true;
+        }
+
+        /** Type of Left Op Right for operands of these types, or Null if unknown */
+        EValueType ResultType(const EOpCode Op, const EValueType Left, const EValueType Right) {
+            if (Op == EOpCode::EQ || Op == EOpCode::NE || Op == EOpCode::TEQ || Op == EOpCode::TNE || Op == EOpCode::LT ||
+                Op == EOpCode::LE) {
+                return EValueType::Bool;
+            }
+            if (const int32_t Math = FindIntrinsic(Op, Left, Right); Math >= 0) {
+                return GetIntrinsic(static_cast<uint32_t>(Math)).Result;
+            }
+            if (Left == EValueType::Int && Right == EValueType::Int) {
+                return EValueType::Int;
+            }
+            const bool Numbers = (Left == EValueType::Int || Left == EValueType::Float) &&
+                                 (Right == EValueType::Int || Right == EValueType::Float);
+            return Numbers && Op <= EOpCode::POW ? EValueType::Float : EValueType::Null;
+        }
+
+        /** Lane a member name reads (X Y Z W or R G B A), or -1 */
+        int32_t LaneOf(const std::string_view Member) {
+            static constexpr std::string_view Names[] = { "X", "Y", "Z", "W", "R", "G", "B", "A" };
+            for (int32_t Index = 0; Index < 8; ++Index) {
+                if (Member == Names[Index]) {
+                    return Index % 4;
+                }
+            }
+            return -1;
+        }
+
+        /** Immediate of `X + Literal` or `X - Literal` when it fits ADDI */
+        bool SmallAddend(const EOpCode Op, const Expression* Right, int32_t& Out) {
+            const auto* Literal = Right->As<IntegerLiteral>();
+            if (Literal == nullptr || (Op != EOpCode::ADD && Op != EOpCode::SUB)) {
+                return false;
+            }
+            const long long Addend = Op == EOpCode::ADD ? Literal->Value : -Literal->Value;
+            if (Addend < -BiasC || Addend > 255 - BiasC) {
+                return false;
+            }
+            Out = static_cast<int32_t>(Addend);
+            return true;
+        }
+
+        /**
+         * Size of a function body for the inlining budget: one per statement
+         * and expression
+         *
+         * A body that makes arrays is never inlined, so the frame-local ones
+         * are still released when its own call returns, nor is one that
+         * declares or returns Shared references, which its RETURN releases
+         * and hands over. Assigned marks the
+         * local slots the body writes after declaring them: parameters that
+         * are not may read the caller's locals in place, and other locals
+         * keep the Define of the array they were declared with.
+         */
+        class InlineCost : public StaticVisitor<InlineCost> {
+        public:
+            uint32_t Cost = 0;
+            bool MakesArrays = false;
+            bool Counts = false;
+            std::vector<bool> Assigned;
+
+            explicit InlineCost(const size_t Slots) : Assigned(Slots, false) {}
+
+            void VisitNode(ASTNode&) { ++Cost; }
+
+            void VisitVariableDeclaration(VariableDeclaration& Variable) {
+                ++Cost;
+                Counts = Counts || OwnershipAnalysis::IsShared(Variable.Type);
+                VisitChildren(Variable);
+            }
+
+            void VisitNewExpression(NewExpression& New) {
+                ++Cost;
+                MakesArrays = true;
+                VisitChildren(New);
+            }
+
+            void VisitBinaryExpression(BinaryExpression& Binary) {
+                ++Cost;
+                const auto* Name = Unwrap(Binary.Left)->As<Identifier>();
+                if (IsAssignmentOp(Binary.Op) && Name != nullptr && Name->Symbol.Kind == ESymbolKind::Local &&
+                    Name->Symbol.Index < Assigned.size()) {
+                    Assigned[Name->Symbol.Index] = true;
+                }
+                VisitChildren(Binary);
+            }
+        };
+
+        /** Local slots an expression assigns, plainly or compounded, anywhere inside it */
+        class LocalWrites : public StaticVisitor<LocalWrites> {
+        public:
+            std::vector<uint32_t> Slots;
+
+            void VisitBinaryExpression(BinaryExpression& Binary) {
+                const auto* Name = Unwrap(Binary.Left)->As<Identifier>();
+                if (IsAssignmentOp(Binary.Op) && Name != nullptr && Name->Symbol.Kind == ESymbolKind::Local) {
+                    Slots.push_back(Name->Symbol.Index);
+                }
+                VisitChildren(Binary);
+            }
+        };
+
+        /** A function of the unit whose calls are compiled as a copy of its body */
+        struct Inlinable {
+            const FunctionDeclaration* Declaration = nullptr;  // Null if calls to it stay calls
+            ScopeId Scope = SymbolTable::GlobalScope;
+            uint32_t SlotCount = 0;
+            uint32_t Hidden = 0;                                // Slots ahead of the parameters: an accessor's array and index
+            std::vector<bool> Assigned;                         // By local slot, hidden ones included
+        };
+
+        /** What a Compiler shares with the functions it builds */
+        struct UnitState {
+            Program& Target;
+            std::vector<CompileError>& Errors;
+            const Resolver& Names;
+            const std::vector<bool>& ConstGlobals;
+            const std::vector<bool>& SharedGlobals;
+            const std::vector<const FunctionDeclaration*>& Signatures;
+            size_t& InlinedCalls;
+            DispatchReport& Dispatch;
+            const bool FrameAllocating;
+            const bool Devirtualizing;
+            const OwnershipAnalysis* Ownership = nullptr;      // Set once the bodies are checked
+            const std::vector<Inlinable>* Inlines = nullptr;   // By function index; set likewise, if calls are inlined
+        };
+
+        /**
+         * Emits the code of one function
+         *
+         * Registers are handed out like a stack: a statement or expression
+         * remembers NextRegister, takes what it needs and gives it all back
+         * when done, so temporaries never outlive their expression and
+         * locals are freed at the end of their block. Names arrive bound by
+         * the Resolver; a local's slot says which register it was given.
+         *
+         * A call to a small function of the unit is replaced by a copy of
+         * its body (see Inline), built on the callee's slots above the
+         * caller's registers. A virtual call is narrowed to the methods its
+         * receiver can run (see CompileVirtualCall).
+         */
+        class FunctionBuilder {
+        public:
+            FunctionBuilder(const UnitState& Unit, const uint32_t Index, const uint32_t SlotCount = 0,
+                            const ScopeId Namespace = SymbolTable::GlobalScope)
+                : Unit(Unit), Building(Index), Output(Unit.Target.Functions[Index]), Slots(SlotCount), Namespace(Namespace) {}
+
+            void AddParameter(const Parameter& Param, const uint32_t Slot) {
+                Slots[Slot] = { Allocate(), false, TypeFromRef(Param.Type), -1 };
+                if (const ERefCount Count = CountOf(Slot); IsCounted(Count)) {
+                    EmitCount(EOpCode::RETAIN, Slots[Slot].Register, Count);
+                    Held.push_back({ Slots[Slot].Register, Slot, Count });
+                }
+            }
+
+            /** A method's or accessor's hidden parameters: the array it was called on in slot 0 and the index in slot 1 */
+            void AddElement() {
+                Slots[0] = { Allocate(), true, EValueType::Array, -1 };
+                Slots[1] = { Allocate(), true, EValueType::Int, -1 };
+            }
+
+            void CompileBody(BlockStatement* Body) {
+                InlineCost Facts(Slots.size());
+                Facts.Visit(Body);
+                BodyAssigned = std::move(Facts.Assigned);
+                Assigned = &BodyAssigned;
+
+                Current = Body->Location;
+                CompileBlock(*Body);
+            }
+
+            void CompileGlobal(const uint32_t Slot, Expression* Initializer, const ScopeId Scope) {
+                Namespace = Scope;
+                const uint32_t Mark = NextRegister;
+                const bool Adopted = Unit.SharedGlobals[Slot] && Adopts(Initializer);
+                Owned = Adopted ? Unwrap(Initializer) : nullptr;
+                const uint32_t Value = CompileOperand(Initializer);
+                Owned = nullptr;
+                Current = Initializer->Location;
+                if (Unit.SharedGlobals[Slot] && !Adopted) {
+                    EmitCount(EOpCode::RETAIN, Value, ERefCount::Atomic);
+                }
+                Emit(ABx(EOpCode::SETGLOBAL, Value, Slot));
+                NextRegister = Mark;
+            }
+
+            /** Ends the code with `return null` and sizes the frame */
+            void Finish() {
+                ReleaseHeld(0);
+                Emit(ABC(EOpCode::RETURN, 0, 0, 0));
+                Output.RegisterCount = static_cast<uint16_t>(std::max<uint32_t>(Highest, 1));
+            }
+
+        private:
+            /**
+             * Type is what the local is known to hold, from its declaration or
+             * its last assignment, or Null if unknown. It only picks
+             * instructions: MATH checks its operands, so a stale guess costs
+             * speed, never correctness. Exact is not a guess: the Define of
+             * the array `new` made for a local that is never assigned again,
+             * or -1.
+             */
+            struct Local {
+                uint32_t Register = 0;
+                bool IsConst = false;
+                EValueType Type = EValueType::Null;
+                int32_t Exact = -1;
+            };
+
+            struct Loop {
+                std::vector<size_t> Breaks;
+                std::vector<size_t> Continues;
+                size_t Holding = 0;                 // Entries of Held when the loop began
+            };
+
+            /** A Shared local or parameter that holds a count of its array, dropped when its scope ends */
+            struct Holder {
+                uint32_t Register;
+                uint32_t Slot;
+                ERefCount Count;
+            };
+
+            /** A call being compiled as a copy of its callee's body */
+            struct Expansion {
+                uint32_t Function;
+                uint32_t Result;                    // The call's target register
+                std::vector<size_t> Exits;          // Jumps from returns to the end of the copy
+            };
+
+            const UnitState& Unit;
+            const uint32_t Building;                // Index of Output
+            Function& Output;                       // Functions are all added before any is built
+
+            std::vector<Local> Slots;               // By the Resolver's local slot
+            std::vector<bool> BodyAssigned;         // By slot, whether Output's own body assigns the local
+            const std::vector<bool>* Assigned = nullptr;  // The same for the body being compiled, which may be a copy
+            ScopeId Namespace;                      // Where the code being built names things from
+            std::vector<Loop> Loops;
+            std::vector<Expansion> Expansions;      // Innermost last
+            std::vector<Holder> Held;               // Innermost scope last
+            const Expression* Owned = nullptr;      // The new or Shared call whose count the store being compiled keeps
+            uint32_t NextRegister = 0;
+            uint32_t Highest = 0;
+            bool OutOfRegisters = false;
+            SourceLocation Current;
+
+            // ---- Emission ----
+
+            void Error(const SourceLocation Location, std::string Message) {
+                Unit.Errors.push_back({ std::move(Message), Location });
+            }
+
+            size_t Emit(const Instruction Word) {
+                Output.Code.push_back(Word);
+                Output.Locations.push_back(Current);
+                return Output.Code.size() - 1;
+            }
+
+            [[nodiscard]] size_t Here() const { return Output.Code.size(); }
+
+            size_t EmitJump(const EOpCode Op, const uint32_t A = 0) {
+                return Emit(Op == EOpCode::JMP ? sJ(Op, 0) : AsBx(Op, A, 0));
+            }
+
+            /** Points the jump at At to To */
+            void Patch(const size_t At, const size_t To) {
+                const auto Offset = static_cast<int64_t>(To) - static_cast<int64_t>(At + 1);
+                Instruction& Word = Output.Code[At];
+
+                if (GetOp(Word) == EOpCode::JMP) {
+                    if (Offset < -BiasJ || Offset > static_cast<int64_t>(MaxJ) - BiasJ) {
+                        Error(Output.Locations[At], "Jump too far");
+                        return;
+                    }
+                    Word = sJ(EOpCode::JMP, static_cast<int32_t>(Offset));
+                } else {
+                    if (Offset < -BiasBx || Offset > static_cast<int64_t>(MaxBx) - BiasBx) {
+                        Error(Output.Locations[At], "Conditional jump too far; split the function");
+                        return;
+                    }
+                    Word = AsBx(GetOp(Word), GetA(Word), static_cast<int32_t>(Offset));
+                }
+            }
+
+            void EmitJumpTo(const EOpCode Op, const uint32_t A, const size_t To) {
+                Patch(EmitJump(Op, A), To);
+            }
+
+            void EmitMove(const uint32_t To, const uint32_t From) {
+                if (To != From) {
+                    Emit(ABC(EOpCode::MOVE, To, From, 0));
+                }
+            }
+
+            void EmitConstant(const uint32_t To, const Value& Constant) {
+                const uint32_t Index = Unit.Target.AddConstant(Constant);
+                if (Index > MaxBx) {
+                    Error(Current, "More than 65536 constants");
+                    return;
+                }
+                Emit(ABx(EOpCode::LOADK, To, Index));
+            }
+
+            // ---- Registers and names ----
+
+            uint32_t Allocate() {
+                if (NextRegister >= MaxRegisters) {
+                    if (!OutOfRegisters) {
+                        Error(Current, "Function needs more than 256 registers");
+                        OutOfRegisters = true;
+                    }
+                    return MaxRegisters - 1;
+                }
+                Highest = std::max(Highest, NextRegister + 1);
+                return NextRegister++;
+            }
+
+            /** The local Expr names, or null if it is anything else */
+            Local* LocalOf(Expression* Expr) {
+                const auto* Name = Unwrap(Expr)->As<Identifier>();
+                return Name != nullptr && Name->Symbol.Kind == ESymbolKind::Local ? &Slots[Name->Symbol.Index] : nullptr;
+            }
+
+            // ---- Shared references ----
+
+            [[nodiscard]] static bool IsCounted(const ERefCount Count) {
+                return Count == ERefCount::NonAtomic || Count == ERefCount::Atomic;
+            }
+
+            /** How a local slot of the function being built counts; inlined copies hold no Shared references */
+            [[nodiscard]] ERefCount CountOf(const uint32_t Slot) const {
+                return Unit.Ownership != nullptr && Expansions.empty() ? Unit.Ownership->GetCount(Building, Slot) : ERefCount::None;
+            }
+
+            /** Whether Value comes with a count of its own: a new array, or the result of a function returning Shared */
+            [[nodiscard]] bool Adopts(Expression* Value) const {
+                Value = Unwrap(Value);
+                if (Value->Is<NewExpression>()) {
+                    return true;
+                }
+                const auto* Call = Value->As<FunctionCall>();
+                return Call != nullptr && HandsCount(*Call);
+            }
+
+            [[nodiscard]] bool HandsCount(const FunctionCall& Call) const {
+                const auto* Callee = Unwrap(Call.Callee)->As<Identifier>();
+                return Unit.Ownership != nullptr && Callee != nullptr && Callee->Symbol.Kind == ESymbolKind::Function &&
+                       Unit.Ownership->ReturnsShared(Callee->Symbol.Index);
+            }
+
+            void EmitCount(const EOpCode Op, const uint32_t Register, const ERefCount Count, const bool Deferred = false) {
+                Emit(ABC(Op, Register, (Count == ERefCount::NonAtomic ? 0 : CountAtomic) | (Deferred ? CountDeferred : 0), 0));
+            }
+
+            /** Drops the counts of the holders above Down, innermost first, but for the one in Kept's slot */
+            void ReleaseHeld(const size_t Down, const uint32_t Kept = UINT32_MAX) {
+                for (size_t Index = Held.size(); Index > Down; --Index) {
+                    if (Held[Index - 1].Slot != Kept) {
+                        EmitCount(EOpCode::RELEASE, Held[Index - 1].Register, Held[Index - 1].Count);
+                    }
+                }
+            }
+
+            // ---- Static types ----
+
+            /** Program::Types index of the elements of an array of this type, or -1 */
+            int32_t LayoutOf(const TypeRef* Type) const {
+                return Unit.Names.LayoutOf(Type, Namespace);
+            }
+
+            /** What Expr evaluates to, as far as can be told without running it; Null if unknown */
+            EValueType StaticType(Expression* Expr) {
+                Expr = Unwrap(Expr);
+                switch (Expr->Kind) {
+                    case ENodeKind::IntegerLiteral:
+                    case ENodeKind::CharLiteral:   return EValueType::Int;
+                    case ENodeKind::FloatLiteral:  return EValueType::Float;
+                    case ENodeKind::BoolLiteral:   return EValueType::Bool;
+                    case ENodeKind::StringLiteral: return EValueType::String;
+
+                    case ENodeKind::Identifier: {
+                        const Local* Found = LocalOf(Expr);
+                        return Found != nullptr ? Found->Type : EValueType::Null;
+                    }
+
+                    case ENodeKind::UnaryExpression: {
+                        const auto* Unary = Expr->As<UnaryExpression>();
+                        const EValueType Operand = StaticType(Unary->Operand);
+                        if (Unary->Op == EUnaryOp::Minus || Unary->Op == EUnaryOp::Plus) {
+                            return Operand == EValueType::Int || Operand == EValueType::Float ||
+                                           (Operand >= EValueType::Vector2 && Operand <= EValueType::Vector4)
+                                       ? Operand
+                                       : EValueType::Null;
+                        }
+                        return Unary->Op == EUnaryOp::LogicalNot ? EValueType::Bool : EValueType::Null;
+                    }
+
+                    case ENodeKind::BinaryExpression: {
+                        const auto* Binary = Expr->As<BinaryExpression>();
+                        EOpCode Op = EOpCode::ADD;
+                        bool Swap = false;
+                        if (IsAssignmentOp(Binary->Op) || !BinaryOpCode(Binary->Op, Op, Swap)) {
+                            return EValueType::Null;
+                        }
+                        return ResultType(Op, StaticType(Binary->Left), StaticType(Binary->Right));
+                    }
+
+                    case ENodeKind::FunctionCall: {
+                        Expression* Callee = Unwrap(Expr->As<FunctionCall>()->Callee);
+                        const auto* Accessor = Callee->As<MemberAccess>();
+                        const SymbolRef Symbol = Callee->Is<Identifier>() ? Callee->As<Identifier>()->Symbol
+                                                 : Accessor != nullptr   ? Accessor->Symbol
+                                                                         : SymbolRef();
+                        if (Symbol.Kind == ESymbolKind::Function) {
+                            const FunctionDeclaration* Signature = Unit.Signatures[Symbol.Index];
+                            const TypeRef* Returned = Signature != nullptr ? Signature->ReturnType : nullptr;
+                            if (Accessor != nullptr && Returned != nullptr && Returned->MemberPath.size() == 1) {
+                                // -> Entity.Health
+                                const TypeLayout& Owner = Unit.Target.Types[Symbol.Owner];
+                                const int32_t Field = Owner.FindField(Returned->MemberPath[0]);
+                                return Field >= 0 ? Owner.Fields[static_cast<size_t>(Field)].Type : EValueType::Null;
+                            }
+                            return TypeFromRef(Returned);
+                        }
+                        return Symbol.Kind == ESymbolKind::Native ? Unit.Target.Natives[Symbol.Index].Result : EValueType::Null;
+                    }
+
+                    case ENodeKind::MemberAccess: {
+                        const auto* Member = Expr->As<MemberAccess>();
+                        if (Member->Symbol.Kind == ESymbolKind::Field) {
+                            return Unit.Target.Types[Member->Symbol.Owner].Fields[Member->Symbol.Index].Type;
+                        }
+                        if (Unwrap(Member->Object)->Is<IndexAccess>()) {
+                            return EValueType::Null;
+                        }
+                        if (Member->Member == "Count" && StaticType(Member->Object) == EValueType::Array) {
+                            return EValueType::Int;
+                        }
+                        return LaneOf(Member->Member) >= 0 ? EValueType::Float : EValueType::Null;
+                    }
+
+                    case ENodeKind::NewExpression:
+                        return LayoutOf(Expr->As<NewExpression>()->Type) >= 0 ? EValueType::Array : EValueType::Null;
+
+                    case ENodeKind::CastExpression: {
+                        const EValueType Type = TypeFromRef(Expr->As<CastExpression>()->Type);
+                        return Type == EValueType::Int || Type == EValueType::Float ? Type : EValueType::Null;
+                    }
+
+                    default:
+                        return EValueType::Null;
+                }
+            }
+
+            /**
+             * Registers of the array and index whose field Member names: Array[I].Field, Entity.Field in an
+             * accessor or this.Field in a method
+             */
+            bool ElementOf(const MemberAccess& Member, uint32_t& Array, uint32_t& Index) {
+                if (Member.IsOptional) {
+                    return false;
+                }
+                Expression* Object = Unwrap(Member.Object);
+                if (const auto* Element = Object->As<IndexAccess>()) {
+                    Array = CompileOperand(Element->Object);
+                    Index = CompileOperand(Element->Index);
+                    return true;
+                }
+                if (Object->Is<ThisExpression>() && Member.Symbol.Kind == ESymbolKind::Field) {
+                    Array = Slots[0].Register;
+                    Index = Slots[1].Register;
+                    return true;
+                }
+                const Local* Self = Member.Symbol.Kind == ESymbolKind::Field ? LocalOf(Object) : nullptr;
+                if (Self == nullptr) {
+                    return false;
+                }
+                Array = Self->Register;
+                Index = Slots[Object->As<Identifier>()->Symbol.Index + 1].Register;
+                return true;
+            }
+
+            /** Emits GETFIELD or SETFIELD for Member; the Resolver has bound it or reported it */
+            void EmitField(const bool Set, const uint32_t Register, const uint32_t Array, const uint32_t Index,
+                           const MemberAccess& Member) {
+                if (Member.Symbol.Kind != ESymbolKind::Field) {
+                    return;                         // Reported by the Resolver
+                }
+                Emit(ABC(Set ? EOpCode::SETFIELD : EOpCode::GETFIELD, Register, Array, Index));
+                Emit(FieldRef(Member.Symbol.Owner, Member.Symbol.Index));
+            }
+
+            /** Emits Op as a MATH instruction if the operand types select an intrinsic */
+            bool EmitMath(const EOpCode Op, const uint32_t To, const uint32_t Left, const uint32_t Right,
+                          const EValueType LeftType, const EValueType RightType) {
+                const int32_t Math = FindIntrinsic(Op, LeftType, RightType);
+                if (Math < 0) {
+                    return false;
+                }
+                Emit(ABC(EOpCode::MATH, To, Left, Right));
+                Emit(static_cast<Instruction>(Math));
+                return true;
+            }
+
+            // ---- Expressions ----
+
+            /** Register holding Expr's value: a local's own register, or a new temporary */
+            uint32_t CompileOperand(Expression* Expr) {
+                Expr = Unwrap(Expr);
+                if (const Local* Found = LocalOf(Expr)) {
+                    return Found->Register;
+                }
+
+                const uint32_t Temporary = Allocate();
+                CompileInto(Expr, Temporary);
+                return Temporary;
+            }
+
+            /** Evaluates Expr into register To */
+            void CompileInto(Expression* Expr, const uint32_t To) {
+                const SourceLocation Saved = Current;
+                Current = Expr->Location;
+                const uint32_t Mark = NextRegister;
+
+                switch (Expr->Kind) {
+                    case ENodeKind::IntegerLiteral: {
+                        const long long Literal = Expr->As<IntegerLiteral>()->Value;
+                        if (Literal >= -BiasBx && Literal <= static_cast<long long>(MaxBx) - BiasBx) {
+                            Emit(AsBx(EOpCode::LOADI, To, static_cast<int32_t>(Literal)));
+                        } else {
+                            EmitConstant(To, Value::MakeInt(Literal));
+                        }
+                        break;
+                    }
+                    case ENodeKind::FloatLiteral:
+                        EmitConstant(To, Value::MakeFloat(Expr->As<FloatLiteral>()->Value));
+                        break;
+                    case ENodeKind::StringLiteral:
+                        EmitConstant(To, Value::MakeString(Unit.Target.Intern(Expr->As<StringLiteral>()->Value)));
+                        break;
+                    case ENodeKind::CharLiteral:
+                        Emit(AsBx(EOpCode::LOADI, To, static_cast<unsigned char>(Expr->As<CharLiteral>()->Value)));
+                        break;
+                    case ENodeKind::BoolLiteral:
+                        Emit(ABC(EOpCode::LOADBOOL, To, Expr->As<BoolLiteral>()->Value ? 1 : 0, 0));
+                        break;
+                    case ENodeKind::NullLiteral:
+                        Emit(ABC(EOpCode::LOADNULL, To, 0, 0));
+                        break;
+
+                    case ENodeKind::Identifier: {
+                        const SymbolRef Symbol = Expr->As<Identifier>()->Symbol;
+                        if (Symbol.Kind == ESymbolKind::Local) {
+                            EmitMove(To, Slots[Symbol.Index].Register);
+                        } else if (Symbol.Kind == ESymbolKind::Global) {
+                            Emit(ABx(EOpCode::GETGLOBAL, To, Symbol.Index));
+                        }
+                        break;                      // The Resolver reported anything else
+                    }
+
+                    case ENodeKind::GroupingExpression:
+                        CompileInto(Expr->As<GroupingExpression>()->Expr, To);
+                        break;
+
+                    case ENodeKind::UnaryExpression: {
+                        const auto* Unary = Expr->As<UnaryExpression>();
+                        const uint32_t Operand = CompileOperand(Unary->Operand);
+                        switch (Unary->Op) {
+                            case EUnaryOp::Plus:        EmitMove(To, Operand); break;
+                            case EUnaryOp::Minus:       Emit(ABC(EOpCode::NEG, To, Operand, 0)); break;
+                            case EUnaryOp::LogicalNot:  Emit(ABC(EOpCode::NOT, To, Operand, 0)); break;
+                            case EUnaryOp::BitwiseNot:  Emit(ABC(EOpCode::BNOT, To, Operand, 0)); break;
+                        }
+                        break;
+                    }
+
+                    case ENodeKind::BinaryExpression:
+                        CompileBinary(*Expr->As<BinaryExpression>(), To);
+                        break;
+
+                    case ENodeKind::TernaryExpression: {
+                        const auto* Ternary = Expr->As<TernaryExpression>();
+                        const size_t ToFalse = EmitJump(EOpCode::JMPIFNOT, CompileOperand(Ternary->Condition));
+                        NextRegister = Mark;
+                        CompileInto(Ternary->TrueExpr, To);
+                        const size_t ToEnd = EmitJump(EOpCode::JMP);
+                        Patch(ToFalse, Here());
+                        CompileInto(Ternary->FalseExpr, To);
+                        Patch(ToEnd, Here());
+                        break;
+                    }
+
+                    case ENodeKind::FunctionCall:
+                        CompileCall(*Expr->As<FunctionCall>(), To);
+                        break;
+
+                    case ENodeKind::MemberAccess: {
+                        const auto* Member = Expr->As<MemberAccess>();
+                        if (uint32_t Array = 0, Index = 0; ElementOf(*Member, Array, Index)) {
+                            // The Resolver bound the field; the array's layout picks the cell
+                            Current = Expr->Location;
+                            EmitField(false, To, Array, Index, *Member);
+                            break;
+                        }
+                        const EValueType Object = StaticType(Member->Object);
+                        if (Member->Member == "Count" && !Member->IsOptional &&
+                            (Object == EValueType::Array || Object == EValueType::Null)) {
+                            Emit(ABC(EOpCode::COUNT, To, CompileOperand(Member->Object), 0));
+                            break;
+                        }
+                        const int32_t Lane = LaneOf(Member->Member);
+                        if (Lane < 0 || Member->IsOptional) {
+                            Error(Expr->Location, NodeKindToString(Expr->Kind) + " is not supported by the VM yet");
+                            break;
+                        }
+                        if (Object != EValueType::Null && Lane >= MathLaneCount(Object)) {
+                            Error(Expr->Location, ValueTypeToString(Object) + " has no member " + std::string(Member->Member));
+                            break;
+                        }
+                        Emit(ABC(EOpCode::GETLANE, To, CompileOperand(Member->Object), static_cast<uint32_t>(Lane)));
+                        break;
+                    }
+
+                    case ENodeKind::IndexAccess: {
+                        const auto* Element = Expr->As<IndexAccess>();
+                        if (Element->Symbol.Kind != ESymbolKind::Interface) {
+                            Error(Expr->Location, "Array elements can only be used through their fields");
+                            break;
+                        }
+                        // Given where an Interface is expected: the element, and its Define's table, found once here
+                        const uint32_t Array = CompileOperand(Element->Object);
+                        const uint32_t Index = CompileOperand(Element->Index);
+                        Current = Expr->Location;
+                        Emit(ABC(EOpCode::IFACE, To, Array, Index));
+                        Emit(static_cast<Instruction>(Element->Symbol.Index));
+                        break;
+                    }
+
+                    case ENodeKind::NewExpression: {
+                        const auto* New = Expr->As<NewExpression>();
+                        const int32_t Layout = LayoutOf(New->Type);
+                        if (Layout < 0) {
+                            Error(Expr->Location, New->Type->IsArray ? "Only arrays of Define types are supported by the VM yet"
+                                                                     : NodeKindToString(Expr->Kind) + " is not supported by the VM yet");
+                            break;
+                        }
+                        if (New->Arguments.size() != 1) {
+                            Error(Expr->Location, "new " + New->Type->ToString() + "() takes the element count");
+                            break;
+                        }
+                        const uint32_t Count = CompileOperand(New->Arguments[0]);
+                        const bool FrameLocal = Unit.FrameAllocating && Unit.Ownership != nullptr && Unit.Ownership->IsFrameLocal(New);
+                        Current = Expr->Location;
+                        Emit(ABC(FrameLocal ? EOpCode::NEWLOCAL : EOpCode::NEWARRAY, To, Count, Expr == Owned ? 1 : 0));
+                        Emit(static_cast<Instruction>(Layout));
+                        break;
+                    }
+
+                    case ENodeKind::CastExpression: {
+                        const auto* Cast = Expr->As<CastExpression>();
+                        const std::string_view Type = Cast->Type != nullptr ? Cast->Type->Name : std::string_view();
+                        const uint32_t Operand = CompileOperand(Cast->Expr);
+                        if (Type == "Int" || Type.substr(0, 4) == "Int_" || Type == "Uint" || Type.substr(0, 5) == "Uint_") {
+                            Emit(ABC(EOpCode::TOINT, To, Operand, 0));
+                        } else if (Type == "Float" || Type.substr(0, 6) == "Float_" || Type == "Double") {
+                            Emit(ABC(EOpCode::TOFLOAT, To, Operand, 0));
+                        } else {
+                            Error(Expr->Location, "Cast to " + std::string(Type) + " is not supported by the VM yet");
+                        }
+                        break;
+                    }
+
+                    default:
+                        Error(Expr->Location, NodeKindToString(Expr->Kind) + " is not supported by the VM yet");
+                        break;
+                }
+
+                NextRegister = Mark;
+                Current = Saved;
+            }
+
+            void CompileBinary(BinaryExpression& Binary, const uint32_t To) {
+                switch (Binary.Op) {
+                    case EBinaryOp::LogicalAnd:
+                    case EBinaryOp::LogicalOr: {
+                        // The right side only runs when the left does not decide
+                        CompileInto(Binary.Left, To);
+                        const size_t Skip = EmitJump(Binary.Op == EBinaryOp::LogicalAnd ? EOpCode::JMPIFNOT : EOpCode::JMPIF, To);
+                        CompileInto(Binary.Right, To);
+                        Patch(Skip, Here());
+                        return;
+                    }
+                    case EBinaryOp::NullCoalesce: {
+                        CompileInto(Binary.Left, To);
+                        const size_t Skip = EmitJump(EOpCode::JMPNN, To);
+                        CompileInto(Binary.Right, To);
+                        Patch(Skip, Here());
+                        return;
+                    }
+                    case EBinaryOp::Range:
+                    case EBinaryOp::RangeInclusive:
+                        Error(Binary.Location, "Ranges are only supported in for loops");
+                        return;
+                    default:
+                        break;
+                }
+
+                if (IsAssignmentOp(Binary.Op)) {
+                    EmitMove(To, CompileAssignment(Binary));
+                    return;
+                }
+
+                EOpCode Op = EOpCode::ADD;
+                bool Swap = false;
+                BinaryOpCode(Binary.Op, Op, Swap);
+
+                const uint32_t Left = CompileOperand(Binary.Left);
+                if (int32_t Addend = 0; SmallAddend(Op, Unwrap(Binary.Right), Addend)) {
+                    Emit(ABC(EOpCode::ADDI, To, Left, static_cast<uint32_t>(Addend + BiasC)));
+                    return;
+                }
+                const uint32_t Right = CompileOperand(Binary.Right);
+                if (EmitMath(Op, To, Left, Right, StaticType(Binary.Left), StaticType(Binary.Right))) {
+                    return;
+                }
+                Emit(Swap ? ABC(Op, To, Right, Left) : ABC(Op, To, Left, Right));
+            }
+
+            /** Performs an assignment; returns the register that holds the assigned value */
+            uint32_t CompileAssignment(BinaryExpression& Assign) {
+                EOpCode Op = EOpCode::ADD;
+                bool Swap = false;
+                const bool Compound = Assign.Op != EBinaryOp::Assign;
+                BinaryOpCode(Assign.Op, Op, Swap);
+
+                if (auto* Member = Unwrap(Assign.Left)->As<MemberAccess>()) {
+                    if (uint32_t Array = 0, Index = 0; ElementOf(*Member, Array, Index)) {
+                        return CompileFieldAssignment(Assign, Op, *Member, Array, Index);
+                    }
+                }
+
+                const auto* Name = Unwrap(Assign.Left)->As<Identifier>();
+                if (Name == nullptr) {
+                    Error(Assign.Location, "Only variables and fields of array elements can be assigned by the VM yet");
+                    return 0;
+                }
+
+                Local* Found = LocalOf(Assign.Left);
+                const uint32_t Slot = Name->Symbol.Index;
+                if (Found == nullptr && Name->Symbol.Kind != ESymbolKind::Global) {
+                    return 0;                       // Reported by the Resolver
+                }
+                if (Found != nullptr ? Found->IsConst : Unit.ConstGlobals[Slot]) {
+                    Error(Assign.Left->Location, "Cannot assign to Const '" + std::string(Name->Name) + "'");
+                    return 0;
+                }
+
+                // A Shared local counts the new array before dropping the old, which may be the same
+                if (const ERefCount Count = Found != nullptr && !Compound ? CountOf(Slot) : ERefCount::None; IsCounted(Count)) {
+                    const bool Adopted = Adopts(Assign.Right);
+                    const uint32_t Temporary = Allocate();
+                    Owned = Adopted ? Unwrap(Assign.Right) : nullptr;
+                    CompileInto(Assign.Right, Temporary);
+                    Owned = nullptr;
+                    Current = Assign.Location;
+                    if (!Adopted) {
+                        EmitCount(EOpCode::RETAIN, Temporary, Count);
+                    }
+                    EmitCount(EOpCode::RELEASE, Found->Register, Count);
+                    EmitMove(Found->Register, Temporary);
+                    Found->Type = StaticType(Assign.Right);
+                    NextRegister = Temporary;
+                    return Found->Register;
+                }
+
+                // A local is updated in its own register
+                if (Found != nullptr) {
+                    const uint32_t Register = Found->Register;
+                    const EValueType Type = Compound ? Found->Type : StaticType(Assign.Right);
+                    if (!Compound) {
+                        const auto* Binary = Unwrap(Assign.Right)->As<BinaryExpression>();
+                        const bool Branches = Unwrap(Assign.Right)->Is<TernaryExpression>() ||
+                                              (Binary != nullptr && (Binary->Op == EBinaryOp::LogicalAnd ||
+                                                                     Binary->Op == EBinaryOp::LogicalOr ||
+                                                                     Binary->Op == EBinaryOp::NullCoalesce));
+                        if (Branches) {
+                            // These write their target before they are done reading the old value
+                            const uint32_t Temporary = Allocate();
+                            CompileInto(Assign.Right, Temporary);
+                            EmitMove(Register, Temporary);
+                            NextRegister = Temporary;
+                        } else {
+                            CompileInto(Assign.Right, Register);
+                        }
+                    } else if (int32_t Addend = 0; SmallAddend(Op, Unwrap(Assign.Right), Addend)) {
+                        Emit(ABC(EOpCode::ADDI, Register, Register, static_cast<uint32_t>(Addend + BiasC)));
+                    } else {
+                        const uint32_t Mark = NextRegister;
+                        const EValueType RightType = StaticType(Assign.Right);
+                        const uint32_t Right = CompileOperand(Assign.Right);
+                        if (!EmitMath(Op, Register, Register, Right, Type, RightType)) {
+                            Emit(ABC(Op, Register, Register, Right));
+                        }
+                        Found->Type = ResultType(Op, Type, RightType);
+                        NextRegister = Mark;
+                        return Register;
+                    }
+                    Found->Type = Type;
+                    return Register;
+                }
+
+                // A global goes through a temporary, which the caller releases
+                const uint32_t Temporary = Allocate();
+                if (!Compound && Unit.SharedGlobals[Slot]) {
+                    const bool Adopted = Adopts(Assign.Right);
+                    Owned = Adopted ? Unwrap(Assign.Right) : nullptr;
+                    CompileInto(Assign.Right, Temporary);
+                    Owned = nullptr;
+                    Current = Assign.Location;
+                    if (!Adopted) {
+                        EmitCount(EOpCode::RETAIN, Temporary, ERefCount::Atomic);
+                    }
+                    const uint32_t Old = Allocate();
+                    Emit(ABx(EOpCode::GETGLOBAL, Old, Slot));
+                    EmitCount(EOpCode::RELEASE, Old, ERefCount::Atomic);
+                    Emit(ABx(EOpCode::SETGLOBAL, Temporary, Slot));
+                    NextRegister = Old;
+                    return Temporary;
+                }
+                if (Compound) {
+                    Emit(ABx(EOpCode::GETGLOBAL, Temporary, Slot));
+                    const uint32_t Mark = NextRegister;
+                    Emit(ABC(Op, Temporary, Temporary, CompileOperand(Assign.Right)));
+                    NextRegister = Mark;
+                } else {
+                    CompileInto(Assign.Right, Temporary);
+                }
+                Emit(ABx(EOpCode::SETGLOBAL, Temporary, Slot));
+                return Temporary;
+            }
+
+            /** Array[Index].Field = Right, or Array[Index].Field Op= Right; returns the register holding the new value */
+            uint32_t CompileFieldAssignment(BinaryExpression& Assign, const EOpCode Op, MemberAccess& Member, const uint32_t Array,
+                                            const uint32_t Index) {
+                uint32_t Result = 0;
+                if (Assign.Op == EBinaryOp::Assign) {
+                    Result = CompileOperand(Assign.Right);
+                } else {
+                    Result = Allocate();
+                    Current = Member.Location;
+                    EmitField(false, Result, Array, Index, Member);
+                    if (int32_t Addend = 0; SmallAddend(Op, Unwrap(Assign.Right), Addend)) {
+                        Emit(ABC(EOpCode::ADDI, Result, Result, static_cast<uint32_t>(Addend + BiasC)));
+                    } else {
+                        const EValueType Type = StaticType(Assign.Left);
+                        const uint32_t Right = CompileOperand(Assign.Right);
+                        Current = Assign.Location;
+                        if (!EmitMath(Op, Result, Result, Right, Type, StaticType(Assign.Right))) {
+                            Emit(ABC(Op, Result, Result, Right));
+                        }
+                    }
+                }
+
+                Current = Assign.Location;
+                EmitField(true, Result, Array, Index, Member);
+                return Result;
+            }
+
+            void CompileCall(FunctionCall& Call, const uint32_t To) {
+                // A function or native by name, or an accessor or method on an element: All[I].Fetch_Health()
+                const auto* Callee = Unwrap(Call.Callee)->As<Identifier>();
+                const auto* Accessor = Unwrap(Call.Callee)->As<MemberAccess>();
+                IndexAccess* Element = Accessor != nullptr ? Unwrap(Accessor->Object)->As<IndexAccess>() : nullptr;
+                if (Accessor != nullptr && Accessor->Symbol.Kind == ESymbolKind::Interface) {
+                    CompileInterfaceCall(Call, *Accessor, To);
+                    return;
+                }
+                if (Element != nullptr && !Accessor->IsOptional) {
+                    if (Accessor->Symbol.Kind != ESymbolKind::Function) {
+                        return;                     // Reported by the Resolver
+                    }
+                } else if (Callee == nullptr || Callee->Symbol.Kind == ESymbolKind::Local) {
+                    Error(Call.Location, "Only functions can be called by the VM yet");
+                    return;
+                } else if (Callee->Symbol.Kind != ESymbolKind::Function && Callee->Symbol.Kind != ESymbolKind::Native) {
+                    return;                         // Reported by the Resolver
+                }
+
+                const SymbolRef Symbol = Callee != nullptr ? Callee->Symbol : Accessor->Symbol;
+                const std::string_view Name = Callee != nullptr ? Callee->Name : Accessor->Member;
+                const bool IsFunction = Symbol.Kind == ESymbolKind::Function;
+                const int32_t Function = IsFunction ? static_cast<int32_t>(Symbol.Index) : -1;
+                const int32_t Native = IsFunction ? -1 : static_cast<int32_t>(Symbol.Index);
+                const size_t Hidden = Callee != nullptr ? 0 : 2;
+
+                const FunctionDeclaration* Signature = Function >= 0 ? Unit.Signatures[static_cast<size_t>(Function)] : nullptr;
+                const size_t Arity = Function >= 0 ? Unit.Target.Functions[static_cast<size_t>(Function)].ParameterCount
+                                                   : Unit.Target.Natives[static_cast<size_t>(Native)].Arity;
+
+                // Missing trailing arguments take their parameter's literal default
+                size_t Required = Arity;
+                while (Signature != nullptr && Required > Hidden && IsLiteral(Signature->Parameters[Required - Hidden - 1].DefaultValue)) {
+                    --Required;
+                }
+                if (Call.Arguments.size() + Hidden < Required || Call.Arguments.size() + Hidden > Arity) {
+                    Error(Call.Location, "'" + std::string(Name) + "' takes " + std::to_string(Arity - Hidden) +
+                                         " arguments, got " + std::to_string(Call.Arguments.size()));
+                    return;
+                }
+
+                // A math native on arguments of known types runs its kernel in place
+                if (Native >= 0 && Call.Arguments.size() == 2) {
+                    const NativeBinding& Binding = Unit.Target.Natives[static_cast<size_t>(Native)];
+                    const int32_t Math = FindIntrinsicCall(Binding.Name, StaticType(Call.Arguments[0]), StaticType(Call.Arguments[1]));
+                    if (Math >= 0 && Binding.Callback == FindMathNative(Binding.Name)) {
+                        const uint32_t Mark = NextRegister;
+                        const uint32_t Left = CompileOperand(Call.Arguments[0]);
+                        const uint32_t Right = CompileOperand(Call.Arguments[1]);
+                        Current = Call.Location;
+                        Emit(ABC(EOpCode::MATH, To, Left, Right));
+                        Emit(static_cast<Instruction>(Math));
+                        NextRegister = Mark;
+                        return;
+                    }
+                }
+
+                // The hidden arguments of an accessor, then the declared ones, then defaults
+                std::vector<Expression*> Arguments;
+                if (Element != nullptr) {
+                    Arguments = { Element->Object, Element->Index };
+                }
+                Arguments.insert(Arguments.end(), Call.Arguments.begin(), Call.Arguments.end());
+                for (size_t Index = Arguments.size(); Index < Arity; ++Index) {
+                    Arguments.push_back(Signature->Parameters[Index - Hidden].DefaultValue);
+                }
+
+                // A Virtual method runs what the receiver's Define has in its slot
+                const int32_t Slot = Element != nullptr ? Unit.Target.Types[Symbol.Owner].FindSlot(Name) : -1;
+                if (Slot >= 0) {
+                    CompileVirtualCall(Arguments, Symbol.Owner, static_cast<uint32_t>(Slot), To, Call.Location);
+                    return;
+                }
+                if (Function >= 0) {
+                    CompileDirectCall(static_cast<uint32_t>(Function), Arguments, To, Call.Location);
+                    if (HandsCount(Call) && &Call != Owned) {
+                        EmitCount(EOpCode::RELEASE, To, ERefCount::Atomic, true);  // Nothing keeps the result's count
+                    }
+                    return;
+                }
+
+                // Arguments go to the top of the frame, where the callee's frame will start
+                const uint32_t Base = NextRegister;
+                for (Expression* Argument : Arguments) {
+                    CompileInto(Argument, Allocate());
+                }
+
+                Current = Call.Location;
+                Emit(ABC(EOpCode::CALLNATIVE, To, Base, static_cast<uint32_t>(Arity)));
+                Emit(static_cast<Instruction>(Native));
+                NextRegister = Base;
+            }
+
+            /**
+             * Calls a method through the Interface value Method's object holds: CALLIFACE unpacks the element
+             * and runs the function in its table's slot, one load whatever the element's Define
+             */
+            void CompileInterfaceCall(FunctionCall& Call, const MemberAccess& Method, const uint32_t To) {
+                const InterfaceLayout& Used = Unit.Target.Interfaces[Method.Symbol.Index];
+                const uint32_t Slot = Method.Symbol.Owner;
+                const size_t Arity = Used.ParameterCounts[Slot];
+                if (Call.Arguments.size() + 2 != Arity) {
+                    Error(Call.Location, "'" + std::string(Method.Member) + "' takes " + std::to_string(Arity - 2) +
+                                         " arguments, got " + std::to_string(Call.Arguments.size()));
+                    return;
+                }
+
+                const uint32_t Base = NextRegister;
+                CompileInto(Method.Object, Allocate());
+                Allocate();                         // The element's index, which the call unpacks
+                for (Expression* Argument : Call.Arguments) {
+                    CompileInto(Argument, Allocate());
+                }
+                Current = Call.Location;
+                Emit(ABC(EOpCode::CALLIFACE, To, Base, static_cast<uint32_t>(Arity)));
+                Emit(FieldRef(Method.Symbol.Index, Slot));
+                NextRegister = Base;
+            }
+
+            /** Calls Function with Arguments, all of its parameters, as a copy of its body if it can be inlined */
+            void CompileDirectCall(const uint32_t Function, const std::vector<Expression*>& Arguments, const uint32_t To,
+                                   const SourceLocation Location) {
+                if (Inline(Function, Arguments, To, Location)) {
+                    return;
+                }
+
+                const uint32_t Base = NextRegister;
+                for (Expression* Argument : Arguments) {
+                    CompileInto(Argument, Allocate());
+                }
+                Current = Location;
+                Emit(ABC(EOpCode::CALL, To, Base, static_cast<uint32_t>(Arguments.size())));
+                Emit(static_cast<Instruction>(Function));
+                NextRegister = Base;
+            }
+
+            /**
+             * Calls the method in virtual slot Slot of the receiver, Arguments[0], whose Define is Owner or
+             * one extending it
+             *
+             * A receiver that is a local only ever holding an array made by
+             * `new` has one possible method, called (or inlined) outright.
+             * Otherwise the candidates are Owner and every Define compiled
+             * so far that extends it, leaving out those whose method has no
+             * body. If there are at most MaxGuardedTypes, each is tested in
+             * turn with ISTYPE, jumping to a direct call of its method, and
+             * CALLVIRT handles anything else, such as a Define a later unit
+             * adds. More candidates leave the call to CALLVIRT alone.
+             */
+            void CompileVirtualCall(const std::vector<Expression*>& Arguments, const uint32_t Owner, const uint32_t Slot,
+                                    const uint32_t To, const SourceLocation Location) {
+                const Program& Code = Unit.Target;
+                ++Unit.Dispatch.VirtualCalls;
+
+                const Local* Receiver = LocalOf(Arguments[0]);
+                if (Unit.Devirtualizing && Receiver != nullptr && Receiver->Exact >= 0 &&
+                    Code.IsA(static_cast<uint32_t>(Receiver->Exact), Owner)) {
+                    ++Unit.Dispatch.Direct;
+                    CompileDirectCall(Code.Types[static_cast<size_t>(Receiver->Exact)].VTable[Slot], Arguments, To, Location);
+                    return;
+                }
+
+                // The candidate Defines, grouped by the method each would run
+                std::vector<uint32_t> Targets;
+                std::vector<std::vector<uint32_t>> Receivers;
+                size_t Candidates = 0;
+                for (uint32_t Type = 0; Unit.Devirtualizing && Type < Code.Types.size(); ++Type) {
+                    if (!Code.IsA(Type, Owner)) {
+                        continue;
+                    }
+                    const uint32_t Target = Code.Types[Type].VTable[Slot];
+                    if (Unit.Signatures[Target] != nullptr && Unit.Signatures[Target]->Body == nullptr) {
+                        continue;
+                    }
+                    const auto Group = static_cast<size_t>(std::find(Targets.begin(), Targets.end(), Target) - Targets.begin());
+                    if (Group == Targets.size()) {
+                        Targets.push_back(Target);
+                        Receivers.emplace_back();
+                    }
+                    Receivers[Group].push_back(Type);
+                    ++Candidates;
+                }
+
+                const uint32_t Base = NextRegister;
+                for (Expression* Argument : Arguments) {
+                    CompileInto(Argument, Allocate());
+                }
+                const auto Arity = static_cast<uint32_t>(Arguments.size());
+                Current = Location;
+
+                const bool Guarded = Candidates != 0 && Candidates <= MaxGuardedTypes;
+                std::vector<std::vector<size_t>> Entries(Targets.size());
+                for (size_t Group = 0; Guarded && Group < Targets.size(); ++Group) {
+                    for (const uint32_t Type : Receivers[Group]) {
+                        Emit(ABx(EOpCode::ISTYPE, Base, Type));
+                        Entries[Group].push_back(EmitJump(EOpCode::JMP));
+                    }
+                }
+                Emit(ABC(EOpCode::CALLVIRT, To, Base, Arity));
+                Emit(FieldRef(Owner, Slot));
+                if (!Guarded) {
+                    ++Unit.Dispatch.Dynamic;
+                    NextRegister = Base;
+                    return;
+                }
+
+                ++Unit.Dispatch.Guarded;
+                std::vector<size_t> Ends{ EmitJump(EOpCode::JMP) };
+                for (size_t Group = 0; Group < Targets.size(); ++Group) {
+                    for (const size_t Entry : Entries[Group]) {
+                        Patch(Entry, Here());
+                    }
+                    if (!InlineOn(Targets[Group], Base, Arity, To, Location)) {
+                        Current = Location;
+                        Emit(ABC(EOpCode::CALL, To, Base, Arity));
+                        Emit(static_cast<Instruction>(Targets[Group]));
+                    }
+                    if (Group + 1 < Targets.size()) {
+                        Ends.push_back(EmitJump(EOpCode::JMP));
+                    }
+                }
+                for (const size_t End : Ends) {
+                    Patch(End, Here());
+                }
+                NextRegister = Base;
+            }
+
+            /** Everything Restore() puts back when a copy of a body does not compile */
+            struct Checkpoint {
+                size_t Errors;
+                size_t Code;
+                size_t Switches;
+                uint32_t Highest;
+                bool OutOfRegisters;
+                size_t InlinedCalls;
+                DispatchReport Dispatch;
+            };
+
+            [[nodiscard]] Checkpoint Save() const {
+                return { Unit.Errors.size(), Here(), Unit.Target.Switches.size(), Highest, OutOfRegisters, Unit.InlinedCalls,
+                         Unit.Dispatch };
+            }
+
+            void Restore(const Checkpoint& Saved) {
+                Unit.Errors.erase(Unit.Errors.begin() + static_cast<std::ptrdiff_t>(Saved.Errors), Unit.Errors.end());
+                Output.Code.resize(Saved.Code);
+                Output.Locations.resize(Saved.Code);
+                Unit.Target.Switches.erase(Unit.Target.Switches.begin() + static_cast<std::ptrdiff_t>(Saved.Switches),
+                                           Unit.Target.Switches.end());
+                Highest = Saved.Highest;
+                OutOfRegisters = Saved.OutOfRegisters;
+                Unit.InlinedCalls = Saved.InlinedCalls;
+                Unit.Dispatch = Saved.Dispatch;
+            }
+
+            /** How to inline Function, if the Compiler chose it and it is not already being expanded here; else null */
+            [[nodiscard]] const Inlinable* Expandable(const uint32_t Function) const {
+                if (Unit.Inlines == nullptr || Function == Building || Expansions.size() >= MaxInlineDepth ||
+                    std::any_of(Expansions.begin(), Expansions.end(), [&](const Expansion& Open) { return Open.Function == Function; })) {
+                    return nullptr;
+                }
+                const Inlinable& Callee = (*Unit.Inlines)[Function];
+                return Callee.Declaration != nullptr ? &Callee : nullptr;
+            }
+
+            /** Declared type of the callee's parameter in Slot, the hidden ones included */
+            static EValueType ParameterType(const Inlinable& Callee, const size_t Slot) {
+                return Slot >= Callee.Hidden ? TypeFromRef(Callee.Declaration->Parameters[Slot - Callee.Hidden].Type)
+                       : Slot == 0           ? EValueType::Array
+                                             : EValueType::Int;
+            }
+
+            /**
+             * Compiles a call as a copy of the callee's body, if it is Expandable
+             *
+             * An argument that is a local of the caller is read in place when
+             * the callee never assigns that parameter and no later argument
+             * assigns that local; the others are evaluated into fresh
+             * registers, as for CALL. If the copy does
+             * not compile, everything it emitted is dropped and false
+             * returned, so the call is made normally and its errors are
+             * reported once, with the callee.
+             */
+            bool Inline(const uint32_t Function, const std::vector<Expression*>& Arguments, const uint32_t To,
+                        const SourceLocation Location) {
+                const Inlinable* Callee = Expandable(Function);
+                if (Callee == nullptr) {
+                    return false;
+                }
+
+                // Registers of the caller's locals that each argument, or one after it, assigns
+                std::vector<std::vector<uint32_t>> WrittenFrom(Arguments.size() + 1);
+                for (size_t Slot = Arguments.size(); Slot-- > 0;) {
+                    LocalWrites Writes;
+                    Writes.Visit(Arguments[Slot]);
+                    WrittenFrom[Slot] = WrittenFrom[Slot + 1];
+                    for (const uint32_t Written : Writes.Slots) {
+                        WrittenFrom[Slot].push_back(Slots[Written].Register);
+                    }
+                }
+
+                const Checkpoint Saved = Save();
+                const uint32_t Base = NextRegister;
+                std::vector<Local> Parameters(Callee->SlotCount);
+                for (size_t Slot = 0; Slot < Arguments.size(); ++Slot) {
+                    const EValueType Declared = ParameterType(*Callee, Slot);
+                    const EValueType Type = Declared != EValueType::Null ? Declared : StaticType(Arguments[Slot]);
+                    const Local* Shared = Callee->Assigned[Slot] ? nullptr : LocalOf(Arguments[Slot]);
+                    const std::vector<uint32_t>& Later = WrittenFrom[Slot + 1];
+                    if (Shared != nullptr && Shared->Register != To &&
+                        std::find(Later.begin(), Later.end(), Shared->Register) == Later.end()) {
+                        Parameters[Slot] = { Shared->Register, Slot < Callee->Hidden, Type, Shared->Exact };
+                        continue;
+                    }
+                    const uint32_t Register = Allocate();
+                    CompileInto(Arguments[Slot], Register);
+                    Parameters[Slot] = { Register, Slot < Callee->Hidden, Type, -1 };
+                }
+
+                const bool Expanded = Expand(*Callee, Function, Parameters, To, Location, Saved);
+                NextRegister = Base;
+                return Expanded;
+            }
+
+            /** Inlines Function on arguments already in the Arity registers from Base, if it is Expandable */
+            bool InlineOn(const uint32_t Function, const uint32_t Base, const uint32_t Arity, const uint32_t To,
+                          const SourceLocation Location) {
+                const Inlinable* Callee = Expandable(Function);
+                if (Callee == nullptr) {
+                    return false;
+                }
+                std::vector<Local> Parameters(Callee->SlotCount);
+                for (uint32_t Slot = 0; Slot < Arity; ++Slot) {
+                    Parameters[Slot] = { Base + Slot, Slot < Callee->Hidden, ParameterType(*Callee, Slot), -1 };
+                }
+                return Expand(*Callee, Function, Parameters, To, Location, Save());
+            }
+
+            /**
+             * Compiles Callee's body in place, on Parameters as its slots
+             *
+             * The body runs on the callee's own namespace, and a return
+             * stores into To and jumps past the rest. On an error everything
+             * since Saved is dropped and false returned.
+             */
+            bool Expand(const Inlinable& Callee, const uint32_t Function, std::vector<Local>& Parameters, const uint32_t To,
+                        const SourceLocation Location, const Checkpoint& Saved) {
+                const uint32_t Mark = NextRegister;
+                std::swap(Slots, Parameters);
+                const std::vector<bool>* CallerAssigned = std::exchange(Assigned, &Callee.Assigned);
+                std::vector<Loop> Outer;
+                std::swap(Loops, Outer);
+                const ScopeId Caller = Namespace;
+                Namespace = Callee.Scope;
+                Expansions.push_back({ Function, To, {} });
+
+                // A return at the end of the body needs no jump
+                const ArenaArray<Statement*>& Body = Callee.Declaration->Body->Statements;
+                auto* Last = !Body.empty() && Body[Body.size() - 1] != nullptr ? Body[Body.size() - 1]->As<ReturnStatement>() : nullptr;
+                for (Statement* Stmt : Body) {
+                    if (Stmt != nullptr && Stmt != Last) {
+                        CompileStatement(*Stmt);
+                    }
+                }
+                if (Last != nullptr && Last->Value != nullptr) {
+                    Current = Last->Location;
+                    CompileInto(Last->Value, To);
+                } else if (Last != nullptr || !IsVoid(Callee.Declaration->ReturnType)) {
+                    Current = Location;
+                    Emit(ABC(EOpCode::LOADNULL, To, 0, 0));
+                }
+                for (const size_t Exit : Expansions.back().Exits) {
+                    Patch(Exit, Here());
+                }
+
+                Expansions.pop_back();
+                Namespace = Caller;
+                std::swap(Loops, Outer);
+                Assigned = CallerAssigned;
+                std::swap(Slots, Parameters);
+                NextRegister = Mark;
+
+                if (Unit.Errors.size() != Saved.Errors) {
+                    Restore(Saved);
+                    return false;
+                }
+                ++Unit.InlinedCalls;
+                return true;
+            }
+
+            // ---- Statements ----
+
+            void CompileBlock(BlockStatement& Block) {
+                const uint32_t Mark = NextRegister;
+                const size_t Holding = Held.size();
+
+                for (Statement* Stmt : Block.Statements) {
+                    if (Stmt != nullptr) {
+                        CompileStatement(*Stmt);
+                    }
+                }
+
+                CloseScope(Holding);
+                NextRegister = Mark;
+            }
+
+            /** Compiles Body as its own scope, even when it is a single statement */
+            void CompileScoped(Statement& Body) {
+                const uint32_t Mark = NextRegister;
+                const size_t Holding = Held.size();
+                CompileStatement(Body);
+                CloseScope(Holding);
+                NextRegister = Mark;
+            }
+
+            /** Drops the counts of the Shared locals a scope declared */
+            void CloseScope(const size_t Holding) {
+                ReleaseHeld(Holding);
+                Held.erase(Held.begin() + static_cast<std::ptrdiff_t>(Holding), Held.end());
+            }
+
+            void CompileStatement(Statement& Stmt) {
+                Current = Stmt.Location;
+                const uint32_t Mark = NextRegister;
+
+                switch (Stmt.Kind) {
+                    case ENodeKind::VariableDeclaration: {
+                        auto& Variable = static_cast<VariableDeclaration&>(Stmt);
+                        const uint32_t Register = Allocate();
+                        const ERefCount Count = CountOf(Variable.Symbol.Index);
+                        const bool Adopted = IsCounted(Count) && Variable.Initializer != nullptr && Adopts(Variable.Initializer);
+                        if (Variable.Initializer != nullptr) {
+                            Owned = Adopted ? Unwrap(Variable.Initializer) : nullptr;
+                            CompileInto(Variable.Initializer, Register);
+                            Owned = nullptr;
+                        } else {
+                            Emit(ABC(EOpCode::LOADNULL, Register, 0, 0));
+                        }
+                        const EValueType Type = Variable.Type != nullptr ? TypeFromRef(Variable.Type)
+                                                : Variable.Initializer != nullptr ? StaticType(Variable.Initializer)
+                                                                                  : EValueType::Null;
+                        const auto* Made = Variable.Initializer != nullptr ? Unwrap(Variable.Initializer)->As<NewExpression>()
+                                                                           : nullptr;
+                        const bool Kept = Made != nullptr && Assigned != nullptr && !(*Assigned)[Variable.Symbol.Index];
+                        Slots[Variable.Symbol.Index] = { Register, Variable.IsConst, Type, Kept ? LayoutOf(Made->Type) : -1 };
+                        if (IsCounted(Count)) {
+                            if (Variable.Initializer != nullptr && !Adopted) {
+                                EmitCount(EOpCode::RETAIN, Register, Count);
+                            }
+                            Held.push_back({ Register, Variable.Symbol.Index, Count });
+                        }
+                        return;                     // Keeps its register until the block ends
+                    }
+
+                    case ENodeKind::ExpressionStatement: {
+                        Expression* Expr = Unwrap(static_cast<ExpressionStatement&>(Stmt).Expr);
+                        const auto* Binary = Expr->As<BinaryExpression>();
+                        if (Binary != nullptr && IsAssignmentOp(Binary->Op)) {
+                            CompileAssignment(*Expr->As<BinaryExpression>());
+                        } else {
+                            CompileInto(Expr, Allocate());
+                        }
+                        break;
+                    }
+
+                    case ENodeKind::BlockStatement:
+                        CompileBlock(static_cast<BlockStatement&>(Stmt));
+                        break;
+
+                    case ENodeKind::IfStatement: {
+                        auto& If = static_cast<IfStatement&>(Stmt);
+                        const size_t ToElse = EmitJump(EOpCode::JMPIFNOT, CompileOperand(If.Condition));
+                        NextRegister = Mark;
+                        CompileScoped(*If.ThenBranch);
+                        if (If.ElseBranch != nullptr) {
+                            const size_t ToEnd = EmitJump(EOpCode::JMP);
+                            Patch(ToElse, Here());
+                            CompileScoped(*If.ElseBranch);
+                            Patch(ToEnd, Here());
+                        } else {
+                            Patch(ToElse, Here());
+                        }
+                        break;
+                    }
+
+                    case ENodeKind::WhileStatement: {
+                        auto& While = static_cast<WhileStatement&>(Stmt);
+                        const size_t Start = Here();
+                        const size_t ToEnd = EmitJump(EOpCode::JMPIFNOT, CompileOperand(While.Condition));
+                        NextRegister = Mark;
+
+                        Loops.push_back({ {}, {}, Held.size() });
+                        CompileScoped(*While.Body);
+                        Current = While.Location;
+                        EmitJumpTo(EOpCode::JMP, 0, Start);
+                        Patch(ToEnd, Here());
+                        CloseLoop(Start, Here());
+                        break;
+                    }
+
+                    case ENodeKind::DoWhileStatement: {
+                        auto& DoWhile = static_cast<DoWhileStatement&>(Stmt);
+                        const size_t Start = Here();
+
+                        Loops.push_back({ {}, {}, Held.size() });
+                        CompileScoped(*DoWhile.Body);
+                        const size_t Condition = Here();
+                        EmitJumpTo(EOpCode::JMPIF, CompileOperand(DoWhile.Condition), Start);
+                        NextRegister = Mark;
+                        CloseLoop(Condition, Here());
+                        break;
+                    }
+
+                    case ENodeKind::ForStatement:
+                        CompileFor(static_cast<ForStatement&>(Stmt));
+                        break;
+
+                    case ENodeKind::ReturnStatement: {
+                        Expression* Result = static_cast<ReturnStatement&>(Stmt).Value;
+                        if (!Expansions.empty()) {
+                            // In an inlined body: the value goes to the call's target, then past the copy
+                            const uint32_t Target = Expansions.back().Result;
+                            if (Result != nullptr) {
+                                CompileInto(Result, Target);
+                            } else {
+                                Emit(ABC(EOpCode::LOADNULL, Target, 0, 0));
+                            }
+                            Expansions.back().Exits.push_back(EmitJump(EOpCode::JMP));
+                            break;
+                        }
+                        if (Result == nullptr) {
+                            ReleaseHeld(0);
+                            Emit(ABC(EOpCode::RETURN, 0, 0, 0));
+                            break;
+                        }
+
+                        // A function returning Shared hands its caller a count: a local's own, or a new one
+                        const bool Hands = Unit.Ownership != nullptr && Unit.Ownership->ReturnsShared(Building);
+                        const auto* Name = Unwrap(Result)->As<Identifier>();
+                        const auto Moved = std::find_if(Held.begin(), Held.end(), [&](const Holder& Holding) {
+                            return Name != nullptr && Name->Symbol.Kind == ESymbolKind::Local && Holding.Slot == Name->Symbol.Index;
+                        });
+                        uint32_t Value = 0;
+                        uint32_t Kept = UINT32_MAX;
+                        if (Hands && Moved != Held.end() && Unit.Ownership->IsEliding()) {
+                            Value = Moved->Register;
+                            Kept = Moved->Slot;
+                        } else if (Hands && Adopts(Result)) {
+                            Owned = Unwrap(Result);
+                            Value = CompileOperand(Result);
+                            Owned = nullptr;
+                        } else {
+                            Value = CompileOperand(Result);
+                            if (Hands) {
+                                EmitCount(EOpCode::RETAIN, Value, ERefCount::Atomic);
+                            }
+                        }
+                        ReleaseHeld(0, Kept);
+                        Emit(ABC(EOpCode::RETURN, Value, 1, 0));
+                        break;
+                    }
+
+                    case ENodeKind::BreakStatement:
+                    case ENodeKind::ContinueStatement:
+                        if (Loops.empty()) {
+                            Error(Stmt.Location, Stmt.Is<BreakStatement>() ? "break outside a loop" : "continue outside a loop");
+                            break;
+                        }
+                        ReleaseHeld(Loops.back().Holding);
+                        (Stmt.Is<BreakStatement>() ? Loops.back().Breaks : Loops.back().Continues).push_back(EmitJump(EOpCode::JMP));
+                        break;
+
+                    case ENodeKind::MatchStatement:
+                        CompileMatch(static_cast<MatchStatement&>(Stmt));
+                        break;
+
+                    default:
+                        Error(Stmt.Location, NodeKindToString(Stmt.Kind) + " is not supported by the VM yet");
+                        break;
+                }
+
+                NextRegister = Mark;
+            }
+
+            void CloseLoop(const size_t Continue, const size_t Break) {
+                const Loop Done = std::move(Loops.back());
+                Loops.pop_back();
+                for (const size_t Jump : Done.Continues) {
+                    Patch(Jump, Continue);
+                }
+                for (const size_t Jump : Done.Breaks) {
+                    Patch(Jump, Break);
+                }
+            }
+
+            /**
+             * R[Base] counts, R[Base + 1] is the limit, R[Base + 2] the step and
+             * R[Base + 3] the iterator the body sees
+             */
+            void CompileFor(ForStatement& For) {
+                const uint32_t Base = Allocate();
+                Allocate();
+                Allocate();
+                const uint32_t Iterator = Allocate();
+
+                CompileInto(For.RangeStart, Base);
+                CompileInto(For.RangeEnd, Base + 1);
+                if (For.Step != nullptr) {
+                    CompileInto(For.Step, Base + 2);
+                } else {
+                    Current = For.Location;
+                    Emit(AsBx(EOpCode::LOADI, Base + 2, 1));
+                }
+
+                Current = For.Location;
+                const size_t Prepare = EmitJump(For.IsInclusive ? EOpCode::FORPREPI : EOpCode::FORPREP, Base);
+                const size_t Body = Here();
+
+                Loops.push_back({ {}, {}, Held.size() });
+                Slots[For.Symbol.Index] = { Iterator, false, EValueType::Null, -1 };
+                CompileScoped(*For.Body);
+
+                Current = For.Location;
+                const size_t Step = Here();
+                EmitJumpTo(For.IsInclusive ? EOpCode::FORLOOPI : EOpCode::FORLOOP, Base, Body);
+                Patch(Prepare, Here());
+                CloseLoop(Step, Here());
+            }
+
+            /**
+             * One SWITCH when the cases allow a table (see PlanSwitch), else a
+             * chain of EQ tests tried in case order
+             */
+            void CompileMatch(MatchStatement& Match) {
+                const uint32_t Subject = CompileOperand(Match.Value);
+                if (SwitchTable Table; Unit.Target.Switches.size() <= MaxSwitches && PlanSwitch(Unit.Target, Match, Table)) {
+                    CompileSwitch(Match, Subject, std::move(Table));
+                    return;
+                }
+
+                std::vector<size_t> ToEnd;
+
+                for (const MatchCase& Case : Match.Cases) {
+                    if (IsWildcard(Case.Pattern)) {
+                        CompileScoped(*Case.Body);
+                        ToEnd.push_back(EmitJump(EOpCode::JMP));
+                        continue;
+                    }
+
+                    const uint32_t Mark = NextRegister;
+                    const uint32_t Pattern = CompileOperand(Case.Pattern);
+                    const uint32_t Test = Allocate();
+                    Current = Case.Pattern->Location;
+                    Emit(ABC(EOpCode::EQ, Test, Subject, Pattern));
+                    const size_t ToNext = EmitJump(EOpCode::JMPIFNOT, Test);
+                    NextRegister = Mark;
+
+                    CompileScoped(*Case.Body);
+                    ToEnd.push_back(EmitJump(EOpCode::JMP));
+                    Patch(ToNext, Here());
+                }
+
+                for (const size_t Jump : ToEnd) {
+                    Patch(Jump, Here());
+                }
+            }
+
+            /** The bodies follow the SWITCH in case order; the first wildcard's is the default */
+            void CompileSwitch(MatchStatement& Match, const uint32_t Subject, SwitchTable Table) {
+                const auto Index = static_cast<uint32_t>(Unit.Target.Switches.size());
+                Unit.Target.Switches.emplace_back();    // Matches nested in the bodies add theirs after it
+                Current = Match.Location;
+                const size_t Switch = Emit(ABx(EOpCode::SWITCH, Subject, Index));
+
+                std::vector<int32_t> Offsets;
+                std::vector<size_t> ToEnd;
+                int32_t Default = -1;
+                for (const MatchCase& Case : Match.Cases) {
+                    Offsets.push_back(static_cast<int32_t>(Here() - (Switch + 1)));
+                    if (Default < 0 && IsWildcard(Case.Pattern)) {
+                        Default = Offsets.back();
+                    }
+                    CompileScoped(*Case.Body);
+                    ToEnd.push_back(EmitJump(EOpCode::JMP));
+                }
+
+                for (const size_t Jump : ToEnd) {
+                    Patch(Jump, Here());
+                }
+                if (Default < 0) {
+                    Default = static_cast<int32_t>(Here() - (Switch + 1));
+                }
+
+                for (std::vector<int32_t>* Targets : { &Table.Targets, &Table.Dense, &Table.KeyTargets }) {
+                    for (int32_t& Target : *Targets) {
+                        Target = Target >= 0 ? Offsets[static_cast<size_t>(Target)] : Default;
+                    }
+                }
+                Table.Default = Default;
+                Unit.Target.Switches[Index] = std::move(Table);
+            }
+        };
+    }
+
+    Compiler::Compiler(Program& Target, const unsigned Threads) : Target(Target), Threads(WorkerCount(Threads)) {}
+
+    std::string Compiler::QualifiedName(const ScopeId Scope, const std::string_view Name) const {
+        return Scope == SymbolTable::GlobalScope ? std::string(Name) : Symbols.QualifiedName(Scope) + "::" + std::string(Name);
+    }
+
+    int32_t Compiler::DeclareType(const DefineDeclaration& Define, const ScopeId Scope) {
+        const std::string Name = QualifiedName(Scope, Define.Name);
+        if (Symbols.FindIn(Scope, Symbols.Intern(Define.Name)) != nullptr || Target.FindType(Name) >= 0) {
+            Errors.push_back({ "Type '" + Name + "' is already defined", Define.Location });
+            return -1;
+        }
+        if (Target.Types.size() > MaxTypes) {
+            Errors.push_back({ "More than 65536 Define types", Define.Location });
+            return -1;
+        }
+
+        const uint32_t Index = Target.AddType(Name);
+        Symbols.Declare(Scope, Symbols.Intern(Define.Name), { ESymbolKind::Type, Index, 0 });
+        return static_cast<int32_t>(Index);
+    }
+
+    int32_t Compiler::FindBase(const DefineDeclaration& Define, const ScopeId Scope) {
+        int32_t Base = -1;
+        for (const TypeRef* Named : Define.BaseTypes) {
+            const SymbolRef* Found = Named != nullptr && !Named->IsArray && !Named->IsPointer
+                                         ? Symbols.LookupPath(Scope, Named->Name, false)
+                                         : nullptr;
+            if (Found == nullptr || Found->Kind != ESymbolKind::Type) {
+                continue;                           // Interfaces need no layout
+            }
+            if (Base >= 0) {
+                Errors.push_back({ "'" + std::string(Define.Name) + "' can extend only one Define", Define.Location });
+                break;
+            }
+            Base = static_cast<int32_t>(Found->Index);
+        }
+        return Base;
+    }
+
+    void Compiler::AddLayout(const DefineDeclaration& Define, const uint32_t Index, const int32_t Base) {
+        TypeLayout& Layout = Target.Types[Index];
+        Layout.IsSoA = std::find(Define.Attributes.begin(), Define.Attributes.end(), "SoA") != Define.Attributes.end();
+
+        // A base's fields keep their indices, so its code reads ours
+        if (Base >= 0) {
+            const TypeLayout& Extended = Target.Types[static_cast<size_t>(Base)];
+            Layout.Base = Base;
+            Layout.Lineage = Extended.Lineage;
+            Layout.Lineage.push_back(Index);
+            for (const FieldLayout& Field : Extended.Fields) {
+                FieldLayout& Added = Layout.AddField(Field.Name);
+                Added.Type = Field.Type;
+                Added.Default = Field.Default;
+            }
+        }
+
+        for (const FieldDeclaration* Field : Define.Fields) {
+            if (Field == nullptr || Field->IsStatic) {
+                continue;                           // Static fields are not stored per element
+            }
+            if (Layout.FindField(Field->Name) >= 0 || Layout.Fields.size() > MaxFields) {
+                Errors.push_back({ Layout.FindField(Field->Name) >= 0
+                                       ? "Field '" + std::string(Field->Name) + "' of " + Layout.Name + " is already defined"
+                                       : Layout.Name + " has more than 65536 fields",
+                                   Field->Location });
+                continue;
+            }
+
+            FieldLayout& Added = Layout.AddField(Field->Name);
+            Added.Type = TypeFromRef(Field->Type);
+            Added.Default = ZeroOf(Added.Type);
+            if (Field->Initializer != nullptr && !LiteralValue(Target, Field->Initializer, Added.Default)) {
+                Errors.push_back({ "The default of " + Layout.Name + "." + Added.Name + " must be a literal", Field->Location });
+            }
+        }
+    }
+
+    int32_t Compiler::DeclareInterface(const InterfaceDeclaration& Interface, const ScopeId Scope) {
+        const std::string Name = QualifiedName(Scope, Interface.Name);
+        if (Symbols.FindIn(Scope, Symbols.Intern(Interface.Name)) != nullptr || Target.FindInterface(Name) >= 0) {
+            Errors.push_back({ "Interface '" + Name + "' is already defined", Interface.Location });
+            return -1;
+        }
+        if (Target.Interfaces.size() > MaxTypes) {
+            Errors.push_back({ "More than 65536 Interfaces", Interface.Location });
+            return -1;
+        }
+
+        const uint32_t Index = Target.AddInterface(Name);
+        Symbols.Declare(Scope, Symbols.Intern(Interface.Name), { ESymbolKind::Interface, Index, 0 });
+        return static_cast<int32_t>(Index);
+    }
+
+    std::vector<uint32_t> Compiler::FindExtended(const InterfaceDeclaration& Interface, const ScopeId Scope) {
+        std::vector<uint32_t> Bases;
+        for (const TypeRef* Named : Interface.BaseInterfaces) {
+            const SymbolRef* Found = Named != nullptr && !Named->IsArray && !Named->IsPointer
+                                         ? Symbols.LookupPath(Scope, Named->Name, false)
+                                         : nullptr;
+            if (Found == nullptr || Found->Kind != ESymbolKind::Interface) {
+                Errors.push_back({ "'" + std::string(Interface.Name) + "' can only extend Interfaces", Interface.Location });
+                continue;
+            }
+            Bases.push_back(Found->Index);
+        }
+        return Bases;
+    }
+
+    void Compiler::AddInterfaceMethods(const InterfaceDeclaration& Interface, const uint32_t Index,
+                                       const std::vector<uint32_t>& Bases) {
+        InterfaceLayout& Layout = Target.Interfaces[Index];
+        const auto Extend = [&](const uint32_t Base) {
+            if (std::find(Layout.Extends.begin(), Layout.Extends.end(), Base) == Layout.Extends.end()) {
+                Layout.Extends.push_back(Base);
+            }
+        };
+
+        for (const uint32_t Base : Bases) {
+            const InterfaceLayout& Extended = Target.Interfaces[Base];
+            Extend(Base);
+            for (const uint32_t Inherited : Extended.Extends) {
+                Extend(Inherited);
+            }
+            for (size_t Slot = 0; Slot < Extended.Methods.size(); ++Slot) {
+                const int32_t Same = Layout.FindMethod(Extended.Methods[Slot]);
+                if (Same < 0) {
+                    Layout.Methods.push_back(Extended.Methods[Slot]);
+                    Layout.ParameterCounts.push_back(Extended.ParameterCounts[Slot]);
+                } else if (Layout.ParameterCounts[static_cast<size_t>(Same)] != Extended.ParameterCounts[Slot]) {
+                    Errors.push_back({ "'" + Layout.Name + "' extends two methods '" + Extended.Methods[Slot] +
+                                           "' with different parameters",
+                                       Interface.Location });
+                }
+            }
+        }
+
+        for (const FunctionDeclaration* Method : Interface.Methods) {
+            if (Method == nullptr) {
+                continue;
+            }
+            if (Layout.FindMethod(Method->Name) >= 0 || Method->Parameters.size() + 2 >= MaxRegisters) {
+                Errors.push_back({ Layout.FindMethod(Method->Name) >= 0
+                                       ? "Method '" + std::string(Method->Name) + "' of " + Layout.Name + " is already defined"
+                                       : "Too many parameters",
+                                   Method->Location });
+                continue;
+            }
+            Layout.Methods.emplace_back(Method->Name);
+            Layout.ParameterCounts.push_back(static_cast<uint8_t>(Method->Parameters.size() + 2));
+        }
+    }
+
+    std::vector<uint32_t> Compiler::FindImplemented(const DefineDeclaration& Define, const ScopeId Scope, const int32_t Base) {
+        std::vector<uint32_t> Implements;
+        const auto Add = [&](const uint32_t Interface) {
+            if (std::find(Implements.begin(), Implements.end(), Interface) == Implements.end()) {
+                Implements.push_back(Interface);
+            }
+        };
+
+        if (Base >= 0) {
+            for (const auto& [Interface, Table] : Target.Types[static_cast<size_t>(Base)].ITables) {
+                Add(Interface);
+            }
+        }
+        for (const TypeRef* Named : Define.BaseTypes) {
+            const SymbolRef* Found = Named != nullptr && !Named->IsArray && !Named->IsPointer
+                                         ? Symbols.LookupPath(Scope, Named->Name, false)
+                                         : nullptr;
+            if (Found != nullptr && Found->Kind == ESymbolKind::Interface) {
+                Add(Found->Index);
+                for (const uint32_t Extended : Target.Interfaces[Found->Index].Extends) {
+                    Add(Extended);
+                }
+            } else if (Found == nullptr || Found->Kind != ESymbolKind::Type) {
+                Errors.push_back({ "'" + (Named != nullptr ? Named->ToString() : std::string()) + "' is not a Define or an Interface",
+                                   Define.Location });
+            }
+        }
+        return Implements;
+    }
+
+    void Compiler::AddITables(const DefineDeclaration& Define, const uint32_t Index, const std::vector<uint32_t>& Implements) {
+        TypeLayout& Layout = Target.Types[Index];
+        for (const uint32_t Interface : Implements) {
+            const InterfaceLayout& Used = Target.Interfaces[Interface];
+            const auto Table = static_cast<uint32_t>(Target.ITables.size());
+            Target.ITables.push_back(Interface);
+
+            bool Complete = true;
+            for (size_t Slot = 0; Slot < Used.Methods.size(); ++Slot) {
+                const int32_t Function = Layout.FindMethod(Used.Methods[Slot]);
+                if (Function < 0) {
+                    Errors.push_back({ "'" + Layout.Name + "' does not implement '" + Used.Name + "." + Used.Methods[Slot] + "'",
+                                       Define.Location });
+                    Complete = false;
+                    continue;
+                }
+                if (Target.Functions[static_cast<size_t>(Function)].ParameterCount != Used.ParameterCounts[Slot]) {
+                    Errors.push_back({ "'" + Target.Functions[static_cast<size_t>(Function)].Name + "' must take the parameters of '" +
+                                           Used.Name + "." + Used.Methods[Slot] + "'",
+                                       Define.Location });
+                    Complete = false;
+                    continue;
+                }
+                Target.ITables.push_back(static_cast<uint32_t>(Function));
+            }
+
+            if (!Complete) {
+                Target.ITables.resize(Table);
+                continue;
+            }
+            Layout.ITables.emplace_back(Interface, Table);
+        }
+    }
+
+    bool Compiler::Compile(TranslationUnit* Unit) {
+        const size_t ErrorsBefore = Errors.size();
+        if (Unit == nullptr) {
+            return true;
+        }
+
+        struct Collected {
+            ASTNode* Node;                          // FunctionDeclaration or a global's VariableDeclaration
+            uint32_t Index;                         // Function index or global slot
+            ScopeId Scope;
+            int32_t Owner = -1;                     // Define an accessor or method belongs to
+            std::string_view Self;                  // What the accessor names its element
+        };
+        struct DeclaredType {
+            const DefineDeclaration* Node;
+            ScopeId Scope;
+            uint32_t Index;
+            int32_t Base = -1;
+        };
+        struct DeclaredInterface {
+            const InterfaceDeclaration* Node;
+            ScopeId Scope;
+            uint32_t Index;
+            std::vector<uint32_t> Bases;
+        };
+        std::vector<Collected> Functions;
+        std::vector<Collected> Globals;
+        std::vector<DeclaredType> Defines;
+        std::vector<DeclaredInterface> Interfaces;
+        std::vector<std::pair<const UsingDeclaration*, ScopeId>> Usings;
+        std::vector<std::pair<Declaration*, ScopeId>> Accessors;
+
+        // Natives are global names, hidden by anything declared nearer the code that calls them
+        for (; DeclaredNatives < Target.Natives.size(); ++DeclaredNatives) {
+            Symbols.Declare(SymbolTable::GlobalScope, Symbols.Intern(Target.Natives[DeclaredNatives].Name),
+                            { ESymbolKind::Native, static_cast<uint32_t>(DeclaredNatives), 0 });
+        }
+
+        std::vector<std::pair<Declaration*, ScopeId>> Pending;
+        for (size_t Index = Unit->Declarations.size(); Index-- > 0;) {
+            Pending.emplace_back(Unit->Declarations[Index], SymbolTable::GlobalScope);
+        }
+
+        while (!Pending.empty()) {
+            const auto [Decl, Scope] = Pending.back();
+            Pending.pop_back();
+            if (Decl == nullptr) {
+                continue;
+            }
+
+            switch (Decl->Kind) {
+                case ENodeKind::FunctionDeclaration: {
+                    auto* Function = static_cast<FunctionDeclaration*>(Decl);
+                    const SymbolId Name = Symbols.Intern(Function->Name);
+                    if (Symbols.FindIn(Scope, Name) != nullptr) {
+                        Errors.push_back({ "'" + QualifiedName(Scope, Function->Name) + "' is already defined", Decl->Location });
+                        break;
+                    }
+                    if (Function->Parameters.size() >= MaxRegisters) {
+                        Errors.push_back({ "Too many parameters", Decl->Location });
+                        break;
+                    }
+
+                    const uint32_t Index = Target.AddFunction(QualifiedName(Scope, Function->Name));
+                    Symbols.Declare(Scope, Name, { ESymbolKind::Function, Index, 0 });
+                    Target.Functions[Index].ParameterCount = static_cast<uint8_t>(Function->Parameters.size());
+                    Signatures.resize(Target.Functions.size(), nullptr);
+                    Signatures[Index] = Function;
+                    Functions.push_back({ Function, Index, Scope, -1, {} });
+                    break;
+                }
+                case ENodeKind::NamespaceDeclaration: {
+                    const auto* Namespace = static_cast<NamespaceDeclaration*>(Decl);
+                    const ScopeId Inner = Symbols.OpenNamespace(Scope, Namespace->Name);
+                    if (Inner == SymbolTable::NoScope) {
+                        Errors.push_back({ "'" + std::string(Namespace->Name) + "' is already defined as something else",
+                                           Decl->Location });
+                        break;
+                    }
+                    for (size_t Index = Namespace->Declarations.size(); Index-- > 0;) {
+                        Pending.emplace_back(Namespace->Declarations[Index], Inner);
+                    }
+                    break;
+                }
+                case ENodeKind::UsingDeclaration:
+                    Usings.emplace_back(static_cast<UsingDeclaration*>(Decl), Scope);
+                    break;
+                case ENodeKind::GlobalDeclaration: {
+                    VariableDeclaration* Variable = static_cast<GlobalDeclaration*>(Decl)->Variable;
+                    if (Variable == nullptr) {
+                        break;
+                    }
+                    const SymbolId Name = Symbols.Intern(Variable->Name);
+                    if (Symbols.FindIn(Scope, Name) != nullptr) {
+                        Errors.push_back({ "Global '" + QualifiedName(Scope, Variable->Name) + "' is already defined", Decl->Location });
+                        break;
+                    }
+
+                    const auto Slot = static_cast<uint32_t>(Target.Globals.size());
+                    Target.Globals.push_back(*Target.Intern(QualifiedName(Scope, Variable->Name)));
+                    Symbols.Declare(Scope, Name, { ESymbolKind::Global, Slot, 0 });
+                    ConstGlobals.push_back(Variable->IsConst);
+                    SharedGlobals.push_back(OwnershipAnalysis::IsShared(Variable->Type));
+                    GlobalLayouts.push_back(-1);
+                    Globals.push_back({ Variable, Slot, Scope, -1, {} });
+                    break;
+                }
+                case ENodeKind::DefineDeclaration: {
+                    const auto* Define = static_cast<DefineDeclaration*>(Decl);
+                    if (const int32_t Index = DeclareType(*Define, Scope); Index >= 0) {
+                        Defines.push_back({ Define, Scope, static_cast<uint32_t>(Index), -1 });
+                    }
+                    break;
+                }
+                case ENodeKind::InterfaceDeclaration: {
+                    const auto* Interface = static_cast<InterfaceDeclaration*>(Decl);
+                    if (const int32_t Index = DeclareInterface(*Interface, Scope); Index >= 0) {
+                        Interfaces.push_back({ Interface, Scope, static_cast<uint32_t>(Index), {} });
+                    }
+                    break;
+                }
+                case ENodeKind::FetchDeclaration:
+                case ENodeKind::SetDeclaration:
+                    Accessors.emplace_back(Decl, Scope);
+                    break;
+                default:
+                    break;                          // Imports need no code here
+            }
+        }
+
+        // Imports take effect once the whole unit is declared, so they may name a namespace declared below them
+        for (const auto& [Using, Scope] : Usings) {
+            const SymbolRef* Found = Symbols.LookupPath(Scope, Using->Path);
+            if (Found == nullptr || Found->Kind != ESymbolKind::Namespace) {
+                Errors.push_back({ "Unknown namespace '" + std::string(Using->Path) + "'", Using->Location });
+                continue;
+            }
+            Symbols.AddUsing(Scope, Found->Index);
+        }
+
+        // An Interface numbers its methods after those of the interfaces it extends, wherever those are declared
+        std::vector<bool> Numbered(Target.Interfaces.size(), true);
+        for (DeclaredInterface& Interface : Interfaces) {
+            Interface.Bases = FindExtended(*Interface.Node, Interface.Scope);
+            Numbered[Interface.Index] = false;
+        }
+        for (bool Progress = true; Progress;) {
+            Progress = false;
+            for (const DeclaredInterface& Interface : Interfaces) {
+                if (!Numbered[Interface.Index] &&
+                    std::all_of(Interface.Bases.begin(), Interface.Bases.end(), [&](const uint32_t Base) { return Numbered[Base]; })) {
+                    AddInterfaceMethods(*Interface.Node, Interface.Index, Interface.Bases);
+                    Numbered[Interface.Index] = Progress = true;
+                }
+            }
+        }
+        for (const DeclaredInterface& Interface : Interfaces) {
+            if (!Numbered[Interface.Index]) {
+                Errors.push_back({ "'" + Target.Interfaces[Interface.Index].Name + "' extends itself", Interface.Node->Location });
+            }
+        }
+
+        // A Define is laid out after the one it extends, wherever that is declared
+        std::vector<bool> LaidOut(Target.Types.size(), true);
+        for (DeclaredType& Type : Defines) {
+            Type.Base = FindBase(*Type.Node, Type.Scope);
+            LaidOut[Type.Index] = false;
+        }
+        std::vector<DeclaredType> Ordered;
+        for (bool Progress = true; Progress;) {
+            Progress = false;
+            for (const DeclaredType& Type : Defines) {
+                if (!LaidOut[Type.Index] && (Type.Base < 0 || LaidOut[static_cast<size_t>(Type.Base)])) {
+                    AddLayout(*Type.Node, Type.Index, Type.Base);
+                    LaidOut[Type.Index] = Progress = true;
+                    Ordered.push_back(Type);
+                }
+            }
+        }
+        for (const DeclaredType& Type : Defines) {
+            if (!LaidOut[Type.Index]) {
+                Errors.push_back({ "'" + Target.Types[Type.Index].Name + "' extends itself", Type.Node->Location });
+            }
+        }
+
+        // Accessors become functions of their Define's layout, taking the array and index ahead of their parameters
+        for (const auto& [Block, Scope] : Accessors) {
+            const bool IsFetch = Block->Is<FetchDeclaration>();
+            const std::string_view Type = IsFetch ? Block->As<FetchDeclaration>()->Target : Block->As<SetDeclaration>()->Target;
+            const ArenaArray<FunctionDeclaration*>& Methods = IsFetch ? Block->As<FetchDeclaration>()->Methods
+                                                                      : Block->As<SetDeclaration>()->Methods;
+            const SymbolRef* Found = Symbols.LookupPath(Scope, Type, false);
+            if (Found == nullptr || Found->Kind != ESymbolKind::Type) {
+                Errors.push_back({ "Unknown Define '" + std::string(Type) + "' for accessors", Block->Location });
+                continue;
+            }
+
+            TypeLayout& Layout = Target.Types[Found->Index];
+            for (FunctionDeclaration* Method : Methods) {
+                if (Method == nullptr) {
+                    continue;
+                }
+                if (Layout.FindMethod(Method->Name) >= 0) {
+                    Errors.push_back({ "Accessor '" + std::string(Method->Name) + "' of " + Layout.Name + " is already defined",
+                                       Method->Location });
+                    continue;
+                }
+                if (Method->Parameters.size() + 2 >= MaxRegisters) {
+                    Errors.push_back({ "Too many parameters", Method->Location });
+                    continue;
+                }
+
+                const uint32_t Index = Target.AddFunction(Layout.Name + "." + std::string(Method->Name));
+                Layout.AddMethod(Method->Name, Index);
+                Target.Functions[Index].ParameterCount = static_cast<uint8_t>(Method->Parameters.size() + 2);
+                Signatures.resize(Target.Functions.size(), nullptr);
+                Signatures[Index] = Method;
+                Functions.push_back({ Method, Index, Scope, static_cast<int32_t>(Found->Index), Type });
+            }
+        }
+
+        // Methods take their receiver like accessors do. An Override (or Implement) takes over the slot it
+        // inherits, a Virtual adds one; every Define starts with its base's table
+        for (const DeclaredType& Type : Ordered) {
+            TypeLayout& Layout = Target.Types[Type.Index];
+            if (Type.Base >= 0) {
+                const TypeLayout& Extended = Target.Types[static_cast<size_t>(Type.Base)];
+                Layout.InheritMethods(Extended);
+                Layout.VTable = Extended.VTable;
+            }
+            const std::vector<uint32_t> Implements = FindImplemented(*Type.Node, Type.Scope, Type.Base);
+
+            for (FunctionDeclaration* Method : Type.Node->Methods) {
+                if (Method == nullptr) {
+                    continue;
+                }
+                const std::string Name = Layout.Name + "." + std::string(Method->Name);
+                const bool Dynamic = Method->IsVirtual || Method->IsOverride || Method->IsImplement;
+                const int32_t Inherited = Layout.FindSlot(Method->Name);
+                std::string Problem;
+                if (Method->IsStatic) {
+                    Problem = "Static methods are not supported by the VM yet";
+                } else if (Target.FindFunction(Name) >= 0) {
+                    Problem = "Method '" + std::string(Method->Name) + "' of " + Layout.Name + " is already defined";
+                } else if (Method->IsOverride && Inherited < 0) {
+                    Problem = "'" + Name + "' overrides no Virtual method";
+                } else if (Method->IsImplement && Inherited < 0 &&
+                           std::none_of(Implements.begin(), Implements.end(), [&](const uint32_t Interface) {
+                               return Target.Interfaces[Interface].FindMethod(Method->Name) >= 0;
+                           })) {
+                    Problem = "'" + Name + "' implements no Interface method";
+                } else if (Layout.FindMethod(Method->Name) >= 0 && Inherited < 0) {
+                    Problem = "'" + Name + "' hides a method of its base that is not Virtual";
+                } else if (Inherited >= 0 && !Method->IsOverride && !Method->IsImplement) {
+                    Problem = "'" + Name + "' must be declared Override";
+                } else if (Inherited >= 0 && Target.Functions[Layout.VTable[static_cast<size_t>(Inherited)]].ParameterCount !=
+                                                 Method->Parameters.size() + 2) {
+                    Problem = "'" + Name + "' must take the parameters of the method it overrides";
+                } else if (Method->Parameters.size() + 2 >= MaxRegisters) {
+                    Problem = "Too many parameters";
+                }
+                if (!Problem.empty()) {
+                    Errors.push_back({ std::move(Problem), Method->Location });
+                    continue;
+                }
+
+                const uint32_t Index = Target.AddFunction(Name);
+                int32_t Slot = -1;
+                if (Dynamic && Inherited >= 0) {
+                    Slot = Inherited;
+                    Layout.VTable[static_cast<size_t>(Slot)] = Index;
+                } else if (Dynamic) {
+                    Slot = static_cast<int32_t>(Layout.VTable.size());
+                    Layout.VTable.push_back(Index);
+                }
+                Layout.AddMethod(Method->Name, Index, Slot);
+                Target.Functions[Index].ParameterCount = static_cast<uint8_t>(Method->Parameters.size() + 2);
+                Signatures.resize(Target.Functions.size(), nullptr);
+                Signatures[Index] = Method;
+                Functions.push_back({ Method, Index, Type.Scope, static_cast<int32_t>(Type.Index), "this" });
+            }
+
+            AddITables(*Type.Node, Type.Index, Implements);
+        }
+
+        // Every function exists before any body is compiled, so calls can go either way
+        const bool HasInitializers = std::any_of(Globals.begin(), Globals.end(), [](const Collected& Global) {
+            return static_cast<VariableDeclaration*>(Global.Node)->Initializer != nullptr;
+        });
+        uint32_t Initializer = 0;
+        if (HasInitializers) {
+            Initializer = Target.AddFunction("<globals " + std::to_string(Target.Initializers.size()) + ">");
+            Signatures.resize(Target.Functions.size(), nullptr);
+        }
+
+        // A global array's Define comes from its declared type, or else from its initializer
+        Resolver Names(Target, Symbols, Signatures, GlobalLayouts, Errors);
+        UnitState State{ Target, Errors, Names, ConstGlobals, SharedGlobals, Signatures, InlinedCalls, Dispatch,
+                         FrameAllocation, Devirtualization };
+        for (const Collected& Global : Globals) {
+            GlobalLayouts[Global.Index] = Names.LayoutOf(static_cast<VariableDeclaration*>(Global.Node)->Type, Global.Scope);
+        }
+
+        if (HasInitializers) {
+            FunctionBuilder Builder(State, Initializer);
+            for (const Collected& Global : Globals) {
+                auto* Variable = static_cast<VariableDeclaration*>(Global.Node);
+                if (Variable->Initializer != nullptr) {
+                    const int32_t Layout = Names.ResolveGlobal(Variable->Initializer, Global.Scope);
+                    if (Variable->Type == nullptr) {
+                        GlobalLayouts[Global.Index] = Layout;
+                    }
+                    Builder.CompileGlobal(Global.Index, Variable->Initializer, Global.Scope);
+                }
+            }
+            Builder.Finish();
+            Target.Initializers.push_back(Initializer);
+        }
+
+        // Check every body, on several threads in a big unit. Checking only reads the shared tables and
+        // binds its own function's names; each function keeps its diagnostics apart until they are merged
+        struct Checked {
+            uint32_t SlotCount = 0;
+            std::vector<CompileError> Errors;
+        };
+        std::vector<Checked> Bodies(Functions.size());
+        std::atomic<size_t> Next{ 0 };
+
+        RunOnWorkers(Functions.size() >= MinParallelFunctions ? Threads : 1, [&](unsigned) {
+            std::vector<CompileError> Found;
+            Resolver Checker(Target, Symbols, Signatures, GlobalLayouts, Found);
+            for (size_t Index = Next.fetch_add(1, std::memory_order_relaxed); Index < Functions.size();
+                 Index = Next.fetch_add(1, std::memory_order_relaxed)) {
+                const Collected& Function = Functions[Index];
+                auto& Declaration = *static_cast<FunctionDeclaration*>(Function.Node);
+                Bodies[Index].SlotCount = Function.Owner >= 0
+                                              ? Checker.ResolveAccessor(Declaration, Function.Scope, Function.Self, Function.Owner)
+                                              : Checker.ResolveFunction(Declaration, Function.Scope);
+                Bodies[Index].Errors.swap(Found);
+            }
+        });
+
+        // Arrays that die with their call are made in its frame, and Shared references count only what they must.
+        // Only this unit's bodies are analyzed, so passing an array to a function of an earlier unit counts as an
+        // escape; accessors can only read and write fields, and methods hold no counted references
+        std::optional<OwnershipAnalysis> Ownership;
+        const bool Clean = std::all_of(Bodies.begin(), Bodies.end(), [](const Checked& Body) { return Body.Errors.empty(); });
+        if (Clean) {
+            std::vector<const FunctionDeclaration*> Analyzed(Target.Functions.size(), nullptr);
+            for (const Collected& Function : Functions) {
+                if (Function.Owner < 0) {
+                    Analyzed[Function.Index] = static_cast<const FunctionDeclaration*>(Function.Node);
+                }
+            }
+            State.Ownership = &Ownership.emplace(Analyzed, SharedGlobals, FrameAllocation, CountElision);
+        }
+
+        // Calls to this unit's small functions, and to its one-statement accessors whatever their size, are inlined
+        std::vector<Inlinable> Inlines;
+        if (Inlining && Clean) {
+            Inlines.resize(Target.Functions.size());
+            for (size_t Position = 0; Position < Functions.size(); ++Position) {
+                const Collected& Function = Functions[Position];
+                const auto* Declaration = static_cast<const FunctionDeclaration*>(Function.Node);
+                if (Declaration->Body == nullptr) {
+                    continue;
+                }
+                const uint32_t Hidden = Function.Owner >= 0 ? 2 : 0;
+                InlineCost Measured(Bodies[Position].SlotCount);
+                Measured.Visit(Declaration->Body);
+                Measured.Counts = Measured.Counts || OwnershipAnalysis::IsShared(Declaration->ReturnType) ||
+                                  std::any_of(Declaration->Parameters.begin(), Declaration->Parameters.end(),
+                                              [](const Parameter& Param) { return OwnershipAnalysis::IsShared(Param.Type); });
+                const bool Trivial = Function.Owner >= 0 && Declaration->Body->Statements.size() == 1;
+                if (Measured.MakesArrays || Measured.Counts || (!Trivial && Measured.Cost > MaxInlineCost)) {
+                    continue;
+                }
+                Inlines[Function.Index] = { Declaration, Function.Scope, Bodies[Position].SlotCount, Hidden,
+                                            std::move(Measured.Assigned) };
+            }
+            State.Inlines = &Inlines;
+        }
+
+        // Code is emitted in source order, so diagnostics come out the same for any number of threads
+        for (size_t Position = 0; Position < Functions.size(); ++Position) {
+            const Collected& Function = Functions[Position];
+            auto* Declaration = static_cast<FunctionDeclaration*>(Function.Node);
+            std::vector<CompileError>& Found = Bodies[Position].Errors;
+            Errors.insert(Errors.end(), std::make_move_iterator(Found.begin()), std::make_move_iterator(Found.end()));
+
+            FunctionBuilder Builder(State, Function.Index, Bodies[Position].SlotCount, Function.Scope);
+            const uint32_t Hidden = Function.Owner >= 0 ? 2 : 0;
+            if (Hidden != 0) {
+                Builder.AddElement();
+            }
+            for (uint32_t Slot = 0; Slot < Declaration->Parameters.size(); ++Slot) {
+                Builder.AddParameter(Declaration->Parameters[Slot], Slot + Hidden);
+            }
+
+            // A Virtual method may leave its body to the Defines extending it, and returns null
+            const bool Abstract = Function.Owner >= 0 && Declaration->IsVirtual && Declaration->Deferred == nullptr;
+            if (Declaration->Body != nullptr) {
+                Builder.CompileBody(Declaration->Body);
+            } else if (!Abstract) {
+                Errors.push_back({ Declaration->Deferred != nullptr
+                                       ? "Body of '" + std::string(Declaration->Name) + "' was not parsed yet"
+                                       : "'" + std::string(Declaration->Name) + "' has no body",
+                                   Declaration->Location });
+            }
+            Builder.Finish();
+        }
+
+        return Errors.size() == ErrorsBefore;
+    }
+}
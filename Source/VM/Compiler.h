@@ -0,0 +1,172 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Bytecode.h"
+#include "Declaration.h"
+#include "SymbolTable.h"
+
+namespace Vex {
+
+    struct CompileError {
+        std::string Message;
+        SourceLocation Location;
+    };
+
+    /** How calls to Virtual, Override and Implement methods were compiled, counting each inlined copy */
+    struct DispatchReport {
+        size_t VirtualCalls = 0;
+        size_t Direct = 0;                          // The receiver's Define was known: its method is called outright
+        size_t Guarded = 0;                         // Few Defines can be the receiver: ISTYPE picks a direct call
+        size_t Dynamic = 0;                         // Left to CALLVIRT
+
+        [[nodiscard]] size_t Devirtualized() const { return Direct + Guarded; }
+    };
+
+    /**
+     * Lowers the functions, globals and Defines of a TranslationUnit to
+     * register bytecode in a Program
+     *
+     * Each function gets a frame of at most 256 registers: parameters
+     * first, then locals in scope order, then temporaries, which are
+     * released as soon as the expression that needed them is done. Locals
+     * used as operands are read in place and assignments to locals write
+     * straight into their register, so most statements need no moves.
+     *
+     * Names are bound before any code is emitted (see Resolver), so the
+     * bytecode holds indices only. All of a unit's declarations are
+     * collected first; function bodies are then checked independently, on
+     * several threads for a unit of MinParallelFunctions or more, while
+     * code is still emitted on the calling thread in source order.
+     * Globals' initializers run in a generated function before anything
+     * else. Several units may be compiled into one Program, each seeing
+     * the declarations of those before it.
+     *
+     * Methods and Fetch/Set accessors compile to functions named after
+     * their Define (Entity.Fetch_Health) that take the array and index
+     * ahead of their parameters; see TypeLayout and InterfaceLayout for
+     * how Defines and Interfaces are laid out. super and static methods
+     * are reported as errors. Run FoldConstants() first to have Const
+     * values inlined.
+     *
+     * Example:
+     *   Program Program;
+     *   Compiler Compiler(Program);
+     *   if (Compiler.Compile(Unit)) { VirtualMachine VM(Program); VM.Call("Main", {}, Result); }
+     */
+    class Compiler {
+    public:
+        /** Threads == 0 uses std::thread::hardware_concurrency() */
+        explicit Compiler(Program& Target, unsigned Threads = 0);
+
+        /** Adds Unit's functions and globals to the Program; false if anything failed to compile */
+        bool Compile(TranslationUnit* Unit);
+
+        [[nodiscard]] const std::vector<CompileError>& GetErrors() const { return Errors; }
+        [[nodiscard]] bool HasErrors() const { return !Errors.empty(); }
+
+        /** Declaration of each Program function, by index, with names bound; null for generated ones */
+        [[nodiscard]] const std::vector<const FunctionDeclaration*>& GetDeclarations() const { return Signatures; }
+
+        /**
+         * Whether arrays that never outlive their call are made in its frame;
+         * on by default
+         *
+         * Once a unit's bodies are checked, OwnershipAnalysis finds the new
+         * arrays that only reach locals which do not escape and callees that
+         * only borrow them. Those compile to NEWLOCAL, which the VM serves
+         * from a region it rolls back when the call returns.
+         */
+        void SetFrameAllocation(const bool Enabled) { FrameAllocation = Enabled; }
+
+        /**
+         * Whether Shared references skip the counting OwnershipAnalysis
+         * proves redundant; on by default
+         *
+         * Shared locals, parameters and globals count the arrays they hold
+         * with RETAIN and RELEASE. With this on, a reference that only
+         * borrows one outliving it is not counted, a returned local hands
+         * its count over, and references no other thread can see count
+         * without atomics. Off, every one counts atomically.
+         */
+        void SetCountElision(const bool Enabled) { CountElision = Enabled; }
+
+        /**
+         * Whether calls to small functions are replaced by their bodies; on
+         * by default
+         *
+         * Accessors whose body is one statement, and other functions of the
+         * unit of at most 24 AST nodes that make no arrays, are copied up to
+         * four deep and never into themselves. The caller's locals are read
+         * in place by parameters the body does not assign.
+         */
+        void SetInlining(const bool Enabled) { Inlining = Enabled; }
+
+        /** Calls compiled as a copy of their callee's body so far, counting each copy made inside another */
+        [[nodiscard]] size_t GetInlinedCalls() const { return InlinedCalls; }
+
+        /**
+         * Whether virtual calls are narrowed by class-hierarchy analysis; on
+         * by default
+         *
+         * Over the Defines compiled so far, a receiver with one possible
+         * Define (a local made by `new Circle[]` and never reassigned) calls
+         * its method outright, and one that at most four Defines can be is
+         * tested against each with ISTYPE ahead of a direct call. CALLVIRT
+         * stays behind the tests for Defines a later unit adds.
+         */
+        void SetDevirtualization(const bool Enabled) { Devirtualization = Enabled; }
+
+        /** How the virtual calls compiled so far dispatch */
+        [[nodiscard]] const DispatchReport& GetDispatch() const { return Dispatch; }
+
+        /** Units with fewer functions are checked on the calling thread alone */
+        static constexpr size_t MinParallelFunctions = 256;
+
+    private:
+        Program& Target;
+        unsigned Threads;
+        std::vector<CompileError> Errors;
+        SymbolTable Symbols;                                    // Every unit's declarations, by namespace
+        size_t DeclaredNatives = 0;                             // Program natives already in Symbols
+        std::vector<bool> ConstGlobals;
+        std::vector<bool> SharedGlobals;                        // By global slot: declared Shared, so stores count the array
+        std::vector<int32_t> GlobalLayouts;                     // By global slot: Program::Types index of an array's elements, or -1
+        std::vector<const FunctionDeclaration*> Signatures;     // By function index, for default arguments
+        bool FrameAllocation = true;
+        bool CountElision = true;
+        bool Inlining = true;
+        size_t InlinedCalls = 0;
+        bool Devirtualization = true;
+        DispatchReport Dispatch;
+
+        /** Program name of Name declared in Scope: qualified by its namespaces */
+        [[nodiscard]] std::string QualifiedName(ScopeId Scope, std::string_view Name) const;
+
+        /** Adds a Define to the Program's Types with no fields yet; its index, or -1 if it cannot be added */
+        int32_t DeclareType(const DefineDeclaration& Define, ScopeId Scope);
+
+        /** Program::Types index of the Define that Define extends, or -1 */
+        int32_t FindBase(const DefineDeclaration& Define, ScopeId Scope);
+
+        /** Records a Define's fields in Types[Index], after those of Base, which is laid out already */
+        void AddLayout(const DefineDeclaration& Define, uint32_t Index, int32_t Base);
+
+        /** Adds an Interface to the Program's Interfaces with no methods yet; its index, or -1 if it cannot be added */
+        int32_t DeclareInterface(const InterfaceDeclaration& Interface, ScopeId Scope);
+
+        /** Program::Interfaces indices of the interfaces Interface extends directly */
+        std::vector<uint32_t> FindExtended(const InterfaceDeclaration& Interface, ScopeId Scope);
+
+        /** Numbers Interface's methods in Interfaces[Index], after those of Bases, which are numbered already */
+        void AddInterfaceMethods(const InterfaceDeclaration& Interface, uint32_t Index, const std::vector<uint32_t>& Bases);
+
+        /** Program::Interfaces indices of what a Define implements: its base's interfaces, those it names, and theirs */
+        std::vector<uint32_t> FindImplemented(const DefineDeclaration& Define, ScopeId Scope, int32_t Base);
+
+        /** Builds the table of Types[Index] for each of Implements, once its methods are all added */
+        void AddITables(const DefineDeclaration& Define, uint32_t Index, const std::vector<uint32_t>& Implements);
+    };
+}
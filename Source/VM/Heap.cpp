@@ -0,0 +1,130 @@
+#include "Heap.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace Vex {
+    FrameArena::~FrameArena() {
+        for (const Chunk& Held : Chunks) {
+            std::free(Held.Memory);
+        }
+    }
+
+    void* FrameArena::AllocateSlow(const size_t Size) {
+        // Chunks past the current one are free; use the next that fits, or put a new one there
+        uint32_t Next = Chunks.empty() ? 0 : Current + 1;
+        while (Next < Chunks.size() && Chunks[Next].Size < Size) {
+            ++Next;
+        }
+        if (Next == Chunks.size()) {
+            const size_t Bytes = std::max(ChunkSize, Size);
+            auto* Memory = static_cast<char*>(std::malloc(Bytes));
+            if (Memory == nullptr) {
+                throw std::bad_alloc();
+            }
+            Next = Chunks.empty() ? 0 : Current + 1;
+            Chunks.insert(Chunks.begin() + Next, { Memory, Bytes });
+            Stats.Reserved += Bytes;
+            ++Stats.Fallbacks;
+        } else if (Next != Current + 1) {
+            std::swap(Chunks[Current + 1], Chunks[Next]);   // Keeps the chunks in use contiguous for Release()
+            Next = Current + 1;
+        }
+
+        Current = Next;
+        Cursor = Chunks[Current].Memory + Size;
+        End = Chunks[Current].Memory + Chunks[Current].Size;
+        Stats.Bytes += Size;
+        Stats.Peak = std::max(Stats.Peak, Stats.Bytes);
+        return Chunks[Current].Memory;
+    }
+
+    SlabAllocator::~SlabAllocator() {
+        for (void* Page : Pages) {
+            std::free(Page);
+        }
+        for (void* Block : Large) {
+            std::free(Block);
+        }
+    }
+
+    size_t SlabAllocator::ClassOf(const size_t Size) {
+        if (Size <= 128) {
+            return Size == 0 ? 0 : (Size - 1) / 16;
+        }
+        size_t Shift = 7;                           // Size - 1 is in [2^Shift, 2^(Shift + 1))
+        while (((Size - 1) >> (Shift + 1)) != 0) {
+            ++Shift;
+        }
+        return 8 + (Shift - 7) * 4 + (((Size - 1) >> (Shift - 2)) & 3);
+    }
+
+    size_t SlabAllocator::ClassSize(const size_t Class) {
+        if (Class < 8) {
+            return (Class + 1) * 16;
+        }
+        const size_t Shift = 7 + (Class - 8) / 4;
+        return (5 + (Class - 8) % 4) << (Shift - 2);
+    }
+
+    void* SlabAllocator::Allocate(const size_t Size) {
+        ++Stats.Allocations;
+        if (Size > MaxClassSize) {
+            void* Memory = std::malloc(Size);
+            if (Memory == nullptr) {
+                throw std::bad_alloc();
+            }
+            Large.insert(Memory);
+            ++Stats.Fallbacks;
+            Stats.Bytes += Size;
+            Stats.Peak = std::max(Stats.Peak, Stats.Bytes);
+            return Memory;
+        }
+
+        const size_t Class = ClassOf(Size);
+        if (FreeLists[Class] == nullptr) {
+            Refill(Class);
+        }
+        FreeBlock* Block = FreeLists[Class];
+        FreeLists[Class] = Block->Next;
+        Stats.Bytes += ClassSize(Class);
+        Stats.Peak = std::max(Stats.Peak, Stats.Bytes);
+        return Block;
+    }
+
+    void SlabAllocator::Free(void* Memory, const size_t Size) {
+        if (Memory == nullptr) {
+            return;
+        }
+        if (Size > MaxClassSize) {
+            Large.erase(Memory);
+            std::free(Memory);
+            Stats.Bytes -= Size;
+            return;
+        }
+
+        const size_t Class = ClassOf(Size);
+        auto* Block = static_cast<FreeBlock*>(Memory);
+        Block->Next = FreeLists[Class];
+        FreeLists[Class] = Block;
+        Stats.Bytes -= ClassSize(Class);
+    }
+
+    void SlabAllocator::Refill(const size_t Class) {
+        auto* Page = static_cast<char*>(std::malloc(PageSize));
+        if (Page == nullptr) {
+            throw std::bad_alloc();
+        }
+        Pages.push_back(Page);
+        Stats.Reserved += PageSize;
+
+        // Pushed in reverse so blocks come out in address order
+        const size_t Size = ClassSize(Class);
+        for (size_t Offset = (PageSize / Size) * Size; Offset >= Size; Offset -= Size) {
+            auto* Block = reinterpret_cast<FreeBlock*>(Page + Offset - Size);
+            Block->Next = FreeLists[Class];
+            FreeLists[Class] = Block;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace Vex {
+
+    struct AllocatorStats {
+        size_t Bytes = 0;                           // Handed out and not yet given back
+        size_t Peak = 0;                            // Most Bytes at any time
+        size_t Reserved = 0;                        // Taken from the system
+        size_t Allocations = 0;
+        size_t Fallbacks = 0;                       // Requests the allocator passed on to the system
+    };
+
+    /**
+     * Bump allocator for memory that dies with the call that takes it
+     *
+     * Allocate() moves a cursor through chunks kept from earlier use.
+     * GetMark() remembers where the cursor is and Release() moves it back,
+     * freeing everything taken since in O(1); Reset() does the same for
+     * everything. Chunks are only returned to the system when the arena is
+     * destroyed, so after warming up a frame loop never calls malloc. A
+     * Fallback is a chunk that had to be added.
+     */
+    class FrameArena {
+    public:
+        static constexpr size_t ChunkSize = 256 * 1024;
+        static constexpr size_t Alignment = 16;
+
+        struct Mark {
+            char* Cursor = nullptr;
+            uint32_t Chunk = 0;
+            size_t Bytes = 0;
+        };
+
+        FrameArena() = default;
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* Allocate(size_t Size) {
+            Size = (Size + Alignment - 1) & ~(Alignment - 1);
+            ++Stats.Allocations;
+            if (static_cast<size_t>(End - Cursor) < Size) {
+                return AllocateSlow(Size);
+            }
+            void* Memory = Cursor;
+            Cursor += Size;
+            Stats.Bytes += Size;
+            Stats.Peak = Stats.Bytes > Stats.Peak ? Stats.Bytes : Stats.Peak;
+            return Memory;
+        }
+
+        [[nodiscard]] Mark GetMark() const { return { Cursor, Current, Stats.Bytes }; }
+
+        /** Frees everything allocated since Saved was taken */
+        void Release(const Mark& Saved) {
+            if (Saved.Cursor == nullptr) {
+                Reset();                            // Taken before the first chunk
+                return;
+            }
+            Cursor = Saved.Cursor;
+            Current = Saved.Chunk;
+            End = Chunks[Current].Memory + Chunks[Current].Size;
+            Stats.Bytes = Saved.Bytes;
+        }
+
+        void Reset() {
+            Current = 0;
+            Cursor = Chunks.empty() ? nullptr : Chunks[0].Memory;
+            End = Chunks.empty() ? nullptr : Chunks[0].Memory + Chunks[0].Size;
+            Stats.Bytes = 0;
+        }
+
+        [[nodiscard]] const AllocatorStats& GetStats() const { return Stats; }
+
+    private:
+        struct Chunk {
+            char* Memory;
+            size_t Size;
+        };
+
+        std::vector<Chunk> Chunks;
+        uint32_t Current = 0;
+        char* Cursor = nullptr;
+        char* End = nullptr;
+        AllocatorStats Stats;
+
+        void* AllocateSlow(size_t Size);
+    };
+
+    /**
+     * Size-class allocator for memory that outlives its call
+     *
+     * Requests up to MaxClassSize are rounded up to one of ClassCount
+     * sizes (16-byte steps to 128, then four per power of two) and served
+     * from that class's free list, which is refilled by carving a 64 KiB
+     * page. Freed blocks go back on their list, so steady churn of
+     * similar sizes settles into a fixed set of pages. Larger requests are
+     * Fallbacks to malloc; the allocator keeps those it has not been given
+     * back and frees them with its pages.
+     */
+    class SlabAllocator {
+    public:
+        static constexpr size_t PageSize = 64 * 1024;
+        static constexpr size_t MaxClassSize = 8192;
+        static constexpr size_t ClassCount = 32;
+
+        SlabAllocator() = default;
+        ~SlabAllocator();
+
+        SlabAllocator(const SlabAllocator&) = delete;
+        SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+        void* Allocate(size_t Size);
+
+        /** Size must be what the block was allocated with */
+        void Free(void* Memory, size_t Size);
+
+        [[nodiscard]] const AllocatorStats& GetStats() const { return Stats; }
+
+        /** Index of the smallest class holding Size bytes (1 .. MaxClassSize), and that class's size */
+        static size_t ClassOf(size_t Size);
+        static size_t ClassSize(size_t Class);
+
+    private:
+        struct FreeBlock {
+            FreeBlock* Next;
+        };
+
+        std::array<FreeBlock*, ClassCount> FreeLists{};
+        std::vector<void*> Pages;
+        std::unordered_set<void*> Large;            // Fallback blocks not yet freed
+        AllocatorStats Stats;
+
+        void Refill(size_t Class);
+    };
+}
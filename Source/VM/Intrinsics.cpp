@@ -0,0 +1,251 @@
+#include "Intrinsics.h"
+
+#include "Math.h"
+
+namespace Vex {
+    namespace {
+        // Registers hold their lanes at an 8-byte offset, so loads and stores are unaligned
+        template<EValueType Type> struct LaneType;
+        template<> struct LaneType<EValueType::Float>   { using Type = float; };
+        template<> struct LaneType<EValueType::Vector2> { using Type = Vector2; };
+        template<> struct LaneType<EValueType::Vector3> { using Type = Vector3; };
+        template<> struct LaneType<EValueType::Vector4> { using Type = Vector4; };
+        template<> struct LaneType<EValueType::Quat>    { using Type = Quat; };
+        template<> struct LaneType<EValueType::Color>   { using Type = Color; };
+
+        template<typename T>
+        T Load(const Value& Source) {
+            return T(Float4::LoadUnaligned(Source.Lanes));
+        }
+
+        template<>
+        float Load<float>(const Value& Source) {
+            return static_cast<float>(Source.ToFloat());
+        }
+
+        template<>
+        Vector2 Load<Vector2>(const Value& Source) {
+            return { Source.Lanes[0], Source.Lanes[1] };
+        }
+
+        template<typename T>
+        Value Store(const EValueType Type, const T& Result) {
+            Value Out;
+            Out.Type = Type;
+            Result.Lanes().StoreUnaligned(Out.Lanes);
+            return Out;
+        }
+
+        Value Store(const EValueType Type, const Vector2& Result) {
+            return Value::MakeMath(Type, Result.X, Result.Y);
+        }
+
+        Value Store(EValueType, const float Result) {
+            return Value::MakeFloat(Result);
+        }
+
+        /** "Dot(A, B)" -> "Dot" */
+        constexpr std::string_view Callee(const std::string_view Kernel) {
+            return Kernel.substr(0, Kernel.find('('));
+        }
+
+    #define VEX_INTRINSIC_KERNEL(Name, Op, Left, Right, Result, Kernel)                             \
+        Value Name(const Value& First, const Value& Second) {                                       \
+            const auto A = Load<LaneType<EValueType::Left>::Type>(First);                           \
+            const auto B = Load<LaneType<EValueType::Right>::Type>(Second);                         \
+            return Store(EValueType::Result, Kernel);                                               \
+        }
+        VEX_INTRINSICS(VEX_INTRINSIC_KERNEL)
+    #undef VEX_INTRINSIC_KERNEL
+
+        const IntrinsicInfo Table[IntrinsicCount] = {
+        #define VEX_INTRINSIC_INFO(Name, Op, Left, Right, Result, Kernel) \
+            { #Name, EOpCode::Op == EOpCode::CALLNATIVE ? Callee(#Kernel) : std::string_view(), EOpCode::Op, \
+              EValueType::Left, EValueType::Right, EValueType::Result, &Name },
+            VEX_INTRINSICS(VEX_INTRINSIC_INFO)
+        #undef VEX_INTRINSIC_INFO
+        };
+
+        // ---- Natives ----
+
+        float Number(const Value& Argument) { return static_cast<float>(Argument.ToFloat()); }
+
+        bool Numbers(const Value* Arguments, const int Count) {
+            for (int Index = 0; Index < Count; ++Index) {
+                if (!Arguments[Index].IsNumber()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<EValueType Type>
+        Value Construct(const Value* Arguments) {
+            constexpr int Count = MathLaneCount(Type);
+            if (!Numbers(Arguments, Count)) {
+                return {};
+            }
+            return Value::MakeMath(Type, Number(Arguments[0]), Number(Arguments[1]), Count > 2 ? Number(Arguments[2]) : 0.0f,
+                                   Count > 3 ? Number(Arguments[3]) : 0.0f);
+        }
+
+        Value NativeDot(const Value* Arguments) {
+            const Value& A = Arguments[0];
+            if (A.Type != Arguments[1].Type) {
+                return {};
+            }
+            switch (A.Type) {
+                case EValueType::Vector2: return Value::MakeFloat(Dot(Load<Vector2>(A), Load<Vector2>(Arguments[1])));
+                case EValueType::Vector3: return Value::MakeFloat(Dot(Load<Vector3>(A), Load<Vector3>(Arguments[1])));
+                case EValueType::Vector4: return Value::MakeFloat(Dot(Load<Vector4>(A), Load<Vector4>(Arguments[1])));
+                case EValueType::Quat:    return Value::MakeFloat(Dot(Load<Quat>(A), Load<Quat>(Arguments[1])));
+                default:                  return {};
+            }
+        }
+
+        Value NativeCross(const Value* Arguments) {
+            if (Arguments[0].Type != EValueType::Vector3 || Arguments[1].Type != EValueType::Vector3) {
+                return {};
+            }
+            return Store(EValueType::Vector3, Cross(Load<Vector3>(Arguments[0]), Load<Vector3>(Arguments[1])));
+        }
+
+        Value NativeLength(const Value* Arguments) {
+            const Value& A = Arguments[0];
+            switch (A.Type) {
+                case EValueType::Vector2: return Value::MakeFloat(Length(Load<Vector2>(A)));
+                case EValueType::Vector3: return Value::MakeFloat(Length(Load<Vector3>(A)));
+                case EValueType::Vector4: return Value::MakeFloat(Length(Load<Vector4>(A)));
+                default:                  return {};
+            }
+        }
+
+        Value NativeNormalize(const Value* Arguments) {
+            const Value& A = Arguments[0];
+            switch (A.Type) {
+                case EValueType::Vector2: return Store(A.Type, Normalize(Load<Vector2>(A)));
+                case EValueType::Vector3: return Store(A.Type, Normalize(Load<Vector3>(A)));
+                case EValueType::Vector4: return Store(A.Type, Normalize(Load<Vector4>(A)));
+                case EValueType::Quat:    return Store(A.Type, Normalize(Load<Quat>(A)));
+                default:                  return {};
+            }
+        }
+
+        Value NativeLerp(const Value* Arguments) {
+            const Value& A = Arguments[0];
+            const Value& B = Arguments[1];
+            if (!Arguments[2].IsNumber()) {
+                return {};
+            }
+            const float T = Number(Arguments[2]);
+            if (A.IsNumber() && B.IsNumber()) {
+                return Value::MakeFloat(A.ToFloat() + (B.ToFloat() - A.ToFloat()) * Arguments[2].ToFloat());
+            }
+            if (A.Type != B.Type) {
+                return {};
+            }
+            switch (A.Type) {
+                case EValueType::Vector2: return Store(A.Type, Lerp(Load<Vector2>(A), Load<Vector2>(B), T));
+                case EValueType::Vector3: return Store(A.Type, Lerp(Load<Vector3>(A), Load<Vector3>(B), T));
+                case EValueType::Vector4: return Store(A.Type, Lerp(Load<Vector4>(A), Load<Vector4>(B), T));
+                case EValueType::Color:   return Store(A.Type, Lerp(Load<Color>(A), Load<Color>(B), T));
+                default:                  return {};
+            }
+        }
+
+        Value NativeSlerp(const Value* Arguments) {
+            if (Arguments[0].Type != EValueType::Quat || Arguments[1].Type != EValueType::Quat || !Arguments[2].IsNumber()) {
+                return {};
+            }
+            return Store(EValueType::Quat, Slerp(Load<Quat>(Arguments[0]), Load<Quat>(Arguments[1]), Number(Arguments[2])));
+        }
+
+        Value NativeRotate(const Value* Arguments) {
+            if (Arguments[0].Type != EValueType::Quat || Arguments[1].Type != EValueType::Vector3) {
+                return {};
+            }
+            return RotateCall(Arguments[0], Arguments[1]);
+        }
+
+        Value NativeAxisAngle(const Value* Arguments) {
+            if (Arguments[0].Type != EValueType::Vector3 || !Arguments[1].IsNumber()) {
+                return {};
+            }
+            return Store(EValueType::Quat, Quat::FromAxisAngle(Load<Vector3>(Arguments[0]), Number(Arguments[1])));
+        }
+
+        const NativeBinding MathNatives[] = {
+            { "Vector2",   &Construct<EValueType::Vector2>, 2, EValueType::Vector2 },
+            { "Vector3",   &Construct<EValueType::Vector3>, 3, EValueType::Vector3 },
+            { "Vector4",   &Construct<EValueType::Vector4>, 4, EValueType::Vector4 },
+            { "Quat",      &Construct<EValueType::Quat>,    4, EValueType::Quat },
+            { "Color",     &Construct<EValueType::Color>,   4, EValueType::Color },
+            { "Dot",       &NativeDot,                      2, EValueType::Float },
+            { "Cross",     &NativeCross,                    2, EValueType::Vector3 },
+            { "Length",    &NativeLength,                   1, EValueType::Float },
+            { "Normalize", &NativeNormalize,                1, EValueType::Null },
+            { "Lerp",      &NativeLerp,                     3, EValueType::Null },
+            { "Slerp",     &NativeSlerp,                    3, EValueType::Quat },
+            { "Rotate",    &NativeRotate,                   2, EValueType::Vector3 },
+            { "AxisAngle", &NativeAxisAngle,                2, EValueType::Quat },
+        };
+    }
+
+    const IntrinsicInfo* GetIntrinsics() {
+        return Table;
+    }
+
+    const IntrinsicInfo& GetIntrinsic(const uint32_t Index) {
+        return Table[Index];
+    }
+
+    int32_t FindIntrinsic(const EOpCode Op, EValueType Left, EValueType Right) {
+        Left = Left == EValueType::Int ? EValueType::Float : Left;
+        Right = Right == EValueType::Int ? EValueType::Float : Right;
+        for (size_t Index = 0; Index < IntrinsicCount; ++Index) {
+            if (Table[Index].Op == Op && Table[Index].Left == Left && Table[Index].Right == Right) {
+                return static_cast<int32_t>(Index);
+            }
+        }
+        return -1;
+    }
+
+    int32_t FindIntrinsicCall(const std::string_view Native, EValueType Left, EValueType Right) {
+        Left = Left == EValueType::Int ? EValueType::Float : Left;
+        Right = Right == EValueType::Int ? EValueType::Float : Right;
+        for (size_t Index = 0; Index < IntrinsicCount; ++Index) {
+            if (Table[Index].Native == Native && Table[Index].Left == Left && Table[Index].Right == Right) {
+                return static_cast<int32_t>(Index);
+            }
+        }
+        return -1;
+    }
+
+    bool NegateMath(const Value& Operand, Value& Out) {
+        switch (Operand.Type) {
+            case EValueType::Vector2: Out = Store(Operand.Type, -Load<Vector2>(Operand)); return true;
+            case EValueType::Vector3: Out = Store(Operand.Type, -Load<Vector3>(Operand)); return true;
+            case EValueType::Vector4: Out = Store(Operand.Type, -Load<Vector4>(Operand)); return true;
+            default:                  return false;
+        }
+    }
+
+    bool SameLanes(const Value& Left, const Value& Right) {
+        return Float4::Equal(Float4::LoadUnaligned(Left.Lanes), Float4::LoadUnaligned(Right.Lanes));
+    }
+
+    NativeFunction FindMathNative(const std::string_view Name) {
+        for (const NativeBinding& Native : MathNatives) {
+            if (Native.Name == Name) {
+                return Native.Callback;
+            }
+        }
+        return nullptr;
+    }
+
+    void AddMathNatives(Program& Target) {
+        for (const NativeBinding& Native : MathNatives) {
+            Target.AddNative(Native.Name, Native.Callback, Native.Arity, Native.Result);
+        }
+    }
+}
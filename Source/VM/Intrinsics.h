@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "Bytecode.h"
+
+namespace Vex {
+
+    /**
+     * Operators on the math types that compile to one MATH instruction,
+     * each running a single Runtime math operation (one SSE instruction or
+     * a short shuffle sequence)
+     *
+     * X(Name, Op, Left, Right, Result, Kernel): Op is the opcode the
+     * operator compiles to otherwise, Left and Right the operand types and
+     * Kernel the computation over A and B (Left and Right as Runtime math
+     * types). Float stands for any number on either side. Entries whose Op
+     * is CALLNATIVE stand for a two-argument call of the native named by
+     * the first word of Kernel, registered by AddMathNatives().
+     */
+    #define VEX_INTRINSICS(X)                                                              \
+        X(AddVector2,     ADD,        Vector2, Vector2, Vector2, A + B)                    \
+        X(SubVector2,     SUB,        Vector2, Vector2, Vector2, A - B)                    \
+        X(MulVector2,     MUL,        Vector2, Vector2, Vector2, A * B)                    \
+        X(DivVector2,     DIV,        Vector2, Vector2, Vector2, A / B)                    \
+        X(ScaleVector2,   MUL,        Vector2, Float,   Vector2, A * B)                    \
+        X(ScaledVector2,  MUL,        Float,   Vector2, Vector2, B * A)                    \
+        X(ShrinkVector2,  DIV,        Vector2, Float,   Vector2, A * (1.0f / B))           \
+        X(AddVector3,     ADD,        Vector3, Vector3, Vector3, A + B)                    \
+        X(SubVector3,     SUB,        Vector3, Vector3, Vector3, A - B)                    \
+        X(MulVector3,     MUL,        Vector3, Vector3, Vector3, A * B)                    \
+        X(DivVector3,     DIV,        Vector3, Vector3, Vector3, A / B)                    \
+        X(ScaleVector3,   MUL,        Vector3, Float,   Vector3, A * B)                    \
+        X(ScaledVector3,  MUL,        Float,   Vector3, Vector3, B * A)                    \
+        X(ShrinkVector3,  DIV,        Vector3, Float,   Vector3, A * (1.0f / B))           \
+        X(AddVector4,     ADD,        Vector4, Vector4, Vector4, A + B)                    \
+        X(SubVector4,     SUB,        Vector4, Vector4, Vector4, A - B)                    \
+        X(MulVector4,     MUL,        Vector4, Vector4, Vector4, A * B)                    \
+        X(DivVector4,     DIV,        Vector4, Vector4, Vector4, A / B)                    \
+        X(ScaleVector4,   MUL,        Vector4, Float,   Vector4, A * B)                    \
+        X(ScaledVector4,  MUL,        Float,   Vector4, Vector4, B * A)                    \
+        X(ShrinkVector4,  DIV,        Vector4, Float,   Vector4, A * (1.0f / B))           \
+        X(AddColor,       ADD,        Color,   Color,   Color,   A + B)                    \
+        X(SubColor,       SUB,        Color,   Color,   Color,   A - B)                    \
+        X(ModulateColor,  MUL,        Color,   Color,   Color,   A * B)                    \
+        X(ScaleColor,     MUL,        Color,   Float,   Color,   A * B)                    \
+        X(ScaledColor,    MUL,        Float,   Color,   Color,   B * A)                    \
+        X(MulQuat,        MUL,        Quat,    Quat,    Quat,    A * B)                    \
+        X(RotateVector3,  MUL,        Quat,    Vector3, Vector3, Rotate(A, B))             \
+        X(DotVector2,     CALLNATIVE, Vector2, Vector2, Float,   Dot(A, B))                \
+        X(DotVector3,     CALLNATIVE, Vector3, Vector3, Float,   Dot(A, B))                \
+        X(DotVector4,     CALLNATIVE, Vector4, Vector4, Float,   Dot(A, B))                \
+        X(CrossVector3,   CALLNATIVE, Vector3, Vector3, Vector3, Cross(A, B))              \
+        X(RotateCall,     CALLNATIVE, Quat,    Vector3, Vector3, Rotate(A, B))
+
+    enum class EIntrinsic : uint8_t {
+    #define VEX_INTRINSIC_ENUM(Name, Op, Left, Right, Result, Kernel) Name,
+        VEX_INTRINSICS(VEX_INTRINSIC_ENUM)
+    #undef VEX_INTRINSIC_ENUM
+    };
+
+    constexpr size_t IntrinsicCount = static_cast<size_t>(EIntrinsic::RotateCall) + 1;
+
+    using IntrinsicKernel = Value (*)(const Value& Left, const Value& Right);
+
+    struct IntrinsicInfo {
+        std::string_view Name;
+        std::string_view Native;                    // Name of the native it replaces, for CALLNATIVE entries
+        EOpCode Op;
+        EValueType Left;
+        EValueType Right;
+        EValueType Result;
+        IntrinsicKernel Kernel;
+
+        /** Whether Kernel may run on these operands; Float accepts Int too */
+        [[nodiscard]] bool Accepts(const Value& A, const Value& B) const {
+            return (Left == EValueType::Float ? A.IsNumber() : A.Type == Left) &&
+                   (Right == EValueType::Float ? B.IsNumber() : B.Type == Right);
+        }
+    };
+
+    /** All intrinsics, indexed by EIntrinsic */
+    const IntrinsicInfo* GetIntrinsics();
+    const IntrinsicInfo& GetIntrinsic(uint32_t Index);
+
+    /** Index of the intrinsic for Op on operands of these types, or -1 */
+    int32_t FindIntrinsic(EOpCode Op, EValueType Left, EValueType Right);
+
+    /** Index of the intrinsic replacing a call of the native Name with arguments of these types, or -1 */
+    int32_t FindIntrinsicCall(std::string_view Native, EValueType Left, EValueType Right);
+
+    /** -Operand for Vector2, Vector3 and Vector4; false for other types */
+    bool NegateMath(const Value& Operand, Value& Out);
+
+    /** Lane-wise equality of two values of the same math type */
+    bool SameLanes(const Value& Left, const Value& Right);
+
+    /** Callback of the math native named Name, or null */
+    NativeFunction FindMathNative(std::string_view Name);
+
+    /**
+     * Registers the math natives: the constructors Vector2(X, Y),
+     * Vector3(X, Y, Z), Vector4(X, Y, Z, W), Quat(X, Y, Z, W) and
+     * Color(R, G, B, A), and Dot, Cross, Length, Normalize, Lerp, Slerp,
+     * Rotate and AxisAngle(Axis, Angle). They return null when given
+     * arguments of the wrong types.
+     */
+    void AddMathNatives(Program& Target);
+}
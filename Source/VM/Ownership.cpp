@@ -0,0 +1,509 @@
+#include "Ownership.h"
+
+#include <algorithm>
+
+#include "Statement.h"
+
+namespace Vex {
+    OwnershipAnalysis::OwnershipAnalysis(const std::vector<const FunctionDeclaration*>& Functions,
+                                         const std::vector<bool>& SharedGlobals, const bool FrameArrays, const bool Elide)
+        : Functions(Functions), SharedGlobals(SharedGlobals), FrameArrays(FrameArrays), Elide(Elide), States(Functions.size()),
+          Summaries(Functions.size()), Reports(Functions.size()) {
+        for (size_t Index = 0; Index < Functions.size(); ++Index) {
+            if (Functions[Index] != nullptr) {
+                Summaries[Index].assign(Functions[Index]->Parameters.size(), 0);
+            }
+        }
+
+        // Summaries start at "borrows everything, releases nothing" and only grow, so this ends; recursion settles
+        // on the least escape
+        for (bool Changed = true; Changed;) {
+            Changed = false;
+            ++Passes;
+            for (uint32_t Index = 0; Index < Functions.size(); ++Index) {
+                if (Functions[Index] != nullptr && Analyze(Index)) {
+                    Changed = true;
+                }
+            }
+        }
+
+        for (uint32_t Index = 0; Index < Functions.size(); ++Index) {
+            Classify(Index);
+            if (Functions[Index] != nullptr) {
+                Count(Index);
+            }
+        }
+        Current = nullptr;
+    }
+
+    bool OwnershipAnalysis::IsFrameLocal(const NewExpression* New) const {
+        const auto Found = FrameLocal.find(New);
+        return Found != FrameLocal.end() && Found->second;
+    }
+
+    bool OwnershipAnalysis::BorrowsParameter(const uint32_t Function, const uint32_t Parameter) const {
+        return Function < Summaries.size() && Parameter < Summaries[Function].size() &&
+               (Summaries[Function][Parameter] & ParameterEscapes) == 0;
+    }
+
+    ERefCount OwnershipAnalysis::GetCount(const uint32_t Function, const uint32_t Slot) const {
+        if (Function >= States.size() || Slot >= States[Function].Counts.size()) {
+            return ERefCount::None;
+        }
+        return States[Function].Counts[Slot];
+    }
+
+    bool OwnershipAnalysis::ReturnsShared(const uint32_t Function) const {
+        return Function < Functions.size() && Functions[Function] != nullptr && IsShared(Functions[Function]->ReturnType);
+    }
+
+    bool OwnershipAnalysis::Analyze(const uint32_t Function) {
+        const FunctionDeclaration& Declaration = *Functions[Function];
+        Current = &States[Function];
+        const bool Released = Current->Releases;
+        Current->Slots.clear();
+        Current->Slots.resize(Declaration.Parameters.size());
+        Current->Allocations.clear();
+        Current->Releases = false;
+        for (uint32_t Index = 0; Index < Declaration.Parameters.size(); ++Index) {
+            Current->Slots[Index].Opaque = true;
+            Current->Slots[Index].Shared = IsShared(Declaration.Parameters[Index].Type);
+        }
+
+        if (Declaration.Body != nullptr) {
+            Walk(*Declaration.Body);
+        }
+
+        // A local escapes if anything holding its value does; locals sharing a value are handed and opaque together
+        std::vector<Slot>& Slots = Current->Slots;
+        for (bool Changed = true; Changed;) {
+            Changed = false;
+            for (Slot& Holder : Slots) {
+                for (const uint32_t Source : Holder.Sources) {
+                    Slot& Held = Slots[Source];
+                    if ((Holder.Escapes && !Held.Escapes) || Holder.Handed != Held.Handed || Holder.Opaque != Held.Opaque) {
+                        Held.Escapes = Held.Escapes || Holder.Escapes;
+                        Held.Handed = Holder.Handed = Held.Handed || Holder.Handed;
+                        Held.Opaque = Holder.Opaque = Held.Opaque || Holder.Opaque;
+                        Changed = true;
+                    }
+                }
+            }
+        }
+
+        bool Changed = Current->Releases != Released;
+        for (uint32_t Index = 0; Index < Declaration.Parameters.size(); ++Index) {
+            const uint8_t Summary = (Slots[Index].Escapes ? ParameterEscapes : 0) | (Slots[Index].Handed ? ParameterHanded : 0);
+            if (Summary != Summaries[Function][Index]) {
+                Summaries[Function][Index] = Summary;
+                Changed = true;
+            }
+        }
+        return Changed;
+    }
+
+    void OwnershipAnalysis::Classify(const uint32_t Function) {
+        OwnershipReport& Report = Reports[Function];
+        const std::vector<Slot>& Slots = States[Function].Slots;
+
+        // An array is frame-local only if every place it may go keeps it so
+        std::vector<const NewExpression*> Made;
+        for (const Allocation& Going : States[Function].Allocations) {
+            bool Local = false;
+            switch (Going.Kind) {
+                case ESite::Local:
+                    Local = Going.Target == Temporary || !Slots[Going.Target].Escapes;
+                    break;
+                case ESite::Argument:
+                    Local = BorrowsParameter(Going.Target, Going.Parameter);
+                    break;
+                default:
+                    break;
+            }
+            const auto [Entry, Inserted] = FrameLocal.emplace(Going.New, Local);
+            if (Inserted) {
+                Made.push_back(Going.New);
+            }
+            Entry->second = Entry->second && Local;
+        }
+        Report.Arrays = Made.size();
+        for (const NewExpression* New : Made) {
+            Report.FrameArrays += FrameLocal[New] ? 1 : 0;
+        }
+
+        Total.Arrays += Report.Arrays;
+        Total.FrameArrays += Report.FrameArrays;
+    }
+
+    void OwnershipAnalysis::Count(const uint32_t Function) {
+        FunctionState& State = States[Function];
+        const std::vector<Slot>& Slots = State.Slots;
+        const size_t Parameters = Functions[Function]->Parameters.size();
+
+        // A local made only by frame-local new expressions has nothing to free
+        std::vector<uint8_t> Fresh(Slots.size(), 0);  // 0: no new, 1: only frame-local ones, 2: some other
+        for (const Allocation& Going : State.Allocations) {
+            if (Going.Kind == ESite::Local && Going.Target != Temporary) {
+                Fresh[Going.Target] = std::max<uint8_t>(Fresh[Going.Target], IsFrameLocal(Going.New) ? 1 : 2);
+            }
+        }
+
+        State.Counts.assign(Slots.size(), ERefCount::None);
+        OwnershipReport& Report = Reports[Function];
+        for (uint32_t Index = 0; Index < Slots.size(); ++Index) {
+            const Slot& Holder = Slots[Index];
+            if (!Holder.Shared) {
+                continue;
+            }
+
+            const bool Lent = Index < Parameters && !Holder.Reassigned && !State.Releases;
+            const bool Copy = Index >= Parameters && !Holder.Reassigned && Holder.Borrows != Temporary &&
+                              Slots[Holder.Borrows].Shared && !Slots[Holder.Borrows].Reassigned;
+            const bool Made = Index >= Parameters && FrameArrays && Fresh[Index] == 1 && Holder.Sources.empty() && !Holder.Opaque;
+            ERefCount& Counted = State.Counts[Index];
+            if (!Elide) {
+                Counted = ERefCount::Atomic;
+            } else if (Lent || Copy || Made) {
+                Counted = ERefCount::Elided;
+            } else {
+                Counted = Holder.Opaque || Holder.Handed ? ERefCount::Atomic : ERefCount::NonAtomic;
+            }
+
+            ++Report.Shared;
+            Report.Elided += Counted == ERefCount::Elided ? 1 : 0;
+            Report.NonAtomic += Counted == ERefCount::NonAtomic ? 1 : 0;
+        }
+
+        Total.Shared += Report.Shared;
+        Total.Elided += Report.Elided;
+        Total.NonAtomic += Report.NonAtomic;
+    }
+
+    OwnershipAnalysis::Slot& OwnershipAnalysis::SlotOf(const uint32_t Index) {
+        if (Index >= Current->Slots.size()) {
+            Current->Slots.resize(Index + 1);
+        }
+        return Current->Slots[Index];
+    }
+
+    // ---- Statements ----
+
+    void OwnershipAnalysis::Walk(Statement& Stmt) {
+        switch (Stmt.Kind) {
+            case ENodeKind::VariableDeclaration: {
+                auto& Variable = static_cast<VariableDeclaration&>(Stmt);
+                if (Variable.Initializer != nullptr) {
+                    Visit(Variable.Initializer);
+                }
+                if (Variable.Symbol.Kind != ESymbolKind::Local) {
+                    if (Variable.Initializer != nullptr) {
+                        Escape(Variable.Initializer);
+                    }
+                    break;
+                }
+
+                Slot& Declared = SlotOf(Variable.Symbol.Index);
+                Declared.Shared = IsShared(Variable.Type);
+                if (Variable.Initializer != nullptr) {
+                    if (const auto* Name = Unwrap(Variable.Initializer)->As<Identifier>(); Name != nullptr &&
+                                                                                            Name->Symbol.Kind == ESymbolKind::Local) {
+                        Declared.Borrows = Name->Symbol.Index;
+                    }
+                    Flow(Variable.Initializer, Variable.Symbol.Index);
+                }
+                break;
+            }
+
+            case ENodeKind::ExpressionStatement:
+                Visit(static_cast<ExpressionStatement&>(Stmt).Expr);
+                break;
+
+            case ENodeKind::BlockStatement:
+                for (Statement* Inner : static_cast<BlockStatement&>(Stmt).Statements) {
+                    if (Inner != nullptr) {
+                        Walk(*Inner);
+                    }
+                }
+                break;
+
+            case ENodeKind::IfStatement: {
+                auto& If = static_cast<IfStatement&>(Stmt);
+                Visit(If.Condition);
+                Walk(*If.ThenBranch);
+                if (If.ElseBranch != nullptr) {
+                    Walk(*If.ElseBranch);
+                }
+                break;
+            }
+
+            case ENodeKind::WhileStatement: {
+                auto& While = static_cast<WhileStatement&>(Stmt);
+                Visit(While.Condition);
+                Walk(*While.Body);
+                break;
+            }
+
+            case ENodeKind::DoWhileStatement: {
+                auto& DoWhile = static_cast<DoWhileStatement&>(Stmt);
+                Walk(*DoWhile.Body);
+                Visit(DoWhile.Condition);
+                break;
+            }
+
+            case ENodeKind::ForStatement: {
+                auto& For = static_cast<ForStatement&>(Stmt);
+                Visit(For.RangeStart);
+                Visit(For.RangeEnd);
+                if (For.Step != nullptr) {
+                    Visit(For.Step);
+                }
+                Walk(*For.Body);
+                break;
+            }
+
+            case ENodeKind::ReturnStatement: {
+                Expression* Value = static_cast<ReturnStatement&>(Stmt).Value;
+                if (Value != nullptr) {
+                    Visit(Value);
+                    Escape(Value);
+                }
+                break;
+            }
+
+            case ENodeKind::MatchStatement: {
+                auto& Match = static_cast<MatchStatement&>(Stmt);
+                Visit(Match.Value);
+                for (const MatchCase& Case : Match.Cases) {
+                    Walk(*Case.Body);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    // ---- Expressions ----
+
+    void OwnershipAnalysis::Visit(Expression* Expr) {
+        switch (Expr->Kind) {
+            case ENodeKind::GroupingExpression:
+                Visit(Expr->As<GroupingExpression>()->Expr);
+                break;
+
+            case ENodeKind::UnaryExpression:
+                Visit(Expr->As<UnaryExpression>()->Operand);
+                break;
+
+            case ENodeKind::BinaryExpression: {
+                auto& Binary = *Expr->As<BinaryExpression>();
+                if (IsAssignmentOp(Binary.Op)) {
+                    VisitAssignment(Binary);
+                } else {
+                    Visit(Binary.Left);
+                    Visit(Binary.Right);
+                }
+                break;
+            }
+
+            case ENodeKind::TernaryExpression: {
+                const auto* Ternary = Expr->As<TernaryExpression>();
+                Visit(Ternary->Condition);
+                Visit(Ternary->TrueExpr);
+                Visit(Ternary->FalseExpr);
+                break;
+            }
+
+            case ENodeKind::FunctionCall:
+                VisitCall(*Expr->As<FunctionCall>());
+                break;
+
+            case ENodeKind::MemberAccess:
+                Visit(Expr->As<MemberAccess>()->Object);
+                break;
+
+            case ENodeKind::IndexAccess: {
+                const auto* Element = Expr->As<IndexAccess>();
+                Visit(Element->Object);
+                Visit(Element->Index);
+                break;
+            }
+
+            case ENodeKind::NewExpression: {
+                const auto* New = Expr->As<NewExpression>();
+                for (Expression* Argument : New->Arguments) {
+                    Visit(Argument);
+                }
+                Current->Allocations.push_back({ New, ESite::Local, Temporary });
+                break;
+            }
+
+            case ENodeKind::CastExpression:
+                Visit(Expr->As<CastExpression>()->Expr);
+                break;
+
+            default:
+                break;                              // Reading a local borrows it
+        }
+    }
+
+    void OwnershipAnalysis::VisitAssignment(BinaryExpression& Assign) {
+        Visit(Assign.Right);
+        const bool Replaces = Assign.Op == EBinaryOp::Assign;
+
+        if (const auto* Name = Unwrap(Assign.Left)->As<Identifier>()) {
+            if (Name->Symbol.Kind == ESymbolKind::Local) {
+                SlotOf(Name->Symbol.Index).Reassigned = true;
+                if (Replaces) {
+                    Flow(Assign.Right, Name->Symbol.Index);
+                }
+            } else if (Replaces && Name->Symbol.Kind == ESymbolKind::Global) {
+                Escape(Assign.Right);
+                if (IsSharedGlobal(Name)) {
+                    Hand(Assign.Right);             // Whoever reads the global later may be another thread's host call
+                    Current->Releases = true;
+                }
+            }
+            return;
+        }
+
+        // A field of an array element
+        Visit(Assign.Left);
+        if (Replaces) {
+            Escape(Assign.Right);
+        }
+    }
+
+    void OwnershipAnalysis::VisitCall(FunctionCall& Call) {
+        for (Expression* Argument : Call.Arguments) {
+            Visit(Argument);
+        }
+
+        const auto* Callee = Unwrap(Call.Callee)->As<Identifier>();
+        if (Callee == nullptr) {
+            Visit(Call.Callee);
+        }
+
+        const FunctionDeclaration* Target =
+            Callee != nullptr && Callee->Symbol.Kind == ESymbolKind::Function && Callee->Symbol.Index < Functions.size()
+                ? Functions[Callee->Symbol.Index]
+                : nullptr;
+        const bool Native = Callee != nullptr && Callee->Symbol.Kind == ESymbolKind::Native;
+        if ((Target == nullptr && !Native) || (Target != nullptr && States[Callee->Symbol.Index].Releases)) {
+            Current->Releases = true;               // Methods, and functions of earlier units, are not analyzed
+        }
+
+        std::vector<const Identifier*> Found;
+        std::vector<const NewExpression*> Made;
+        for (size_t Index = 0; Index < Call.Arguments.size(); ++Index) {
+            if (Target == nullptr || Index >= Target->Parameters.size()) {
+                Escape(Call.Arguments[Index]);    // Natives included: the host may keep anything
+                Hand(Call.Arguments[Index]);
+                continue;
+            }
+
+            const uint32_t Function = Callee->Symbol.Index;
+            Found.clear();
+            Values(Call.Arguments[Index], Found);
+            for (const Identifier* Name : Found) {
+                Slot& Passed = SlotOf(Name->Symbol.Index);
+                Passed.Escapes = Passed.Escapes || (Summaries[Function][Index] & ParameterEscapes) != 0;
+                Passed.Handed = Passed.Handed || (Summaries[Function][Index] & ParameterHanded) != 0;
+            }
+
+            Made.clear();
+            Allocations(Call.Arguments[Index], Made);
+            for (const NewExpression* New : Made) {
+                Current->Allocations.push_back({ New, ESite::Argument, Function, static_cast<uint32_t>(Index) });
+            }
+        }
+    }
+
+    void OwnershipAnalysis::Values(Expression* Expr, std::vector<const Identifier*>& Out) const {
+        Expr = Unwrap(Expr);
+        if (const auto* Name = Expr->As<Identifier>()) {
+            if (Name->Symbol.Kind == ESymbolKind::Local) {
+                Out.push_back(Name);
+            }
+        } else if (const auto* Ternary = Expr->As<TernaryExpression>()) {
+            Values(Ternary->TrueExpr, Out);
+            Values(Ternary->FalseExpr, Out);
+        } else if (const auto* Element = Expr->As<IndexAccess>(); Element != nullptr && Element->Symbol.Kind == ESymbolKind::Interface) {
+            Values(Element->Object, Out);           // An element used through an Interface keeps its array
+        }
+    }
+
+    void OwnershipAnalysis::Allocations(Expression* Expr, std::vector<const NewExpression*>& Out) const {
+        Expr = Unwrap(Expr);
+        if (const auto* New = Expr->As<NewExpression>()) {
+            Out.push_back(New);
+        } else if (const auto* Ternary = Expr->As<TernaryExpression>()) {
+            Allocations(Ternary->TrueExpr, Out);
+            Allocations(Ternary->FalseExpr, Out);
+        } else if (const auto* Element = Expr->As<IndexAccess>(); Element != nullptr && Element->Symbol.Kind == ESymbolKind::Interface) {
+            Allocations(Element->Object, Out);
+        }
+    }
+
+    void OwnershipAnalysis::Flow(Expression* Value, const uint32_t Into) {
+        if (IsForeign(Value)) {
+            SlotOf(Into).Opaque = true;
+        }
+
+        std::vector<const Identifier*> Found;
+        Values(Value, Found);
+        for (const Identifier* Name : Found) {
+            SlotOf(Name->Symbol.Index);
+            SlotOf(Into).Sources.push_back(Name->Symbol.Index);
+        }
+
+        std::vector<const NewExpression*> Made;
+        Allocations(Value, Made);
+        for (const NewExpression* New : Made) {
+            Current->Allocations.push_back({ New, ESite::Local, Into });
+        }
+    }
+
+    bool OwnershipAnalysis::IsForeign(Expression* Expr) const {
+        Expr = Unwrap(Expr);
+        if (const auto* Ternary = Expr->As<TernaryExpression>()) {
+            return IsForeign(Ternary->TrueExpr) || IsForeign(Ternary->FalseExpr);
+        }
+        if (const auto* Element = Expr->As<IndexAccess>()) {
+            return Element->Symbol.Kind != ESymbolKind::Interface || IsForeign(Element->Object);
+        }
+        if (const auto* Name = Expr->As<Identifier>()) {
+            return Name->Symbol.Kind != ESymbolKind::Local;
+        }
+        return Expr->Is<FunctionCall>() || Expr->Is<MemberAccess>();
+    }
+
+    bool OwnershipAnalysis::IsSharedGlobal(const Expression* Expr) const {
+        const auto* Name = Expr->As<Identifier>();
+        return Name != nullptr && Name->Symbol.Kind == ESymbolKind::Global && Name->Symbol.Index < SharedGlobals.size() &&
+               SharedGlobals[Name->Symbol.Index];
+    }
+
+    void OwnershipAnalysis::Hand(Expression* Value) {
+        std::vector<const Identifier*> Found;
+        Values(Value, Found);
+        for (const Identifier* Name : Found) {
+            SlotOf(Name->Symbol.Index).Handed = true;
+        }
+    }
+
+    void OwnershipAnalysis::Escape(Expression* Value) {
+        std::vector<const Identifier*> Found;
+        Values(Value, Found);
+        for (const Identifier* Name : Found) {
+            SlotOf(Name->Symbol.Index).Escapes = true;
+        }
+
+        std::vector<const NewExpression*> Made;
+        Allocations(Value, Made);
+        for (const NewExpression* New : Made) {
+            Current->Allocations.push_back({ New, ESite::Escape });
+        }
+    }
+}
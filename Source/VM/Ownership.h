@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Declaration.h"
+#include "Expression.h"
+
+namespace Vex {
+
+    struct OwnershipReport {
+        size_t Arrays = 0;                          // new expressions
+        size_t FrameArrays = 0;                     // Of those, never outliving the call that makes them
+        size_t Shared = 0;                          // Locals and parameters declared Shared
+        size_t Elided = 0;                          // Of those, only borrowing what another reference keeps alive
+        size_t NonAtomic = 0;                       // Of the rest, counted where no other thread can see them
+    };
+
+    /** How a Shared local or parameter counts its references */
+    enum class ERefCount : uint8_t { None, Elided, NonAtomic, Atomic };
+
+    /**
+     * Which `new` arrays never outlive the call that makes them, over the
+     * resolved functions of a Compiler
+     *
+     * A local escapes when its value may be returned, stored in a field or
+     * global, passed to a native, or passed where the callee lets it
+     * escape, or when a local holding its value escapes. Callee summaries
+     * start at "borrows every parameter" and are solved to a fixed point,
+     * so recursion settles on the least escape. Globals are not tracked.
+     *
+     * A `new` whose result is only held by locals that do not escape, or
+     * passed where the callee only borrows it, is frame-local, and the
+     * Compiler has the VM make it in the calling frame's scratch
+     * (NEWLOCAL) instead of the VM's heap.
+     *
+     * A local or parameter declared Shared holds a counted reference (see
+     * RETAIN), unless it only borrows one that outlives it: a parameter
+     * the function never assigns, if nothing the call runs can store a
+     * Shared global; or a local never assigned after being declared as a
+     * copy of such a holder, or of frame-local arrays. A reference whose
+     * array comes only from this function's `new` and is never handed to
+     * a native or a Shared global is counted without atomics.
+     *
+     * Example:
+     *   OwnershipAnalysis Ownership(Compiler.GetDeclarations(), SharedGlobals);
+     *   const OwnershipReport& Total = Ownership.GetTotal();
+     */
+    class OwnershipAnalysis {
+    public:
+        /**
+         * Functions by Program index, with null for those that have no
+         * declaration. With Elide false, every Shared reference is counted
+         * atomically, as if nothing were proven.
+         */
+        OwnershipAnalysis(const std::vector<const FunctionDeclaration*>& Functions, const std::vector<bool>& SharedGlobals = {},
+                          bool FrameArrays = true, bool Elide = true);
+
+        [[nodiscard]] const OwnershipReport& GetTotal() const { return Total; }
+        [[nodiscard]] const OwnershipReport& GetReport(uint32_t Function) const { return Reports[Function]; }
+
+        /** Whether the array New makes dies with the call that makes it; false for a New not analyzed */
+        [[nodiscard]] bool IsFrameLocal(const NewExpression* New) const;
+
+        /** Whether the function never lets its Parameter-th argument escape */
+        [[nodiscard]] bool BorrowsParameter(uint32_t Function, uint32_t Parameter) const;
+
+        /** How a local slot of the function counts; None if it is not Shared or the function was not analyzed */
+        [[nodiscard]] ERefCount GetCount(uint32_t Function, uint32_t Slot) const;
+
+        /** Whether the function was analyzed and returns Shared, handing its caller a count of the result */
+        [[nodiscard]] bool ReturnsShared(uint32_t Function) const;
+
+        /** Whether counts are left out and made non-atomic where proven; see the constructor */
+        [[nodiscard]] bool IsEliding() const { return Elide; }
+
+        /** Whether a declared type holds a counted reference: Shared, and not only Borrow */
+        [[nodiscard]] static bool IsShared(const TypeRef* Type) { return Type != nullptr && Type->IsShared && !Type->IsBorrow; }
+
+        /** Rounds over every function until the callee summaries stopped changing */
+        [[nodiscard]] size_t GetPasses() const { return Passes; }
+
+    private:
+        static constexpr uint32_t Temporary = UINT32_MAX;  // Allocation target of the new expression itself
+
+        enum class ESite : uint8_t { Local, Argument, Escape };
+
+        /** Where a new array goes; it is frame-local if every place it goes allows it */
+        struct Allocation {
+            const NewExpression* New;
+            ESite Kind;                             // A return is an Escape
+            uint32_t Target = 0;                    // Local: slot, or Temporary. Argument: callee
+            uint32_t Parameter = 0;                 // Argument: callee's parameter
+        };
+
+        struct Slot {
+            bool Escapes = false;                   // May outlive the call
+            bool Handed = false;                    // May reach a native or a Shared global
+            bool Opaque = false;                    // May hold an array this function did not make
+            bool Shared = false;                    // Declared Shared
+            bool Reassigned = false;                // Assigned after being declared
+            uint32_t Borrows = Temporary;           // The slot it was declared as a copy of
+            std::vector<uint32_t> Sources;          // Slots whose value it may hold
+        };
+
+        struct FunctionState {
+            std::vector<Slot> Slots;
+            std::vector<Allocation> Allocations;
+            std::vector<ERefCount> Counts;          // By slot
+            bool Releases = false;                  // May store a Shared global, so drop a count its caller lent
+        };
+
+        /** Bits of a parameter's summary */
+        static constexpr uint8_t ParameterEscapes = 1;
+        static constexpr uint8_t ParameterHanded = 2;
+
+        std::vector<const FunctionDeclaration*> Functions;
+        std::vector<bool> SharedGlobals;
+        bool FrameArrays;
+        bool Elide;
+        std::vector<FunctionState> States;
+        std::vector<std::vector<uint8_t>> Summaries;  // By function and parameter: ParameterEscapes, ParameterHanded
+        std::vector<OwnershipReport> Reports;
+        std::unordered_map<const NewExpression*, bool> FrameLocal;
+        OwnershipReport Total;
+        size_t Passes = 0;
+
+        FunctionState* Current = nullptr;
+
+        /** One pass over a function; true if its summary changed */
+        bool Analyze(uint32_t Function);
+        void Classify(uint32_t Function);
+        void Count(uint32_t Function);
+
+        Slot& SlotOf(uint32_t Index);
+
+        void Walk(Statement& Stmt);
+        void Visit(Expression* Expr);
+        void VisitAssignment(BinaryExpression& Assign);
+        void VisitCall(FunctionCall& Call);
+
+        /** Locals, and new arrays, whose value Expr may evaluate to; an element used through an Interface carries its array */
+        void Values(Expression* Expr, std::vector<const Identifier*>& Out) const;
+        void Allocations(Expression* Expr, std::vector<const NewExpression*>& Out) const;
+        void Flow(Expression* Value, uint32_t Into);
+        void Escape(Expression* Value);
+        void Hand(Expression* Value);
+
+        /** Whether Expr may evaluate to an array that no local or new expression of this function gave it */
+        [[nodiscard]] bool IsForeign(Expression* Expr) const;
+        [[nodiscard]] bool IsSharedGlobal(const Expression* Expr) const;
+    };
+}
@@ -0,0 +1,419 @@
+#include "Resolver.h"
+
+#include "Expression.h"
+#include "Statement.h"
+
+namespace Vex {
+    uint32_t Resolver::ResolveFunction(FunctionDeclaration& Function, const ScopeId Namespace) {
+        this->Namespace = Namespace;
+        Layouts.clear();
+        Interfaces.clear();
+        Self = -1;
+        Returns = InterfaceOf(Function.ReturnType);
+
+        // Parameters get a block of their own, so the body may shadow them
+        Locals.PushScope();
+        for (const Parameter& Param : Function.Parameters) {
+            Declare(Param.Name, LayoutOf(Param.Type), Function.Location, InterfaceOf(Param.Type));
+        }
+        if (Function.Body != nullptr) {
+            ResolveStatement(*Function.Body);
+        }
+        Locals.PopScope();
+        return static_cast<uint32_t>(Layouts.size());
+    }
+
+    uint32_t Resolver::ResolveAccessor(FunctionDeclaration& Accessor, const ScopeId Namespace, const std::string_view Target,
+                                       const int32_t Layout) {
+        this->Namespace = Namespace;
+        Layouts.clear();
+        Interfaces.clear();
+        Returns = InterfaceOf(Accessor.ReturnType);
+
+        Locals.PushScope();
+        Self = static_cast<int32_t>(Declare(Target, Layout, Accessor.Location));
+        Declare("[]", -1, Accessor.Location);       // The index, which no name reaches
+        for (const Parameter& Param : Accessor.Parameters) {
+            Declare(Param.Name, LayoutOf(Param.Type), Accessor.Location, InterfaceOf(Param.Type));
+        }
+        if (Accessor.Body != nullptr) {
+            ResolveStatement(*Accessor.Body);
+        }
+        Locals.PopScope();
+        Self = -1;
+        return static_cast<uint32_t>(Layouts.size());
+    }
+
+    int32_t Resolver::ResolveGlobal(Expression* Initializer, const ScopeId Namespace) {
+        this->Namespace = Namespace;
+        Layouts.clear();
+        Interfaces.clear();
+        Self = -1;
+        Returns = -1;
+        return Resolve(Initializer);
+    }
+
+    int32_t Resolver::LayoutOf(const TypeRef* Type, const ScopeId Namespace) const {
+        if (Type == nullptr || !Type->IsArray || Type->IsPointer) {
+            return -1;
+        }
+        const SymbolRef* Found = Symbols.LookupPath(Namespace, Type->Name, false);
+        return Found != nullptr && Found->Kind == ESymbolKind::Type ? static_cast<int32_t>(Found->Index) : -1;
+    }
+
+    int32_t Resolver::InterfaceOf(const TypeRef* Type, const ScopeId Namespace) const {
+        if (Type == nullptr || Type->IsArray || Type->IsPointer) {
+            return -1;
+        }
+        const SymbolRef* Found = Symbols.LookupPath(Namespace, Type->Name, false);
+        return Found != nullptr && Found->Kind == ESymbolKind::Interface ? static_cast<int32_t>(Found->Index) : -1;
+    }
+
+    void Resolver::Expect(Expression* Value, const int32_t Interface) {
+        if (auto* Element = Value != nullptr && Interface >= 0 ? Unwrap(Value)->As<IndexAccess>() : nullptr) {
+            Element->Symbol = { ESymbolKind::Interface, static_cast<uint32_t>(Interface), 0 };
+        }
+    }
+
+    uint32_t Resolver::Declare(const std::string_view Name, const int32_t Layout, const SourceLocation Location,
+                               const int32_t Interface) {
+        const auto Slot = static_cast<uint32_t>(Layouts.size());
+        Layouts.push_back(Layout);
+        Interfaces.push_back(Interface);
+        if (!Locals.DeclareLocal(Locals.Intern(Name), { ESymbolKind::Local, Slot, 0 })) {
+            Errors.push_back({ "'" + std::string(Name) + "' is already declared in this block", Location });
+        }
+        return Slot;
+    }
+
+    const SymbolRef* Resolver::Lookup(const std::string_view Name) const {
+        if (const SymbolRef* Local = Locals.Lookup(SymbolTable::GlobalScope, Locals.Find(Name))) {
+            return Local;
+        }
+        return Symbols.LookupPath(Namespace, Name, false);
+    }
+
+    // ---- Statements ----
+
+    void Resolver::ResolveScoped(Statement& Body) {
+        Locals.PushScope();
+        ResolveStatement(Body);
+        Locals.PopScope();
+    }
+
+    void Resolver::ResolveStatement(Statement& Stmt) {
+        switch (Stmt.Kind) {
+            case ENodeKind::VariableDeclaration: {
+                auto& Variable = static_cast<VariableDeclaration&>(Stmt);
+                // The initializer still sees any outer local of the same name
+                const int32_t Layout = Variable.Initializer != nullptr ? Resolve(Variable.Initializer) : -1;
+                const int32_t Interface = InterfaceOf(Variable.Type);
+                Expect(Variable.Initializer, Interface);
+                const uint32_t Slot = Declare(Variable.Name, Variable.Type != nullptr ? LayoutOf(Variable.Type) : Layout,
+                                              Variable.Location, Interface);
+                Variable.Symbol = { ESymbolKind::Local, Slot, 0 };
+                break;
+            }
+
+            case ENodeKind::ExpressionStatement:
+                Resolve(static_cast<ExpressionStatement&>(Stmt).Expr);
+                break;
+
+            case ENodeKind::BlockStatement:
+                Locals.PushScope();
+                for (Statement* Inner : static_cast<BlockStatement&>(Stmt).Statements) {
+                    if (Inner != nullptr) {
+                        ResolveStatement(*Inner);
+                    }
+                }
+                Locals.PopScope();
+                break;
+
+            case ENodeKind::IfStatement: {
+                auto& If = static_cast<IfStatement&>(Stmt);
+                Resolve(If.Condition);
+                ResolveScoped(*If.ThenBranch);
+                if (If.ElseBranch != nullptr) {
+                    ResolveScoped(*If.ElseBranch);
+                }
+                break;
+            }
+
+            case ENodeKind::WhileStatement: {
+                auto& While = static_cast<WhileStatement&>(Stmt);
+                Resolve(While.Condition);
+                ResolveScoped(*While.Body);
+                break;
+            }
+
+            case ENodeKind::DoWhileStatement: {
+                auto& DoWhile = static_cast<DoWhileStatement&>(Stmt);
+                ResolveScoped(*DoWhile.Body);
+                Resolve(DoWhile.Condition);
+                break;
+            }
+
+            case ENodeKind::ForStatement: {
+                auto& For = static_cast<ForStatement&>(Stmt);
+                Resolve(For.RangeStart);
+                Resolve(For.RangeEnd);
+                if (For.Step != nullptr) {
+                    Resolve(For.Step);
+                }
+                Locals.PushScope();
+                For.Symbol = { ESymbolKind::Local, Declare(For.Iterator, -1, For.Location), 0 };
+                ResolveScoped(*For.Body);
+                Locals.PopScope();
+                break;
+            }
+
+            case ENodeKind::ReturnStatement:
+                if (Expression* Result = static_cast<ReturnStatement&>(Stmt).Value) {
+                    Resolve(Result);
+                    Expect(Result, Returns);
+                }
+                break;
+
+            case ENodeKind::MatchStatement: {
+                auto& Match = static_cast<MatchStatement&>(Stmt);
+                Resolve(Match.Value);
+                for (const MatchCase& Case : Match.Cases) {
+                    const auto* Name = Case.Pattern->As<Identifier>();
+                    if (Name == nullptr || Name->Name != "_") {
+                        Resolve(Case.Pattern);
+                    }
+                    ResolveScoped(*Case.Body);
+                }
+                break;
+            }
+
+            default:
+                break;                              // Nothing to bind, or the Compiler reports it
+        }
+    }
+
+    // ---- Expressions ----
+
+    int32_t Resolver::Resolve(Expression* Expr) {
+        switch (Expr->Kind) {
+            case ENodeKind::Identifier: {
+                auto& Name = *Expr->As<Identifier>();
+                ResolveName(Name);
+                if (Name.Symbol.Kind == ESymbolKind::Local && static_cast<int32_t>(Name.Symbol.Index) == Self) {
+                    Errors.push_back({ "'" + std::string(Name.Name) + "' can only be used through its fields here", Name.Location });
+                }
+                if (Name.Symbol.Kind == ESymbolKind::Global) {
+                    return GlobalLayouts[Name.Symbol.Index];
+                }
+                return Name.Symbol.Kind == ESymbolKind::Local ? Layouts[Name.Symbol.Index] : -1;
+            }
+
+            case ENodeKind::GroupingExpression:
+                return Resolve(Expr->As<GroupingExpression>()->Expr);
+
+            case ENodeKind::UnaryExpression:
+                Resolve(Expr->As<UnaryExpression>()->Operand);
+                return -1;
+
+            case ENodeKind::BinaryExpression: {
+                auto& Binary = *Expr->As<BinaryExpression>();
+                if (IsAssignmentOp(Binary.Op)) {
+                    return ResolveAssignment(Binary);
+                }
+                Resolve(Binary.Left);
+                Resolve(Binary.Right);
+                return -1;
+            }
+
+            case ENodeKind::TernaryExpression: {
+                const auto* Ternary = Expr->As<TernaryExpression>();
+                Resolve(Ternary->Condition);
+                Resolve(Ternary->TrueExpr);
+                Resolve(Ternary->FalseExpr);
+                return -1;
+            }
+
+            case ENodeKind::FunctionCall:
+                return ResolveCall(*Expr->As<FunctionCall>());
+
+            case ENodeKind::MemberAccess: {
+                auto& Member = *Expr->As<MemberAccess>();
+                Member.Symbol = {};
+                auto* Element = Unwrap(Member.Object)->As<IndexAccess>();
+                if (Element == nullptr || Member.IsOptional) {
+                    // this.Radius in a method
+                    if (Unwrap(Member.Object)->Is<ThisExpression>() && Self >= 0 && !Member.IsOptional) {
+                        ResolveElementField(Member, Layouts[static_cast<size_t>(Self)]);
+                        return -1;
+                    }
+                    // Entity.Health in an accessor of Entity
+                    if (auto* Name = Unwrap(Member.Object)->As<Identifier>(); Name != nullptr && Self >= 0 && !Member.IsOptional) {
+                        ResolveName(*Name);
+                        if (Name->Symbol.Kind == ESymbolKind::Local && static_cast<int32_t>(Name->Symbol.Index) == Self) {
+                            ResolveElementField(Member, Layouts[static_cast<size_t>(Self)]);
+                        }
+                        return -1;
+                    }
+                    Resolve(Member.Object);
+                    return -1;
+                }
+
+                const int32_t Layout = Resolve(Element->Object);
+                Resolve(Element->Index);
+                ResolveElementField(Member, Layout);
+                return -1;
+            }
+
+            case ENodeKind::IndexAccess: {
+                auto* Element = Expr->As<IndexAccess>();
+                Element->Symbol = {};
+                Resolve(Element->Object);
+                Resolve(Element->Index);
+                return -1;
+            }
+
+            case ENodeKind::NewExpression: {
+                const auto* New = Expr->As<NewExpression>();
+                for (Expression* Argument : New->Arguments) {
+                    Resolve(Argument);
+                }
+                return LayoutOf(New->Type);
+            }
+
+            case ENodeKind::CastExpression:
+                Resolve(Expr->As<CastExpression>()->Expr);
+                return -1;
+
+            default:
+                return -1;
+        }
+    }
+
+    int32_t Resolver::ResolveAssignment(BinaryExpression& Assign) {
+        auto* Name = Unwrap(Assign.Left)->As<Identifier>();
+        if (Name == nullptr) {
+            Resolve(Assign.Left);
+            Resolve(Assign.Right);
+            return -1;
+        }
+
+        ResolveName(*Name);
+        const int32_t Layout = Resolve(Assign.Right);
+        if (Assign.Op != EBinaryOp::Assign) {
+            return -1;
+        }
+        // Field accesses after this point see what the local holds now, or the base it shares with what it held
+        if (Name->Symbol.Kind == ESymbolKind::Local) {
+            Layouts[Name->Symbol.Index] = Join(Layouts[Name->Symbol.Index], Layout);
+            Expect(Assign.Right, Interfaces[Name->Symbol.Index]);
+        }
+        return Layout;
+    }
+
+    int32_t Resolver::Join(const int32_t Held, const int32_t Given) const {
+        if (Held < 0 || Given < 0) {
+            return Given;
+        }
+        const std::vector<uint32_t>& Left = Target.Types[static_cast<size_t>(Held)].Lineage;
+        const std::vector<uint32_t>& Right = Target.Types[static_cast<size_t>(Given)].Lineage;
+        int32_t Shared = -1;
+        for (size_t Depth = 0; Depth < Left.size() && Depth < Right.size() && Left[Depth] == Right[Depth]; ++Depth) {
+            Shared = static_cast<int32_t>(Left[Depth]);
+        }
+        return Shared;
+    }
+
+    void Resolver::ResolveElementField(MemberAccess& Member, const int32_t Layout) {
+        if (Layout < 0) {
+            Errors.push_back({ "The element type must be known to use '" + std::string(Member.Member) + "'", Member.Location });
+            return;
+        }
+        const TypeLayout& Type = Target.Types[static_cast<size_t>(Layout)];
+        const int32_t Field = Type.FindField(Member.Member);
+        if (Field < 0) {
+            Errors.push_back({ Type.Name + " has no field " + std::string(Member.Member), Member.Location });
+            return;
+        }
+        Member.Symbol = { ESymbolKind::Field, static_cast<uint32_t>(Field), static_cast<uint32_t>(Layout) };
+    }
+
+    int32_t Resolver::ResolveCall(FunctionCall& Call) {
+        auto* Callee = Unwrap(Call.Callee)->As<Identifier>();
+        auto* Method = Unwrap(Call.Callee)->As<MemberAccess>();
+        auto* Element = Method != nullptr && !Method->IsOptional ? Unwrap(Method->Object)->As<IndexAccess>() : nullptr;
+        SymbolRef Bound;
+
+        if (Element != nullptr) {
+            // All[I].Fetch_Health() calls the accessor or method of the array's element type
+            const int32_t Layout = Resolve(Element->Object);
+            Resolve(Element->Index);
+            const int32_t Accessor = Layout >= 0 ? Target.Types[static_cast<size_t>(Layout)].FindMethod(Method->Member) : -1;
+            Method->Symbol = {};
+            if (Accessor >= 0) {
+                Method->Symbol = { ESymbolKind::Function, static_cast<uint32_t>(Accessor), static_cast<uint32_t>(Layout) };
+                Bound = Method->Symbol;
+            } else {
+                Errors.push_back({ Layout < 0 ? "The element type must be known to call '" + std::string(Method->Member) + "'"
+                                              : Target.Types[static_cast<size_t>(Layout)].Name + " has no method " +
+                                                    std::string(Method->Member),
+                                   Call.Location });
+            }
+        } else if (const int32_t Interface = Method != nullptr && !Method->IsOptional ? InterfaceOfLocal(Method->Object) : -1;
+                   Interface >= 0) {
+            // Target.TakeDamage(5) calls through the Interface the local was declared with
+            const InterfaceLayout& Used = Target.Interfaces[static_cast<size_t>(Interface)];
+            const int32_t Slot = Used.FindMethod(Method->Member);
+            Resolve(Method->Object);
+            Method->Symbol = {};
+            if (Slot >= 0) {
+                Method->Symbol = { ESymbolKind::Interface, static_cast<uint32_t>(Interface), static_cast<uint32_t>(Slot) };
+            } else {
+                Errors.push_back({ Used.Name + " has no method " + std::string(Method->Member), Call.Location });
+            }
+        } else if (Callee == nullptr) {
+            Resolve(Call.Callee);
+        } else if (const SymbolRef* Found = Lookup(Callee->Name);
+                   Found != nullptr && (Found->Kind == ESymbolKind::Local || Found->Kind == ESymbolKind::Function ||
+                                        Found->Kind == ESymbolKind::Native)) {
+            Callee->Symbol = *Found;
+            Bound = *Found;
+        } else {
+            Callee->Symbol = {};
+            Errors.push_back({ "Unknown function '" + std::string(Callee->Name) + "'", Call.Location });
+        }
+
+        for (Expression* Argument : Call.Arguments) {
+            Resolve(Argument);
+        }
+
+        if (Bound.Kind != ESymbolKind::Function) {
+            return -1;
+        }
+        const FunctionDeclaration* Signature = Signatures[Bound.Index];
+        if (Signature == nullptr) {
+            return -1;
+        }
+        for (size_t Index = 0; Index < Call.Arguments.size() && Index < Signature->Parameters.size(); ++Index) {
+            Expect(Call.Arguments[Index], InterfaceOf(Signature->Parameters[Index].Type));
+        }
+        return LayoutOf(Signature->ReturnType);
+    }
+
+    int32_t Resolver::InterfaceOfLocal(Expression* Object) const {
+        const auto* Name = Unwrap(Object)->As<Identifier>();
+        const SymbolRef* Found = Name != nullptr ? Lookup(Name->Name) : nullptr;
+        return Found != nullptr && Found->Kind == ESymbolKind::Local ? Interfaces[Found->Index] : -1;
+    }
+
+    void Resolver::ResolveName(Identifier& Name) {
+        const SymbolRef* Found = Lookup(Name.Name);
+        if (Found != nullptr && (Found->Kind == ESymbolKind::Local || Found->Kind == ESymbolKind::Global)) {
+            Name.Symbol = *Found;
+            return;
+        }
+        Name.Symbol = {};
+        Errors.push_back({ Found != nullptr ? "'" + std::string(Name.Name) + "' is not a value"
+                                            : "Unknown name '" + std::string(Name.Name) + "'",
+                           Name.Location });
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "Bytecode.h"
+#include "Compiler.h"
+#include "Declaration.h"
+#include "SymbolTable.h"
+
+namespace Vex {
+
+    /**
+     * Binds the names of a function to what they refer to, before the
+     * Compiler emits its code
+     *
+     * Every Identifier the VM compiles gets a SymbolRef: a local, a global
+     * slot, or, where it is called, a function or native. Locals are
+     * numbered per function in declaration order, parameters first, and
+     * each VariableDeclaration and for loop records the slot it declares,
+     * so two locals of the same name never share one. `Array[I].Field`
+     * is bound to the Define and field when the array's element type is
+     * known at that point: from a declared Type[], or from the `new`, call
+     * or assignment that last gave a local its value. A local given arrays
+     * of two Defines is bound to the nearest one both extend, or left
+     * unbound if there is none.
+     *
+     * In a Fetch or Set accessor, the target type's name stands for the
+     * element the accessor was called on: `Entity.Health` is bound like
+     * `Array[I].Health`, to two hidden slots ahead of the parameters
+     * holding the array and the index. A method of a Define gets the same
+     * slots, reached as `this.Radius`. `All[I].Fetch_Health()` is bound
+     * to the accessor's or method's function, as the array's element type
+     * declares or inherits it, when that type is known.
+     *
+     * A local declared with an Interface type, a parameter included, holds
+     * an element used through it: `Target.TakeDamage(5)` is bound to the
+     * Interface and the method's slot. `All[I]` given where an Interface
+     * is expected (an argument for such a parameter, the initial or
+     * assigned value of such a local, or what a function returning one
+     * returns) is marked to be converted into one.
+     *
+     * Names are looked up in the blocks open around them, then in the
+     * Compiler's SymbolTable: the namespace the function is declared in,
+     * the namespaces it imports with Using, and each enclosing one.
+     * `A::B` names B in namespace A. The Compiler's table is only read;
+     * each Resolver pushes and pops blocks on a table of its own, so
+     * several can check functions at once, one per thread.
+     *
+     * The Compiler turns bindings straight into register, slot and field
+     * operands, so no name is looked up when the code runs. Names that
+     * refer to nothing, locals declared twice in one block, fields a known
+     * Define does not have, and fields of arrays whose Define is not known,
+     * are reported here.
+     *
+     * Example:
+     *   Resolver Names(Program, Symbols, Signatures, GlobalLayouts, Errors);
+     *   const uint32_t Slots = Names.ResolveFunction(*Function, Namespace);
+     */
+    class Resolver {
+    public:
+        Resolver(const Program& Target, const SymbolTable& Symbols, const std::vector<const FunctionDeclaration*>& Signatures,
+                 const std::vector<int32_t>& GlobalLayouts, std::vector<CompileError>& Errors)
+            : Target(Target), Symbols(Symbols), Signatures(Signatures), GlobalLayouts(GlobalLayouts), Errors(Errors) {}
+
+        /** Binds Function's parameters and body; returns how many local slots it uses */
+        uint32_t ResolveFunction(FunctionDeclaration& Function, ScopeId Namespace);
+
+        /**
+         * Binds an accessor or method of Define Layout, whose element Target names (this, for a method); slots 0
+         * and 1 are the array and index
+         */
+        uint32_t ResolveAccessor(FunctionDeclaration& Accessor, ScopeId Namespace, std::string_view Target, int32_t Layout);
+
+        /**
+         * Binds an expression evaluated outside any function, such as a global's initializer; returns the layout of
+         * the array it evaluates to, or -1 if unknown
+         */
+        int32_t ResolveGlobal(Expression* Initializer, ScopeId Namespace);
+
+        /** Program::Types index of the elements of an array of this type, as named from Namespace, or -1 */
+        [[nodiscard]] int32_t LayoutOf(const TypeRef* Type, ScopeId Namespace) const;
+
+        /** Program::Interfaces index of this type, as named from Namespace, or -1 if it is not an Interface */
+        [[nodiscard]] int32_t InterfaceOf(const TypeRef* Type, ScopeId Namespace) const;
+
+    private:
+        const Program& Target;
+        const SymbolTable& Symbols;
+        const std::vector<const FunctionDeclaration*>& Signatures;
+        const std::vector<int32_t>& GlobalLayouts;  // By global slot, like Layouts
+        std::vector<CompileError>& Errors;
+
+        SymbolTable Locals;                         // Open blocks only
+        ScopeId Namespace = SymbolTable::GlobalScope;
+        std::vector<int32_t> Layouts;               // By slot: Program::Types index of an array's elements, or -1
+        std::vector<int32_t> Interfaces;            // By slot: Program::Interfaces index of its declared type, or -1
+        int32_t Self = -1;                          // Slot of the array an accessor or method was called on, or -1
+        int32_t Returns = -1;                       // Interface the function returns, or -1
+
+        uint32_t Declare(std::string_view Name, int32_t Layout, SourceLocation Location, int32_t Interface = -1);
+
+        /** A local in the open blocks, else what Name means from Namespace; null if nothing */
+        [[nodiscard]] const SymbolRef* Lookup(std::string_view Name) const;
+        [[nodiscard]] int32_t LayoutOf(const TypeRef* Type) const { return LayoutOf(Type, Namespace); }
+        [[nodiscard]] int32_t InterfaceOf(const TypeRef* Type) const { return InterfaceOf(Type, Namespace); }
+
+        /** Marks Value to be converted to Interface if it is an array element; nothing if Interface is -1 */
+        static void Expect(Expression* Value, int32_t Interface);
+
+        void ResolveStatement(Statement& Stmt);
+        void ResolveScoped(Statement& Body);
+
+        /** Binds the names in Expr; returns the layout of the array it evaluates to, or -1 if unknown */
+        int32_t Resolve(Expression* Expr);
+        int32_t ResolveAssignment(BinaryExpression& Assign);
+
+        /** Layout of a local that held arrays of Held and is now given one of Given */
+        [[nodiscard]] int32_t Join(int32_t Held, int32_t Given) const;
+        int32_t ResolveCall(FunctionCall& Call);
+
+        /** Interface a local named by Object was declared with, or -1 */
+        [[nodiscard]] int32_t InterfaceOfLocal(Expression* Object) const;
+        void ResolveElementField(MemberAccess& Member, int32_t Layout);
+        void ResolveName(Identifier& Name);
+    };
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+
+// Forward declarations of all test functions
+void Test_VM_001_BytecodeVM();
+void Test_VM_002_MathIntrinsics();
+void Test_VM_003_DefineArrays();
+void Test_VM_004_NameResolution();
+void Test_VM_005_ParallelChecking();
+void Test_VM_006_MatchDispatch();
+void Test_VM_007_SharedReferences();
+void Test_VM_008_FrameArrays();
+void Test_VM_009_Allocators();
+void Test_VM_010_Inlining();
+void Test_VM_011_Devirtualization();
+void Test_VM_012_Interfaces();
+
+int main() {
+    std::cout << "========================================" << "\n";
+    std::cout << " VEX VM TEST SUITE" << "\n";
+    std::cout << "========================================" << "\n\n";
+
+    try {
+        Test_VM_001_BytecodeVM();
+        Test_VM_002_MathIntrinsics();
+        Test_VM_003_DefineArrays();
+        Test_VM_004_NameResolution();
+        Test_VM_005_ParallelChecking();
+        Test_VM_006_MatchDispatch();
+        Test_VM_007_SharedReferences();
+        Test_VM_008_FrameArrays();
+        Test_VM_009_Allocators();
+        Test_VM_010_Inlining();
+        Test_VM_011_Devirtualization();
+        Test_VM_012_Interfaces();
+
+        std::cout << "\n";
+
+        std::cout << "========================================" << "\n";
+        std::cout << " ALL TESTS PASSED!" << "\n";
+        std::cout << "========================================" << "\n";
+
+        return 0;
+
+    } catch (const std::exception& E) {
+        std::cerr << "Test failed with exception: " << E.what() << "\n";
+        return 1;
+    } catch (...) {
+        std::cerr << "Test failed with unknown exception" << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,314 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../VM.h"
+#include "ConstantFolder.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    /** Parses, folds and compiles Source; the VM is null if anything failed */
+    struct CompiledScript {
+        ASTContext Context;
+        Program Code;
+        std::vector<CompileError> Errors;
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit CompiledScript(const std::string& Source, const bool Fold = true) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            if (Fold) {
+                FoldConstants(Unit, Context);
+            }
+
+            Code.AddNative("Sqrt", [](const Value* Arguments) { return Value::MakeFloat(std::sqrt(Arguments[0].ToFloat())); }, 1);
+
+            Compiler Compiler(Code);
+            if (Compiler.Compile(Unit)) {
+                VM = std::make_unique<VirtualMachine>(Code);
+            }
+            Errors = Compiler.GetErrors();
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            assert(VM != nullptr);
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+    };
+
+    long long RunInt(const std::string& Source, const std::string& Name = "Main") {
+        CompiledScript Script(Source);
+        const Value Result = Script.Run(Name);
+        assert(Result.Type == EValueType::Int);
+        return Result.Int;
+    }
+
+    /** Value of an expression, computed at run time (no folding) */
+    Value Evaluate(const std::string& Expression) {
+        CompiledScript Script("Main() -> Void { Var One = 1; Var Zero = 0; return " + Expression + "; }", false);
+        return Script.Run("Main");
+    }
+
+    /** Whether an expression of literals gives the same result folded as computed at run time */
+    bool FoldsAlike(const std::string& Expression) {
+        CompiledScript Folded("Main() -> Void { return " + Expression + "; }");
+        CompiledScript Computed("Main() -> Void { return " + Expression + "; }", false);
+        const Value Left = Folded.Run("Main");
+        const Value Right = Computed.Run("Main");
+        return Left.Type == Right.Type && Left.ToString() == Right.ToString();
+    }
+
+    /** As Evaluate(), for results that point into the VM */
+    std::string EvaluateText(const std::string& Expression) {
+        CompiledScript Script("Main() -> Void { Var One = 1; return " + Expression + "; }", false);
+        return Script.Run("Main").ToString();
+    }
+}
+
+void Test_VM_001_BytecodeVM() {
+    std::cout << "--- VM Test 001: Bytecode Compiler and VM ---" << "\n";
+
+    // Operators agree with the constant folder, including its edge cases
+    {
+        assert(Evaluate("(One + 2) * 3").Int == 9);
+        assert(Evaluate("9223372036854775807 + One").Int == std::numeric_limits<long long>::min());
+        assert(Evaluate("-7 / (One * 2)").Int == -3);
+        assert(Evaluate("-7 % (One * 2)").Int == -1);
+        assert(Evaluate("(-9223372036854775807 - One) / -One").Int == std::numeric_limits<long long>::min());
+        assert(Evaluate("2 ** (One - 2)").Int == 0);
+        assert(Evaluate("(-One) ** -3").Int == -1);
+        assert(Evaluate("One << 65").Int == 2);
+        assert(Evaluate("-16 >> (One + 1)").Int == -4);
+        assert(Evaluate("~Zero & 6 | One ^ 2").Int == 7);
+        assert(Evaluate("One + 0.5").Float == 1.5);
+        assert(Evaluate("7.5 % (One * 2)").Float == 1.5);
+        assert(Evaluate("(One + 1) ** 0.5").Float == std::sqrt(2.0));
+        assert(Evaluate("One + 1 as Float").Type == EValueType::Float);
+        assert(Evaluate("(One * 7.9) as Int").Int == 7);
+        assert(Evaluate("One == 1.0").Bool && !Evaluate("One === 1.0").Bool && Evaluate("One !== 1.0").Bool);
+        assert(!Evaluate("One == \"1\"").Bool && Evaluate("null == null").Bool);
+        assert(Evaluate("One > 0 && Zero >= 0 && One <= 1 && 0.5 < One").Bool);
+        assert(Evaluate("\"Ab\" < \"B\"").Bool);
+        assert(EvaluateText("\"Fire\" + \"ball\"") == "Fireball");
+        assert(Evaluate("\"Fire\" + \"ball\" == \"Fireball\"").Bool);
+        assert(Evaluate("null ?? One").Int == 1 && Evaluate("Zero ?? One").Int == 0);
+        assert(Evaluate("One > 0 ? 10 : 20").Int == 10);
+        assert(Evaluate("true & false | true ^ true").Bool == false);
+        assert(Evaluate("'A' + Zero").Int == 65);
+        for (const char* Mixed : { "'a' === 97", "97 === 'a'", "'a' !== 97", "'a' == 97", "'a' === 98", "'a' === 97.0", "'a' === 'a'" }) {
+            assert(FoldsAlike(Mixed));
+        }
+        assert(Evaluate("'a' === 97").Bool);
+
+        std::cout << "  ✓ Operators" << "\n";
+    }
+
+    // if, while, do-while, for with steps and ranges, break and continue
+    {
+        assert(RunInt(R"(
+            Main() -> Int {
+                Var Sum = 0;
+                for I in 0..10 { Sum += I; }
+                for I in 0..=10 step 5 { Sum += I * 100; }
+                for I in 10..0 step -3 { Sum += I * 10000; }
+                for I in 5..5 { Sum = -1; }
+                return Sum;
+            }
+        )") == 45 + 1500 + 220000);
+
+        assert(RunInt(R"(
+            Main() -> Int {
+                Var Count = 0;
+                Var I = 0;
+                while true {
+                    I += 1;
+                    if I % 2 == 0 { continue; }
+                    if I > 9 { break; }
+                    Count += 1;
+                }
+                do { Count += 100; } while Count < 300;
+                for J in 0..100 {
+                    if J == 3 { break; }
+                    for K in 0..100 { if K >= J { continue; } Count += 1000; }
+                }
+                return Count;
+            }
+        )") == 5 + 300 + 3000);
+
+        // The iterator is a copy: changing it does not steer the loop
+        assert(RunInt("Main() -> Int { Var N = 0; for I in 0..4 { I = 100; N += 1; } return N; }") == 4);
+
+        // Float loops, and bounds evaluated once
+        assert(RunInt(R"(
+            Main() -> Int {
+                Var Steps = 0;
+                Var Limit = 1.0;
+                for X in 0..Limit step 0.25 { Steps += 1; Limit = 100.0; }
+                return Steps;
+            }
+        )") == 4);
+
+        // The last Int loop step stops instead of overflowing
+        assert(RunInt("Main() -> Int { Var N = 0; for I in 9223372036854775806..=9223372036854775807 { N += 1; } return N; }") == 2);
+
+        std::cout << "  ✓ Control flow" << "\n";
+    }
+
+    // match compares in order; _ takes the rest
+    {
+        const std::string Source = R"(
+            Classify(Value: Int) -> Int {
+                Var Result = 0;
+                match Value {
+                    0 -> Result = 10;
+                    1 -> { Result = 20; }
+                    2 -> return 30;
+                    _ -> Result = -1;
+                }
+                return Result;
+            }
+            NoDefault(Value: Int) -> Int {
+                Var Result = 5;
+                match Value * 2 { 4 -> Result = 6; }
+                return Result;
+            }
+        )";
+        CompiledScript Script(Source);
+        assert(Script.Run("Classify", { Value::MakeInt(0) }).Int == 10);
+        assert(Script.Run("Classify", { Value::MakeInt(1) }).Int == 20);
+        assert(Script.Run("Classify", { Value::MakeInt(2) }).Int == 30);
+        assert(Script.Run("Classify", { Value::MakeInt(7) }).Int == -1);
+        assert(Script.Run("NoDefault", { Value::MakeInt(2) }).Int == 6);
+        assert(Script.Run("NoDefault", { Value::MakeInt(3) }).Int == 5);
+
+        std::cout << "  ✓ match" << "\n";
+    }
+
+    // Calls: recursion, defaults, natives, globals and initializers
+    {
+        const std::string Source = R"(
+            global Var Calls: Int = 0;
+            global Const Scale: Float = Base * 2.0;
+            global Const Base: Float = 1.5;
+            global Var Name: String = "Vex";
+
+            Fib(N: Int) -> Int {
+                Calls += 1;
+                if N < 2 { return N; }
+                return Fib(N - 1) + Fib(N - 2);
+            }
+            Hypot(X: Float, Y: Float = 4.0) -> Float { return Sqrt(X * X + Y * Y); }
+            Five() -> Float { return Hypot(3.0); }
+            Even(N: Int) -> Bool { return N == 0 ? true : Odd(N - 1); }
+            Odd(N: Int) -> Bool { return N == 0 ? false : Even(N - 1); }
+            Greet() -> String { Name = Name + "!"; return Name; }
+            Nothing() -> Void { Calls = -1; }
+        )";
+        CompiledScript Script(Source);
+        assert(Script.Run("Fib", { Value::MakeInt(20) }).Int == 6765);
+        assert(Script.VM->GetGlobal("Calls").Int == 21891);
+        assert(Script.Run("Five").Float == 5.0);
+        assert(Script.Run("Hypot", { Value::MakeInt(5), Value::MakeInt(12) }).Float == 13.0);
+        assert(Script.Run("Even", { Value::MakeInt(101) }).Bool == false);
+        assert(Script.VM->GetGlobal("Scale").Float == 3.0);
+        assert(*Script.Run("Greet").String == "Vex!");
+        assert(*Script.Run("Greet").String == "Vex!!");
+        assert(Script.Run("Nothing").IsNull() && Script.VM->GetGlobal("Calls").Int == -1);
+
+        std::cout << "  ✓ Calls and globals" << "\n";
+    }
+
+    // Assignment as an expression writes through and yields the value
+    {
+        assert(RunInt(R"(
+            Main() -> Int {
+                Var A = 1;
+                Var B = 2;
+                A = B = A + B;
+                B = B > 2 && A > 2 ? A * 10 : 0;
+                return A + B;
+            }
+        )") == 3 + 30);
+
+        std::cout << "  ✓ Assignment" << "\n";
+    }
+
+    // Mistakes found while compiling, with locations
+    {
+        CompiledScript Unknown("Main() -> Int {\n    return Missing + 1;\n}\n");
+        assert(Unknown.VM == nullptr && Unknown.Errors.size() == 1);
+        assert(Unknown.Errors[0].Message == "Unknown name 'Missing'" && Unknown.Errors[0].Location.Line == 2);
+
+        CompiledScript Arity("F(A: Int, B: Int = 2) -> Int { return A + B; }\nMain() -> Int { return F(); }");
+        assert(Arity.Errors.size() == 1 && Arity.Errors[0].Message == "'F' takes 2 arguments, got 0");
+
+        CompiledScript Constant("Main() -> Void { Const Limit = 3; Limit = 4; }", false);
+        assert(Constant.Errors.size() == 1 && Constant.Errors[0].Message == "Cannot assign to Const 'Limit'");
+
+        CompiledScript Outside("Main() -> Void { break; }");
+        assert(Outside.Errors.size() == 1 && Outside.Errors[0].Message == "break outside a loop");
+
+        CompiledScript Member("Main(Entity: Int) -> Int { return Entity.Health; }");
+        assert(Member.Errors.size() == 1 && Member.Errors[0].Message == "MemberAccess is not supported by the VM yet");
+
+        std::cout << "  ✓ Compile errors" << "\n";
+    }
+
+    // Run time failures stop the call and say where
+    {
+        CompiledScript Script("Divide(A: Int, B: Int) -> Int {\n    Var Q = A / B;\n    return Q;\n}\n"
+                      "Test(A: Int) -> Int {\n    if A { return 1; }\n    return 0;\n}\n"
+                      "Forever(N: Int) -> Int { return Forever(N + 1); }\n");
+        Value Result;
+        const Value Arguments[] = { Value::MakeInt(7), Value::MakeInt(0) };
+        assert(!Script.VM->Call(static_cast<uint32_t>(Script.Code.FindFunction("Divide")), Arguments, 2, Result));
+        assert(Script.VM->GetError().Message == "Integer division by zero");
+        assert(Script.VM->GetError().Function == "Divide" && Script.VM->GetError().Location.Line == 2);
+
+        assert(!Script.VM->Call("Test", { Value::MakeInt(1) }, Result));
+        assert(Script.VM->GetError().Message == "Condition must be Bool, not Int");
+
+        assert(!Script.VM->Call("Forever", { Value::MakeInt(0) }, Result));
+        assert(Script.VM->GetError().Message == "Stack overflow calling Forever");
+
+        assert(!Script.VM->Call("Divide", { Value::MakeInt(1) }, Result));
+
+        // Still usable afterwards
+        assert(Script.VM->Call("Divide", { Value::MakeInt(7), Value::MakeInt(2) }, Result) && Result.Int == 3);
+        assert(!Script.VM->HasError());
+
+        std::cout << "  ✓ Runtime errors" << "\n";
+    }
+
+    // Code shape: locals are operands in place, loops are one instruction per step
+    {
+        CompiledScript Script("Sum(N: Int) -> Int { Var Total = 0; for I in 0..N { Total += I; } return Total; }");
+        const Function& Sum = Script.Code.Functions[static_cast<size_t>(Script.Code.FindFunction("Sum"))];
+        const std::string Listing = Script.Code.Disassemble(Sum);
+        assert(Listing.find("5\tADD R1 R1 R5\n  6\tFORLOOP R2 -2") != std::string::npos);
+        assert(Listing.find("ADD R1 R1") == Listing.rfind("ADD R1 R1"));
+        assert(Sum.RegisterCount == 6 && Sum.Code.size() == Sum.Locations.size());
+
+        // Equal constants share a slot
+        CompiledScript Pool("Main() -> Float { return 2.5 + 2.5 * 100000; }", false);
+        assert(Pool.Code.Constants.size() == 2);
+
+        std::cout << "  ✓ Code shape" << "\n";
+    }
+}
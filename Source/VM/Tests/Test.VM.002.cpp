@@ -0,0 +1,213 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../Intrinsics.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    /** Parses and compiles Source with the math natives; the VM is null if compiling failed */
+    struct MathScript {
+        ASTContext Context;
+        Program Code;
+        std::vector<CompileError> Errors;
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit MathScript(const std::string& Source) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            AddMathNatives(Code);
+            Compiler Compiler(Code);
+            if (Compiler.Compile(Unit)) {
+                VM = std::make_unique<VirtualMachine>(Code);
+            }
+            Errors = Compiler.GetErrors();
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            assert(VM != nullptr);
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const {
+            return Code.Disassemble(Code.Functions[static_cast<size_t>(Code.FindFunction(Name))]);
+        }
+    };
+
+    Value Vector(const float X, const float Y, const float Z) { return Value::MakeMath(EValueType::Vector3, X, Y, Z); }
+
+    bool Near(const Value& Result, const EValueType Type, const float X, const float Y, const float Z = 0.0f, const float W = 0.0f) {
+        const float Expected[4] = { X, Y, Z, W };
+        for (int Lane = 0; Lane < 4; ++Lane) {
+            if (std::fabs(Result.Lanes[Lane] - Expected[Lane]) > 1e-5f) {
+                return false;
+            }
+        }
+        return Result.Type == Type;
+    }
+
+    /** Value of Expression, where P and Q are vectors the compiler cannot type */
+    Value Evaluate(const std::string& Expression) {
+        MathScript Script("Hide(V: Thing) -> Thing { return V; }"
+                          "Main() -> Void { Var P = Hide(Vector3(1, 2, 3)); Var Q = Hide(Vector3(-4, 5, 0.5)); return " +
+                          Expression + "; }");
+        return Script.Run("Main");
+    }
+}
+
+void Test_VM_002_MathIntrinsics() {
+    std::cout << "--- VM Test 002: Math Types and Intrinsics ---" << "\n";
+
+    // Operators on declared math types compile to one MATH each
+    {
+        MathScript Script(R"(
+            Step(Position: Vector3, Velocity: Vector3, Dt: Float) -> Vector3 {
+                return Position + Velocity * Dt;
+            }
+            Drift(Position: Vector3, Velocity: Vector3) -> Vector3 {
+                Var Result = Position;
+                Result += Velocity * 0.5;
+                Result -= 2 * Velocity;
+                return Result / 2;
+            }
+        )");
+
+        const Value Moved = Script.Run("Step", { Vector(1, 2, 3), Vector(10, 20, 30), Value::MakeFloat(0.5) });
+        assert(Near(Moved, EValueType::Vector3, 6, 12, 18));
+        assert(Near(Script.Run("Drift", { Vector(1, 2, 3), Vector(2, 4, 6) }), EValueType::Vector3, -1, -2, -3));
+
+        const std::string Step = Script.Listing("Step");
+        assert(Step.find("MATH") != std::string::npos && Step.find("ScaleVector3") != std::string::npos);
+        assert(Step.find("AddVector3") != std::string::npos && Step.find("\tADD") == std::string::npos);
+        assert(Step.find("\tMUL") == std::string::npos);
+
+        const std::string Drift = Script.Listing("Drift");
+        assert(Drift.find("ScaledVector3") != std::string::npos && Drift.find("ShrinkVector3") != std::string::npos);
+        assert(Drift.find("\tADD") == std::string::npos && Drift.find("\tSUB") == std::string::npos);
+
+        std::cout << "  ✓ Typed operators lower to intrinsics" << "\n";
+    }
+
+    // The same operators on values the compiler cannot type go through the generic opcodes
+    {
+        assert(Near(Evaluate("P + Q"), EValueType::Vector3, -3, 7, 3.5f));
+        assert(Near(Evaluate("P - Q * 2"), EValueType::Vector3, 9, -8, 2));
+        assert(Near(Evaluate("-P"), EValueType::Vector3, -1, -2, -3));
+        assert(Near(Evaluate("Vector2(1, 2) / Vector2(4, 8)"), EValueType::Vector2, 0.25f, 0.25f));
+        assert(Near(Evaluate("Vector4(1, 2, 3, 4) * 0.5"), EValueType::Vector4, 0.5f, 1, 1.5f, 2));
+        assert(Near(Evaluate("Color(1, 0.5, 0, 1) * Color(0.5, 0.5, 0.5, 0.5)"), EValueType::Color, 0.5f, 0.25f, 0, 0.5f));
+        assert(Evaluate("P == Vector3(1, 2, 3)").Bool && Evaluate("P != Q").Bool && !Evaluate("P == Q").Bool);
+        assert(!Evaluate("P == Vector4(1, 2, 3, 0)").Bool);
+
+        // A wrong declared type only costs the fast path
+        MathScript Script(R"(
+            Untyped(A: Thing, B: Thing) -> Thing { return A + B; }
+            Wrong(A: Vector3, B: Vector3) -> Vector3 { return A * B; }
+        )");
+        assert(Script.Listing("Untyped").find("MATH") == std::string::npos);
+        assert(Near(Script.Run("Untyped", { Vector(1, 1, 1), Vector(1, 2, 3) }), EValueType::Vector3, 2, 3, 4));
+        assert(Script.Listing("Wrong").find("MulVector3") != std::string::npos);
+        assert(Script.Run("Wrong", { Value::MakeInt(6), Value::MakeInt(7) }).Int == 42);
+        assert(Near(Script.Run("Wrong", { Value::MakeFloat(2), Vector(1, 2, 3) }), EValueType::Vector3, 2, 4, 6));
+
+        std::cout << "  ✓ Untyped and mistyped operands" << "\n";
+    }
+
+    // Quaternions: product, rotation and the natives
+    {
+        MathScript Script(R"(
+            Turn(Q: Quat, V: Vector3) -> Vector3 { return Q * V; }
+            Twice(Q: Quat) -> Quat { return Q * Q; }
+            Main() -> Vector3 {
+                Var Quarter = AxisAngle(Vector3(0, 0, 1), 1.5707963);
+                return Turn(Quarter * Quarter, Vector3(1, 2, 3));
+            }
+        )");
+        assert(Script.Listing("Turn").find("RotateVector3") != std::string::npos);
+        assert(Script.Listing("Main").find("MulQuat") != std::string::npos);
+        assert(Near(Script.Run("Main"), EValueType::Vector3, -1, -2, 3));
+
+        const Value Identity = Value::MakeMath(EValueType::Quat, 0, 0, 0, 1);
+        assert(Near(Script.Run("Twice", { Identity }), EValueType::Quat, 0, 0, 0, 1));
+
+        assert(Near(Evaluate("Slerp(Quat(0, 0, 0, 1), AxisAngle(Vector3(0, 0, 1), 1.5707963), 0.5)"), EValueType::Quat, 0, 0,
+                    std::sin(3.14159265f / 8.0f), std::cos(3.14159265f / 8.0f)));
+        assert(Near(Evaluate("Rotate(AxisAngle(Vector3(0, 0, 1), 1.5707963), Vector3(1, 0, 0))"), EValueType::Vector3, 0, 1, 0));
+
+        std::cout << "  ✓ Quaternions" << "\n";
+    }
+
+    // Lanes, natives and formatting
+    {
+        assert(Evaluate("P.X + P.Y * P.Z").Float == 7.0);
+        assert(Evaluate("Color(0.25, 0.5, 0.75, 1).B").Float == 0.75);
+        assert(Evaluate("Dot(P, Q)").Float == 7.5);
+        assert(Near(Evaluate("Cross(Vector3(1, 0, 0), Vector3(0, 1, 0))"), EValueType::Vector3, 0, 0, 1));
+        assert(Evaluate("Length(Vector3(3, 4, 12))").Float == 13.0);
+        assert(Near(Evaluate("Normalize(Vector2(3, 4))"), EValueType::Vector2, 0.6f, 0.8f));
+        assert(Near(Evaluate("Lerp(P, Q, 0.5)"), EValueType::Vector3, -1.5f, 3.5f, 1.75f));
+        assert(Evaluate("Lerp(1, 3, 0.25)").Float == 1.5);
+        assert(Evaluate("Dot(P, 1)").IsNull() && Evaluate("Vector3(1, true, 3)").IsNull());
+        assert(Evaluate("P").ToString() == "Vector3(1, 2, 3)");
+        assert(Evaluate("Color(1, 0.5, 0, 1)").ToString() == "Color(1, 0.5, 0, 1)");
+
+        MathScript Typed("Main() -> Float { Var V: Vector3 = Vector3(1, 2, 3); Var Sum = V.X; Sum += V.Z; return Sum; }");
+        assert(Typed.Run("Main").Float == 4.0);
+
+        // Two-argument math natives on typed vectors run their kernel in place
+        MathScript Calls(R"(
+            Project(A: Vector3, B: Vector3) -> Float { return Dot(A, B) + Dot(Cross(A, B), A); }
+            Loose(A: Thing, B: Vector3) -> Float { return Dot(A, B); }
+            Mistyped(A: Vector3, B: Vector3) -> Float { return Dot(A, B); }
+        )");
+        const std::string Project = Calls.Listing("Project");
+        assert(Project.find("DotVector3") != std::string::npos && Project.find("CrossVector3") != std::string::npos);
+        assert(Project.find("CALLNATIVE") == std::string::npos);
+        assert(Calls.Run("Project", { Vector(1, 2, 3), Vector(4, 5, 6) }).Float == 32.0);
+        assert(Calls.Listing("Loose").find("CALLNATIVE") != std::string::npos);
+        assert(Calls.Run("Loose", { Vector(1, 0, 0), Vector(2, 0, 0) }).Float == 2.0);
+        const Value Flat = Value::MakeMath(EValueType::Vector2, 3, 4);
+        assert(Calls.Run("Mistyped", { Flat, Flat }).Float == 25.0);
+
+        std::cout << "  ✓ Lanes and natives" << "\n";
+    }
+
+    // Errors
+    {
+        MathScript Missing("Main() -> Float { Var V = Vector2(1, 2); return V.Z; }");
+        assert(Missing.VM == nullptr && Missing.Errors[0].Message == "Vector2 has no member Z");
+
+        MathScript Other("Main() -> Float { Var V = Vector2(1, 2); return V.Length; }");
+        assert(Other.VM == nullptr && Other.Errors[0].Message == "MemberAccess is not supported by the VM yet");
+
+        MathScript Script(R"(
+            Lane(Value: Thing) -> Float { return Value.Y; }
+            Mixed(V: Vector3) -> Vector3 { return V + Vector2(1, 2); }
+        )");
+        Value Result;
+        assert(!Script.VM->Call("Lane", { Value::MakeInt(1) }, Result));
+        assert(Script.VM->GetError().Message == "Int has no lane 1");
+        assert(Script.VM->Call("Lane", { Value::MakeMath(EValueType::Vector2, 1, 2) }, Result) && Result.Float == 2.0);
+        assert(!Script.VM->Call("Mixed", { Vector(1, 2, 3) }, Result));
+        assert(Script.VM->GetError().Message == "Cannot apply + to Vector3 and Vector2");
+
+        std::cout << "  ✓ Errors" << "\n";
+    }
+}
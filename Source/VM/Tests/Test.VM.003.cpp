@@ -0,0 +1,235 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../Intrinsics.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    /** Parses and compiles Source with the math natives; the VM is null if compiling failed */
+    struct ArrayScript {
+        ASTContext Context;
+        Program Code;
+        std::vector<CompileError> Errors;
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit ArrayScript(const std::string& Source) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            AddMathNatives(Code);
+            Compiler Compiler(Code);
+            if (Compiler.Compile(Unit)) {
+                VM = std::make_unique<VirtualMachine>(Code);
+            }
+            Errors = Compiler.GetErrors();
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            assert(VM != nullptr);
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+
+        /** Message of the runtime error Name stops with */
+        std::string Fail(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            assert(VM != nullptr && !VM->Call(Name, Arguments, Result));
+            return VM->GetError().Message;
+        }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const {
+            return Code.Disassemble(Code.Functions[static_cast<size_t>(Code.FindFunction(Name))]);
+        }
+    };
+
+    /** The same program over an array-of-structs or a structure-of-arrays Define */
+    std::string Entities(const bool SoA) {
+        return std::string(SoA ? "@SoA " : "") + R"(
+            Define Entity {
+                Health -> Int_32 = 100;
+                Armor -> Int_32;
+                Speed -> Float = -1.5;
+                Position -> Vector3;
+                Name -> String = "Grunt";
+            }
+
+            Spawn(Count: Int) -> Entity[] {
+                Var Made = new Entity[](Count);
+                for I in 0..Made.Count {
+                    Made[I].Armor = I * 2;
+                    Made[I].Position = Vector3(I, 0, 1);
+                }
+                return Made;
+            }
+
+            Hit(All: Entity[], Damage: Int) -> Void {
+                for I in 0..All.Count {
+                    All[I].Health -= Damage + All[I].Armor;
+                    All[I].Position += Vector3(0, 1, 0);
+                }
+            }
+
+            Total(All: Entity[]) -> Float {
+                Var Sum = 0.0;
+                for I in 0..All.Count {
+                    Sum += All[I].Health + All[I].Speed + All[I].Position.X + All[I].Position.Y;
+                }
+                return Sum;
+            }
+
+            Main() -> Float {
+                Var All = Spawn(4);
+                Hit(All, 10);
+                return Total(All);
+            }
+        )";
+    }
+}
+
+void Test_VM_003_DefineArrays() {
+    std::cout << "--- VM Test 003: Define Arrays and @SoA Layout ---" << "\n";
+
+    // Array types parse as a TypeRef flag and print back
+    {
+        ASTContext Context;
+        Parser Parser("Keep(All: Entity[], Some: Entity*[]) -> Entity[] { return new Entity[](3); }", Context);
+        const TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        assert(!Parser.HasErrors());
+        const auto* Keep = Unit->Declarations[0]->As<FunctionDeclaration>();
+        assert(Keep->Parameters[0].Type->IsArray && Keep->Parameters[0].Type->ToString() == "Entity[]");
+        assert(Keep->Parameters[1].Type->IsPointer && Keep->Parameters[1].Type->ToString() == "Entity*[]");
+        assert(Keep->ReturnType == Keep->Parameters[0].Type);
+        assert(Context.GetTypes().Get("Entity") != Keep->ReturnType);
+
+        std::cout << "  ✓ Array types" << "\n";
+    }
+
+    // Both layouts run the same code to the same result
+    {
+        ArrayScript AoS(Entities(false));
+        ArrayScript SoA(Entities(true));
+        assert(!AoS.Code.Types[0].IsSoA && SoA.Code.Types[0].IsSoA);
+
+        // 4 * 90 - (0 + 2 + 4 + 6) - 4 * 1.5 + (0 + 1 + 2 + 3) + 4 * 1
+        const double Expected = 360 - 12 - 6 + 6 + 4;
+        assert(AoS.Run("Main").Float == Expected);
+        assert(SoA.Run("Main").Float == Expected);
+
+        // Only the listing's notes tell the layouts apart
+        std::string Plain = SoA.Listing("Hit");
+        for (size_t At = Plain.find(" (SoA)"); At != std::string::npos; At = Plain.find(" (SoA)")) {
+            Plain.erase(At, 6);
+        }
+        assert(Plain == AoS.Listing("Hit") && Plain != SoA.Listing("Hit"));
+
+        // Field operators keep the declared types: the Vector3 field adds with one MATH
+        const std::string Hit = SoA.Listing("Hit");
+        assert(Hit.find("SETFIELD") != std::string::npos && Hit.find("Entity.Position (SoA)") != std::string::npos);
+        assert(Hit.find("AddVector3") != std::string::npos);
+        std::cout << "  ✓ AoS and SoA agree" << "\n";
+    }
+
+    // Cells: element by element, or one column per field
+    {
+        ArrayScript AoS(Entities(false));
+        ArrayScript SoA(Entities(true));
+        const Value Packed = AoS.Run("Spawn", { Value::MakeInt(3) });
+        const Value Columns = SoA.Run("Spawn", { Value::MakeInt(3) });
+        assert(Packed.Type == EValueType::Array && Packed.ToString() == "Entity[3]");
+
+        const auto& Fields = AoS.Code.Types[0].Fields;
+        assert(Fields.size() == 5 && Fields[0].Type == EValueType::Int && Fields[3].Type == EValueType::Vector3);
+        assert(Fields[2].Default.Float == -1.5 && Fields[1].Default.Int == 0 && *Fields[4].Default.String == "Grunt");
+
+        // Armor is field 1 and holds 0, 2, 4
+        for (long long Index = 0; Index < 3; ++Index) {
+            assert(Packed.Array->Cells[static_cast<size_t>(Index) * 5 + 1].Int == Index * 2);
+            assert(Columns.Array->Cells[3 + static_cast<size_t>(Index)].Int == Index * 2);
+            assert(Packed.Array->At(static_cast<size_t>(Index), 1).Int == Columns.Array->At(static_cast<size_t>(Index), 1).Int);
+        }
+        assert(Columns.Array->Cells[0].Int == 100 && Columns.Array->Cells[2].Int == 100);
+
+        ArrayScript Empty("@SoA Define Nothing {} Main() -> Int { Var None = new Nothing[](5); return None.Count; }");
+        assert(Empty.Run("Main").Int == 5);
+
+        std::cout << "  ✓ Cell layout" << "\n";
+    }
+
+    // Arrays are values: shared by reference, compared by identity
+    {
+        ArrayScript Script(R"(
+            @SoA Define Particle { Life -> Float = 1.0; }
+            Same() -> Bool {
+                Var A = new Particle[](2);
+                Var B = A;
+                B[1].Life = 0.25;
+                return A == B && A[1].Life == 0.25 && A != new Particle[](2);
+            }
+        )");
+        assert(Script.Run("Same").Bool);
+        std::cout << "  ✓ Array identity" << "\n";
+    }
+
+    // Compile errors
+    {
+        const std::string Define = "Define Entity { Health -> Int; } ";
+
+        ArrayScript Unknown(Define + "Main(All: Entity[]) -> Int { return All[0].Mana; }");
+        assert(Unknown.VM == nullptr && Unknown.Errors[0].Message == "Entity has no field Mana");
+
+        ArrayScript Whole(Define + "Main(All: Entity[]) -> Int { Var First = All[0]; return 0; }");
+        assert(Whole.Errors[0].Message == "Array elements can only be used through their fields");
+
+        ArrayScript Scalars("Main() -> Int { Var Numbers = new Int[](3); return 0; }");
+        assert(Scalars.Errors[0].Message == "Only arrays of Define types are supported by the VM yet");
+
+        ArrayScript Defaults("Define Entity { Health -> Int = Max(); }");
+        assert(Defaults.Errors[0].Message == "The default of Entity.Health must be a literal");
+
+        ArrayScript Twice(Define + Define);
+        assert(Twice.Errors[0].Message == "Type 'Entity' is already defined");
+
+        std::cout << "  ✓ Compile errors" << "\n";
+    }
+
+    // Runtime errors
+    {
+        ArrayScript Script(R"(
+            Define Entity { Health -> Int; }
+            Define Other { Health -> Int; }
+            Read(All: Entity[], Index: Int) -> Int { return All[Index].Health; }
+            Make(Count: Thing) -> Entity[] { return new Entity[](Count); }
+            Mixed() -> Int { Var All = new Other[](1); return Read(All, 0); }
+            Size(All: Thing) -> Int { return All.Count; }
+        )");
+        const Value All = Script.Run("Make", { Value::MakeInt(3) });
+        assert(Script.Run("Read", { All, Value::MakeInt(2) }).Int == 0);
+        assert(Script.Fail("Read", { All, Value::MakeInt(3) }) == "Index 3 is out of range for Entity[3]");
+        assert(Script.Fail("Read", { All, Value::MakeInt(-1) }) == "Index -1 is out of range for Entity[3]");
+        assert(Script.Fail("Read", { All, Value::MakeFloat(1) }) == "Array index must be an Int, not Float");
+        assert(Script.Fail("Read", { Value::MakeInt(1), Value::MakeInt(0) }) == "Expected Entity[], got Int");
+        assert(Script.Fail("Mixed") == "Expected Entity[], got Other[]");
+        assert(Script.Fail("Make", { Value::MakeInt(-2) }) == "Array size -2 is negative");
+        assert(Script.Fail("Make", { Value::MakeFloat(2) }) == "Array size must be an Int, not Float");
+        assert(Script.Fail("Make", { Value::MakeInt(1LL << 40) }) == "Entity[] of 1099511627776 elements is too large");
+        assert(Script.Run("Size", { All }).Int == 3);
+        assert(Script.Fail("Size", { Value::MakeInt(3) }) == "Cannot take the Count of Int");
+
+        std::cout << "  ✓ Runtime errors" << "\n";
+    }
+}
@@ -0,0 +1,292 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../Intrinsics.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    /** Parses and compiles Source, keeping the tree so its bindings can be inspected */
+    struct ResolvedScript {
+        ASTContext Context;
+        TranslationUnit* Unit = nullptr;
+        Program Code;
+        std::vector<CompileError> Errors;
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit ResolvedScript(const std::string& Source) {
+            Parser Parser(Source, Context);
+            Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            AddMathNatives(Code);
+            Compiler Compiler(Code);
+            if (Compiler.Compile(Unit)) {
+                VM = std::make_unique<VirtualMachine>(Code);
+            }
+            Errors = Compiler.GetErrors();
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            assert(VM != nullptr);
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+
+        std::string Fail(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            assert(VM != nullptr && !VM->Call(Name, Arguments, Result));
+            return VM->GetError().Message;
+        }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const {
+            return Code.Disassemble(Code.Functions[static_cast<size_t>(Code.FindFunction(Name))]);
+        }
+
+        /** Body statements of the Index-th declaration, a function */
+        [[nodiscard]] ArenaArray<Statement*>& Body(const size_t Index) const {
+            return Unit->Declarations[Index]->As<FunctionDeclaration>()->Body->Statements;
+        }
+    };
+
+    Expression* ReturnValue(Statement* Stmt) {
+        return Stmt->As<ReturnStatement>()->Value;
+    }
+}
+
+void Test_VM_004_NameResolution() {
+    std::cout << "--- VM Test 004: Name Resolution ---" << "\n";
+
+    // Every name is bound before code is emitted
+    {
+        ResolvedScript Script(R"(
+            global Var Total: Int = 0;
+            Define Entity { Health -> Int; Armor -> Int; }
+            Helper(X: Int) -> Int { return X; }
+            Main(All: Entity[], X: Int) -> Int {
+                Var Y = X;
+                {
+                    Var X = Y + 1;
+                    Total = X;
+                }
+                return Helper(X) + Vector2(Y, Total).Y as Int + All[0].Armor;
+            }
+            Spawn() -> Entity[] { return new Entity[](1); }
+        )");
+        assert(Script.VM != nullptr);
+
+        auto& Body = Script.Body(3);
+        const auto* Y = Body[0]->As<VariableDeclaration>();
+        assert(Y->Symbol.Kind == ESymbolKind::Local && Y->Symbol.Index == 2);
+        assert(Y->Initializer->As<Identifier>()->Symbol.Index == 1);
+
+        // The inner X is a slot of its own; Total is a global
+        auto& Inner = Body[1]->As<BlockStatement>()->Statements;
+        const auto* InnerX = Inner[0]->As<VariableDeclaration>();
+        assert(InnerX->Symbol.Kind == ESymbolKind::Local && InnerX->Symbol.Index == 3);
+        const auto* Store = Inner[1]->As<ExpressionStatement>()->Expr->As<BinaryExpression>();
+        assert(Store->Left->As<Identifier>()->Symbol.Kind == ESymbolKind::Global);
+        assert(Store->Right->As<Identifier>()->Symbol.Index == 3);
+
+        // Helper(X) + Vector2(Y, Total).Y as Int + All[0].Armor
+        const auto* Sum = ReturnValue(Body[2])->As<BinaryExpression>();
+        const auto* Calls = Sum->Left->As<BinaryExpression>();
+        const auto* Helper = Calls->Left->As<FunctionCall>();
+        assert(Helper->Callee->As<Identifier>()->Symbol.Kind == ESymbolKind::Function);
+        assert(Helper->Callee->As<Identifier>()->Symbol.Index == static_cast<uint32_t>(Script.Code.FindFunction("Helper")));
+        assert(Helper->Arguments[0]->As<Identifier>()->Symbol.Index == 1);
+        const auto* Make = Calls->Right->As<CastExpression>()->Expr->As<MemberAccess>()->Object->As<FunctionCall>();
+        assert(Make->Callee->As<Identifier>()->Symbol.Kind == ESymbolKind::Native);
+        assert(Make->Arguments[1]->As<Identifier>()->Symbol.Kind == ESymbolKind::Global);
+        const auto* Armor = Sum->Right->As<MemberAccess>();
+        assert(Armor->Symbol.Kind == ESymbolKind::Field && Armor->Symbol.Owner == 0 && Armor->Symbol.Index == 1);
+
+        // Helper(2) + 3 + 0
+        assert(Script.Run("Main", { Script.Run("Spawn"), Value::MakeInt(2) }).Int == 5);
+        assert(Script.VM->GetGlobal("Total").Int == 3);
+        std::cout << "  ✓ Bindings" << "\n";
+    }
+
+    // Shadowing follows scopes, and loop iterators get slots too
+    {
+        ResolvedScript Script(R"(
+            Main() -> Int {
+                Var X = 1;
+                Var Sum = 0;
+                for X in 10..13 {
+                    Var Y = X;
+                    Sum += Y;
+                }
+                {
+                    Var X = X + 100;
+                    Sum += X;
+                }
+                return Sum * 1000 + X;
+            }
+        )");
+        assert(Script.Run("Main").Int == (10 + 11 + 12 + 101) * 1000 + 1);
+
+        const auto* Loop = Script.Body(0)[2]->As<ForStatement>();
+        assert(Loop->Symbol.Kind == ESymbolKind::Local && Loop->Symbol.Index == 2);
+        std::cout << "  ✓ Scopes" << "\n";
+    }
+
+    // Every field access is bound to an index; fields of arrays whose Define is not known do not compile
+    {
+        const std::string Source = R"(
+            Define Entity { Health -> Int = 100; Armor -> Int = 3; }
+            Spawn(Count: Int) -> Entity[] { return new Entity[](Count); }
+            Typed(All: Entity[]) -> Int {
+                for I in 0..All.Count { All[I].Health -= All[I].Armor; }
+                return All[0].Health;
+            }
+            Read(All: Entity[], Index: Thing) -> Int { return All[Index].Health; }
+        )";
+        for (const bool SoA : { false, true }) {
+            ResolvedScript Script(std::string(SoA ? "@SoA " : "") + Source);
+            const Value All = Script.Run("Spawn", { Value::MakeInt(2) });
+            assert(Script.Run("Typed", { All }).Int == 97);
+            assert(All.Array->At(1, 0).Int == 97);
+            assert(Script.Listing("Typed").find("SETFIELD ") != std::string::npos);
+
+            assert(Script.Run("Read", { All, Value::MakeInt(1) }).Int == 97);
+            assert(Script.Fail("Read", { All, Value::MakeInt(2) }) == "Index 2 is out of range for Entity[2]");
+            assert(Script.Fail("Read", { All, Value::MakeFloat(0) }) == "Array index must be an Int, not Float");
+        }
+
+        ResolvedScript Loose(R"(
+            Define Entity { Health -> Int; Armor -> Int; }
+            Loose(All: Thing) -> Int {
+                for I in 0..All.Count { All[I].Health -= All[I].Armor; }
+                return All[0].Health;
+            }
+        )");
+        assert(Loose.VM == nullptr && Loose.Errors.size() == 3);
+        assert(Loose.Errors[0].Message == "The element type must be known to use 'Health'");
+        assert(Loose.Errors[1].Message == "The element type must be known to use 'Armor'");
+
+        // A global's Define comes from its declared type or its initializer
+        ResolvedScript Globals(R"(
+            Define Entity { Health -> Int = 5; }
+            global Var Typed: Entity[] = new Entity[](1);
+            global Var Made = new Entity[](2);
+            Main() -> Int { Made[1].Health += 1; return Typed[0].Health + Made[1].Health; }
+        )");
+        assert(Globals.Run("Main").Int == 11);
+        std::cout << "  ✓ Fields bound when compiling" << "\n";
+    }
+
+    // Names that refer to nothing are reported once, where they appear
+    {
+        ResolvedScript Unknown("Main() -> Int {\n    Var A = 1;\n    return A + Missing(B);\n}\n");
+        assert(Unknown.VM == nullptr && Unknown.Errors.size() == 2);
+        assert(Unknown.Errors[0].Message == "Unknown function 'Missing'" && Unknown.Errors[0].Location.Line == 3);
+        assert(Unknown.Errors[1].Message == "Unknown name 'B'");
+
+        ResolvedScript Local("Main(F: Int) -> Int { return F(1); }");
+        assert(Local.Errors.size() == 1 && Local.Errors[0].Message == "Only functions can be called by the VM yet");
+
+        ResolvedScript Field("Define Entity { Health -> Int; } Main(All: Entity[]) -> Void { All[0].Mana = 1; }");
+        assert(Field.Errors.size() == 1 && Field.Errors[0].Message == "Entity has no field Mana");
+
+        std::cout << "  ✓ Compile errors" << "\n";
+    }
+
+    // Namespaces qualify names, Using imports them, and nearer declarations hide farther ones
+    {
+        ResolvedScript Script(R"(
+            Namespace Engine::Math {
+                Dot(A: Int, B: Int) -> Int { return A * B; }
+                global Var Scale: Int = 10;
+            }
+            Namespace Engine {
+                Define Entity { Health -> Int = 7; }
+                Spawn() -> Entity[] { return new Entity[](2); }
+                Tick(All: Entity[]) -> Int { return Math::Dot(All[1].Health, Math::Scale); }
+            }
+            Namespace Game {
+                Using Engine::Math;
+                Dot(A: Int, B: Int) -> Int { return A + B; }
+                Near() -> Int { return Dot(2, 3); }
+                Imported() -> Int { return Scale + Engine::Math::Dot(2, 3); }
+            }
+            Main() -> Int {
+                Var Dot = 1;
+                return Engine::Tick(Engine::Spawn()) + Game::Near() + Dot;
+            }
+        )");
+        assert(Script.Errors.empty() && Script.VM != nullptr);
+        assert(Script.Code.FindFunction("Engine::Math::Dot") >= 0 && Script.Code.FindFunction("Dot") < 0);
+        assert(Script.Code.FindType("Engine::Entity") >= 0);
+        assert(Script.VM->GetGlobal("Engine::Math::Scale").Int == 10);
+
+        assert(Script.Run("Game::Near").Int == 5);
+        assert(Script.Run("Game::Imported").Int == 16);
+        assert(Script.Run("Main").Int == 70 + 5 + 1);
+        assert(Script.Listing("Engine::Tick").find("GETFIELDN") == std::string::npos);
+
+        // Using may name a namespace declared further down; natives are hidden by nearer functions
+        ResolvedScript Later(R"(
+            Using Tools;
+            Main() -> Int { return Twice(4); }
+            Namespace Tools { Twice(X: Int) -> Int { return X * 2; } }
+            Namespace Shapes { Length(X: Int) -> Int { return X; } Make() -> Int { return Length(3); } }
+        )");
+        assert(Later.Run("Main").Int == 8 && Later.Run("Shapes::Make").Int == 3);
+
+        std::cout << "  ✓ Namespaces and Using" << "\n";
+    }
+
+    // Declarations that clash, or names that are not what they are used as
+    {
+        ResolvedScript Twice("Main() -> Int {\n    Var A = 1;\n    Var A = 2;\n    return A;\n}\n");
+        assert(Twice.Errors.size() == 1 && Twice.Errors[0].Message == "'A' is already declared in this block");
+        assert(Twice.Errors[0].Location.Line == 3);
+
+        ResolvedScript Clash(R"(
+            Namespace Math { Dot() -> Int { return 1; } Dot() -> Int { return 2; } }
+            Main() -> Int { return Math; }
+            Namespace Main { }
+            Using Missing::Space;
+        )");
+        assert(Clash.Errors.size() == 4);
+        assert(Clash.Errors[0].Message == "'Math::Dot' is already defined");
+        assert(Clash.Errors[1].Message == "'Main' is already defined as something else");
+        assert(Clash.Errors[2].Message == "Unknown namespace 'Missing::Space'");
+        assert(Clash.Errors[3].Message == "'Math' is not a value");
+
+        std::cout << "  ✓ Declaration errors" << "\n";
+    }
+
+    // Program and layout lookups by name are hashed
+    {
+        Program Code;
+        AddMathNatives(Code);
+        const uint32_t Twice = Code.AddNative("Twice", [](const Value* Args) { return Value::MakeInt(Args[0].Int * 2); }, 1);
+        const uint32_t Shadow = Code.AddNative("Twice", [](const Value*) { return Value(); }, 1);
+        assert(Code.FindNative("Twice") == static_cast<int32_t>(Twice) && Shadow != Twice);
+        assert(Code.FindNative("Thrice") < 0);
+
+        TypeLayout& Layout = Code.Types[Code.AddType("Entity")];
+        for (int Index = 0; Index < 100; ++Index) {
+            Layout.AddField("Field" + std::to_string(Index)).Type = EValueType::Int;
+        }
+        assert(Layout.FindField("Field0") == 0 && Layout.FindField("Field99") == 99 && Layout.FindField("Field100") < 0);
+        assert(Layout.Fields[42].Name == "Field42");
+
+        std::cout << "  ✓ Hashed lookups" << "\n";
+    }
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "../Compiler.h"
+#include "../Intrinsics.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    /**
+     * Count functions spread over a few namespaces, each calling the one
+     * before it. With Errors, every seventh one refers to a name that
+     * does not exist and every eleventh declares a local twice.
+     */
+    std::string Generate(const int Count, const bool Errors) {
+        std::string Source = "Define Entity { Health -> Int = 10; }\n"
+                             "Spawn() -> Entity[] { return new Entity[](1); }\n";
+        for (int Index = 0; Index < Count; ++Index) {
+            const std::string Name = "F" + std::to_string(Index);
+            Source += "Namespace N" + std::to_string(Index % 4) + " {\n";
+            Source += "    " + Name + "(All: Entity[], X: Int) -> Int {\n";
+            Source += "        Var Sum = X + All[0].Health;\n";
+            Source += "        for I in 0..3 { Var Y = I * 2; Sum += Y; }\n";
+            if (Errors && Index % 7 == 3) {
+                Source += "        Sum += Missing" + std::to_string(Index) + ";\n";
+            }
+            if (Errors && Index % 11 == 5) {
+                Source += "        Var Sum = 1;\n";
+            }
+            if (Index > 0) {
+                Source += "        Sum += N" + std::to_string((Index - 1) % 4) + "::F" + std::to_string(Index - 1) + "(All, 0);\n";
+            }
+            Source += "        return Sum;\n    }\n}\n";
+        }
+        return Source;
+    }
+
+    struct Compiled {
+        Program Code;
+        std::vector<CompileError> Errors;
+        bool Succeeded = false;
+
+        Compiled(TranslationUnit* Unit, const unsigned Threads) {
+            AddMathNatives(Code);
+            Compiler Compiler(Code, Threads);
+            Succeeded = Compiler.Compile(Unit);
+            Errors = Compiler.GetErrors();
+        }
+    };
+
+    void AssertSame(const Compiled& Serial, const Compiled& Parallel) {
+        assert(Serial.Succeeded == Parallel.Succeeded);
+        assert(Serial.Errors.size() == Parallel.Errors.size());
+        for (size_t Index = 0; Index < Serial.Errors.size(); ++Index) {
+            assert(Serial.Errors[Index].Message == Parallel.Errors[Index].Message);
+            assert(Serial.Errors[Index].Location.Line == Parallel.Errors[Index].Location.Line);
+            assert(Serial.Errors[Index].Location.Column == Parallel.Errors[Index].Location.Column);
+        }
+        assert(Serial.Code.Functions.size() == Parallel.Code.Functions.size());
+        for (size_t Index = 0; Index < Serial.Code.Functions.size(); ++Index) {
+            assert(Serial.Code.Disassemble(Serial.Code.Functions[Index]) ==
+                   Parallel.Code.Disassemble(Parallel.Code.Functions[Index]));
+        }
+    }
+}
+
+void Test_VM_005_ParallelChecking() {
+    std::cout << "--- VM Test 005: Parallel Checking ---" << "\n";
+
+    constexpr int Count = static_cast<int>(Compiler::MinParallelFunctions) * 2;
+
+    // Diagnostics are merged in source order, whatever the thread count
+    {
+        ASTContext Context;
+        Parser Parser(Generate(Count, true), Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        assert(!Parser.HasErrors());
+
+        const Compiled Serial(Unit, 1);
+        assert(!Serial.Succeeded);
+        size_t Expected = 0;
+        for (int Index = 0; Index < Count; ++Index) {
+            Expected += (Index % 7 == 3 ? 1 : 0) + (Index % 11 == 5 ? 1 : 0);
+        }
+        assert(Serial.Errors.size() == Expected);
+        for (size_t Index = 1; Index < Serial.Errors.size(); ++Index) {
+            assert(Serial.Errors[Index - 1].Location.Line < Serial.Errors[Index].Location.Line);
+        }
+        assert(Serial.Errors[0].Message == "Unknown name 'Missing3'");
+
+        for (const unsigned Threads : { 2u, 4u, 8u }) {
+            AssertSame(Serial, Compiled(Unit, Threads));
+        }
+        std::cout << "  ✓ Same diagnostics in source order on 1, 2, 4 and 8 threads" << "\n";
+    }
+
+    // Bindings and code are identical too, and the program runs
+    {
+        ASTContext Context;
+        Parser Parser(Generate(Count, false), Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        assert(!Parser.HasErrors());
+
+        const Compiled Serial(Unit, 1);
+        const Compiled Parallel(Unit, 4);
+        assert(Serial.Succeeded && Serial.Errors.empty());
+        AssertSame(Serial, Parallel);
+
+        // F(I) = 16 + F(I - 1)
+        VirtualMachine VM(Parallel.Code);
+        Value All;
+        Value Result;
+        assert(VM.Call("Spawn", {}, All));
+        assert(VM.Call("N1::F5", { All, Value::MakeInt(0) }, Result) && Result.Int == 16 * 6);
+        std::cout << "  ✓ Same bytecode on 1 and 4 threads" << "\n";
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,175 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    struct SwitchScript {
+        ASTContext Context;
+        Program Code;
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit SwitchScript(const std::string& Source) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            Compiler Compiler(Code);
+            const bool Succeeded = Compiler.Compile(Unit);
+            for (const auto& Error : Compiler.GetErrors()) {
+                std::cerr << Error.Message << "\n";
+            }
+            assert(Succeeded);
+            VM = std::make_unique<VirtualMachine>(Code);
+        }
+
+        long long Run(const std::string& Name, const Value& Argument) {
+            Value Result;
+            const bool Succeeded = VM->Call(Name, { Argument }, Result);
+            assert(Succeeded && Result.Type == EValueType::Int);
+            return Result.Int;
+        }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const {
+            return Code.Disassemble(Code.Functions[static_cast<size_t>(Code.FindFunction(Name))]);
+        }
+    };
+
+    /** Name(Value: Type) returning the position of the case Value takes, or -1 */
+    std::string Classifier(const std::string& Name, const std::string& Type, const std::vector<std::string>& Patterns) {
+        std::string Source = Name + "(Value: " + Type + ") -> Int {\n    match Value {\n";
+        for (size_t Index = 0; Index < Patterns.size(); ++Index) {
+            Source += "        " + Patterns[Index] + " -> return " + std::to_string(Index) + ";\n";
+        }
+        return Source + "    }\n    return -1;\n}\n";
+    }
+
+    bool Contains(const std::string& Text, const std::string& Part) { return Text.find(Part) != std::string::npos; }
+}
+
+void Test_VM_006_MatchDispatch() {
+    std::cout << "--- VM Test 006: Match Dispatch ---" << "\n";
+
+    // Ints close together index a table directly
+    {
+        SwitchScript Script(Classifier("Small", "Int", { "3", "4", "6", "7", "8", "10" }) +
+                            Classifier("Letters", "Int", { "'a'", "'b'", "'c'", "'e'" }));
+        assert(Contains(Script.Listing("Small"), "SWITCH") && Contains(Script.Listing("Small"), "dense, 6 cases"));
+        const std::vector<long long> Expected = { -1, -1, -1, -1, -1, 0, 1, -1, 2, 3, 4, -1, 5, -1, -1, -1 };
+        for (long long Subject = -2; Subject < 14; ++Subject) {
+            assert(Script.Run("Small", Value::MakeInt(Subject)) == Expected[static_cast<size_t>(Subject + 2)]);
+        }
+        assert(Contains(Script.Listing("Letters"), "dense, 4 cases"));
+        assert(Script.Run("Letters", Value::MakeInt('c')) == 2 && Script.Run("Letters", Value::MakeInt('d')) == -1);
+
+        std::cout << "  ✓ Dense tables" << "\n";
+    }
+
+    // Sparse Ints are found by binary search, extremes included
+    {
+        SwitchScript Script(Classifier("Sparse", "Int", { "1000000", "-5", "1", "100", "9223372036854775807", "-9223372036854775807" }));
+        assert(Contains(Script.Listing("Sparse"), "sorted, 6 cases"));
+        assert(Script.Run("Sparse", Value::MakeInt(1000000)) == 0);
+        assert(Script.Run("Sparse", Value::MakeInt(-5)) == 1);
+        assert(Script.Run("Sparse", Value::MakeInt(100)) == 3);
+        assert(Script.Run("Sparse", Value::MakeInt(9223372036854775807LL)) == 4);
+        assert(Script.Run("Sparse", Value::MakeInt(-9223372036854775807LL)) == 5);
+        assert(Script.Run("Sparse", Value::MakeInt(0)) == -1 && Script.Run("Sparse", Value::MakeInt(2)) == -1);
+        assert(Script.Run("Sparse", Value::MakeInt(-9223372036854775807LL - 1)) == -1);
+
+        std::cout << "  ✓ Sorted tables" << "\n";
+    }
+
+    // Strings go through a perfect hash, and compare by content
+    {
+        std::vector<std::string> Words;
+        for (int Index = 0; Index < 300; ++Index) {
+            Words.push_back("\"Word" + std::to_string(Index * 7) + "\"");
+        }
+        Words.emplace_back("\"\"");
+        SwitchScript Script(Classifier("Lookup", "String", Words));
+        assert(Contains(Script.Listing("Lookup"), "hashed, 301 cases"));
+
+        for (int Index = 0; Index < 300; ++Index) {
+            const std::string Built = "Word" + std::to_string(Index * 7);
+            assert(Script.Run("Lookup", Value::MakeString(&Built)) == Index);
+            const std::string Missing = "Word" + std::to_string(Index * 7 + 1);
+            assert(Script.Run("Lookup", Value::MakeString(&Missing)) == -1);
+        }
+        const std::string Empty;
+        assert(Script.Run("Lookup", Value::MakeString(&Empty)) == 300);
+
+        std::cout << "  ✓ Perfect-hashed strings" << "\n";
+    }
+
+    // Same answers as the chain of EQ: first case wins, _ ends the table, other types as EQ sees them
+    {
+        const std::string Source = Classifier("Repeats", "Int", { "1", "2", "1", "3", "4", "_", "5", "6" }) +
+                                   Classifier("Mixed", "Float", { "0", "1", "2", "3" }) + R"(
+            Nested(Outer: Int, Inner: Int) -> Int {
+                match Outer {
+                    0 -> { match Inner { 0 -> return 0; 1 -> return 1; 2 -> return 2; 3 -> return 3; } }
+                    1 -> return 10;
+                    2 -> return 20;
+                    3 -> return 30;
+                }
+                return -1;
+            }
+        )";
+        SwitchScript Script(Source);
+        assert(Script.Run("Repeats", Value::MakeInt(1)) == 0);
+        assert(Script.Run("Repeats", Value::MakeInt(4)) == 4);
+        assert(Script.Run("Repeats", Value::MakeInt(3)) == 3);
+        assert(Script.Run("Repeats", Value::MakeInt(5)) == 5 && Script.Run("Repeats", Value::MakeInt(6)) == 5);
+        assert(Contains(Script.Listing("Repeats"), "dense, 4 cases"));
+
+        assert(Script.Run("Mixed", Value::MakeFloat(2.0)) == 2);
+        assert(Script.Run("Mixed", Value::MakeFloat(2.5)) == -1);
+        assert(Script.Run("Mixed", Value::MakeInt(3)) == 3);
+        assert(Script.Run("Mixed", Value()) == -1);
+        assert(Script.Run("Mixed", Value::MakeBool(true)) == -1);
+        const std::string One = "1";
+        assert(Script.Run("Mixed", Value::MakeString(&One)) == -1);
+
+        Value Result;
+        assert(Script.VM->Call("Nested", { Value::MakeInt(0), Value::MakeInt(3) }, Result) && Result.Int == 3);
+        assert(Script.VM->Call("Nested", { Value::MakeInt(0), Value::MakeInt(4) }, Result) && Result.Int == -1);
+        assert(Script.VM->Call("Nested", { Value::MakeInt(2), Value::MakeInt(0) }, Result) && Result.Int == 20);
+        assert(Script.Code.Switches.size() == 4);
+
+        std::cout << "  ✓ Duplicates, wildcards, nesting and mixed types" << "\n";
+    }
+
+    // Small, mixed or non-literal matches stay chains of EQ
+    {
+        const std::string Source = Classifier("Few", "Int", { "1", "2", "3" }) +
+                                   Classifier("Floats", "Float", { "1.5", "2", "3", "4" }) +
+                                   Classifier("Both", "Int", { "1", "2", "3", "\"4\"" }) + R"(
+            Computed(Value: Int) -> Int {
+                Var Two = 2;
+                match Value { 1 -> return 0; Two -> return 1; 3 -> return 2; 4 -> return 3; }
+                return -1;
+            }
+        )";
+        SwitchScript Script(Source);
+        for (const char* Name : { "Few", "Floats", "Both", "Computed" }) {
+            assert(!Contains(Script.Listing(Name), "SWITCH"));
+        }
+        assert(Script.Code.Switches.empty());
+        assert(Script.Run("Computed", Value::MakeInt(2)) == 1 && Script.Run("Floats", Value::MakeFloat(1.5)) == 0);
+
+        std::cout << "  ✓ Chains for the rest" << "\n";
+    }
+
+    std::cout << "\n";
+}
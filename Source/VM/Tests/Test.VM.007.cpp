@@ -0,0 +1,198 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../Ownership.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    struct Analyzed {
+        ASTContext Context;
+        Program Code;
+        Vex::Compiler Checked{ Code };
+        bool Succeeded = false;
+
+        explicit Analyzed(const std::string& Source, const bool Elide = true) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+            Checked.SetCountElision(Elide);
+            Succeeded = Checked.Compile(Unit);
+            for (const auto& Error : Checked.GetErrors()) {
+                std::cerr << Error.Message << "\n";
+            }
+            assert(Succeeded);
+        }
+
+        [[nodiscard]] uint32_t IndexOf(const std::string& Name) const { return static_cast<uint32_t>(Code.FindFunction(Name)); }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const { return Code.Disassemble(Code.Functions[IndexOf(Name)]); }
+    };
+
+    Value Run(VirtualMachine& VM, const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+        Value Result;
+        const bool Succeeded = VM.Call(Name, Arguments, Result);
+        if (!Succeeded) {
+            std::cerr << VM.GetError().Message << "\n";
+        }
+        assert(Succeeded);
+        return Result;
+    }
+
+    const char* const Shared = R"(
+        Define Entity { Health -> Int = 10; }
+        global Var Registry: Shared Entity[] = new Entity[](1);
+
+        Spawn(N: Int) -> Shared Entity[] { Var Made: Shared Entity[] = new Entity[](N); Made[0].Health = N; return Made; }
+        Peek(All: Shared Entity[]) -> Int { Var Seen: Shared Entity[] = All; return Seen[0].Health + Seen.Count; }
+        Churn(N: Int) -> Int {
+            Var Total = 0;
+            for I in 0..N { Var Pack: Shared Entity[] = Spawn(3); Total += Peek(Pack); }
+            return Total;
+        }
+        Local(N: Int) -> Int {
+            Var Own: Shared Entity[] = new Entity[](N);
+            Var Other: Shared Entity[] = new Entity[](N + 1);
+            Other = Own;
+            return Other.Count;
+        }
+        Publish(N: Int) -> Int { Var Made: Shared Entity[] = new Entity[](N); Registry = Made; return Registry.Count; }
+        Replace(All: Shared Entity[]) -> Int { All = Spawn(1); return All.Count; }
+        Drop() -> Int { Spawn(2); return 0; }
+        Stale() -> Int { Var Plain: Entity[] = Registry; Registry = Spawn(1); return Plain.Count; }
+    )";
+}
+
+void Test_VM_007_SharedReferences() {
+    std::cout << "--- VM Test 007: Ownership and Shared References ---" << "\n";
+
+    const std::string Source = R"(
+        Define Entity { Health -> Int = 10; }
+        global Var Cache: Entity[] = new Entity[](1);
+
+        Sum(All: Entity[]) -> Int { Var Alias = All; return Alias[0].Health + Alias.Count; }
+        Caller(All: Entity[]) -> Int { return Sum(All) + Sum(All); }
+        Plain(All: Entity[]) -> Int { Var Alias = All; return Alias.Count; }
+
+        Keep(All: Entity[]) -> Entity[] { return All; }
+        Pass(All: Entity[]) -> Int { Var Kept = Keep(All); return Kept.Count; }
+        Make() -> Entity[] { Var Fresh: Entity[] = new Entity[](2); return Fresh; }
+        Store(All: Entity[]) -> Int { Cache = All; return 0; }
+
+        Swap(A: Entity[], B: Entity[]) -> Int { Var T = A; A = B; return T.Count + A.Count; }
+        Outer(All: Entity[]) -> Int {
+            Var Held: Entity[] = All;
+            { Var Inner: Entity[] = new Entity[](1); Held = Inner; }
+            return Held.Count;
+        }
+
+        Walk(All: Entity[], N: Int) -> Int { if N == 0 { return All.Count; } return Walk(All, N - 1); }
+        Leak(All: Entity[], N: Int) -> Entity[] { if N == 0 { return All; } return Leak(All, N - 1); }
+        Down(All: Entity[]) -> Int { return Up(All); }
+        Up(All: Entity[]) -> Int { Cache = All; return Down(All); }
+    )";
+    Analyzed Unit(Source);
+    const OwnershipAnalysis Ownership(Unit.Checked.GetDeclarations());
+    const auto Borrows = [&](const std::string& Function, const uint32_t Parameter) {
+        return Ownership.BorrowsParameter(Unit.IndexOf(Function), Parameter);
+    };
+
+    // Parameters only read, copied to locals that are only read, or passed where the callee borrows them
+    {
+        assert(Borrows("Sum", 0) && Borrows("Caller", 0) && Borrows("Plain", 0));
+        assert(Borrows("Swap", 0) && Borrows("Swap", 1) && Borrows("Outer", 0));
+
+        std::cout << "  ✓ Borrowed parameters" << "\n";
+    }
+
+    // Escaping through returns, callees and globals, also through a local holding the value
+    {
+        assert(!Borrows("Keep", 0) && !Borrows("Pass", 0) && !Borrows("Store", 0));
+
+        std::cout << "  ✓ Escaping parameters" << "\n";
+    }
+
+    // Recursion settles on the least escape
+    {
+        assert(Borrows("Walk", 0) && Borrows("Walk", 1));
+        assert(!Borrows("Leak", 0) && !Borrows("Down", 0) && !Borrows("Up", 0));
+        assert(Ownership.GetPasses() >= 2);
+
+        std::cout << "  ✓ Recursive summaries" << "\n";
+    }
+
+    // Borrowed references are not counted; those no other thread can see count without atomics
+    {
+        Analyzed Counted(Shared);
+        const OwnershipAnalysis Counts(Counted.Checked.GetDeclarations(), { true });
+        const auto CountOf = [&](const std::string& Function, const uint32_t Slot) {
+            return Counts.GetCount(Counted.IndexOf(Function), Slot);
+        };
+        assert(CountOf("Peek", 0) == ERefCount::Elided && CountOf("Peek", 1) == ERefCount::Elided);
+        assert(CountOf("Spawn", 1) == ERefCount::NonAtomic && CountOf("Spawn", 0) == ERefCount::None);
+        assert(CountOf("Local", 1) == ERefCount::Elided && CountOf("Local", 2) == ERefCount::NonAtomic);
+        assert(CountOf("Churn", 3) == ERefCount::Atomic);     // From a call: the host may have handed it out
+        assert(CountOf("Publish", 1) == ERefCount::Atomic && CountOf("Replace", 0) == ERefCount::Atomic);
+        assert(Counts.ReturnsShared(Counted.IndexOf("Spawn")) && !Counts.ReturnsShared(Counted.IndexOf("Peek")));
+
+        const OwnershipReport& Total = Counts.GetTotal();
+        assert(Total.Shared == 8 && Total.Elided == 3 && Total.NonAtomic == 2);
+
+        const OwnershipAnalysis Naive(Counted.Checked.GetDeclarations(), { true }, true, false);
+        assert(Naive.GetTotal().Elided == 0 && Naive.GetTotal().NonAtomic == 0);
+        assert(Naive.GetCount(Counted.IndexOf("Peek"), 0) == ERefCount::Atomic);
+
+        assert(Counted.Listing("Peek").find("RETAIN") == std::string::npos);
+        assert(Counted.Listing("Spawn").find(", counted") != std::string::npos);
+        assert(Counted.Listing("Local").find("non-atomic") != std::string::npos);
+        assert(Counted.Listing("Drop").find("deferred") != std::string::npos);
+
+        std::cout << "  ✓ Counts elided and made non-atomic" << "\n";
+    }
+
+    // An array is freed with its last Shared reference; one the host keeps never is
+    {
+        Analyzed Counted(Shared);
+        VirtualMachine VM(Counted.Code);
+        assert(Run(VM, "Churn", { Value::MakeInt(100) }).Int == 600);
+        assert(VM.GetReleasedArrays() == 100);
+
+        const Value Kept = Run(VM, "Spawn", { Value::MakeInt(4) });
+        Run(VM, "Drop");
+        assert(VM.GetReleasedArrays() == 101 && Kept.Array->Count == 4);
+        assert(Run(VM, "Peek", { Kept }).Int == 8);
+
+        assert(Run(VM, "Local", { Value::MakeInt(2) }).Int == 2);
+        assert(Run(VM, "Replace", { Kept }).Int == 1 && Kept.Array->Count == 4);
+
+        // A plain copy only borrows: once the global lets go, it reads an emptied array
+        assert(Run(VM, "Stale").Int == 0);
+        assert(Run(VM, "Publish", { Value::MakeInt(3) }).Int == 3);
+        assert(VM.GetGlobal("Registry").Array->Count == 3);
+
+        std::cout << "  ✓ Arrays freed with their last reference" << "\n";
+    }
+
+    // Elision leaves the same results with fewer count operations
+    {
+        Analyzed Elided(Shared);
+        Analyzed Naive(Shared, false);
+        VirtualMachine Fast(Elided.Code);
+        VirtualMachine Slow(Naive.Code);
+        assert(Run(Fast, "Churn", { Value::MakeInt(10) }).Int == Run(Slow, "Churn", { Value::MakeInt(10) }).Int);
+        assert(Fast.GetReleasedArrays() == Slow.GetReleasedArrays());
+        assert(Fast.GetCountOperations() == 10 && Slow.GetCountOperations() == 70);
+
+        std::cout << "  ✓ Elided operations" << "\n";
+    }
+
+    std::cout << "\n";
+}
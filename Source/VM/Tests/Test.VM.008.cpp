@@ -0,0 +1,158 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../Ownership.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    struct FrameScript {
+        ASTContext Context;
+        Program Code;
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit FrameScript(const std::string& Source, const bool FrameAllocation = true) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            Compiler Compiler(Code);
+            Compiler.SetFrameAllocation(FrameAllocation);
+            const bool Succeeded = Compiler.Compile(Unit);
+            for (const auto& Error : Compiler.GetErrors()) {
+                std::cerr << Error.Message << "\n";
+            }
+            assert(Succeeded);
+            VM = std::make_unique<VirtualMachine>(Code);
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const {
+            return Code.Disassemble(Code.Functions[static_cast<size_t>(Code.FindFunction(Name))]);
+        }
+
+        [[nodiscard]] bool MakesInFrame(const std::string& Name) const {
+            const std::string Text = Listing(Name);
+            return Text.find("NEWLOCAL") != std::string::npos && Text.find("NEWARRAY") == std::string::npos;
+        }
+    };
+}
+
+void Test_VM_008_FrameArrays() {
+    std::cout << "--- VM Test 008: Frame-Local Arrays ---" << "\n";
+
+    const std::string Source = R"(
+        Define Entity { Health -> Int = 10; }
+        global Var Cache: Entity[] = new Entity[](1);
+
+        Sum(All: Entity[]) -> Int { Var Total = 0; for I in 0..All.Count { Total += All[I].Health; } return Total; }
+        Scratch(N: Int) -> Int { Var T = new Entity[](4); T[0].Health = N; return Sum(T); }
+        Inner() -> Int { Var T = new Entity[](2); T[1].Health = 100; return T[1].Health; }
+        Outer() -> Int { Var Mine = new Entity[](2); Mine[1].Health = 7; Var X = Inner() + Inner(); return Mine[1].Health + X; }
+        Bad(N: Int) -> Int { Var T = new Entity[](N); return T.Count; }
+
+        Make(N: Int) -> Entity[] { Var Fresh = new Entity[](N); Fresh[0].Health = N; return Fresh; }
+        Store() -> Int { Var Kept = new Entity[](3); Cache = Kept; return 0; }
+        Keep(All: Entity[]) -> Entity[] { return All; }
+        Pass() -> Int { Var T = new Entity[](1); Var K = Keep(T); return K.Count; }
+        Field() -> Int { Cache[0].Health = Sum(new Entity[](2)); return Cache[0].Health; }
+        Nested() -> Int { Var Held = new Entity[](1); { Var Inner = new Entity[](2); Held = Inner; } return Held.Count; }
+    )";
+
+    // Arrays that die with their call come from the frame, and the next call reuses them
+    {
+        FrameScript Script(Source);
+        assert(Script.MakesInFrame("Scratch") && Script.MakesInFrame("Inner") && Script.MakesInFrame("Outer"));
+        assert(Script.MakesInFrame("Field"));
+
+        const size_t Heap = Script.VM->GetHeapArrays();
+        for (int Round = 0; Round < 100; ++Round) {
+            assert(Script.Run("Scratch", { Value::MakeInt(Round) }).Int == Round + 30);
+        }
+        assert(Script.VM->GetHeapArrays() == Heap && Script.VM->GetScratchArrays() == 1);
+
+        std::cout << "  ✓ Frame-local arrays are reused across calls" << "\n";
+    }
+
+    // A callee's arrays never overwrite its caller's
+    {
+        FrameScript Script(Source);
+        assert(Script.Run("Outer").Int == 207);
+        assert(Script.VM->GetScratchArrays() == 2);
+        assert(Script.Run("Field").Int == 20);
+
+        std::cout << "  ✓ Nested frames keep their own arrays" << "\n";
+    }
+
+    // Returned, stored and possibly returned arrays stay on the heap and stay valid
+    {
+        FrameScript Script(Source);
+        assert(Script.Listing("Make").find("NEWARRAY") != std::string::npos);
+        assert(Script.Listing("Store").find("NEWARRAY") != std::string::npos);
+        assert(Script.Listing("Pass").find("NEWARRAY") != std::string::npos);
+
+        const Value Made = Script.Run("Make", { Value::MakeInt(5) });
+        Script.Run("Scratch", { Value::MakeInt(1) });
+        Script.Run("Outer");
+        assert(Made.Type == EValueType::Array && Made.Array->Count == 5 && Made.Array->At(0, 0).Int == 5);
+
+        Script.Run("Store");
+        Script.Run("Scratch", { Value::MakeInt(1) });
+        assert(Script.VM->GetGlobal("Cache").Array->Count == 3);
+        assert(Script.Run("Pass").Int == 1);
+
+        std::cout << "  ✓ Escaping arrays stay on the heap" << "\n";
+    }
+
+    // A failed call gives back its frame's arrays; the analysis can be turned off
+    {
+        FrameScript Script(Source);
+        Value Result;
+        assert(!Script.VM->Call("Bad", { Value::MakeInt(-1) }, Result));
+        assert(Script.Run("Bad", { Value::MakeInt(3) }).Int == 3);
+        assert(Script.Run("Outer").Int == 207 && Script.VM->GetScratchArrays() == 2);
+
+        FrameScript Heap(Source, false);
+        assert(Heap.Listing("Scratch").find("NEWLOCAL") == std::string::npos);
+        const size_t Before = Heap.VM->GetHeapArrays();
+        assert(Heap.Run("Scratch", { Value::MakeInt(2) }).Int == 32);
+        assert(Heap.VM->GetHeapArrays() == Before + 1 && Heap.VM->GetScratchArrays() == 0);
+
+        std::cout << "  ✓ Failures and the switch" << "\n";
+    }
+
+    // The analysis reports what it decided
+    {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        Program Code;
+        Compiler Checked(Code);
+        const bool Succeeded = Checked.Compile(Parser.ParseTranslationUnit());
+        assert(Succeeded);
+        const OwnershipAnalysis Ownership(Checked.GetDeclarations());
+        assert(Ownership.GetTotal().Arrays == 10 && Ownership.GetTotal().FrameArrays == 7);
+        assert(Ownership.GetReport(static_cast<uint32_t>(Code.FindFunction("Make"))).FrameArrays == 0);
+        assert(Ownership.GetReport(static_cast<uint32_t>(Code.FindFunction("Nested"))).FrameArrays == 2);
+
+        std::cout << "  ✓ Frame-local arrays are reported" << "\n";
+    }
+
+    std::cout << "\n";
+}
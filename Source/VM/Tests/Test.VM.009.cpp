@@ -0,0 +1,158 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../Heap.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    struct AllocatorScript {
+        ASTContext Context;
+        Program Code;
+        std::unique_ptr<VirtualMachine> VM;
+
+        AllocatorScript(const std::string& Source, const EAllocator Allocator) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            assert(!Parser.HasErrors());
+            Compiler Compiler(Code);
+            const bool Succeeded = Compiler.Compile(Unit);
+            for (const auto& Error : Compiler.GetErrors()) {
+                std::cerr << Error.Message << "\n";
+            }
+            assert(Succeeded);
+            VM = std::make_unique<VirtualMachine>(Code, VirtualMachine::DefaultStackSize, Allocator);
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            assert(Succeeded);
+            return Result;
+        }
+    };
+}
+
+void Test_VM_009_Allocators() {
+    std::cout << "--- VM Test 009: Allocators ---" << "\n";
+
+    // Size classes cover every size up to the largest, each class is the smallest that fits
+    {
+        assert(SlabAllocator::ClassSize(SlabAllocator::ClassOf(SlabAllocator::MaxClassSize)) == SlabAllocator::MaxClassSize);
+        assert(SlabAllocator::ClassOf(SlabAllocator::MaxClassSize) == SlabAllocator::ClassCount - 1);
+        for (size_t Size = 1; Size <= SlabAllocator::MaxClassSize; ++Size) {
+            const size_t Class = SlabAllocator::ClassOf(Size);
+            assert(SlabAllocator::ClassSize(Class) >= Size);
+            assert(Class == 0 || SlabAllocator::ClassSize(Class - 1) < Size);
+        }
+        assert(SlabAllocator::ClassSize(SlabAllocator::ClassOf(24)) == 32 && SlabAllocator::ClassSize(SlabAllocator::ClassOf(129)) == 160);
+
+        std::cout << "  ✓ Size classes" << "\n";
+    }
+
+    // Freed blocks are reused; big requests fall back to malloc
+    {
+        SlabAllocator Slabs;
+        void* First = Slabs.Allocate(100);
+        void* Second = Slabs.Allocate(100);
+        assert(First != Second && Slabs.GetStats().Bytes == 224);
+        Slabs.Free(First, 100);
+        assert(Slabs.Allocate(112) == First);
+
+        void* Big = Slabs.Allocate(100000);
+        assert(Slabs.GetStats().Fallbacks == 1 && Slabs.GetStats().Peak == 224 + 100000);
+        Slabs.Free(Big, 100000);
+        Slabs.Free(Second, 100);
+        Slabs.Free(First, 112);
+        assert(Slabs.GetStats().Bytes == 0 && Slabs.GetStats().Allocations == 4 && Slabs.GetStats().Reserved == SlabAllocator::PageSize);
+
+        std::cout << "  ✓ Slab reuse and fallbacks" << "\n";
+    }
+
+    // Releasing to a mark frees everything after it; chunks are kept for the next frame
+    {
+        FrameArena Arena;
+        const FrameArena::Mark Start = Arena.GetMark();
+        void* A = Arena.Allocate(40);
+        const FrameArena::Mark Middle = Arena.GetMark();
+        void* B = Arena.Allocate(FrameArena::ChunkSize);
+        void* C = Arena.Allocate(64);
+        assert(A != B && B != C && Arena.GetStats().Bytes == 48 + FrameArena::ChunkSize + 64);
+        assert(Arena.GetStats().Fallbacks == 3);
+
+        Arena.Release(Middle);
+        assert(Arena.GetStats().Bytes == 48 && Arena.Allocate(64) != A);
+        Arena.Release(Start);
+        assert(Arena.Allocate(40) == A);
+
+        Arena.Reset();
+        for (int Frame = 0; Frame < 100; ++Frame) {
+            Arena.Allocate(FrameArena::ChunkSize / 2);
+            Arena.Allocate(FrameArena::ChunkSize / 2);
+            Arena.Allocate(FrameArena::ChunkSize);
+            Arena.Reset();
+        }
+        assert(Arena.GetStats().Fallbacks == 3 && Arena.GetStats().Bytes == 0);
+        assert(Arena.GetStats().Peak == 2 * FrameArena::ChunkSize);
+
+        std::cout << "  ✓ Frame arena marks and reuse" << "\n";
+    }
+
+    // The VM's arrays come out the same from either allocator
+    {
+        const std::string Source = R"(
+            Define Entity { Health -> Int = 10; Armor -> Int = 2; }
+            Sum(All: Entity[]) -> Int { Var Total = 0; for I in 0..All.Count { Total += All[I].Health + All[I].Armor; } return Total; }
+            Frame(N: Int) -> Int { Var T = new Entity[](N); T[0].Health = N; return Sum(T) + Sum(new Entity[](N * 2)); }
+            Make(N: Int) -> Entity[] { return new Entity[](N); }
+        )";
+        for (const EAllocator Allocator : { EAllocator::System, EAllocator::Pooled }) {
+            AllocatorScript Script(Source, Allocator);
+            for (int Round = 1; Round <= 50; ++Round) {
+                assert(Script.Run("Frame", { Value::MakeInt(Round) }).Int == Round * 12 + Round - 10 + Round * 24);
+            }
+            const Value Made = Script.Run("Make", { Value::MakeInt(300) });
+            assert(Made.Array->Count == 300 && Made.Array->At(299, 1).Int == 2);
+
+            const AllocatorStats& Heap = Script.VM->GetHeapStats();
+            const AllocatorStats& Frame = Script.VM->GetFrameStats();
+            if (Allocator == EAllocator::Pooled) {
+                assert(Heap.Allocations == 1 && Heap.Bytes == 300 * 2 * sizeof(Value) && Heap.Fallbacks == 1);
+                assert(Frame.Allocations == 100 && Frame.Bytes == 0 && Frame.Fallbacks == 1);
+                assert(Frame.Peak == 50 * 2 * sizeof(Value) + 100 * 2 * sizeof(Value));
+            } else {
+                // The two frame-local blocks grew with N, then the one heap array
+                assert(Heap.Allocations == 101 && Heap.Fallbacks == 0 && Frame.Allocations == 0);
+                assert(Heap.Bytes == (50 + 100 + 300) * 2 * sizeof(Value));
+            }
+        }
+
+        std::cout << "  ✓ System and pooled VMs" << "\n";
+    }
+
+    // Blocks past the largest class are freed with the allocator, and with the VM holding them
+    {
+        {
+            SlabAllocator Slabs;
+            Slabs.Allocate(SlabAllocator::MaxClassSize + 1);
+            Slabs.Free(Slabs.Allocate(SlabAllocator::MaxClassSize * 2), SlabAllocator::MaxClassSize * 2);
+            assert(Slabs.GetStats().Fallbacks == 2 && Slabs.GetStats().Bytes == SlabAllocator::MaxClassSize + 1);
+        }
+
+        AllocatorScript Script("Define Entity { Health -> Int = 10; } Make(N: Int) -> Entity[] { return new Entity[](N); }",
+                               EAllocator::Pooled);
+        const size_t Count = SlabAllocator::MaxClassSize / sizeof(Value) + 1;
+        const Value Made = Script.Run("Make", { Value::MakeInt(static_cast<long long>(Count)) });
+        assert(Made.Array->Count == Count && Script.VM->GetHeapStats().Fallbacks == 1);
+        Script.VM.reset();                          // Frees the cells; leak checkers see them go
+
+        std::cout << "  ✓ Large blocks freed on destruction" << "\n";
+    }
+
+    std::cout << "\n";
+}
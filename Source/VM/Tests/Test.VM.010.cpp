@@ -0,0 +1,196 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    struct InlineScript {
+        ASTContext Context;
+        Program Code;
+        std::unique_ptr<VirtualMachine> VM;
+        size_t Inlined = 0;
+
+        explicit InlineScript(const std::string& Source, const bool Inlining = true) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            Compiler Compiler(Code);
+            Compiler.SetInlining(Inlining);
+            const bool Succeeded = Compiler.Compile(Unit);
+            for (const auto& Error : Compiler.GetErrors()) {
+                std::cerr << Error.Message << "\n";
+            }
+            assert(Succeeded);
+            Inlined = Compiler.GetInlinedCalls();
+            VM = std::make_unique<VirtualMachine>(Code);
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+    };
+
+    /** First error compiling Source, or "" if it compiles */
+    std::string FirstError(const std::string& Source) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        assert(!Parser.HasErrors());
+        Program Code;
+        Compiler Compiler(Code);
+        Compiler.Compile(Unit);
+        return Compiler.HasErrors() ? Compiler.GetErrors()[0].Message : std::string();
+    }
+}
+
+void Test_VM_010_Inlining() {
+    std::cout << "--- VM Test 010: Accessors and Inlining ---" << "\n";
+
+    // Fetch and Set accessors run on the element they are called on, as calls or as copies of their bodies
+    {
+        const std::string Source = R"(
+            Define Entity { Health -> Int = 100; Armor -> Int = 5; }
+            Fetch Entity {
+                Fetch_Health() -> Entity.Health { return Entity.Health; }
+                Fetch_Effective() -> Int { return Entity.Health + Entity.Armor * 2; }
+            }
+            Set Entity {
+                Set_Health(Value: Int) -> Void { Entity.Health = Value; }
+                Damage(Amount: Int) -> Void { Entity.Health -= Amount - Entity.Armor; }
+            }
+            Total(All: Entity[]) -> Int { Var Sum = 0; for I in 0..All.Count { Sum += All[I].Fetch_Health(); } return Sum; }
+            Hurt(All: Entity[], Amount: Int) -> Int { for I in 0..All.Count { All[I].Damage(Amount); } return Total(All); }
+            Run(N: Int) -> Int {
+                Var All = new Entity[](N);
+                for I in 0..N { All[I].Set_Health(I * 10); }
+                return Hurt(All, 7) + All[0].Fetch_Effective();
+            }
+        )";
+
+        InlineScript Calls(Source, false);
+        assert(Calls.Code.FindFunction("Entity.Fetch_Health") >= 0 && Calls.Code.FindFunction("Entity.Damage") >= 0);
+        assert(Calls.Code.Functions[static_cast<size_t>(Calls.Code.FindFunction("Entity.Damage"))].ParameterCount == 3);
+        assert(Calls.Run("Run", { Value::MakeInt(10) }).Int == 450 - 20 + 8);
+        assert(Calls.Inlined == 0 && Calls.VM->GetCalls() == 3 * 10 + 3);
+
+        // Total's Fetch_Health; Hurt's Damage, Total and its Fetch_Health; Run's Set_Health, Fetch_Effective, and Hurt with its three
+        InlineScript Copies(Source);
+        assert(Copies.Run("Run", { Value::MakeInt(10) }).Int == 450 - 20 + 8);
+        assert(Copies.Inlined == 1 + 3 + 6 && Copies.VM->GetCalls() == 0);
+
+        std::cout << "  ✓ Accessors as calls and inlined" << "\n";
+    }
+
+    // Inlined bodies keep call semantics: parameters are copies, returns leave early, defaults apply
+    {
+        const std::string Source = R"(
+            Twice(X: Int) -> Int { X = X * 2; return X; }
+            Next(X: Int) -> Int { return X + 1; }
+            Clamp(X: Int, Low: Int = 0, High: Int = 50) -> Int { if (X < Low) { return Low; } if (X > High) { return High; } return X; }
+            Both(P: Bool, Q: Bool) -> Bool { return P && Q; }
+            Sum(N: Int) -> Int { Var Total = 0; for I in 0..N { if (I == 5) { break; } Total += I; } return Total; }
+            Check(V: Int) -> Int {
+                Var A = V;
+                Var B = Twice(A);
+                A = Next(A);
+                Var C = Clamp(A * 3) + Clamp(-A) + Clamp(A, 5, 7);
+                return A * 1000000 + B * 1000 + C;
+            }
+            Flags() -> Bool { Var P = false; Var Q = true; P = Both(Q, P); return P; }
+            Loops() -> Int { Var Total = 0; for J in 0..3 { Total += Sum(J * 4); } return Total; }
+        )";
+        for (const bool Inlining : { false, true }) {
+            InlineScript Script(Source, Inlining);
+            assert(Script.Run("Check", { Value::MakeInt(4) }).Int == 5008020);
+            assert(Script.Run("Check", { Value::MakeInt(30) }).Int == 31060057);
+            assert(Script.Run("Flags").Bool == false);
+            assert(Script.Run("Loops").Int == 0 + 6 + 10);
+            assert(Script.VM->GetCalls() == (Inlining ? 0u : 2 * 5 + 1 + 3));
+        }
+
+        std::cout << "  ✓ Inlined calls behave as calls" << "\n";
+    }
+
+    // A local a later argument assigns is read before that assignment, as the call would read it
+    {
+        const std::string Source = R"(
+            Define Cell {
+                Base -> Int = 0;
+                Virtual Mix(A: Int, B: Int) -> Int { return A * 10 + B + this.Base; }
+            }
+            Add(A: Int, B: Int) -> Int { return A * 10 + B; }
+            Assigned() -> Int { Var X: Int = 1; return Add(X, X = 5); }
+            Compounded() -> Int { Var X: Int = 1; return Add(X, X += 2) * 100 + Add(X, X); }
+            Method() -> Int { Var All = new Cell[](1); Var X: Int = 1; return All[0].Mix(X, X = 5); }
+        )";
+        for (const bool Inlining : { false, true }) {
+            InlineScript Script(Source, Inlining);
+            assert(Script.Run("Assigned").Int == 15);
+            assert(Script.Run("Compounded").Int == 1300 + 33);
+            assert(Script.Run("Method").Int == 15);
+            assert(Inlining ? Script.Inlined == 4 : Script.Inlined == 0);
+        }
+
+        std::cout << "  ✓ Arguments assigning the caller's locals" << "\n";
+    }
+
+    // Recursion, bodies over the budget and bodies making arrays stay calls
+    {
+        const std::string Source = R"(
+            Define Cell { Value -> Int = 0; }
+            Fact(N: Int) -> Int { if (N <= 1) { return 1; } return N * Fact(N - 1); }
+            IsEven(N: Int) -> Bool { if (N == 0) { return true; } return IsOdd(N - 1); }
+            IsOdd(N: Int) -> Bool { if (N == 0) { return false; } return IsEven(N - 1); }
+            Long(X: Int) -> Int {
+                Var A = X + 1; Var B = A * 2 + X; Var C = B - A * 3 + X;
+                Var D = C * C + B * A; Var E = D - C + B - A;
+                return A + B + C + D + E;
+            }
+            Make(N: Int) -> Int { Var Made = new Cell[](N); return Made.Count; }
+            UseLong(X: Int) -> Int { return Long(X); }
+            UseMake(N: Int) -> Int { return Make(N) + Make(N + 1); }
+        )";
+        InlineScript Script(Source);
+        assert(Script.Run("Fact", { Value::MakeInt(10) }).Int == 3628800);
+        assert(Script.Run("IsEven", { Value::MakeInt(10) }).Bool && !Script.Run("IsEven", { Value::MakeInt(11) }).Bool);
+        const size_t Recursive = Script.VM->GetCalls();
+        assert(Recursive > 0);
+
+        assert(Script.Run("UseLong", { Value::MakeInt(1) }).Int == 2 + 5 + 0 + 10 + 13);
+        assert(Script.VM->GetCalls() == Recursive + 1);
+        assert(Script.Run("UseMake", { Value::MakeInt(3) }).Int == 7 && Script.VM->GetCalls() == Recursive + 3);
+
+        std::cout << "  ✓ Recursion and size guards" << "\n";
+    }
+
+    // Accessors on unknown types, fields or names are reported
+    {
+        assert(FirstError("Fetch Missing { Fetch_X() -> Int { return 1; } }") == "Unknown Define 'Missing' for accessors");
+        assert(FirstError("Define E { H -> Int = 1; } Fetch E { Get() -> Int { return E.Nope; } }") == "E has no field Nope");
+        assert(FirstError("Define E { H -> Int = 1; } Fetch E { Get() -> Int { Var Copy = E; return 0; } }") ==
+               "'E' can only be used through its fields here");
+        assert(FirstError("Define E { H -> Int = 1; } Go(All: E[]) -> Int { return All[0].Nope(); }") == "E has no method Nope");
+        assert(FirstError("Define E { H -> Int = 1; } Set E { Put(V: Int) -> Void { E.H = V; } Put(V: Int) -> Void { } }") ==
+               "Accessor 'Put' of E is already defined");
+
+        std::cout << "  ✓ Accessor errors" << "\n";
+    }
+
+    std::cout << "\n";
+}
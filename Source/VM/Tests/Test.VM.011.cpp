@@ -0,0 +1,182 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    /** Units compiled one after another into one Program */
+    struct DispatchScript {
+        ASTContext Context;
+        Program Code;
+        Vex::Compiler Builder{ Code };
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit DispatchScript(const std::vector<std::string>& Units, const bool Devirtualization = true) {
+            Builder.SetDevirtualization(Devirtualization);
+            for (const std::string& Source : Units) {
+                Parser Parser(Source, Context);
+                TranslationUnit* Unit = Parser.ParseTranslationUnit();
+                for (const auto& Error : Parser.GetErrors()) {
+                    std::cerr << Error.ToString() << "\n";
+                }
+                assert(!Parser.HasErrors());
+                const bool Succeeded = Builder.Compile(Unit);
+                for (const auto& Error : Builder.GetErrors()) {
+                    std::cerr << Error.Message << "\n";
+                }
+                assert(Succeeded);
+            }
+            VM = std::make_unique<VirtualMachine>(Code);
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const {
+            return Code.Disassemble(Code.Functions[static_cast<size_t>(Code.FindFunction(Name))]);
+        }
+    };
+
+    /** First error compiling Source, or "" if it compiles */
+    std::string FirstError(const std::string& Source) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        assert(!Parser.HasErrors());
+        Program Code;
+        Compiler Compiler(Code);
+        Compiler.Compile(Unit);
+        return Compiler.HasErrors() ? Compiler.GetErrors()[0].Message : std::string();
+    }
+
+    const char* const Shapes = R"(
+        Define Shape {
+            Scale -> Float = 1.0;
+            Virtual Area() -> Float;
+            Virtual Sides() -> Int { return 0; }
+            Describe() -> Float { return this.Scale * 10.0; }
+        }
+        Define Circle : Shape {
+            Radius -> Float = 1.0;
+            Override Area() -> Float { return this.Radius * this.Radius * 3.0 * this.Scale; }
+        }
+        Define Square : Shape {
+            Side -> Float = 2.0;
+            Override Area() -> Float { return this.Side * this.Side * this.Scale; }
+            Override Sides() -> Int { return 4; }
+        }
+        Define Tile : Square { Override Sides() -> Int { return 8; } }
+
+        Total(All: Shape[]) -> Float {
+            Var Sum = 0.0;
+            for I in 0..All.Count { Sum += All[I].Area() + All[I].Sides() + All[I].Describe(); }
+            return Sum;
+        }
+        Circles(N: Int) -> Float { Var All = new Circle[](N); All[0].Radius = 2.0; return Total(All); }
+        Tiles(N: Int) -> Float { Var All = new Tile[](N); All[0].Scale = 2.0; return Total(All); }
+        Exact(N: Int) -> Float { Var All = new Square[](N); Var Sum = 0.0; for I in 0..N { Sum += All[I].Area(); } return Sum; }
+        Swap(Flag: Bool) -> Float { Var All: Shape[] = new Circle[](1); if (Flag) { All = new Square[](1); } return All[0].Area(); }
+        Abstract() -> Bool { Var All = new Shape[](1); return All[0].Area() == null; }
+    )";
+}
+
+void Test_VM_011_Devirtualization() {
+    std::cout << "--- VM Test 011: Virtual Methods and Devirtualization ---" << "\n";
+
+    // Derived Defines extend their base's fields and methods and override its virtual slots
+    {
+        DispatchScript Script({ Shapes });
+        const TypeLayout& Tile = Script.Code.Types[static_cast<size_t>(Script.Code.FindType("Tile"))];
+        const TypeLayout& Shape = Script.Code.Types[static_cast<size_t>(Script.Code.FindType("Shape"))];
+        assert(Tile.FindField("Scale") == 0 && Tile.FindField("Side") == 1 && Tile.Lineage.size() == 3);
+        assert(Tile.VTable.size() == 2 && Tile.VTable[1] == static_cast<uint32_t>(Script.Code.FindFunction("Tile.Sides")));
+        assert(Tile.FindMethod("Area") == Script.Code.FindFunction("Square.Area") && Tile.FindSlot("Describe") < 0);
+        assert(Script.Code.IsA(static_cast<uint32_t>(Script.Code.FindType("Tile")), static_cast<uint32_t>(Script.Code.FindType("Shape"))));
+        assert(!Script.Code.IsA(static_cast<uint32_t>(Script.Code.FindType("Circle")), static_cast<uint32_t>(Script.Code.FindType("Square"))));
+        assert(Shape.VTable.size() == 2);
+
+        assert(Script.Run("Circles", { Value::MakeInt(3) }).Float == 12.0 + 3.0 + 3.0 + 30.0);
+        assert(Script.Run("Tiles", { Value::MakeInt(2) }).Float == 8.0 + 4.0 + 16.0 + 20.0 + 10.0);
+        assert(Script.Run("Exact", { Value::MakeInt(3) }).Float == 12.0);
+        assert(Script.Run("Swap", { Value::MakeBool(true) }).Float == 4.0);
+        assert(Script.Run("Swap", { Value::MakeBool(false) }).Float == 3.0);
+        assert(Script.Run("Abstract").Bool);
+
+        std::cout << "  ✓ Inheritance and overrides" << "\n";
+    }
+
+    // Exact receivers call their method outright; the rest are guarded by the Defines they can be
+    {
+        DispatchScript Narrowed({ Shapes });
+        const DispatchReport& Report = Narrowed.Builder.GetDispatch();
+        // Total's Area and Sides are guarded, Swap's Area too (its local is reassigned); Exact's and Abstract's are direct
+        assert(Report.VirtualCalls == 5 && Report.Guarded == 3 && Report.Direct == 2 && Report.Dynamic == 0);
+        assert(Report.Devirtualized() == 5);
+        const std::string Total = Narrowed.Listing("Total");
+        assert(Total.find("ISTYPE") != std::string::npos && Total.find("CALLVIRT") != std::string::npos);
+        assert(Narrowed.Listing("Exact").find("CALLVIRT") == std::string::npos);
+
+        DispatchScript Dynamic({ Shapes }, false);
+        assert(Dynamic.Builder.GetDispatch().Dynamic == 5 && Dynamic.Builder.GetDispatch().Devirtualized() == 0);
+        assert(Dynamic.Listing("Total").find("ISTYPE") == std::string::npos);
+        for (DispatchScript* Script : { &Narrowed, &Dynamic }) {
+            assert(Script->Run("Circles", { Value::MakeInt(5) }).Float == 12.0 + 4 * 3.0 + 5 * 10.0);
+            assert(Script->Run("Tiles", { Value::MakeInt(4) }).Float == 8.0 + 3 * 4.0 + 32.0 + 20.0 + 30.0);
+            assert(Script->Run("Exact", { Value::MakeInt(2) }).Float == 8.0);
+        }
+        assert(Narrowed.VM->GetCalls() < Dynamic.VM->GetCalls());
+
+        std::cout << "  ✓ Direct, guarded and dynamic calls" << "\n";
+    }
+
+    // A Define added by a later unit falls through the guards to CALLVIRT; other arrays are refused
+    {
+        DispatchScript Script({ Shapes, R"(
+            Define Hexagon : Shape { Override Area() -> Float { return 6.0; } Override Sides() -> Int { return 6; } }
+            Define Other { Scale -> Float = 1.0; }
+            Hexes(N: Int) -> Float { return Total(new Hexagon[](N)); }
+            Wrong() -> Float { return Total(new Other[](1)); }
+        )" });
+        assert(Script.Run("Hexes", { Value::MakeInt(2) }).Float == 12.0 + 12.0 + 20.0);
+        assert(Script.Run("Circles", { Value::MakeInt(1) }).Float == 12.0 + 10.0);
+
+        Value Result;
+        assert(!Script.VM->Call("Wrong", {}, Result));
+        assert(Script.VM->GetError().Message == "Expected Shape[], got Other[]");
+
+        std::cout << "  ✓ Defines from later units" << "\n";
+    }
+
+    // Hierarchies and overrides that cannot work are reported
+    {
+        assert(FirstError("Define A { Virtual F() -> Int { return 1; } } Define B : A { F() -> Int { return 2; } }") ==
+               "'B.F' must be declared Override");
+        assert(FirstError("Define A { F() -> Int { return 1; } } Define B : A { Override F() -> Int { return 2; } }") ==
+               "'B.F' overrides no Virtual method");
+        assert(FirstError("Define A { F() -> Int { return 1; } } Define B : A { Virtual F() -> Int { return 2; } }") ==
+               "'B.F' hides a method of its base that is not Virtual");
+        assert(FirstError("Define A { Virtual F(X: Int) -> Int { return X; } } Define B : A { Override F() -> Int { return 2; } }") ==
+               "'B.F' must take the parameters of the method it overrides");
+        assert(FirstError("Define A { X -> Int = 0; } Define B : A { X -> Int = 1; }") == "Field 'X' of B is already defined");
+        assert(FirstError("Define A : B { } Define B : A { }") == "'A' extends itself");
+        assert(FirstError("Define A { } Define B { } Define C : A, B { }") == "'C' can extend only one Define");
+
+        std::cout << "  ✓ Hierarchy errors" << "\n";
+    }
+
+    std::cout << "\n";
+}
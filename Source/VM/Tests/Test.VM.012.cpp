@@ -0,0 +1,192 @@
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include "../Compiler.h"
+#include "../VM.h"
+#include "Parser.h"
+
+using namespace Vex;
+
+namespace {
+    struct InterfaceScript {
+        ASTContext Context;
+        Program Code;
+        std::unique_ptr<VirtualMachine> VM;
+
+        explicit InterfaceScript(const std::string& Source) {
+            Parser Parser(Source, Context);
+            TranslationUnit* Unit = Parser.ParseTranslationUnit();
+            for (const auto& Error : Parser.GetErrors()) {
+                std::cerr << Error.ToString() << "\n";
+            }
+            assert(!Parser.HasErrors());
+
+            Compiler Compiler(Code);
+            const bool Succeeded = Compiler.Compile(Unit);
+            for (const auto& Error : Compiler.GetErrors()) {
+                std::cerr << Error.Message << "\n";
+            }
+            assert(Succeeded);
+            VM = std::make_unique<VirtualMachine>(Code);
+        }
+
+        Value Run(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            const bool Succeeded = VM->Call(Name, Arguments, Result);
+            if (!Succeeded) {
+                std::cerr << VM->GetError().Message << "\n";
+            }
+            assert(Succeeded);
+            return Result;
+        }
+
+        /** Message of the runtime error calling Name, or "" if it succeeds */
+        std::string Fail(const std::string& Name, const std::initializer_list<Value> Arguments = {}) {
+            Value Result;
+            return VM->Call(Name, Arguments, Result) ? std::string() : VM->GetError().Message;
+        }
+
+        [[nodiscard]] std::string Listing(const std::string& Name) const {
+            return Code.Disassemble(Code.Functions[static_cast<size_t>(Code.FindFunction(Name))]);
+        }
+
+        [[nodiscard]] uint32_t Type(const std::string& Name) const { return static_cast<uint32_t>(Code.FindType(Name)); }
+        [[nodiscard]] uint32_t Interface(const std::string& Name) const {
+            return static_cast<uint32_t>(Code.FindInterface(Name));
+        }
+    };
+
+    /** First error compiling Source, or "" if it compiles */
+    std::string FirstError(const std::string& Source) {
+        ASTContext Context;
+        Parser Parser(Source, Context);
+        TranslationUnit* Unit = Parser.ParseTranslationUnit();
+        assert(!Parser.HasErrors());
+        Program Code;
+        Compiler Compiler(Code);
+        Compiler.Compile(Unit);
+        return Compiler.HasErrors() ? Compiler.GetErrors()[0].Message : std::string();
+    }
+
+    const char* const Shapes = R"(
+        Interface IShape { Area() -> Float; Sides() -> Int; }
+        Interface INamed { Code() -> Int; }
+        Interface IPart : IShape, INamed { Weight(Scale: Float) -> Float; }
+
+        Define Circle : IShape {
+            Radius -> Float = 1.0;
+            Implement Area() -> Float { return this.Radius * this.Radius * 3.0; }
+            Implement Sides() -> Int { return 0; }
+        }
+        Define Square : IPart {
+            Side -> Float = 2.0;
+            Virtual Area() -> Float { return this.Side * this.Side; }
+            Implement Sides() -> Int { return 4; }
+            Implement Code() -> Int { return 7; }
+            Implement Weight(Scale: Float) -> Float { return this.Side * Scale; }
+        }
+        Define Tile : Square { Override Area() -> Float { return 1.0; } }
+
+        Measure(S: IShape) -> Float { return S.Area() + S.Sides(); }
+        Parts(All: Square[]) -> Float {
+            Var Total = 0.0;
+            for I in 0..All.Count { Var P: IPart = All[I]; Total += P.Weight(0.5) + P.Code() + Measure(P); }
+            return Total;
+        }
+        Circles(N: Int) -> Float {
+            Var All = new Circle[](N);
+            All[0].Radius = 2.0;
+            Var Total = 0.0;
+            for I in 0..N { Total += Measure(All[I]); }
+            return Total;
+        }
+        Squares(N: Int) -> Float { return Parts(new Square[](N)); }
+        Tiles(N: Int) -> Float { return Parts(new Tile[](N)); }
+        Keep(N: Int) -> IShape { Var All = new Circle[](N); All[N - 1].Radius = 3.0; return All[N - 1]; }
+        Same() -> Bool { Var All = new Circle[](2); Var A: IShape = All[1]; Var B: IShape = All[0]; B = All[1]; return A == B; }
+        Wrong(All: Circle[]) -> Float { Var P: IPart = All[0]; return P.Weight(1.0); }
+    )";
+}
+
+void Test_VM_012_Interfaces() {
+    std::cout << "--- VM Test 012: Interfaces and Interface Tables ---" << "\n";
+
+    // Interfaces number their methods after those they extend; each implementing Define gets a table of its own
+    {
+        InterfaceScript Script(Shapes);
+        const InterfaceLayout& Part = Script.Code.Interfaces[Script.Interface("IPart")];
+        assert(Part.Methods.size() == 4 && Part.FindMethod("Area") == 0 && Part.FindMethod("Code") == 2 &&
+               Part.FindMethod("Weight") == 3);
+        assert(Part.ParameterCounts[3] == 3 && Part.Extends.size() == 2);
+
+        const TypeLayout& Square = Script.Code.Types[Script.Type("Square")];
+        const TypeLayout& Tile = Script.Code.Types[Script.Type("Tile")];
+        const TypeLayout& Circle = Script.Code.Types[Script.Type("Circle")];
+        assert(Square.ITables.size() == 3 && Tile.ITables.size() == 3 && Circle.ITables.size() == 1);
+        assert(Circle.FindITable(Script.Interface("IPart")) < 0);
+
+        const auto Table = static_cast<size_t>(Tile.FindITable(Script.Interface("IPart")));
+        assert(Script.Code.ITables[Table] == Script.Interface("IPart"));
+        assert(Script.Code.ITables[Table + 1] == static_cast<uint32_t>(Script.Code.FindFunction("Tile.Area")));
+        assert(Script.Code.ITables[Table + 4] == static_cast<uint32_t>(Script.Code.FindFunction("Square.Weight")));
+        assert(Square.FindITable(Script.Interface("IShape")) != Tile.FindITable(Script.Interface("IShape")));
+
+        std::cout << "  ✓ Interface methods and tables" << "\n";
+    }
+
+    // Elements become (element, table) values where an Interface is expected; calls through them use the table
+    {
+        InterfaceScript Script(Shapes);
+        assert(Script.Run("Circles", { Value::MakeInt(3) }).Float == 12.0 + 3.0 + 3.0);
+        assert(Script.Run("Squares", { Value::MakeInt(2) }).Float == 2 * (1.0 + 7.0 + 4.0 + 4.0));
+        assert(Script.Run("Tiles", { Value::MakeInt(2) }).Float == 2 * (1.0 + 7.0 + 1.0 + 4.0));
+        assert(Script.Run("Same").Bool);
+
+        const std::string Measure = Script.Listing("Measure");
+        assert(Measure.find("CALLIFACE") != std::string::npos && Measure.find("IShape.Sides") != std::string::npos);
+        assert(Script.Listing("Parts").find("IFACE") != std::string::npos);
+
+        // A value kept by the host still runs its own Define's method
+        const Value Kept = Script.Run("Keep", { Value::MakeInt(2) });
+        assert(Kept.Type == EValueType::Interface && Kept.Interface.Index == 1);
+        assert(Script.Run("Measure", { Kept }).Float == 27.0);
+        assert(Script.Listing("Keep").find("NEWARRAY") != std::string::npos);
+        assert(Script.Listing("Circles").find("NEWLOCAL") != std::string::npos);
+
+        std::cout << "  ✓ Calls through interface values" << "\n";
+    }
+
+    // Values that are not elements of an implementing Define are refused when they run
+    {
+        InterfaceScript Script(Shapes);
+        assert(Script.Fail("Measure", { Value::MakeInt(3) }) == "Expected IShape, got Int");
+        const Value Circles = [&] {
+            Value Made;
+            Script.VM->Call("Keep", { Value::MakeInt(1) }, Made);
+            return Made;
+        }();
+        assert(Script.Fail("Wrong", { Value::MakeArray(Circles.Interface.Array) }) == "Circle does not implement IPart");
+
+        std::cout << "  ✓ Runtime errors" << "\n";
+    }
+
+    // Interfaces that cannot be implemented or called as written are reported
+    {
+        assert(FirstError("Interface I { F() -> Int; } Define A : I { }") == "'A' does not implement 'I.F'");
+        assert(FirstError("Interface I { F(X: Int) -> Int; } Define A : I { Implement F() -> Int { return 1; } }") ==
+               "'A.F' must take the parameters of 'I.F'");
+        assert(FirstError("Define A { Implement F() -> Int { return 1; } }") == "'A.F' implements no Interface method");
+        assert(FirstError("Interface I : J { } Interface J : I { }") == "'I' extends itself");
+        assert(FirstError("Define A { } Interface I : A { }") == "'I' can only extend Interfaces");
+        assert(FirstError("Define A : Nope { }") == "'Nope' is not a Define or an Interface");
+        assert(FirstError("Interface I { F() -> Int; F() -> Int; }") == "Method 'F' of I is already defined");
+        assert(FirstError("Interface I { F() -> Int; } Go(X: I) -> Int { return X.G(); }") == "I has no method G");
+        assert(FirstError("Interface I { F() -> Int; } Go(X: I) -> Int { return X.F(1); }") == "'F' takes 0 arguments, got 1");
+
+        std::cout << "  ✓ Interface errors" << "\n";
+    }
+
+    std::cout << "\n";
+}
@@ -0,0 +1,923 @@
+#include "VM.h"
+
+#include "Intrinsics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+// Computed goto (&&Label, goto *Target) is a GNU extension; only Execute() is exempt from -Wpedantic for it
+#if defined(__GNUC__) || defined(__clang__)
+    #define VEX_VM_COMPUTED_GOTO 1
+#else
+    #define VEX_VM_COMPUTED_GOTO 0
+#endif
+
+namespace Vex {
+    namespace {
+        using namespace Encoding;
+
+        constexpr long long MinInt = std::numeric_limits<long long>::min();
+        constexpr long long MaxInt = std::numeric_limits<long long>::max();
+
+        long long Wrap(const uint64_t Bits) { return static_cast<long long>(Bits); }
+
+        std::string OperatorSymbol(const EOpCode Op) {
+            switch (Op) {
+                case EOpCode::ADD:     case EOpCode::ADDI: return "+";
+                case EOpCode::SUB:     return "-";
+                case EOpCode::MUL:     return "*";
+                case EOpCode::DIV:     return "/";
+                case EOpCode::MOD:     return "%";
+                case EOpCode::POW:     return "**";
+                case EOpCode::LT:      return "<";
+                case EOpCode::LE:      return "<=";
+                case EOpCode::BAND:    return "&";
+                case EOpCode::BOR:     return "|";
+                case EOpCode::BXOR:    return "^";
+                case EOpCode::SHL:     return "<<";
+                case EOpCode::SHR:     return ">>";
+                case EOpCode::NEG:     return "-";
+                case EOpCode::NOT:     return "!";
+                case EOpCode::BNOT:    return "~";
+                default:               return OpCodeToString(Op);
+            }
+        }
+
+        std::string TypeMismatch(const EOpCode Op, const Value& Left, const Value& Right) {
+            return "Cannot apply " + OperatorSymbol(Op) + " to " + ValueTypeToString(Left.Type) + " and " +
+                   ValueTypeToString(Right.Type);
+        }
+
+        bool IntPower(const long long Base, const long long Exponent, long long& Out) {
+            if (Exponent < 0) {
+                if (Base == 0) {
+                    return false;
+                }
+                Out = Base == 1 ? 1 : Base == -1 ? (Exponent % 2 == 0 ? 1 : -1) : 0;
+                return true;
+            }
+
+            uint64_t Result = 1;
+            uint64_t Factor = static_cast<uint64_t>(Base);
+            for (auto Remaining = static_cast<uint64_t>(Exponent); Remaining != 0; Remaining >>= 1) {
+                if ((Remaining & 1) != 0) {
+                    Result *= Factor;
+                }
+                Factor *= Factor;
+            }
+            Out = Wrap(Result);
+            return true;
+        }
+
+        /** Stores a scalar (anything but a math value): only the tag and the first payload word are written */
+        inline void Put(Value& Target, const Value& Scalar) {
+            Target.Type = Scalar.Type;
+            Target.Int = Scalar.Int;
+        }
+
+        bool SameString(const std::string* Left, const std::string* Right) {
+            return Left == Right || *Left == *Right;
+        }
+
+        /** Why Array cannot stand for an array of Types[Expected] */
+        std::string ArrayError(const Value& Array, const Program& Code, const uint32_t Expected) {
+            return "Expected " + Code.Types[Expected].Name + "[], got " +
+                   (Array.Type == EValueType::Array ? Array.Array->Layout->Name + "[]" : ValueTypeToString(Array.Type));
+        }
+
+        /** Why GETFIELD or SETFIELD cannot use Array[Index] as an element of Types[Expected] */
+        std::string ElementError(const Value& Array, const Value& Index, const Program& Code, const uint32_t Expected) {
+            if (Array.Type != EValueType::Array || !Code.IsA(Array.Array->Type, Expected)) {
+                return ArrayError(Array, Code, Expected);
+            }
+            if (Index.Type != EValueType::Int) {
+                return "Array index must be an Int, not " + ValueTypeToString(Index.Type);
+            }
+            return "Index " + Index.ToString() + " is out of range for " + Array.ToString();
+        }
+
+        /** Why IFACE cannot use Array[Index] through Interfaces[Interface] */
+        std::string InterfaceError(const Value& Array, const Value& Index, const Program& Code, const uint32_t Interface) {
+            if (Array.Type != EValueType::Array) {
+                return "Cannot use " + ValueTypeToString(Array.Type) + " as " + Code.Interfaces[Interface].Name;
+            }
+            if (Index.Type != EValueType::Int) {
+                return "Array index must be an Int, not " + ValueTypeToString(Index.Type);
+            }
+            if (static_cast<uint64_t>(Index.Int) >= Array.Array->Count) {
+                return "Index " + Index.ToString() + " is out of range for " + Array.ToString();
+            }
+            return Array.Array->Layout->Name + " does not implement " + Code.Interfaces[Interface].Name;
+        }
+    }
+
+    VirtualMachine::VirtualMachine(const Program& Code, const size_t StackSize, const EAllocator Allocator)
+        : Code(Code), Stack(StackSize), Globals(Code.Globals.size()), Allocator(Allocator) {
+        Frames.reserve(MaxCallDepth);
+
+        Value Ignored;
+        for (const uint32_t Initializer : Code.Initializers) {
+            if (!Call(Initializer, nullptr, 0, Ignored)) {
+                break;
+            }
+        }
+    }
+
+    VirtualMachine::~VirtualMachine() {
+        // Pooled cells go with their slabs and arena
+        if (Allocator == EAllocator::System) {
+            for (const ArrayObject& Array : Arrays) {
+                FreeCells(Array.Cells, Array.Capacity);
+            }
+            for (const ArrayObject& Array : Scratch) {
+                FreeCells(Array.Cells, Array.Capacity);
+            }
+        }
+    }
+
+    Value* VirtualMachine::AllocateCells(const size_t Count) {
+        if (Allocator == EAllocator::Pooled) {
+            return static_cast<Value*>(Slabs.Allocate(Count * sizeof(Value)));
+        }
+
+        auto* Cells = static_cast<Value*>(std::malloc(Count * sizeof(Value)));
+        if (Cells == nullptr && Count != 0) {
+            throw std::bad_alloc();
+        }
+        ++SystemStats.Allocations;
+        SystemStats.Bytes += Count * sizeof(Value);
+        SystemStats.Reserved = SystemStats.Peak = std::max(SystemStats.Peak, SystemStats.Bytes);
+        return Cells;
+    }
+
+    void VirtualMachine::FreeCells(Value* Cells, const size_t Count) {
+        if (Allocator == EAllocator::Pooled) {
+            Slabs.Free(Cells, Count * sizeof(Value));
+            return;
+        }
+        std::free(Cells);
+        SystemStats.Bytes -= Count * sizeof(Value);
+    }
+
+    void VirtualMachine::Release(ArrayObject& Array, const bool Atomic) {
+        // An array never counted up, like one the host passed in, stays at zero
+        uint32_t Held = Array.Shares.load(std::memory_order_relaxed);
+        if (Atomic) {
+            do {
+                if (Held == 0) {
+                    return;
+                }
+            } while (!Array.Shares.compare_exchange_weak(Held, Held - 1, std::memory_order_acq_rel));
+        } else if (Held != 0) {
+            Array.Shares.store(Held - 1, std::memory_order_relaxed);
+        } else {
+            return;
+        }
+        if (Held == 1 && Array.Counted) {
+            FreeCells(Array.Cells, Array.Capacity);
+            Array.Cells = nullptr;
+            Array.Capacity = 0;
+            Array.Count = 0;
+            Array.Counted = false;
+            ++ReleasedArrays;
+        }
+    }
+
+    void VirtualMachine::ReleaseDeferred() {
+        for (ArrayObject* Array : Deferred) {
+            Release(*Array, true);
+        }
+        Deferred.clear();
+    }
+
+    bool VirtualMachine::Call(const uint32_t Index, const Value* Arguments, const size_t Count, Value& Result) {
+        Failed = false;
+        if (Index >= Code.Functions.size()) {
+            Error = { "No function #" + std::to_string(Index), {}, {} };
+            Failed = true;
+            return false;
+        }
+
+        const Function& Callee = Code.Functions[Index];
+        if (Count != Callee.ParameterCount || Callee.RegisterCount > Stack.size()) {
+            Error = { Count != Callee.ParameterCount
+                          ? Callee.Name + " takes " + std::to_string(Callee.ParameterCount) + " arguments, got " +
+                                std::to_string(Count)
+                          : "Stack overflow",
+                      Callee.Name, {} };
+            Failed = true;
+            return false;
+        }
+
+        std::copy(Arguments, Arguments + Count, Stack.begin());
+        return Execute(Callee, Result);
+    }
+
+    bool VirtualMachine::Call(const std::string_view Name, const std::initializer_list<Value> Arguments, Value& Result) {
+        const int32_t Index = Code.FindFunction(Name);
+        if (Index < 0) {
+            Error = { "No function named '" + std::string(Name) + "'", {}, {} };
+            Failed = true;
+            return false;
+        }
+        return Call(static_cast<uint32_t>(Index), Arguments.begin(), Arguments.size(), Result);
+    }
+
+    Value VirtualMachine::GetGlobal(const std::string_view Name) const {
+        for (size_t Slot = 0; Slot < Code.Globals.size(); ++Slot) {
+            if (Code.Globals[Slot] == Name) {
+                return Globals[Slot];
+            }
+        }
+        return {};
+    }
+
+    Value VirtualMachine::Arithmetic(const EOpCode Op, const Value& Left, const Value& Right, std::string& Message) {
+        if (Left.Type == EValueType::Int && Right.Type == EValueType::Int) {
+            const auto A = static_cast<uint64_t>(Left.Int);
+            const auto B = static_cast<uint64_t>(Right.Int);
+
+            switch (Op) {
+                case EOpCode::ADD:  return Value::MakeInt(Wrap(A + B));
+                case EOpCode::SUB:  return Value::MakeInt(Wrap(A - B));
+                case EOpCode::MUL:  return Value::MakeInt(Wrap(A * B));
+                case EOpCode::DIV:
+                case EOpCode::MOD:
+                    if (Right.Int == 0) {
+                        Message = Op == EOpCode::DIV ? "Integer division by zero" : "Integer remainder by zero";
+                        return {};
+                    }
+                    if (Right.Int == -1) {                          // MIN / -1 would trap
+                        return Value::MakeInt(Op == EOpCode::DIV ? Wrap(0 - A) : 0);
+                    }
+                    return Value::MakeInt(Op == EOpCode::DIV ? Left.Int / Right.Int : Left.Int % Right.Int);
+                case EOpCode::POW: {
+                    long long Power = 0;
+                    if (!IntPower(Left.Int, Right.Int, Power)) {
+                        Message = "Zero raised to a negative power";
+                        return {};
+                    }
+                    return Value::MakeInt(Power);
+                }
+                case EOpCode::BAND: return Value::MakeInt(Left.Int & Right.Int);
+                case EOpCode::BOR:  return Value::MakeInt(Left.Int | Right.Int);
+                case EOpCode::BXOR: return Value::MakeInt(Left.Int ^ Right.Int);
+                case EOpCode::SHL:  return Value::MakeInt(Wrap(A << (B & 63)));
+                case EOpCode::SHR:  return Value::MakeInt(Left.Int >> (B & 63));
+                default:            break;
+            }
+        } else if (Left.IsNumber() && Right.IsNumber()) {
+            const double A = Left.ToFloat();
+            const double B = Right.ToFloat();
+
+            switch (Op) {
+                case EOpCode::ADD:  return Value::MakeFloat(A + B);
+                case EOpCode::SUB:  return Value::MakeFloat(A - B);
+                case EOpCode::MUL:  return Value::MakeFloat(A * B);
+                case EOpCode::DIV:  return Value::MakeFloat(A / B);
+                case EOpCode::MOD:  return Value::MakeFloat(std::fmod(A, B));
+                case EOpCode::POW:  return Value::MakeFloat(std::pow(A, B));
+                default:            break;
+            }
+        } else if (Left.Type == EValueType::Bool && Right.Type == EValueType::Bool) {
+            switch (Op) {
+                case EOpCode::BAND: return Value::MakeBool(Left.Bool && Right.Bool);
+                case EOpCode::BOR:  return Value::MakeBool(Left.Bool || Right.Bool);
+                case EOpCode::BXOR: return Value::MakeBool(Left.Bool != Right.Bool);
+                default:            break;
+            }
+        } else if (Op == EOpCode::ADD && Left.Type == EValueType::String && Right.Type == EValueType::String) {
+            std::string& Joined = Strings.emplace_back();
+            Joined.reserve(Left.String->size() + Right.String->size());
+            Joined.append(*Left.String).append(*Right.String);
+            return Value::MakeString(&Joined);
+        } else if (Left.IsMath() || Right.IsMath()) {
+            // Operands the compiler could not type; the same kernels MATH runs
+            if (const int32_t Index = FindIntrinsic(Op, Left.Type, Right.Type); Index >= 0) {
+                return GetIntrinsic(static_cast<uint32_t>(Index)).Kernel(Left, Right);
+            }
+        }
+
+        Message = TypeMismatch(Op, Left, Right);
+        return {};
+    }
+
+    Value VirtualMachine::Compare(const EOpCode Op, const Value& Left, const Value& Right, std::string& Message) {
+        if (Op == EOpCode::LT || Op == EOpCode::LE) {
+            int Order = 0;
+            if (Left.Type == EValueType::Int && Right.Type == EValueType::Int) {
+                Order = Left.Int < Right.Int ? -1 : Right.Int < Left.Int ? 1 : 0;
+            } else if (Left.IsNumber() && Right.IsNumber()) {
+                const double A = Left.ToFloat();
+                const double B = Right.ToFloat();
+                if (A != A || B != B) {
+                    return Value::MakeBool(false);                  // NaN is unordered
+                }
+                Order = A < B ? -1 : B < A ? 1 : 0;
+            } else if (Left.Type == EValueType::String && Right.Type == EValueType::String) {
+                const int Text = Left.String->compare(*Right.String);
+                Order = Text < 0 ? -1 : Text > 0 ? 1 : 0;
+            } else {
+                Message = TypeMismatch(Op, Left, Right);
+                return {};
+            }
+            return Value::MakeBool(Op == EOpCode::LT ? Order < 0 : Order <= 0);
+        }
+
+        const bool Strict = Op == EOpCode::TEQ || Op == EOpCode::TNE;
+        bool Same = false;
+        if (Left.Type != Right.Type) {
+            Same = !Strict && Left.IsNumber() && Right.IsNumber() && Left.ToFloat() == Right.ToFloat();
+        } else {
+            switch (Left.Type) {
+                case EValueType::Null:   Same = true; break;
+                case EValueType::Bool:   Same = Left.Bool == Right.Bool; break;
+                case EValueType::Int:    Same = Left.Int == Right.Int; break;
+                case EValueType::Float:  Same = Left.Float == Right.Float; break;
+                case EValueType::String: Same = SameString(Left.String, Right.String); break;
+                case EValueType::Array:  Same = Left.Array == Right.Array; break;
+                case EValueType::Interface:
+                    Same = Left.Interface.Array == Right.Interface.Array && Left.Interface.Index == Right.Interface.Index;
+                    break;
+                default:                 Same = SameLanes(Left, Right); break;
+            }
+        }
+        return Value::MakeBool(Op == EOpCode::EQ || Op == EOpCode::TEQ ? Same : !Same);
+    }
+
+    Value VirtualMachine::Unary(const EOpCode Op, const Value& Operand, std::string& Message) {
+        switch (Op) {
+            case EOpCode::NEG:
+                if (Operand.Type == EValueType::Int) {
+                    return Value::MakeInt(Wrap(0 - static_cast<uint64_t>(Operand.Int)));
+                }
+                if (Operand.Type == EValueType::Float) {
+                    return Value::MakeFloat(-Operand.Float);
+                }
+                if (Value Negated; NegateMath(Operand, Negated)) {
+                    return Negated;
+                }
+                break;
+            case EOpCode::NOT:
+                if (Operand.Type == EValueType::Bool) {
+                    return Value::MakeBool(!Operand.Bool);
+                }
+                break;
+            case EOpCode::BNOT:
+                if (Operand.Type == EValueType::Int) {
+                    return Value::MakeInt(~Operand.Int);
+                }
+                break;
+            case EOpCode::TOINT:
+                if (Operand.Type == EValueType::Int) {
+                    return Operand;
+                }
+                if (Operand.Type == EValueType::Float) {
+                    // 2^63 is exact as a double; anything at or past it does not fit
+                    if (!(Operand.Float > -9223372036854775808.0 - 1.0 && Operand.Float < 9223372036854775808.0)) {
+                        Message = "Float " + Operand.ToString() + " does not fit in an Int";
+                        return {};
+                    }
+                    return Value::MakeInt(static_cast<long long>(Operand.Float));
+                }
+                break;
+            case EOpCode::TOFLOAT:
+                if (Operand.IsNumber()) {
+                    return Value::MakeFloat(Operand.ToFloat());
+                }
+                break;
+            default:
+                break;
+        }
+
+        Message = Op == EOpCode::TOINT || Op == EOpCode::TOFLOAT
+                      ? "Cannot convert " + ValueTypeToString(Operand.Type) + " to " + (Op == EOpCode::TOINT ? "Int" : "Float")
+                      : "Cannot apply " + OperatorSymbol(Op) + " to " + ValueTypeToString(Operand.Type);
+        return {};
+    }
+
+#if VEX_VM_COMPUTED_GOTO
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+    bool VirtualMachine::Execute(const Function& Entry, Value& Result) {
+        Frames.clear();
+        ScratchTop = 0;
+        Arena.Reset();
+        Frames.push_back({ &Entry, nullptr, Stack.data(), 0, 0, Arena.GetMark() });
+
+        const Function* Current = &Entry;
+        const Instruction* Pc = Entry.Code.data();
+        Value* R = Stack.data();
+        Value* const StackEnd = Stack.data() + Stack.size();
+        const Value* const K = Code.Constants.data();
+        const IntrinsicInfo* const Intrinsics = GetIntrinsics();
+        Value* const G = Globals.data();
+        Instruction Word = 0;
+        std::string Message;
+
+    #if VEX_VM_COMPUTED_GOTO
+        static const void* const Labels[OpCodeCount] = {
+        #define VEX_OPCODE_LABEL(Name, Format, Effect) &&Op_##Name,
+            VEX_OPCODES(VEX_OPCODE_LABEL)
+        #undef VEX_OPCODE_LABEL
+        };
+
+        #define VM_CASE(Name) Op_##Name:
+        #define VM_NEXT() Word = *Pc++; goto *Labels[Word & 0xFF]
+
+        VM_NEXT();
+    #else
+        #define VM_CASE(Name) case EOpCode::Name:
+        #define VM_NEXT() continue
+
+        for (;;) {
+            Word = *Pc++;
+            switch (GetOp(Word)) {
+    #endif
+
+        #define VM_FAIL(Text) { Message = Text; goto Failure; }
+
+        // Int (and Float) operands take the inline path; everything else goes through the helpers
+        #define VM_NUMERIC(Name, IntResult, FloatResult)                                        \
+            VM_CASE(Name) {                                                                     \
+                const Value& Left = R[GetB(Word)];                                              \
+                const Value& Right = R[GetC(Word)];                                             \
+                if (Left.Type == EValueType::Int && Right.Type == EValueType::Int) {            \
+                    Put(R[GetA(Word)], IntResult);                                             \
+                } else if (Left.Type == EValueType::Float && Right.Type == EValueType::Float) { \
+                    Put(R[GetA(Word)], FloatResult);                                           \
+                } else {                                                                        \
+                    R[GetA(Word)] = Slow(EOpCode::Name, Left, Right, Message);                  \
+                    if (!Message.empty()) {                                                     \
+                        goto Failure;                                                           \
+                    }                                                                           \
+                }                                                                               \
+                VM_NEXT();                                                                      \
+            }
+
+        #define VM_INTEGER(Name, Guard, IntResult)                                              \
+            VM_CASE(Name) {                                                                     \
+                const Value& Left = R[GetB(Word)];                                              \
+                const Value& Right = R[GetC(Word)];                                             \
+                if (Left.Type == EValueType::Int && Right.Type == EValueType::Int && (Guard)) { \
+                    Put(R[GetA(Word)], Value::MakeInt(IntResult));                             \
+                } else {                                                                        \
+                    R[GetA(Word)] = Arithmetic(EOpCode::Name, Left, Right, Message);            \
+                    if (!Message.empty()) {                                                     \
+                        goto Failure;                                                           \
+                    }                                                                           \
+                }                                                                               \
+                VM_NEXT();                                                                      \
+            }
+
+        #define VM_GENERIC(Name, Helper)                                                        \
+            VM_CASE(Name) {                                                                     \
+                R[GetA(Word)] = Helper(EOpCode::Name, R[GetB(Word)], R[GetC(Word)], Message);   \
+                if (!Message.empty()) {                                                         \
+                    goto Failure;                                                               \
+                }                                                                               \
+                VM_NEXT();                                                                      \
+            }
+
+        #define VM_UNARY(Name)                                                                  \
+            VM_CASE(Name) {                                                                     \
+                R[GetA(Word)] = Unary(EOpCode::Name, R[GetB(Word)], Message);                   \
+                if (!Message.empty()) {                                                         \
+                    goto Failure;                                                               \
+                }                                                                               \
+                VM_NEXT();                                                                      \
+            }
+
+        #define Slow(Op, Left, Right, Message) Arithmetic(Op, Left, Right, Message)
+            VM_NUMERIC(ADD, Value::MakeInt(Wrap(static_cast<uint64_t>(Left.Int) + static_cast<uint64_t>(Right.Int))),
+                       Value::MakeFloat(Left.Float + Right.Float))
+            VM_NUMERIC(SUB, Value::MakeInt(Wrap(static_cast<uint64_t>(Left.Int) - static_cast<uint64_t>(Right.Int))),
+                       Value::MakeFloat(Left.Float - Right.Float))
+            VM_NUMERIC(MUL, Value::MakeInt(Wrap(static_cast<uint64_t>(Left.Int) * static_cast<uint64_t>(Right.Int))),
+                       Value::MakeFloat(Left.Float * Right.Float))
+        #undef Slow
+        #define Slow(Op, Left, Right, Message) Compare(Op, Left, Right, Message)
+            VM_NUMERIC(LT, Value::MakeBool(Left.Int < Right.Int), Value::MakeBool(Left.Float < Right.Float))
+            VM_NUMERIC(LE, Value::MakeBool(Left.Int <= Right.Int), Value::MakeBool(Left.Float <= Right.Float))
+            VM_NUMERIC(EQ, Value::MakeBool(Left.Int == Right.Int), Value::MakeBool(Left.Float == Right.Float))
+            VM_NUMERIC(NE, Value::MakeBool(Left.Int != Right.Int), Value::MakeBool(Left.Float != Right.Float))
+        #undef Slow
+
+            // Zero and -1 divisors take the slow path, which reports or special-cases them
+            VM_INTEGER(DIV, static_cast<uint64_t>(Right.Int) + 1 > 1, Left.Int / Right.Int)
+            VM_INTEGER(MOD, static_cast<uint64_t>(Right.Int) + 1 > 1, Left.Int % Right.Int)
+            VM_INTEGER(BAND, true, Left.Int & Right.Int)
+            VM_INTEGER(BOR, true, Left.Int | Right.Int)
+            VM_INTEGER(BXOR, true, Left.Int ^ Right.Int)
+            VM_GENERIC(POW, Arithmetic)
+            VM_GENERIC(SHL, Arithmetic)
+            VM_GENERIC(SHR, Arithmetic)
+            VM_GENERIC(TEQ, Compare)
+            VM_GENERIC(TNE, Compare)
+
+            VM_UNARY(NEG)
+            VM_UNARY(NOT)
+            VM_UNARY(BNOT)
+            VM_UNARY(TOINT)
+            VM_UNARY(TOFLOAT)
+
+            VM_CASE(MATH) {
+                const IntrinsicInfo& Math = Intrinsics[*Pc++];
+                const Value& Left = R[GetB(Word)];
+                const Value& Right = R[GetC(Word)];
+                if (Math.Accepts(Left, Right)) {
+                    R[GetA(Word)] = Math.Kernel(Left, Right);
+                } else if (Math.Op == EOpCode::CALLNATIVE) {
+                    const Value Arguments[2] = { Left, Right };
+                    R[GetA(Word)] = FindMathNative(Math.Native)(Arguments);
+                } else {
+                    R[GetA(Word)] = Arithmetic(Math.Op, Left, Right, Message);     // The types were guessed wrong
+                    if (!Message.empty()) {
+                        goto Failure;
+                    }
+                }
+                VM_NEXT();
+            }
+            VM_CASE(GETLANE) {
+                const Value& Source = R[GetB(Word)];
+                if (GetC(Word) >= static_cast<uint32_t>(MathLaneCount(Source.Type))) {
+                    VM_FAIL(ValueTypeToString(Source.Type) + " has no lane " + std::to_string(GetC(Word)))
+                }
+                R[GetA(Word)] = Value::MakeFloat(Source.Lanes[GetC(Word)]);
+                VM_NEXT();
+            }
+
+            VM_CASE(NEWARRAY)
+            VM_CASE(NEWLOCAL) {
+                const uint32_t Type = *Pc++;
+                const TypeLayout& Layout = Code.Types[Type];
+                const Value& Size = R[GetB(Word)];
+                if (Size.Type != EValueType::Int || Size.Int < 0) {
+                    VM_FAIL(Size.Type != EValueType::Int ? "Array size must be an Int, not " + ValueTypeToString(Size.Type)
+                                                         : "Array size " + Size.ToString() + " is negative")
+                }
+                if (static_cast<uint64_t>(Size.Int) > MaxArrayCells / std::max<size_t>(Layout.Fields.size(), 1)) {
+                    VM_FAIL(Layout.Name + "[] of " + Size.ToString() + " elements is too large")
+                }
+                const auto Count = static_cast<size_t>(Size.Int);
+                const size_t Cells = ArrayObject::CellsFor(Layout, Count);
+                ArrayObject* Made = nullptr;
+                if (GetOp(Word) == EOpCode::NEWARRAY) {
+                    Made = &Arrays.emplace_back();
+                    Made->Reset(Layout, Type, Count, AllocateCells(Cells), Cells);
+                    if (GetC(Word) != 0) {
+                        Made->Counted = true;
+                        Made->Shares.store(1, std::memory_order_relaxed);  // The reference it is made for
+                    }
+                } else {
+                    Made = ScratchTop < Scratch.size() ? &Scratch[ScratchTop] : &Scratch.emplace_back();
+                    ++ScratchTop;
+                    if (Allocator == EAllocator::Pooled) {
+                        Made->Reset(Layout, Type, Count, static_cast<Value*>(Arena.Allocate(Cells * sizeof(Value))), Cells);
+                    } else if (Made->Capacity >= Cells) {
+                        Made->Reset(Layout, Type, Count, Made->Cells, Made->Capacity);
+                    } else {
+                        FreeCells(Made->Cells, Made->Capacity);
+                        Made->Reset(Layout, Type, Count, AllocateCells(Cells), Cells);
+                    }
+                }
+                R[GetA(Word)] = Value::MakeArray(Made);
+                VM_NEXT();
+            }
+            VM_CASE(GETFIELD)
+            VM_CASE(SETFIELD) {
+                const Instruction Ref = *Pc++;
+                const Value& Array = R[GetB(Word)];
+                const Value& Index = R[GetC(Word)];
+                // A derived Define's arrays pass the slower check: its base's fields sit at the same indices
+                if (Array.Type != EValueType::Array ||
+                    (Array.Array->Type != GetFieldType(Ref) && !Code.IsA(Array.Array->Type, GetFieldType(Ref))) ||
+                    Index.Type != EValueType::Int || static_cast<uint64_t>(Index.Int) >= Array.Array->Count) {
+                    VM_FAIL(ElementError(Array, Index, Code, GetFieldType(Ref)))
+                }
+                Value& Cell = Array.Array->At(static_cast<size_t>(Index.Int), GetField(Ref));
+                if (GetOp(Word) == EOpCode::GETFIELD) {
+                    R[GetA(Word)] = Cell;
+                } else {
+                    Cell = R[GetA(Word)];
+                }
+                VM_NEXT();
+            }
+            VM_CASE(RETAIN) {
+                ++CountOperations;
+                if (const Value& Held = R[GetA(Word)]; Held.Type == EValueType::Array) {
+                    std::atomic<uint32_t>& Shares = Held.Array->Shares;
+                    if ((GetB(Word) & CountAtomic) != 0) {
+                        Shares.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        Shares.store(Shares.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    }
+                }
+                VM_NEXT();
+            }
+            VM_CASE(RELEASE) {
+                ++CountOperations;
+                if (const Value& Held = R[GetA(Word)]; Held.Type == EValueType::Array) {
+                    if ((GetB(Word) & CountDeferred) != 0) {
+                        Deferred.push_back(Held.Array);
+                    } else {
+                        Release(*Held.Array, (GetB(Word) & CountAtomic) != 0);
+                    }
+                }
+                VM_NEXT();
+            }
+            VM_CASE(IFACE) {
+                // The Define's table is found once here, so every call through the value is one load
+                const uint32_t Interface = *Pc++;
+                const Value& Array = R[GetB(Word)];
+                const Value& Index = R[GetC(Word)];
+                const int32_t Table = Array.Type == EValueType::Array ? Array.Array->Layout->FindITable(Interface) : -1;
+                if (Table < 0 || Index.Type != EValueType::Int || static_cast<uint64_t>(Index.Int) >= Array.Array->Count) {
+                    VM_FAIL(InterfaceError(Array, Index, Code, Interface))
+                }
+                R[GetA(Word)] = Value::MakeInterface(Array.Array, static_cast<uint32_t>(Index.Int), static_cast<uint32_t>(Table));
+                VM_NEXT();
+            }
+            VM_CASE(COUNT) {
+                const Value& Array = R[GetB(Word)];
+                if (Array.Type != EValueType::Array) {
+                    VM_FAIL("Cannot take the Count of " + ValueTypeToString(Array.Type))
+                }
+                Put(R[GetA(Word)], Value::MakeInt(static_cast<long long>(Array.Array->Count)));
+                VM_NEXT();
+            }
+
+            VM_CASE(MOVE) {
+                R[GetA(Word)] = R[GetB(Word)];
+                VM_NEXT();
+            }
+            VM_CASE(LOADK) {
+                R[GetA(Word)] = K[GetBx(Word)];
+                VM_NEXT();
+            }
+            VM_CASE(LOADI) {
+                Put(R[GetA(Word)], Value::MakeInt(GetsBx(Word)));
+                VM_NEXT();
+            }
+            VM_CASE(LOADNULL) {
+                R[GetA(Word)] = Value();
+                VM_NEXT();
+            }
+            VM_CASE(LOADBOOL) {
+                Put(R[GetA(Word)], Value::MakeBool(GetB(Word) != 0));
+                VM_NEXT();
+            }
+            VM_CASE(GETGLOBAL) {
+                R[GetA(Word)] = G[GetBx(Word)];
+                VM_NEXT();
+            }
+            VM_CASE(SETGLOBAL) {
+                G[GetBx(Word)] = R[GetA(Word)];
+                VM_NEXT();
+            }
+            VM_CASE(ADDI) {
+                const Value& Left = R[GetB(Word)];
+                if (Left.Type == EValueType::Int) {
+                    Put(R[GetA(Word)], Value::MakeInt(Wrap(static_cast<uint64_t>(Left.Int) + static_cast<uint64_t>(GetsC(Word)))));
+                } else if (Left.Type == EValueType::Float) {
+                    Put(R[GetA(Word)], Value::MakeFloat(Left.Float + GetsC(Word)));
+                } else {
+                    VM_FAIL(TypeMismatch(EOpCode::ADDI, Left, Value::MakeInt(0)))
+                }
+                VM_NEXT();
+            }
+
+            VM_CASE(JMP) {
+                Pc += GetsJ(Word);
+                VM_NEXT();
+            }
+            VM_CASE(JMPIF) {
+                const Value& Condition = R[GetA(Word)];
+                if (Condition.Type != EValueType::Bool) {
+                    VM_FAIL("Condition must be Bool, not " + ValueTypeToString(Condition.Type))
+                }
+                if (Condition.Bool) {
+                    Pc += GetsBx(Word);
+                }
+                VM_NEXT();
+            }
+            VM_CASE(JMPIFNOT) {
+                const Value& Condition = R[GetA(Word)];
+                if (Condition.Type != EValueType::Bool) {
+                    VM_FAIL("Condition must be Bool, not " + ValueTypeToString(Condition.Type))
+                }
+                if (!Condition.Bool) {
+                    Pc += GetsBx(Word);
+                }
+                VM_NEXT();
+            }
+            VM_CASE(JMPNN) {
+                if (R[GetA(Word)].Type != EValueType::Null) {
+                    Pc += GetsBx(Word);
+                }
+                VM_NEXT();
+            }
+            VM_CASE(ISTYPE) {
+                const Value& Subject = R[GetA(Word)];
+                if (Subject.Type != EValueType::Array || Subject.Array->Type != GetBx(Word)) {
+                    ++Pc;
+                }
+                VM_NEXT();
+            }
+
+            VM_CASE(SWITCH) {
+                const SwitchTable& Table = Code.Switches[GetBx(Word)];
+                const Value& Subject = R[GetA(Word)];
+                if (Table.Kind == ESwitchKind::Dense && Subject.Type == EValueType::Int) {
+                    const uint64_t Index = static_cast<uint64_t>(Subject.Int) - static_cast<uint64_t>(Table.Low);
+                    Pc += Index < Table.Dense.size() ? Table.Dense[Index] : Table.Default;
+                } else {
+                    Pc += Table.Target(Subject);
+                }
+                VM_NEXT();
+            }
+
+            VM_CASE(FORPREP)
+            VM_CASE(FORPREPI) {
+                Value* Loop = R + GetA(Word);
+                const bool Inclusive = GetOp(Word) == EOpCode::FORPREPI;
+                bool Enter = false;
+
+                if (Loop[0].Type == EValueType::Int && Loop[1].Type == EValueType::Int && Loop[2].Type == EValueType::Int) {
+                    const long long Step = Loop[2].Int;
+                    if (Step == 0) {
+                        VM_FAIL("for loop step is zero")
+                    }
+                    Enter = Step > 0 ? (Inclusive ? Loop[0].Int <= Loop[1].Int : Loop[0].Int < Loop[1].Int)
+                                     : (Inclusive ? Loop[0].Int >= Loop[1].Int : Loop[0].Int > Loop[1].Int);
+                } else {
+                    if (!Loop[0].IsNumber() || !Loop[1].IsNumber() || !Loop[2].IsNumber()) {
+                        VM_FAIL("for loop bounds and step must be numbers")
+                    }
+                    for (int Index = 0; Index < 3; ++Index) {
+                        Loop[Index] = Value::MakeFloat(Loop[Index].ToFloat());
+                    }
+                    const double Step = Loop[2].Float;
+                    if (Step == 0.0 || Step != Step) {
+                        VM_FAIL("for loop step is zero")
+                    }
+                    Enter = Step > 0 ? (Inclusive ? Loop[0].Float <= Loop[1].Float : Loop[0].Float < Loop[1].Float)
+                                     : (Inclusive ? Loop[0].Float >= Loop[1].Float : Loop[0].Float > Loop[1].Float);
+                }
+
+                if (Enter) {
+                    Loop[3] = Loop[0];
+                } else {
+                    Pc += GetsBx(Word);
+                }
+                VM_NEXT();
+            }
+            VM_CASE(FORLOOP)
+            VM_CASE(FORLOOPI) {
+                Value* Loop = R + GetA(Word);
+                const bool Inclusive = GetOp(Word) == EOpCode::FORLOOPI;
+
+                if (Loop[0].Type == EValueType::Int) {
+                    const long long Step = Loop[2].Int;
+                    if (Step > 0 ? Loop[0].Int > MaxInt - Step : Loop[0].Int < MinInt - Step) {
+                        VM_NEXT();                                  // The next value does not exist
+                    }
+                    const long long Next = Loop[0].Int + Step;
+                    if (Step > 0 ? (Inclusive ? Next <= Loop[1].Int : Next < Loop[1].Int)
+                                 : (Inclusive ? Next >= Loop[1].Int : Next > Loop[1].Int)) {
+                        Loop[0].Int = Next;
+                        Loop[3] = Loop[0];
+                        Pc += GetsBx(Word);
+                    }
+                } else {
+                    const double Step = Loop[2].Float;
+                    const double Next = Loop[0].Float + Step;
+                    if (Step > 0 ? (Inclusive ? Next <= Loop[1].Float : Next < Loop[1].Float)
+                                 : (Inclusive ? Next >= Loop[1].Float : Next > Loop[1].Float)) {
+                        Loop[0].Float = Next;
+                        Loop[3] = Loop[0];
+                        Pc += GetsBx(Word);
+                    }
+                }
+                VM_NEXT();
+            }
+
+            VM_CASE(CALL)
+            VM_CASE(CALLVIRT)
+            VM_CASE(CALLIFACE) {
+                const Instruction Target = *Pc++;
+                const Function* Found = nullptr;
+                if (GetOp(Word) == EOpCode::CALL) {
+                    Found = &Code.Functions[Target];
+                } else if (GetOp(Word) == EOpCode::CALLIFACE) {
+                    // The value's table picks the function; one made for another Interface is looked up again
+                    Value* const Receiver = R + GetB(Word);
+                    if (Receiver->Type != EValueType::Interface) {
+                        VM_FAIL("Expected " + Code.Interfaces[GetFieldType(Target)].Name + ", got " +
+                                ValueTypeToString(Receiver->Type))
+                    }
+                    const InterfaceRef Self = Receiver->Interface;
+                    int32_t Table = static_cast<int32_t>(Self.Table);
+                    if (Code.ITables[Self.Table] != GetFieldType(Target)) {
+                        Table = Self.Array->Layout->FindITable(GetFieldType(Target));
+                        if (Table < 0) {
+                            VM_FAIL(Self.Array->Layout->Name + " does not implement " + Code.Interfaces[GetFieldType(Target)].Name)
+                        }
+                    }
+                    Found = &Code.Functions[Code.ITables[static_cast<size_t>(Table) + 1 + GetField(Target)]];
+                    Receiver[0] = Value::MakeArray(Self.Array);
+                    Receiver[1] = Value::MakeInt(Self.Index);
+                } else {
+                    // The receiver's own Define picks the slot's function
+                    const Value& Receiver = R[GetB(Word)];
+                    if (Receiver.Type != EValueType::Array || !Code.IsA(Receiver.Array->Type, GetFieldType(Target))) {
+                        VM_FAIL(ArrayError(Receiver, Code, GetFieldType(Target)))
+                    }
+                    Found = &Code.Functions[Receiver.Array->Layout->VTable[GetField(Target)]];
+                }
+                const Function& Callee = *Found;
+                Value* const Base = R + GetB(Word);
+                if (Frames.size() >= MaxCallDepth || Base + Callee.RegisterCount > StackEnd) {
+                    VM_FAIL("Stack overflow calling " + Callee.Name)
+                }
+
+                Frames.push_back({ &Callee, Pc, Base, GetA(Word), ScratchTop, Arena.GetMark() });
+                ++Calls;
+                Current = &Callee;
+                R = Base;
+                Pc = Callee.Code.data();
+                VM_NEXT();
+            }
+            VM_CASE(CALLNATIVE) {
+                const NativeBinding& Native = Code.Natives[*Pc++];
+                const Value Returned = Native.Callback(R + GetB(Word));
+                if (Returned.IsMath() || Returned.Type == EValueType::Interface) {
+                    R[GetA(Word)] = Returned;
+                } else {
+                    Put(R[GetA(Word)], Returned);                  // Reads back the fields as the callee wrote them
+                }
+                VM_NEXT();
+            }
+            VM_CASE(RETURN) {
+                // Copied straight from the callee's register: a temporary would cost a register-sized round trip
+                const Value* Returned = GetB(Word) != 0 ? R + GetA(Word) : nullptr;
+                const Frame Done = Frames.back();
+                Frames.pop_back();
+                ScratchTop = Done.ScratchMark;              // The callee's frame-local arrays are free again
+                Arena.Release(Done.ArenaMark);
+
+                if (Frames.empty()) {
+                    Result = Returned != nullptr ? *Returned : Value();
+                    if (Result.Type == EValueType::Array && Result.Array->Counted) {
+                        Result.Array->Shares.fetch_add(1, std::memory_order_relaxed);  // The host's, never dropped
+                    }
+                    ReleaseDeferred();
+                    return true;
+                }
+
+                const Frame& Caller = Frames.back();
+                Current = Caller.Callee;
+                R = Caller.Base;
+                Pc = Done.ReturnPc;
+                if (Returned != nullptr) {
+                    R[Done.ResultRegister] = *Returned;
+                } else {
+                    Put(R[Done.ResultRegister], Value());
+                }
+                VM_NEXT();
+            }
+
+    #if !VEX_VM_COMPUTED_GOTO
+            }
+        }
+    #endif
+
+        #undef VM_CASE
+        #undef VM_NEXT
+        #undef VM_FAIL
+        #undef VM_NUMERIC
+        #undef VM_INTEGER
+        #undef VM_GENERIC
+        #undef VM_UNARY
+
+    Failure:
+        const size_t Offset = static_cast<size_t>(Pc - Current->Code.data()) - 1;
+        Error = { std::move(Message), Current->Name,
+                  Offset < Current->Locations.size() ? Current->Locations[Offset] : SourceLocation() };
+        Failed = true;
+        Frames.clear();
+        ScratchTop = 0;
+        Arena.Reset();
+        ReleaseDeferred();
+        return false;
+    }
+
+#if VEX_VM_COMPUTED_GOTO
+    #pragma GCC diagnostic pop
+#endif
+}
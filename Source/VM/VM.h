@@ -0,0 +1,153 @@
+#pragma once
+
+#include <deque>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Array.h"
+#include "Bytecode.h"
+#include "Heap.h"
+
+namespace Vex {
+
+    struct RuntimeError {
+        std::string Message;
+        std::string Function;                       // Function that was running
+        SourceLocation Location;                    // Of the failing instruction
+    };
+
+    /** Where a VirtualMachine gets the cells of its arrays */
+    enum class EAllocator : uint8_t {
+        System,                                     // malloc for each array; frame-local arrays reuse their block
+        Pooled                                      // Size-class slabs, and a frame arena for frame-local arrays
+    };
+
+    /**
+     * Runs the functions of a Program
+     *
+     * All frames share one register stack: a call's frame starts at the
+     * register holding its first argument, so arguments are never copied
+     * and a call costs one Frame push. Dispatch uses computed goto where
+     * the compiler supports it (GCC, Clang) and a switch elsewhere.
+     *
+     * Arithmetic follows FoldConstants(): Int wraps, mixed Int and Float
+     * operations use Float, and Int division or remainder by zero stops
+     * the program with a RuntimeError, as does any operation on values of
+     * the wrong type. The first error ends the current Call(); the VM stays
+     * usable afterwards. Math values (Vector2 .. Color) support the
+     * operators listed in Intrinsics.h whichever instruction applies them,
+     * plus ==, != and unary minus on vectors.
+     *
+     * Arrays of Define types live until the VM is destroyed, except those
+     * made by NEWLOCAL: the compiler proved they die with their call, so
+     * they come from a scratch region that every return rolls back and
+     * the next call reuses. With EAllocator::Pooled (the default) their
+     * cells are bumped from a FrameArena that every return rolls back in
+     * O(1) and every Call() starts empty, and other arrays take theirs
+     * from a SlabAllocator; GetHeapStats() and GetFrameStats() report the
+     * bytes, peaks and fallbacks of each. Reading or
+     * writing a field checks that the array holds the Define the compiler
+     * expected and that the index is in range, then touches exactly one
+     * cell; the array's layout (see TypeLayout) decides which.
+     *
+     * RETAIN and RELEASE count the Shared references to an array; the
+     * compiler leaves out those its OwnershipAnalysis proves redundant and
+     * makes the rest non-atomic where no other thread can see the array.
+     * A counted array is freed when its count drops to zero. A function
+     * returning Shared hands its caller a count: one the caller does not
+     * keep is dropped when the outermost Call() returns, and one returned
+     * to the host is never dropped.
+     *
+     * Example:
+     *   VirtualMachine VM(Program);
+     *   Value Result;
+     *   if (!VM.Call("Fib", { Value::MakeInt(30) }, Result)) { Log(VM.GetError().Message); }
+     */
+    class VirtualMachine {
+    public:
+        static constexpr size_t DefaultStackSize = 1 << 16;    // Registers
+        static constexpr size_t MaxCallDepth = 1 << 12;
+        static constexpr size_t MaxArrayCells = 1 << 26;        // Fields times elements, per array
+
+        /** Runs the Program's global initializers; check HasError() afterwards */
+        explicit VirtualMachine(const Program& Code, size_t StackSize = DefaultStackSize,
+                                EAllocator Allocator = EAllocator::Pooled);
+        ~VirtualMachine();
+
+        VirtualMachine(const VirtualMachine&) = delete;
+        VirtualMachine& operator=(const VirtualMachine&) = delete;
+
+        /** Runs Functions[Index] with Count arguments; false on a runtime error */
+        bool Call(uint32_t Index, const Value* Arguments, size_t Count, Value& Result);
+        bool Call(std::string_view Name, std::initializer_list<Value> Arguments, Value& Result);
+
+        /** Current value of a global, or null if there is none by that name */
+        [[nodiscard]] Value GetGlobal(std::string_view Name) const;
+
+        [[nodiscard]] const RuntimeError& GetError() const { return Error; }
+        [[nodiscard]] bool HasError() const { return Failed; }
+
+        /** Arrays made so far that live as long as the VM, and those kept for reuse by frames */
+        [[nodiscard]] size_t GetHeapArrays() const { return Arrays.size(); }
+        [[nodiscard]] size_t GetScratchArrays() const { return Scratch.size(); }
+
+        /** Cells of arrays that outlive their call; Fallbacks are those too big for a slab. System also counts the blocks frame-local arrays reuse */
+        [[nodiscard]] const AllocatorStats& GetHeapStats() const { return Allocator == EAllocator::Pooled ? Slabs.GetStats() : SystemStats; }
+
+        /** Cells of frame-local arrays; all zero unless Pooled */
+        [[nodiscard]] const AllocatorStats& GetFrameStats() const { return Arena.GetStats(); }
+
+        /** Script functions entered by a CALL instruction so far; calls from the host are not counted */
+        [[nodiscard]] size_t GetCalls() const { return Calls; }
+
+        /** RETAIN and RELEASE instructions run so far, and the arrays freed by the last of their Shared references */
+        [[nodiscard]] size_t GetCountOperations() const { return CountOperations; }
+        [[nodiscard]] size_t GetReleasedArrays() const { return ReleasedArrays; }
+
+    private:
+        struct Frame {
+            const Function* Callee;
+            const Instruction* ReturnPc;            // Caller's next instruction
+            Value* Base;                            // Callee's R[0]
+            uint32_t ResultRegister;                // In the caller's frame
+            size_t ScratchMark;                     // ScratchTop when the call began
+            FrameArena::Mark ArenaMark;             // Likewise for the frame arena
+        };
+
+        const Program& Code;
+        std::vector<Value> Stack;
+        std::vector<Value> Globals;
+        std::vector<Frame> Frames;
+        std::deque<std::string> Strings;            // Built at runtime; never freed while the VM lives
+        std::deque<ArrayObject> Arrays;             // Likewise
+        std::deque<ArrayObject> Scratch;            // Frame-local arrays; those from ScratchTop on are free
+        size_t ScratchTop = 0;
+        EAllocator Allocator;
+        SlabAllocator Slabs;
+        FrameArena Arena;
+        AllocatorStats SystemStats;
+        size_t Calls = 0;
+        std::vector<ArrayObject*> Deferred;         // Counts RELEASE left for the end of Call()
+        size_t CountOperations = 0;
+        size_t ReleasedArrays = 0;
+        RuntimeError Error;
+        bool Failed = false;
+
+        bool Execute(const Function& Entry, Value& Result);
+
+        /** Cells for an array that may outlive its call, and giving them back */
+        Value* AllocateCells(size_t Count);
+        void FreeCells(Value* Cells, size_t Count);
+
+        /** Drops one Shared reference to Array, freeing it if that was the last */
+        void Release(ArrayObject& Array, bool Atomic);
+        void ReleaseDeferred();
+
+        /** Slow paths of the arithmetic opcodes; an empty Message means success */
+        Value Arithmetic(EOpCode Op, const Value& Left, const Value& Right, std::string& Message);
+        static Value Compare(EOpCode Op, const Value& Left, const Value& Right, std::string& Message);
+        static Value Unary(EOpCode Op, const Value& Operand, std::string& Message);
+    };
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Vex {
+
+    struct ArrayObject;
+
+    enum class EValueType : uint8_t {
+        Null,
+        Bool,
+        Int,            // 64-bit, wraps on overflow
+        Float,          // IEEE double
+        String,         // Immutable, owned by the Program or the VirtualMachine
+        Array,          // Elements of a Define type, owned by the VirtualMachine
+        Interface,      // One element of an array, with the table of an Interface its Define implements
+        Vector2,        // Math types, held in Lanes
+        Vector3,
+        Vector4,
+        Quat,
+        Color,
+    };
+
+    std::string ValueTypeToString(EValueType Type);
+
+    /** Lanes a math type uses (the rest stay zero), or 0 for the other types */
+    constexpr int MathLaneCount(const EValueType Type) {
+        return Type == EValueType::Vector2 ? 2 : Type == EValueType::Vector3 ? 3 : Type >= EValueType::Vector4 ? 4 : 0;
+    }
+
+    /**
+     * An element used through an Interface: a fat pointer to the element
+     * and to the table of its Define's methods for that Interface (the
+     * offset of the table in Program::ITables)
+     */
+    struct InterfaceRef {
+        ArrayObject* Array;
+        uint32_t Index;
+        uint32_t Table;
+    };
+
+    /**
+     * One VM register (24 bytes, trivially copyable)
+     *
+     * Only the member named by Type is meaningful. Strings and arrays
+     * point at storage that outlives every register holding them, and the
+     * math types and interface references are stored inline, so copying a
+     * Value never allocates.
+     */
+    struct Value {
+        EValueType Type = EValueType::Null;
+        union {
+            bool               Bool;
+            long long          Int;
+            double             Float;
+            const std::string* String;
+            ArrayObject*       Array;
+            InterfaceRef       Interface;
+            float              Lanes[4];
+        };
+
+        Value() : Int(0) {}
+
+        static Value MakeBool(const bool Data) {
+            Value Result;
+            Result.Type = EValueType::Bool;
+            Result.Bool = Data;
+            return Result;
+        }
+
+        static Value MakeInt(const long long Data) {
+            Value Result;
+            Result.Type = EValueType::Int;
+            Result.Int = Data;
+            return Result;
+        }
+
+        static Value MakeFloat(const double Data) {
+            Value Result;
+            Result.Type = EValueType::Float;
+            Result.Float = Data;
+            return Result;
+        }
+
+        static Value MakeString(const std::string* Data) {
+            Value Result;
+            Result.Type = EValueType::String;
+            Result.String = Data;
+            return Result;
+        }
+
+        static Value MakeArray(ArrayObject* Data) {
+            Value Result;
+            Result.Type = EValueType::Array;
+            Result.Array = Data;
+            return Result;
+        }
+
+        static Value MakeInterface(ArrayObject* Data, const uint32_t Index, const uint32_t Table) {
+            Value Result;
+            Result.Type = EValueType::Interface;
+            Result.Interface = { Data, Index, Table };
+            return Result;
+        }
+
+        static Value MakeMath(const EValueType Type, const float X, const float Y, const float Z = 0.0f, const float W = 0.0f) {
+            Value Result;
+            Result.Type = Type;
+            Result.Lanes[0] = X;
+            Result.Lanes[1] = Y;
+            Result.Lanes[2] = Z;
+            Result.Lanes[3] = W;
+            return Result;
+        }
+
+        [[nodiscard]] bool IsNull() const { return Type == EValueType::Null; }
+        [[nodiscard]] bool IsNumber() const { return Type == EValueType::Int || Type == EValueType::Float; }
+        [[nodiscard]] bool IsMath() const { return Type >= EValueType::Vector2; }
+
+        /** Int or Float as a double; only meaningful when IsNumber() */
+        [[nodiscard]] double ToFloat() const { return Type == EValueType::Int ? static_cast<double>(Int) : Float; }
+
+        std::string ToString() const;
+    };
+
+    static_assert(sizeof(Value) == 24, "Registers are expected to stay three words wide");
+}